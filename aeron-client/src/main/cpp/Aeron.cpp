@@ -63,7 +63,8 @@ Aeron::Aeron(Context &context) :
         m_context.m_onUnavailableCounterHandler,
         m_context.m_mediaDriverTimeout,
         m_context.m_resourceLingerTimeout,
-        CncFileDescriptor::clientLivenessTimeout(m_cncBuffer)),
+        CncFileDescriptor::clientLivenessTimeout(m_cncBuffer),
+        m_context.m_termBufferHugePages),
     m_idleStrategy(IDLE_SLEEP_MS),
     m_conductorRunner(m_conductor, m_idleStrategy, m_context.m_exceptionHandler, AGENT_NAME),
     m_conductorInvoker(m_conductor, m_context.m_exceptionHandler)
@@ -109,7 +110,7 @@ inline MemoryMappedFile::ptr_t Aeron::mapCncFile(Context &context)
             std::this_thread::sleep_for(IDLE_SLEEP_MS_16);
         }
 
-        cncBuffer = MemoryMappedFile::mapExisting(context.cncFileName().c_str());
+        cncBuffer = MemoryMappedFile::mapExisting(context.cncFileName().c_str(), context.m_cncHugePages);
 
         std::int32_t cncVersion = 0;
 
@@ -470,7 +470,7 @@ void ClientConductor::onNewPublication(
         state.m_sessionId = sessionId;
         state.m_publicationLimitCounterId = publicationLimitCounterId;
         state.m_channelStatusId = channelStatusIndicatorId;
-        state.m_buffers = std::make_shared<LogBuffers>(logFileName.c_str());
+        state.m_buffers = std::make_shared<LogBuffers>(logFileName.c_str(), m_termBufferHugePages);
         state.m_originalRegistrationId = originalRegistrationId;
 
         m_onNewPublicationHandler(state.m_channel, streamId, sessionId, registrationId);
@@ -502,7 +502,7 @@ void ClientConductor::onNewExclusivePublication(
         state.m_sessionId = sessionId;
         state.m_publicationLimitCounterId = publicationLimitCounterId;
         state.m_channelStatusId = channelStatusIndicatorId;
-        state.m_buffers = std::make_shared<LogBuffers>(logFileName.c_str());
+        state.m_buffers = std::make_shared<LogBuffers>(logFileName.c_str(), m_termBufferHugePages);
         state.m_originalRegistrationId = originalRegistrationId;
 
         m_onNewExclusivePublicationHandler(state.m_channel, streamId, sessionId, registrationId);
@@ -647,7 +647,8 @@ void ClientConductor::onAvailableImage(
 
                 if (nullptr != subscription)
                 {
-                    std::shared_ptr<LogBuffers> logBuffers = std::make_shared<LogBuffers>(logFilename.c_str());
+                    std::shared_ptr<LogBuffers> logBuffers =
+                        std::make_shared<LogBuffers>(logFilename.c_str(), m_termBufferHugePages);
                     UnsafeBufferPosition subscriberPosition(m_counterValuesBuffer, subscriberPositionId);
 
                     Image image(
@@ -61,7 +61,8 @@ public:
         const on_unavailable_counter_t& unavailableCounterHandler,
         long driverTimeoutMs,
         long resourceLingerTimeoutMs,
-        long long interServiceTimeoutNs) :
+        long long interServiceTimeoutNs,
+        bool termBufferHugePages) :
         m_driverProxy(driverProxy),
         m_driverListenerAdapter(broadcastReceiver, *this),
         m_countersReader(counterMetadataBuffer, counterValuesBuffer),
@@ -79,6 +80,7 @@ public:
         m_driverTimeoutMs(driverTimeoutMs),
         m_resourceLingerTimeoutMs(resourceLingerTimeoutMs),
         m_interServiceTimeoutMs(static_cast<long>(interServiceTimeoutNs / 1000000)),
+        m_termBufferHugePages(termBufferHugePages),
         m_driverActive(true),
         m_isClosed(false)
     {
@@ -367,6 +369,7 @@ private:
     long m_driverTimeoutMs;
     long m_resourceLingerTimeoutMs;
     long m_interServiceTimeoutMs;
+    bool m_termBufferHugePages;
 
     std::atomic<bool> m_driverActive;
     std::atomic<bool> m_isClosed;
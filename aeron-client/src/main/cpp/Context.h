@@ -18,6 +18,7 @@
 #define AERON_CONTEXT_H
 
 #include <memory>
+#include <cstring>
 #include <util/Exceptions.h>
 #include <concurrent/AgentRunner.h>
 #include <concurrent/broadcast/CopyBroadcastReceiver.h>
@@ -111,6 +112,13 @@ const static long NULL_TIMEOUT = -1;
 const static long DEFAULT_MEDIA_DRIVER_TIMEOUT_MS = 10000;
 const static long DEFAULT_RESOURCE_LINGER_MS = 5000;
 
+/**
+ * Environment variables the media driver reads to place term buffers and the CnC file on huge pages. The client
+ * defaults to the same settings so its mappings of those files follow the driver.
+ */
+constexpr const char *TERM_BUFFER_HUGE_PAGES_ENV_VAR = "AERON_TERM_BUFFER_HUGE_PAGES";
+constexpr const char *CNC_HUGE_PAGES_ENV_VAR = "AERON_CNC_HUGE_PAGES";
+
 /**
  * The Default handler for Aeron runtime exceptions.
  * When a DriverTimeoutException is encountered, this handler will exit the program.
@@ -362,6 +370,60 @@ public:
         return *this;
     }
 
+    /**
+     * Set whether mappings of log buffers advise the kernel to back them with transparent huge pages. This should
+     * match the media driver setting of AERON_TERM_BUFFER_HUGE_PAGES, which is the default.
+     *
+     * @param value true to advise huge pages.
+     * @return reference to this Context instance
+     */
+    inline this_t& termBufferHugePages(bool value)
+    {
+        m_termBufferHugePages = value;
+        return *this;
+    }
+
+    /**
+     * Whether mappings of log buffers advise the kernel to back them with transparent huge pages.
+     *
+     * @return true if huge pages are advised for log buffers.
+     */
+    inline bool termBufferHugePages() const
+    {
+        return m_termBufferHugePages;
+    }
+
+    /**
+     * Set whether the mapping of the CnC file advises the kernel to back it with transparent huge pages. This should
+     * match the media driver setting of AERON_CNC_HUGE_PAGES, which is the default.
+     *
+     * @param value true to advise huge pages.
+     * @return reference to this Context instance
+     */
+    inline this_t& cncHugePages(bool value)
+    {
+        m_cncHugePages = value;
+        return *this;
+    }
+
+    /**
+     * Whether the mapping of the CnC file advises the kernel to back it with transparent huge pages.
+     *
+     * @return true if huge pages are advised for the CnC file.
+     */
+    inline bool cncHugePages() const
+    {
+        return m_cncHugePages;
+    }
+
+    inline static bool isEnvTrue(const char *name)
+    {
+        const char *value = ::getenv(name);
+
+        return nullptr != value &&
+            (0 == ::strncmp(value, "1", 1) || 0 == ::strncmp(value, "on", 2) || 0 == ::strncmp(value, "true", 4));
+    }
+
     inline static std::string tmpDir()
     {
 #if defined(_MSC_VER)
@@ -431,6 +493,8 @@ private:
     long m_mediaDriverTimeout = DEFAULT_MEDIA_DRIVER_TIMEOUT_MS;
     long m_resourceLingerTimeout = DEFAULT_RESOURCE_LINGER_MS;
     bool m_useConductorAgentInvoker = false;
+    bool m_termBufferHugePages = isEnvTrue(TERM_BUFFER_HUGE_PAGES_ENV_VAR);
+    bool m_cncHugePages = isEnvTrue(CNC_HUGE_PAGES_ENV_VAR);
     bool m_isOnNewExclusivePublicationHandlerSet = false;
 };
 
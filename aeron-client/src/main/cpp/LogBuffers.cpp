@@ -21,11 +21,11 @@ namespace aeron {
 using namespace aeron::util;
 using namespace aeron::concurrent::logbuffer;
 
-LogBuffers::LogBuffers(const char *filename)
+LogBuffers::LogBuffers(const char *filename, bool useHugePages)
 {
     const std::int64_t logLength = MemoryMappedFile::getFileSize(filename);
 
-    m_memoryMappedFiles = MemoryMappedFile::mapExisting(filename);
+    m_memoryMappedFiles = MemoryMappedFile::mapExisting(filename, useHugePages);
 
     std::uint8_t *basePtr = m_memoryMappedFiles->getMemoryPtr();
 
@@ -76,10 +76,11 @@ MemoryMappedFile::ptr_t MemoryMappedFile::createNew(const char *filename, size_t
         throw IOException(std::string("Failed to write to file: ") + filename + " " + toString(GetLastError()), SOURCEINFO);
     }
 
-    return MemoryMappedFile::ptr_t(new MemoryMappedFile(fd, offset, size));
+    return MemoryMappedFile::ptr_t(new MemoryMappedFile(fd, offset, size, false));
 }
 
-MemoryMappedFile::ptr_t MemoryMappedFile::mapExisting(const char *filename, size_t offset, size_t size)
+MemoryMappedFile::ptr_t MemoryMappedFile::mapExisting(
+    const char *filename, size_t offset, size_t size, bool useHugePages)
 {
     FileHandle fd;
     fd.handle = CreateFile(filename, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
@@ -89,7 +90,7 @@ MemoryMappedFile::ptr_t MemoryMappedFile::mapExisting(const char *filename, size
         throw IOException(std::string("Failed to create file: ") + filename + " " + toString(GetLastError()), SOURCEINFO);
     }
 
-    return MemoryMappedFile::ptr_t(new MemoryMappedFile(fd, offset, size));
+    return MemoryMappedFile::ptr_t(new MemoryMappedFile(fd, offset, size, useHugePages));
 }
 #else
 bool MemoryMappedFile::fill(FileHandle fd, size_t size, uint8_t value)
@@ -137,10 +138,11 @@ MemoryMappedFile::ptr_t MemoryMappedFile::createNew(const char *filename, off_t
         throw IOException(std::string("failed to write to file: ") + filename, SOURCEINFO);
     }
 
-    return MemoryMappedFile::ptr_t(new MemoryMappedFile(fd, offset, size));
+    return MemoryMappedFile::ptr_t(new MemoryMappedFile(fd, offset, size, false));
 }
 
-MemoryMappedFile::ptr_t MemoryMappedFile::mapExisting(const char *filename, off_t offset, size_t length)
+MemoryMappedFile::ptr_t MemoryMappedFile::mapExisting(
+    const char *filename, off_t offset, size_t length, bool useHugePages)
 {
     FileHandle fd;
     fd.handle = ::open(filename, O_RDWR, 0666);
@@ -155,13 +157,13 @@ MemoryMappedFile::ptr_t MemoryMappedFile::mapExisting(const char *filename, off_
         close(fd.handle);
     });
 
-    return MemoryMappedFile::ptr_t(new MemoryMappedFile(fd, offset, length));
+    return MemoryMappedFile::ptr_t(new MemoryMappedFile(fd, offset, length, useHugePages));
 }
 #endif
 
-MemoryMappedFile::ptr_t MemoryMappedFile::mapExisting(const char *filename)
+MemoryMappedFile::ptr_t MemoryMappedFile::mapExisting(const char *filename, bool useHugePages)
 {
-    return mapExisting(filename, 0, 0);
+    return mapExisting(filename, 0, 0, useHugePages);
 }
 
 uint8_t* MemoryMappedFile::getMemoryPtr() const
@@ -177,7 +179,7 @@ size_t MemoryMappedFile::getMemorySize() const
 size_t MemoryMappedFile::m_page_size = getPageSize();
 
 #ifdef _WIN32
-MemoryMappedFile::MemoryMappedFile(FileHandle fd, size_t offset, size_t length)
+MemoryMappedFile::MemoryMappedFile(FileHandle fd, size_t offset, size_t length, bool useHugePages)
 {
     if (0 == length && 0 == offset)
     {
@@ -192,7 +194,7 @@ MemoryMappedFile::MemoryMappedFile(FileHandle fd, size_t offset, size_t length)
     }
 
     m_memorySize = length;
-    m_memory = doMapping(m_memorySize, fd, offset);
+    m_memory = doMapping(m_memorySize, fd, offset, useHugePages);
 
     if (!m_memory)
     {
@@ -224,7 +226,7 @@ MemoryMappedFile::~MemoryMappedFile()
     cleanUp();
 }
 
-uint8_t* MemoryMappedFile::doMapping(size_t size, FileHandle fd, size_t offset)
+uint8_t* MemoryMappedFile::doMapping(size_t size, FileHandle fd, size_t offset, bool useHugePages)
 {
     m_mapping = CreateFileMapping(fd.handle, NULL, PAGE_READWRITE, 0, (DWORD)size, NULL);
     if (m_mapping == NULL)
@@ -258,7 +260,7 @@ std::int64_t MemoryMappedFile::getFileSize(const char *filename)
 }
 
 #else
-MemoryMappedFile::MemoryMappedFile(FileHandle fd, off_t offset, size_t length)
+MemoryMappedFile::MemoryMappedFile(FileHandle fd, off_t offset, size_t length, bool useHugePages)
 {
     if (0 == length && 0 == offset)
     {
@@ -268,7 +270,7 @@ MemoryMappedFile::MemoryMappedFile(FileHandle fd, off_t offset, size_t length)
     }
 
     m_memorySize = length;
-    m_memory = doMapping(m_memorySize, fd, offset);
+    m_memory = doMapping(m_memorySize, fd, offset, useHugePages);
 }
 
 MemoryMappedFile::~MemoryMappedFile()
@@ -279,7 +281,7 @@ MemoryMappedFile::~MemoryMappedFile()
     }
 }
 
-uint8_t* MemoryMappedFile::doMapping(size_t length, FileHandle fd, size_t offset)
+uint8_t* MemoryMappedFile::doMapping(size_t length, FileHandle fd, size_t offset, bool useHugePages)
 {
     void* memory = ::mmap(NULL, length, PROT_READ|PROT_WRITE, MAP_SHARED, fd.handle, static_cast<off_t>(offset));
 
@@ -288,6 +290,14 @@ uint8_t* MemoryMappedFile::doMapping(size_t length, FileHandle fd, size_t offset
         throw IOException("failed to Memory Map File", SOURCEINFO);
     }
 
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // only a hint, failure just means small pages
+    if (useHugePages)
+    {
+        ::madvise(memory, length, MADV_HUGEPAGE);
+    }
+#endif
+
     return static_cast<uint8_t*>(memory);
 }
 
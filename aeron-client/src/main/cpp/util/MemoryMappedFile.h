@@ -38,13 +38,17 @@ public:
 
 #ifdef _WIN32
     static ptr_t createNew(const char* filename, size_t offset, size_t length);
-    static ptr_t mapExisting(const char* filename, size_t offset, size_t length);
+    static ptr_t mapExisting(const char* filename, size_t offset, size_t length, bool useHugePages = false);
 #else
     static ptr_t createNew(const char* filename, off_t offset, size_t length);
-    static ptr_t mapExisting(const char* filename, off_t offset, size_t length);
+    static ptr_t mapExisting(const char* filename, off_t offset, size_t length, bool useHugePages = false);
 #endif
 
-    static ptr_t mapExisting(const char* filename);
+    /**
+     * Map an existing file in full. With useHugePages the kernel is advised to back the mapping with transparent
+     * huge pages, as the driver does for files it placed on them, and small pages are used where it cannot.
+     */
+    static ptr_t mapExisting(const char* filename, bool useHugePages = false);
 
     ~MemoryMappedFile ();
 
@@ -68,12 +72,12 @@ private:
     };
 
 #ifdef _WIN32
-    MemoryMappedFile(const FileHandle fd, size_t offset, size_t length);
+    MemoryMappedFile(const FileHandle fd, size_t offset, size_t length, bool useHugePages);
 #else
-    MemoryMappedFile(const FileHandle fd, off_t offset, size_t length);
+    MemoryMappedFile(const FileHandle fd, off_t offset, size_t length, bool useHugePages);
 #endif
 
-    uint8_t* doMapping(size_t size, FileHandle fd, size_t offset);
+    uint8_t* doMapping(size_t size, FileHandle fd, size_t offset, bool useHugePages);
 
     std::uint8_t* m_memory = 0;
     size_t m_memorySize = 0;
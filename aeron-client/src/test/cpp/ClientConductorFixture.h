@@ -93,7 +93,8 @@ public:
             std::bind(&testing::NiceMock<MockClientConductorHandlers>::onUnavailableCounter, &m_handlers, _1, _2, _3),
             DRIVER_TIMEOUT_MS,
             RESOURCE_LINGER_TIMEOUT_MS,
-            INTER_SERVICE_TIMEOUT_NS),
+            INTER_SERVICE_TIMEOUT_NS,
+            false),
         m_errorHandler(defaultErrorHandler),
         m_onAvailableImageHandler(std::bind(&testing::NiceMock<MockClientConductorHandlers>::onNewImage, &m_handlers, _1)),
         m_onUnavailableImageHandler(std::bind(&testing::NiceMock<MockClientConductorHandlers>::onInactive, &m_handlers, _1)),
@@ -15,6 +15,9 @@
  */
 #include <stdlib.h>
 #include <gtest/gtest.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
 #include <string>
 
 #include <util/MemoryMappedFile.h>
@@ -84,3 +87,57 @@ TEST(mmfileTest, writeReadCheck)
 
     ::unlink(name.c_str());
 }
+
+#if defined(__linux__)
+
+static bool isAdvisedHugePages(const void *addr)
+{
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool inMapping = false;
+
+    while (std::getline(smaps, line))
+    {
+        std::uintptr_t start, end;
+        char dash;
+        std::istringstream header(line);
+
+        if (header >> std::hex >> start >> dash >> end && '-' == dash)
+        {
+            inMapping = reinterpret_cast<std::uintptr_t>(addr) >= start && reinterpret_cast<std::uintptr_t>(addr) < end;
+        }
+        else if (inMapping && 0 == line.compare(0, 8, "VmFlags:"))
+        {
+            return std::string::npos != (line + " ").find(" hg ");
+        }
+    }
+
+    return false;
+}
+
+TEST(mmfileTest, shouldOnlyAdviseHugePagesWhenAsked)
+{
+    if (!std::ifstream("/sys/kernel/mm/transparent_hugepage/enabled"))
+    {
+        std::cout << "[  SKIPPED ] no transparent huge pages on this kernel" << std::endl;
+        return;
+    }
+
+    const size_t size = 4 * 1024 * 1024;
+    const std::string name(makeTempFileName());
+
+    ASSERT_NO_THROW({
+        MemoryMappedFile::createNew(name.c_str(), 0, size);
+    });
+
+    MemoryMappedFile::ptr_t plain = MemoryMappedFile::mapExisting(name.c_str());
+    MemoryMappedFile::ptr_t advised = MemoryMappedFile::mapExisting(name.c_str(), true);
+
+    EXPECT_FALSE(isAdvisedHugePages(plain->getMemoryPtr()));
+    EXPECT_TRUE(isAdvisedHugePages(advised->getMemoryPtr()));
+    EXPECT_EQ(advised->getMemorySize(), size);
+
+    ::unlink(name.c_str());
+}
+
+#endif
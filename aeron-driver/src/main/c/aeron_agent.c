@@ -63,6 +63,118 @@ static void aeron_idle_strategy_noop_idle(void *state, int work_count)
 {
 }
 
+static void aeron_idle_strategy_backoff_reset(aeron_idle_strategy_backoff_state_t *state)
+{
+    state->spins = 0;
+    state->yields = 0;
+    state->park_period_ns = state->min_park_period_ns;
+    state->state = AERON_IDLE_STRATEGY_BACKOFF_STATE_NOT_IDLE;
+}
+
+void aeron_idle_strategy_backoff_state_init(
+    aeron_idle_strategy_backoff_state_t *state,
+    uint64_t max_spins,
+    uint64_t max_yields,
+    uint64_t min_park_period_ns,
+    uint64_t max_park_period_ns)
+{
+    state->max_spins = max_spins;
+    state->max_yields = max_yields;
+    state->min_park_period_ns = min_park_period_ns;
+    state->max_park_period_ns = max_park_period_ns < min_park_period_ns ? min_park_period_ns : max_park_period_ns;
+    aeron_idle_strategy_backoff_reset(state);
+}
+
+void aeron_idle_strategy_backoff_idle(void *state, int work_count)
+{
+    aeron_idle_strategy_backoff_state_t *backoff = (aeron_idle_strategy_backoff_state_t *)state;
+
+    if (work_count > 0)
+    {
+        if (AERON_IDLE_STRATEGY_BACKOFF_STATE_NOT_IDLE != backoff->state)
+        {
+            aeron_idle_strategy_backoff_reset(backoff);
+        }
+
+        return;
+    }
+
+    switch (backoff->state)
+    {
+        case AERON_IDLE_STRATEGY_BACKOFF_STATE_NOT_IDLE:
+            backoff->state = AERON_IDLE_STRATEGY_BACKOFF_STATE_SPINNING;
+            backoff->spins++;
+            break;
+
+        case AERON_IDLE_STRATEGY_BACKOFF_STATE_SPINNING:
+            proc_yield();
+            if (++backoff->spins > backoff->max_spins)
+            {
+                backoff->state = AERON_IDLE_STRATEGY_BACKOFF_STATE_YIELDING;
+                backoff->yields = 0;
+            }
+            break;
+
+        case AERON_IDLE_STRATEGY_BACKOFF_STATE_YIELDING:
+            if (++backoff->yields > backoff->max_yields)
+            {
+                backoff->state = AERON_IDLE_STRATEGY_BACKOFF_STATE_PARKING;
+                backoff->park_period_ns = backoff->min_park_period_ns;
+            }
+            else
+            {
+                sched_yield();
+            }
+            break;
+
+        default:
+            aeron_nano_sleep((size_t)backoff->park_period_ns);
+            backoff->park_period_ns = backoff->park_period_ns << 1;
+            if (backoff->park_period_ns > backoff->max_park_period_ns)
+            {
+                backoff->park_period_ns = backoff->max_park_period_ns;
+            }
+            break;
+    }
+}
+
+void aeron_idle_strategy_controllable_idle(void *state, int work_count)
+{
+    aeron_idle_strategy_controllable_state_t *controllable = (aeron_idle_strategy_controllable_state_t *)state;
+    volatile int64_t *status_indicator = *controllable->status_indicator;
+    int64_t status = AERON_IDLE_STRATEGY_CONTROLLABLE_NOT_CONTROLLED;
+
+    if (NULL != status_indicator)
+    {
+        AERON_GET_VOLATILE(status, *status_indicator);
+    }
+
+    switch (status)
+    {
+        case AERON_IDLE_STRATEGY_CONTROLLABLE_NOOP:
+            break;
+
+        case AERON_IDLE_STRATEGY_CONTROLLABLE_BUSY_SPIN:
+            aeron_idle_strategy_busy_spinning_idle(NULL, work_count);
+            break;
+
+        case AERON_IDLE_STRATEGY_CONTROLLABLE_YIELD:
+            aeron_idle_strategy_yielding_idle(NULL, work_count);
+            break;
+
+        case AERON_IDLE_STRATEGY_CONTROLLABLE_PARK:
+            if (work_count <= 0)
+            {
+                aeron_nano_sleep((size_t)controllable->backoff.max_park_period_ns);
+            }
+            break;
+
+        default:
+            aeron_idle_strategy_backoff_idle(&controllable->backoff, work_count);
+            break;
+    }
+}
+
 static int aeron_idle_strategy_init_null(void **state)
 {
     *state = NULL;
@@ -95,7 +207,8 @@ aeron_idle_strategy_t aeron_idle_strategy_noop =
 
 aeron_idle_strategy_func_t aeron_idle_strategy_load(
     const char *idle_strategy_name,
-    void **idle_strategy_state)
+    void **idle_strategy_state,
+    aeron_driver_context_t *context)
 {
     char idle_func_name[AERON_MAX_PATH];
     aeron_idle_strategy_func_t idle_func = NULL;
@@ -126,6 +239,51 @@ aeron_idle_strategy_func_t aeron_idle_strategy_load(
     {
         idle_func = aeron_idle_strategy_noop_idle;
     }
+    else if (strncmp(idle_strategy_name, "backoff", sizeof("backoff")) == 0)
+    {
+        aeron_idle_strategy_backoff_state_t *backoff = NULL;
+
+        if (aeron_alloc((void **)&backoff, sizeof(aeron_idle_strategy_backoff_state_t)) < 0)
+        {
+            int err_code = errno;
+
+            aeron_set_err(err_code, "%s:%d: %s", __FILE__, __LINE__, strerror(err_code));
+            return NULL;
+        }
+
+        aeron_idle_strategy_backoff_state_init(
+            backoff,
+            context->idle_strategy_max_spins,
+            context->idle_strategy_max_yields,
+            context->idle_strategy_min_park_period_ns,
+            context->idle_strategy_max_park_period_ns);
+
+        idle_func = aeron_idle_strategy_backoff_idle;
+        *idle_strategy_state = backoff;
+    }
+    else if (strncmp(idle_strategy_name, "controllable", sizeof("controllable")) == 0)
+    {
+        aeron_idle_strategy_controllable_state_t *controllable = NULL;
+
+        if (aeron_alloc((void **)&controllable, sizeof(aeron_idle_strategy_controllable_state_t)) < 0)
+        {
+            int err_code = errno;
+
+            aeron_set_err(err_code, "%s:%d: %s", __FILE__, __LINE__, strerror(err_code));
+            return NULL;
+        }
+
+        aeron_idle_strategy_backoff_state_init(
+            &controllable->backoff,
+            context->idle_strategy_max_spins,
+            context->idle_strategy_max_yields,
+            context->idle_strategy_min_park_period_ns,
+            context->idle_strategy_max_park_period_ns);
+        controllable->status_indicator = &context->controllable_idle_strategy_status_indicator;
+
+        idle_func = aeron_idle_strategy_controllable_idle;
+        *idle_strategy_state = controllable;
+    }
     else
     {
         aeron_idle_strategy_t *idle_strat = NULL;
@@ -172,7 +330,8 @@ int aeron_agent_init(
     aeron_agent_do_work_func_t do_work,
     aeron_agent_on_close_func_t on_close,
     aeron_idle_strategy_func_t idle_strategy_func,
-    void *idle_strategy_state)
+    void *idle_strategy_state,
+    const aeron_cpu_set_t *cpu_affinity)
 {
     size_t role_name_length = strlen(role_name);
 
@@ -198,6 +357,7 @@ int aeron_agent_init(
 
     runner->idle_strategy_state = idle_strategy_state;
     runner->idle_strategy = idle_strategy_func;
+    runner->cpu_affinity = cpu_affinity;
     runner->running = true;
     runner->state = AERON_AGENT_STATE_INITED;
 
@@ -244,6 +404,14 @@ int aeron_agent_start(aeron_agent_runner_t *runner)
         return -1;
     }
 
+    if (NULL != runner->cpu_affinity && !aeron_cpu_set_is_empty(runner->cpu_affinity) &&
+        (pthread_result = aeron_thread_attr_set_affinity(&attr, runner->cpu_affinity)) != 0)
+    {
+        aeron_set_err(
+            pthread_result, "%s agent aeron_thread_attr_set_affinity: %s", runner->role_name, strerror(pthread_result));
+        return -1;
+    }
+
     if ((pthread_result = aeron_thread_create(&runner->thread, &attr, agent_main, runner)) != 0)
     {
         aeron_set_err(pthread_result, "aeron_thread_create: %s", strerror(pthread_result));
@@ -42,6 +42,40 @@ typedef struct aeron_idle_strategy_stct
 }
 aeron_idle_strategy_t;
 
+typedef struct aeron_driver_context_stct aeron_driver_context_t;
+
+#define AERON_IDLE_STRATEGY_BACKOFF_STATE_NOT_IDLE 0
+#define AERON_IDLE_STRATEGY_BACKOFF_STATE_SPINNING 1
+#define AERON_IDLE_STRATEGY_BACKOFF_STATE_YIELDING 2
+#define AERON_IDLE_STRATEGY_BACKOFF_STATE_PARKING 3
+
+typedef struct aeron_idle_strategy_backoff_state_stct
+{
+    uint64_t max_spins;
+    uint64_t max_yields;
+    uint64_t min_park_period_ns;
+    uint64_t max_park_period_ns;
+    uint64_t spins;
+    uint64_t yields;
+    uint64_t park_period_ns;
+    uint8_t state;
+}
+aeron_idle_strategy_backoff_state_t;
+
+#define AERON_IDLE_STRATEGY_CONTROLLABLE_NOT_CONTROLLED 0
+#define AERON_IDLE_STRATEGY_CONTROLLABLE_NOOP 1
+#define AERON_IDLE_STRATEGY_CONTROLLABLE_BUSY_SPIN 2
+#define AERON_IDLE_STRATEGY_CONTROLLABLE_YIELD 3
+#define AERON_IDLE_STRATEGY_CONTROLLABLE_PARK 4
+
+typedef struct aeron_idle_strategy_controllable_state_stct
+{
+    aeron_idle_strategy_backoff_state_t backoff;
+    /* indirect as the status counter is only allocated once the conductor is initialised */
+    volatile int64_t **status_indicator;
+}
+aeron_idle_strategy_controllable_state_t;
+
 typedef struct aeron_agent_runner_stct
 {
     const char *role_name;
@@ -52,6 +86,7 @@ typedef struct aeron_agent_runner_stct
     aeron_agent_do_work_func_t do_work;
     aeron_agent_on_close_func_t on_close;
     aeron_idle_strategy_func_t idle_strategy;
+    const aeron_cpu_set_t *cpu_affinity;
     aeron_thread_t thread;
     volatile bool running;
     uint8_t state;
@@ -60,7 +95,19 @@ aeron_agent_runner_t;
 
 aeron_idle_strategy_func_t aeron_idle_strategy_load(
     const char *idle_strategy_name,
-    void **idle_strategy_state);
+    void **idle_strategy_state,
+    aeron_driver_context_t *context);
+
+void aeron_idle_strategy_backoff_idle(void *state, int work_count);
+
+void aeron_idle_strategy_controllable_idle(void *state, int work_count);
+
+void aeron_idle_strategy_backoff_state_init(
+    aeron_idle_strategy_backoff_state_t *state,
+    uint64_t max_spins,
+    uint64_t max_yields,
+    uint64_t min_park_period_ns,
+    uint64_t max_park_period_ns);
 
 aeron_agent_on_start_func_t aeron_agent_on_start_load(const char *name);
 
@@ -73,7 +120,8 @@ int aeron_agent_init(
     aeron_agent_do_work_func_t do_work,
     aeron_agent_on_close_func_t on_close,
     aeron_idle_strategy_func_t idle_strategy_func,
-    void *idle_strategy_state);
+    void *idle_strategy_state,
+    const aeron_cpu_set_t *cpu_affinity);
 
 int aeron_agent_start(aeron_agent_runner_t *runner);
 
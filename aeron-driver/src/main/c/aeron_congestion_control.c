@@ -20,6 +20,7 @@
 #endif
 
 #include <errno.h>
+#include <math.h>
 #include "protocol/aeron_udp_protocol.h"
 #include "concurrent/aeron_logbuffer_descriptor.h"
 #include "util/aeron_error.h"
@@ -27,6 +28,7 @@
 #include "aeron_congestion_control.h"
 #include "aeron_alloc.h"
 #include "aeron_driver_context.h"
+#include "aeron_position.h"
 
 aeron_congestion_control_strategy_supplier_func_t aeron_congestion_control_strategy_supplier_load(
     const char *strategy_name)
@@ -53,6 +55,10 @@ bool aeron_static_window_congestion_control_strategy_should_measure_rtt(void *st
     return false;
 }
 
+void aeron_static_window_congestion_control_strategy_on_rttm_sent(void *state, int64_t now_ns)
+{
+}
+
 void aeron_static_window_congestion_control_strategy_on_rttm(
     void *state, int64_t now_ns, int64_t rtt_ns, struct sockaddr_storage *source_address)
 {
@@ -106,6 +112,7 @@ int aeron_static_window_congestion_control_strategy_supplier(
     }
 
     _strategy->should_measure_rtt = aeron_static_window_congestion_control_strategy_should_measure_rtt;
+    _strategy->on_rttm_sent = aeron_static_window_congestion_control_strategy_on_rttm_sent;
     _strategy->on_rttm = aeron_static_window_congestion_control_strategy_on_rttm;
     _strategy->on_track_rebuild = aeron_static_window_congestion_control_strategy_on_track_rebuild;
     _strategy->initial_window_length = aeron_static_window_congestion_control_strategy_initial_window_length;
@@ -120,3 +127,220 @@ int aeron_static_window_congestion_control_strategy_supplier(
     *strategy = _strategy;
     return 0;
 }
+
+typedef struct aeron_cubic_congestion_control_strategy_state_stct
+{
+    bool measure_rtt;
+    bool tcp_mode;
+    int32_t min_window;
+    int32_t mtu;
+    int32_t max_cwnd;
+    int32_t cwnd;
+    int32_t w_max;
+    int32_t outstanding_rtt_measurements;
+    int64_t last_loss_timestamp_ns;
+    int64_t last_update_timestamp_ns;
+    int64_t last_rtt_timestamp_ns;
+    int64_t window_update_timeout_ns;
+    int64_t rtt_ns;
+    double k;
+
+    int32_t rtt_indicator_counter_id;
+    int32_t window_indicator_counter_id;
+    int64_t *rtt_indicator;
+    int64_t *window_indicator;
+    aeron_counters_manager_t *counters_manager;
+}
+aeron_cubic_congestion_control_strategy_state_t;
+
+bool aeron_cubic_congestion_control_strategy_should_measure_rtt(void *state, int64_t now_ns)
+{
+    aeron_cubic_congestion_control_strategy_state_t *cubic_state = (aeron_cubic_congestion_control_strategy_state_t *)state;
+
+    /* a measurement whose reply was lost must not stop measurement, so the max timeout ignores outstanding ones */
+    return cubic_state->measure_rtt &&
+        ((cubic_state->last_rtt_timestamp_ns + AERON_CUBICCONGESTIONCONTROL_RTT_MAX_TIMEOUT_NS) - now_ns < 0 ||
+        (cubic_state->outstanding_rtt_measurements < AERON_CUBICCONGESTIONCONTROL_MAX_OUTSTANDING_RTT_MEASUREMENTS &&
+        (cubic_state->last_rtt_timestamp_ns + AERON_CUBICCONGESTIONCONTROL_RTT_MEASUREMENT_TIMEOUT_NS) - now_ns < 0));
+}
+
+void aeron_cubic_congestion_control_strategy_on_rttm_sent(void *state, int64_t now_ns)
+{
+    aeron_cubic_congestion_control_strategy_state_t *cubic_state = (aeron_cubic_congestion_control_strategy_state_t *)state;
+
+    cubic_state->last_rtt_timestamp_ns = now_ns;
+    cubic_state->outstanding_rtt_measurements++;
+}
+
+void aeron_cubic_congestion_control_strategy_on_rttm(
+    void *state, int64_t now_ns, int64_t rtt_ns, struct sockaddr_storage *source_address)
+{
+    aeron_cubic_congestion_control_strategy_state_t *cubic_state = (aeron_cubic_congestion_control_strategy_state_t *)state;
+
+    if (cubic_state->outstanding_rtt_measurements > 0)
+    {
+        cubic_state->outstanding_rtt_measurements--;
+    }
+
+    cubic_state->last_rtt_timestamp_ns = now_ns;
+
+    if (rtt_ns > 0)
+    {
+        cubic_state->rtt_ns = rtt_ns;
+        aeron_counter_set_ordered(cubic_state->rtt_indicator, rtt_ns);
+    }
+}
+
+int32_t aeron_cubic_congestion_control_strategy_on_track_rebuild(
+    void *state,
+    bool *should_force_sm,
+    int64_t now_ns,
+    int64_t new_consumption_position,
+    int64_t last_sm_position,
+    int64_t hwm_position,
+    int64_t starting_rebuild_position,
+    int64_t ending_rebuild_position,
+    bool loss_occurred)
+{
+    aeron_cubic_congestion_control_strategy_state_t *cubic_state = (aeron_cubic_congestion_control_strategy_state_t *)state;
+    const double b = AERON_CUBICCONGESTIONCONTROL_B;
+    const double c = AERON_CUBICCONGESTIONCONTROL_C;
+    bool force_sm = false;
+
+    if (loss_occurred)
+    {
+        const int32_t reduced_cwnd = (int32_t)(cubic_state->cwnd * (1.0 - b));
+
+        cubic_state->w_max = cubic_state->cwnd;
+        cubic_state->k = cbrt((double)cubic_state->w_max * b / c);
+        cubic_state->cwnd = reduced_cwnd > 1 ? reduced_cwnd : 1;
+        cubic_state->last_loss_timestamp_ns = now_ns;
+        force_sm = true;
+    }
+    else if (cubic_state->cwnd < cubic_state->max_cwnd &&
+        (cubic_state->last_update_timestamp_ns + cubic_state->window_update_timeout_ns) - now_ns < 0)
+    {
+        /* W_cubic(t) = C * (t - K)^3 + w_max */
+        const double duration_since_decrease_s = (double)(now_ns - cubic_state->last_loss_timestamp_ns) / 1e9;
+        const double diff_to_k = duration_since_decrease_s - cubic_state->k;
+        const double increment = c * diff_to_k * diff_to_k * diff_to_k;
+        const int32_t w_cubic = cubic_state->w_max + (int32_t)increment;
+
+        cubic_state->cwnd = w_cubic < cubic_state->max_cwnd ? w_cubic : cubic_state->max_cwnd;
+
+        if (cubic_state->tcp_mode && cubic_state->cwnd < cubic_state->w_max)
+        {
+            /* W_tcp(t) = w_max * (1 - B) + 3 * B / (2 - B) * t / RTT */
+            const double rtt_s = (double)cubic_state->rtt_ns / 1e9;
+            const int32_t w_tcp = (int32_t)(
+                (double)cubic_state->w_max * (1.0 - b) + ((3.0 * b / (2.0 - b)) * (duration_since_decrease_s / rtt_s)));
+
+            cubic_state->cwnd = w_tcp > cubic_state->cwnd ? w_tcp : cubic_state->cwnd;
+        }
+
+        cubic_state->last_update_timestamp_ns = now_ns;
+        force_sm = true;
+    }
+
+    const int32_t window = cubic_state->cwnd * cubic_state->mtu;
+    aeron_counter_set_ordered(cubic_state->window_indicator, window);
+
+    *should_force_sm = force_sm;
+    return window;
+}
+
+int32_t aeron_cubic_congestion_control_strategy_initial_window_length(void *state)
+{
+    return ((aeron_cubic_congestion_control_strategy_state_t *)state)->min_window;
+}
+
+int aeron_cubic_congestion_control_strategy_fini(aeron_congestion_control_strategy_t *strategy)
+{
+    aeron_cubic_congestion_control_strategy_state_t *state = strategy->state;
+
+    aeron_counters_manager_free(state->counters_manager, state->rtt_indicator_counter_id);
+    aeron_counters_manager_free(state->counters_manager, state->window_indicator_counter_id);
+
+    aeron_free(strategy->state);
+    aeron_free(strategy);
+    return 0;
+}
+
+int aeron_cubic_congestion_control_strategy_supplier(
+    aeron_congestion_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int32_t session_id,
+    int64_t registration_id,
+    int32_t term_length,
+    int32_t sender_mtu_length,
+    aeron_driver_context_t *context,
+    aeron_counters_manager_t *counters_manager)
+{
+    aeron_congestion_control_strategy_t *_strategy;
+
+    if (aeron_alloc((void **)&_strategy, sizeof(aeron_congestion_control_strategy_t)) < 0 ||
+        aeron_alloc((void **)&_strategy->state, sizeof(aeron_cubic_congestion_control_strategy_state_t)) < 0)
+    {
+        return -1;
+    }
+
+    _strategy->should_measure_rtt = aeron_cubic_congestion_control_strategy_should_measure_rtt;
+    _strategy->on_rttm_sent = aeron_cubic_congestion_control_strategy_on_rttm_sent;
+    _strategy->on_rttm = aeron_cubic_congestion_control_strategy_on_rttm;
+    _strategy->on_track_rebuild = aeron_cubic_congestion_control_strategy_on_track_rebuild;
+    _strategy->initial_window_length = aeron_cubic_congestion_control_strategy_initial_window_length;
+    _strategy->fini = aeron_cubic_congestion_control_strategy_fini;
+
+    aeron_cubic_congestion_control_strategy_state_t *state = _strategy->state;
+    const int32_t initial_window_length = (int32_t)context->initial_window_length;
+    const int32_t max_window_for_term = term_length / 2;
+    const int32_t max_window =
+        max_window_for_term < initial_window_length ? max_window_for_term : initial_window_length;
+
+    state->measure_rtt = context->cubic_measure_rtt;
+    state->tcp_mode = context->cubic_tcp_mode;
+    state->mtu = sender_mtu_length;
+    state->min_window = sender_mtu_length;
+    state->max_cwnd = max_window / sender_mtu_length;
+    state->cwnd = AERON_CUBICCONGESTIONCONTROL_INITCWND < state->max_cwnd ?
+        AERON_CUBICCONGESTIONCONTROL_INITCWND : state->max_cwnd;
+    state->w_max = state->max_cwnd;
+    state->k = cbrt((double)state->w_max * AERON_CUBICCONGESTIONCONTROL_B / AERON_CUBICCONGESTIONCONTROL_C);
+    state->outstanding_rtt_measurements = 0;
+
+    /* interval for adjusting the window is based on the RTT estimate */
+    state->rtt_ns = (int64_t)context->cubic_initial_rtt_ns;
+    state->window_update_timeout_ns = state->rtt_ns;
+
+    state->counters_manager = counters_manager;
+    state->rtt_indicator_counter_id = aeron_counter_per_image_indicator_allocate(
+        counters_manager, "rcv-cc-cubic-rtt", registration_id, session_id, stream_id, channel_length, channel);
+    state->window_indicator_counter_id = aeron_counter_per_image_indicator_allocate(
+        counters_manager, "rcv-cc-cubic-wnd", registration_id, session_id, stream_id, channel_length, channel);
+
+    if (state->rtt_indicator_counter_id < 0 || state->window_indicator_counter_id < 0)
+    {
+        if (state->rtt_indicator_counter_id >= 0)
+        {
+            aeron_counters_manager_free(counters_manager, state->rtt_indicator_counter_id);
+        }
+
+        aeron_free(_strategy->state);
+        aeron_free(_strategy);
+        return -1;
+    }
+
+    state->rtt_indicator = aeron_counter_addr(counters_manager, state->rtt_indicator_counter_id);
+    state->window_indicator = aeron_counter_addr(counters_manager, state->window_indicator_counter_id);
+    aeron_counter_set_ordered(state->rtt_indicator, 0);
+    aeron_counter_set_ordered(state->window_indicator, state->min_window);
+
+    state->last_loss_timestamp_ns = context->nano_clock();
+    state->last_update_timestamp_ns = state->last_loss_timestamp_ns;
+    state->last_rtt_timestamp_ns = 0;
+
+    *strategy = _strategy;
+    return 0;
+}
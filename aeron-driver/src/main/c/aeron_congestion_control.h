@@ -27,6 +27,8 @@ typedef struct aeron_counters_manager_stct aeron_counters_manager_t;
 
 typedef bool (*aeron_congestion_control_strategy_should_measure_rtt_func_t)(void *state, int64_t now_ns);
 
+typedef void (*aeron_congestion_control_strategy_on_rttm_sent_func_t)(void *state, int64_t now_ns);
+
 typedef void (*aeron_congestion_control_strategy_on_rttm_func_t)(
     void *state, int64_t now_ns, int64_t rtt_ns, struct sockaddr_storage *source_address);
 
@@ -49,6 +51,7 @@ typedef int (*aeron_congestion_control_strategy_fini_func_t)(
 typedef struct aeron_congestion_control_strategy_stct
 {
     aeron_congestion_control_strategy_should_measure_rtt_func_t should_measure_rtt;
+    aeron_congestion_control_strategy_on_rttm_sent_func_t on_rttm_sent; /* optional, may be NULL */
     aeron_congestion_control_strategy_on_rttm_func_t on_rttm;
     aeron_congestion_control_strategy_on_track_rebuild_func_t on_track_rebuild;
     aeron_congestion_control_strategy_initial_window_length_func_t initial_window_length;
@@ -69,6 +72,13 @@ typedef int (*aeron_congestion_control_strategy_supplier_func_t)(
     aeron_driver_context_t *context,
     aeron_counters_manager_t *counters_manager);
 
+#define AERON_CUBICCONGESTIONCONTROL_INITCWND (10)
+#define AERON_CUBICCONGESTIONCONTROL_RTT_MEASUREMENT_TIMEOUT_NS (10 * 1000 * 1000L)
+#define AERON_CUBICCONGESTIONCONTROL_RTT_MAX_TIMEOUT_NS (1000 * 1000 * 1000L)
+#define AERON_CUBICCONGESTIONCONTROL_MAX_OUTSTANDING_RTT_MEASUREMENTS (1)
+#define AERON_CUBICCONGESTIONCONTROL_C (0.4)
+#define AERON_CUBICCONGESTIONCONTROL_B (0.2)
+
 aeron_congestion_control_strategy_supplier_func_t aeron_congestion_control_strategy_supplier_load(
     const char *strategy_name);
 
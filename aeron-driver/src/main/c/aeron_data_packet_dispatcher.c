@@ -24,75 +24,203 @@ int aeron_data_packet_dispatcher_init(
     aeron_driver_conductor_proxy_t *conductor_proxy,
     aeron_driver_receiver_t *receiver)
 {
-    if (aeron_int64_to_ptr_hash_map_init(
-        &dispatcher->ignored_sessions_map, 16, AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
+    dispatcher->sessions.capacity = AERON_DATA_PACKET_DISPATCHER_SESSIONS_INITIAL_CAPACITY;
+    dispatcher->sessions.shift =
+        64 - (size_t)aeron_number_of_trailing_zeroes(AERON_DATA_PACKET_DISPATCHER_SESSIONS_INITIAL_CAPACITY);
+    dispatcher->sessions.size = 0;
+
+    if (aeron_alloc(
+        (void **)&dispatcher->sessions.entries,
+        dispatcher->sessions.capacity * sizeof(aeron_data_packet_dispatcher_session_entry_t)) < 0)
     {
         int errcode = errno;
 
-        aeron_set_err(errcode, "could not init ignored_session_map: %s", strerror(errcode));
+        aeron_set_err(errcode, "could not init sessions: %s", strerror(errcode));
         return -1;
     }
 
     if (aeron_int64_to_ptr_hash_map_init(
-        &dispatcher->session_by_stream_id_map, 16, AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
+        &dispatcher->subscribed_streams_map, 16, AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
     {
         int errcode = errno;
 
-        aeron_set_err(errcode, "could not init session_by_stream_id_map: %s", strerror(errcode));
+        aeron_set_err(errcode, "could not init subscribed_streams_map: %s", strerror(errcode));
         return -1;
     }
 
+    dispatcher->hot_image = NULL;
     dispatcher->conductor_proxy = conductor_proxy;
     dispatcher->receiver = receiver;
     return 0;
 }
 
-void aeron_data_packet_dispatcher_delete_session_maps(void *clientd, int64_t key, void *value)
+int aeron_data_packet_dispatcher_close(aeron_data_packet_dispatcher_t *dispatcher)
 {
-    aeron_int64_to_ptr_hash_map_t *session_map = value;
+    aeron_free(dispatcher->sessions.entries);
+    aeron_int64_to_ptr_hash_map_delete(&dispatcher->subscribed_streams_map);
 
-    aeron_int64_to_ptr_hash_map_delete(session_map);
-    aeron_free(session_map);
+    return 0;
 }
 
-int aeron_data_packet_dispatcher_close(aeron_data_packet_dispatcher_t *dispatcher)
+static int aeron_data_packet_dispatcher_sessions_rehash(aeron_data_packet_dispatcher_t *dispatcher, size_t new_capacity)
 {
-    aeron_int64_to_ptr_hash_map_for_each(
-        &dispatcher->session_by_stream_id_map, aeron_data_packet_dispatcher_delete_session_maps, dispatcher);
-    aeron_int64_to_ptr_hash_map_delete(&dispatcher->ignored_sessions_map);
-    aeron_int64_to_ptr_hash_map_delete(&dispatcher->session_by_stream_id_map);
+    aeron_data_packet_dispatcher_session_entry_t *entries;
+    const size_t mask = new_capacity - 1;
+    const size_t shift = 64 - (size_t)aeron_number_of_trailing_zeroes((int32_t)new_capacity);
+
+    if (aeron_alloc((void **)&entries, new_capacity * sizeof(aeron_data_packet_dispatcher_session_entry_t)) < 0)
+    {
+        return -1;
+    }
+
+    for (size_t i = 0, capacity = dispatcher->sessions.capacity; i < capacity; i++)
+    {
+        aeron_data_packet_dispatcher_session_entry_t *entry = &dispatcher->sessions.entries[i];
+
+        if (NULL != entry->value)
+        {
+            size_t index = aeron_data_packet_dispatcher_session_index(entry->session_id, entry->stream_id, shift);
+
+            while (NULL != entries[index].value)
+            {
+                index = (index + 1) & mask;
+            }
+
+            entries[index] = *entry;
+        }
+    }
+
+    aeron_free(dispatcher->sessions.entries);
+    dispatcher->sessions.entries = entries;
+    dispatcher->sessions.capacity = new_capacity;
+    dispatcher->sessions.shift = shift;
 
     return 0;
 }
 
-int aeron_data_packet_dispatcher_add_subscription(aeron_data_packet_dispatcher_t *dispatcher, int32_t stream_id)
+static int aeron_data_packet_dispatcher_session_put(
+    aeron_data_packet_dispatcher_t *dispatcher, int32_t session_id, int32_t stream_id, void *value)
+{
+    if ((dispatcher->sessions.size + 1) * 2 > dispatcher->sessions.capacity &&
+        aeron_data_packet_dispatcher_sessions_rehash(dispatcher, dispatcher->sessions.capacity << 1) < 0)
+    {
+        return -1;
+    }
+
+    const size_t mask = dispatcher->sessions.capacity - 1;
+    size_t index = aeron_data_packet_dispatcher_session_index(session_id, stream_id, dispatcher->sessions.shift);
+    aeron_data_packet_dispatcher_session_entry_t *entry;
+
+    while (NULL != (entry = &dispatcher->sessions.entries[index])->value)
+    {
+        if (session_id == entry->session_id && stream_id == entry->stream_id)
+        {
+            entry->value = value;
+            return 0;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    entry->session_id = session_id;
+    entry->stream_id = stream_id;
+    entry->value = value;
+    dispatcher->sessions.size++;
+
+    return 0;
+}
+
+/* empty the entry and move back any later in its probe sequence that may then go closer to where they hash to */
+static void aeron_data_packet_dispatcher_sessions_compact_chain(
+    aeron_data_packet_dispatcher_t *dispatcher, size_t delete_index)
 {
-    aeron_int64_to_ptr_hash_map_t *session_map;
+    aeron_data_packet_dispatcher_session_entry_t *entries = dispatcher->sessions.entries;
+    const size_t mask = dispatcher->sessions.capacity - 1;
+    size_t index = delete_index;
 
-    if ((session_map = aeron_int64_to_ptr_hash_map_get(&dispatcher->session_by_stream_id_map, stream_id)) == NULL)
+    entries[delete_index].value = NULL;
+    dispatcher->sessions.size--;
+
+    while (true)
     {
-        if (aeron_alloc((void **)&session_map, sizeof(aeron_int64_to_ptr_hash_map_t)) < 0 ||
-            aeron_int64_to_ptr_hash_map_init(session_map, 16, AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0 ||
-            aeron_int64_to_ptr_hash_map_put(&dispatcher->session_by_stream_id_map, stream_id, session_map) < 0)
+        index = (index + 1) & mask;
+        if (NULL == entries[index].value)
         {
-            int errcode = errno;
+            break;
+        }
 
-            aeron_set_err(errcode, "could not aeron_data_packet_dispatcher_add_subscription: %s", strerror(errcode));
-            return -1;
+        size_t hash = aeron_data_packet_dispatcher_session_index(
+            entries[index].session_id, entries[index].stream_id, dispatcher->sessions.shift);
+
+        if ((index < hash && (hash <= delete_index || delete_index <= index)) ||
+            (hash <= delete_index && delete_index <= index))
+        {
+            entries[delete_index] = entries[index];
+            entries[index].value = NULL;
+            delete_index = index;
         }
     }
+}
+
+void *aeron_data_packet_dispatcher_session_remove(
+    aeron_data_packet_dispatcher_t *dispatcher, int32_t session_id, int32_t stream_id)
+{
+    const size_t mask = dispatcher->sessions.capacity - 1;
+    size_t index = aeron_data_packet_dispatcher_session_index(session_id, stream_id, dispatcher->sessions.shift);
+    aeron_data_packet_dispatcher_session_entry_t *entry;
+
+    while (NULL != (entry = &dispatcher->sessions.entries[index])->value)
+    {
+        if (session_id == entry->session_id && stream_id == entry->stream_id)
+        {
+            void *value = entry->value;
+
+            aeron_data_packet_dispatcher_sessions_compact_chain(dispatcher, index);
+            return value;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    return NULL;
+}
+
+int aeron_data_packet_dispatcher_add_subscription(aeron_data_packet_dispatcher_t *dispatcher, int32_t stream_id)
+{
+    if (NULL == aeron_int64_to_ptr_hash_map_get(&dispatcher->subscribed_streams_map, stream_id) &&
+        aeron_int64_to_ptr_hash_map_put(
+            &dispatcher->subscribed_streams_map, stream_id, &dispatcher->tokens.subscribed) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "could not aeron_data_packet_dispatcher_add_subscription: %s", strerror(errcode));
+        return -1;
+    }
 
     return 0;
 }
 
 int aeron_data_packet_dispatcher_remove_subscription(aeron_data_packet_dispatcher_t *dispatcher, int32_t stream_id)
 {
-    aeron_int64_to_ptr_hash_map_t *session_map;
-
-    if ((session_map = aeron_int64_to_ptr_hash_map_remove(&dispatcher->session_by_stream_id_map, stream_id)) != NULL)
+    if (NULL != aeron_int64_to_ptr_hash_map_remove(&dispatcher->subscribed_streams_map, stream_id))
     {
-        aeron_int64_to_ptr_hash_map_delete(session_map);
-        aeron_free(session_map);
+        /* compacting may move a later entry into the one just emptied, so look at it again before moving on */
+        for (size_t i = 0; i < dispatcher->sessions.capacity;)
+        {
+            aeron_data_packet_dispatcher_session_entry_t *entry = &dispatcher->sessions.entries[i];
+
+            if (NULL != entry->value && stream_id == entry->stream_id &&
+                !aeron_data_packet_dispatcher_is_token(dispatcher, entry->value))
+            {
+                aeron_data_packet_dispatcher_sessions_compact_chain(dispatcher, i);
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        dispatcher->hot_image = NULL;
     }
 
     return 0;
@@ -101,12 +229,10 @@ int aeron_data_packet_dispatcher_remove_subscription(aeron_data_packet_dispatche
 int aeron_data_packet_dispatcher_add_publication_image(
     aeron_data_packet_dispatcher_t *dispatcher, aeron_publication_image_t *image)
 {
-    aeron_int64_to_ptr_hash_map_t *session_map =
-        aeron_int64_to_ptr_hash_map_get(&dispatcher->session_by_stream_id_map, image->stream_id);
-
-    if (NULL != session_map)
+    if (NULL != aeron_int64_to_ptr_hash_map_get(&dispatcher->subscribed_streams_map, image->stream_id))
     {
-        if (aeron_int64_to_ptr_hash_map_put(session_map, image->session_id, image) < 0)
+        /* takes the place of any token the session was ignored with */
+        if (aeron_data_packet_dispatcher_session_put(dispatcher, image->session_id, image->stream_id, image) < 0)
         {
             int errcode = errno;
 
@@ -114,9 +240,7 @@ int aeron_data_packet_dispatcher_add_publication_image(
             return -1;
         }
 
-        aeron_int64_to_ptr_hash_map_remove(
-            &dispatcher->ignored_sessions_map,
-            aeron_int64_to_ptr_hash_map_compound_key(image->session_id, image->stream_id));
+        dispatcher->hot_image = NULL;
     }
 
     return 0;
@@ -125,27 +249,23 @@ int aeron_data_packet_dispatcher_add_publication_image(
 int aeron_data_packet_dispatcher_remove_publication_image(
     aeron_data_packet_dispatcher_t *dispatcher, aeron_publication_image_t *image)
 {
-    aeron_int64_to_ptr_hash_map_t *session_map =
-        aeron_int64_to_ptr_hash_map_get(&dispatcher->session_by_stream_id_map, image->stream_id);
+    void *value = aeron_data_packet_dispatcher_session_get(dispatcher, image->session_id, image->stream_id);
 
-    if (NULL != session_map)
+    if (dispatcher->hot_image == image)
     {
-        aeron_publication_image_t *mapped_image = aeron_int64_to_ptr_hash_map_get(session_map, image->session_id);
+        dispatcher->hot_image = NULL;
+    }
 
-        if (NULL != mapped_image &&
-            image->conductor_fields.managed_resource.registration_id == mapped_image->conductor_fields.managed_resource.registration_id)
-        {
-            aeron_int64_to_ptr_hash_map_remove(session_map, image->session_id);
-            aeron_int64_to_ptr_hash_map_remove(
-                &dispatcher->ignored_sessions_map,
-                aeron_int64_to_ptr_hash_map_compound_key(image->session_id, image->stream_id));
-        }
+    /* a newer image for the same session stays mapped, and goes on cool down in turn when it is removed */
+    if (NULL != value && !aeron_data_packet_dispatcher_is_token(dispatcher, value) &&
+        image->conductor_fields.managed_resource.registration_id !=
+        ((aeron_publication_image_t *)value)->conductor_fields.managed_resource.registration_id)
+    {
+        return 0;
     }
 
-    if (aeron_int64_to_ptr_hash_map_put(
-        &dispatcher->ignored_sessions_map,
-        aeron_int64_to_ptr_hash_map_compound_key(image->session_id, image->stream_id),
-        &dispatcher->tokens.on_cool_down) < 0)
+    if (aeron_data_packet_dispatcher_session_put(
+        dispatcher, image->session_id, image->stream_id, &dispatcher->tokens.on_cool_down) < 0)
     {
         int errcode = errno;
 
@@ -164,28 +284,30 @@ int aeron_data_packet_dispatcher_on_data(
     size_t length,
     struct sockaddr_storage *addr)
 {
-    aeron_int64_to_ptr_hash_map_t *session_map =
-        aeron_int64_to_ptr_hash_map_get(&dispatcher->session_by_stream_id_map, header->stream_id);
+    aeron_publication_image_t *image = dispatcher->hot_image;
 
-    if (NULL != session_map)
+    if (NULL == image || header->session_id != image->session_id || header->stream_id != image->stream_id)
     {
-        aeron_publication_image_t *image = aeron_int64_to_ptr_hash_map_get(session_map, header->session_id);
+        void *value = aeron_data_packet_dispatcher_session_get(dispatcher, header->session_id, header->stream_id);
 
-        if (NULL != image)
-        {
-            return aeron_publication_image_insert_packet(image, header->term_id, header->term_offset, buffer, length);
-        }
-        else if (NULL == aeron_int64_to_ptr_hash_map_get(
-            &dispatcher->ignored_sessions_map,
-            aeron_int64_to_ptr_hash_map_compound_key(header->session_id, header->stream_id)) &&
-            (((aeron_frame_header_t *)buffer)->flags & AERON_DATA_HEADER_EOS_FLAG) == 0)
+        if (NULL == value || aeron_data_packet_dispatcher_is_token(dispatcher, value))
         {
-            return aeron_data_packet_dispatcher_elicit_setup_from_source(
-                dispatcher, endpoint, addr, header->stream_id, header->session_id);
+            if (NULL == value &&
+                (((aeron_frame_header_t *)buffer)->flags & AERON_DATA_HEADER_EOS_FLAG) == 0 &&
+                NULL != aeron_int64_to_ptr_hash_map_get(&dispatcher->subscribed_streams_map, header->stream_id))
+            {
+                return aeron_data_packet_dispatcher_elicit_setup_from_source(
+                    dispatcher, endpoint, addr, header->stream_id, header->session_id);
+            }
+
+            return 0;
         }
+
+        image = (aeron_publication_image_t *)value;
+        dispatcher->hot_image = image;
     }
 
-    return 0;
+    return aeron_publication_image_insert_packet(image, header->term_id, header->term_offset, buffer, length);
 }
 
 int aeron_data_packet_dispatcher_on_setup(
@@ -196,27 +318,21 @@ int aeron_data_packet_dispatcher_on_setup(
     size_t length,
     struct sockaddr_storage *addr)
 {
-    aeron_int64_to_ptr_hash_map_t *session_map =
-        aeron_int64_to_ptr_hash_map_get(&dispatcher->session_by_stream_id_map, header->stream_id);
-
-    if (NULL != session_map)
+    if (NULL != aeron_int64_to_ptr_hash_map_get(&dispatcher->subscribed_streams_map, header->stream_id))
     {
-        aeron_publication_image_t *image = aeron_int64_to_ptr_hash_map_get(session_map, header->session_id);
+        void *value = aeron_data_packet_dispatcher_session_get(dispatcher, header->session_id, header->stream_id);
 
-        if (NULL == image &&
-            aeron_data_packet_dispatcher_is_not_already_in_progress_or_on_cool_down(
-                dispatcher, header->stream_id, header->session_id))
+        if (NULL == value || &dispatcher->tokens.pending_setup_frame == value)
         {
             if (endpoint->conductor_fields.udp_channel->multicast &&
                 endpoint->conductor_fields.udp_channel->multicast_ttl < header->ttl)
             {
-                aeron_counter_ordered_increment(endpoint->possible_ttl_asymmetry_counter, 1);
+                aeron_counter_shared_increment(
+                    endpoint->possible_ttl_asymmetry_counter, 1, endpoint->has_shared_system_counters);
             }
 
-            if (aeron_int64_to_ptr_hash_map_put(
-                &dispatcher->ignored_sessions_map,
-                aeron_int64_to_ptr_hash_map_compound_key(header->session_id, header->stream_id),
-                &dispatcher->tokens.init_in_progress) < 0)
+            if (aeron_data_packet_dispatcher_session_put(
+                dispatcher, header->session_id, header->stream_id, &dispatcher->tokens.init_in_progress) < 0)
             {
                 int errcode = errno;
 
@@ -253,27 +369,23 @@ int aeron_data_packet_dispatcher_on_rttm(
     size_t length,
     struct sockaddr_storage *addr)
 {
-    aeron_int64_to_ptr_hash_map_t *session_map =
-        aeron_int64_to_ptr_hash_map_get(&dispatcher->session_by_stream_id_map, header->stream_id);
+    void *value = aeron_data_packet_dispatcher_session_get(dispatcher, header->session_id, header->stream_id);
 
-    if (NULL != session_map)
+    if (NULL != value && !aeron_data_packet_dispatcher_is_token(dispatcher, value))
     {
-        aeron_publication_image_t *image = aeron_int64_to_ptr_hash_map_get(session_map, header->session_id);
+        aeron_publication_image_t *image = (aeron_publication_image_t *)value;
 
-        if (NULL != image)
+        if (header->frame_header.flags & AERON_RTTM_HEADER_REPLY_FLAG)
         {
-            if (header->frame_header.flags & AERON_RTTM_HEADER_REPLY_FLAG)
-            {
-                struct sockaddr_storage *control_addr =
-                    endpoint->conductor_fields.udp_channel->multicast ? &endpoint->conductor_fields.udp_channel->remote_control : addr;
+            struct sockaddr_storage *control_addr =
+                endpoint->conductor_fields.udp_channel->multicast ? &endpoint->conductor_fields.udp_channel->remote_control : addr;
 
-                return aeron_receive_channel_endpoint_send_rttm(
-                    endpoint, control_addr, header->stream_id, header->session_id, header->echo_timestamp, 0, false);
-            }
-            else
-            {
-                return aeron_publication_image_on_rttm(image, header, addr);
-            }
+            return aeron_receive_channel_endpoint_send_rttm(
+                endpoint, control_addr, header->stream_id, header->session_id, header->echo_timestamp, 0, false);
+        }
+        else
+        {
+            return aeron_publication_image_on_rttm(image, header, addr);
         }
     }
 
@@ -290,10 +402,8 @@ int aeron_data_packet_dispatcher_elicit_setup_from_source(
     struct sockaddr_storage *control_addr =
         endpoint->conductor_fields.udp_channel->multicast ? &endpoint->conductor_fields.udp_channel->remote_control : addr;
 
-    if (aeron_int64_to_ptr_hash_map_put(
-        &dispatcher->ignored_sessions_map,
-        aeron_int64_to_ptr_hash_map_compound_key(session_id, stream_id),
-        &dispatcher->tokens.pending_setup_frame) < 0)
+    if (aeron_data_packet_dispatcher_session_put(
+        dispatcher, session_id, stream_id, &dispatcher->tokens.pending_setup_frame) < 0)
     {
         int errcode = errno;
 
@@ -310,6 +420,10 @@ int aeron_data_packet_dispatcher_elicit_setup_from_source(
     return aeron_driver_receiver_add_pending_setup(dispatcher->receiver, endpoint, session_id, stream_id, NULL);
 }
 
+extern size_t aeron_data_packet_dispatcher_session_index(int32_t session_id, int32_t stream_id, size_t shift);
+extern void *aeron_data_packet_dispatcher_session_get(
+    aeron_data_packet_dispatcher_t *dispatcher, int32_t session_id, int32_t stream_id);
+extern bool aeron_data_packet_dispatcher_is_token(aeron_data_packet_dispatcher_t *dispatcher, const void *value);
 extern bool aeron_data_packet_dispatcher_is_not_already_in_progress_or_on_cool_down(
     aeron_data_packet_dispatcher_t *dispatcher, int32_t stream_id, int32_t session_id);
 extern int aeron_data_packet_dispatcher_remove_pending_setup(
@@ -25,17 +25,45 @@ typedef struct aeron_publication_image_stct aeron_publication_image_t;
 typedef struct aeron_receive_channel_endpoint_stct aeron_receive_channel_endpoint_t;
 typedef struct aeron_driver_receiver_stct aeron_driver_receiver_t;
 
+#define AERON_DATA_PACKET_DISPATCHER_SESSIONS_INITIAL_CAPACITY (64)
+
+typedef struct aeron_data_packet_dispatcher_session_entry_stct
+{
+    int32_t session_id;
+    int32_t stream_id;
+    void *value;
+}
+aeron_data_packet_dispatcher_session_entry_t;
+
 typedef struct aeron_data_packet_dispatcher_stct
 {
-    aeron_int64_to_ptr_hash_map_t ignored_sessions_map;
-    aeron_int64_to_ptr_hash_map_t session_by_stream_id_map;
+    /*
+     * Open addressed on (session id, stream id) with linear probing and at most half full. Each entry holds either the
+     * image for the session or one of the tokens while it is ignored, so a data frame is matched with one probe over
+     * adjacent entries rather than a map per stream and another for ignored sessions.
+     */
+    struct aeron_data_packet_dispatcher_sessions_stct
+    {
+        aeron_data_packet_dispatcher_session_entry_t *entries;
+        size_t capacity;
+        size_t shift;
+        size_t size;
+    }
+    sessions;
+
+    /* stream ids subscribed to on the endpoint, only sessions of these are set up */
+    aeron_int64_to_ptr_hash_map_t subscribed_streams_map;
 
-    /* tombstones for PENDING_SETUP_FRAME, INIT_IN_PROGRESS, and ON_COOL_DOWN */
+    /* the image the last data frame went to, as frames for one session tend to come in runs */
+    aeron_publication_image_t *hot_image;
+
+    /* tombstones for PENDING_SETUP_FRAME, INIT_IN_PROGRESS, and ON_COOL_DOWN, and the value of subscribed streams */
     struct aeron_data_packet_dispatcher_tokens_stct
     {
         int pending_setup_frame;
         int init_in_progress;
         int on_cool_down;
+        int subscribed;
     }
     tokens;
 
@@ -89,11 +117,47 @@ int aeron_data_packet_dispatcher_elicit_setup_from_source(
     int32_t stream_id,
     int32_t session_id);
 
+/* Fibonacci hashing, taking the top bits of the product as they depend on every bit of both ids */
+inline size_t aeron_data_packet_dispatcher_session_index(int32_t session_id, int32_t stream_id, size_t shift)
+{
+    const uint64_t key = ((uint64_t)(uint32_t)session_id << 32) | (uint32_t)stream_id;
+
+    return (size_t)((key * UINT64_C(0x9E3779B97F4A7C15)) >> shift);
+}
+
+inline void *aeron_data_packet_dispatcher_session_get(
+    aeron_data_packet_dispatcher_t *dispatcher, int32_t session_id, int32_t stream_id)
+{
+    const size_t mask = dispatcher->sessions.capacity - 1;
+    size_t index = aeron_data_packet_dispatcher_session_index(session_id, stream_id, dispatcher->sessions.shift);
+    aeron_data_packet_dispatcher_session_entry_t *entry;
+
+    while (NULL != (entry = &dispatcher->sessions.entries[index])->value)
+    {
+        if (session_id == entry->session_id && stream_id == entry->stream_id)
+        {
+            return entry->value;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    return NULL;
+}
+
+void *aeron_data_packet_dispatcher_session_remove(
+    aeron_data_packet_dispatcher_t *dispatcher, int32_t session_id, int32_t stream_id);
+
+inline bool aeron_data_packet_dispatcher_is_token(aeron_data_packet_dispatcher_t *dispatcher, const void *value)
+{
+    return (const uint8_t *)value >= (const uint8_t *)&dispatcher->tokens &&
+        (const uint8_t *)value < (const uint8_t *)(&dispatcher->tokens + 1);
+}
+
 inline bool aeron_data_packet_dispatcher_is_not_already_in_progress_or_on_cool_down(
     aeron_data_packet_dispatcher_t *dispatcher, int32_t stream_id, int32_t session_id)
 {
-    void *status = aeron_int64_to_ptr_hash_map_get(&dispatcher->ignored_sessions_map,
-        aeron_int64_to_ptr_hash_map_compound_key(session_id, stream_id));
+    void *status = aeron_data_packet_dispatcher_session_get(dispatcher, session_id, stream_id);
 
     return (&dispatcher->tokens.init_in_progress != status && &dispatcher->tokens.on_cool_down != status);
 }
@@ -101,13 +165,11 @@ inline bool aeron_data_packet_dispatcher_is_not_already_in_progress_or_on_cool_d
 inline int aeron_data_packet_dispatcher_remove_pending_setup(
     aeron_data_packet_dispatcher_t *dispatcher, int32_t session_id, int32_t stream_id)
 {
-    const void *status = aeron_int64_to_ptr_hash_map_get(&dispatcher->ignored_sessions_map,
-        aeron_int64_to_ptr_hash_map_compound_key(session_id, stream_id));
+    const void *status = aeron_data_packet_dispatcher_session_get(dispatcher, session_id, stream_id);
 
     if (status == &dispatcher->tokens.pending_setup_frame)
     {
-        aeron_int64_to_ptr_hash_map_remove(&dispatcher->ignored_sessions_map,
-            aeron_int64_to_ptr_hash_map_compound_key(session_id, stream_id));
+        aeron_data_packet_dispatcher_session_remove(dispatcher, session_id, stream_id);
     }
 
     return 0;
@@ -116,13 +178,11 @@ inline int aeron_data_packet_dispatcher_remove_pending_setup(
 inline int aeron_data_packet_dispatcher_remove_cool_down(
     aeron_data_packet_dispatcher_t *dispatcher, int32_t session_id, int32_t stream_id)
 {
-    const void *status = aeron_int64_to_ptr_hash_map_get(&dispatcher->ignored_sessions_map,
-        aeron_int64_to_ptr_hash_map_compound_key(session_id, stream_id));
+    const void *status = aeron_data_packet_dispatcher_session_get(dispatcher, session_id, stream_id);
 
     if (status == &dispatcher->tokens.on_cool_down)
     {
-        aeron_int64_to_ptr_hash_map_remove(&dispatcher->ignored_sessions_map,
-            aeron_int64_to_ptr_hash_map_compound_key(session_id, stream_id));
+        aeron_data_packet_dispatcher_session_remove(dispatcher, session_id, stream_id);
     }
 
     return 0;
@@ -130,7 +190,7 @@ inline int aeron_data_packet_dispatcher_remove_cool_down(
 
 inline bool aeron_data_packet_dispatcher_should_elicit_setup_message(aeron_data_packet_dispatcher_t *dispatcher)
 {
-    return (0 != dispatcher->session_by_stream_id_map.size);
+    return (0 != dispatcher->subscribed_streams_map.size);
 }
 
 #endif //AERON_DATA_PACKET_DISPATCHER_H
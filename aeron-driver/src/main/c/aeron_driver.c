@@ -108,6 +108,24 @@ int64_t aeron_epoch_clock()
     return (ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
 }
 
+int64_t aeron_epoch_nano_clock()
+{
+    struct timespec ts;
+#if defined(AERON_COMPILER_MSVC)
+    if (aeron_clock_gettime_realtime(&ts) < 0)
+    {
+        return -1;
+    }
+#else
+    if (clock_gettime(CLOCK_REALTIME, &ts) < 0)
+    {
+        return -1;
+    }
+#endif
+
+    return ((int64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
 extern int aeron_number_of_trailing_zeroes(int32_t value);
 extern int aeron_number_of_leading_zeroes(int32_t value);
 extern int32_t aeron_find_next_power_of_two(int32_t value);
@@ -287,6 +305,17 @@ int aeron_driver_ensure_dir_is_recreated(aeron_driver_t *driver)
         return -1;
     }
 
+    if (driver->context->raw_log_pool_depth > 0)
+    {
+        snprintf(buffer, sizeof(buffer) - 1, "%s/%s", dirname, AERON_RAW_LOG_POOL_DIR);
+        if (mkdir(buffer, S_IRWXU) != 0)
+        {
+            int errcode = errno;
+            aeron_set_err(errcode, "mkdir %s: %s", buffer, strerror(errcode));
+            return -1;
+        }
+    }
+
     return 0;
 }
 
@@ -319,12 +348,22 @@ int aeron_driver_create_cnc_file(aeron_driver_t *driver)
 
     snprintf(buffer, sizeof(buffer) - 1, "%s/%s", driver->context->aeron_dir, AERON_CNC_FILE);
 
-    if (aeron_map_new_file(&driver->context->cnc_map, buffer, true) < 0)
+    if (aeron_map_new_file(&driver->context->cnc_map, buffer, !driver->context->cnc_huge_pages) < 0)
     {
         aeron_set_err(aeron_errcode(), "could not map CnC file: %s", aeron_errmsg());
         return -1;
     }
 
+    if (driver->context->cnc_huge_pages)
+    {
+        if (aeron_mapped_file_advise_huge_pages(&driver->context->cnc_map) < 0)
+        {
+            fprintf(stderr, "WARNING: could not advise huge pages for CnC file: %s\n", aeron_errmsg());
+        }
+
+        aeron_mapped_file_touch_pages(&driver->context->cnc_map, (size_t)driver->context->file_page_size);
+    }
+
     aeron_driver_fill_cnc_metadata(driver->context);
 
     return 0;
@@ -349,6 +388,102 @@ int aeron_driver_create_loss_report_file(aeron_driver_t *driver)
     return 0;
 }
 
+int aeron_driver_validate_huge_pages(aeron_driver_t *driver)
+{
+    int64_t huge_page_size = aeron_hugetlbfs_page_size(driver->context->aeron_dir);
+
+    if (huge_page_size < 0)
+    {
+        return -1;
+    }
+
+    if (huge_page_size > 0 && (driver->context->file_page_size % (uint64_t)huge_page_size) != 0)
+    {
+        aeron_set_err(
+            EINVAL,
+            "%s is on hugetlbfs with page size %" PRId64 ", set %s to a multiple of it: page size=%" PRIu64,
+            driver->context->aeron_dir,
+            huge_page_size,
+            AERON_FILE_PAGE_SIZE_ENV_VAR,
+            driver->context->file_page_size);
+        return -1;
+    }
+
+    return 0;
+}
+
+void aeron_driver_report_huge_page_length(const char *name, aeron_mapped_file_t *mapped_file)
+{
+    int64_t huge_page_length = aeron_mapped_file_huge_page_length(mapped_file);
+
+    if (huge_page_length < 0)
+    {
+        fprintf(stderr, "WARNING: could not determine huge page usage of %s: %s\n", name, aeron_errmsg());
+    }
+    else if (0 == huge_page_length)
+    {
+        fprintf(
+            stderr,
+            "WARNING: %s requested huge pages but none were obtained, check "
+            "/sys/kernel/mm/transparent_hugepage/shmem_enabled or place aeron.dir on hugetlbfs\n",
+            name);
+    }
+    else
+    {
+        fprintf(
+            stderr,
+            "INFO: %s backed by huge pages: %" PRId64 " of %" PRIu64 " bytes\n",
+            name,
+            huge_page_length,
+            (uint64_t)mapped_file->length);
+    }
+}
+
+/*
+ * Term buffers are mapped on demand so a throwaway log is mapped the same way to see what the kernel actually gives.
+ */
+int aeron_driver_report_huge_pages(aeron_driver_t *driver)
+{
+    aeron_driver_context_t *context = driver->context;
+    char buffer[AERON_MAX_PATH];
+
+    if (context->cnc_huge_pages)
+    {
+        aeron_driver_report_huge_page_length("CnC file", &context->cnc_map);
+    }
+
+    if (context->term_buffer_huge_pages)
+    {
+        aeron_mapped_raw_log_t probe;
+        int64_t huge_page_size = aeron_hugetlbfs_page_size(context->aeron_dir);
+
+        if (huge_page_size > 0)
+        {
+            fprintf(stderr, "INFO: term buffers on hugetlbfs with page size %" PRId64 "\n", huge_page_size);
+            return 0;
+        }
+
+        snprintf(
+            buffer, sizeof(buffer) - 1, "%s/%s/huge-page-probe.logbuffer", context->aeron_dir, AERON_PUBLICATIONS_DIR);
+
+        if (aeron_map_raw_log(
+            &probe, buffer, false, true, AERON_DRIVER_HUGE_PAGE_PROBE_TERM_LENGTH, context->file_page_size, -1) < 0)
+        {
+            aeron_set_err(aeron_errcode(), "could not map huge page probe log: %s", aeron_errmsg());
+            return -1;
+        }
+
+        aeron_driver_report_huge_page_length("term buffers", &probe.mapped_file);
+
+        if (aeron_map_raw_log_close(&probe, buffer) < 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 int aeron_driver_validate_sufficient_socket_buffer_lengths(aeron_driver_t *driver)
 {
     int result = -1, probe_fd;
@@ -599,6 +734,12 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
         goto error;
     }
 
+    if (_driver->context->io_uring_enabled &&
+        aeron_driver_context_validate_io_uring_entries(_driver->context->io_uring_entries) < 0)
+    {
+        goto error;
+    }
+
     if (aeron_driver_validate_sufficient_socket_buffer_lengths(_driver) < 0)
     {
         goto error;
@@ -611,6 +752,11 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
         goto error;
     }
 
+    if (aeron_driver_validate_huge_pages(_driver) < 0)
+    {
+        goto error;
+    }
+
     if (aeron_driver_create_cnc_file(_driver) < 0)
     {
         goto error;
@@ -621,6 +767,72 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
         goto error;
     }
 
+    if (aeron_driver_report_huge_pages(_driver) < 0)
+    {
+        goto error;
+    }
+
+    if (_driver->context->raw_log_pool_depth > 0)
+    {
+        /* network publications and images are bound to the node of the sender and receiver, IPC ones are not */
+        const uint64_t term_lengths[] =
+        {
+            _driver->context->term_buffer_length,
+            _driver->context->term_buffer_length,
+            _driver->context->ipc_term_buffer_length
+        };
+        const int32_t numa_nodes[] =
+        {
+            _driver->context->sender_numa_node, _driver->context->receiver_numa_node, -1
+        };
+
+        if (aeron_raw_log_pool_init(
+            &_driver->context->raw_log_pool,
+            _driver->context->aeron_dir,
+            term_lengths,
+            numa_nodes,
+            sizeof(term_lengths) / sizeof(term_lengths[0]),
+            _driver->context->raw_log_pool_depth,
+            _driver->context->file_page_size,
+            _driver->context->term_buffer_huge_pages) < 0)
+        {
+            goto error;
+        }
+    }
+
+    if ('\0' != _driver->context->xdp_interface[0])
+    {
+        if (_driver->context->io_uring_enabled)
+        {
+            aeron_set_err(EINVAL, "%s", "aeron.xdp.interface is not supported with io_uring");
+            goto error;
+        }
+
+        /* the receiver owns the RX side of the one socket and the sender the TX side */
+        if (AERON_THREADING_MODE_DEDICATED == _driver->context->threading_mode &&
+            (_driver->context->sender_count > 1 || _driver->context->receiver_count > 1))
+        {
+            aeron_set_err(EINVAL, "%s", "aeron.xdp.interface requires a single sender and receiver");
+            goto error;
+        }
+
+        /* AF_XDP delivers to a transport by port, which the sockets of a fan-out would all share */
+        if (_driver->context->receiver_socket_fan_out > 1)
+        {
+            aeron_set_err(EINVAL, "%s", "aeron.xdp.interface is not supported with aeron.receiver.socket.fan.out");
+            goto error;
+        }
+
+        if (aeron_udp_transport_xdp_init(
+            &_driver->context->xdp,
+            _driver->context->xdp_interface,
+            _driver->context->xdp_queue,
+            _driver->context->xdp_frame_count) < 0)
+        {
+            goto error;
+        }
+    }
+
     if (aeron_driver_conductor_init(&_driver->conductor, context) < 0)
     {
         goto error;
@@ -635,6 +847,34 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
     }
 
     _driver->context->sender_proxy = &_driver->sender.sender_proxy;
+    _driver->context->sender_proxies[0] = _driver->context->sender_proxy;
+
+    if (AERON_THREADING_MODE_DEDICATED != _driver->context->threading_mode)
+    {
+        _driver->context->sender_count = 1;
+    }
+
+    if (_driver->context->sender_count > 1)
+    {
+        if (aeron_driver_sender_shard_init(&_driver->sender, &_driver->conductor.counters_manager, 0) < 0)
+        {
+            goto error;
+        }
+
+        for (size_t i = 1; i < _driver->context->sender_count; i++)
+        {
+            aeron_driver_sender_t *sender = &_driver->sender_shards[i - 1];
+
+            if (aeron_driver_sender_init(
+                sender, context, &_driver->conductor.system_counters, &_driver->conductor.error_log) < 0 ||
+                aeron_driver_sender_shard_init(sender, &_driver->conductor.counters_manager, (int32_t)i) < 0)
+            {
+                goto error;
+            }
+
+            _driver->context->sender_proxies[i] = &sender->sender_proxy;
+        }
+    }
 
     if (aeron_driver_receiver_init(
         &_driver->receiver, context, &_driver->conductor.system_counters, &_driver->conductor.error_log) < 0)
@@ -643,6 +883,34 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
     }
 
     _driver->context->receiver_proxy = &_driver->receiver.receiver_proxy;
+    _driver->context->receiver_proxies[0] = _driver->context->receiver_proxy;
+
+    if (AERON_THREADING_MODE_DEDICATED != _driver->context->threading_mode)
+    {
+        _driver->context->receiver_count = 1;
+    }
+
+    if (_driver->context->receiver_count > 1)
+    {
+        if (aeron_driver_receiver_shard_init(&_driver->receiver, &_driver->conductor.counters_manager, 0) < 0)
+        {
+            goto error;
+        }
+
+        for (size_t i = 1; i < _driver->context->receiver_count; i++)
+        {
+            aeron_driver_receiver_t *receiver = &_driver->receiver_shards[i - 1];
+
+            if (aeron_driver_receiver_init(
+                receiver, context, &_driver->conductor.system_counters, &_driver->conductor.error_log) < 0 ||
+                aeron_driver_receiver_shard_init(receiver, &_driver->conductor.counters_manager, (int32_t)i) < 0)
+            {
+                goto error;
+            }
+
+            _driver->context->receiver_proxies[i] = &receiver->receiver_proxy;
+        }
+    }
 
     aeron_mpsc_rb_consumer_heartbeat_time(&_driver->conductor.to_driver_commands, aeron_epoch_clock());
     aeron_cnc_version_signal_cnc_ready((aeron_cnc_metadata_t *)context->cnc_map.addr, AERON_CNC_VERSION);
@@ -659,7 +927,8 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
                 aeron_driver_shared_do_work,
                 aeron_driver_shared_on_close,
                 _driver->context->shared_idle_strategy_func,
-                _driver->context->shared_idle_strategy_state) < 0)
+                _driver->context->shared_idle_strategy_state,
+                &_driver->context->conductor_cpu_affinity) < 0)
             {
                 goto error;
             }
@@ -675,7 +944,8 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
                 aeron_driver_conductor_do_work,
                 aeron_driver_conductor_on_close,
                 _driver->context->conductor_idle_strategy_func,
-                _driver->context->conductor_idle_strategy_state) < 0)
+                _driver->context->conductor_idle_strategy_state,
+                &_driver->context->conductor_cpu_affinity) < 0)
             {
                 goto error;
             }
@@ -689,7 +959,8 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
                 aeron_driver_shared_network_do_work,
                 aeron_driver_shared_network_on_close,
                 _driver->context->shared_network_idle_strategy_func,
-                _driver->context->shared_network_idle_strategy_state) < 0)
+                _driver->context->shared_network_idle_strategy_state,
+                &_driver->context->sender_cpu_affinity) < 0)
             {
                 goto error;
             }
@@ -706,7 +977,8 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
                 aeron_driver_conductor_do_work,
                 aeron_driver_conductor_on_close,
                 _driver->context->conductor_idle_strategy_func,
-                _driver->context->conductor_idle_strategy_state) < 0)
+                _driver->context->conductor_idle_strategy_state,
+                &_driver->context->conductor_cpu_affinity) < 0)
             {
                 goto error;
             }
@@ -720,11 +992,34 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
                 aeron_driver_sender_do_work,
                 aeron_driver_sender_on_close,
                 _driver->context->sender_idle_strategy_func,
-                _driver->context->sender_idle_strategy_state) < 0)
+                _driver->context->sender_idle_strategy_state,
+                &_driver->context->sender_cpu_affinity) < 0)
             {
                 goto error;
             }
 
+            for (size_t i = 1; i < _driver->context->sender_count; i++)
+            {
+                char role_name[16];
+
+                snprintf(role_name, sizeof(role_name), "sender-%d", (int)i);
+
+                if (aeron_agent_init(
+                    &_driver->runners[AERON_AGENT_RUNNER_SENDER_SHARDS + i - 1],
+                    role_name,
+                    &_driver->sender_shards[i - 1],
+                    _driver->context->agent_on_start_func,
+                    _driver->context->agent_on_start_state,
+                    aeron_driver_sender_do_work,
+                    aeron_driver_sender_on_close,
+                    _driver->context->sender_idle_strategy_func,
+                    _driver->context->sender_shard_idle_strategy_states[i],
+                    &_driver->context->sender_cpu_affinity) < 0)
+                {
+                    goto error;
+                }
+            }
+
             if (aeron_agent_init(
                 &_driver->runners[AERON_AGENT_RUNNER_RECEIVER],
                 "receiver",
@@ -734,13 +1029,54 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
                 aeron_driver_receiver_do_work,
                 aeron_driver_receiver_on_close,
                 _driver->context->receiver_idle_strategy_func,
-                _driver->context->receiver_idle_strategy_state) < 0)
+                _driver->context->receiver_idle_strategy_state,
+                &_driver->context->receiver_cpu_affinity) < 0)
             {
                 goto error;
             }
+
+            for (size_t i = 1; i < _driver->context->receiver_count; i++)
+            {
+                char role_name[16];
+
+                snprintf(role_name, sizeof(role_name), "receiver-%d", (int)i);
+
+                if (aeron_agent_init(
+                    &_driver->runners[AERON_AGENT_RUNNER_RECEIVER_SHARDS + i - 1],
+                    role_name,
+                    &_driver->receiver_shards[i - 1],
+                    _driver->context->agent_on_start_func,
+                    _driver->context->agent_on_start_state,
+                    aeron_driver_receiver_do_work,
+                    aeron_driver_receiver_on_close,
+                    _driver->context->receiver_idle_strategy_func,
+                    _driver->context->receiver_shard_idle_strategy_states[i],
+                    &_driver->context->receiver_cpu_affinity) < 0)
+                {
+                    goto error;
+                }
+            }
             break;
     }
 
+    if (_driver->context->term_cleaner_dedicated)
+    {
+        if (aeron_agent_init(
+            &_driver->runners[AERON_AGENT_RUNNER_TERM_CLEANER],
+            "term-cleaner",
+            &_driver->conductor.term_cleaner,
+            aeron_term_cleaner_on_start,
+            _driver->context,
+            aeron_term_cleaner_do_work,
+            NULL,
+            _driver->context->term_cleaner_idle_strategy_func,
+            _driver->context->term_cleaner_idle_strategy_state,
+            NULL) < 0)
+        {
+            goto error;
+        }
+    }
+
     *driver = _driver;
     return 0;
 
@@ -748,6 +1084,8 @@ int aeron_driver_init(aeron_driver_t **driver, aeron_driver_context_t *context)
 
     if (NULL != _driver)
     {
+        aeron_raw_log_pool_close(_driver->context->raw_log_pool);
+        _driver->context->raw_log_pool = NULL;
         aeron_free(_driver);
     }
 
@@ -843,6 +1181,22 @@ int aeron_driver_close(aeron_driver_t *driver)
         }
     }
 
+    for (size_t i = 1; i < driver->context->sender_count; i++)
+    {
+        aeron_driver_sender_shard_close(&driver->sender_shards[i - 1]);
+    }
+
+    for (size_t i = 1; i < driver->context->receiver_count; i++)
+    {
+        aeron_driver_receiver_shard_close(&driver->receiver_shards[i - 1]);
+    }
+
+    aeron_raw_log_pool_close(driver->context->raw_log_pool);
+    driver->context->raw_log_pool = NULL;
+
+    aeron_udp_transport_xdp_close(driver->context->xdp);
+    driver->context->xdp = NULL;
+
     aeron_free(driver);
     return 0;
 }
@@ -28,14 +28,21 @@
 #define AERON_AGENT_RUNNER_RECEIVER 2
 #define AERON_AGENT_RUNNER_SHARED_NETWORK 1
 #define AERON_AGENT_RUNNER_SHARED 0
-#define AERON_AGENT_RUNNER_MAX 3
+#define AERON_AGENT_RUNNER_TERM_CLEANER 3
+#define AERON_AGENT_RUNNER_RECEIVER_SHARDS 4
+#define AERON_AGENT_RUNNER_SENDER_SHARDS (AERON_AGENT_RUNNER_RECEIVER_SHARDS + AERON_DRIVER_RECEIVER_COUNT_MAX - 1)
+#define AERON_AGENT_RUNNER_MAX (AERON_AGENT_RUNNER_SENDER_SHARDS + AERON_DRIVER_SENDER_COUNT_MAX - 1)
+
+#define AERON_DRIVER_HUGE_PAGE_PROBE_TERM_LENGTH (2 * 1024 * 1024)
 
 typedef struct aeron_driver_stct
 {
     aeron_driver_context_t *context;
     aeron_driver_conductor_t conductor;
     aeron_driver_sender_t sender;
+    aeron_driver_sender_t sender_shards[AERON_DRIVER_SENDER_COUNT_MAX - 1];
     aeron_driver_receiver_t receiver;
+    aeron_driver_receiver_t receiver_shards[AERON_DRIVER_RECEIVER_COUNT_MAX - 1];
     aeron_agent_runner_t runners[AERON_AGENT_RUNNER_MAX];
 }
 aeron_driver_t;
@@ -81,6 +81,9 @@ int aeron_driver_conductor_init(aeron_driver_conductor_t *conductor, aeron_drive
         return -1;
     }
 
+    context->controllable_idle_strategy_status_indicator = aeron_system_counter_addr(
+        &conductor->system_counters, AERON_SYSTEM_COUNTER_CONTROLLABLE_IDLE_STRATEGY);
+
     if (aeron_distinct_error_log_init(
         &conductor->error_log,
         context->error_buffer,
@@ -104,11 +107,49 @@ int aeron_driver_conductor_init(aeron_driver_conductor_t *conductor, aeron_drive
         return -1;
     }
 
+    if (aeron_int64_to_ptr_hash_map_init(
+        &conductor->client_by_id_map, 64, AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
+    {
+        return -1;
+    }
+
+    if (aeron_int64_to_ptr_hash_map_init(
+        &conductor->ipc_publication_by_registration_id_map, 64, AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
+    {
+        return -1;
+    }
+
+    if (aeron_int64_to_ptr_hash_map_init(
+        &conductor->shared_ipc_publication_by_stream_id_map, 64, AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
+    {
+        return -1;
+    }
+
+    if (aeron_int64_to_ptr_hash_map_init(
+        &conductor->network_publication_by_registration_id_map,
+        64,
+        AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
+    {
+        return -1;
+    }
+
     if (aeron_loss_reporter_init(&conductor->loss_reporter, context->loss_report.addr, context->loss_report.length) < 0)
     {
         return -1;
     }
 
+    if (aeron_term_cleaner_init(
+        &conductor->term_cleaner,
+        context->term_cleaner_dedicated,
+        context->term_cleaner_non_temporal_stores,
+        aeron_system_counter_addr(&conductor->system_counters, AERON_SYSTEM_COUNTER_BYTES_CLEANED),
+        aeron_system_counter_addr(&conductor->system_counters, AERON_SYSTEM_COUNTER_TERM_CLEANER_LAG)) < 0)
+    {
+        return -1;
+    }
+
+    context->term_cleaner = &conductor->term_cleaner;
+
     conductor->conductor_proxy.command_queue = &context->conductor_command_queue;
     conductor->conductor_proxy.fail_counter = aeron_counter_addr(
         &conductor->counters_manager, AERON_SYSTEM_COUNTER_CONDUCTOR_PROXY_FAILS);
@@ -118,9 +159,9 @@ int aeron_driver_conductor_init(aeron_driver_conductor_t *conductor, aeron_drive
     conductor->clients.array = NULL;
     conductor->clients.capacity = 0;
     conductor->clients.length = 0;
-    conductor->clients.on_time_event = aeron_client_on_time_event;
-    conductor->clients.has_reached_end_of_life = aeron_client_has_reached_end_of_life;
-    conductor->clients.delete_func = aeron_client_delete;
+    conductor->clients.on_time_event = aeron_client_entry_on_time_event;
+    conductor->clients.has_reached_end_of_life = aeron_client_entry_has_reached_end_of_life;
+    conductor->clients.delete_func = aeron_client_entry_delete;
 
     conductor->ipc_publications.array = NULL;
     conductor->ipc_publications.length = 0;
@@ -196,77 +237,75 @@ int aeron_driver_conductor_init(aeron_driver_conductor_t *conductor, aeron_drive
     return 0;
 }
 
-int aeron_driver_conductor_find_client(aeron_driver_conductor_t *conductor, int64_t client_id)
+aeron_client_t *aeron_driver_conductor_find_client(aeron_driver_conductor_t *conductor, int64_t client_id)
 {
-    int index = -1;
-
-    for (int i = (int)conductor->clients.length - 1; i >= 0; i--)
-    {
-        if (client_id == conductor->clients.array[i].client_id)
-        {
-            index = i;
-            break;
-        }
-    }
-
-    return index;
+    return aeron_int64_to_ptr_hash_map_get(&conductor->client_by_id_map, client_id);
 }
 
 aeron_client_t *aeron_driver_conductor_get_or_add_client(aeron_driver_conductor_t *conductor, int64_t client_id)
 {
-    aeron_client_t *client = NULL;
-    int index;
+    aeron_client_t *client = aeron_driver_conductor_find_client(conductor, client_id);
 
-    if ((index = aeron_driver_conductor_find_client(conductor, client_id)) == -1)
+    if (NULL == client)
     {
         int ensure_capacity_result = 0;
-        AERON_ARRAY_ENSURE_CAPACITY(ensure_capacity_result, conductor->clients, aeron_client_t);
+        AERON_ARRAY_ENSURE_CAPACITY(ensure_capacity_result, conductor->clients, aeron_client_entry_t);
 
-        if (ensure_capacity_result >= 0)
+        if (ensure_capacity_result < 0 || aeron_alloc((void **)&client, sizeof(aeron_client_t)) < 0)
         {
-            aeron_counter_t client_heartbeat;
+            return NULL;
+        }
 
-            client_heartbeat.counter_id = aeron_counter_client_heartbeat_status_allocate(
-                &conductor->counters_manager, client_id);
-            client_heartbeat.value_addr = aeron_counter_addr(
-                &conductor->counters_manager, (int32_t)client_heartbeat.counter_id);
+        aeron_counter_t client_heartbeat;
 
-            if (client_heartbeat.counter_id >= 0)
-            {
-                index = (int)conductor->clients.length;
-                client = &conductor->clients.array[index];
-
-                client->client_id = client_id;
-                client->reached_end_of_life = false;
-                client->time_of_last_keepalive_ms = conductor->context->epoch_clock();
-
-                client->heartbeat_status.counter_id = client_heartbeat.counter_id;
-                client->heartbeat_status.value_addr = client_heartbeat.value_addr;
-                aeron_counter_set_ordered(client->heartbeat_status.value_addr, client->time_of_last_keepalive_ms);
-
-                client->client_liveness_timeout_ms = conductor->context->client_liveness_timeout_ns < 1000000 ?
-                    1 : conductor->context->client_liveness_timeout_ns / 1000000;
-                client->publication_links.array = NULL;
-                client->publication_links.length = 0;
-                client->publication_links.capacity = 0;
-                client->counter_links.array = NULL;
-                client->counter_links.length = 0;
-                client->counter_links.capacity = 0;
-                conductor->clients.length++;
-            }
+        client_heartbeat.counter_id = aeron_counter_client_heartbeat_status_allocate(
+            &conductor->counters_manager, client_id);
+
+        if (client_heartbeat.counter_id < 0)
+        {
+            aeron_free(client);
+            return NULL;
         }
-    }
-    else
-    {
-        client = &conductor->clients.array[index];
+
+        if (aeron_int64_to_ptr_hash_map_put(&conductor->client_by_id_map, client_id, client) < 0)
+        {
+            aeron_set_err(ENOMEM, "could not index client_id=%" PRId64, client_id);
+            aeron_counters_manager_free(&conductor->counters_manager, (int32_t)client_heartbeat.counter_id);
+            aeron_free(client);
+            return NULL;
+        }
+
+        client_heartbeat.value_addr = aeron_counter_addr(
+            &conductor->counters_manager, (int32_t)client_heartbeat.counter_id);
+
+        client->client_id = client_id;
+        client->reached_end_of_life = false;
+        client->time_of_last_keepalive_ms = conductor->context->epoch_clock();
+
+        client->heartbeat_status.counter_id = client_heartbeat.counter_id;
+        client->heartbeat_status.value_addr = client_heartbeat.value_addr;
+        aeron_counter_set_ordered(client->heartbeat_status.value_addr, client->time_of_last_keepalive_ms);
+
+        client->client_liveness_timeout_ms = conductor->context->client_liveness_timeout_ns < 1000000 ?
+            1 : conductor->context->client_liveness_timeout_ns / 1000000;
+        client->publication_links.array = NULL;
+        client->publication_links.length = 0;
+        client->publication_links.capacity = 0;
+        client->counter_links.array = NULL;
+        client->counter_links.length = 0;
+        client->counter_links.capacity = 0;
+
+        conductor->clients.array[conductor->clients.length++].client = client;
     }
 
     return client;
 }
 
-void aeron_client_on_time_event(
-    aeron_driver_conductor_t *conductor, aeron_client_t *client, int64_t now_ns, int64_t now_ms)
+void aeron_client_entry_on_time_event(
+    aeron_driver_conductor_t *conductor, aeron_client_entry_t *entry, int64_t now_ns, int64_t now_ms)
 {
+    aeron_client_t *client = entry->client;
+
     if (now_ms > (client->time_of_last_keepalive_ms + client->client_liveness_timeout_ms))
     {
         client->reached_end_of_life = true;
@@ -275,13 +314,17 @@ void aeron_client_on_time_event(
     }
 }
 
-bool aeron_client_has_reached_end_of_life(aeron_driver_conductor_t *conductor, aeron_client_t *client)
+bool aeron_client_entry_has_reached_end_of_life(aeron_driver_conductor_t *conductor, aeron_client_entry_t *entry)
 {
-    return client->reached_end_of_life;
+    return entry->client->reached_end_of_life;
 }
 
-void aeron_client_delete(aeron_driver_conductor_t *conductor, aeron_client_t *client)
+void aeron_client_entry_delete(aeron_driver_conductor_t *conductor, aeron_client_entry_t *entry)
 {
+    aeron_client_t *client = entry->client;
+
+    aeron_int64_to_ptr_hash_map_remove(&conductor->client_by_id_map, client->client_id);
+
     for (size_t i = 0; i < client->publication_links.length; i++)
     {
         aeron_driver_managed_resource_t *resource = client->publication_links.array[i].resource;
@@ -358,18 +401,81 @@ void aeron_client_delete(aeron_driver_conductor_t *conductor, aeron_client_t *cl
     aeron_counters_manager_free(&conductor->counters_manager, (int32_t)client->heartbeat_status.counter_id);
 
     aeron_free(client->publication_links.array);
-    client->publication_links.array = NULL;
-    client->publication_links.length = 0;
-    client->publication_links.capacity = 0;
-
     aeron_free(client->counter_links.array);
-    client->counter_links.array = NULL;
-    client->counter_links.length = 0;
-    client->counter_links.capacity = 0;
+    aeron_free(client);
+    entry->client = NULL;
+}
 
-    client->client_id = -1;
-    client->heartbeat_status.counter_id = -1;
-    client->heartbeat_status.value_addr = NULL;
+static int aeron_driver_conductor_index_ipc_publication(
+    aeron_driver_conductor_t *conductor, aeron_ipc_publication_t *publication)
+{
+    if (aeron_int64_to_ptr_hash_map_put(
+        &conductor->ipc_publication_by_registration_id_map,
+        publication->conductor_fields.managed_resource.registration_id,
+        publication) < 0 ||
+        (!publication->is_exclusive && aeron_int64_to_ptr_hash_map_put(
+        &conductor->shared_ipc_publication_by_stream_id_map, publication->stream_id, publication) < 0))
+    {
+        aeron_set_err(
+            ENOMEM,
+            "could not index publication registration_id=%" PRId64,
+            publication->conductor_fields.managed_resource.registration_id);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void aeron_driver_conductor_unindex_ipc_publication(
+    aeron_driver_conductor_t *conductor, aeron_ipc_publication_t *publication)
+{
+    aeron_int64_to_ptr_hash_map_remove(
+        &conductor->ipc_publication_by_registration_id_map,
+        publication->conductor_fields.managed_resource.registration_id);
+
+    /* a newer shared publication may have replaced this one once it stopped being active */
+    if (publication == aeron_int64_to_ptr_hash_map_get(
+        &conductor->shared_ipc_publication_by_stream_id_map, publication->stream_id))
+    {
+        aeron_int64_to_ptr_hash_map_remove(&conductor->shared_ipc_publication_by_stream_id_map, publication->stream_id);
+    }
+}
+
+static int aeron_driver_conductor_index_network_publication(
+    aeron_driver_conductor_t *conductor, aeron_network_publication_t *publication)
+{
+    aeron_send_channel_endpoint_t *endpoint = publication->endpoint;
+
+    if (aeron_int64_to_ptr_hash_map_put(
+        &conductor->network_publication_by_registration_id_map,
+        publication->conductor_fields.managed_resource.registration_id,
+        publication) < 0 ||
+        (!publication->is_exclusive && aeron_int64_to_ptr_hash_map_put(
+        &endpoint->conductor_fields.shared_publication_by_stream_id_map, publication->stream_id, publication) < 0))
+    {
+        aeron_set_err(
+            ENOMEM,
+            "could not index publication registration_id=%" PRId64,
+            publication->conductor_fields.managed_resource.registration_id);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void aeron_driver_conductor_unindex_network_publication(
+    aeron_driver_conductor_t *conductor, aeron_network_publication_t *publication)
+{
+    aeron_int64_to_ptr_hash_map_t *shared_map = &publication->endpoint->conductor_fields.shared_publication_by_stream_id_map;
+
+    aeron_int64_to_ptr_hash_map_remove(
+        &conductor->network_publication_by_registration_id_map,
+        publication->conductor_fields.managed_resource.registration_id);
+
+    if (publication == aeron_int64_to_ptr_hash_map_get(shared_map, publication->stream_id))
+    {
+        aeron_int64_to_ptr_hash_map_remove(shared_map, publication->stream_id);
+    }
 }
 
 void aeron_ipc_publication_entry_on_time_event(
@@ -428,7 +534,11 @@ void aeron_ipc_publication_entry_on_time_event(
 bool aeron_ipc_publication_entry_has_reached_end_of_life(
     aeron_driver_conductor_t *conductor, aeron_ipc_publication_entry_t *entry)
 {
-    return aeron_ipc_publication_has_reached_end_of_life(entry->publication);
+    aeron_ipc_publication_t *publication = entry->publication;
+
+    return aeron_ipc_publication_has_reached_end_of_life(publication) &&
+        aeron_term_cleaner_has_caught_up(
+            publication->conductor_fields.cleaning_position, &publication->cleaned_position);
 }
 
 void aeron_ipc_publication_entry_delete(
@@ -440,6 +550,7 @@ void aeron_ipc_publication_entry_delete(
         aeron_driver_conductor_unlink_subscribable(link, &entry->publication->conductor_fields.subscribable);
     }
 
+    aeron_driver_conductor_unindex_ipc_publication(conductor, entry->publication);
     aeron_ipc_publication_close(&conductor->counters_manager, entry->publication);
     entry->publication = NULL;
 }
@@ -453,7 +564,10 @@ void aeron_network_publication_entry_on_time_event(
 bool aeron_network_publication_entry_has_reached_end_of_life(
     aeron_driver_conductor_t *conductor, aeron_network_publication_entry_t *entry)
 {
-    return aeron_network_publication_has_sender_released(entry->publication);
+    aeron_network_publication_t *publication = entry->publication;
+
+    return aeron_network_publication_has_sender_released(publication) &&
+        aeron_term_cleaner_has_caught_up(publication->conductor_fields.clean_position, &publication->cleaned_position);
 }
 
 void aeron_network_publication_entry_delete(
@@ -467,6 +581,7 @@ void aeron_network_publication_entry_delete(
         aeron_driver_conductor_unlink_subscribable(link, &entry->publication->conductor_fields.subscribable);
     }
 
+    aeron_driver_conductor_unindex_network_publication(conductor, entry->publication);
     aeron_network_publication_close(&conductor->counters_manager, entry->publication);
     entry->publication = NULL;
 
@@ -505,7 +620,7 @@ void aeron_driver_conductor_cleanup_spies(aeron_driver_conductor_t *conductor, a
 void aeron_driver_conductor_cleanup_network_publication(
     aeron_driver_conductor_t *conductor, aeron_network_publication_t *publication)
 {
-    aeron_driver_sender_proxy_on_remove_publication(conductor->context->sender_proxy, publication);
+    aeron_driver_sender_proxy_on_remove_publication(publication->endpoint->sender_proxy, publication);
 }
 
 void aeron_send_channel_endpoint_entry_on_time_event(
@@ -563,7 +678,10 @@ void aeron_publication_image_entry_on_time_event(
 bool aeron_publication_image_entry_has_reached_end_of_life(
     aeron_driver_conductor_t *conductor, aeron_publication_image_entry_t *entry)
 {
-    return AERON_PUBLICATION_IMAGE_STATUS_DONE == entry->image->conductor_fields.status;
+    aeron_publication_image_t *image = entry->image;
+
+    return AERON_PUBLICATION_IMAGE_STATUS_DONE == image->conductor_fields.status &&
+        aeron_term_cleaner_has_caught_up(image->conductor_fields.clean_position, &image->cleaned_position);
 }
 
 void aeron_publication_image_entry_delete(
@@ -621,7 +739,7 @@ void aeron_driver_conductor_image_transition_to_linger(
         }
 
         aeron_driver_receiver_proxy_on_remove_cool_down(
-            conductor->context->receiver_proxy, image->endpoint, image->session_id, image->stream_id);
+            image->receiver_proxy, image->endpoint, image->session_id, image->stream_id);
     }
 }
 
@@ -643,7 +761,7 @@ void aeron_driver_conductor_on_check_managed_resources(
     aeron_driver_conductor_t *conductor, int64_t now_ns, int64_t now_ms)
 {
     AERON_DRIVER_CONDUCTOR_CHECK_MANAGED_RESOURCE(
-        conductor, conductor->clients, aeron_client_t, now_ns, now_ms);
+        conductor, conductor->clients, aeron_client_entry_t, now_ns, now_ms);
     AERON_DRIVER_CONDUCTOR_CHECK_MANAGED_RESOURCE(
         conductor, conductor->ipc_publications, aeron_ipc_publication_entry_t, now_ns, now_ms);
     AERON_DRIVER_CONDUCTOR_CHECK_MANAGED_RESOURCE(
@@ -672,17 +790,12 @@ aeron_ipc_publication_t *aeron_driver_conductor_get_or_add_ipc_publication(
 
     if (!is_exclusive)
     {
-        for (size_t i = 0; i < conductor->ipc_publications.length; i++)
-        {
-            aeron_ipc_publication_t *pub_entry = conductor->ipc_publications.array[i].publication;
+        aeron_ipc_publication_t *pub_entry = aeron_int64_to_ptr_hash_map_get(
+            &conductor->shared_ipc_publication_by_stream_id_map, stream_id);
 
-            if (stream_id == pub_entry->stream_id &&
-                !pub_entry->is_exclusive &&
-                AERON_IPC_PUBLICATION_STATUS_ACTIVE == pub_entry->conductor_fields.status)
-            {
-                publication = pub_entry;
-                break;
-            }
+        if (NULL != pub_entry && AERON_IPC_PUBLICATION_STATUS_ACTIVE == pub_entry->conductor_fields.status)
+        {
+            publication = pub_entry;
         }
     }
 
@@ -743,6 +856,13 @@ aeron_ipc_publication_t *aeron_driver_conductor_get_or_add_ipc_publication(
                         is_exclusive,
                         &conductor->system_counters) >= 0)
                 {
+                    if (aeron_driver_conductor_index_ipc_publication(conductor, publication) < 0)
+                    {
+                        aeron_driver_conductor_unindex_ipc_publication(conductor, publication);
+                        aeron_ipc_publication_close(&conductor->counters_manager, publication);
+                        return NULL;
+                    }
+
                     aeron_publication_link_t *link = &client->publication_links.array[client->publication_links.length];
 
                     link->resource = &publication->conductor_fields.managed_resource;
@@ -786,18 +906,12 @@ aeron_network_publication_t *aeron_driver_conductor_get_or_add_network_publicati
 
     if (!is_exclusive)
     {
-        for (size_t i = 0; i < conductor->network_publications.length; i++)
-        {
-            aeron_network_publication_t *pub_entry = conductor->network_publications.array[i].publication;
+        aeron_network_publication_t *pub_entry = aeron_int64_to_ptr_hash_map_get(
+            &endpoint->conductor_fields.shared_publication_by_stream_id_map, stream_id);
 
-            if (endpoint == pub_entry->endpoint &&
-                stream_id == pub_entry->stream_id &&
-                !pub_entry->is_exclusive &&
-                pub_entry->conductor_fields.status == AERON_NETWORK_PUBLICATION_STATUS_ACTIVE)
-            {
-                publication = pub_entry;
-                break;
-            }
+        if (NULL != pub_entry && pub_entry->conductor_fields.status == AERON_NETWORK_PUBLICATION_STATUS_ACTIVE)
+        {
+            publication = pub_entry;
         }
     }
 
@@ -875,7 +989,8 @@ aeron_network_publication_t *aeron_driver_conductor_get_or_add_network_publicati
                     stream_id,
                     registration_id,
                     initial_term_id,
-                    params->term_length) < 0)
+                    params->term_length,
+                    conductor->context) < 0)
                 {
                     return NULL;
                 }
@@ -899,8 +1014,15 @@ aeron_network_publication_t *aeron_driver_conductor_get_or_add_network_publicati
                         conductor->context->spies_simulate_connection,
                         &conductor->system_counters) >= 0)
                 {
+                    if (aeron_driver_conductor_index_network_publication(conductor, publication) < 0)
+                    {
+                        aeron_driver_conductor_unindex_network_publication(conductor, publication);
+                        aeron_network_publication_close(&conductor->counters_manager, publication);
+                        return NULL;
+                    }
+
                     endpoint->conductor_fields.managed_resource.incref(endpoint->conductor_fields.managed_resource.clientd);
-                    aeron_driver_sender_proxy_on_add_publication(conductor->context->sender_proxy, publication);
+                    aeron_driver_sender_proxy_on_add_publication(endpoint->sender_proxy, publication);
 
                     aeron_publication_link_t *link = &client->publication_links.array[client->publication_links.length];
 
@@ -969,7 +1091,7 @@ aeron_send_channel_endpoint_t *aeron_driver_conductor_get_or_add_send_channel_en
             return NULL;
         }
 
-        aeron_driver_sender_proxy_on_add_endpoint(conductor->context->sender_proxy, endpoint);
+        aeron_driver_sender_proxy_on_add_endpoint(endpoint->sender_proxy, endpoint);
         conductor->send_channel_endpoints.array[conductor->send_channel_endpoints.length++].endpoint = endpoint;
         *status_indicator.value_addr = AERON_COUNTER_CHANNEL_ENDPOINT_STATUS_ACTIVE;
     }
@@ -1401,6 +1523,38 @@ void aeron_driver_conductor_on_command(int32_t msg_type_id, const void *message,
             break;
         }
 
+        case AERON_COMMAND_ADD_RCV_DESTINATION:
+        {
+            aeron_destination_command_t *command = (aeron_destination_command_t *)message;
+
+            if (length < sizeof(aeron_destination_command_t) ||
+                length < (sizeof(aeron_destination_command_t) + command->channel_length))
+            {
+                goto malformed_command;
+            }
+
+            correlation_id = command->correlated.correlation_id;
+
+            result = aeron_driver_conductor_on_add_receive_destination(conductor, command);
+            break;
+        }
+
+        case AERON_COMMAND_REMOVE_RCV_DESTINATION:
+        {
+            aeron_destination_command_t *command = (aeron_destination_command_t *)message;
+
+            if (length < sizeof(aeron_destination_command_t) ||
+                length < (sizeof(aeron_destination_command_t) + command->channel_length))
+            {
+                goto malformed_command;
+            }
+
+            correlation_id = command->correlated.correlation_id;
+
+            result = aeron_driver_conductor_on_remove_receive_destination(conductor, command);
+            break;
+        }
+
         case AERON_COMMAND_ADD_COUNTER:
         {
             aeron_counter_command_t *command = (aeron_counter_command_t *)message;
@@ -1516,6 +1670,7 @@ int aeron_driver_conductor_do_work(void *clientd)
         aeron_mpsc_rb_consumer_heartbeat_time(&conductor->to_driver_commands, now_ms);
         aeron_driver_conductor_on_check_managed_resources(conductor, now_ns, now_ms);
         aeron_driver_conductor_on_check_for_blocked_driver_commands(conductor, now_ns);
+        aeron_term_cleaner_update_lag(&conductor->term_cleaner);
         conductor->time_of_last_timeout_check_ns = now_ns;
         work_count++;
     }
@@ -1545,8 +1700,9 @@ void aeron_driver_conductor_on_close(void *clientd)
 
     for (size_t i = 0, length = conductor->clients.length; i < length; i++)
     {
-        aeron_free(conductor->clients.array[i].publication_links.array);
-        aeron_free(conductor->clients.array[i].counter_links.array);
+        aeron_free(conductor->clients.array[i].client->publication_links.array);
+        aeron_free(conductor->clients.array[i].client->counter_links.array);
+        aeron_free(conductor->clients.array[i].client);
     }
     aeron_free(conductor->clients.array);
 
@@ -1602,12 +1758,17 @@ void aeron_driver_conductor_on_close(void *clientd)
     }
     aeron_free(conductor->publication_images.array);
 
+    aeron_term_cleaner_close(&conductor->term_cleaner);
     aeron_system_counters_close(&conductor->system_counters);
     aeron_counters_manager_close(&conductor->counters_manager);
     aeron_distinct_error_log_close(&conductor->error_log);
 
     aeron_str_to_ptr_hash_map_delete(&conductor->send_channel_endpoint_by_channel_map);
     aeron_str_to_ptr_hash_map_delete(&conductor->receive_channel_endpoint_by_channel_map);
+    aeron_int64_to_ptr_hash_map_delete(&conductor->client_by_id_map);
+    aeron_int64_to_ptr_hash_map_delete(&conductor->ipc_publication_by_registration_id_map);
+    aeron_int64_to_ptr_hash_map_delete(&conductor->shared_ipc_publication_by_stream_id_map);
+    aeron_int64_to_ptr_hash_map_delete(&conductor->network_publication_by_registration_id_map);
 }
 
 int aeron_driver_subscribable_add_position(
@@ -1833,6 +1994,13 @@ int aeron_driver_conductor_on_add_network_publication(
         return -1;
     }
 
+    if (udp_channel->is_manual_control_mode && !udp_channel->explicit_control)
+    {
+        aeron_set_err(EINVAL, "%s", "publications in manual control mode must specify a control address");
+        aeron_udp_channel_delete(udp_channel);
+        return -1;
+    }
+
     if ((client = aeron_driver_conductor_get_or_add_client(conductor, command->correlated.client_id)) == NULL)
     {
         return -1;
@@ -1921,12 +2089,10 @@ int aeron_driver_conductor_on_remove_publication(
     aeron_driver_conductor_t *conductor,
     aeron_remove_command_t *command)
 {
-    int index;
+    aeron_client_t *client;
 
-    if ((index = aeron_driver_conductor_find_client(conductor, command->correlated.client_id)) >= 0)
+    if ((client = aeron_driver_conductor_find_client(conductor, command->correlated.client_id)) != NULL)
     {
-        aeron_client_t *client = &conductor->clients.array[index];
-
         for (size_t i = 0, size = client->publication_links.length, last_index = size - 1; i < size; i++)
         {
             aeron_driver_managed_resource_t *resource = client->publication_links.array[i].resource;
@@ -2122,6 +2288,35 @@ int aeron_driver_conductor_on_add_network_subscription(
         return -1;
     }
 
+    if (udp_channel->is_manual_control_mode)
+    {
+        if (NULL != udp_channel->uri.params.udp.endpoint_key || NULL != udp_channel->uri.params.udp.control_key)
+        {
+            aeron_set_err(EINVAL, "%s", "subscriptions in manual control mode must add their endpoints as destinations");
+            aeron_udp_channel_delete(udp_channel);
+            return -1;
+        }
+
+        /* there is no address to share an endpoint by so each multi-destination subscription has its own */
+        const size_t remaining_length = sizeof(udp_channel->canonical_form) - udp_channel->canonical_length;
+        const int suffix_length = snprintf(
+            udp_channel->canonical_form + udp_channel->canonical_length,
+            remaining_length,
+            "-%" PRId64,
+            command->correlated.correlation_id);
+
+        /* a truncated form could match another subscription's and so share its endpoint */
+        if (suffix_length < 0 || (size_t)suffix_length >= remaining_length)
+        {
+            aeron_set_err(
+                EINVAL, "channel too long for a manual control mode subscription: %.*s", (int)uri_length, uri);
+            aeron_udp_channel_delete(udp_channel);
+            return -1;
+        }
+
+        udp_channel->canonical_length += (size_t)suffix_length;
+    }
+
     bool is_reliable = params.is_reliable;
     if (aeron_driver_conductor_has_clashing_subscription(conductor, endpoint, command->stream_id, is_reliable))
     {
@@ -2297,12 +2492,10 @@ int aeron_driver_conductor_on_client_keepalive(
     aeron_driver_conductor_t *conductor,
     int64_t client_id)
 {
-    int index;
+    aeron_client_t *client;
 
-    if ((index = aeron_driver_conductor_find_client(conductor, client_id)) >= 0)
+    if ((client = aeron_driver_conductor_find_client(conductor, client_id)) != NULL)
     {
-        aeron_client_t *client = &conductor->clients.array[index];
-
         client->time_of_last_keepalive_ms = conductor->epoch_clock();
         aeron_counter_set_ordered(client->heartbeat_status.value_addr, client->time_of_last_keepalive_ms);
     }
@@ -2315,16 +2508,12 @@ int aeron_driver_conductor_on_add_destination(
     aeron_destination_command_t *command)
 {
     aeron_send_channel_endpoint_t *endpoint = NULL;
+    aeron_network_publication_t *publication = aeron_driver_conductor_find_network_publication(
+        conductor, command->registration_id);
 
-    for (size_t i = 0, length = conductor->network_publications.length; i < length; i++)
+    if (NULL != publication)
     {
-        aeron_network_publication_t *publication = conductor->network_publications.array[i].publication;
-
-        if (command->registration_id == publication->conductor_fields.managed_resource.registration_id)
-        {
-            endpoint = publication->endpoint;
-            break;
-        }
+        endpoint = publication->endpoint;
     }
 
     if (NULL != endpoint)
@@ -2337,7 +2526,7 @@ int aeron_driver_conductor_on_add_destination(
             goto error_cleanup;
         }
 
-        if (NULL != endpoint->destination_tracker || !endpoint->destination_tracker->is_manual_control_mode)
+        if (NULL == endpoint->destination_tracker || !endpoint->destination_tracker->is_manual_control_mode)
         {
             aeron_set_err(
                 EINVAL,
@@ -2363,7 +2552,7 @@ int aeron_driver_conductor_on_add_destination(
             goto error_cleanup;
         }
 
-        aeron_driver_sender_proxy_on_add_destination(conductor->context->sender_proxy, endpoint, &destination_addr);
+        aeron_driver_sender_proxy_on_add_destination(endpoint->sender_proxy, endpoint, &destination_addr);
         aeron_driver_conductor_on_operation_succeeded(conductor, command->correlated.correlation_id);
 
         aeron_uri_close(&uri_params);
@@ -2388,16 +2577,12 @@ int aeron_driver_conductor_on_remove_destination(
     aeron_destination_command_t *command)
 {
     aeron_send_channel_endpoint_t *endpoint = NULL;
+    aeron_network_publication_t *publication = aeron_driver_conductor_find_network_publication(
+        conductor, command->registration_id);
 
-    for (size_t i = 0, length = conductor->network_publications.length; i < length; i++)
+    if (NULL != publication)
     {
-        aeron_network_publication_t *publication = conductor->network_publications.array[i].publication;
-
-        if (command->registration_id == publication->conductor_fields.managed_resource.registration_id)
-        {
-            endpoint = publication->endpoint;
-            break;
-        }
+        endpoint = publication->endpoint;
     }
 
     if (NULL != endpoint)
@@ -2410,7 +2595,7 @@ int aeron_driver_conductor_on_remove_destination(
             goto error_cleanup;
         }
 
-        if (NULL != endpoint->destination_tracker || !endpoint->destination_tracker->is_manual_control_mode)
+        if (NULL == endpoint->destination_tracker || !endpoint->destination_tracker->is_manual_control_mode)
         {
             aeron_set_err(
                 EINVAL,
@@ -2437,7 +2622,7 @@ int aeron_driver_conductor_on_remove_destination(
             goto error_cleanup;
         }
 
-        aeron_driver_sender_proxy_on_remove_destination(conductor->context->sender_proxy, endpoint, &destination_addr);
+        aeron_driver_sender_proxy_on_remove_destination(endpoint->sender_proxy, endpoint, &destination_addr);
         aeron_driver_conductor_on_operation_succeeded(conductor, command->correlated.correlation_id);
 
         aeron_uri_close(&uri_params);
@@ -2457,6 +2642,121 @@ int aeron_driver_conductor_on_remove_destination(
     return -1;
 }
 
+static aeron_receive_channel_endpoint_t *aeron_driver_conductor_find_manual_control_mode_endpoint(
+    aeron_driver_conductor_t *conductor, aeron_destination_command_t *command)
+{
+    for (size_t i = 0, length = conductor->network_subscriptions.length; i < length; i++)
+    {
+        aeron_subscription_link_t *link = &conductor->network_subscriptions.array[i];
+
+        if (command->registration_id == link->registration_id)
+        {
+            if (!link->endpoint->is_manual_control_mode)
+            {
+                aeron_set_err(
+                    EINVAL,
+                    "channel does not allow manual control of destinations: %.*s",
+                    link->channel_length, link->channel);
+                return NULL;
+            }
+
+            return link->endpoint;
+        }
+    }
+
+    aeron_set_err(EINVAL, "unknown subscription registration_id=%" PRId64, command->registration_id);
+    return NULL;
+}
+
+static aeron_udp_channel_t *aeron_driver_conductor_parse_receive_destination(aeron_destination_command_t *command)
+{
+    aeron_udp_channel_t *udp_channel = NULL;
+    const char *command_uri = (const char *)command + sizeof(aeron_destination_command_t);
+
+    if (aeron_udp_channel_parse((size_t)command->channel_length, command_uri, &udp_channel) < 0)
+    {
+        return NULL;
+    }
+
+    if (udp_channel->is_manual_control_mode || NULL == udp_channel->uri.params.udp.endpoint_key)
+    {
+        aeron_set_err(
+            EINVAL, "incorrect URI format for receive destination: %.*s", command->channel_length, command_uri);
+        aeron_udp_channel_delete(udp_channel);
+        return NULL;
+    }
+
+    return udp_channel;
+}
+
+int aeron_driver_conductor_on_add_receive_destination(
+    aeron_driver_conductor_t *conductor,
+    aeron_destination_command_t *command)
+{
+    aeron_receive_channel_endpoint_t *endpoint =
+        aeron_driver_conductor_find_manual_control_mode_endpoint(conductor, command);
+    aeron_udp_channel_t *udp_channel = NULL;
+    aeron_receive_destination_t *destination = NULL;
+
+    if (NULL == endpoint || NULL == (udp_channel = aeron_driver_conductor_parse_receive_destination(command)))
+    {
+        return -1;
+    }
+
+    if (aeron_receive_destination_create(&destination, udp_channel, endpoint, conductor->context) < 0)
+    {
+        aeron_udp_channel_delete(udp_channel);
+        return -1;
+    }
+
+    if (aeron_receive_channel_endpoint_track_destination(endpoint, destination) < 0)
+    {
+        aeron_receive_destination_delete(destination);
+        return -1;
+    }
+
+    if (0 == endpoint->so_rcvbuf || destination->so_rcvbuf < endpoint->so_rcvbuf)
+    {
+        endpoint->so_rcvbuf = destination->so_rcvbuf;
+    }
+
+    aeron_driver_receiver_proxy_on_add_destination(endpoint->receiver_proxy, endpoint, destination);
+    aeron_driver_conductor_on_operation_succeeded(conductor, command->correlated.correlation_id);
+
+    return 0;
+}
+
+int aeron_driver_conductor_on_remove_receive_destination(
+    aeron_driver_conductor_t *conductor,
+    aeron_destination_command_t *command)
+{
+    aeron_receive_channel_endpoint_t *endpoint =
+        aeron_driver_conductor_find_manual_control_mode_endpoint(conductor, command);
+    aeron_udp_channel_t *udp_channel = NULL;
+
+    if (NULL == endpoint || NULL == (udp_channel = aeron_driver_conductor_parse_receive_destination(command)))
+    {
+        return -1;
+    }
+
+    if (!aeron_receive_channel_endpoint_forget_destination(endpoint, udp_channel))
+    {
+        aeron_set_err(
+            EINVAL,
+            "unknown receive destination %.*s for registration_id=%" PRId64,
+            (int)udp_channel->uri_length,
+            udp_channel->original_uri,
+            command->registration_id);
+        aeron_udp_channel_delete(udp_channel);
+        return -1;
+    }
+
+    aeron_driver_receiver_proxy_on_remove_destination(endpoint->receiver_proxy, endpoint, udp_channel);
+    aeron_driver_conductor_on_operation_succeeded(conductor, command->correlated.correlation_id);
+
+    return 0;
+}
+
 int aeron_driver_conductor_on_add_counter(
     aeron_driver_conductor_t *conductor,
     aeron_counter_command_t *command)
@@ -2507,12 +2807,10 @@ int aeron_driver_conductor_on_remove_counter(
     aeron_driver_conductor_t *conductor,
     aeron_remove_command_t *command)
 {
-    int index;
+    aeron_client_t *client;
 
-    if ((index = aeron_driver_conductor_find_client(conductor, command->correlated.client_id)) >= 0)
+    if ((client = aeron_driver_conductor_find_client(conductor, command->correlated.client_id)) != NULL)
     {
-        aeron_client_t *client = &conductor->clients.array[index];
-
         for (size_t i = 0, size = client->counter_links.length, last_index = size - 1; i < size; i++)
         {
             aeron_counter_link_t *link = &client->counter_links.array[i];
@@ -2546,12 +2844,10 @@ int aeron_driver_conductor_on_client_close(
     aeron_driver_conductor_t *conductor,
     aeron_correlated_command_t *command)
 {
-    int index;
+    aeron_client_t *client;
 
-    if ((index = aeron_driver_conductor_find_client(conductor, command->client_id)) >= 0)
+    if ((client = aeron_driver_conductor_find_client(conductor, command->client_id)) != NULL)
     {
-        aeron_client_t *client = &conductor->clients.array[index];
-
         client->time_of_last_keepalive_ms = 0;
         aeron_counter_set_ordered(client->heartbeat_status.value_addr, client->time_of_last_keepalive_ms);
     }
@@ -2650,6 +2946,13 @@ void aeron_driver_conductor_on_create_publication_image(void *clientd, void *ite
         return;
     }
 
+    if (AERON_RECEIVER_TIMESTAMPING_NONE != conductor->context->receiver_timestamping &&
+        aeron_publication_image_enable_recv_histograms(image, &conductor->counters_manager, uri_length, uri) < 0)
+    {
+        aeron_publication_image_close(&conductor->counters_manager, image);
+        return;
+    }
+
     conductor->publication_images.array[conductor->publication_images.length++].image = image;
 
     for (size_t i = 0, length = conductor->network_subscriptions.length; i < length; i++)
@@ -2682,8 +2985,8 @@ void aeron_driver_conductor_on_create_publication_image(void *clientd, void *ite
         }
     }
 
-    aeron_driver_receiver_proxy_on_add_publication_image(conductor->context->receiver_proxy, endpoint, image);
-    aeron_driver_receiver_proxy_on_delete_create_publication_image_cmd(conductor->context->receiver_proxy, item);
+    aeron_driver_receiver_proxy_on_add_publication_image(endpoint->receiver_proxy, endpoint, image);
+    aeron_driver_receiver_proxy_on_delete_create_publication_image_cmd(endpoint->receiver_proxy, item);
 }
 
 void aeron_driver_conductor_on_linger_buffer(void *clientd, void *item)
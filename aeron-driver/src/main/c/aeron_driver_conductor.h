@@ -27,6 +27,7 @@
 #include "aeron_system_counters.h"
 #include "aeron_ipc_publication.h"
 #include "collections/aeron_str_to_ptr_hash_map.h"
+#include "collections/aeron_int64_to_ptr_hash_map.h"
 #include "media/aeron_send_channel_endpoint.h"
 #include "media/aeron_receive_channel_endpoint.h"
 #include "aeron_driver_conductor_proxy.h"
@@ -76,6 +77,12 @@ typedef struct aeron_client_stct
 }
 aeron_client_t;
 
+typedef struct aeron_client_entry_stct
+{
+    aeron_client_t *client;
+}
+aeron_client_entry_t;
+
 typedef struct aeron_subscribable_list_entry_stct
 {
     aeron_subscribable_t *subscribable;
@@ -156,18 +163,23 @@ typedef struct aeron_driver_conductor_stct
     aeron_system_counters_t system_counters;
     aeron_driver_conductor_proxy_t conductor_proxy;
     aeron_loss_reporter_t loss_reporter;
+    aeron_term_cleaner_t term_cleaner;
 
     aeron_str_to_ptr_hash_map_t send_channel_endpoint_by_channel_map;
     aeron_str_to_ptr_hash_map_t receive_channel_endpoint_by_channel_map;
+    aeron_int64_to_ptr_hash_map_t client_by_id_map;
+    aeron_int64_to_ptr_hash_map_t ipc_publication_by_registration_id_map;
+    aeron_int64_to_ptr_hash_map_t shared_ipc_publication_by_stream_id_map;
+    aeron_int64_to_ptr_hash_map_t network_publication_by_registration_id_map;
 
     struct client_stct
     {
-        aeron_client_t *array;
+        aeron_client_entry_t *array;
         size_t length;
         size_t capacity;
-        void (*on_time_event)(aeron_driver_conductor_t *, aeron_client_t *, int64_t, int64_t);
-        bool (*has_reached_end_of_life)(aeron_driver_conductor_t *, aeron_client_t *);
-        void (*delete_func)(aeron_driver_conductor_t *, aeron_client_t *);
+        void (*on_time_event)(aeron_driver_conductor_t *, aeron_client_entry_t *, int64_t, int64_t);
+        bool (*has_reached_end_of_life)(aeron_driver_conductor_t *, aeron_client_entry_t *);
+        void (*delete_func)(aeron_driver_conductor_t *, aeron_client_entry_t *);
     }
     clients;
 
@@ -277,12 +289,12 @@ aeron_driver_conductor_t;
 
 #define AERON_FORMAT_BUFFER(buffer, format, ...) snprintf(buffer, sizeof(buffer) - 1, format, __VA_ARGS__)
 
-void aeron_client_on_time_event(
-    aeron_driver_conductor_t *conductor, aeron_client_t *client, int64_t now_ns, int64_t now_ms);
+void aeron_client_entry_on_time_event(
+    aeron_driver_conductor_t *conductor, aeron_client_entry_t *entry, int64_t now_ns, int64_t now_ms);
 
-bool aeron_client_has_reached_end_of_life(aeron_driver_conductor_t *conductor, aeron_client_t *client);
+bool aeron_client_entry_has_reached_end_of_life(aeron_driver_conductor_t *conductor, aeron_client_entry_t *entry);
 
-void aeron_client_delete(aeron_driver_conductor_t *conductor, aeron_client_t *);
+void aeron_client_entry_delete(aeron_driver_conductor_t *conductor, aeron_client_entry_t *);
 
 void aeron_ipc_publication_entry_on_time_event(
     aeron_driver_conductor_t *conductor, aeron_ipc_publication_entry_t *entry, int64_t now_ns, int64_t now_ms);
@@ -415,6 +427,12 @@ int aeron_driver_conductor_on_add_destination(
 int aeron_driver_conductor_on_remove_destination(
     aeron_driver_conductor_t *conductor, aeron_destination_command_t *command);
 
+int aeron_driver_conductor_on_add_receive_destination(
+    aeron_driver_conductor_t *conductor, aeron_destination_command_t *command);
+
+int aeron_driver_conductor_on_remove_receive_destination(
+    aeron_driver_conductor_t *conductor, aeron_destination_command_t *command);
+
 int aeron_driver_conductor_on_add_counter(aeron_driver_conductor_t *conductor, aeron_counter_command_t *command);
 
 int aeron_driver_conductor_on_remove_counter(aeron_driver_conductor_t *conductor, aeron_remove_command_t *command);
@@ -642,33 +660,15 @@ inline aeron_receive_channel_endpoint_t * aeron_driver_conductor_find_receive_ch
 inline aeron_ipc_publication_t * aeron_driver_conductor_find_ipc_publication(
     aeron_driver_conductor_t *conductor, int64_t id)
 {
-    for (size_t i = 0, length = conductor->ipc_publications.length; i < length; i++)
-    {
-        aeron_ipc_publication_t *publication = conductor->ipc_publications.array[i].publication;
-
-        if (id == publication->conductor_fields.managed_resource.registration_id)
-        {
-            return publication;
-        }
-    }
-
-    return NULL;
+    return (aeron_ipc_publication_t *)aeron_int64_to_ptr_hash_map_get(
+        &conductor->ipc_publication_by_registration_id_map, id);
 }
 
 inline aeron_network_publication_t * aeron_driver_conductor_find_network_publication(
     aeron_driver_conductor_t *conductor, int64_t id)
 {
-    for (size_t i = 0, length = conductor->network_publications.length; i < length; i++)
-    {
-        aeron_network_publication_t *publication = conductor->network_publications.array[i].publication;
-
-        if (id == publication->conductor_fields.managed_resource.registration_id)
-        {
-            return publication;
-        }
-    }
-
-    return NULL;
+    return (aeron_network_publication_t *)aeron_int64_to_ptr_hash_map_get(
+        &conductor->network_publication_by_registration_id_map, id);
 }
 
 inline aeron_publication_image_t * aeron_driver_conductor_find_publication_image(
@@ -54,6 +54,7 @@
 #include "concurrent/aeron_broadcast_transmitter.h"
 #include "aeron_agent.h"
 #include "concurrent/aeron_counters_manager.h"
+#include "aeron_retransmit_handler.h"
 
 #if defined(__clang__)
     #pragma clang diagnostic push
@@ -165,6 +166,31 @@ uint64_t aeron_config_parse_uint64(const char *name, const char *str, uint64_t d
     return result;
 }
 
+int64_t aeron_config_parse_int64(const char *name, const char *str, int64_t def, int64_t min, int64_t max)
+{
+    int64_t result = def;
+
+    if (NULL != str)
+    {
+        char *end = NULL;
+        errno = 0;
+        int64_t value = strtoll(str, &end, 0);
+
+        if (0 != errno || end == str || '\0' != *end)
+        {
+            aeron_config_prop_warning(name, str);
+        }
+        else
+        {
+            result = value;
+            result = result > max ? max : result;
+            result = result < min ? min : result;
+        }
+    }
+
+    return result;
+}
+
 uint64_t aeron_config_parse_size64(const char *name, const char *str, uint64_t def, uint64_t min, uint64_t max)
 {
     uint64_t result = def;
@@ -211,6 +237,48 @@ uint64_t aeron_config_parse_duration_ns(const char *name, const char *str, uint6
     return result;
 }
 
+double aeron_config_parse_rate(const char *name, const char *str, double def)
+{
+    double result = def;
+
+    if (NULL != str)
+    {
+        char *end = NULL;
+
+        errno = 0;
+        double value = strtod(str, &end);
+
+        if (0 != errno || end == str || value < 0.0 || value > 1.0)
+        {
+            aeron_config_prop_warning(name, str);
+        }
+        else
+        {
+            result = value;
+        }
+    }
+
+    return result;
+}
+
+static void aeron_config_parse_impairment(
+    aeron_udp_channel_impairment_params_t *params,
+    const char *loss_rate_name,
+    const char *duplicate_rate_name,
+    const char *reorder_rate_name,
+    const char *delay_name,
+    const char *delay_jitter_name)
+{
+    params->loss_rate = aeron_config_parse_rate(loss_rate_name, getenv(loss_rate_name), params->loss_rate);
+    params->duplicate_rate = aeron_config_parse_rate(
+        duplicate_rate_name, getenv(duplicate_rate_name), params->duplicate_rate);
+    params->reorder_rate = aeron_config_parse_rate(reorder_rate_name, getenv(reorder_rate_name), params->reorder_rate);
+    params->delay_ns = aeron_config_parse_duration_ns(
+        delay_name, getenv(delay_name), params->delay_ns, 0, INT32_MAX);
+    params->delay_jitter_ns = aeron_config_parse_duration_ns(
+        delay_jitter_name, getenv(delay_jitter_name), params->delay_jitter_ns, 0, INT32_MAX);
+}
+
 #define AERON_CONFIG_GETENV_OR_DEFAULT(e, d) ((NULL == getenv(e)) ? (d) : getenv(e))
 
 static void aeron_driver_conductor_to_driver_interceptor_null(
@@ -276,7 +344,7 @@ int aeron_driver_context_init(aeron_driver_context_t **context)
     }
 
     if ((_context->multicast_flow_control_supplier_func = aeron_flow_control_strategy_supplier_load(
-        "aeron_max_multicast_flow_control_strategy_supplier")) == NULL)
+        "aeron_default_multicast_flow_control_strategy_supplier")) == NULL)
     {
         return -1;
     }
@@ -296,11 +364,23 @@ int aeron_driver_context_init(aeron_driver_context_t **context)
 #endif
 
     _context->threading_mode = AERON_THREADING_MODE_DEDICATED;
+    _context->receiver_timestamping = AERON_RECEIVER_TIMESTAMPING_NONE;
+    _context->receiver_socket_fan_out = 1;
+    _context->receiver_socket_fan_out_steering = AERON_UDP_CHANNEL_TRANSPORT_STEERING_SESSION;
+    _context->receiver_socket_busy_poll_ns = 0;
+    memset(&_context->data_impairment, 0, sizeof(_context->data_impairment));
+    memset(&_context->control_impairment, 0, sizeof(_context->control_impairment));
+    _context->impairment_seed = (uint64_t)aeron_epoch_clock();
     _context->dirs_delete_on_start = false;
     _context->warn_if_dirs_exist = true;
     _context->term_buffer_sparse_file = false;
     _context->perform_storage_checks = true;
     _context->spies_simulate_connection = false;
+    _context->io_uring_enabled = false;
+    _context->socket_gso_enabled = false;
+    _context->socket_gro_enabled = false;
+    _context->receiver_zero_copy_enabled = false;
+    _context->sender_zero_copy_enabled = false;
     _context->driver_timeout_ms = 10 * 1000;
     _context->to_driver_buffer_length = 1024 * 1024 + AERON_RB_TRAILER_LENGTH;
     _context->to_clients_buffer_length = 1024 * 1024 + AERON_BROADCAST_BUFFER_TRAILER_LENGTH;
@@ -327,9 +407,41 @@ int aeron_driver_context_init(aeron_driver_context_t **context)
     _context->initial_window_length = 128 * 1024;
     _context->loss_report_length = 1024 * 1024;
     _context->file_page_size = 4 * 1024;
+    _context->raw_log_pool_depth = 0;
     _context->publication_unblock_timeout_ns = 10 * 1000 * 1000 * 1000L;
     _context->publication_connection_timeout_ns = 5 * 1000 * 1000 * 1000L;
     _context->counter_free_to_reuse_ns = 1 * 1000 * 1000 * 1000L;
+    _context->flow_control_receiver_timeout_ns = AERON_MAX_FLOW_CONTROL_STRATEGY_RECEIVER_TIMEOUT_NS;
+    _context->flow_control_group_tag = -1;
+    _context->cubic_measure_rtt = false;
+    _context->cubic_initial_rtt_ns = 100 * 1000L;
+    _context->cubic_tcp_mode = false;
+    _context->idle_strategy_max_spins = 10;
+    _context->idle_strategy_max_yields = 20;
+    _context->idle_strategy_min_park_period_ns = 1000;
+    _context->idle_strategy_max_park_period_ns = 1000 * 1000L;
+    _context->io_uring_entries = 64;
+    _context->receiver_io_vector_capacity = 32;
+    _context->receiver_count = 1;
+    _context->sender_count = 1;
+    _context->network_publication_max_messages_per_send = 4;
+    _context->send_batch_budget = 64;
+    _context->sender_zero_copy_threshold = 8 * 1024;
+    _context->xdp_queue = 0;
+    _context->xdp_frame_count = 4096;
+    _context->xdp_interface[0] = '\0';
+    _context->xdp = NULL;
+    _context->max_resend = AERON_RETRANSMIT_HANDLER_DEFAULT_MAX_RETRANSMITS;
+    _context->retransmit_rate_limit = 0;
+    _context->retransmit_rate_interval_ns = AERON_RETRANSMIT_HANDLER_DEFAULT_RATE_INTERVAL_NS;
+    _context->numa_bind_term_buffers = false;
+    _context->term_buffer_huge_pages = false;
+    _context->cnc_huge_pages = false;
+    _context->term_cleaner_dedicated = false;
+    _context->term_cleaner_non_temporal_stores = false;
+    _context->term_cleaner = NULL;
+    _context->sender_numa_node = -1;
+    _context->receiver_numa_node = -1;
 
     char *value = NULL;
 
@@ -338,6 +450,11 @@ int aeron_driver_context_init(aeron_driver_context_t **context)
         snprintf(_context->aeron_dir, AERON_MAX_PATH - 1, "%s", value);
     }
 
+    if ((value = getenv(AERON_XDP_INTERFACE_ENV_VAR)))
+    {
+        snprintf(_context->xdp_interface, sizeof(_context->xdp_interface), "%s", value);
+    }
+
     if ((value = getenv(AERON_AGENT_ON_START_FUNCTION_ENV_VAR)))
     {
         if ((_context->agent_on_start_func = aeron_agent_on_start_load(value)) == NULL)
@@ -386,6 +503,90 @@ int aeron_driver_context_init(aeron_driver_context_t **context)
         }
     }
 
+    if ((value = getenv(AERON_RECEIVER_TIMESTAMPING_ENV_VAR)))
+    {
+        if (strncmp(value, "SOFTWARE", sizeof("SOFTWARE")) == 0)
+        {
+            _context->receiver_timestamping = AERON_RECEIVER_TIMESTAMPING_SOFTWARE;
+        }
+        else if (strncmp(value, "HARDWARE", sizeof("HARDWARE")) == 0)
+        {
+            _context->receiver_timestamping = AERON_RECEIVER_TIMESTAMPING_HARDWARE;
+        }
+        else if (strncmp(value, "NONE", sizeof("NONE")) == 0)
+        {
+            _context->receiver_timestamping = AERON_RECEIVER_TIMESTAMPING_NONE;
+        }
+    }
+
+    if ((value = getenv(AERON_RECEIVER_SOCKET_FAN_OUT_STEERING_ENV_VAR)))
+    {
+        if (strncmp(value, "SESSION", sizeof("SESSION")) == 0)
+        {
+            _context->receiver_socket_fan_out_steering = AERON_UDP_CHANNEL_TRANSPORT_STEERING_SESSION;
+        }
+        else if (strncmp(value, "CPU", sizeof("CPU")) == 0)
+        {
+            _context->receiver_socket_fan_out_steering = AERON_UDP_CHANNEL_TRANSPORT_STEERING_CPU;
+        }
+        else if (strncmp(value, "HASH", sizeof("HASH")) == 0)
+        {
+            _context->receiver_socket_fan_out_steering = AERON_UDP_CHANNEL_TRANSPORT_STEERING_HASH;
+        }
+    }
+
+    if (aeron_parse_cpu_set(
+        AERON_CONFIG_GETENV_OR_DEFAULT(AERON_CONDUCTOR_CPU_AFFINITY_ENV_VAR, ""),
+        &_context->conductor_cpu_affinity) < 0 ||
+        aeron_parse_cpu_set(
+            AERON_CONFIG_GETENV_OR_DEFAULT(AERON_SENDER_CPU_AFFINITY_ENV_VAR, ""),
+            &_context->sender_cpu_affinity) < 0 ||
+        aeron_parse_cpu_set(
+            AERON_CONFIG_GETENV_OR_DEFAULT(AERON_RECEIVER_CPU_AFFINITY_ENV_VAR, ""),
+            &_context->receiver_cpu_affinity) < 0)
+    {
+        return -1;
+    }
+
+    _context->numa_bind_term_buffers = aeron_config_parse_bool(
+        getenv(AERON_NUMA_BIND_TERM_BUFFERS_ENV_VAR),
+        _context->numa_bind_term_buffers);
+
+    if (_context->numa_bind_term_buffers)
+    {
+        aeron_cpu_set_t *sender_cpus = &_context->sender_cpu_affinity;
+        aeron_cpu_set_t *receiver_cpus = &_context->receiver_cpu_affinity;
+
+        if (AERON_THREADING_MODE_SHARED == _context->threading_mode)
+        {
+            sender_cpus = &_context->conductor_cpu_affinity;
+            receiver_cpus = &_context->conductor_cpu_affinity;
+        }
+        else if (AERON_THREADING_MODE_SHARED_NETWORK == _context->threading_mode)
+        {
+            receiver_cpus = &_context->sender_cpu_affinity;
+        }
+
+        _context->sender_numa_node = aeron_cpu_set_numa_node(sender_cpus);
+        _context->receiver_numa_node = aeron_cpu_set_numa_node(receiver_cpus);
+    }
+
+    _context->term_buffer_huge_pages = aeron_config_parse_bool(
+        getenv(AERON_TERM_BUFFER_HUGE_PAGES_ENV_VAR),
+        _context->term_buffer_huge_pages);
+
+    _context->cnc_huge_pages = aeron_config_parse_bool(
+        getenv(AERON_CNC_HUGE_PAGES_ENV_VAR),
+        _context->cnc_huge_pages);
+
+    _context->term_cleaner_dedicated = aeron_config_parse_bool(
+        getenv(AERON_TERM_CLEANER_DEDICATED_ENV_VAR),
+        _context->term_cleaner_dedicated);
+
+    _context->term_cleaner_non_temporal_stores = aeron_config_parse_bool(
+        getenv(AERON_TERM_CLEANER_NON_TEMPORAL_STORES_ENV_VAR),
+        _context->term_cleaner_non_temporal_stores);
+
     _context->dirs_delete_on_start = aeron_config_parse_bool(
         getenv(AERON_DIR_DELETE_ON_START_ENV_VAR),
         _context->dirs_delete_on_start);
@@ -406,6 +607,26 @@ int aeron_driver_context_init(aeron_driver_context_t **context)
         getenv(AERON_SPIES_SIMULATE_CONNECTION_ENV_VAR),
         _context->spies_simulate_connection);
 
+    _context->io_uring_enabled = aeron_config_parse_bool(
+        getenv(AERON_IO_URING_ENABLED_ENV_VAR),
+        _context->io_uring_enabled);
+
+    _context->socket_gso_enabled = aeron_config_parse_bool(
+        getenv(AERON_SOCKET_GSO_ENABLED_ENV_VAR),
+        _context->socket_gso_enabled);
+
+    _context->socket_gro_enabled = aeron_config_parse_bool(
+        getenv(AERON_SOCKET_GRO_ENABLED_ENV_VAR),
+        _context->socket_gro_enabled);
+
+    _context->receiver_zero_copy_enabled = aeron_config_parse_bool(
+        getenv(AERON_RECEIVER_ZERO_COPY_ENABLED_ENV_VAR),
+        _context->receiver_zero_copy_enabled);
+
+    _context->sender_zero_copy_enabled = aeron_config_parse_bool(
+        getenv(AERON_SENDER_ZERO_COPY_ENABLED_ENV_VAR),
+        _context->sender_zero_copy_enabled);
+
     _context->to_driver_buffer_length = aeron_config_parse_size64(
         AERON_TO_CONDUCTOR_BUFFER_LENGTH_ENV_VAR,
         getenv(AERON_TO_CONDUCTOR_BUFFER_LENGTH_ENV_VAR),
@@ -585,6 +806,156 @@ int aeron_driver_context_init(aeron_driver_context_t **context)
         0,
         INT64_MAX);
 
+    _context->flow_control_receiver_timeout_ns = aeron_config_parse_duration_ns(
+        AERON_FLOW_CONTROL_RECEIVER_TIMEOUT_ENV_VAR,
+        getenv(AERON_FLOW_CONTROL_RECEIVER_TIMEOUT_ENV_VAR),
+        _context->flow_control_receiver_timeout_ns,
+        1000,
+        INT64_MAX);
+
+    _context->flow_control_group_tag = aeron_config_parse_int64(
+        AERON_FLOW_CONTROL_GROUP_TAG_ENV_VAR,
+        getenv(AERON_FLOW_CONTROL_GROUP_TAG_ENV_VAR),
+        _context->flow_control_group_tag,
+        INT64_MIN,
+        INT64_MAX);
+
+    _context->cubic_measure_rtt = aeron_config_parse_bool(
+        getenv(AERON_CUBICCONGESTIONCONTROL_MEASURERTT_ENV_VAR),
+        _context->cubic_measure_rtt);
+
+    _context->cubic_initial_rtt_ns = aeron_config_parse_duration_ns(
+        AERON_CUBICCONGESTIONCONTROL_INITIALRTT_ENV_VAR,
+        getenv(AERON_CUBICCONGESTIONCONTROL_INITIALRTT_ENV_VAR),
+        _context->cubic_initial_rtt_ns,
+        1000,
+        INT64_MAX);
+
+    _context->cubic_tcp_mode = aeron_config_parse_bool(
+        getenv(AERON_CUBICCONGESTIONCONTROL_TCPMODE_ENV_VAR),
+        _context->cubic_tcp_mode);
+
+    _context->io_uring_entries = (uint32_t)aeron_config_parse_uint64(
+        AERON_IO_URING_ENTRIES_ENV_VAR,
+        getenv(AERON_IO_URING_ENTRIES_ENV_VAR),
+        _context->io_uring_entries,
+        1,
+        32768);
+
+    _context->receiver_io_vector_capacity = (uint32_t)aeron_config_parse_uint64(
+        AERON_RECEIVER_IO_VECTOR_CAPACITY_ENV_VAR,
+        getenv(AERON_RECEIVER_IO_VECTOR_CAPACITY_ENV_VAR),
+        _context->receiver_io_vector_capacity,
+        1,
+        256);
+
+    _context->receiver_count = (size_t)aeron_config_parse_uint64(
+        AERON_RECEIVER_COUNT_ENV_VAR,
+        getenv(AERON_RECEIVER_COUNT_ENV_VAR),
+        _context->receiver_count,
+        1,
+        AERON_DRIVER_RECEIVER_COUNT_MAX);
+
+    _context->sender_count = (size_t)aeron_config_parse_uint64(
+        AERON_SENDER_COUNT_ENV_VAR,
+        getenv(AERON_SENDER_COUNT_ENV_VAR),
+        _context->sender_count,
+        1,
+        AERON_DRIVER_SENDER_COUNT_MAX);
+
+    _context->network_publication_max_messages_per_send = (size_t)aeron_config_parse_uint64(
+        AERON_NETWORK_PUBLICATION_MAX_MESSAGES_PER_SEND_ENV_VAR,
+        getenv(AERON_NETWORK_PUBLICATION_MAX_MESSAGES_PER_SEND_ENV_VAR),
+        _context->network_publication_max_messages_per_send,
+        1,
+        1024);
+
+    _context->send_batch_budget = (size_t)aeron_config_parse_uint64(
+        AERON_SENDER_SEND_BATCH_BUDGET_ENV_VAR,
+        getenv(AERON_SENDER_SEND_BATCH_BUDGET_ENV_VAR),
+        _context->send_batch_budget,
+        1,
+        1024);
+
+    _context->sender_zero_copy_threshold = (size_t)aeron_config_parse_size64(
+        AERON_SENDER_ZERO_COPY_THRESHOLD_ENV_VAR,
+        getenv(AERON_SENDER_ZERO_COPY_THRESHOLD_ENV_VAR),
+        _context->sender_zero_copy_threshold,
+        1,
+        AERON_MAX_UDP_PAYLOAD_LENGTH);
+
+    _context->xdp_queue = (uint32_t)aeron_config_parse_uint64(
+        AERON_XDP_QUEUE_ENV_VAR,
+        getenv(AERON_XDP_QUEUE_ENV_VAR),
+        _context->xdp_queue,
+        0,
+        1023);
+
+    _context->xdp_frame_count = (uint32_t)aeron_config_parse_uint64(
+        AERON_XDP_FRAME_COUNT_ENV_VAR,
+        getenv(AERON_XDP_FRAME_COUNT_ENV_VAR),
+        _context->xdp_frame_count,
+        2,
+        1024 * 1024);
+
+    _context->max_resend = (size_t)aeron_config_parse_uint64(
+        AERON_MAX_RESEND_ENV_VAR,
+        getenv(AERON_MAX_RESEND_ENV_VAR),
+        _context->max_resend,
+        1,
+        AERON_RETRANSMIT_HANDLER_MAX_RETRANSMITS_LIMIT);
+
+    _context->retransmit_rate_limit = aeron_config_parse_size64(
+        AERON_RETRANSMIT_RATE_LIMIT_ENV_VAR,
+        getenv(AERON_RETRANSMIT_RATE_LIMIT_ENV_VAR),
+        _context->retransmit_rate_limit,
+        0,
+        INT32_MAX);
+
+    _context->retransmit_rate_interval_ns = aeron_config_parse_duration_ns(
+        AERON_RETRANSMIT_RATE_INTERVAL_ENV_VAR,
+        getenv(AERON_RETRANSMIT_RATE_INTERVAL_ENV_VAR),
+        _context->retransmit_rate_interval_ns,
+        1000,
+        INT64_MAX);
+
+    _context->receiver_socket_fan_out = aeron_config_parse_uint64(
+        AERON_RECEIVER_SOCKET_FAN_OUT_ENV_VAR,
+        getenv(AERON_RECEIVER_SOCKET_FAN_OUT_ENV_VAR),
+        _context->receiver_socket_fan_out,
+        1,
+        64);
+
+    _context->receiver_socket_busy_poll_ns = aeron_config_parse_duration_ns(
+        AERON_RECEIVER_SOCKET_BUSY_POLL_ENV_VAR,
+        getenv(AERON_RECEIVER_SOCKET_BUSY_POLL_ENV_VAR),
+        _context->receiver_socket_busy_poll_ns,
+        0,
+        INT32_MAX * 1000LL);
+
+    aeron_config_parse_impairment(
+        &_context->data_impairment,
+        AERON_DEBUG_DATA_LOSS_RATE_ENV_VAR,
+        AERON_DEBUG_DATA_DUPLICATE_RATE_ENV_VAR,
+        AERON_DEBUG_DATA_REORDER_RATE_ENV_VAR,
+        AERON_DEBUG_DATA_DELAY_ENV_VAR,
+        AERON_DEBUG_DATA_DELAY_JITTER_ENV_VAR);
+
+    aeron_config_parse_impairment(
+        &_context->control_impairment,
+        AERON_DEBUG_CONTROL_LOSS_RATE_ENV_VAR,
+        AERON_DEBUG_CONTROL_DUPLICATE_RATE_ENV_VAR,
+        AERON_DEBUG_CONTROL_REORDER_RATE_ENV_VAR,
+        AERON_DEBUG_CONTROL_DELAY_ENV_VAR,
+        AERON_DEBUG_CONTROL_DELAY_JITTER_ENV_VAR);
+
+    _context->impairment_seed = aeron_config_parse_uint64(
+        AERON_DEBUG_IMPAIRMENT_SEED_ENV_VAR,
+        getenv(AERON_DEBUG_IMPAIRMENT_SEED_ENV_VAR),
+        _context->impairment_seed,
+        0,
+        UINT64_MAX);
+
     _context->to_driver_buffer = NULL;
     _context->to_clients_buffer = NULL;
     _context->counters_values_buffer = NULL;
@@ -594,25 +965,91 @@ int aeron_driver_context_init(aeron_driver_context_t **context)
     _context->nano_clock = aeron_nano_clock;
     _context->epoch_clock = aeron_epoch_clock;
 
+    _context->idle_strategy_max_spins = aeron_config_parse_uint64(
+        AERON_IDLE_STRATEGY_MAX_SPINS_ENV_VAR,
+        getenv(AERON_IDLE_STRATEGY_MAX_SPINS_ENV_VAR),
+        _context->idle_strategy_max_spins,
+        0,
+        INT32_MAX);
+
+    _context->idle_strategy_max_yields = aeron_config_parse_uint64(
+        AERON_IDLE_STRATEGY_MAX_YIELDS_ENV_VAR,
+        getenv(AERON_IDLE_STRATEGY_MAX_YIELDS_ENV_VAR),
+        _context->idle_strategy_max_yields,
+        0,
+        INT32_MAX);
+
+    _context->idle_strategy_min_park_period_ns = aeron_config_parse_duration_ns(
+        AERON_IDLE_STRATEGY_MIN_PARK_PERIOD_ENV_VAR,
+        getenv(AERON_IDLE_STRATEGY_MIN_PARK_PERIOD_ENV_VAR),
+        _context->idle_strategy_min_park_period_ns,
+        1,
+        INT64_MAX);
+
+    _context->idle_strategy_max_park_period_ns = aeron_config_parse_duration_ns(
+        AERON_IDLE_STRATEGY_MAX_PARK_PERIOD_ENV_VAR,
+        getenv(AERON_IDLE_STRATEGY_MAX_PARK_PERIOD_ENV_VAR),
+        _context->idle_strategy_max_park_period_ns,
+        _context->idle_strategy_min_park_period_ns,
+        INT64_MAX);
+
+    _context->controllable_idle_strategy_status_indicator = NULL;
+
+    _context->raw_log_pool_depth = aeron_config_parse_uint64(
+        AERON_RAW_LOG_POOL_DEPTH_ENV_VAR,
+        getenv(AERON_RAW_LOG_POOL_DEPTH_ENV_VAR),
+        _context->raw_log_pool_depth,
+        0,
+        AERON_RAW_LOG_POOL_MAX_DEPTH);
+    _context->raw_log_pool = NULL;
+
     _context->conductor_idle_strategy_func = aeron_idle_strategy_load(
         AERON_CONFIG_GETENV_OR_DEFAULT(AERON_CONDUCTOR_IDLE_STRATEGY_ENV_VAR, "yielding"),
-        &_context->conductor_idle_strategy_state);
+        &_context->conductor_idle_strategy_state,
+        _context);
 
     _context->shared_idle_strategy_func = aeron_idle_strategy_load(
         AERON_CONFIG_GETENV_OR_DEFAULT(AERON_SHARED_IDLE_STRATEGY_ENV_VAR, "yielding"),
-        &_context->shared_idle_strategy_state);
+        &_context->shared_idle_strategy_state,
+        _context);
 
     _context->shared_network_idle_strategy_func = aeron_idle_strategy_load(
         AERON_CONFIG_GETENV_OR_DEFAULT(AERON_SHAREDNETWORK_IDLE_STRATEGY_ENV_VAR, "yielding"),
-        &_context->shared_network_idle_strategy_state);
+        &_context->shared_network_idle_strategy_state,
+        _context);
 
     _context->sender_idle_strategy_func = aeron_idle_strategy_load(
         AERON_CONFIG_GETENV_OR_DEFAULT(AERON_SENDER_IDLE_STRATEGY_ENV_VAR, "noop"),
-        &_context->sender_idle_strategy_state);
+        &_context->sender_idle_strategy_state,
+        _context);
+
+    /* idle strategies keep state so every additional sender shard needs its own */
+    for (size_t i = 1; i < _context->sender_count; i++)
+    {
+        aeron_idle_strategy_load(
+            AERON_CONFIG_GETENV_OR_DEFAULT(AERON_SENDER_IDLE_STRATEGY_ENV_VAR, "noop"),
+            &_context->sender_shard_idle_strategy_states[i],
+            _context);
+    }
 
     _context->receiver_idle_strategy_func = aeron_idle_strategy_load(
         AERON_CONFIG_GETENV_OR_DEFAULT(AERON_RECEIVER_IDLE_STRATEGY_ENV_VAR, "noop"),
-        &_context->receiver_idle_strategy_state);
+        &_context->receiver_idle_strategy_state,
+        _context);
+
+    /* idle strategies keep state so every additional receiver shard needs its own */
+    for (size_t i = 1; i < _context->receiver_count; i++)
+    {
+        aeron_idle_strategy_load(
+            AERON_CONFIG_GETENV_OR_DEFAULT(AERON_RECEIVER_IDLE_STRATEGY_ENV_VAR, "noop"),
+            &_context->receiver_shard_idle_strategy_states[i],
+            _context);
+    }
+
+    _context->term_cleaner_idle_strategy_func = aeron_idle_strategy_load(
+        AERON_CONFIG_GETENV_OR_DEFAULT(AERON_TERM_CLEANER_IDLE_STRATEGY_ENV_VAR, "backoff"),
+        &_context->term_cleaner_idle_strategy_state,
+        _context);
 
     _context->usable_fs_space_func = _context->perform_storage_checks ?
         aeron_usable_fs_space : aeron_usable_fs_space_disabled;
@@ -661,6 +1098,18 @@ int aeron_driver_context_close(aeron_driver_context_t *context)
     aeron_free((void *)context->aeron_dir);
     aeron_free(context->conductor_idle_strategy_state);
     aeron_free(context->shared_idle_strategy_state);
+    aeron_free(context->shared_network_idle_strategy_state);
+    aeron_free(context->sender_idle_strategy_state);
+    for (size_t i = 0; i < AERON_DRIVER_SENDER_COUNT_MAX; i++)
+    {
+        aeron_free(context->sender_shard_idle_strategy_states[i]);
+    }
+    aeron_free(context->receiver_idle_strategy_state);
+    for (size_t i = 0; i < AERON_DRIVER_RECEIVER_COUNT_MAX; i++)
+    {
+        aeron_free(context->receiver_shard_idle_strategy_states[i]);
+    }
+    aeron_free(context->term_cleaner_idle_strategy_state);
     aeron_free(context);
 
     return 0;
@@ -686,6 +1135,21 @@ int aeron_driver_context_validate_mtu_length(uint64_t mtu_length)
     return 0;
 }
 
+int aeron_driver_context_validate_io_uring_entries(uint32_t io_uring_entries)
+{
+    if (!AERON_IS_POWER_OF_TWO(io_uring_entries))
+    {
+        aeron_set_err(
+            EINVAL,
+            "%s must be a power of 2: io_uring_entries=%" PRIu32,
+            AERON_IO_URING_ENTRIES_ENV_VAR,
+            io_uring_entries);
+        return -1;
+    }
+
+    return 0;
+}
+
 bool aeron_is_driver_active_with_cnc(
     aeron_mapped_file_t *cnc_mmap, int64_t timeout, int64_t now, aeron_log_func_t log_func)
 {
@@ -27,6 +27,10 @@
 #include "aeron_flow_control.h"
 #include "aeron_congestion_control.h"
 #include "aeron_agent.h"
+#include "aeron_raw_log_pool.h"
+#include "aeron_term_cleaner.h"
+#include "media/aeron_udp_transport_xdp.h"
+#include "media/aeron_udp_channel_impairment.h"
 
 #define AERON_CNC_FILE "cnc.dat"
 #define AERON_LOSS_REPORT_FILE "loss-report.dat"
@@ -53,6 +57,9 @@ aeron_cnc_metadata_t;
 
 #define AERON_COMMAND_QUEUE_CAPACITY (256)
 
+#define AERON_DRIVER_RECEIVER_COUNT_MAX (8)
+#define AERON_DRIVER_SENDER_COUNT_MAX (8)
+
 typedef struct aeron_driver_conductor_stct aeron_driver_conductor_t;
 
 typedef struct aeron_driver_conductor_proxy_stct aeron_driver_conductor_proxy_t;
@@ -71,6 +78,14 @@ typedef enum aeron_threading_mode_enum
 }
 aeron_threading_mode_t;
 
+typedef enum aeron_receiver_timestamping_enum
+{
+    AERON_RECEIVER_TIMESTAMPING_NONE,
+    AERON_RECEIVER_TIMESTAMPING_SOFTWARE,
+    AERON_RECEIVER_TIMESTAMPING_HARDWARE,
+}
+aeron_receiver_timestamping_t;
+
 typedef struct aeron_driver_context_stct
 {
     char *aeron_dir;                            /* aeron.dir */
@@ -80,6 +95,18 @@ typedef struct aeron_driver_context_stct
     bool term_buffer_sparse_file;               /* aeron.term.buffer.sparse.file = false */
     bool perform_storage_checks;                /* aeron.perform.storage.checks = true */
     bool spies_simulate_connection;             /* aeron.spies.simulate.connection = false */
+    bool io_uring_enabled;                      /* aeron.io.uring.enabled = false */
+    bool socket_gso_enabled;                    /* aeron.socket.gso.enabled = false */
+    bool socket_gro_enabled;                    /* aeron.socket.gro.enabled = false */
+    bool receiver_zero_copy_enabled;            /* aeron.receiver.zero.copy.enabled = false */
+    bool sender_zero_copy_enabled;              /* aeron.sender.zero.copy.enabled = false */
+    bool cubic_measure_rtt;                     /* aeron.CubicCongestionControl.measureRtt = false */
+    bool cubic_tcp_mode;                        /* aeron.CubicCongestionControl.tcpMode = false */
+    bool numa_bind_term_buffers;                /* aeron.numa.bind.term.buffers = false */
+    bool term_buffer_huge_pages;                /* aeron.term.buffer.huge.pages = false */
+    bool cnc_huge_pages;                        /* aeron.cnc.huge.pages = false */
+    bool term_cleaner_dedicated;                /* aeron.term.cleaner.dedicated = false */
+    bool term_cleaner_non_temporal_stores;      /* aeron.term.cleaner.non.temporal.stores = false */
     uint64_t driver_timeout_ms;                 /* aeron.driver.timeout = 10s */
     uint64_t client_liveness_timeout_ns;        /* aeron.client.liveness.timeout = 5s */
     uint64_t publication_linger_timeout_ns;     /* aeron.publication.linger.timeout = 5s */
@@ -89,6 +116,13 @@ typedef struct aeron_driver_context_stct
     uint64_t publication_connection_timeout_ns; /* aeron.publication.connection.timeout = 5s */
     uint64_t timer_interval_ns;                 /* aeron.timer.interval = 1s */
     uint64_t counter_free_to_reuse_ns;          /* aeron.counters.free.to.reuse.timeout = 1s */
+    uint64_t flow_control_receiver_timeout_ns;  /* aeron.flow.control.receiver.timeout = 2s */
+    int64_t flow_control_group_tag;             /* aeron.flow.control.group.tag = -1 */
+    uint64_t cubic_initial_rtt_ns;              /* aeron.CubicCongestionControl.initialRtt = 100us */
+    uint64_t idle_strategy_max_spins;           /* aeron.idle.strategy.max.spins = 10 */
+    uint64_t idle_strategy_max_yields;          /* aeron.idle.strategy.max.yields = 20 */
+    uint64_t idle_strategy_min_park_period_ns;  /* aeron.idle.strategy.min.park.period = 1us */
+    uint64_t idle_strategy_max_park_period_ns;  /* aeron.idle.strategy.max.park.period = 1ms */
     size_t to_driver_buffer_length;             /* aeron.conductor.buffer.length = 1MB + trailer*/
     size_t to_clients_buffer_length;            /* aeron.clients.buffer.length = 1MB + trailer */
     size_t counters_values_buffer_length;       /* aeron.counters.buffer.length = 1MB */
@@ -106,7 +140,34 @@ typedef struct aeron_driver_context_stct
     size_t initial_window_length;               /* aeron.rcv.initial.window.length = 128KB */
     size_t loss_report_length;                  /* aeron.loss.report.buffer.length = 1MB */
     size_t file_page_size;                      /* aeron.file.page.size = 4KB */
+    size_t raw_log_pool_depth;                  /* aeron.raw.log.pool.depth = 0 */
     uint8_t multicast_ttl;                      /* aeron.socket.multicast.ttl = 0 */
+    uint32_t io_uring_entries;                  /* aeron.io.uring.entries = 64 */
+    uint32_t receiver_io_vector_capacity;       /* aeron.receiver.io.vector.capacity = 32 */
+    size_t receiver_count;                      /* aeron.receiver.count = 1 */
+    size_t sender_count;                        /* aeron.sender.count = 1 */
+    size_t network_publication_max_messages_per_send; /* aeron.network.publication.max.messages.per.send = 4 */
+    size_t send_batch_budget;                   /* aeron.sender.send.batch.budget = 64 */
+    size_t sender_zero_copy_threshold;          /* aeron.sender.zero.copy.threshold = 8KB */
+    uint32_t xdp_queue;                         /* aeron.xdp.queue = 0 */
+    uint32_t xdp_frame_count;                   /* aeron.xdp.frame.count = 4096 */
+    char xdp_interface[IF_NAMESIZE];            /* aeron.xdp.interface = none */
+    aeron_receiver_timestamping_t receiver_timestamping; /* aeron.receiver.timestamping = NONE */
+    size_t receiver_socket_fan_out;             /* aeron.receiver.socket.fan.out = 1 */
+    /* aeron.receiver.socket.fan.out.steering = SESSION */
+    aeron_udp_channel_transport_steering_t receiver_socket_fan_out_steering;
+    uint64_t receiver_socket_busy_poll_ns;      /* aeron.receiver.socket.busy.poll = 0 */
+    aeron_udp_channel_impairment_params_t data_impairment;    /* aeron.debug.data.* = none */
+    aeron_udp_channel_impairment_params_t control_impairment; /* aeron.debug.control.* = none */
+    uint64_t impairment_seed;                   /* aeron.debug.impairment.seed = start time */
+    size_t max_resend;                          /* aeron.max.resend = 16 */
+    uint64_t retransmit_rate_limit;             /* aeron.retransmit.rate.limit = 0 */
+    uint64_t retransmit_rate_interval_ns;       /* aeron.retransmit.rate.interval = 1ms */
+    aeron_cpu_set_t conductor_cpu_affinity;     /* aeron.conductor.cpu.affinity = none */
+    aeron_cpu_set_t sender_cpu_affinity;        /* aeron.sender.cpu.affinity = none */
+    aeron_cpu_set_t receiver_cpu_affinity;      /* aeron.receiver.cpu.affinity = none */
+    int32_t sender_numa_node;                   /* node of sender_cpu_affinity if binding term buffers, else -1 */
+    int32_t receiver_numa_node;                 /* node of receiver_cpu_affinity if binding term buffers, else -1 */
 
     aeron_mapped_file_t cnc_map;
     aeron_mapped_file_t loss_report;
@@ -135,12 +196,20 @@ typedef struct aeron_driver_context_stct
     void *shared_network_idle_strategy_state;
     aeron_idle_strategy_func_t sender_idle_strategy_func;
     void *sender_idle_strategy_state;
+    void *sender_shard_idle_strategy_states[AERON_DRIVER_SENDER_COUNT_MAX];
     aeron_idle_strategy_func_t receiver_idle_strategy_func;
     void *receiver_idle_strategy_state;
+    void *receiver_shard_idle_strategy_states[AERON_DRIVER_RECEIVER_COUNT_MAX];
+    aeron_idle_strategy_func_t term_cleaner_idle_strategy_func;
+    void *term_cleaner_idle_strategy_state;
+    volatile int64_t *controllable_idle_strategy_status_indicator;
 
     aeron_usable_fs_space_func_t usable_fs_space_func;
     aeron_map_raw_log_func_t map_raw_log_func;
     aeron_map_raw_log_close_func_t map_raw_log_close_func;
+    aeron_raw_log_pool_t *raw_log_pool;
+    aeron_term_cleaner_t *term_cleaner;
+    aeron_udp_transport_xdp_t *xdp;
 
     aeron_flow_control_strategy_supplier_func_t unicast_flow_control_supplier_func;
     aeron_flow_control_strategy_supplier_func_t multicast_flow_control_supplier_func;
@@ -149,7 +218,9 @@ typedef struct aeron_driver_context_stct
 
     aeron_driver_conductor_proxy_t *conductor_proxy;
     aeron_driver_sender_proxy_t *sender_proxy;
+    aeron_driver_sender_proxy_t *sender_proxies[AERON_DRIVER_SENDER_COUNT_MAX];
     aeron_driver_receiver_proxy_t *receiver_proxy;
+    aeron_driver_receiver_proxy_t *receiver_proxies[AERON_DRIVER_RECEIVER_COUNT_MAX];
 
     aeron_driver_conductor_to_driver_interceptor_func_t to_driver_interceptor_func;
     aeron_driver_conductor_to_client_interceptor_func_t to_client_interceptor_func;
@@ -162,6 +233,8 @@ void aeron_driver_fill_cnc_metadata(aeron_driver_context_t *context);
 
 int aeron_driver_context_validate_mtu_length(uint64_t mtu_length);
 
+int aeron_driver_context_validate_io_uring_entries(uint32_t io_uring_entries);
+
 inline int32_t aeron_cnc_version_volatile(aeron_cnc_metadata_t *metadata)
 {
     int32_t cnc_version;
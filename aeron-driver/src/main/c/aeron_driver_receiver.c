@@ -22,9 +22,11 @@
 #include "aeron_socket.h"
 #include <stdio.h>
 #include "util/aeron_arrayutil.h"
+#include "util/aeron_bitutil.h"
 #include "media/aeron_receive_channel_endpoint.h"
 #include "aeron_driver_receiver.h"
 #include "aeron_publication_image.h"
+#include "aeron_position.h"
 
 #if !defined(HAVE_STRUCT_MMSGHDR)
 struct mmsghdr
@@ -34,36 +36,119 @@ struct mmsghdr
 };
 #endif
 
+static int aeron_driver_receiver_map_recv_slots(aeron_driver_receiver_t *receiver, size_t slot_length)
+{
+    struct aeron_driver_receiver_buffers_stct *buffers = &receiver->recv_buffers;
+    uint8_t *arena = NULL;
+    size_t offset = 0;
+
+    /* slots are whole cache line pairs so neighbouring datagrams never share a line, or an adjacent line prefetch */
+    slot_length = AERON_ALIGN(slot_length, AERON_CACHE_LINE_LENGTH * 2);
+
+    if (aeron_alloc_aligned((void **)&arena, &offset, buffers->capacity * slot_length, AERON_CACHE_LINE_LENGTH * 2) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "%s:%d: %s", __FILE__, __LINE__, strerror(errcode));
+        return -1;
+    }
+
+    aeron_free(buffers->arena);
+    buffers->arena = arena;
+    buffers->slot_length = slot_length;
+
+    for (size_t i = 0; i < buffers->capacity; i++)
+    {
+        buffers->iov[i].iov_base = arena + offset + (i * slot_length);
+        buffers->iov[i].iov_len = slot_length;
+    }
+
+    return 0;
+}
+
+static void aeron_driver_receiver_reset_recv_headers(aeron_driver_receiver_t *receiver, size_t length)
+{
+    struct aeron_driver_receiver_buffers_stct *buffers = &receiver->recv_buffers;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        struct mmsghdr *header = &buffers->mmsghdrs[i];
+
+        header->msg_hdr.msg_namelen = sizeof(buffers->addrs[i]);
+        header->msg_hdr.msg_flags = 0;
+        header->msg_hdr.msg_controllen = AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH;
+        header->msg_len = 0;
+    }
+}
+
 int aeron_driver_receiver_init(
     aeron_driver_receiver_t *receiver,
     aeron_driver_context_t *context,
     aeron_system_counters_t *system_counters,
     aeron_distinct_error_log_t *error_log)
 {
-    if (aeron_udp_transport_poller_init(&receiver->poller) < 0)
+    aeron_udp_transport_uring_t *uring = NULL;
+
+    if (context->io_uring_enabled)
     {
-        return -1;
+        if (aeron_udp_transport_uring_init(
+            &receiver->uring, context->io_uring_entries, AERON_DRIVER_RECEIVER_MAX_UDP_PACKET_LENGTH) < 0)
+        {
+            return -1;
+        }
+
+        uring = &receiver->uring;
     }
 
-    for (size_t i = 0; i < AERON_DRIVER_RECEIVER_NUM_RECV_BUFFERS; i++)
+    if (aeron_udp_transport_poller_init(&receiver->poller, uring, context->xdp) < 0)
     {
-        size_t offset = 0;
-        if (aeron_alloc_aligned(
-            (void **)&receiver->recv_buffers.buffers[i],
-            &offset,
-            AERON_DRIVER_RECEIVER_MAX_UDP_PACKET_LENGTH,
-            AERON_CACHE_LINE_LENGTH * 2) < 0)
+        if (NULL != uring)
         {
-            int errcode = errno;
-
-            aeron_set_err(errcode, "%s:%d: %s", __FILE__, __LINE__, strerror(errcode));
-            return -1;
+            aeron_udp_transport_uring_close(uring);
         }
 
-        receiver->recv_buffers.iov[i].iov_base = receiver->recv_buffers.buffers[i] + offset;
-        receiver->recv_buffers.iov[i].iov_len = AERON_DRIVER_RECEIVER_MAX_UDP_PACKET_LENGTH;
+        return -1;
     }
 
+    struct aeron_driver_receiver_buffers_stct *buffers = &receiver->recv_buffers;
+    const size_t capacity = context->receiver_io_vector_capacity;
+
+    buffers->arena = NULL;
+    buffers->capacity = capacity;
+
+    if (aeron_alloc((void **)&buffers->mmsghdrs, capacity * sizeof(struct mmsghdr)) < 0 ||
+        aeron_alloc((void **)&buffers->iov, capacity * sizeof(struct iovec)) < 0 ||
+        aeron_alloc((void **)&buffers->addrs, capacity * sizeof(struct sockaddr_storage)) < 0 ||
+        aeron_alloc((void **)&buffers->control, capacity * AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "%s:%d: %s", __FILE__, __LINE__, strerror(errcode));
+        return -1;
+    }
+
+    /*
+     * Coalesced GRO receives can be up to a full UDP packet, otherwise slots start at the MTU and grow to the largest
+     * sender MTU of the images added.
+     */
+    if (aeron_driver_receiver_map_recv_slots(
+        receiver, context->socket_gro_enabled ? AERON_DRIVER_RECEIVER_MAX_UDP_PACKET_LENGTH : context->mtu_length) < 0)
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < capacity; i++)
+    {
+        struct mmsghdr *header = &buffers->mmsghdrs[i];
+
+        header->msg_hdr.msg_name = &buffers->addrs[i];
+        header->msg_hdr.msg_iov = &buffers->iov[i];
+        header->msg_hdr.msg_iovlen = 1;
+        header->msg_hdr.msg_control = buffers->control + (i * AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH);
+    }
+
+    aeron_driver_receiver_reset_recv_headers(receiver, capacity);
+
     receiver->images.array = NULL;
     receiver->images.length = 0;
     receiver->images.capacity = 0;
@@ -80,6 +165,7 @@ int aeron_driver_receiver_init(
         aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_RECEIVER_PROXY_FAILS);
     receiver->receiver_proxy.threading_mode = context->threading_mode;
     receiver->receiver_proxy.receiver = receiver;
+    receiver->receiver_proxy.endpoint_count = 0;
 
     receiver->errors_counter =
         aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_ERRORS);
@@ -88,9 +174,70 @@ int aeron_driver_receiver_init(
     receiver->total_bytes_received_counter =
         aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_BYTES_RECEIVED);
 
+    receiver->cached_clock_ns = context->nano_clock();
+
+    receiver->impairment = NULL;
+    if (aeron_udp_channel_impairment_params_is_enabled(&context->data_impairment) &&
+        aeron_udp_channel_impairment_create(
+            &receiver->impairment,
+            &context->data_impairment,
+            context->impairment_seed,
+            aeron_receive_channel_endpoint_dispatch,
+            receiver) < 0)
+    {
+        return -1;
+    }
+
+    receiver->shard.index = 0;
+    receiver->shard.bytes_received_counter = NULL;
+    receiver->shard.images_counter = NULL;
+
+    return 0;
+}
+
+int aeron_driver_receiver_shard_init(
+    aeron_driver_receiver_t *receiver, aeron_counters_manager_t *counters_manager, int32_t shard_index)
+{
+    int32_t bytes_received_counter_id = aeron_counter_receiver_shard_allocate(
+        counters_manager, AERON_COUNTER_RECEIVER_SHARD_BYTES_RECEIVED_NAME, shard_index);
+    int32_t images_counter_id = aeron_counter_receiver_shard_allocate(
+        counters_manager, AERON_COUNTER_RECEIVER_SHARD_IMAGES_NAME, shard_index);
+
+    if (bytes_received_counter_id < 0 || images_counter_id < 0)
+    {
+        return -1;
+    }
+
+    receiver->shard.index = shard_index;
+    receiver->shard.bytes_received_counter = aeron_counter_addr(counters_manager, bytes_received_counter_id);
+    receiver->shard.images_counter = aeron_counter_addr(counters_manager, images_counter_id);
+
+    if (NULL != receiver->impairment)
+    {
+        aeron_udp_channel_impairment_seed(receiver->impairment, receiver->context->impairment_seed + shard_index);
+    }
+
+    if (shard_index > 0)
+    {
+        if (aeron_spsc_concurrent_array_queue_init(&receiver->shard.command_queue, AERON_COMMAND_QUEUE_CAPACITY) < 0)
+        {
+            return -1;
+        }
+
+        receiver->receiver_proxy.command_queue = &receiver->shard.command_queue;
+    }
+
     return 0;
 }
 
+void aeron_driver_receiver_shard_close(aeron_driver_receiver_t *receiver)
+{
+    if (receiver->shard.index > 0)
+    {
+        aeron_spsc_concurrent_array_queue_close(&receiver->shard.command_queue);
+    }
+}
+
 void aeron_driver_receiver_on_command(void *clientd, volatile void *item)
 {
     aeron_command_base_t *cmd = (aeron_command_base_t *)item;
@@ -100,48 +247,59 @@ void aeron_driver_receiver_on_command(void *clientd, volatile void *item)
 
 int aeron_driver_receiver_do_work(void *clientd)
 {
-    struct mmsghdr mmsghdr[AERON_DRIVER_RECEIVER_NUM_RECV_BUFFERS];
     aeron_driver_receiver_t *receiver = (aeron_driver_receiver_t *)clientd;
     int64_t bytes_received = 0;
     int work_count = 0;
+    int64_t now_ns = receiver->context->nano_clock();
+
+    receiver->cached_clock_ns = now_ns;
 
     work_count +=
         aeron_spsc_concurrent_array_queue_drain(
             receiver->receiver_proxy.command_queue, aeron_driver_receiver_on_command, receiver, 10);
 
-    for (size_t i = 0; i < AERON_DRIVER_RECEIVER_NUM_RECV_BUFFERS; i++)
+    aeron_udp_transport_recv_func_t recv_func = aeron_receive_channel_endpoint_dispatch;
+    void *recv_clientd = receiver;
+
+    if (NULL != receiver->impairment)
     {
-        mmsghdr[i].msg_hdr.msg_name = &receiver->recv_buffers.addrs[i];
-        mmsghdr[i].msg_hdr.msg_namelen = sizeof(receiver->recv_buffers.addrs[i]);
-        mmsghdr[i].msg_hdr.msg_iov = &receiver->recv_buffers.iov[i];
-        mmsghdr[i].msg_hdr.msg_iovlen = 1;
-        mmsghdr[i].msg_hdr.msg_flags = 0;
-        mmsghdr[i].msg_hdr.msg_control = NULL;
-        mmsghdr[i].msg_hdr.msg_controllen = 0;
-        mmsghdr[i].msg_len = 0;
+        work_count += aeron_udp_channel_impairment_release(receiver->impairment, now_ns);
+        recv_func = aeron_udp_channel_impairment_on_recv;
+        recv_clientd = receiver->impairment;
     }
 
     int poll_result = aeron_udp_transport_poller_poll(
         &receiver->poller,
-        mmsghdr,
-        AERON_DRIVER_RECEIVER_NUM_RECV_BUFFERS,
-        aeron_receive_channel_endpoint_dispatch,
-        receiver);
+        receiver->recv_buffers.mmsghdrs,
+        receiver->recv_buffers.capacity,
+        &bytes_received,
+        recv_func,
+        recv_clientd);
 
     if (poll_result < 0)
     {
         AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver poller_poll: %s", aeron_errmsg());
+        aeron_driver_receiver_reset_recv_headers(receiver, receiver->recv_buffers.capacity);
     }
-
-    for (int i = 0; i < poll_result; i++)
+    else
     {
-        bytes_received += mmsghdr[i].msg_len;
-        work_count++;
+        /*
+         * Each datagram is at least one unit of work and every receive fills from the front, so only those headers
+         * need their kernel written fields reset. One more covers the recvmsg fallback stopping on an empty datagram.
+         */
+        size_t used = (size_t)poll_result + 1;
+        aeron_driver_receiver_reset_recv_headers(
+            receiver, used < receiver->recv_buffers.capacity ? used : receiver->recv_buffers.capacity);
     }
 
-    aeron_counter_add_ordered(receiver->total_bytes_received_counter, bytes_received);
+    work_count += (poll_result < 0) ? 0 : poll_result;
 
-    int64_t now_ns = receiver->context->nano_clock();
+    aeron_counter_shared_increment(
+        receiver->total_bytes_received_counter, bytes_received, receiver->context->receiver_count > 1);
+    if (NULL != receiver->shard.bytes_received_counter)
+    {
+        aeron_counter_add_ordered(receiver->shard.bytes_received_counter, bytes_received);
+    }
 
     for (size_t i = 0, length = receiver->images.length; i < length; i++)
     {
@@ -213,6 +371,11 @@ int aeron_driver_receiver_do_work(void *clientd)
         }
     }
 
+    if (NULL != receiver->poller.uring && aeron_udp_transport_uring_submit(receiver->poller.uring) < 0)
+    {
+        AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver io_uring submit: %s", aeron_errmsg());
+    }
+
     return work_count;
 }
 
@@ -220,13 +383,20 @@ void aeron_driver_receiver_on_close(void *clientd)
 {
     aeron_driver_receiver_t *receiver = (aeron_driver_receiver_t *)clientd;
 
-    for (size_t i = 0; i < AERON_DRIVER_RECEIVER_NUM_RECV_BUFFERS; i++)
-    {
-        aeron_free(receiver->recv_buffers.buffers[i]);
-    }
+    aeron_free(receiver->recv_buffers.arena);
+    aeron_free(receiver->recv_buffers.mmsghdrs);
+    aeron_free(receiver->recv_buffers.iov);
+    aeron_free(receiver->recv_buffers.addrs);
+    aeron_free(receiver->recv_buffers.control);
 
     aeron_free(receiver->images.array);
     aeron_free(receiver->pending_setups.array);
+    aeron_udp_channel_impairment_delete(receiver->impairment);
+
+    if (NULL != receiver->poller.uring)
+    {
+        aeron_udp_transport_uring_close(receiver->poller.uring);
+    }
 
     aeron_udp_transport_poller_close(&receiver->poller);
 }
@@ -238,11 +408,22 @@ void aeron_driver_receiver_on_add_endpoint(void *clientd, void *command)
     aeron_receive_channel_endpoint_t *endpoint = (aeron_receive_channel_endpoint_t *)cmd->item;
     aeron_udp_channel_t *udp_channel = endpoint->conductor_fields.udp_channel;
 
-    if (aeron_udp_transport_poller_add(&receiver->poller, &endpoint->transport) < 0)
+    endpoint->transport.truncated_counter = receiver->invalid_frames_counter;
+    if (!endpoint->is_manual_control_mode &&
+        aeron_udp_transport_poller_add(&receiver->poller, &endpoint->transport) < 0)
     {
         AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver on_add_endpoint: %s", aeron_errmsg());
     }
 
+    for (size_t i = 0; i < endpoint->fan_out.length; i++)
+    {
+        endpoint->fan_out.transports[i].truncated_counter = receiver->invalid_frames_counter;
+        if (aeron_udp_transport_poller_add(&receiver->poller, &endpoint->fan_out.transports[i]) < 0)
+        {
+            AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver on_add_endpoint: %s", aeron_errmsg());
+        }
+    }
+
     if (udp_channel->explicit_control)
     {
         if (aeron_driver_receiver_add_pending_setup(receiver, endpoint, 0, 0, &udp_channel->local_control) < 0)
@@ -273,11 +454,31 @@ void aeron_driver_receiver_on_remove_endpoint(void *clientd, void *command)
     aeron_command_base_t *cmd = (aeron_command_base_t *)command;
     aeron_receive_channel_endpoint_t *endpoint = (aeron_receive_channel_endpoint_t *)cmd->item;
 
-    if (aeron_udp_transport_poller_remove(&receiver->poller, &endpoint->transport) < 0)
+    if (!endpoint->is_manual_control_mode &&
+        aeron_udp_transport_poller_remove(&receiver->poller, &endpoint->transport) < 0)
     {
         AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver on_remove_endpoint: %s", aeron_errmsg());
     }
 
+    for (size_t i = 0; i < endpoint->fan_out.length; i++)
+    {
+        if (aeron_udp_transport_poller_remove(&receiver->poller, &endpoint->fan_out.transports[i]) < 0)
+        {
+            AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver on_remove_endpoint: %s", aeron_errmsg());
+        }
+    }
+
+    /* destinations stay with the endpoint to be deleted along with it */
+    for (size_t i = 0, length = endpoint->destinations.length; i < length; i++)
+    {
+        aeron_receive_destination_t *destination = endpoint->destinations.array[i].destination;
+
+        if (aeron_udp_transport_poller_remove(&receiver->poller, &destination->transport) < 0)
+        {
+            AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver on_remove_endpoint: %s", aeron_errmsg());
+        }
+    }
+
     for (int last_index = (int)receiver->pending_setups.length - 1, i = last_index; i >= 0; i--)
     {
         aeron_driver_receiver_pending_setup_entry_t *entry = &receiver->pending_setups.array[i];
@@ -294,10 +495,66 @@ void aeron_driver_receiver_on_remove_endpoint(void *clientd, void *command)
         }
     }
 
+    if (NULL != receiver->impairment)
+    {
+        aeron_udp_channel_impairment_remove(receiver->impairment, endpoint);
+    }
+
     aeron_receive_channel_endpoint_receiver_release(endpoint);
     aeron_driver_conductor_proxy_on_delete_cmd(receiver->context->conductor_proxy, command);
 }
 
+void aeron_driver_receiver_on_add_destination(void *clientd, void *item)
+{
+    aeron_driver_receiver_t *receiver = (aeron_driver_receiver_t *)clientd;
+    aeron_command_receive_destination_t *cmd = (aeron_command_receive_destination_t *)item;
+    aeron_receive_channel_endpoint_t *endpoint = (aeron_receive_channel_endpoint_t *)cmd->endpoint;
+    aeron_receive_destination_t *destination = (aeron_receive_destination_t *)cmd->destination;
+
+    if (aeron_receive_channel_endpoint_add_destination(endpoint, destination) < 0)
+    {
+        AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver on_add_destination: %s", aeron_errmsg());
+        aeron_receive_destination_delete(destination);
+    }
+    else
+    {
+        destination->transport.truncated_counter = receiver->invalid_frames_counter;
+        if (aeron_udp_transport_poller_add(&receiver->poller, &destination->transport) < 0)
+        {
+            AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver on_add_destination: %s", aeron_errmsg());
+        }
+    }
+
+    aeron_driver_conductor_proxy_on_delete_cmd(receiver->context->conductor_proxy, item);
+}
+
+void aeron_driver_receiver_on_remove_destination(void *clientd, void *item)
+{
+    aeron_driver_receiver_t *receiver = (aeron_driver_receiver_t *)clientd;
+    aeron_command_receive_destination_t *cmd = (aeron_command_receive_destination_t *)item;
+    aeron_receive_channel_endpoint_t *endpoint = (aeron_receive_channel_endpoint_t *)cmd->endpoint;
+    aeron_udp_channel_t *udp_channel = (aeron_udp_channel_t *)cmd->udp_channel;
+    aeron_receive_destination_t *destination = aeron_receive_channel_endpoint_remove_destination(endpoint, udp_channel);
+
+    if (NULL != destination)
+    {
+        if (aeron_udp_transport_poller_remove(&receiver->poller, &destination->transport) < 0)
+        {
+            AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver on_remove_destination: %s", aeron_errmsg());
+        }
+
+        if (NULL != receiver->impairment)
+        {
+            aeron_udp_channel_impairment_remove(receiver->impairment, destination);
+        }
+
+        aeron_receive_destination_delete(destination);
+    }
+
+    aeron_udp_channel_delete(udp_channel);
+    aeron_driver_conductor_proxy_on_delete_cmd(receiver->context->conductor_proxy, item);
+}
+
 void aeron_driver_receiver_on_add_subscription(void *clientd, void *item)
 {
     aeron_driver_receiver_t *receiver = (aeron_driver_receiver_t *)clientd;
@@ -326,6 +583,27 @@ void aeron_driver_receiver_on_remove_subscription(void *clientd, void *item)
     aeron_driver_conductor_proxy_on_delete_cmd(receiver->context->conductor_proxy, item);
 }
 
+static void aeron_driver_receiver_update_zero_copy_image(
+    aeron_driver_receiver_t *receiver, aeron_receive_channel_endpoint_t *endpoint)
+{
+    aeron_publication_image_t *zero_copy_image = NULL;
+    size_t image_count = 0;
+
+    for (size_t i = 0, length = receiver->images.length; i < length; i++)
+    {
+        aeron_publication_image_t *image = receiver->images.array[i].image;
+
+        if (endpoint == image->endpoint)
+        {
+            zero_copy_image = image;
+            image_count++;
+        }
+    }
+
+    /* with more than one image the next datagram could be for any of them, so there is nowhere to put it up front */
+    aeron_receive_channel_endpoint_set_zero_copy_image(endpoint, 1 == image_count ? zero_copy_image : NULL);
+}
+
 void aeron_driver_receiver_on_add_publication_image(void *clientd, void *item)
 {
     aeron_driver_receiver_t *receiver = (aeron_driver_receiver_t *)clientd;
@@ -341,6 +619,20 @@ void aeron_driver_receiver_on_add_publication_image(void *clientd, void *item)
     }
 
     receiver->images.array[receiver->images.length++].image = cmd->image;
+    if (NULL != receiver->shard.images_counter)
+    {
+        aeron_counter_set_ordered(receiver->shard.images_counter, (int64_t)receiver->images.length);
+    }
+
+    const size_t sender_mtu_length = (size_t)((aeron_publication_image_t *)cmd->image)->mtu_length;
+    if (sender_mtu_length > receiver->recv_buffers.slot_length &&
+        aeron_driver_receiver_map_recv_slots(receiver, sender_mtu_length) < 0)
+    {
+        AERON_DRIVER_RECEIVER_ERROR(receiver, "receiver recv slots: %s", aeron_errmsg());
+    }
+
+    aeron_driver_receiver_update_zero_copy_image(receiver, endpoint);
+
     aeron_driver_conductor_proxy_on_delete_cmd(receiver->context->conductor_proxy, item);
 }
 
@@ -362,10 +654,19 @@ void aeron_driver_receiver_on_remove_publication_image(void *clientd, void *item
             aeron_array_fast_unordered_remove(
                 (uint8_t *)receiver->images.array, sizeof(aeron_driver_receiver_image_entry_t), i, last_index);
             receiver->images.length--;
+            if (NULL != receiver->shard.images_counter)
+            {
+                aeron_counter_set_ordered(receiver->shard.images_counter, (int64_t)receiver->images.length);
+            }
             break;
         }
     }
 
+    if (NULL != endpoint)
+    {
+        aeron_driver_receiver_update_zero_copy_image(receiver, endpoint);
+    }
+
     aeron_driver_conductor_proxy_on_delete_cmd(receiver->context->conductor_proxy, item);
 }
 
@@ -18,12 +18,12 @@
 #define AERON_DRIVER_RECEIVER_H
 
 #include "media/aeron_udp_transport_poller.h"
+#include "media/aeron_udp_channel_impairment.h"
 #include "concurrent/aeron_distinct_error_log.h"
 #include "aeron_driver_context.h"
 #include "aeron_driver_receiver_proxy.h"
 #include "aeron_system_counters.h"
 
-#define AERON_DRIVER_RECEIVER_NUM_RECV_BUFFERS (2)
 #define AERON_DRIVER_RECEIVER_MAX_UDP_PACKET_LENGTH (64 * 1024)
 
 #define AERON_DRIVER_RECEIVER_PENDING_SETUP_TIMEOUT_NS (1000 * 1000 * 1000L)
@@ -49,12 +49,17 @@ typedef struct aeron_driver_receiver_stct
 {
     aeron_driver_receiver_proxy_t receiver_proxy;
     aeron_udp_transport_poller_t poller;
+    aeron_udp_transport_uring_t uring;
 
     struct aeron_driver_receiver_buffers_stct
     {
-        uint8_t *buffers[AERON_DRIVER_RECEIVER_NUM_RECV_BUFFERS];
-        struct iovec iov[AERON_DRIVER_RECEIVER_NUM_RECV_BUFFERS];
-        struct sockaddr_storage addrs[AERON_DRIVER_RECEIVER_NUM_RECV_BUFFERS];
+        uint8_t *arena;
+        size_t slot_length;
+        size_t capacity;
+        struct mmsghdr *mmsghdrs;
+        struct iovec *iov;
+        struct sockaddr_storage *addrs;
+        uint8_t *control;
     }
     recv_buffers;
 
@@ -80,6 +85,21 @@ typedef struct aeron_driver_receiver_stct
     int64_t *errors_counter;
     int64_t *invalid_frames_counter;
     int64_t *total_bytes_received_counter;
+
+    /* clock read once per duty cycle so per datagram bookkeeping does not have to */
+    int64_t cached_clock_ns;
+
+    /* frames polled go through this on their way to the endpoints when aeron.debug.data.* is set */
+    aeron_udp_channel_impairment_t *impairment;
+
+    struct aeron_driver_receiver_shard_stct
+    {
+        aeron_spsc_concurrent_array_queue_t command_queue;
+        int32_t index;
+        int64_t *bytes_received_counter;
+        int64_t *images_counter;
+    }
+    shard;
 }
 aeron_driver_receiver_t;
 
@@ -101,12 +121,24 @@ int aeron_driver_receiver_init(
     aeron_system_counters_t *system_counters,
     aeron_distinct_error_log_t *error_log);
 
+/*
+ * Make an initialised receiver one of several, each polling its own shard of the receive channel endpoints. Shards
+ * other than 0 take commands on a queue of their own rather than the context's. Each shard reports its own counters.
+ */
+int aeron_driver_receiver_shard_init(
+    aeron_driver_receiver_t *receiver, aeron_counters_manager_t *counters_manager, int32_t shard_index);
+
+void aeron_driver_receiver_shard_close(aeron_driver_receiver_t *receiver);
+
 int aeron_driver_receiver_do_work(void *clientd);
 void aeron_driver_receiver_on_close(void *clientd);
 
 void aeron_driver_receiver_on_add_endpoint(void *clientd, void *item);
 void aeron_driver_receiver_on_remove_endpoint(void *clientd, void *item);
 
+void aeron_driver_receiver_on_add_destination(void *clientd, void *item);
+void aeron_driver_receiver_on_remove_destination(void *clientd, void *item);
+
 void aeron_driver_receiver_on_add_subscription(void *clientd, void *item);
 void aeron_driver_receiver_on_remove_subscription(void *clientd, void *item);
 
@@ -28,6 +28,21 @@ void aeron_driver_receiver_proxy_offer(aeron_driver_receiver_proxy_t *receiver_p
     }
 }
 
+aeron_driver_receiver_proxy_t *aeron_driver_receiver_proxy_for_new_endpoint(aeron_driver_context_t *context)
+{
+    aeron_driver_receiver_proxy_t *receiver_proxy = context->receiver_proxy;
+
+    for (size_t i = 1; i < context->receiver_count && NULL != context->receiver_proxies[i]; i++)
+    {
+        if (context->receiver_proxies[i]->endpoint_count < receiver_proxy->endpoint_count)
+        {
+            receiver_proxy = context->receiver_proxies[i];
+        }
+    }
+
+    return receiver_proxy;
+}
+
 void aeron_driver_receiver_proxy_on_delete_create_publication_image_cmd(
     aeron_driver_receiver_proxy_t *receiver_proxy, aeron_command_base_t *cmd)
 {
@@ -277,3 +292,77 @@ void aeron_driver_receiver_proxy_on_remove_cool_down(
         aeron_driver_receiver_proxy_offer(receiver_proxy, cmd);
     }
 }
+
+void aeron_driver_receiver_proxy_on_add_destination(
+    aeron_driver_receiver_proxy_t *receiver_proxy,
+    aeron_receive_channel_endpoint_t *endpoint,
+    aeron_receive_destination_t *destination)
+{
+    if (AERON_THREADING_MODE_SHARED == receiver_proxy->threading_mode)
+    {
+        aeron_command_receive_destination_t cmd =
+            {
+                .base = { .func = aeron_driver_receiver_on_add_destination, .item = NULL },
+                .endpoint = endpoint,
+                .destination = destination,
+                .udp_channel = NULL
+            };
+
+        aeron_driver_receiver_on_add_destination(receiver_proxy->receiver, &cmd);
+    }
+    else
+    {
+        aeron_command_receive_destination_t *cmd;
+
+        if (aeron_alloc((void **)&cmd, sizeof(aeron_command_receive_destination_t)) < 0)
+        {
+            aeron_counter_ordered_increment(receiver_proxy->fail_counter, 1);
+            return;
+        }
+
+        cmd->base.func = aeron_driver_receiver_on_add_destination;
+        cmd->base.item = NULL;
+        cmd->endpoint = endpoint;
+        cmd->destination = destination;
+        cmd->udp_channel = NULL;
+
+        aeron_driver_receiver_proxy_offer(receiver_proxy, cmd);
+    }
+}
+
+void aeron_driver_receiver_proxy_on_remove_destination(
+    aeron_driver_receiver_proxy_t *receiver_proxy,
+    aeron_receive_channel_endpoint_t *endpoint,
+    aeron_udp_channel_t *udp_channel)
+{
+    if (AERON_THREADING_MODE_SHARED == receiver_proxy->threading_mode)
+    {
+        aeron_command_receive_destination_t cmd =
+            {
+                .base = { .func = aeron_driver_receiver_on_remove_destination, .item = NULL },
+                .endpoint = endpoint,
+                .udp_channel = udp_channel,
+                .destination = NULL
+            };
+
+        aeron_driver_receiver_on_remove_destination(receiver_proxy->receiver, &cmd);
+    }
+    else
+    {
+        aeron_command_receive_destination_t *cmd;
+
+        if (aeron_alloc((void **)&cmd, sizeof(aeron_command_receive_destination_t)) < 0)
+        {
+            aeron_counter_ordered_increment(receiver_proxy->fail_counter, 1);
+            return;
+        }
+
+        cmd->base.func = aeron_driver_receiver_on_remove_destination;
+        cmd->base.item = NULL;
+        cmd->endpoint = endpoint;
+        cmd->udp_channel = udp_channel;
+        cmd->destination = NULL;
+
+        aeron_driver_receiver_proxy_offer(receiver_proxy, cmd);
+    }
+}
@@ -22,6 +22,8 @@
 typedef struct aeron_driver_receiver_stct aeron_driver_receiver_t;
 typedef struct aeron_receive_channel_endpoint_stct aeron_receive_channel_endpoint_t;
 typedef struct aeron_publication_image_stct aeron_publication_image_t;
+typedef struct aeron_receive_destination_stct aeron_receive_destination_t;
+typedef struct aeron_udp_channel_stct aeron_udp_channel_t;
 
 typedef struct aeron_driver_receiver_proxy_stct
 {
@@ -29,9 +31,15 @@ typedef struct aeron_driver_receiver_proxy_stct
     aeron_threading_mode_t threading_mode;
     aeron_spsc_concurrent_array_queue_t *command_queue;
     int64_t *fail_counter;
+    size_t endpoint_count;
 }
 aeron_driver_receiver_proxy_t;
 
+/*
+ * Receiver a new receive channel endpoint should be sharded to, the one with the fewest endpoints. Conductor only.
+ */
+aeron_driver_receiver_proxy_t *aeron_driver_receiver_proxy_for_new_endpoint(aeron_driver_context_t *context);
+
 void aeron_driver_receiver_proxy_on_delete_create_publication_image_cmd(
     aeron_driver_receiver_proxy_t *receiver_proxy, aeron_command_base_t *cmd);
 
@@ -84,4 +92,22 @@ void aeron_driver_receiver_proxy_on_remove_cool_down(
     int32_t session_id,
     int32_t stream_id);
 
+typedef struct aeron_command_receive_destination_stct
+{
+    aeron_command_base_t base;
+    void *endpoint;
+    void *destination;
+    void *udp_channel;
+}
+aeron_command_receive_destination_t;
+
+void aeron_driver_receiver_proxy_on_add_destination(
+    aeron_driver_receiver_proxy_t *receiver_proxy,
+    aeron_receive_channel_endpoint_t *endpoint,
+    aeron_receive_destination_t *destination);
+void aeron_driver_receiver_proxy_on_remove_destination(
+    aeron_driver_receiver_proxy_t *receiver_proxy,
+    aeron_receive_channel_endpoint_t *endpoint,
+    aeron_udp_channel_t *udp_channel);
+
 #endif //AERON_DRIVER_RECEIVER_PROXY_H
@@ -34,6 +34,7 @@ struct mmsghdr
 #include "media/aeron_send_channel_endpoint.h"
 #include "aeron_driver_sender.h"
 #include "aeron_driver_conductor_proxy.h"
+#include "aeron_position.h"
 
 int aeron_driver_sender_init(
     aeron_driver_sender_t *sender,
@@ -41,8 +42,25 @@ int aeron_driver_sender_init(
     aeron_system_counters_t *system_counters,
     aeron_distinct_error_log_t *error_log)
 {
-    if (aeron_udp_transport_poller_init(&sender->poller) < 0)
+    aeron_udp_transport_uring_t *uring = NULL;
+
+    if (context->io_uring_enabled)
     {
+        if (aeron_udp_transport_uring_init(&sender->uring, context->io_uring_entries, context->mtu_length) < 0)
+        {
+            return -1;
+        }
+
+        uring = &sender->uring;
+    }
+
+    if (aeron_udp_transport_poller_init(&sender->poller, uring, NULL) < 0)
+    {
+        if (NULL != uring)
+        {
+            aeron_udp_transport_uring_close(uring);
+        }
+
         return -1;
     }
 
@@ -72,6 +90,8 @@ int aeron_driver_sender_init(
     sender->sender_proxy.fail_counter =
         aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_SENDER_PROXY_FAILS);
     sender->sender_proxy.threading_mode = context->threading_mode;
+    sender->sender_proxy.endpoint_count = 0;
+    sender->sender_proxy.publication_count = 0;
 
     sender->network_publications.array = NULL;
     sender->network_publications.length = 0;
@@ -82,6 +102,9 @@ int aeron_driver_sender_init(
     sender->duty_cycle_ratio = context->send_to_sm_poll_ratio;
     sender->status_message_read_timeout_ns = context->status_message_timeout_ns / 2;
     sender->control_poll_timeout_ns = 0;
+    sender->send_batch_budget = context->send_batch_budget;
+    sender->max_messages_per_send = context->network_publication_max_messages_per_send;
+    sender->active_publications = 0;
     sender->total_bytes_sent_counter =
         aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_BYTES_SENT);
     sender->errors_counter =
@@ -92,10 +115,71 @@ int aeron_driver_sender_init(
         aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_STATUS_MESSAGES_RECEIVED);
     sender->nak_messages_received_counter =
         aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_NAK_MESSAGES_RECEIVED);
+    sender->short_sends_counter =
+        aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_SHORT_SENDS);
+
+    sender->impairment = NULL;
+    if (aeron_udp_channel_impairment_params_is_enabled(&context->control_impairment) &&
+        aeron_udp_channel_impairment_create(
+            &sender->impairment,
+            &context->control_impairment,
+            context->impairment_seed,
+            aeron_send_channel_endpoint_dispatch,
+            sender) < 0)
+    {
+        return -1;
+    }
+
+    sender->shard.index = 0;
+    sender->shard.bytes_sent_counter = NULL;
+    sender->shard.publications_counter = NULL;
+
+    return 0;
+}
+
+int aeron_driver_sender_shard_init(
+    aeron_driver_sender_t *sender, aeron_counters_manager_t *counters_manager, int32_t shard_index)
+{
+    int32_t bytes_sent_counter_id = aeron_counter_sender_shard_allocate(
+        counters_manager, AERON_COUNTER_SENDER_SHARD_BYTES_SENT_NAME, shard_index);
+    int32_t publications_counter_id = aeron_counter_sender_shard_allocate(
+        counters_manager, AERON_COUNTER_SENDER_SHARD_PUBLICATIONS_NAME, shard_index);
+
+    if (bytes_sent_counter_id < 0 || publications_counter_id < 0)
+    {
+        return -1;
+    }
+
+    sender->shard.index = shard_index;
+    sender->shard.bytes_sent_counter = aeron_counter_addr(counters_manager, bytes_sent_counter_id);
+    sender->shard.publications_counter = aeron_counter_addr(counters_manager, publications_counter_id);
+
+    if (NULL != sender->impairment)
+    {
+        aeron_udp_channel_impairment_seed(sender->impairment, sender->context->impairment_seed + shard_index);
+    }
+
+    if (shard_index > 0)
+    {
+        if (aeron_spsc_concurrent_array_queue_init(&sender->shard.command_queue, AERON_COMMAND_QUEUE_CAPACITY) < 0)
+        {
+            return -1;
+        }
+
+        sender->sender_proxy.command_queue = &sender->shard.command_queue;
+    }
 
     return 0;
 }
 
+void aeron_driver_sender_shard_close(aeron_driver_sender_t *sender)
+{
+    if (sender->shard.index > 0)
+    {
+        aeron_spsc_concurrent_array_queue_close(&sender->shard.command_queue);
+    }
+}
+
 void aeron_driver_sender_on_command(void *clientd, volatile void *item)
 {
     aeron_driver_sender_t *sender = (aeron_driver_sender_t *)clientd;
@@ -119,6 +203,15 @@ int aeron_driver_sender_do_work(void *clientd)
     int64_t now_ns = sender->context->nano_clock();
     int bytes_sent = aeron_driver_sender_do_send(sender, now_ns);
     int poll_result;
+    aeron_udp_transport_recv_func_t recv_func = aeron_send_channel_endpoint_dispatch;
+    void *recv_clientd = sender;
+
+    if (NULL != sender->impairment)
+    {
+        work_count += aeron_udp_channel_impairment_release(sender->impairment, now_ns);
+        recv_func = aeron_udp_channel_impairment_on_recv;
+        recv_clientd = sender->impairment;
+    }
 
     if (0 == bytes_sent ||
         ++sender->duty_cycle_counter == sender->duty_cycle_ratio ||
@@ -138,12 +231,14 @@ int aeron_driver_sender_do_work(void *clientd)
             mmsghdr[i].msg_len = 0;
         }
 
+        int64_t bytes_received = 0;
         poll_result = aeron_udp_transport_poller_poll(
             &sender->poller,
             mmsghdr,
             AERON_DRIVER_SENDER_NUM_RECV_BUFFERS,
-            aeron_send_channel_endpoint_dispatch,
-            sender);
+            &bytes_received,
+            recv_func,
+            recv_clientd);
 
         if (poll_result < 0)
         {
@@ -156,6 +251,11 @@ int aeron_driver_sender_do_work(void *clientd)
         sender->control_poll_timeout_ns = now_ns + sender->status_message_read_timeout_ns;
     }
 
+    if (NULL != sender->poller.uring && aeron_udp_transport_uring_submit(sender->poller.uring) < 0)
+    {
+        AERON_DRIVER_SENDER_ERROR(sender, "sender io_uring submit: %s", aeron_errmsg());
+    }
+
     return work_count + bytes_sent;
 }
 
@@ -168,8 +268,14 @@ void aeron_driver_sender_on_close(void *clientd)
         aeron_free(sender->recv_buffers.buffers[i]);
     }
 
+    if (NULL != sender->poller.uring)
+    {
+        aeron_udp_transport_uring_close(sender->poller.uring);
+    }
+
     aeron_udp_transport_poller_close(&sender->poller);
     aeron_free(sender->network_publications.array);
+    aeron_udp_channel_impairment_delete(sender->impairment);
 }
 
 void aeron_driver_sender_on_add_endpoint(void *clientd, void *command)
@@ -195,6 +301,11 @@ void aeron_driver_sender_on_remove_endpoint(void *clientd, void *command)
         AERON_DRIVER_SENDER_ERROR(sender, "sender on_remove_endpoint: %s", aeron_errmsg());
     }
 
+    if (NULL != sender->impairment)
+    {
+        aeron_udp_channel_impairment_remove(sender->impairment, endpoint);
+    }
+
     aeron_send_channel_endpoint_sender_release(endpoint);
 }
 
@@ -215,6 +326,11 @@ void aeron_driver_sender_on_add_publication(void *clientd, void *command)
     }
 
     sender->network_publications.array[sender->network_publications.length++].publication = publication;
+    if (NULL != sender->shard.publications_counter)
+    {
+        aeron_counter_set_ordered(sender->shard.publications_counter, (int64_t)sender->network_publications.length);
+    }
+
     if (aeron_send_channel_endpoint_add_publication(publication->endpoint, publication) < 0)
     {
         AERON_DRIVER_SENDER_ERROR(sender, "sender on_add_publication add_publication: %s", aeron_errmsg());
@@ -237,6 +353,11 @@ void aeron_driver_sender_on_remove_publication(void *clientd, void *command)
                 i,
                 last_index);
             sender->network_publications.length--;
+            if (NULL != sender->shard.publications_counter)
+            {
+                aeron_counter_set_ordered(
+                    sender->shard.publications_counter, (int64_t)sender->network_publications.length);
+            }
             break;
         }
     }
@@ -283,9 +404,19 @@ int aeron_driver_sender_do_send(aeron_driver_sender_t *sender, int64_t now_ns)
         sender->round_robin_index = starting_index = 0;
     }
 
+    /*
+     * The budget is shared between the publications that had something to send last duty cycle, so a lone hot stream
+     * can send a deep batch while with many active streams none can starve the others. Each always sends at least one.
+     */
+    const size_t active_last_cycle = 0 == sender->active_publications ? 1 : sender->active_publications;
+    size_t max_messages = sender->send_batch_budget / active_last_cycle;
+    max_messages = max_messages > sender->max_messages_per_send ? sender->max_messages_per_send : max_messages;
+    max_messages = 0 == max_messages ? 1 : max_messages;
+    size_t active_publications = 0;
+
     for (size_t i = starting_index; i < length; i++)
     {
-        int result = aeron_network_publication_send(publications[i].publication, now_ns);
+        int result = aeron_network_publication_send(publications[i].publication, now_ns, max_messages);
         if (result < 0)
         {
             AERON_DRIVER_SENDER_ERROR(sender, "sender do_send: %s", aeron_errmsg());
@@ -293,12 +424,13 @@ int aeron_driver_sender_do_send(aeron_driver_sender_t *sender, int64_t now_ns)
         else
         {
             bytes_sent += result;
+            active_publications += result > 0 ? 1 : 0;
         }
     }
 
     for (size_t i = 0; i < starting_index; i++)
     {
-        int result = aeron_network_publication_send(publications[i].publication, now_ns);
+        int result = aeron_network_publication_send(publications[i].publication, now_ns, max_messages);
         if (result < 0)
         {
             AERON_DRIVER_SENDER_ERROR(sender, "sender do_send: %s", aeron_errmsg());
@@ -306,10 +438,26 @@ int aeron_driver_sender_do_send(aeron_driver_sender_t *sender, int64_t now_ns)
         else
         {
             bytes_sent += result;
+            active_publications += result > 0 ? 1 : 0;
         }
     }
 
-    aeron_counter_add_ordered(sender->total_bytes_sent_counter, bytes_sent);
+    for (size_t i = 0; i < length; i++)
+    {
+        if (aeron_send_channel_endpoint_send_batch_flush(
+            publications[i].publication->endpoint, sender->short_sends_counter) < 0)
+        {
+            AERON_DRIVER_SENDER_ERROR(sender, "sender do_send flush: %s", aeron_errmsg());
+        }
+    }
+
+    sender->active_publications = active_publications;
+
+    aeron_counter_shared_increment(sender->total_bytes_sent_counter, bytes_sent, sender->context->sender_count > 1);
+    if (NULL != sender->shard.bytes_sent_counter)
+    {
+        aeron_counter_add_ordered(sender->shard.bytes_sent_counter, bytes_sent);
+    }
 
     return bytes_sent;
 }
@@ -22,6 +22,7 @@
 #include "aeron_driver_sender_proxy.h"
 #include "aeron_system_counters.h"
 #include "media/aeron_udp_transport_poller.h"
+#include "media/aeron_udp_channel_impairment.h"
 #include "aeron_network_publication.h"
 #include "concurrent/aeron_distinct_error_log.h"
 
@@ -37,6 +38,7 @@ typedef struct aeron_driver_sender_stct
 {
     aeron_driver_sender_proxy_t sender_proxy;
     aeron_udp_transport_poller_t poller;
+    aeron_udp_transport_uring_t uring;
 
     struct aeron_driver_sender_network_publications_stct
     {
@@ -61,12 +63,28 @@ typedef struct aeron_driver_sender_stct
     size_t round_robin_index;
     size_t duty_cycle_counter;
     size_t duty_cycle_ratio;
+    size_t send_batch_budget;
+    size_t max_messages_per_send;
+    size_t active_publications;
+
+    /* control frames polled go through this on their way to the endpoints when aeron.debug.control.* is set */
+    aeron_udp_channel_impairment_t *impairment;
 
     int64_t *total_bytes_sent_counter;
     int64_t *errors_counter;
     int64_t *invalid_frames_counter;
     int64_t *status_messages_received_counter;
     int64_t *nak_messages_received_counter;
+    int64_t *short_sends_counter;
+
+    struct aeron_driver_sender_shard_stct
+    {
+        aeron_spsc_concurrent_array_queue_t command_queue;
+        int32_t index;
+        int64_t *bytes_sent_counter;
+        int64_t *publications_counter;
+    }
+    shard;
 }
 aeron_driver_sender_t;
 
@@ -88,6 +106,16 @@ int aeron_driver_sender_init(
     aeron_system_counters_t *system_counters,
     aeron_distinct_error_log_t *error_log);
 
+/*
+ * Make an initialised sender one of several, each sending its own shard of the network publications and polling the
+ * control frames of their endpoints. Shards other than 0 take commands on a queue of their own rather than the
+ * context's. Each shard reports its own counters.
+ */
+int aeron_driver_sender_shard_init(
+    aeron_driver_sender_t *sender, aeron_counters_manager_t *counters_manager, int32_t shard_index);
+
+void aeron_driver_sender_shard_close(aeron_driver_sender_t *sender);
+
 int aeron_driver_sender_do_work(void *clientd);
 void aeron_driver_sender_on_close(void *clientd);
 
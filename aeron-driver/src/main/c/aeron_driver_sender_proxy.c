@@ -27,9 +27,30 @@ void aeron_driver_sender_proxy_offer(aeron_driver_sender_proxy_t *sender_proxy,
     }
 }
 
+aeron_driver_sender_proxy_t *aeron_driver_sender_proxy_for_new_endpoint(aeron_driver_context_t *context)
+{
+    aeron_driver_sender_proxy_t *sender_proxy = context->sender_proxy;
+
+    for (size_t i = 1; i < context->sender_count && NULL != context->sender_proxies[i]; i++)
+    {
+        aeron_driver_sender_proxy_t *candidate = context->sender_proxies[i];
+
+        if (candidate->publication_count < sender_proxy->publication_count ||
+            (candidate->publication_count == sender_proxy->publication_count &&
+             candidate->endpoint_count < sender_proxy->endpoint_count))
+        {
+            sender_proxy = candidate;
+        }
+    }
+
+    return sender_proxy;
+}
+
 void aeron_driver_sender_proxy_on_add_endpoint(
     aeron_driver_sender_proxy_t *sender_proxy, aeron_send_channel_endpoint_t *endpoint)
 {
+    sender_proxy->endpoint_count++;
+
     if (AERON_THREADING_MODE_SHARED == sender_proxy->threading_mode)
     {
         aeron_command_base_t cmd =
@@ -60,6 +81,8 @@ void aeron_driver_sender_proxy_on_add_endpoint(
 void aeron_driver_sender_proxy_on_remove_endpoint(
     aeron_driver_sender_proxy_t *sender_proxy, aeron_send_channel_endpoint_t *endpoint)
 {
+    sender_proxy->endpoint_count--;
+
     if (AERON_THREADING_MODE_SHARED == sender_proxy->threading_mode)
     {
         aeron_command_base_t cmd =
@@ -90,6 +113,8 @@ void aeron_driver_sender_proxy_on_remove_endpoint(
 void aeron_driver_sender_proxy_on_add_publication(
     aeron_driver_sender_proxy_t *sender_proxy, aeron_network_publication_t *publication)
 {
+    sender_proxy->publication_count++;
+
     if (AERON_THREADING_MODE_SHARED == sender_proxy->threading_mode)
     {
         aeron_command_base_t cmd =
@@ -120,6 +145,8 @@ void aeron_driver_sender_proxy_on_add_publication(
 void aeron_driver_sender_proxy_on_remove_publication(
     aeron_driver_sender_proxy_t *sender_proxy, aeron_network_publication_t *publication)
 {
+    sender_proxy->publication_count--;
+
     if (AERON_THREADING_MODE_SHARED == sender_proxy->threading_mode)
     {
         aeron_command_base_t cmd =
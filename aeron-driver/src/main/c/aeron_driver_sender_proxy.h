@@ -29,9 +29,17 @@ typedef struct aeron_driver_sender_proxy_stct
     aeron_threading_mode_t threading_mode;
     aeron_spsc_concurrent_array_queue_t *command_queue;
     int64_t *fail_counter;
+    size_t endpoint_count;
+    size_t publication_count;
 }
 aeron_driver_sender_proxy_t;
 
+/*
+ * Sender a new send channel endpoint, and so every network publication on it, should be pinned to. The one with the
+ * fewest publications, then the fewest endpoints. Conductor only.
+ */
+aeron_driver_sender_proxy_t *aeron_driver_sender_proxy_for_new_endpoint(aeron_driver_context_t *context);
+
 void aeron_driver_sender_proxy_on_add_endpoint(
     aeron_driver_sender_proxy_t *sender_proxy, aeron_send_channel_endpoint_t *endpoint);
 
@@ -20,12 +20,19 @@
 #endif
 
 #include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
 #include "protocol/aeron_udp_protocol.h"
 #include "concurrent/aeron_logbuffer_descriptor.h"
 #include "util/aeron_error.h"
 #include "util/aeron_dlopen.h"
+#include "util/aeron_arrayutil.h"
+#include "util/aeron_parse_util.h"
+#include "uri/aeron_uri.h"
 #include "aeron_flow_control.h"
 #include "aeron_alloc.h"
+#include "aeron_driver_context.h"
 
 aeron_flow_control_strategy_supplier_func_t aeron_flow_control_strategy_supplier_load(const char *strategy_name)
 {
@@ -121,7 +128,8 @@ int aeron_max_multicast_flow_control_strategy_supplier(
     int32_t stream_id,
     int64_t registration_id,
     int32_t initial_term_id,
-    size_t term_buffer_capacity)
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context)
 {
     aeron_flow_control_strategy_t *_strategy;
 
@@ -153,8 +161,428 @@ int aeron_unicast_flow_control_strategy_supplier(
     int32_t stream_id,
     int64_t registration_id,
     int32_t initial_term_id,
-    size_t term_buffer_capacity)
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context)
 {
     return aeron_max_multicast_flow_control_strategy_supplier(
-        strategy, channel_length, channel, stream_id, registration_id, initial_term_id, term_buffer_capacity);
+        strategy, channel_length, channel, stream_id, registration_id, initial_term_id, term_buffer_capacity, context);
+}
+
+typedef struct aeron_min_flow_control_strategy_receiver_stct
+{
+    int64_t last_position;
+    int64_t last_position_plus_window;
+    int64_t time_of_last_status_message;
+    int64_t receiver_id;
+}
+aeron_min_flow_control_strategy_receiver_t;
+
+typedef struct aeron_min_flow_control_strategy_state_stct
+{
+    struct aeron_min_flow_control_strategy_receivers_stct
+    {
+        aeron_min_flow_control_strategy_receiver_t *array;
+        size_t length;
+        size_t capacity;
+    }
+    receivers;
+
+    int64_t receiver_timeout_ns;
+    int64_t group_tag;
+    bool is_tagged;
+    bool should_linger;
+}
+aeron_min_flow_control_strategy_state_t;
+
+int64_t aeron_min_flow_control_strategy_on_idle(
+    void *state,
+    int64_t now_ns,
+    int64_t snd_lmt,
+    int64_t snd_pos,
+    bool is_end_of_stream)
+{
+    aeron_min_flow_control_strategy_state_t *strategy_state = (aeron_min_flow_control_strategy_state_t *)state;
+    int64_t min_limit_position = INT64_MAX;
+    int64_t min_last_position = INT64_MAX;
+
+    for (int last_index = (int)strategy_state->receivers.length - 1, i = last_index; i >= 0; i--)
+    {
+        aeron_min_flow_control_strategy_receiver_t *receiver = &strategy_state->receivers.array[i];
+
+        if (now_ns > (receiver->time_of_last_status_message + strategy_state->receiver_timeout_ns))
+        {
+            aeron_array_fast_unordered_remove(
+                (uint8_t *)strategy_state->receivers.array,
+                sizeof(aeron_min_flow_control_strategy_receiver_t),
+                (size_t)i,
+                (size_t)last_index);
+            last_index--;
+            strategy_state->receivers.length--;
+        }
+        else
+        {
+            min_limit_position = receiver->last_position_plus_window < min_limit_position ?
+                receiver->last_position_plus_window : min_limit_position;
+            min_last_position = receiver->last_position < min_last_position ?
+                receiver->last_position : min_last_position;
+        }
+    }
+
+    if (is_end_of_stream && strategy_state->should_linger)
+    {
+        if (0 == strategy_state->receivers.length || min_last_position >= snd_pos)
+        {
+            AERON_PUT_ORDERED(strategy_state->should_linger, false);
+        }
+    }
+
+    return strategy_state->receivers.length > 0 ? min_limit_position : snd_lmt;
+}
+
+inline static bool aeron_min_flow_control_strategy_has_group_tag(
+    aeron_min_flow_control_strategy_state_t *strategy_state, const uint8_t *sm, size_t length)
+{
+    int64_t group_tag;
+
+    if (length < sizeof(aeron_status_message_header_t) + sizeof(aeron_status_message_optional_header_t))
+    {
+        return false;
+    }
+
+    memcpy(
+        &group_tag,
+        sm + sizeof(aeron_status_message_header_t) + offsetof(aeron_status_message_optional_header_t, group_tag),
+        sizeof(group_tag));
+
+    return group_tag == strategy_state->group_tag;
+}
+
+int64_t aeron_min_flow_control_strategy_on_sm(
+    void *state,
+    const uint8_t *sm,
+    size_t length,
+    struct sockaddr_storage *recv_addr,
+    int64_t snd_lmt,
+    int32_t initial_term_id,
+    size_t position_bits_to_shift,
+    int64_t now_ns)
+{
+    aeron_status_message_header_t *status_message_header = (aeron_status_message_header_t *)sm;
+    aeron_min_flow_control_strategy_state_t *strategy_state = (aeron_min_flow_control_strategy_state_t *)state;
+
+    int64_t position = aeron_logbuffer_compute_position(
+        status_message_header->consumption_term_id,
+        status_message_header->consumption_term_offset,
+        position_bits_to_shift,
+        initial_term_id);
+    int64_t window_edge = position + status_message_header->receiver_window;
+    int64_t min_position = INT64_MAX;
+    bool is_tracked = !strategy_state->is_tagged ||
+        aeron_min_flow_control_strategy_has_group_tag(strategy_state, sm, length);
+    bool is_existing = false;
+
+    for (size_t i = 0, size = strategy_state->receivers.length; i < size; i++)
+    {
+        aeron_min_flow_control_strategy_receiver_t *receiver = &strategy_state->receivers.array[i];
+
+        if (is_tracked && status_message_header->receiver_id == receiver->receiver_id)
+        {
+            receiver->last_position = position > receiver->last_position ? position : receiver->last_position;
+            receiver->last_position_plus_window = window_edge;
+            receiver->time_of_last_status_message = now_ns;
+            is_existing = true;
+        }
+
+        min_position = receiver->last_position_plus_window < min_position ?
+            receiver->last_position_plus_window : min_position;
+    }
+
+    if (is_tracked && !is_existing)
+    {
+        int ensure_capacity_result = 0;
+
+        AERON_ARRAY_ENSURE_CAPACITY(
+            ensure_capacity_result, strategy_state->receivers, aeron_min_flow_control_strategy_receiver_t);
+
+        if (ensure_capacity_result >= 0)
+        {
+            aeron_min_flow_control_strategy_receiver_t *receiver =
+                &strategy_state->receivers.array[strategy_state->receivers.length++];
+
+            receiver->last_position = position;
+            receiver->last_position_plus_window = window_edge;
+            receiver->time_of_last_status_message = now_ns;
+            receiver->receiver_id = status_message_header->receiver_id;
+
+            min_position = window_edge < min_position ? window_edge : min_position;
+        }
+    }
+
+    if (0 == strategy_state->receivers.length)
+    {
+        return snd_lmt > window_edge ? snd_lmt : window_edge;
+    }
+
+    return min_position;
+}
+
+bool aeron_min_flow_control_strategy_should_linger(
+    void *state,
+    int64_t now_ns)
+{
+    aeron_min_flow_control_strategy_state_t *strategy_state = (aeron_min_flow_control_strategy_state_t *)state;
+
+    bool should_linger;
+    AERON_GET_VOLATILE(should_linger, strategy_state->should_linger);
+
+    return should_linger;
+}
+
+int aeron_min_flow_control_strategy_fini(aeron_flow_control_strategy_t *strategy)
+{
+    aeron_min_flow_control_strategy_state_t *strategy_state = (aeron_min_flow_control_strategy_state_t *)strategy->state;
+
+    aeron_free(strategy_state->receivers.array);
+    aeron_free(strategy->state);
+    aeron_free(strategy);
+    return 0;
+}
+
+static int aeron_flow_control_strategy_channel_options(
+    int32_t channel_length, const char *channel, aeron_flow_control_options_t *options, char *buffer, size_t buffer_length)
+{
+    aeron_uri_t uri;
+    const char *value;
+    int result = 0;
+
+    memset(options, 0, sizeof(aeron_flow_control_options_t));
+
+    if (aeron_uri_parse((size_t)channel_length, channel, &uri) < 0)
+    {
+        return -1;
+    }
+
+    if (AERON_URI_UDP == uri.type &&
+        NULL != (value = aeron_uri_find_param_value(&uri.params.udp.additional_params, AERON_URI_FC_KEY)))
+    {
+        size_t value_length = strlen(value);
+
+        if (value_length >= buffer_length)
+        {
+            aeron_set_err(EINVAL, "flow control options too long: %s", value);
+            result = -1;
+        }
+        else
+        {
+            memcpy(buffer, value, value_length + 1);
+            result = aeron_flow_control_parse_options(value_length, buffer, options);
+        }
+    }
+
+    aeron_uri_close(&uri);
+
+    return result;
+}
+
+inline static bool aeron_flow_control_strategy_name_equals(aeron_flow_control_options_t *options, const char *name)
+{
+    return strlen(name) == options->strategy_name_length &&
+        0 == strncmp(options->strategy_name, name, options->strategy_name_length);
+}
+
+static int aeron_min_flow_control_strategy_create(
+    aeron_flow_control_strategy_t **strategy,
+    aeron_flow_control_options_t *options,
+    aeron_driver_context_t *context,
+    bool is_tagged)
+{
+    aeron_flow_control_strategy_t *_strategy;
+
+    if (aeron_alloc((void **)&_strategy, sizeof(aeron_flow_control_strategy_t)) < 0)
+    {
+        return -1;
+    }
+
+    if (aeron_alloc((void **)&_strategy->state, sizeof(aeron_min_flow_control_strategy_state_t)) < 0)
+    {
+        aeron_free(_strategy);
+        return -1;
+    }
+
+    _strategy->on_idle = aeron_min_flow_control_strategy_on_idle;
+    _strategy->on_status_message = aeron_min_flow_control_strategy_on_sm;
+    _strategy->should_linger = aeron_min_flow_control_strategy_should_linger;
+    _strategy->fini = aeron_min_flow_control_strategy_fini;
+
+    aeron_min_flow_control_strategy_state_t *state = (aeron_min_flow_control_strategy_state_t *)_strategy->state;
+    state->receivers.array = NULL;
+    state->receivers.length = 0;
+    state->receivers.capacity = 0;
+    state->receiver_timeout_ns = options->has_receiver_timeout ?
+        options->receiver_timeout_ns : (int64_t)context->flow_control_receiver_timeout_ns;
+    state->group_tag = options->has_group_tag ? options->group_tag : context->flow_control_group_tag;
+    state->is_tagged = is_tagged;
+    state->should_linger = true;
+
+    *strategy = _strategy;
+
+    return 0;
+}
+
+int aeron_min_multicast_flow_control_strategy_supplier(
+    aeron_flow_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int64_t registration_id,
+    int32_t initial_term_id,
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context)
+{
+    aeron_flow_control_options_t options;
+    char buffer[AERON_MAX_PATH];
+
+    if (aeron_flow_control_strategy_channel_options(channel_length, channel, &options, buffer, sizeof(buffer)) < 0)
+    {
+        return -1;
+    }
+
+    return aeron_min_flow_control_strategy_create(strategy, &options, context, false);
+}
+
+int aeron_tagged_multicast_flow_control_strategy_supplier(
+    aeron_flow_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int64_t registration_id,
+    int32_t initial_term_id,
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context)
+{
+    aeron_flow_control_options_t options;
+    char buffer[AERON_MAX_PATH];
+
+    if (aeron_flow_control_strategy_channel_options(channel_length, channel, &options, buffer, sizeof(buffer)) < 0)
+    {
+        return -1;
+    }
+
+    return aeron_min_flow_control_strategy_create(strategy, &options, context, true);
+}
+
+int aeron_default_multicast_flow_control_strategy_supplier(
+    aeron_flow_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int64_t registration_id,
+    int32_t initial_term_id,
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context)
+{
+    aeron_flow_control_options_t options;
+    char buffer[AERON_MAX_PATH];
+
+    if (aeron_flow_control_strategy_channel_options(channel_length, channel, &options, buffer, sizeof(buffer)) < 0)
+    {
+        return -1;
+    }
+
+    if (NULL == options.strategy_name ||
+        aeron_flow_control_strategy_name_equals(&options, AERON_FLOW_CONTROL_STRATEGY_NAME_MAX))
+    {
+        return aeron_max_multicast_flow_control_strategy_supplier(
+            strategy,
+            channel_length,
+            channel,
+            stream_id,
+            registration_id,
+            initial_term_id,
+            term_buffer_capacity,
+            context);
+    }
+
+    if (aeron_flow_control_strategy_name_equals(&options, AERON_FLOW_CONTROL_STRATEGY_NAME_MIN))
+    {
+        return aeron_min_flow_control_strategy_create(strategy, &options, context, false);
+    }
+
+    if (aeron_flow_control_strategy_name_equals(&options, AERON_FLOW_CONTROL_STRATEGY_NAME_TAGGED))
+    {
+        return aeron_min_flow_control_strategy_create(strategy, &options, context, true);
+    }
+
+    aeron_set_err(
+        EINVAL, "unsupported flow control strategy: %.*s", (int)options.strategy_name_length, options.strategy_name);
+    return -1;
+}
+
+int aeron_flow_control_parse_options(
+    size_t options_length, const char *options, aeron_flow_control_options_t *flow_control_options)
+{
+    char value[AERON_MAX_PATH];
+    const char *ptr = options;
+    const char *end = options + options_length;
+
+    memset(flow_control_options, 0, sizeof(aeron_flow_control_options_t));
+
+    while (ptr < end)
+    {
+        const char *next = memchr(ptr, ',', (size_t)(end - ptr));
+        size_t length = (size_t)((NULL == next ? end : next) - ptr);
+
+        if (ptr == options)
+        {
+            flow_control_options->strategy_name = ptr;
+            flow_control_options->strategy_name_length = length;
+        }
+        else if (length > 2 && ':' == ptr[1] && length < sizeof(value))
+        {
+            memcpy(value, ptr + 2, length - 2);
+            value[length - 2] = '\0';
+
+            if ('t' == ptr[0])
+            {
+                uint64_t timeout_ns;
+
+                if (aeron_parse_duration_ns(value, &timeout_ns) < 0)
+                {
+                    aeron_set_err(EINVAL, "invalid flow control receiver timeout: %s", value);
+                    return -1;
+                }
+
+                flow_control_options->receiver_timeout_ns = (int64_t)timeout_ns;
+                flow_control_options->has_receiver_timeout = true;
+            }
+            else if ('g' == ptr[0])
+            {
+                char *tag_end = NULL;
+
+                errno = 0;
+                flow_control_options->group_tag = strtoll(value, &tag_end, 10);
+                if (0 != errno || '\0' != *tag_end)
+                {
+                    aeron_set_err(EINVAL, "invalid flow control group tag: %s", value);
+                    return -1;
+                }
+
+                flow_control_options->has_group_tag = true;
+            }
+            else
+            {
+                aeron_set_err(EINVAL, "unknown flow control option: %.*s", (int)length, ptr);
+                return -1;
+            }
+        }
+        else
+        {
+            aeron_set_err(EINVAL, "invalid flow control option: %.*s", (int)length, ptr);
+            return -1;
+        }
+
+        ptr += length + 1;
+    }
+
+    return 0;
 }
@@ -21,9 +21,14 @@
 #include "aeron_driver_common.h"
 
 typedef struct aeron_flow_control_strategy_stct aeron_flow_control_strategy_t;
+typedef struct aeron_driver_context_stct aeron_driver_context_t;
 
 #define AERON_MAX_FLOW_CONTROL_STRATEGY_RECEIVER_TIMEOUT_NS (2 * 1000 * 1000 * 1000L)
 
+#define AERON_FLOW_CONTROL_STRATEGY_NAME_MAX "max"
+#define AERON_FLOW_CONTROL_STRATEGY_NAME_MIN "min"
+#define AERON_FLOW_CONTROL_STRATEGY_NAME_TAGGED "tagged"
+
 typedef int64_t (*aeron_flow_control_strategy_on_idle_func_t)(
     void *state,
     int64_t now_ns,
@@ -65,8 +70,34 @@ typedef int (*aeron_flow_control_strategy_supplier_func_t)(
     int32_t stream_id,
     int64_t registration_id,
     int32_t initial_term_id,
-    size_t term_buffer_capacity);
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context);
 
 aeron_flow_control_strategy_supplier_func_t aeron_flow_control_strategy_supplier_load(const char *strategy_name);
 
+/**
+ * Options given in the fc parameter of a channel, e.g. fc=min,t:5s or fc=tagged,g:100,t:5s
+ */
+typedef struct aeron_flow_control_options_stct
+{
+    const char *strategy_name;
+    size_t strategy_name_length;
+    int64_t receiver_timeout_ns;
+    int64_t group_tag;
+    bool has_receiver_timeout;
+    bool has_group_tag;
+}
+aeron_flow_control_options_t;
+
+/**
+ * Parse the value of the fc channel parameter. strategy_name points into options so must not outlive it.
+ *
+ * @param options_length of the fc parameter value.
+ * @param options value of the fc parameter.
+ * @param flow_control_options to fill in.
+ * @return 0 for success and -1 for error.
+ */
+int aeron_flow_control_parse_options(
+    size_t options_length, const char *options, aeron_flow_control_options_t *flow_control_options);
+
 #endif //AERON_FLOW_CONTROL_H
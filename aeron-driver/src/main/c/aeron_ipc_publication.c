@@ -71,8 +71,16 @@ int aeron_ipc_publication_create(
         return -1;
     }
 
-    if (context->map_raw_log_func(
-        &_pub->mapped_raw_log, path, params->is_sparse, params->term_length, context->file_page_size) < 0)
+    if (!aeron_raw_log_pool_take(
+        context->raw_log_pool, &_pub->mapped_raw_log, path, params->is_sparse, params->term_length, -1) &&
+        context->map_raw_log_func(
+            &_pub->mapped_raw_log,
+            path,
+            params->is_sparse,
+            context->term_buffer_huge_pages,
+            params->term_length,
+            context->file_page_size,
+            -1) < 0)
     {
         aeron_free(_pub->log_file_name);
         aeron_free(_pub);
@@ -86,12 +94,19 @@ int aeron_ipc_publication_create(
     _pub->log_file_name_length = (size_t)path_length;
     _pub->log_meta_data = (aeron_logbuffer_metadata_t *)(_pub->mapped_raw_log.log_meta_data.addr);
 
+    int64_t initial_position = 0;
     if (params->is_replay)
     {
         int64_t term_id = params->term_id;
         int32_t term_count = (int32_t)term_id - initial_term_id;
         size_t active_index = aeron_logbuffer_index_by_term_count(term_count);
 
+        initial_position = aeron_logbuffer_compute_position(
+            (int32_t)term_id,
+            (int32_t)params->term_offset,
+            (size_t)aeron_number_of_trailing_zeroes((int32_t)params->term_length),
+            initial_term_id);
+
         _pub->log_meta_data->term_tail_counters[active_index] =
             (term_id * ((int64_t)1 << 32)) | params->term_offset;
 
@@ -116,7 +131,6 @@ int aeron_ipc_publication_create(
         _pub->log_meta_data->active_term_count = 0;
     }
 
-    _pub->log_meta_data->active_term_count = 0;
     _pub->log_meta_data->initial_term_id = initial_term_id;
     _pub->log_meta_data->mtu_length = (int32_t)params->mtu_length;
     _pub->log_meta_data->term_length = (int32_t)params->term_length;
@@ -139,10 +153,12 @@ int aeron_ipc_publication_create(
     _pub->conductor_fields.managed_resource.incref = aeron_ipc_publication_incref;
     _pub->conductor_fields.managed_resource.decref = aeron_ipc_publication_decref;
     _pub->conductor_fields.has_reached_end_of_life = false;
-    _pub->conductor_fields.cleaning_position = 0;
+    _pub->conductor_fields.cleaning_position = initial_position;
+    _pub->term_cleaner = context->term_cleaner;
+    _pub->cleaned_position = initial_position;
     _pub->conductor_fields.trip_limit = 0;
-    _pub->conductor_fields.consumer_position = 0;
-    _pub->conductor_fields.last_consumer_position = 0;
+    _pub->conductor_fields.consumer_position = initial_position;
+    _pub->conductor_fields.last_consumer_position = initial_position;
     _pub->conductor_fields.time_of_last_consumer_position_change = now_ns;
     _pub->conductor_fields.status = AERON_IPC_PUBLICATION_STATUS_ACTIVE;
     _pub->conductor_fields.refcnt = 1;
@@ -214,15 +230,27 @@ int aeron_ipc_publication_update_pub_lmt(aeron_ipc_publication_t *publication)
     }
     else
     {
-        int64_t proposed_limit = min_sub_pos + publication->term_window_length;
+        const int64_t uncleaned_limit = min_sub_pos + publication->term_window_length;
+        const int64_t proposed_limit = aeron_term_cleaner_limit(
+            publication->term_cleaner,
+            uncleaned_limit,
+            &publication->cleaned_position,
+            2 * (int64_t)publication->mapped_raw_log.term_length);
+        const bool is_cleaner_limited = proposed_limit < uncleaned_limit;
+
         if (proposed_limit > publication->conductor_fields.trip_limit)
         {
             aeron_counter_set_ordered(publication->pub_lmt_position.value_addr, proposed_limit);
-            publication->conductor_fields.trip_limit = proposed_limit + publication->trip_gain;
+            publication->conductor_fields.trip_limit =
+                is_cleaner_limited ? proposed_limit : proposed_limit + publication->trip_gain;
 
             aeron_ipc_publication_clean_buffer(publication, min_sub_pos);
             work_count = 1;
         }
+        else if (is_cleaner_limited)
+        {
+            aeron_ipc_publication_clean_buffer(publication, min_sub_pos);
+        }
 
         publication->conductor_fields.consumer_position = max_sub_pos;
     }
@@ -240,9 +268,13 @@ void aeron_ipc_publication_clean_buffer(aeron_ipc_publication_t *publication, in
     int32_t bytes_left_in_term = term_length - term_offset;
     int32_t length = bytes_to_clean < bytes_left_in_term ? bytes_to_clean : bytes_left_in_term;
 
-    if (length > 0)
+    if (length > 0 && aeron_term_cleaner_clean(
+        publication->term_cleaner,
+        publication->mapped_raw_log.term_buffers[dirty_index].addr + term_offset,
+        (size_t)length,
+        cleaning_position + length,
+        &publication->cleaned_position))
     {
-        memset(publication->mapped_raw_log.term_buffers[dirty_index].addr + term_offset, 0, (size_t)length);
         publication->conductor_fields.cleaning_position = cleaning_position + length;
     }
 }
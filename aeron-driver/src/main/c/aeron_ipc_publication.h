@@ -53,6 +53,8 @@ typedef struct aeron_ipc_publication_stct
     /* uint8_t conductor_fields_pad[(2 * AERON_CACHE_LINE_LENGTH) - sizeof(struct conductor_fields_stct)]; */
 
     aeron_mapped_raw_log_t mapped_raw_log;
+    aeron_term_cleaner_t *term_cleaner;
+    volatile int64_t cleaned_position;
     aeron_position_t pub_lmt_position;
     aeron_position_t pub_pos_position;
     aeron_logbuffer_metadata_t *log_meta_data;
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "aeron_latency_histogram.h"
+#include "aeron_position.h"
+
+static const char *aeron_latency_histogram_bucket_labels[AERON_LATENCY_HISTOGRAM_BUCKET_COUNT] =
+    {
+        "<1us",
+        "<4us",
+        "<16us",
+        "<64us",
+        "<256us",
+        "<1ms",
+        "<4ms",
+        ">=4ms"
+    };
+
+int aeron_latency_histogram_init(
+    aeron_latency_histogram_t *histogram,
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int64_t registration_id,
+    int32_t session_id,
+    int32_t stream_id,
+    int32_t channel_length,
+    const char *channel)
+{
+    for (size_t i = 0; i < AERON_LATENCY_HISTOGRAM_BUCKET_COUNT; i++)
+    {
+        int32_t counter_id = aeron_counter_receiver_histogram_allocate(
+            counters_manager,
+            name,
+            registration_id,
+            session_id,
+            stream_id,
+            channel_length,
+            channel,
+            aeron_latency_histogram_bucket_labels[i]);
+
+        if (counter_id < 0)
+        {
+            for (size_t j = 0; j < i; j++)
+            {
+                aeron_counters_manager_free(counters_manager, histogram->counter_ids[j]);
+            }
+
+            return -1;
+        }
+
+        histogram->counter_ids[i] = counter_id;
+        histogram->buckets[i] = aeron_counter_addr(counters_manager, counter_id);
+    }
+
+    return 0;
+}
+
+void aeron_latency_histogram_close(aeron_latency_histogram_t *histogram, aeron_counters_manager_t *counters_manager)
+{
+    for (size_t i = 0; i < AERON_LATENCY_HISTOGRAM_BUCKET_COUNT; i++)
+    {
+        aeron_counters_manager_free(counters_manager, histogram->counter_ids[i]);
+    }
+}
+
+extern size_t aeron_latency_histogram_bucket_index(int64_t duration_ns);
+
+extern void aeron_latency_histogram_record(aeron_latency_histogram_t *histogram, int64_t duration_ns);
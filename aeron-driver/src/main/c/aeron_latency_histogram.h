@@ -0,0 +1,73 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AERON_LATENCY_HISTOGRAM_H
+#define AERON_LATENCY_HISTOGRAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "concurrent/aeron_counters_manager.h"
+
+#define AERON_LATENCY_HISTOGRAM_BUCKET_COUNT (8)
+
+/*
+ * Counts of durations falling into buckets with bounds growing by powers of 4 from 1us, so from under 1us up to 4ms
+ * and over, each bucket a counter so the distribution shows up in the counters file. Recorded by a single thread.
+ */
+typedef struct aeron_latency_histogram_stct
+{
+    int32_t counter_ids[AERON_LATENCY_HISTOGRAM_BUCKET_COUNT];
+    int64_t *buckets[AERON_LATENCY_HISTOGRAM_BUCKET_COUNT];
+}
+aeron_latency_histogram_t;
+
+/**
+ * Allocate a counter for each bucket, labelled like the other counters of a stream with the bucket bound appended.
+ *
+ * @return 0 for success and -1 for error.
+ */
+int aeron_latency_histogram_init(
+    aeron_latency_histogram_t *histogram,
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int64_t registration_id,
+    int32_t session_id,
+    int32_t stream_id,
+    int32_t channel_length,
+    const char *channel);
+
+void aeron_latency_histogram_close(aeron_latency_histogram_t *histogram, aeron_counters_manager_t *counters_manager);
+
+inline size_t aeron_latency_histogram_bucket_index(int64_t duration_ns)
+{
+    size_t index = 0;
+
+    for (int64_t bound_ns = 1000; index < AERON_LATENCY_HISTOGRAM_BUCKET_COUNT - 1 && duration_ns >= bound_ns;)
+    {
+        bound_ns <<= 2;
+        index++;
+    }
+
+    return index;
+}
+
+inline void aeron_latency_histogram_record(aeron_latency_histogram_t *histogram, int64_t duration_ns)
+{
+    aeron_counter_ordered_increment(histogram->buckets[aeron_latency_histogram_bucket_index(duration_ns)], 1);
+}
+
+#endif //AERON_LATENCY_HISTOGRAM_H
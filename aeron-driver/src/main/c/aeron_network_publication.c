@@ -100,7 +100,13 @@ int aeron_network_publication_create(
     if (aeron_retransmit_handler_init(
         &_pub->retransmit_handler,
         aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_INVALID_PACKETS),
-        AERON_RETRANSMIT_HANDLER_DEFAULT_LINGER_TIMEOUT_NS) < 0)
+        aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_RETRANSMITTED_BYTES),
+        aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_RETRANSMIT_OVERFLOW),
+        context->sender_count > 1,
+        AERON_RETRANSMIT_HANDLER_DEFAULT_LINGER_TIMEOUT_NS,
+        context->max_resend,
+        (int64_t)context->retransmit_rate_limit,
+        (int64_t)context->retransmit_rate_interval_ns) < 0)
     {
         aeron_free(_pub->log_file_name);
         aeron_free(_pub);
@@ -108,8 +114,21 @@ int aeron_network_publication_create(
         return -1;
     }
 
-    if (context->map_raw_log_func(
-        &_pub->mapped_raw_log, path, params->is_sparse, params->term_length, context->file_page_size) < 0)
+    if (!aeron_raw_log_pool_take(
+        context->raw_log_pool,
+        &_pub->mapped_raw_log,
+        path,
+        params->is_sparse,
+        params->term_length,
+        context->sender_numa_node) &&
+        context->map_raw_log_func(
+            &_pub->mapped_raw_log,
+            path,
+            params->is_sparse,
+            context->term_buffer_huge_pages,
+            params->term_length,
+            context->file_page_size,
+            context->sender_numa_node) < 0)
     {
         aeron_free(_pub->log_file_name);
         aeron_free(_pub);
@@ -118,17 +137,25 @@ int aeron_network_publication_create(
     }
     _pub->map_raw_log_close_func = context->map_raw_log_close_func;
 
+
     strncpy(_pub->log_file_name, path, (size_t)path_length);
     _pub->log_file_name[path_length] = '\0';
     _pub->log_file_name_length = (size_t)path_length;
     _pub->log_meta_data = (aeron_logbuffer_metadata_t *)(_pub->mapped_raw_log.log_meta_data.addr);
 
+    int64_t initial_position = 0;
     if (params->is_replay)
     {
         int64_t term_id = params->term_id;
         int32_t term_count = (int32_t)term_id - initial_term_id;
         size_t active_index = aeron_logbuffer_index_by_term_count(term_count);
 
+        initial_position = aeron_logbuffer_compute_position(
+            (int32_t)term_id,
+            (int32_t)params->term_offset,
+            (size_t)aeron_number_of_trailing_zeroes((int32_t)params->term_length),
+            initial_term_id);
+
         _pub->log_meta_data->term_tail_counters[active_index] =
             (term_id * ((int64_t)1 << 32)) | params->term_offset;
         
@@ -177,7 +204,14 @@ int aeron_network_publication_create(
     _pub->conductor_fields.managed_resource.incref = aeron_network_publication_incref;
     _pub->conductor_fields.managed_resource.decref = aeron_network_publication_decref;
     _pub->conductor_fields.has_reached_end_of_life = false;
-    _pub->conductor_fields.clean_position = 0;
+    _pub->conductor_fields.clean_position = initial_position;
+    _pub->term_cleaner = context->term_cleaner;
+    _pub->cleaned_position = initial_position;
+    _pub->zero_copy_released_position = 0;
+    _pub->zero_copy_checkpoint_position = 0;
+    _pub->zero_copy_checkpoint_id = 0;
+    _pub->has_zero_copy_checkpoint = false;
+    _pub->is_zero_copy_enabled = aeron_udp_channel_transport_is_zero_copy_enabled(&endpoint->transport);
     _pub->conductor_fields.status = AERON_NETWORK_PUBLICATION_STATUS_ACTIVE;
     _pub->conductor_fields.refcnt = 1;
     _pub->conductor_fields.time_of_last_activity_ns = now_ns;
@@ -213,7 +247,9 @@ int aeron_network_publication_create(
     _pub->is_end_of_stream = false;
     _pub->track_sender_limits = true;
     _pub->has_sender_released = false;
+    _pub->gso_enabled = context->socket_gso_enabled;
 
+    _pub->has_shared_system_counters = context->sender_count > 1;
     _pub->short_sends_counter = aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_SHORT_SENDS);
     _pub->heartbeats_sent_counter = aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_HEARTBEATS_SENT);
     _pub->sender_flow_control_limits_counter = aeron_system_counter_addr(
@@ -357,7 +393,8 @@ int aeron_network_publication_heartbeat_message_check(
             }
         }
 
-        aeron_counter_ordered_increment(publication->heartbeats_sent_counter, 1);
+        aeron_counter_shared_increment(
+            publication->heartbeats_sent_counter, 1, publication->has_shared_system_counters);
         publication->time_of_last_send_or_heartbeat_ns = now_ns;
     }
 
@@ -365,76 +402,140 @@ int aeron_network_publication_heartbeat_message_check(
 }
 
 int aeron_network_publication_send_data(
-    aeron_network_publication_t *publication, int64_t now_ns, int64_t snd_pos, int32_t term_offset)
+    aeron_network_publication_t *publication, int64_t now_ns, int64_t snd_pos, int32_t term_offset, size_t max_messages)
 {
     const size_t term_length = (size_t)publication->term_length_mask + 1;
     int result = 0, vlen = 0, bytes_sent = 0;
     int32_t available_window = (int32_t)(aeron_counter_get(publication->snd_lmt_position.value_addr) - snd_pos);
     int64_t highest_pos = snd_pos;
-    struct iovec iov[AERON_NETWORK_PUBLICATION_MAX_MESSAGES_PER_SEND];
-    struct mmsghdr mmsghdr[AERON_NETWORK_PUBLICATION_MAX_MESSAGES_PER_SEND];
+    bool is_scan_complete = available_window <= 0;
 
-    for (size_t i = 0; i < AERON_NETWORK_PUBLICATION_MAX_MESSAGES_PER_SEND && available_window > 0; i++)
+    for (size_t i = 0; i < max_messages && !is_scan_complete; i++)
     {
-        size_t scan_limit = (size_t)available_window < publication->mtu_length ?
-            (size_t)available_window : publication->mtu_length;
         size_t active_index = aeron_logbuffer_index_by_position(snd_pos, publication->position_bits_to_shift);
-        size_t padding = 0;
+        uint8_t *term_buffer = publication->mapped_raw_log.term_buffers[active_index].addr;
+        uint8_t *ptr = term_buffer + term_offset;
+        size_t segment_length = publication->mtu_length, num_segments = 0, length = 0, position_delta = 0;
+
+        /*
+         * With GSO, contiguous chunks are coalesced into one message for as long as each is a full segment. Only the
+         * last chunk may be shorter, which matches how the kernel splits the payload back into datagrams.
+         */
+        do
+        {
+            size_t scan_limit = (size_t)available_window < segment_length ? (size_t)available_window : segment_length;
+            size_t padding = 0;
 
-        uint8_t *ptr = publication->mapped_raw_log.term_buffers[active_index].addr + term_offset;
-        const size_t term_length_left = term_length - (size_t)term_offset;
-        const size_t available = aeron_term_scanner_scan_for_availability(ptr, term_length_left, scan_limit, &padding);
+            const size_t term_length_left = term_length - (size_t)term_offset;
+            const size_t available = aeron_term_scanner_scan_for_availability(
+                term_buffer + term_offset, term_length_left, scan_limit, &padding);
 
-        if (available > 0)
-        {
-            iov[i].iov_base = ptr;
-            iov[i].iov_len = available;
-            mmsghdr[i].msg_hdr.msg_iov = &iov[i];
-            mmsghdr[i].msg_hdr.msg_iovlen = 1;
-            mmsghdr[i].msg_hdr.msg_flags = 0;
-            mmsghdr[i].msg_len = 0;
-            mmsghdr[i].msg_hdr.msg_control = NULL;
-            mmsghdr[i].msg_hdr.msg_controllen = 0;
-            vlen++;
+            if (available > 0)
+            {
+                segment_length = 0 == num_segments ? available : segment_length;
+                num_segments++;
+                length += available;
+                position_delta += available + padding;
 
-            bytes_sent += available;
-            available_window -= available + padding;
-            term_offset += available + padding;
-            highest_pos += available + padding;
-        }
+                available_window -= available + padding;
+                term_offset += available + padding;
+            }
 
-        if (available == 0 || term_length == (size_t)term_offset)
-        {
-            break;
+            if (available == 0 || term_length == (size_t)term_offset || available_window <= 0)
+            {
+                is_scan_complete = true;
+                break;
+            }
+
+            if (available < segment_length || padding > 0)
+            {
+                break;
+            }
         }
-    }
+        while (publication->gso_enabled &&
+            num_segments < AERON_UDP_CHANNEL_TRANSPORT_GSO_MAX_SEGMENTS &&
+            length + segment_length <= AERON_UDP_CHANNEL_TRANSPORT_GSO_MAX_LENGTH);
 
-    if (vlen > 0)
-    {
-        if ((result = aeron_send_channel_sendmmsg(publication->endpoint, mmsghdr, (size_t)vlen)) != vlen)
+        if (num_segments > 0)
         {
-            if (result >= 0)
+            if ((result = aeron_send_channel_endpoint_send_batch_add(
+                publication->endpoint,
+                ptr,
+                length,
+                num_segments > 1 ? (uint16_t)segment_length : 0,
+                publication->short_sends_counter)) < 0)
             {
-                aeron_counter_increment(publication->short_sends_counter, 1);
+                break;
             }
+
+            /* only what was staged counts as sent, so a failed add leaves snd_pos at the start of its chunk */
+            bytes_sent += (int)length;
+            highest_pos += position_delta;
+            vlen++;
         }
+    }
 
+    if (vlen > 0)
+    {
         publication->time_of_last_send_or_heartbeat_ns = now_ns;
         publication->track_sender_limits = true;
         aeron_counter_set_ordered(publication->snd_pos_position.value_addr, highest_pos);
     }
     else if (publication->track_sender_limits && available_window <= 0)
     {
-        aeron_counter_ordered_increment(publication->sender_flow_control_limits_counter, 1);
+        aeron_counter_shared_increment(
+            publication->sender_flow_control_limits_counter, 1, publication->has_shared_system_counters);
         publication->track_sender_limits = false;
     }
 
     return result < 0 ? result : bytes_sent;
 }
 
-int aeron_network_publication_send(aeron_network_publication_t *publication, int64_t now_ns)
+static int aeron_network_publication_update_zero_copy_released(
+    aeron_network_publication_t *publication, int64_t snd_pos)
+{
+    aeron_udp_channel_transport_t *transport = &publication->endpoint->transport;
+
+    if (aeron_udp_channel_transport_poll_zero_copy(transport) < 0)
+    {
+        return -1;
+    }
+
+    /* the batch holding everything up to snd_pos has been flushed, so all of it was sent before zero_copy_sent */
+    if (transport->zero_copy_completed == transport->zero_copy_sent)
+    {
+        publication->has_zero_copy_checkpoint = false;
+        AERON_PUT_ORDERED(publication->zero_copy_released_position, snd_pos);
+        return 0;
+    }
+
+    if (publication->has_zero_copy_checkpoint &&
+        aeron_udp_channel_transport_zero_copy_has_completed(transport, publication->zero_copy_checkpoint_id))
+    {
+        publication->has_zero_copy_checkpoint = false;
+        AERON_PUT_ORDERED(publication->zero_copy_released_position, publication->zero_copy_checkpoint_position);
+    }
+
+    if (!publication->has_zero_copy_checkpoint && snd_pos > publication->zero_copy_released_position)
+    {
+        publication->zero_copy_checkpoint_id = transport->zero_copy_sent;
+        publication->zero_copy_checkpoint_position = snd_pos;
+        publication->has_zero_copy_checkpoint = true;
+    }
+
+    return 0;
+}
+
+int aeron_network_publication_send(aeron_network_publication_t *publication, int64_t now_ns, size_t max_messages)
 {
     int64_t snd_pos = aeron_counter_get(publication->snd_pos_position.value_addr);
+
+    if (publication->is_zero_copy_enabled &&
+        aeron_network_publication_update_zero_copy_released(publication, snd_pos) < 0)
+    {
+        return -1;
+    }
+
     int32_t active_term_id = aeron_logbuffer_compute_term_id_from_position(
         snd_pos, publication->position_bits_to_shift, publication->initial_term_id);
     int32_t term_offset = (int32_t)snd_pos & publication->term_length_mask;
@@ -447,7 +548,7 @@ int aeron_network_publication_send(aeron_network_publication_t *publication, int
         }
     }
 
-    int bytes_sent = aeron_network_publication_send_data(publication, now_ns, snd_pos, term_offset);
+    int bytes_sent = aeron_network_publication_send_data(publication, now_ns, snd_pos, term_offset, max_messages);
     if (bytes_sent < 0)
     {
         return -1;
@@ -491,7 +592,8 @@ int aeron_network_publication_send(aeron_network_publication_t *publication, int
         AERON_PUT_ORDERED(publication->has_receivers, false);
     }
 
-    aeron_retransmit_handler_process_timeouts(&publication->retransmit_handler, now_ns);
+    aeron_retransmit_handler_process_timeouts(
+        &publication->retransmit_handler, now_ns, aeron_network_publication_resend, publication);
 
     return bytes_sent;
 }
@@ -503,7 +605,7 @@ int aeron_network_publication_resend(void *clientd, int32_t term_id, int32_t ter
     const int64_t resend_position = aeron_logbuffer_compute_position(
         term_id, term_offset, publication->position_bits_to_shift, publication->initial_term_id);
     const size_t term_length = (size_t)(publication->term_length_mask + 1L);
-    int result = 0;
+    int bytes_resent = 0;
 
     if (resend_position < sender_position && resend_position >= (sender_position - (int32_t)term_length))
     {
@@ -549,20 +651,21 @@ int aeron_network_publication_resend(void *clientd, int32_t term_id, int32_t ter
                 }
                 else
                 {
-                    result = -1;
-                    break;
+                    return -1;
                 }
             }
 
             bytes_sent = (int32_t)(available + padding);
+            bytes_resent += (int)available;
             remaining_bytes -= bytes_sent;
         }
         while (remaining_bytes > 0);
 
-        aeron_counter_ordered_increment(publication->retransmits_sent_counter, 1);
+        aeron_counter_shared_increment(
+            publication->retransmits_sent_counter, 1, publication->has_shared_system_counters);
     }
 
-    return result;
+    return bytes_resent;
 }
 
 void aeron_network_publication_on_nak(
@@ -669,8 +772,29 @@ void aeron_network_publication_clean_buffer(aeron_network_publication_t *publica
         int32_t bytes_for_cleaning = (int32_t)(dirty_range - reserved_range);
         int32_t length = bytes_for_cleaning < bytes_left_in_term ? bytes_for_cleaning : bytes_left_in_term;
 
-        memset(publication->mapped_raw_log.term_buffers[dirty_index].addr + term_offset, 0, (size_t)length);
-        publication->conductor_fields.clean_position = clean_position + length;
+        if (publication->is_zero_copy_enabled)
+        {
+            int64_t released_position;
+            AERON_GET_VOLATILE(released_position, publication->zero_copy_released_position);
+
+            const int64_t bytes_released = released_position - clean_position;
+            if (bytes_released <= 0)
+            {
+                return;
+            }
+
+            length = bytes_released < length ? (int32_t)bytes_released : length;
+        }
+
+        if (aeron_term_cleaner_clean(
+            publication->term_cleaner,
+            publication->mapped_raw_log.term_buffers[dirty_index].addr + term_offset,
+            (size_t)length,
+            clean_position + length,
+            &publication->cleaned_position))
+        {
+            publication->conductor_fields.clean_position = clean_position + length;
+        }
     }
 }
 
@@ -701,12 +825,32 @@ int aeron_network_publication_update_pub_lmt(aeron_network_publication_t *public
             }
         }
 
-        const int64_t proposed_pub_lmt = min_consumer_position + publication->term_window_length;
+        const int64_t uncleaned_pub_lmt = min_consumer_position + publication->term_window_length;
+        int64_t proposed_pub_lmt = aeron_term_cleaner_limit(
+            publication->term_cleaner,
+            uncleaned_pub_lmt,
+            &publication->cleaned_position,
+            2 * (int64_t)(publication->term_length_mask + 1));
+
+        if (publication->is_zero_copy_enabled)
+        {
+            /* as with a lagging cleaner, keep producers off what cannot be cleaned until the kernel lets go of it */
+            int64_t released_position;
+            AERON_GET_VOLATILE(released_position, publication->zero_copy_released_position);
+
+            const int64_t released_limit = released_position + (2 * (int64_t)(publication->term_length_mask + 1));
+            proposed_pub_lmt = proposed_pub_lmt < released_limit ? proposed_pub_lmt : released_limit;
+        }
+
         if (aeron_counter_propose_max_ordered(publication->pub_lmt_position.value_addr, proposed_pub_lmt))
         {
-            aeron_network_publication_clean_buffer(publication, proposed_pub_lmt);
+            aeron_network_publication_clean_buffer(publication, uncleaned_pub_lmt);
             work_count = 1;
         }
+        else if (proposed_pub_lmt < uncleaned_pub_lmt)
+        {
+            aeron_network_publication_clean_buffer(publication, uncleaned_pub_lmt);
+        }
     }
     else if (*publication->pub_lmt_position.value_addr > snd_pos)
     {
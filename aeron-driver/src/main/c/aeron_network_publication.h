@@ -39,8 +39,6 @@ aeron_network_publication_status_t;
 #define AERON_NETWORK_PUBLICATION_SETUP_TIMEOUT_NS (100 * 1000 * 1000L)
 #define AERON_NETWORK_PUBLICATION_CONNECTION_TIMEOUT_MS (5 * 1000L)
 
-#define AERON_NETWORK_PUBLICATION_MAX_MESSAGES_PER_SEND (2)
-
 typedef struct aeron_send_channel_endpoint_stct aeron_send_channel_endpoint_t;
 typedef struct aeron_driver_conductor_stct aeron_driver_conductor_t;
 
@@ -63,6 +61,20 @@ typedef struct aeron_network_publication_stct
         (4 * AERON_CACHE_LINE_LENGTH) - sizeof(struct aeron_network_publication_conductor_fields_stct)];
 
     aeron_mapped_raw_log_t mapped_raw_log;
+    aeron_term_cleaner_t *term_cleaner;
+    volatile int64_t cleaned_position;
+
+    /*
+     * With zero-copy sends the kernel may still be reading from the term after a send returns, so the sender publishes
+     * the position below which it is known to have finished and the conductor does not clean beyond that. A checkpoint
+     * ties the sender position at the time to the number of the next zero-copy send on the endpoint.
+     */
+    volatile int64_t zero_copy_released_position;
+    int64_t zero_copy_checkpoint_position;
+    uint32_t zero_copy_checkpoint_id;
+    bool has_zero_copy_checkpoint;
+    bool is_zero_copy_enabled;
+
     aeron_position_t pub_pos_position;
     aeron_position_t pub_lmt_position;
     aeron_position_t snd_pos_position;
@@ -98,6 +110,7 @@ typedef struct aeron_network_publication_stct
     bool is_end_of_stream;
     bool track_sender_limits;
     bool has_sender_released;
+    bool gso_enabled;
     aeron_map_raw_log_close_func_t map_raw_log_close_func;
 
     int64_t *short_sends_counter;
@@ -105,6 +118,7 @@ typedef struct aeron_network_publication_stct
     int64_t *sender_flow_control_limits_counter;
     int64_t *retransmits_sent_counter;
     int64_t *unblocked_publications_counter;
+    bool has_shared_system_counters;
 }
 aeron_network_publication_t;
 
@@ -136,10 +150,16 @@ void aeron_network_publication_decref(void *clientd);
 void aeron_network_publication_on_time_event(
     aeron_driver_conductor_t *conductor, aeron_network_publication_t *publication, int64_t now_ns, int64_t now_ms);
 
-int aeron_network_publication_send(aeron_network_publication_t *publication, int64_t now_ns);
+/*
+ * Stage up to max_messages of data on the endpoint send batch, or send a setup or heartbeat if due. The batch is sent
+ * when the caller flushes the endpoint.
+ */
+int aeron_network_publication_send(aeron_network_publication_t *publication, int64_t now_ns, size_t max_messages);
 
 int aeron_network_publication_send_data(
-    aeron_network_publication_t *publication, int64_t now_ns, int64_t snd_pos, int32_t term_offset);
+    aeron_network_publication_t *publication, int64_t now_ns, int64_t snd_pos, int32_t term_offset, size_t max_messages);
+
+int aeron_network_publication_resend(void *clientd, int32_t term_id, int32_t term_offset, size_t length);
 
 void aeron_network_publication_on_nak(
     aeron_network_publication_t *publication, int32_t term_id, int32_t term_offset, int32_t length);
@@ -248,6 +248,27 @@ int32_t aeron_counter_receive_channel_status_allocate(
         channel);
 }
 
+int32_t aeron_counter_per_image_indicator_allocate(
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int64_t registration_id,
+    int32_t session_id,
+    int32_t stream_id,
+    int32_t channel_length,
+    const char *channel)
+{
+    return aeron_stream_position_counter_allocate(
+        counters_manager,
+        name,
+        AERON_COUNTER_PER_IMAGE_TYPE_ID,
+        registration_id,
+        session_id,
+        stream_id,
+        channel_length,
+        channel,
+        "");
+}
+
 int32_t aeron_heartbeat_status_allocate(
     aeron_counters_manager_t *counters_manager,
     const char *name,
@@ -295,3 +316,41 @@ int32_t aeron_counter_publisher_position_allocate(
         channel,
         "");
 }
+
+int32_t aeron_counter_receiver_histogram_allocate(
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int64_t registration_id,
+    int32_t session_id,
+    int32_t stream_id,
+    int32_t channel_length,
+    const char *channel,
+    const char *bucket_label)
+{
+    return aeron_stream_position_counter_allocate(
+        counters_manager,
+        name,
+        AERON_COUNTER_RECEIVER_HISTOGRAM_TYPE_ID,
+        registration_id,
+        session_id,
+        stream_id,
+        channel_length,
+        channel,
+        bucket_label);
+}
+
+int32_t aeron_counter_receiver_shard_allocate(
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int32_t shard_index)
+{
+    return aeron_heartbeat_status_allocate(counters_manager, name, AERON_COUNTER_RECEIVER_SHARD_TYPE_ID, shard_index);
+}
+
+int32_t aeron_counter_sender_shard_allocate(
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int32_t shard_index)
+{
+    return aeron_heartbeat_status_allocate(counters_manager, name, AERON_COUNTER_SENDER_SHARD_TYPE_ID, shard_index);
+}
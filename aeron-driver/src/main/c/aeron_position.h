@@ -130,6 +130,17 @@ int32_t aeron_counter_receive_channel_status_allocate(
     int32_t channel_length,
     const char *channel);
 
+#define AERON_COUNTER_PER_IMAGE_TYPE_ID (10)
+
+int32_t aeron_counter_per_image_indicator_allocate(
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int64_t registration_id,
+    int32_t session_id,
+    int32_t stream_id,
+    int32_t channel_length,
+    const char *channel);
+
 #define AERON_COUNTER_CLIENT_HEARTBEAT_STATUS_NAME "client-heartbeat"
 #define AERON_COUNTER_CLIENT_HEARTBEAT_STATUS_TYPE_ID (11)
 
@@ -148,4 +159,36 @@ int32_t aeron_counter_publisher_position_allocate(
     int32_t channel_length,
     const char *channel);
 
+#define AERON_COUNTER_RECEIVER_SHARD_BYTES_RECEIVED_NAME "rcv-shard-bytes"
+#define AERON_COUNTER_RECEIVER_SHARD_IMAGES_NAME "rcv-shard-images"
+#define AERON_COUNTER_RECEIVER_SHARD_TYPE_ID (13)
+
+int32_t aeron_counter_receiver_shard_allocate(
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int32_t shard_index);
+
+#define AERON_COUNTER_RECEIVER_LATENCY_NAME "rcv-latency"
+#define AERON_COUNTER_RECEIVER_JITTER_NAME "rcv-jitter"
+#define AERON_COUNTER_RECEIVER_HISTOGRAM_TYPE_ID (15)
+
+int32_t aeron_counter_receiver_histogram_allocate(
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int64_t registration_id,
+    int32_t session_id,
+    int32_t stream_id,
+    int32_t channel_length,
+    const char *channel,
+    const char *bucket_label);
+
+#define AERON_COUNTER_SENDER_SHARD_BYTES_SENT_NAME "snd-shard-bytes"
+#define AERON_COUNTER_SENDER_SHARD_PUBLICATIONS_NAME "snd-shard-publications"
+#define AERON_COUNTER_SENDER_SHARD_TYPE_ID (14)
+
+int32_t aeron_counter_sender_shard_allocate(
+    aeron_counters_manager_t *counters_manager,
+    const char *name,
+    int32_t shard_index);
+
 #endif
@@ -22,6 +22,7 @@
 #include "aeron_driver_receiver_proxy.h"
 #include "aeron_driver_conductor.h"
 #include "concurrent/aeron_term_gap_filler.h"
+#include "aeron_position.h"
 
 int aeron_publication_image_create(
     aeron_publication_image_t **image,
@@ -98,8 +99,21 @@ int aeron_publication_image_create(
         return -1;
     }
 
-    if (context->map_raw_log_func(
-        &_image->mapped_raw_log, path, is_sparse, (uint64_t)term_buffer_length, context->file_page_size) < 0)
+    if (!aeron_raw_log_pool_take(
+        context->raw_log_pool,
+        &_image->mapped_raw_log,
+        path,
+        is_sparse,
+        (uint64_t)term_buffer_length,
+        context->receiver_numa_node) &&
+        context->map_raw_log_func(
+            &_image->mapped_raw_log,
+            path,
+            is_sparse,
+            context->term_buffer_huge_pages,
+            (uint64_t)term_buffer_length,
+            context->file_page_size,
+            context->receiver_numa_node) < 0)
     {
         aeron_free(_image->log_file_name);
         aeron_free(_image);
@@ -108,6 +122,7 @@ int aeron_publication_image_create(
     }
     _image->map_raw_log_close_func = context->map_raw_log_close_func;
 
+
     strncpy(_image->log_file_name, path, (size_t)path_length);
     _image->log_file_name[path_length] = '\0';
     _image->log_file_name_length = (size_t)path_length;
@@ -124,6 +139,7 @@ int aeron_publication_image_create(
         _image->mapped_raw_log.log_meta_data.addr, session_id, stream_id, initial_term_id);
 
     _image->endpoint = endpoint;
+    _image->receiver_proxy = endpoint->receiver_proxy;
     _image->congestion_control = congestion_control;
     _image->loss_reporter = loss_reporter;
     _image->loss_reporter_offset = -1;
@@ -155,10 +171,14 @@ int aeron_publication_image_create(
     _image->last_sm_change_number = -1;
     _image->last_loss_change_number = -1;
     _image->is_end_of_stream = false;
+    _image->has_recv_histograms = false;
+    _image->last_recv_timestamp_ns = 0;
+    _image->last_recv_interval_ns = -1;
 
     memcpy(&_image->control_address, control_address, sizeof(_image->control_address));
     memcpy(&_image->source_address, source_address, sizeof(_image->source_address));
 
+    _image->has_shared_system_counters = context->receiver_count > 1;
     _image->heartbeats_received_counter = aeron_system_counter_addr(
         system_counters, AERON_SYSTEM_COUNTER_HEARTBEATS_RECEIVED);
     _image->flow_control_under_runs_counter = aeron_system_counter_addr(
@@ -191,6 +211,8 @@ int aeron_publication_image_create(
     _image->last_packet_timestamp_ns = now_ns;
     _image->last_status_message_timestamp = 0;
     _image->conductor_fields.clean_position = initial_position;
+    _image->term_cleaner = context->term_cleaner;
+    _image->cleaned_position = initial_position;
     _image->conductor_fields.time_of_last_status_change_ns = now_ns;
 
     aeron_counter_set_ordered(_image->rcv_hwm_position.value_addr, initial_position);
@@ -210,6 +232,12 @@ int aeron_publication_image_close(aeron_counters_manager_t *counters_manager, ae
         aeron_counters_manager_free(counters_manager, (int32_t)image->rcv_hwm_position.counter_id);
         aeron_counters_manager_free(counters_manager, (int32_t)image->rcv_pos_position.counter_id);
 
+        if (image->has_recv_histograms)
+        {
+            aeron_latency_histogram_close(&image->recv_latency_histogram, counters_manager);
+            aeron_latency_histogram_close(&image->recv_jitter_histogram, counters_manager);
+        }
+
         for (size_t i = 0, length = subscribable->length; i < length; i++)
         {
             aeron_counters_manager_free(counters_manager, (int32_t)subscribable->array[i].counter_id);
@@ -227,6 +255,80 @@ int aeron_publication_image_close(aeron_counters_manager_t *counters_manager, ae
     return 0;
 }
 
+int aeron_publication_image_enable_recv_histograms(
+    aeron_publication_image_t *image,
+    aeron_counters_manager_t *counters_manager,
+    int32_t channel_length,
+    const char *channel)
+{
+    const int64_t registration_id = image->conductor_fields.managed_resource.registration_id;
+
+    if (aeron_latency_histogram_init(
+        &image->recv_latency_histogram,
+        counters_manager,
+        AERON_COUNTER_RECEIVER_LATENCY_NAME,
+        registration_id,
+        image->session_id,
+        image->stream_id,
+        channel_length,
+        channel) < 0)
+    {
+        return -1;
+    }
+
+    if (aeron_latency_histogram_init(
+        &image->recv_jitter_histogram,
+        counters_manager,
+        AERON_COUNTER_RECEIVER_JITTER_NAME,
+        registration_id,
+        image->session_id,
+        image->stream_id,
+        channel_length,
+        channel) < 0)
+    {
+        aeron_latency_histogram_close(&image->recv_latency_histogram, counters_manager);
+        return -1;
+    }
+
+    image->has_recv_histograms = true;
+
+    return 0;
+}
+
+/*
+ * Jitter is how much the interval between arrivals differs from the one before, as in RFC 3550 without smoothing.
+ */
+static void aeron_publication_image_record_recv_timestamp(aeron_publication_image_t *image)
+{
+    if (!image->has_recv_histograms)
+    {
+        return;
+    }
+
+    const int64_t recv_timestamp_ns = image->endpoint->recv_timestamp_ns;
+    if (0 == recv_timestamp_ns)
+    {
+        return;
+    }
+
+    aeron_latency_histogram_record(&image->recv_latency_histogram, aeron_epoch_nano_clock() - recv_timestamp_ns);
+
+    if (0 != image->last_recv_timestamp_ns)
+    {
+        const int64_t interval_ns = recv_timestamp_ns - image->last_recv_timestamp_ns;
+
+        if (image->last_recv_interval_ns >= 0)
+        {
+            const int64_t jitter_ns = interval_ns - image->last_recv_interval_ns;
+            aeron_latency_histogram_record(&image->recv_jitter_histogram, jitter_ns < 0 ? -jitter_ns : jitter_ns);
+        }
+
+        image->last_recv_interval_ns = interval_ns;
+    }
+
+    image->last_recv_timestamp_ns = recv_timestamp_ns;
+}
+
 void aeron_publication_image_clean_buffer_to(aeron_publication_image_t *image, int64_t new_clean_position)
 {
     const int64_t clean_position = image->conductor_fields.clean_position;
@@ -236,9 +338,13 @@ void aeron_publication_image_clean_buffer_to(aeron_publication_image_t *image, i
     const int32_t bytes_left_in_term = (int32_t)image->term_length_mask + 1 - term_offset;
     const int32_t length = bytes_for_cleaning < bytes_left_in_term ? bytes_for_cleaning : bytes_left_in_term;
 
-    if (length > 0)
+    if (length > 0 && aeron_term_cleaner_clean(
+        image->term_cleaner,
+        image->mapped_raw_log.term_buffers[dirty_term_index].addr + term_offset,
+        (size_t)length,
+        clean_position + (int64_t)length,
+        &image->cleaned_position))
     {
-        memset(image->mapped_raw_log.term_buffers[dirty_term_index].addr + term_offset, 0, (size_t)length);
         image->conductor_fields.clean_position = clean_position + (int64_t)length;
     }
 }
@@ -338,12 +444,18 @@ void aeron_publication_image_track_rebuild(
         loss_found);
 
     const int32_t threshold = window_length / 4;
+    const int64_t sm_position = aeron_term_cleaner_limit(
+        image->term_cleaner, min_sub_pos, &image->cleaned_position, (int64_t)image->term_length_mask + 1);
 
     if (should_force_send_sm ||
         (now_ns > (image->last_status_message_timestamp + status_message_timeout)) ||
-        (min_sub_pos > (image->next_sm_position + threshold)))
+        (sm_position > (image->next_sm_position + threshold)))
+    {
+        aeron_publication_image_schedule_status_message(image, now_ns, sm_position, window_length);
+        aeron_publication_image_clean_buffer_to(image, min_sub_pos - (image->term_length_mask + 1));
+    }
+    else if (sm_position < min_sub_pos)
     {
-        aeron_publication_image_schedule_status_message(image, now_ns, min_sub_pos, window_length);
         aeron_publication_image_clean_buffer_to(image, min_sub_pos - (image->term_length_mask + 1));
     }
 }
@@ -367,7 +479,7 @@ int aeron_publication_image_insert_packet(
                 AERON_PUT_ORDERED(image->log_meta_data->end_of_stream_position, packet_position);
             }
 
-            aeron_counter_ordered_increment(image->heartbeats_received_counter, 1);
+            aeron_counter_shared_increment(image->heartbeats_received_counter, 1, image->has_shared_system_counters);
         }
         else
         {
@@ -375,6 +487,7 @@ int aeron_publication_image_insert_packet(
             uint8_t *term_buffer = image->mapped_raw_log.term_buffers[index].addr;
 
             aeron_term_rebuilder_insert(term_buffer + term_offset, buffer, length);
+            aeron_publication_image_record_recv_timestamp(image);
         }
 
         AERON_PUT_ORDERED(image->last_packet_timestamp_ns, image->nano_clock());
@@ -384,6 +497,61 @@ int aeron_publication_image_insert_packet(
     return (int)length;
 }
 
+uint8_t *aeron_publication_image_zero_copy_target(aeron_publication_image_t *image, size_t max_length, size_t *length)
+{
+    const int64_t hwm_position = aeron_counter_get(image->rcv_hwm_position.value_addr);
+    const int32_t term_offset = (int32_t)(hwm_position & image->term_length_mask);
+    const int64_t term_length_left = (int64_t)image->term_length_mask + 1 - term_offset;
+    const int64_t window_length_left = image->last_sm_position_window_limit - hwm_position;
+    const int64_t available =
+        (term_length_left < window_length_left ? term_length_left : window_length_left) - AERON_DATA_HEADER_LENGTH;
+
+    if (available <= 0)
+    {
+        *length = 0;
+        return NULL;
+    }
+
+    const size_t index = aeron_logbuffer_index_by_position(hwm_position, image->position_bits_to_shift);
+
+    *length = (size_t)available < max_length ? (size_t)available : max_length;
+
+    return image->mapped_raw_log.term_buffers[index].addr + term_offset + AERON_DATA_HEADER_LENGTH;
+}
+
+bool aeron_publication_image_insert_in_place(aeron_publication_image_t *image, const uint8_t *buffer, size_t length)
+{
+    aeron_data_header_t *header = (aeron_data_header_t *)buffer;
+
+    if (AERON_FRAME_HEADER_VERSION != header->frame_header.version ||
+        AERON_HDR_TYPE_DATA != header->frame_header.type ||
+        image->session_id != header->session_id ||
+        image->stream_id != header->stream_id)
+    {
+        return false;
+    }
+
+    const int64_t packet_position = aeron_logbuffer_compute_position(
+        header->term_id, header->term_offset, image->position_bits_to_shift, image->initial_term_id);
+
+    if (packet_position != aeron_counter_get(image->rcv_hwm_position.value_addr) ||
+        packet_position < image->last_sm_position)
+    {
+        return false;
+    }
+
+    const size_t index = aeron_logbuffer_index_by_position(packet_position, image->position_bits_to_shift);
+    uint8_t *term_buffer = image->mapped_raw_log.term_buffers[index].addr;
+
+    aeron_term_rebuilder_insert_header(term_buffer + header->term_offset, buffer);
+    aeron_publication_image_record_recv_timestamp(image);
+
+    AERON_PUT_ORDERED(image->last_packet_timestamp_ns, image->nano_clock());
+    aeron_counter_propose_max_ordered(image->rcv_hwm_position.value_addr, packet_position + (int64_t)length);
+
+    return true;
+}
+
 int aeron_publication_image_on_rttm(
     aeron_publication_image_t *image, aeron_rttm_header_t *header, struct sockaddr_storage *addr)
 {
@@ -427,7 +595,8 @@ int aeron_publication_image_send_pending_status_message(aeron_publication_image_
                     receiver_window_length,
                     0);
 
-                aeron_counter_ordered_increment(image->status_messages_sent_counter, 1);
+                aeron_counter_shared_increment(
+                    image->status_messages_sent_counter, 1, image->has_shared_system_counters);
 
                 image->last_sm_change_number = change_number;
                 image->last_sm_position = sm_position;
@@ -470,7 +639,8 @@ int aeron_publication_image_send_pending_loss(aeron_publication_image_t *image)
                         term_offset,
                         length);
 
-                    aeron_counter_ordered_increment(image->nak_messages_sent_counter, 1);
+                    aeron_counter_shared_increment(
+                        image->nak_messages_sent_counter, 1, image->has_shared_system_counters);
                     work_count = send_nak_result < 0 ? send_nak_result : 1;
                 }
                 else
@@ -480,7 +650,8 @@ int aeron_publication_image_send_pending_loss(aeron_publication_image_t *image)
 
                     if (aeron_term_gap_filler_try_fill_gap(image->log_meta_data, buffer, term_id, term_offset, length))
                     {
-                        aeron_counter_ordered_increment(image->loss_gap_fills_counter, 1);
+                        aeron_counter_shared_increment(
+                            image->loss_gap_fills_counter, 1, image->has_shared_system_counters);
                     }
 
                     work_count = 1;
@@ -511,6 +682,10 @@ int aeron_publication_image_initiate_rttm(aeron_publication_image_t *image, int6
                 0,
                 true);
 
+            if (NULL != image->congestion_control->on_rttm_sent)
+            {
+                image->congestion_control->on_rttm_sent(image->congestion_control->state, now_ns);
+            }
             work_count = send_rttm_result < 0 ? send_rttm_result : 1;
         }
     }
@@ -540,7 +715,7 @@ void aeron_publication_image_on_time_event(
                 image->conductor_fields.time_of_last_status_change_ns = now_ns;
 
                 aeron_driver_receiver_proxy_on_remove_publication_image(
-                    conductor->context->receiver_proxy, image->endpoint, image);
+                    image->receiver_proxy, image->endpoint, image);
             }
             break;
         }
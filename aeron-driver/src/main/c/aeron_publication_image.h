@@ -21,6 +21,7 @@
 #include "media/aeron_receive_channel_endpoint.h"
 #include "aeron_congestion_control.h"
 #include "aeron_loss_detector.h"
+#include "aeron_latency_histogram.h"
 #include "reports/aeron_loss_reporter.h"
 
 typedef enum aeron_publication_image_status_enum
@@ -54,11 +55,14 @@ typedef struct aeron_publication_image_stct
     aeron_loss_detector_t loss_detector;
 
     aeron_mapped_raw_log_t mapped_raw_log;
+    aeron_term_cleaner_t *term_cleaner;
+    volatile int64_t cleaned_position;
     aeron_position_t rcv_hwm_position;
     aeron_position_t rcv_pos_position;
     aeron_logbuffer_metadata_t *log_meta_data;
 
     aeron_receive_channel_endpoint_t *endpoint;
+    aeron_driver_receiver_proxy_t *receiver_proxy;
     aeron_congestion_control_strategy_t *congestion_control;
     aeron_clock_func_t nano_clock;
     aeron_clock_func_t epoch_clock;
@@ -106,6 +110,14 @@ typedef struct aeron_publication_image_stct
     int64_t *status_messages_sent_counter;
     int64_t *nak_messages_sent_counter;
     int64_t *loss_gap_fills_counter;
+    bool has_shared_system_counters;
+
+    /* from the receive timestamp of each datagram to its data landing in the term, and the jitter in their arrival */
+    bool has_recv_histograms;
+    int64_t last_recv_timestamp_ns;
+    int64_t last_recv_interval_ns;
+    aeron_latency_histogram_t recv_latency_histogram;
+    aeron_latency_histogram_t recv_jitter_histogram;
 }
 aeron_publication_image_t;
 
@@ -133,6 +145,16 @@ int aeron_publication_image_create(
 
 int aeron_publication_image_close(aeron_counters_manager_t *counters_manager, aeron_publication_image_t *image);
 
+/*
+ * Record histograms of receive latency and jitter in the counters file for datagrams that come with a receive
+ * timestamp, which needs timestamping enabled on the transports of the endpoint.
+ */
+int aeron_publication_image_enable_recv_histograms(
+    aeron_publication_image_t *image,
+    aeron_counters_manager_t *counters_manager,
+    int32_t channel_length,
+    const char *channel);
+
 void aeron_publication_image_clean_buffer_to(aeron_publication_image_t *image, int64_t new_clean_position);
 
 void aeron_publication_image_on_gap_detected(void *clientd, int32_t term_id, int32_t term_offset, size_t length);
@@ -143,6 +165,19 @@ void aeron_publication_image_track_rebuild(
 int aeron_publication_image_insert_packet(
     aeron_publication_image_t *image, int32_t term_id, int32_t term_offset, const uint8_t *buffer, size_t length);
 
+/*
+ * Where the payload of the next in order datagram belongs, just past the header slot at the receiver high water
+ * mark. Nothing has been received beyond that mark so it is clean, and length is held to the term and the receiver
+ * window so nothing a sender may not yet send can be overwritten. Returns NULL when there is no room.
+ */
+uint8_t *aeron_publication_image_zero_copy_target(aeron_publication_image_t *image, size_t max_length, size_t *length);
+
+/*
+ * Complete a datagram whose header is in buffer and payload already landed at the zero copy target. Returns false,
+ * leaving the term untouched, if it is not the next in order data for this image and so must be inserted as usual.
+ */
+bool aeron_publication_image_insert_in_place(aeron_publication_image_t *image, const uint8_t *buffer, size_t length);
+
 int aeron_publication_image_on_rttm(
     aeron_publication_image_t *image, aeron_rttm_header_t *header, struct sockaddr_storage *addr);
 
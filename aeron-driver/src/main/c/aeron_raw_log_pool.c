@@ -0,0 +1,269 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "aeron_raw_log_pool.h"
+#include "aeron_alloc.h"
+#include "concurrent/aeron_atomic.h"
+#include "util/aeron_error.h"
+
+static void aeron_raw_log_pool_entry_delete(aeron_raw_log_pool_entry_t *entry)
+{
+    aeron_map_raw_log_close(&entry->mapped_raw_log, entry->path);
+    aeron_free(entry);
+}
+
+static aeron_raw_log_pool_entry_t *aeron_raw_log_pool_entry_create(
+    aeron_raw_log_pool_t *pool, uint64_t term_length, int32_t numa_node)
+{
+    aeron_raw_log_pool_entry_t *entry = NULL;
+
+    if (aeron_alloc((void **)&entry, sizeof(aeron_raw_log_pool_entry_t)) < 0)
+    {
+        return NULL;
+    }
+
+    int path_length = snprintf(
+        entry->path, sizeof(entry->path),
+        "%s/%" PRIx64 "-%" PRIx64 ".logbuffer", pool->dir, term_length, pool->next_file_id++);
+
+    if (path_length < 0 || (size_t)path_length >= sizeof(entry->path) || aeron_map_raw_log(
+        &entry->mapped_raw_log, entry->path, false, pool->use_huge_pages, term_length, pool->page_size, numa_node) < 0)
+    {
+        aeron_free(entry);
+        return NULL;
+    }
+
+    return entry;
+}
+
+static void aeron_raw_log_pool_entry_delete_func(void *clientd, volatile void *item)
+{
+    aeron_raw_log_pool_entry_delete((aeron_raw_log_pool_entry_t *)item);
+}
+
+static void *aeron_raw_log_pool_run(void *arg)
+{
+    aeron_raw_log_pool_t *pool = (aeron_raw_log_pool_t *)arg;
+    bool running;
+
+#if defined(Darwin)
+    aeron_thread_set_name("raw-log-pool");
+#else
+    aeron_thread_set_name(aeron_thread_self(), "raw-log-pool");
+#endif
+
+    AERON_GET_VOLATILE(running, pool->running);
+    while (running)
+    {
+        int work_count = 0;
+
+        for (size_t i = 0; i < pool->term_length_pools_length; i++)
+        {
+            volatile aeron_spsc_concurrent_array_queue_t *queue = &pool->term_length_pools[i].queue;
+
+            if (aeron_spsc_concurrent_array_queue_size(queue) < pool->depth)
+            {
+                aeron_raw_log_pool_entry_t *entry = aeron_raw_log_pool_entry_create(
+                    pool, pool->term_length_pools[i].term_length, pool->term_length_pools[i].numa_node);
+
+                /* on failure the conductor maps its own logs and reports why, so just try again later */
+                if (NULL != entry)
+                {
+                    aeron_spsc_concurrent_array_queue_offer(queue, entry);
+                    work_count++;
+                }
+            }
+        }
+
+        if (0 == work_count)
+        {
+            aeron_nano_sleep(AERON_RAW_LOG_POOL_IDLE_NS);
+        }
+
+        AERON_GET_VOLATILE(running, pool->running);
+    }
+
+    return NULL;
+}
+
+int aeron_raw_log_pool_init(
+    aeron_raw_log_pool_t **pool,
+    const char *aeron_dir,
+    const uint64_t *term_lengths,
+    const int32_t *numa_nodes,
+    size_t term_lengths_length,
+    size_t depth,
+    uint64_t page_size,
+    bool use_huge_pages)
+{
+    aeron_raw_log_pool_t *_pool = NULL;
+    int pthread_result;
+
+    if (term_lengths_length > AERON_RAW_LOG_POOL_MAX_TERM_LENGTHS)
+    {
+        aeron_set_err(EINVAL, "too many raw log pool term lengths: %d", (int)term_lengths_length);
+        return -1;
+    }
+
+    if (aeron_alloc((void **)&_pool, sizeof(aeron_raw_log_pool_t)) < 0)
+    {
+        aeron_set_err(ENOMEM, "%s", "could not allocate raw log pool");
+        return -1;
+    }
+
+    _pool->term_length_pools_length = 0;
+    for (size_t i = 0; i < term_lengths_length; i++)
+    {
+        bool is_duplicate = false;
+
+        for (size_t j = 0; j < _pool->term_length_pools_length; j++)
+        {
+            is_duplicate |= term_lengths[i] == _pool->term_length_pools[j].term_length &&
+                numa_nodes[i] == _pool->term_length_pools[j].numa_node;
+        }
+
+        if (is_duplicate)
+        {
+            continue;
+        }
+
+        if (aeron_spsc_concurrent_array_queue_init(
+            &_pool->term_length_pools[_pool->term_length_pools_length].queue, depth) < 0)
+        {
+            aeron_set_err(ENOMEM, "%s", "could not allocate raw log pool queue");
+            aeron_raw_log_pool_close(_pool);
+            return -1;
+        }
+
+        _pool->term_length_pools[_pool->term_length_pools_length].term_length = term_lengths[i];
+        _pool->term_length_pools[_pool->term_length_pools_length].numa_node = numa_nodes[i];
+        _pool->term_length_pools_length++;
+    }
+
+    snprintf(_pool->dir, sizeof(_pool->dir) - 1, "%s/%s", aeron_dir, AERON_RAW_LOG_POOL_DIR);
+    _pool->depth = depth;
+    _pool->page_size = page_size;
+    _pool->use_huge_pages = use_huge_pages;
+    _pool->next_file_id = 0;
+    _pool->running = true;
+
+    if ((pthread_result = aeron_thread_create(&_pool->thread, NULL, aeron_raw_log_pool_run, _pool)) != 0)
+    {
+        aeron_set_err(pthread_result, "raw log pool aeron_thread_create: %s", strerror(pthread_result));
+        _pool->running = false;
+        aeron_raw_log_pool_close(_pool);
+        return -1;
+    }
+
+    *pool = _pool;
+    return 0;
+}
+
+int aeron_raw_log_pool_close(aeron_raw_log_pool_t *pool)
+{
+    if (NULL == pool)
+    {
+        return 0;
+    }
+
+    if (pool->running)
+    {
+        AERON_PUT_ORDERED(pool->running, false);
+        aeron_thread_join(pool->thread, NULL);
+    }
+
+    for (size_t i = 0; i < pool->term_length_pools_length; i++)
+    {
+        aeron_spsc_concurrent_array_queue_drain_all(
+            &pool->term_length_pools[i].queue, aeron_raw_log_pool_entry_delete_func, NULL);
+        aeron_spsc_concurrent_array_queue_close(&pool->term_length_pools[i].queue);
+    }
+
+    aeron_free(pool);
+    return 0;
+}
+
+static void aeron_raw_log_pool_take_func(void *clientd, volatile void *item)
+{
+    *(aeron_raw_log_pool_entry_t **)clientd = (aeron_raw_log_pool_entry_t *)item;
+}
+
+bool aeron_raw_log_pool_take(
+    aeron_raw_log_pool_t *pool,
+    aeron_mapped_raw_log_t *mapped_raw_log,
+    const char *path,
+    bool use_sparse_files,
+    uint64_t term_length,
+    int32_t numa_node)
+{
+    if (NULL == pool || use_sparse_files)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < pool->term_length_pools_length; i++)
+    {
+        if (term_length == pool->term_length_pools[i].term_length && numa_node == pool->term_length_pools[i].numa_node)
+        {
+            aeron_raw_log_pool_entry_t *entry = NULL;
+
+            aeron_spsc_concurrent_array_queue_drain(
+                &pool->term_length_pools[i].queue, aeron_raw_log_pool_take_func, &entry, 1);
+
+            if (NULL == entry)
+            {
+                return false;
+            }
+
+            /* the mapping survives the rename so the log only has to be moved to where clients expect it */
+            if (rename(entry->path, path) < 0)
+            {
+                aeron_raw_log_pool_entry_delete(entry);
+                return false;
+            }
+
+            memcpy(mapped_raw_log, &entry->mapped_raw_log, sizeof(aeron_mapped_raw_log_t));
+            aeron_free(entry);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t aeron_raw_log_pool_available(aeron_raw_log_pool_t *pool, uint64_t term_length, int32_t numa_node)
+{
+    for (size_t i = 0; NULL != pool && i < pool->term_length_pools_length; i++)
+    {
+        if (term_length == pool->term_length_pools[i].term_length && numa_node == pool->term_length_pools[i].numa_node)
+        {
+            return (size_t)aeron_spsc_concurrent_array_queue_size(&pool->term_length_pools[i].queue);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AERON_RAW_LOG_POOL_H
+#define AERON_RAW_LOG_POOL_H
+
+#include "aeron_driver_common.h"
+#include "util/aeron_fileutil.h"
+#include "concurrent/aeron_spsc_concurrent_array_queue.h"
+#include "concurrent/aeron_thread.h"
+
+#define AERON_RAW_LOG_POOL_DIR "pool"
+#define AERON_RAW_LOG_POOL_MAX_TERM_LENGTHS (3)
+#define AERON_RAW_LOG_POOL_MAX_DEPTH (1024)
+#define AERON_RAW_LOG_POOL_IDLE_NS (1000 * 1000)
+
+typedef struct aeron_raw_log_pool_entry_stct
+{
+    aeron_mapped_raw_log_t mapped_raw_log;
+    char path[AERON_MAX_PATH];
+}
+aeron_raw_log_pool_entry_t;
+
+/*
+ * Pre-created and pre-faulted raw logs, one queue per term length and NUMA node. A background thread is the single
+ * producer keeping each queue topped up to depth and the conductor is the single consumer.
+ */
+typedef struct aeron_raw_log_pool_stct
+{
+    struct
+    {
+        aeron_spsc_concurrent_array_queue_t queue;
+        uint64_t term_length;
+        int32_t numa_node;
+    }
+    term_length_pools[AERON_RAW_LOG_POOL_MAX_TERM_LENGTHS];
+    size_t term_length_pools_length;
+
+    char dir[AERON_MAX_PATH];
+    size_t depth;
+    uint64_t page_size;
+    bool use_huge_pages;
+    int64_t next_file_id;
+
+    aeron_thread_t thread;
+    volatile bool running;
+}
+aeron_raw_log_pool_t;
+
+int aeron_raw_log_pool_init(
+    aeron_raw_log_pool_t **pool,
+    const char *aeron_dir,
+    const uint64_t *term_lengths,
+    const int32_t *numa_nodes,
+    size_t term_lengths_length,
+    size_t depth,
+    uint64_t page_size,
+    bool use_huge_pages);
+
+int aeron_raw_log_pool_close(aeron_raw_log_pool_t *pool);
+
+/*
+ * Move a pooled log of term_length, bound to numa_node or unbound when it is negative, to path. Returns false when
+ * there is no pool, the request is for a sparse log, or none is ready, so the caller maps one itself.
+ */
+bool aeron_raw_log_pool_take(
+    aeron_raw_log_pool_t *pool,
+    aeron_mapped_raw_log_t *mapped_raw_log,
+    const char *path,
+    bool use_sparse_files,
+    uint64_t term_length,
+    int32_t numa_node);
+
+size_t aeron_raw_log_pool_available(aeron_raw_log_pool_t *pool, uint64_t term_length, int32_t numa_node);
+
+#endif //AERON_RAW_LOG_POOL_H
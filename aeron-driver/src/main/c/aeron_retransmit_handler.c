@@ -14,32 +14,47 @@
  * limitations under the License.
  */
 
+#include <errno.h>
 #include <string.h>
 #include "concurrent/aeron_counters_manager.h"
 #include "protocol/aeron_udp_protocol.h"
 #include "util/aeron_error.h"
+#include "aeron_alloc.h"
 #include "aeron_retransmit_handler.h"
 
 int aeron_retransmit_handler_init(
     aeron_retransmit_handler_t *handler,
     int64_t *invalid_packets_counter,
-    int64_t linger_timeout_ns)
+    int64_t *retransmitted_bytes_counter,
+    int64_t *retransmit_overflow_counter,
+    bool has_shared_counters,
+    int64_t linger_timeout_ns,
+    size_t max_retransmits,
+    int64_t rate_limit_bytes,
+    int64_t rate_interval_ns)
 {
-    if (aeron_int64_to_ptr_hash_map_init(
-        &handler->active_retransmits_map, 8, AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
+    handler->actions = NULL;
+    if (aeron_alloc((void **)&handler->actions, sizeof(aeron_retransmit_action_t) * max_retransmits) < 0)
     {
-        int errcode = errno;
-
-        aeron_set_err(errcode, "could not init retransmit handler map: %s", strerror(errcode));
+        aeron_set_err(ENOMEM, "%s", "could not allocate retransmit actions");
         return -1;
     }
 
-    handler->invalid_packets_counter = invalid_packets_counter;
+    handler->actions_length = 0;
+    handler->actions_capacity = max_retransmits;
     handler->linger_timeout_ns = linger_timeout_ns;
+    handler->rate_limit_bytes = rate_limit_bytes;
+    handler->rate_interval_ns = rate_interval_ns;
+    handler->rate_budget_bytes = 0;
+    handler->rate_interval_deadline_ns = INT64_MIN;
+    handler->invalid_packets_counter = invalid_packets_counter;
+    handler->retransmitted_bytes_counter = retransmitted_bytes_counter;
+    handler->retransmit_overflow_counter = retransmit_overflow_counter;
+    handler->has_shared_counters = has_shared_counters;
 
-    for (size_t i = 0; i < AERON_RETRANSMIT_HANDLER_MAX_RETRANSMITS; i++)
+    for (size_t i = 0; i < max_retransmits; i++)
     {
-        handler->retransmit_action_pool[i].state = AERON_RETRANSMIT_ACTION_STATE_INACTIVE;
+        handler->actions[i].state = AERON_RETRANSMIT_ACTION_STATE_INACTIVE;
     }
 
     return 0;
@@ -47,11 +62,13 @@ int aeron_retransmit_handler_init(
 
 int aeron_retransmit_handler_close(aeron_retransmit_handler_t *handler)
 {
-    aeron_int64_to_ptr_hash_map_delete(&handler->active_retransmits_map);
+    aeron_free(handler->actions);
+    handler->actions = NULL;
     return 0;
 }
 
-bool aeron_retransmit_handler_is_invalid(aeron_retransmit_handler_t *handler, int32_t term_offset, size_t term_length)
+static bool aeron_retransmit_handler_is_invalid(
+    aeron_retransmit_handler_t *handler, int32_t term_offset, size_t term_length)
 {
     const bool is_invalid = (term_offset > ((int32_t)(term_length - AERON_DATA_HEADER_LENGTH))) || (term_offset < 0);
 
@@ -63,17 +80,81 @@ bool aeron_retransmit_handler_is_invalid(aeron_retransmit_handler_t *handler, in
     return is_invalid;
 }
 
-aeron_retransmit_action_t *aeron_retransmit_handler_assign_action(aeron_retransmit_handler_t *handler)
+static void aeron_retransmit_handler_replenish(aeron_retransmit_handler_t *handler, int64_t now_ns)
 {
-    for (size_t i = 0; i < AERON_RETRANSMIT_HANDLER_MAX_RETRANSMITS; i++)
+    if (handler->rate_limit_bytes > 0 && now_ns >= handler->rate_interval_deadline_ns)
     {
-        if (AERON_RETRANSMIT_ACTION_STATE_INACTIVE == handler->retransmit_action_pool[i].state)
+        /* an action is always sent whole, so an overshoot is paid back out of the next interval */
+        handler->rate_budget_bytes =
+            (handler->rate_budget_bytes < 0 ? handler->rate_budget_bytes : 0) + handler->rate_limit_bytes;
+        handler->rate_interval_deadline_ns = now_ns + handler->rate_interval_ns;
+    }
+}
+
+static bool aeron_retransmit_handler_can_resend(aeron_retransmit_handler_t *handler)
+{
+    return 0 == handler->rate_limit_bytes || handler->rate_budget_bytes > 0;
+}
+
+static int aeron_retransmit_handler_resend(
+    aeron_retransmit_handler_t *handler,
+    aeron_retransmit_action_t *action,
+    int64_t now_ns,
+    aeron_retransmit_handler_resend_func_t resend,
+    void *resend_clientd)
+{
+    int bytes_resent = resend(resend_clientd, action->term_id, action->term_offset, action->length);
+
+    action->state = AERON_RETRANSMIT_ACTION_STATE_LINGERING;
+    action->expire_ns = now_ns + handler->linger_timeout_ns;
+
+    if (bytes_resent > 0)
+    {
+        handler->rate_budget_bytes -= bytes_resent;
+        aeron_counter_shared_increment(
+            handler->retransmitted_bytes_counter, bytes_resent, handler->has_shared_counters);
+    }
+
+    return bytes_resent < 0 ? -1 : 0;
+}
+
+/*
+ * Term ids are compared by their distance so the order holds across wrap, as the pending ones are never far apart.
+ */
+static int aeron_retransmit_handler_compare(const aeron_retransmit_action_t *action, int32_t term_id, int32_t offset)
+{
+    const int32_t term_id_delta = (int32_t)((uint32_t)action->term_id - (uint32_t)term_id);
+
+    if (0 != term_id_delta)
+    {
+        return term_id_delta < 0 ? -1 : 1;
+    }
+
+    return action->term_offset < offset ? -1 : (action->term_offset > offset ? 1 : 0);
+}
+
+/*
+ * Index of the first action starting after offset of term_id, so any action covering offset is the one before it.
+ */
+static size_t aeron_retransmit_handler_upper_bound(aeron_retransmit_handler_t *handler, int32_t term_id, int32_t offset)
+{
+    size_t low = 0, high = handler->actions_length;
+
+    while (low < high)
+    {
+        const size_t mid = low + ((high - low) >> 1);
+
+        if (aeron_retransmit_handler_compare(&handler->actions[mid], term_id, offset) <= 0)
+        {
+            low = mid + 1;
+        }
+        else
         {
-            return &handler->retransmit_action_pool[i];
+            high = mid;
         }
     }
 
-    return NULL;
+    return low;
 }
 
 int aeron_retransmit_handler_on_nak(
@@ -88,39 +169,67 @@ int aeron_retransmit_handler_on_nak(
 {
     int result = 0;
 
-    if (!aeron_retransmit_handler_is_invalid(handler, term_offset, term_length))
+    if (aeron_retransmit_handler_is_invalid(handler, term_offset, term_length))
+    {
+        return 0;
+    }
+
+    const size_t term_length_left = term_length - term_offset;
+    const int32_t end_offset = term_offset + (int32_t)(length < term_length_left ? length : term_length_left);
+    int32_t offset = term_offset;
+
+    aeron_retransmit_handler_replenish(handler, now_ns);
+
+    while (offset < end_offset)
     {
-        const int64_t key = aeron_int64_to_ptr_hash_map_compound_key(term_id, term_offset);
+        const size_t index = aeron_retransmit_handler_upper_bound(handler, term_id, offset);
+        aeron_retransmit_action_t *before = index > 0 && handler->actions[index - 1].term_id == term_id ?
+            &handler->actions[index - 1] : NULL;
+        aeron_retransmit_action_t *after = index < handler->actions_length &&
+            handler->actions[index].term_id == term_id ? &handler->actions[index] : NULL;
 
-        if (NULL == aeron_int64_to_ptr_hash_map_get(&handler->active_retransmits_map, key) &&
-            handler->active_retransmits_map.size < AERON_RETRANSMIT_HANDLER_MAX_RETRANSMITS)
+        if (NULL != before && offset < before->term_offset + (int32_t)before->length)
         {
-            aeron_retransmit_action_t *action = aeron_retransmit_handler_assign_action(handler);
+            offset = before->term_offset + (int32_t)before->length;
+            continue;
+        }
 
-            if (NULL == action)
-            {
-                aeron_set_err(EINVAL, "%s", "could not assign retransmit action");
-                return -1;
-            }
+        const int32_t gap_end_offset = NULL != after && after->term_offset < end_offset ?
+            after->term_offset : end_offset;
+        const size_t gap_length = (size_t)(gap_end_offset - offset);
 
-            const size_t term_length_left = term_length - term_offset;
+        if (NULL != before &&
+            AERON_RETRANSMIT_ACTION_STATE_DELAYED == before->state &&
+            before->term_offset + (int32_t)before->length == offset)
+        {
+            before->length += gap_length;
+        }
+        else if (handler->actions_length < handler->actions_capacity)
+        {
+            aeron_retransmit_action_t *action = &handler->actions[index];
 
-            action->term_id = term_id;
-            action->term_offset = term_offset;
-            action->length = length < term_length_left ? length : term_length_left;
+            /* NAKs mostly arrive for the latest gaps so this is usually an append and moves little */
+            memmove(action + 1, action, (handler->actions_length - index) * sizeof(aeron_retransmit_action_t));
+            handler->actions_length++;
 
-            result = resend(resend_clientd, term_id, term_offset, action->length);
-            action->state = AERON_RETRANSMIT_ACTION_STATE_LINGERING;
-            action->expire_ns = now_ns + handler->linger_timeout_ns;
+            action->term_id = term_id;
+            action->term_offset = offset;
+            action->length = gap_length;
+            action->state = AERON_RETRANSMIT_ACTION_STATE_DELAYED;
 
-            if (aeron_int64_to_ptr_hash_map_put(&handler->active_retransmits_map, key, action) < 0)
+            if (aeron_retransmit_handler_can_resend(handler) &&
+                aeron_retransmit_handler_resend(handler, action, now_ns, resend, resend_clientd) < 0)
             {
-                int errcode = errno;
-
-                aeron_set_err(errcode, "could not put retransmit handler map: %s", strerror(errcode));
-                return -1;
+                result = -1;
             }
         }
+        else
+        {
+            /* the receiver will NAK the gap again once an action has lingered out */
+            aeron_counter_shared_increment(handler->retransmit_overflow_counter, 1, handler->has_shared_counters);
+        }
+
+        offset = gap_end_offset;
     }
 
     return result;
@@ -128,32 +237,52 @@ int aeron_retransmit_handler_on_nak(
 
 int aeron_retransmit_handler_process_timeouts(
     aeron_retransmit_handler_t *handler,
-    int64_t now_ns)
+    int64_t now_ns,
+    aeron_retransmit_handler_resend_func_t resend,
+    void *resend_clientd)
 {
     int result = 0;
-    size_t num_active_actions = handler->active_retransmits_map.size;
 
-    if (num_active_actions > 0)
+    if (0 == handler->actions_length)
     {
-        for (size_t i = 0; i < AERON_RETRANSMIT_HANDLER_MAX_RETRANSMITS && num_active_actions > 0; i++)
-        {
-            aeron_retransmit_action_t *action = &handler->retransmit_action_pool[i];
+        return 0;
+    }
 
-            if (AERON_RETRANSMIT_ACTION_STATE_LINGERING == action->state)
-            {
-                if (now_ns > action->expire_ns)
-                {
-                    const int64_t key = aeron_int64_to_ptr_hash_map_compound_key(action->term_id, action->term_offset);
+    aeron_retransmit_handler_replenish(handler, now_ns);
 
-                    action->state = AERON_RETRANSMIT_ACTION_STATE_INACTIVE;
-                    aeron_int64_to_ptr_hash_map_remove(&handler->active_retransmits_map, key);
-                    result++;
-                }
+    size_t retained = 0;
+    for (size_t i = 0; i < handler->actions_length; i++)
+    {
+        aeron_retransmit_action_t *action = &handler->actions[i];
 
-                num_active_actions--;
+        if (AERON_RETRANSMIT_ACTION_STATE_DELAYED == action->state)
+        {
+            if (aeron_retransmit_handler_can_resend(handler))
+            {
+                aeron_retransmit_handler_resend(handler, action, now_ns, resend, resend_clientd);
             }
         }
+        else if (now_ns > action->expire_ns)
+        {
+            result++;
+            continue;
+        }
+
+        /* compacted in place rather than swapped with the last so the actions stay in order */
+        if (retained != i)
+        {
+            handler->actions[retained] = *action;
+        }
+
+        retained++;
     }
 
+    for (size_t i = retained; i < handler->actions_length; i++)
+    {
+        handler->actions[i].state = AERON_RETRANSMIT_ACTION_STATE_INACTIVE;
+    }
+
+    handler->actions_length = retained;
+
     return result;
 }
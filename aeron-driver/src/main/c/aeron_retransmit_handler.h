@@ -19,12 +19,12 @@
 
 #include <stdint.h>
 #include <stddef.h>
-#include "collections/aeron_int64_to_ptr_hash_map.h"
 #include "aeron_driver_common.h"
 #include "aeronmd.h"
 
 typedef enum aeron_retransmit_action_state_enum
 {
+    AERON_RETRANSMIT_ACTION_STATE_DELAYED,
     AERON_RETRANSMIT_ACTION_STATE_LINGERING,
     AERON_RETRANSMIT_ACTION_STATE_INACTIVE,
 }
@@ -40,26 +40,52 @@ typedef struct aeron_retransmit_action_stct
 }
 aeron_retransmit_action_t;
 
-#define AERON_RETRANSMIT_HANDLER_MAX_RETRANSMITS (16)
+#define AERON_RETRANSMIT_HANDLER_DEFAULT_MAX_RETRANSMITS (16)
+#define AERON_RETRANSMIT_HANDLER_MAX_RETRANSMITS_LIMIT (64 * 1024)
 #define AERON_RETRANSMIT_HANDLER_DEFAULT_LINGER_TIMEOUT_NS (60 * 1000 * 1000L)
+#define AERON_RETRANSMIT_HANDLER_DEFAULT_RATE_INTERVAL_NS (1000 * 1000L)
 
+/*
+ * Returns the number of bytes resent, which may be 0 if the range has not been sent yet, or -1 on error.
+ */
 typedef int (*aeron_retransmit_handler_resend_func_t)(
     void *clientd, int32_t term_id, int32_t term_offset, size_t length);
 
+/*
+ * Actions are kept packed at the front of the array in term id and offset order so a NAK finds its neighbours with a
+ * binary search. Each covers a disjoint range of a term so overlapping NAKs only resend what is not already pending
+ * or lingering. With a rate limit, ranges that do not fit the budget for the current interval are held as delayed
+ * until a later interval.
+ */
 typedef struct aeron_retransmit_handler_stct
 {
-    aeron_retransmit_action_t retransmit_action_pool[AERON_RETRANSMIT_HANDLER_MAX_RETRANSMITS];
-    aeron_int64_to_ptr_hash_map_t active_retransmits_map;
+    aeron_retransmit_action_t *actions;
+    size_t actions_length;
+    size_t actions_capacity;
     int64_t linger_timeout_ns;
 
+    int64_t rate_limit_bytes;
+    int64_t rate_interval_ns;
+    int64_t rate_budget_bytes;
+    int64_t rate_interval_deadline_ns;
+
     int64_t *invalid_packets_counter;
+    int64_t *retransmitted_bytes_counter;
+    int64_t *retransmit_overflow_counter;
+    bool has_shared_counters;
 }
 aeron_retransmit_handler_t;
 
 int aeron_retransmit_handler_init(
     aeron_retransmit_handler_t *handler,
     int64_t *invalid_packets_counter,
-    int64_t linger_timeout_ns);
+    int64_t *retransmitted_bytes_counter,
+    int64_t *retransmit_overflow_counter,
+    bool has_shared_counters,
+    int64_t linger_timeout_ns,
+    size_t max_retransmits,
+    int64_t rate_limit_bytes,
+    int64_t rate_interval_ns);
 
 int aeron_retransmit_handler_close(aeron_retransmit_handler_t *handler);
 
@@ -73,8 +99,13 @@ int aeron_retransmit_handler_on_nak(
     aeron_retransmit_handler_resend_func_t resend,
     void *resend_clientd);
 
+/*
+ * Resend delayed actions the rate limit now allows and retire lingering ones. Returns the number retired.
+ */
 int aeron_retransmit_handler_process_timeouts(
     aeron_retransmit_handler_t *handler,
-    int64_t now_ns);
+    int64_t now_ns,
+    aeron_retransmit_handler_resend_func_t resend,
+    void *resend_clientd);
 
 #endif //AERON_RETRANSMIT_HANDLER_H
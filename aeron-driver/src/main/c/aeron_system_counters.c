@@ -46,7 +46,11 @@ static aeron_system_counter_t system_counters[] =
         { "Possible TTL Asymmetry", AERON_SYSTEM_COUNTER_POSSIBLE_TTL_ASYMMETRY },
         { "ControllableIdleStrategy status", AERON_SYSTEM_COUNTER_CONTROLLABLE_IDLE_STRATEGY },
         { "Loss gap fills", AERON_SYSTEM_COUNTER_LOSS_GAP_FILLS},
-        { "Client liveness timeouts", AERON_SYSTEM_COUNTER_CLIENT_TIMEOUTS}
+        { "Client liveness timeouts", AERON_SYSTEM_COUNTER_CLIENT_TIMEOUTS},
+        { "Term buffer bytes cleaned", AERON_SYSTEM_COUNTER_BYTES_CLEANED},
+        { "Term cleaner lag in bytes", AERON_SYSTEM_COUNTER_TERM_CLEANER_LAG},
+        { "Retransmitted bytes", AERON_SYSTEM_COUNTER_RETRANSMITTED_BYTES},
+        { "Retransmit ranges dropped by full retransmit handlers", AERON_SYSTEM_COUNTER_RETRANSMIT_OVERFLOW}
     };
 
 static size_t num_system_counters = sizeof(system_counters) / sizeof(aeron_system_counter_t);
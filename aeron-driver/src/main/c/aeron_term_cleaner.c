@@ -0,0 +1,206 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <string.h>
+
+#include "util/aeron_platform.h"
+
+#if defined(AERON_CPU_X64) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+#include "aeron_term_cleaner.h"
+#include "aeron_driver_context.h"
+#include "aeron_alloc.h"
+#include "concurrent/aeron_counters_manager.h"
+#include "util/aeron_error.h"
+
+#define AERON_TERM_CLEANER_NICE (10)
+
+int aeron_term_cleaner_init(
+    aeron_term_cleaner_t *cleaner,
+    bool is_offloaded,
+    bool use_non_temporal_stores,
+    int64_t *bytes_cleaned_counter,
+    int64_t *lag_counter)
+{
+    cleaner->commands_buffer = NULL;
+    cleaner->is_offloaded = is_offloaded;
+    cleaner->use_non_temporal_stores = use_non_temporal_stores;
+    cleaner->bytes_dispatched = 0;
+    cleaner->bytes_cleaned_counter = bytes_cleaned_counter;
+    cleaner->lag_counter = lag_counter;
+
+    if (is_offloaded)
+    {
+        if (aeron_alloc((void **)&cleaner->commands_buffer, AERON_TERM_CLEANER_BUFFER_LENGTH) < 0)
+        {
+            aeron_set_err(ENOMEM, "%s", "could not allocate term cleaner commands buffer");
+            return -1;
+        }
+
+        if (aeron_spsc_rb_init(&cleaner->commands, cleaner->commands_buffer, AERON_TERM_CLEANER_BUFFER_LENGTH) < 0)
+        {
+            aeron_free(cleaner->commands_buffer);
+            cleaner->commands_buffer = NULL;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+void aeron_term_cleaner_close(aeron_term_cleaner_t *cleaner)
+{
+    aeron_free(cleaner->commands_buffer);
+    cleaner->commands_buffer = NULL;
+}
+
+void aeron_term_cleaner_zero(uint8_t *addr, size_t length, bool use_non_temporal_stores)
+{
+#if defined(AERON_CPU_X64) && defined(__SSE2__)
+    if (use_non_temporal_stores)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        size_t head = (16 - ((uintptr_t)addr & 15)) & 15;
+        size_t i;
+
+        head = head < length ? head : length;
+        memset(addr, 0, head);
+
+        /* streaming stores bypass the cache so zeroing GBs does not evict what the agent is actually working on */
+        for (i = head; i + 16 <= length; i += 16)
+        {
+            _mm_stream_si128((__m128i *)(addr + i), zero);
+        }
+
+        memset(addr + i, 0, length - i);
+
+        /* streaming stores are weakly ordered so must be fenced before the cleaned position is published */
+        _mm_sfence();
+        return;
+    }
+#endif
+
+    memset(addr, 0, length);
+}
+
+static void aeron_term_cleaner_clean_now(aeron_term_cleaner_t *cleaner, aeron_term_cleaner_command_t *command)
+{
+    aeron_term_cleaner_zero(command->addr, command->length, cleaner->use_non_temporal_stores);
+    AERON_PUT_ORDERED(*command->cleaned_position, command->position);
+    aeron_counter_add_ordered(cleaner->bytes_cleaned_counter, (int64_t)command->length);
+}
+
+bool aeron_term_cleaner_clean(
+    aeron_term_cleaner_t *cleaner,
+    uint8_t *addr,
+    size_t length,
+    int64_t position,
+    volatile int64_t *cleaned_position)
+{
+    aeron_term_cleaner_command_t command;
+
+    command.addr = addr;
+    command.length = length;
+    command.position = position;
+    command.cleaned_position = cleaned_position;
+
+    if (NULL == cleaner)
+    {
+        memset(addr, 0, length);
+        AERON_PUT_ORDERED(*cleaned_position, position);
+        return true;
+    }
+
+    if (!cleaner->is_offloaded)
+    {
+        aeron_term_cleaner_clean_now(cleaner, &command);
+        return true;
+    }
+
+    if (AERON_RB_SUCCESS != aeron_spsc_rb_write(
+        &cleaner->commands, AERON_TERM_CLEANER_COMMAND_CLEAN, &command, sizeof(command)))
+    {
+        return false;
+    }
+
+    cleaner->bytes_dispatched += (int64_t)length;
+    return true;
+}
+
+void aeron_term_cleaner_update_lag(aeron_term_cleaner_t *cleaner)
+{
+    if (aeron_term_cleaner_is_offloaded(cleaner))
+    {
+        aeron_counter_set_ordered(
+            cleaner->lag_counter, cleaner->bytes_dispatched - aeron_counter_get_volatile(cleaner->bytes_cleaned_counter));
+    }
+}
+
+static void aeron_term_cleaner_on_command(int32_t msg_type_id, const void *message, size_t length, void *clientd)
+{
+    aeron_term_cleaner_t *cleaner = (aeron_term_cleaner_t *)clientd;
+    aeron_term_cleaner_command_t command;
+
+    if (AERON_TERM_CLEANER_COMMAND_CLEAN == msg_type_id && sizeof(command) == length)
+    {
+        memcpy(&command, message, sizeof(command));
+        aeron_term_cleaner_clean_now(cleaner, &command);
+    }
+}
+
+int aeron_term_cleaner_do_work(void *clientd)
+{
+    aeron_term_cleaner_t *cleaner = (aeron_term_cleaner_t *)clientd;
+
+    return (int)aeron_spsc_rb_read(
+        &cleaner->commands, aeron_term_cleaner_on_command, cleaner, AERON_TERM_CLEANER_COMMAND_LIMIT);
+}
+
+void aeron_term_cleaner_on_start(void *state, const char *role_name)
+{
+    aeron_driver_context_t *context = (aeron_driver_context_t *)state;
+
+#if defined(__linux__) && defined(SYS_gettid)
+    /* best effort, cleaning is never on the critical path as long as it keeps ahead of the producers */
+    setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), AERON_TERM_CLEANER_NICE);
+#endif
+
+    if (NULL != context->agent_on_start_func)
+    {
+        context->agent_on_start_func(context->agent_on_start_state, role_name);
+    }
+}
+
+extern bool aeron_term_cleaner_is_offloaded(aeron_term_cleaner_t *cleaner);
+
+extern int64_t aeron_term_cleaner_limit(
+    aeron_term_cleaner_t *cleaner, int64_t proposed_limit, volatile int64_t *cleaned_position, int64_t max_ahead);
+
+extern bool aeron_term_cleaner_has_caught_up(int64_t clean_position, volatile int64_t *cleaned_position);
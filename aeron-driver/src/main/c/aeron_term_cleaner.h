@@ -0,0 +1,116 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AERON_TERM_CLEANER_H
+#define AERON_TERM_CLEANER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "concurrent/aeron_atomic.h"
+#include "concurrent/aeron_spsc_rb.h"
+
+#define AERON_TERM_CLEANER_COMMAND_CLEAN (1)
+#define AERON_TERM_CLEANER_BUFFER_LENGTH ((64 * 1024) + AERON_RB_TRAILER_LENGTH)
+#define AERON_TERM_CLEANER_COMMAND_LIMIT (64)
+
+typedef struct aeron_term_cleaner_command_stct
+{
+    uint8_t *addr;
+    size_t length;
+    int64_t position;
+    volatile int64_t *cleaned_position;
+}
+aeron_term_cleaner_command_t;
+
+/*
+ * Zeroes dirty term regions either inline on the conductor or, when offloaded, on a dedicated cleaner agent fed
+ * through an SPSC ring buffer. Each resource tracks the position it has asked to be cleaned to and the cleaner
+ * publishes the position actually cleaned to, which the conductor then uses to hold back limits handed to producers.
+ */
+typedef struct aeron_term_cleaner_stct
+{
+    aeron_spsc_rb_t commands;
+    uint8_t *commands_buffer;
+    bool is_offloaded;
+    bool use_non_temporal_stores;
+    int64_t bytes_dispatched;
+    int64_t *bytes_cleaned_counter;
+    int64_t *lag_counter;
+}
+aeron_term_cleaner_t;
+
+int aeron_term_cleaner_init(
+    aeron_term_cleaner_t *cleaner,
+    bool is_offloaded,
+    bool use_non_temporal_stores,
+    int64_t *bytes_cleaned_counter,
+    int64_t *lag_counter);
+
+void aeron_term_cleaner_close(aeron_term_cleaner_t *cleaner);
+
+/*
+ * Clean length bytes at addr which takes the resource to position. Returns false if the cleaner could not accept
+ * the work, in which case the resource keeps its clean position and asks again later.
+ */
+bool aeron_term_cleaner_clean(
+    aeron_term_cleaner_t *cleaner,
+    uint8_t *addr,
+    size_t length,
+    int64_t position,
+    volatile int64_t *cleaned_position);
+
+void aeron_term_cleaner_zero(uint8_t *addr, size_t length, bool use_non_temporal_stores);
+
+void aeron_term_cleaner_update_lag(aeron_term_cleaner_t *cleaner);
+
+int aeron_term_cleaner_do_work(void *clientd);
+
+void aeron_term_cleaner_on_start(void *state, const char *role_name);
+
+inline bool aeron_term_cleaner_is_offloaded(aeron_term_cleaner_t *cleaner)
+{
+    return NULL != cleaner && cleaner->is_offloaded;
+}
+
+/*
+ * Hold a limit back to max_ahead of what has actually been cleaned so producers never reach dirty memory while the
+ * cleaner lags.
+ */
+inline int64_t aeron_term_cleaner_limit(
+    aeron_term_cleaner_t *cleaner, int64_t proposed_limit, volatile int64_t *cleaned_position, int64_t max_ahead)
+{
+    if (aeron_term_cleaner_is_offloaded(cleaner))
+    {
+        int64_t cleaned;
+        AERON_GET_VOLATILE(cleaned, *cleaned_position);
+
+        return proposed_limit < cleaned + max_ahead ? proposed_limit : cleaned + max_ahead;
+    }
+
+    return proposed_limit;
+}
+
+inline bool aeron_term_cleaner_has_caught_up(int64_t clean_position, volatile int64_t *cleaned_position)
+{
+    int64_t cleaned;
+    AERON_GET_VOLATILE(cleaned, *cleaned_position);
+
+    return cleaned == clean_position;
+}
+
+#endif //AERON_TERM_CLEANER_H
@@ -167,6 +167,18 @@ typedef struct aeron_driver_stct aeron_driver_t;
  */
 #define AERON_UNICAST_FLOWCONTROL_SUPPLIER_ENV_VAR "AERON_UNICAST_FLOWCONTROL_SUPPLIER"
 
+/**
+ * Timeout in nanoseconds after which a receiver is no longer tracked by the min and tagged multicast flow control
+ * strategies if it has not sent a status message. Can be overridden per channel with fc=min,t:5s.
+ */
+#define AERON_FLOW_CONTROL_RECEIVER_TIMEOUT_ENV_VAR "AERON_FLOW_CONTROL_RECEIVER_TIMEOUT"
+
+/**
+ * Group tag a receiver must send in its status messages to be tracked by the tagged multicast flow control
+ * strategy. Can be overridden per channel with fc=tagged,g:100.
+ */
+#define AERON_FLOW_CONTROL_GROUP_TAG_ENV_VAR "AERON_FLOW_CONTROL_GROUP_TAG"
+
 /**
  * Image liveness timeout in nanoseconds
  */
@@ -182,6 +194,21 @@ typedef struct aeron_driver_stct aeron_driver_t;
  */
 #define AERON_CONGESTIONCONTROL_SUPPLIER_ENV_VAR "AERON_CONGESTIONCONTROL_SUPPLIER"
 
+/**
+ * Should the CUBIC congestion control strategy measure RTT to the sender or use the initial RTT.
+ */
+#define AERON_CUBICCONGESTIONCONTROL_MEASURERTT_ENV_VAR "AERON_CUBICCONGESTIONCONTROL_MEASURERTT"
+
+/**
+ * Initial RTT estimate in nanoseconds used by the CUBIC congestion control strategy.
+ */
+#define AERON_CUBICCONGESTIONCONTROL_INITIALRTT_ENV_VAR "AERON_CUBICCONGESTIONCONTROL_INITIALRTT"
+
+/**
+ * Should the CUBIC congestion control strategy grow at least as fast as TCP Reno would in the TCP friendly region.
+ */
+#define AERON_CUBICCONGESTIONCONTROL_TCPMODE_ENV_VAR "AERON_CUBICCONGESTIONCONTROL_TCPMODE"
+
 /**
  * Length (in bytes) of the buffer for the loss report log.
  */
@@ -227,6 +254,27 @@ typedef struct aeron_driver_stct aeron_driver_t;
  */
 #define AERON_SHARED_IDLE_STRATEGY_ENV_VAR "AERON_SHARED_IDLE_STRATEGY"
 
+/**
+ * Number of busy spins before the backoff and controllable idle strategies start to yield.
+ */
+#define AERON_IDLE_STRATEGY_MAX_SPINS_ENV_VAR "AERON_IDLE_STRATEGY_MAX_SPINS"
+
+/**
+ * Number of yields before the backoff and controllable idle strategies start to park.
+ */
+#define AERON_IDLE_STRATEGY_MAX_YIELDS_ENV_VAR "AERON_IDLE_STRATEGY_MAX_YIELDS"
+
+/**
+ * Initial park period (in nanoseconds) of the backoff and controllable idle strategies.
+ */
+#define AERON_IDLE_STRATEGY_MIN_PARK_PERIOD_ENV_VAR "AERON_IDLE_STRATEGY_MIN_PARK_PERIOD"
+
+/**
+ * Park period (in nanoseconds) the backoff idle strategy doubles up to, also used for the PARK status of the
+ * controllable idle strategy.
+ */
+#define AERON_IDLE_STRATEGY_MAX_PARK_PERIOD_ENV_VAR "AERON_IDLE_STRATEGY_MAX_PARK_PERIOD"
+
 /**
  * Function name to call on start of each agent.
  */
@@ -237,6 +285,231 @@ typedef struct aeron_driver_stct aeron_driver_t;
  */
 #define AERON_COUNTERS_FREE_TO_REUSE_TIMEOUT_ENV_VAR "AERON_COUNTERS_FREE_TO_REUSE_TIMEOUT"
 
+/**
+ * Should the Sender and Receiver use io_uring for UDP sends and receives rather than sendmmsg/recvmmsg and epoll.
+ */
+#define AERON_IO_URING_ENABLED_ENV_VAR "AERON_IO_URING_ENABLED"
+
+/**
+ * Number of submission queue entries, and provided receive buffers, for each io_uring. Must be a power of 2.
+ */
+#define AERON_IO_URING_ENTRIES_ENV_VAR "AERON_IO_URING_ENTRIES"
+
+/**
+ * Number of datagrams the Receiver will take from a socket in a single recvmmsg, between 1 and 256.
+ */
+#define AERON_RECEIVER_IO_VECTOR_CAPACITY_ENV_VAR "AERON_RECEIVER_IO_VECTOR_CAPACITY"
+
+/**
+ * Number of Receiver agents in DEDICATED Threading Mode, each owning a shard of the receive channel endpoints. New
+ * endpoints go to the Receiver with the fewest. Ignored, as 1, in the other Threading Modes.
+ */
+#define AERON_RECEIVER_COUNT_ENV_VAR "AERON_RECEIVER_COUNT"
+
+/**
+ * Number of Sender agents in DEDICATED Threading Mode. Send channel endpoints, and the network publications on them,
+ * are pinned at creation to the Sender with the fewest publications, which also polls their control frames. Ignored,
+ * as 1, in the other Threading Modes.
+ */
+#define AERON_SENDER_COUNT_ENV_VAR "AERON_SENDER_COUNT"
+
+/**
+ * Maximum number of messages, each of up to an MTU or one GSO message, a network publication may send per Sender duty
+ * cycle. Deeper bursts need receivers with an aeron.socket.so_rcvbuf that can hold them.
+ */
+#define AERON_NETWORK_PUBLICATION_MAX_MESSAGES_PER_SEND_ENV_VAR "AERON_NETWORK_PUBLICATION_MAX_MESSAGES_PER_SEND"
+
+/**
+ * Number of messages the Sender aims to send per duty cycle, shared between the publications active in the last one.
+ */
+#define AERON_SENDER_SEND_BATCH_BUDGET_ENV_VAR "AERON_SENDER_SEND_BATCH_BUDGET"
+
+/**
+ * Maximum number of disjoint NAKed ranges a network publication tracks as being resent or lingering at once. NAKs for
+ * further ranges are dropped, and counted, until an existing one lingers out.
+ */
+#define AERON_MAX_RESEND_ENV_VAR "AERON_MAX_RESEND"
+
+/**
+ * Bytes a network publication may retransmit per aeron.retransmit.rate.interval. 0 means retransmits are not rate
+ * limited. Ranges over the limit are held and resent in a later interval.
+ */
+#define AERON_RETRANSMIT_RATE_LIMIT_ENV_VAR "AERON_RETRANSMIT_RATE_LIMIT"
+
+/**
+ * Interval over which aeron.retransmit.rate.limit applies.
+ */
+#define AERON_RETRANSMIT_RATE_INTERVAL_ENV_VAR "AERON_RETRANSMIT_RATE_INTERVAL"
+
+/**
+ * Should network publications send contiguous ranges of the term buffer as a single UDP_SEGMENT (GSO) write.
+ */
+#define AERON_SOCKET_GSO_ENABLED_ENV_VAR "AERON_SOCKET_GSO_ENABLED"
+
+/**
+ * Should receive channel endpoints enable UDP_GRO and split coalesced receives back into datagrams.
+ */
+#define AERON_SOCKET_GRO_ENABLED_ENV_VAR "AERON_SOCKET_GRO_ENABLED"
+
+/**
+ * Should unicast receive channel endpoints with a single image receive payloads straight into its term buffers rather
+ * than copying them out of the receiver buffers. Datagrams are then received one at a time rather than batched, so
+ * this pays off with larger MTUs. Ignored with aeron.socket.gro.enabled or io_uring.
+ */
+#define AERON_RECEIVER_ZERO_COPY_ENABLED_ENV_VAR "AERON_RECEIVER_ZERO_COPY_ENABLED"
+
+/**
+ * Should send channel endpoints use SO_ZEROCOPY so the kernel reads data straight from the term buffers. Completions
+ * are tracked so term buffers are not cleaned while the kernel may still reference them. Not supported with io_uring.
+ */
+#define AERON_SENDER_ZERO_COPY_ENABLED_ENV_VAR "AERON_SENDER_ZERO_COPY_ENABLED"
+
+/**
+ * Average message length in a send batch for it to be sent with MSG_ZEROCOPY, below which copying is cheaper.
+ */
+#define AERON_SENDER_ZERO_COPY_THRESHOLD_ENV_VAR "AERON_SENDER_ZERO_COPY_THRESHOLD"
+
+/**
+ * Interface, such as "eth0", to attach an AF_XDP socket to in generic mode so IPv4 unicast data bypasses the kernel
+ * network stack. Requires a single Sender and Receiver thread and is not supported with io_uring.
+ */
+#define AERON_XDP_INTERFACE_ENV_VAR "AERON_XDP_INTERFACE"
+
+/**
+ * Queue of aeron.xdp.interface to bind the AF_XDP socket to, which should be the queue the NIC steers data to.
+ */
+#define AERON_XDP_QUEUE_ENV_VAR "AERON_XDP_QUEUE"
+
+/**
+ * Number of frames in the AF_XDP UMEM, half for receiving and half for sending. Must be a power of 2.
+ */
+#define AERON_XDP_FRAME_COUNT_ENV_VAR "AERON_XDP_FRAME_COUNT"
+
+/**
+ * Timestamping of received datagrams, NONE, SOFTWARE, or HARDWARE, so each image records histograms of how long its
+ * data took from arrival to the term buffer and of the jitter in arrivals. HARDWARE needs RX timestamping enabled on
+ * the NIC and its clock kept in step with CLOCK_REALTIME, e.g. by phc2sys. Not available for AF_XDP receives.
+ */
+#define AERON_RECEIVER_TIMESTAMPING_ENV_VAR "AERON_RECEIVER_TIMESTAMPING"
+
+/**
+ * Number of sockets each unicast receive channel endpoint opens on its port with SO_REUSEPORT, so receive processing
+ * in the kernel for endpoints with many sessions is spread out rather than all queued on one socket. The sockets are
+ * all polled by the receiver of the endpoint. Endpoints opening more than one do not use receive zero copy and this is
+ * not supported with aeron.xdp.interface.
+ */
+#define AERON_RECEIVER_SOCKET_FAN_OUT_ENV_VAR "AERON_RECEIVER_SOCKET_FAN_OUT"
+
+/**
+ * How datagrams are steered to the sockets of aeron.receiver.socket.fan.out: SESSION keeping each session on one
+ * socket, CPU by the CPU the datagram is received on so each socket follows a receive queue of the NIC when the
+ * queues are bound to CPUs, or HASH by the addresses and ports of the datagram as the kernel does by default.
+ */
+#define AERON_RECEIVER_SOCKET_FAN_OUT_STEERING_ENV_VAR "AERON_RECEIVER_SOCKET_FAN_OUT_STEERING"
+
+/**
+ * SO_BUSY_POLL for the sockets of receive channel endpoints, to poll the device queue for up to this long rather than
+ * wait on an interrupt when there is nothing to receive, in whole microseconds. Raising it above net.core.busy_read
+ * needs CAP_NET_ADMIN. Default 0 to leave it unset.
+ */
+#define AERON_RECEIVER_SOCKET_BUSY_POLL_ENV_VAR "AERON_RECEIVER_SOCKET_BUSY_POLL"
+
+/**
+ * Rate, from 0.0 to 1.0, at which frames arriving at receive channel endpoints are dropped to simulate loss. For
+ * testing only, like the other AERON_DEBUG_DATA_ and AERON_DEBUG_CONTROL_ settings impairing frames arriving at
+ * receive and send channel endpoints respectively. Receive channel endpoints do not use zero copy when impaired.
+ */
+#define AERON_DEBUG_DATA_LOSS_RATE_ENV_VAR "AERON_DEBUG_DATA_LOSS_RATE"
+
+/**
+ * Rate, from 0.0 to 1.0, at which frames arriving at receive channel endpoints are dispatched twice.
+ */
+#define AERON_DEBUG_DATA_DUPLICATE_RATE_ENV_VAR "AERON_DEBUG_DATA_DUPLICATE_RATE"
+
+/**
+ * Rate, from 0.0 to 1.0, at which frames arriving at receive channel endpoints are held back to be dispatched after
+ * the frame following them.
+ */
+#define AERON_DEBUG_DATA_REORDER_RATE_ENV_VAR "AERON_DEBUG_DATA_REORDER_RATE"
+
+/**
+ * Delay added to every frame arriving at receive channel endpoints.
+ */
+#define AERON_DEBUG_DATA_DELAY_ENV_VAR "AERON_DEBUG_DATA_DELAY"
+
+/**
+ * Upper bound of a uniformly random delay added on top of aeron.debug.data.delay, reordering frames closer together.
+ */
+#define AERON_DEBUG_DATA_DELAY_JITTER_ENV_VAR "AERON_DEBUG_DATA_DELAY_JITTER"
+
+#define AERON_DEBUG_CONTROL_LOSS_RATE_ENV_VAR "AERON_DEBUG_CONTROL_LOSS_RATE"
+#define AERON_DEBUG_CONTROL_DUPLICATE_RATE_ENV_VAR "AERON_DEBUG_CONTROL_DUPLICATE_RATE"
+#define AERON_DEBUG_CONTROL_REORDER_RATE_ENV_VAR "AERON_DEBUG_CONTROL_REORDER_RATE"
+#define AERON_DEBUG_CONTROL_DELAY_ENV_VAR "AERON_DEBUG_CONTROL_DELAY"
+#define AERON_DEBUG_CONTROL_DELAY_JITTER_ENV_VAR "AERON_DEBUG_CONTROL_DELAY_JITTER"
+
+/**
+ * Seed of the random draws impairing frames, so a run can be repeated. Defaults to the time the driver started.
+ */
+#define AERON_DEBUG_IMPAIRMENT_SEED_ENV_VAR "AERON_DEBUG_IMPAIRMENT_SEED"
+
+/**
+ * CPUs, as a list such as "0-3,8", the Conductor thread is pinned to. Also used by the single agent thread in SHARED
+ * Threading Mode.
+ */
+#define AERON_CONDUCTOR_CPU_AFFINITY_ENV_VAR "AERON_CONDUCTOR_CPU_AFFINITY"
+
+/**
+ * CPUs the Sender thread is pinned to. Also used by the [sender, receiver] thread in SHARED_NETWORK Threading Mode.
+ */
+#define AERON_SENDER_CPU_AFFINITY_ENV_VAR "AERON_SENDER_CPU_AFFINITY"
+
+/**
+ * CPUs the Receiver thread is pinned to in DEDICATED Threading Mode.
+ */
+#define AERON_RECEIVER_CPU_AFFINITY_ENV_VAR "AERON_RECEIVER_CPU_AFFINITY"
+
+/**
+ * Should network publication and image term buffers be bound to the NUMA node of the CPUs the Sender and Receiver,
+ * respectively, are pinned to.
+ */
+#define AERON_NUMA_BIND_TERM_BUFFERS_ENV_VAR "AERON_NUMA_BIND_TERM_BUFFERS"
+
+/**
+ * Should term buffers be backed by huge pages. Transparent huge pages are requested for each log, or if aeron.dir is
+ * on hugetlbfs then the logs are huge page backed regardless and aeron.file.page.size must be a multiple of its
+ * page size.
+ */
+#define AERON_TERM_BUFFER_HUGE_PAGES_ENV_VAR "AERON_TERM_BUFFER_HUGE_PAGES"
+
+/**
+ * Should the CnC file be backed by transparent huge pages.
+ */
+#define AERON_CNC_HUGE_PAGES_ENV_VAR "AERON_CNC_HUGE_PAGES"
+
+/**
+ * Number of pre-created and pre-faulted logs kept ready for each of the term buffer length and the IPC term buffer
+ * length so publications and images of those lengths do not map and fault their logs on the conductor thread.
+ * 0 disables the pool.
+ */
+#define AERON_RAW_LOG_POOL_DEPTH_ENV_VAR "AERON_RAW_LOG_POOL_DEPTH"
+
+/**
+ * Should term buffers be cleaned by a dedicated low priority agent rather than inline on the conductor. Limits given
+ * to publishers and senders are then held back to what the cleaner has actually zeroed.
+ */
+#define AERON_TERM_CLEANER_DEDICATED_ENV_VAR "AERON_TERM_CLEANER_DEDICATED"
+
+/**
+ * Should term buffers be cleaned with non-temporal stores so cleaning does not evict the working set from cache.
+ */
+#define AERON_TERM_CLEANER_NON_TEMPORAL_STORES_ENV_VAR "AERON_TERM_CLEANER_NON_TEMPORAL_STORES"
+
+/**
+ * Idle strategy to be employed by the term cleaner agent when aeron.term.cleaner.dedicated is set.
+ */
+#define AERON_TERM_CLEANER_IDLE_STRATEGY_ENV_VAR "AERON_TERM_CLEANER_IDLE_STRATEGY"
+
 #define AERON_IPC_CHANNEL "aeron:ipc"
 #define AERON_IPC_CHANNEL_LEN strlen(AERON_IPC_CHANNEL)
 #define AERON_SPY_PREFIX "aeron-spy:"
@@ -331,6 +604,13 @@ int64_t aeron_nano_clock();
  */
 int64_t aeron_epoch_clock();
 
+/**
+ * Return time in nanoseconds since epoch. Is wall clock time, as used for kernel receive timestamps.
+ *
+ * @return nanoseconds since epoch.
+ */
+int64_t aeron_epoch_nano_clock();
+
 /**
  * Function to return logging information.
  */
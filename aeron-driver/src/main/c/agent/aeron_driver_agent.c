@@ -34,6 +34,7 @@
 #include <inttypes.h>
 #include <stdarg.h>
 #include "agent/aeron_driver_agent.h"
+#include "agent/aeron_driver_agent_capture.h"
 #include "aeron_driver_context.h"
 #include "aeron_driver_agent.h"
 #include "util/aeron_dlopen.h"
@@ -121,6 +122,15 @@ static void initialize_agent_logging()
         }
     }
 
+    if (aeron_driver_agent_capture_init() < 0)
+    {
+        fprintf(stderr, "could not start capture: %s. exiting.\n", aeron_errmsg());
+        exit(EXIT_FAILURE);
+    }
+
+    /* by exit the driver has been closed and its threads joined, so nothing is captured while the ring drains */
+    atexit(aeron_driver_agent_capture_close);
+
     if (receive_loss_rate_str)
     {
         receive_data_loss_rate = strtod(receive_loss_rate_str, NULL);
@@ -174,10 +184,13 @@ int aeron_driver_agent_map_raw_log_interceptor(
     aeron_mapped_raw_log_t *mapped_raw_log,
     const char *path,
     bool use_sparse_files,
+    bool use_huge_pages,
     uint64_t term_length,
-    uint64_t page_size)
+    uint64_t page_size,
+    int32_t numa_node)
 {
-    int result = aeron_map_raw_log(mapped_raw_log, path, use_sparse_files, term_length, page_size);
+    int result = aeron_map_raw_log(
+        mapped_raw_log, path, use_sparse_files, use_huge_pages, term_length, page_size, numa_node);
 
     uint8_t buffer[AERON_MAX_PATH + sizeof(aeron_driver_agent_map_raw_log_op_header_t)];
     aeron_driver_agent_map_raw_log_op_header_t *hdr = (aeron_driver_agent_map_raw_log_op_header_t *)buffer;
@@ -317,6 +330,12 @@ ssize_t sendmsg(int socket, const struct msghdr *message, int flags)
 
     ssize_t result = _original_func(socket, message, flags);
 
+    if (result > 0 && aeron_driver_agent_capture_is_enabled())
+    {
+        aeron_driver_agent_capture_frame(
+            AERON_CAPTURE_FRAME_OUT, socket, message, (size_t)result, aeron_driver_agent_capture_nano_clock());
+    }
+
     if (mask & AERON_FRAME_OUT)
     {
         aeron_driver_agent_log_frame(
@@ -346,6 +365,12 @@ ssize_t recvmsg(int socket, struct msghdr *message, int flags)
 
     if (result > 0)
     {
+        if (aeron_driver_agent_capture_is_enabled())
+        {
+            aeron_driver_agent_capture_frame(
+                AERON_CAPTURE_FRAME_IN, socket, message, (size_t)result, aeron_driver_agent_capture_nano_clock());
+        }
+
         if (receive_data_loss_rate > 0.0 && aeron_agent_should_drop_frame(message))
         {
             aeron_driver_agent_log_frame(AERON_FRAME_IN_DROPPED, socket, message, flags, (int)result, (int32_t)result);
@@ -384,6 +409,17 @@ int sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags)
 
     int result = _original_func(sockfd, msgvec, vlen, flags);
 
+    if (result > 0 && aeron_driver_agent_capture_is_enabled())
+    {
+        const int64_t time_ns = aeron_driver_agent_capture_nano_clock();
+
+        for (int i = 0; i < result; i++)
+        {
+            aeron_driver_agent_capture_frame(
+                AERON_CAPTURE_FRAME_OUT, sockfd, &msgvec[i].msg_hdr, msgvec[i].msg_len, time_ns);
+        }
+    }
+
     if (mask & AERON_FRAME_OUT)
     {
         for (int i = 0; i < result; i++)
@@ -433,6 +469,17 @@ int recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags, r
 
     int result = _original_func(sockfd, msgvec, vlen, flags, timeout);
 
+    if (result > 0 && aeron_driver_agent_capture_is_enabled())
+    {
+        const int64_t time_ns = aeron_driver_agent_capture_nano_clock();
+
+        for (int i = 0; i < result; i++)
+        {
+            aeron_driver_agent_capture_frame(
+                AERON_CAPTURE_FRAME_IN, sockfd, &msgvec[i].msg_hdr, msgvec[i].msg_len, time_ns);
+        }
+    }
+
     for (int i = 0; i < result; i++)
     {
         if (receive_data_loss_rate > 0.0 && aeron_agent_should_drop_frame(&msgvec[i].msg_hdr))
@@ -505,6 +552,12 @@ static const char *dissect_command_type_id(int64_t cmd_type_id)
         case AERON_COMMAND_REMOVE_DESTINATION:
             return "REMOVE_DESTINATION";
 
+        case AERON_COMMAND_ADD_RCV_DESTINATION:
+            return "ADD_RCV_DESTINATION";
+
+        case AERON_COMMAND_REMOVE_RCV_DESTINATION:
+            return "REMOVE_RCV_DESTINATION";
+
         default:
             return "unknown command";
     }
@@ -575,6 +628,8 @@ static const char *dissect_cmd_in(int64_t cmd_id, const void *message, size_t le
 
         case AERON_COMMAND_ADD_DESTINATION:
         case AERON_COMMAND_REMOVE_DESTINATION:
+        case AERON_COMMAND_ADD_RCV_DESTINATION:
+        case AERON_COMMAND_REMOVE_RCV_DESTINATION:
         {
             aeron_destination_command_t *command = (aeron_destination_command_t *)message;
 
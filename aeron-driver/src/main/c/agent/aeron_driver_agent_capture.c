@@ -0,0 +1,645 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "agent/aeron_driver_agent_capture.h"
+#include "concurrent/aeron_atomic.h"
+#include "concurrent/aeron_mpsc_rb.h"
+#include "concurrent/aeron_thread.h"
+#include "protocol/aeron_udp_protocol.h"
+#include "util/aeron_error.h"
+#include "util/aeron_fileutil.h"
+#include "aeron_driver_common.h"
+#include "aeron_windows.h"
+
+#define AERON_PCAP_MAGIC_NANOS (0xA1B23C4D)
+#define AERON_PCAP_VERSION_MAJOR (2)
+#define AERON_PCAP_VERSION_MINOR (4)
+#define AERON_PCAP_LINKTYPE_RAW (101)
+#define AERON_PCAP_IPV4_HEADER_LENGTH (20)
+#define AERON_PCAP_IPV6_HEADER_LENGTH (40)
+#define AERON_PCAP_UDP_HEADER_LENGTH (8)
+#define AERON_PCAP_TTL (64)
+#define AERON_PCAP_IPPROTO_UDP (17)
+
+#define AERON_CAPTURE_READ_LIMIT (1000)
+
+#pragma pack(push)
+#pragma pack(4)
+typedef struct aeron_pcap_file_header_stct
+{
+    uint32_t magic;
+    uint16_t version_major;
+    uint16_t version_minor;
+    int32_t thiszone;
+    uint32_t sigfigs;
+    uint32_t snaplen;
+    uint32_t linktype;
+}
+aeron_pcap_file_header_t;
+
+typedef struct aeron_pcap_record_header_stct
+{
+    uint32_t ts_sec;
+    uint32_t ts_nsec;
+    uint32_t incl_len;
+    uint32_t orig_len;
+}
+aeron_pcap_record_header_t;
+#pragma pack(pop)
+
+static bool capture_enabled = false;
+static aeron_mpsc_rb_t capture_rb;
+static aeron_mapped_file_t capture_rb_file = { NULL, 0 };
+static aeron_thread_t capture_thread;
+static volatile bool capture_running = false;
+
+static const char *capture_path = NULL;
+static int64_t capture_file_size = AERON_AGENT_CAPTURE_FILE_SIZE_DEFAULT;
+static int capture_file_count = AERON_AGENT_CAPTURE_FILE_COUNT_DEFAULT;
+static size_t capture_snaplen = AERON_AGENT_CAPTURE_SNAPLEN_DEFAULT;
+static int64_t capture_sample = 1;
+static int32_t capture_stream_ids[AERON_AGENT_CAPTURE_MAX_STREAM_IDS];
+static size_t capture_stream_ids_length = 0;
+
+static volatile int64_t capture_sample_count = 0;
+static volatile int64_t capture_dropped_count = 0;
+
+static FILE *capture_file = NULL;
+static int64_t capture_file_position = 0;
+static int capture_file_index = 0;
+static int64_t capture_dropped_reported = 0;
+
+int64_t aeron_driver_agent_capture_nano_clock()
+{
+    struct timespec ts;
+#if defined(AERON_COMPILER_MSVC)
+    if (aeron_clock_gettime_realtime(&ts) < 0)
+    {
+        return -1;
+    }
+#else
+    if (clock_gettime(CLOCK_REALTIME, &ts) < 0)
+    {
+        return -1;
+    }
+#endif
+    return ((int64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+bool aeron_driver_agent_capture_is_enabled()
+{
+    return capture_enabled;
+}
+
+static bool aeron_driver_agent_capture_stream_id(const uint8_t *frame, size_t length, int32_t *stream_id)
+{
+    if (length < sizeof(aeron_frame_header_t))
+    {
+        return false;
+    }
+
+    switch (((aeron_frame_header_t *)frame)->type)
+    {
+        case AERON_HDR_TYPE_DATA:
+        case AERON_HDR_TYPE_PAD:
+            if (length < sizeof(aeron_data_header_t))
+            {
+                return false;
+            }
+            *stream_id = ((aeron_data_header_t *)frame)->stream_id;
+            return true;
+
+        case AERON_HDR_TYPE_SM:
+            if (length < sizeof(aeron_status_message_header_t))
+            {
+                return false;
+            }
+            *stream_id = ((aeron_status_message_header_t *)frame)->stream_id;
+            return true;
+
+        case AERON_HDR_TYPE_NAK:
+            if (length < sizeof(aeron_nak_header_t))
+            {
+                return false;
+            }
+            *stream_id = ((aeron_nak_header_t *)frame)->stream_id;
+            return true;
+
+        case AERON_HDR_TYPE_SETUP:
+            if (length < sizeof(aeron_setup_header_t))
+            {
+                return false;
+            }
+            *stream_id = ((aeron_setup_header_t *)frame)->stream_id;
+            return true;
+
+        case AERON_HDR_TYPE_RTTM:
+            if (length < sizeof(aeron_rttm_header_t))
+            {
+                return false;
+            }
+            *stream_id = ((aeron_rttm_header_t *)frame)->stream_id;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static bool aeron_driver_agent_capture_should_capture(const struct msghdr *msghdr, size_t length)
+{
+    if (capture_stream_ids_length > 0)
+    {
+        int32_t stream_id;
+        const size_t first_length = msghdr->msg_iov[0].iov_len < length ? msghdr->msg_iov[0].iov_len : length;
+
+        if (!aeron_driver_agent_capture_stream_id(msghdr->msg_iov[0].iov_base, first_length, &stream_id))
+        {
+            return false;
+        }
+
+        bool is_selected = false;
+        for (size_t i = 0; i < capture_stream_ids_length; i++)
+        {
+            if (stream_id == capture_stream_ids[i])
+            {
+                is_selected = true;
+                break;
+            }
+        }
+
+        if (!is_selected)
+        {
+            return false;
+        }
+    }
+
+    if (capture_sample > 1)
+    {
+        int64_t count;
+        AERON_GET_AND_ADD_INT64(count, capture_sample_count, 1);
+
+        return 0 == count % capture_sample;
+    }
+
+    return true;
+}
+
+void aeron_driver_agent_capture_frame(
+    int32_t msg_type_id, int sockfd, const struct msghdr *msghdr, size_t length, int64_t time_ns)
+{
+    if (NULL == msghdr->msg_iov || 0 == msghdr->msg_iovlen ||
+        !aeron_driver_agent_capture_should_capture(msghdr, length))
+    {
+        return;
+    }
+
+    uint8_t buffer[sizeof(aeron_driver_agent_capture_header_t) +
+        sizeof(struct sockaddr_storage) + AERON_AGENT_CAPTURE_MAX_SNAPLEN];
+    aeron_driver_agent_capture_header_t *hdr = (aeron_driver_agent_capture_header_t *)buffer;
+    size_t sockaddr_len = NULL == msghdr->msg_name ? 0 : (size_t)msghdr->msg_namelen;
+
+    if (sockaddr_len > sizeof(struct sockaddr_storage))
+    {
+        sockaddr_len = sizeof(struct sockaddr_storage);
+    }
+
+    hdr->time_ns = time_ns;
+    hdr->sockfd = sockfd;
+    hdr->frame_length = (int32_t)length;
+    hdr->sockaddr_len = (int32_t)sockaddr_len;
+
+    uint8_t *ptr = buffer + sizeof(aeron_driver_agent_capture_header_t);
+    if (sockaddr_len > 0)
+    {
+        memcpy(ptr, msghdr->msg_name, sockaddr_len);
+        ptr += sockaddr_len;
+    }
+
+    size_t remaining = length < capture_snaplen ? length : capture_snaplen;
+    for (size_t i = 0; i < (size_t)msghdr->msg_iovlen && remaining > 0; i++)
+    {
+        const size_t copy_length = msghdr->msg_iov[i].iov_len < remaining ? msghdr->msg_iov[i].iov_len : remaining;
+
+        memcpy(ptr, msghdr->msg_iov[i].iov_base, copy_length);
+        ptr += copy_length;
+        remaining -= copy_length;
+    }
+
+    if (AERON_RB_SUCCESS != aeron_mpsc_rb_write(&capture_rb, msg_type_id, buffer, (size_t)(ptr - buffer)))
+    {
+        int64_t dropped;
+        AERON_GET_AND_ADD_INT64(dropped, capture_dropped_count, 1);
+    }
+}
+
+static int aeron_driver_agent_capture_rotate()
+{
+    char path[AERON_MAX_PATH];
+
+    if (NULL != capture_file)
+    {
+        fclose(capture_file);
+        capture_file = NULL;
+
+        int64_t dropped;
+        AERON_GET_VOLATILE(dropped, capture_dropped_count);
+        if (dropped != capture_dropped_reported)
+        {
+            fprintf(stderr, "capture dropped %" PRId64 " frames with the ring full\n", dropped);
+            capture_dropped_reported = dropped;
+        }
+    }
+
+    snprintf(path, sizeof(path) - 1, "%s.%d", capture_path, capture_file_index);
+    capture_file_index = (capture_file_index + 1) % capture_file_count;
+
+    if ((capture_file = fopen(path, "wb")) == NULL)
+    {
+        aeron_set_err(errno, "could not open capture file %s: %s", path, strerror(errno));
+        return -1;
+    }
+
+    aeron_pcap_file_header_t header;
+    header.magic = AERON_PCAP_MAGIC_NANOS;
+    header.version_major = AERON_PCAP_VERSION_MAJOR;
+    header.version_minor = AERON_PCAP_VERSION_MINOR;
+    header.thiszone = 0;
+    header.sigfigs = 0;
+    header.snaplen = (uint32_t)(AERON_PCAP_IPV6_HEADER_LENGTH + AERON_PCAP_UDP_HEADER_LENGTH + capture_snaplen);
+    header.linktype = AERON_PCAP_LINKTYPE_RAW;
+
+    fwrite(&header, sizeof(header), 1, capture_file);
+    capture_file_position = sizeof(header);
+
+    return 0;
+}
+
+static uint16_t aeron_driver_agent_capture_ipv4_checksum(const uint8_t *header)
+{
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < AERON_PCAP_IPV4_HEADER_LENGTH; i += 2)
+    {
+        sum += (uint32_t)((header[i] << 8) | header[i + 1]);
+    }
+
+    while (sum >> 16)
+    {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+
+    return (uint16_t)~sum;
+}
+
+/* GSO and GRO super-datagrams can be longer than the length fields hold so are clamped */
+static void aeron_driver_agent_capture_put_uint16(uint8_t *buffer, size_t length)
+{
+    const uint16_t value = length > UINT16_MAX ? UINT16_MAX : (uint16_t)length;
+
+    buffer[0] = (uint8_t)(value >> 8);
+    buffer[1] = (uint8_t)value;
+}
+
+static uint16_t aeron_driver_agent_capture_port(const struct sockaddr_storage *addr)
+{
+    if (AF_INET == addr->ss_family)
+    {
+        return ((struct sockaddr_in *)addr)->sin_port;
+    }
+    else if (AF_INET6 == addr->ss_family)
+    {
+        return ((struct sockaddr_in6 *)addr)->sin6_port;
+    }
+
+    return 0;
+}
+
+/*
+ * Addresses are looked up on this thread rather than when captured, so the local address of a socket closed in the
+ * meantime, or the peer of a connected one, comes out as zeroes.
+ */
+static size_t aeron_driver_agent_capture_ip_udp_header(
+    int32_t msg_type_id, const aeron_driver_agent_capture_header_t *hdr, const uint8_t *sockaddr, uint8_t *header)
+{
+    struct sockaddr_storage local, remote;
+    socklen_t addr_len = sizeof(local);
+
+    memset(&local, 0, sizeof(local));
+    memset(&remote, 0, sizeof(remote));
+
+    if (getsockname(hdr->sockfd, (struct sockaddr *)&local, &addr_len) < 0)
+    {
+        local.ss_family = AF_UNSPEC;
+    }
+
+    if (hdr->sockaddr_len > 0)
+    {
+        memcpy(&remote, sockaddr, (size_t)hdr->sockaddr_len);
+    }
+    else
+    {
+        addr_len = sizeof(remote);
+        if (getpeername(hdr->sockfd, (struct sockaddr *)&remote, &addr_len) < 0)
+        {
+            remote.ss_family = AF_UNSPEC;
+        }
+    }
+
+    const int family = AF_INET6 == remote.ss_family || AF_INET6 == local.ss_family ? AF_INET6 : AF_INET;
+    const bool is_out = AERON_CAPTURE_FRAME_OUT == msg_type_id;
+    const struct sockaddr_storage *src = is_out ? &local : &remote;
+    const struct sockaddr_storage *dst = is_out ? &remote : &local;
+    const size_t udp_length = AERON_PCAP_UDP_HEADER_LENGTH + (size_t)hdr->frame_length;
+    size_t ip_length;
+
+    if (AF_INET6 == family)
+    {
+        ip_length = AERON_PCAP_IPV6_HEADER_LENGTH;
+        memset(header, 0, ip_length);
+        header[0] = 0x60;
+        aeron_driver_agent_capture_put_uint16(header + 4, udp_length);
+        header[6] = AERON_PCAP_IPPROTO_UDP;
+        header[7] = AERON_PCAP_TTL;
+
+        if (AF_INET6 == src->ss_family)
+        {
+            memcpy(header + 8, &((struct sockaddr_in6 *)src)->sin6_addr, 16);
+        }
+
+        if (AF_INET6 == dst->ss_family)
+        {
+            memcpy(header + 24, &((struct sockaddr_in6 *)dst)->sin6_addr, 16);
+        }
+    }
+    else
+    {
+        ip_length = AERON_PCAP_IPV4_HEADER_LENGTH;
+        memset(header, 0, ip_length);
+        header[0] = 0x45;
+        aeron_driver_agent_capture_put_uint16(header + 2, ip_length + udp_length);
+        header[6] = 0x40;
+        header[8] = AERON_PCAP_TTL;
+        header[9] = AERON_PCAP_IPPROTO_UDP;
+
+        if (AF_INET == src->ss_family)
+        {
+            memcpy(header + 12, &((struct sockaddr_in *)src)->sin_addr, 4);
+        }
+
+        if (AF_INET == dst->ss_family)
+        {
+            memcpy(header + 16, &((struct sockaddr_in *)dst)->sin_addr, 4);
+        }
+
+        aeron_driver_agent_capture_put_uint16(header + 10, aeron_driver_agent_capture_ipv4_checksum(header));
+    }
+
+    uint8_t *udp = header + ip_length;
+    const uint16_t src_port = aeron_driver_agent_capture_port(src);
+    const uint16_t dst_port = aeron_driver_agent_capture_port(dst);
+
+    memcpy(udp, &src_port, sizeof(src_port));
+    memcpy(udp + 2, &dst_port, sizeof(dst_port));
+    aeron_driver_agent_capture_put_uint16(udp + 4, udp_length);
+    udp[6] = 0;
+    udp[7] = 0;
+
+    return ip_length + AERON_PCAP_UDP_HEADER_LENGTH;
+}
+
+static void aeron_driver_agent_capture_write(int32_t msg_type_id, const void *message, size_t length, void *clientd)
+{
+    const aeron_driver_agent_capture_header_t *hdr = (aeron_driver_agent_capture_header_t *)message;
+    const uint8_t *sockaddr = (const uint8_t *)message + sizeof(aeron_driver_agent_capture_header_t);
+    const uint8_t *frame = sockaddr + hdr->sockaddr_len;
+    const size_t captured_length = length - (size_t)(frame - (const uint8_t *)message);
+    uint8_t header[AERON_PCAP_IPV6_HEADER_LENGTH + AERON_PCAP_UDP_HEADER_LENGTH];
+
+    const size_t header_length = aeron_driver_agent_capture_ip_udp_header(msg_type_id, hdr, sockaddr, header);
+    const size_t record_length = sizeof(aeron_pcap_record_header_t) + header_length + captured_length;
+
+    if ((NULL == capture_file || capture_file_position + (int64_t)record_length > capture_file_size) &&
+        aeron_driver_agent_capture_rotate() < 0)
+    {
+        fprintf(stderr, "%s\n", aeron_errmsg());
+        return;
+    }
+
+    aeron_pcap_record_header_t record;
+    record.ts_sec = (uint32_t)(hdr->time_ns / 1000000000);
+    record.ts_nsec = (uint32_t)(hdr->time_ns % 1000000000);
+    record.incl_len = (uint32_t)(header_length + captured_length);
+    record.orig_len = (uint32_t)(header_length + (size_t)hdr->frame_length);
+
+    fwrite(&record, sizeof(record), 1, capture_file);
+    fwrite(header, header_length, 1, capture_file);
+    fwrite(frame, captured_length, 1, capture_file);
+    capture_file_position += (int64_t)record_length;
+}
+
+static void *aeron_driver_agent_capture_offload(void *arg)
+{
+    bool running;
+
+    AERON_GET_VOLATILE(running, capture_running);
+    while (running)
+    {
+        if (0 == aeron_mpsc_rb_read(&capture_rb, aeron_driver_agent_capture_write, NULL, AERON_CAPTURE_READ_LIMIT))
+        {
+            if (NULL != capture_file)
+            {
+                fflush(capture_file);
+            }
+
+            aeron_nano_sleep(1000 * 1000);
+        }
+
+        AERON_GET_VOLATILE(running, capture_running);
+    }
+
+    while (aeron_mpsc_rb_read(&capture_rb, aeron_driver_agent_capture_write, NULL, AERON_CAPTURE_READ_LIMIT) > 0)
+    {
+    }
+
+    if (NULL != capture_file)
+    {
+        fclose(capture_file);
+        capture_file = NULL;
+    }
+
+    return NULL;
+}
+
+static int aeron_driver_agent_capture_parse_stream_ids(const char *str)
+{
+    const char *ptr = str;
+
+    while ('\0' != *ptr)
+    {
+        char *end = NULL;
+
+        errno = 0;
+        long stream_id = strtol(ptr, &end, 0);
+
+        if (0 != errno || end == ptr || (',' != *end && '\0' != *end) || stream_id < INT32_MIN ||
+            stream_id > INT32_MAX)
+        {
+            aeron_set_err(EINVAL, "invalid %s: %s", AERON_AGENT_CAPTURE_STREAM_IDS_ENV_VAR, str);
+            return -1;
+        }
+
+        if (capture_stream_ids_length == AERON_AGENT_CAPTURE_MAX_STREAM_IDS)
+        {
+            aeron_set_err(
+                EINVAL, "more than %d stream ids in %s", AERON_AGENT_CAPTURE_MAX_STREAM_IDS,
+                AERON_AGENT_CAPTURE_STREAM_IDS_ENV_VAR);
+            return -1;
+        }
+
+        capture_stream_ids[capture_stream_ids_length++] = (int32_t)stream_id;
+        ptr = ',' == *end ? end + 1 : end;
+    }
+
+    return 0;
+}
+
+int aeron_driver_agent_capture_init()
+{
+    char ring_path[AERON_MAX_PATH];
+    char *value;
+
+    if ((capture_path = getenv(AERON_AGENT_CAPTURE_FILE_ENV_VAR)) == NULL)
+    {
+        return 0;
+    }
+
+    size_t buffer_length = AERON_AGENT_CAPTURE_BUFFER_LENGTH_DEFAULT;
+
+    capture_file_size = AERON_AGENT_CAPTURE_FILE_SIZE_DEFAULT;
+    capture_file_count = AERON_AGENT_CAPTURE_FILE_COUNT_DEFAULT;
+    capture_snaplen = AERON_AGENT_CAPTURE_SNAPLEN_DEFAULT;
+    capture_sample = 1;
+    capture_stream_ids_length = 0;
+    capture_sample_count = 0;
+    capture_dropped_count = 0;
+    capture_dropped_reported = 0;
+    capture_file_position = 0;
+    capture_file_index = 0;
+
+    if ((value = getenv(AERON_AGENT_CAPTURE_FILE_SIZE_ENV_VAR)))
+    {
+        capture_file_size = strtoll(value, NULL, 0);
+    }
+
+    if ((value = getenv(AERON_AGENT_CAPTURE_FILE_COUNT_ENV_VAR)))
+    {
+        capture_file_count = (int)strtol(value, NULL, 0);
+    }
+
+    if ((value = getenv(AERON_AGENT_CAPTURE_BUFFER_LENGTH_ENV_VAR)))
+    {
+        buffer_length = (size_t)strtoull(value, NULL, 0);
+    }
+
+    if ((value = getenv(AERON_AGENT_CAPTURE_SNAPLEN_ENV_VAR)))
+    {
+        capture_snaplen = (size_t)strtoull(value, NULL, 0);
+        capture_snaplen = capture_snaplen > AERON_AGENT_CAPTURE_MAX_SNAPLEN ?
+            AERON_AGENT_CAPTURE_MAX_SNAPLEN : capture_snaplen;
+    }
+
+    if ((value = getenv(AERON_AGENT_CAPTURE_SAMPLE_ENV_VAR)))
+    {
+        capture_sample = strtoll(value, NULL, 0);
+    }
+
+    if ((value = getenv(AERON_AGENT_CAPTURE_STREAM_IDS_ENV_VAR)) &&
+        aeron_driver_agent_capture_parse_stream_ids(value) < 0)
+    {
+        return -1;
+    }
+
+    if (capture_file_size <= 0 || capture_file_count <= 0 || capture_sample <= 0)
+    {
+        aeron_set_err(
+            EINVAL, "capture file size, file count and sample must be positive: %" PRId64 " %d %" PRId64,
+            capture_file_size, capture_file_count, capture_sample);
+        return -1;
+    }
+
+    if (!AERON_RB_IS_CAPACITY_VALID(buffer_length))
+    {
+        aeron_set_err(
+            EINVAL, "%s must be a power of 2: %" PRIu64, AERON_AGENT_CAPTURE_BUFFER_LENGTH_ENV_VAR,
+            (uint64_t)buffer_length);
+        return -1;
+    }
+
+    snprintf(ring_path, sizeof(ring_path) - 1, "%s.ring", capture_path);
+    remove(ring_path);
+
+    capture_rb_file.length = buffer_length + AERON_RB_TRAILER_LENGTH;
+    if (aeron_map_new_file(&capture_rb_file, ring_path, true) < 0)
+    {
+        return -1;
+    }
+
+    if (aeron_mpsc_rb_init(&capture_rb, capture_rb_file.addr, capture_rb_file.length) < 0)
+    {
+        return -1;
+    }
+
+    capture_running = true;
+    if (aeron_thread_create(&capture_thread, NULL, aeron_driver_agent_capture_offload, NULL) != 0)
+    {
+        aeron_set_err(errno, "could not start capture thread: %s", strerror(errno));
+        capture_running = false;
+        aeron_unmap(&capture_rb_file);
+        return -1;
+    }
+
+    capture_enabled = true;
+
+    return 0;
+}
+
+void aeron_driver_agent_capture_close()
+{
+    if (!capture_enabled)
+    {
+        return;
+    }
+
+    capture_enabled = false;
+    AERON_PUT_ORDERED(capture_running, false);
+    aeron_thread_join(capture_thread, NULL);
+
+    aeron_unmap(&capture_rb_file);
+    capture_rb_file.addr = NULL;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AERON_DRIVER_AGENT_CAPTURE_H
+#define AERON_DRIVER_AGENT_CAPTURE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "aeron_socket.h"
+
+/*
+ * Binary capture of the frames seen by the sendmsg, recvmsg, sendmmsg and recvmmsg interceptors. Intercepting
+ * threads copy each frame with a nanosecond timestamp into a ring mapped from <file>.ring and a capture thread writes
+ * them out as pcap, with IP and UDP headers made up from the socket addresses so the Aeron dissector of Wireshark can
+ * read it.
+ *
+ * Only what passes through those libc calls is seen, so there are limits:
+ * - frames sent and received through io_uring or AF_XDP never reach the interceptors and are not captured.
+ * - a GSO send or GRO receive is captured as the one super-datagram handed to the call, not as the datagrams on the
+ *   wire. Its IP and UDP length fields are clamped to 65535 when it is larger, so Wireshark may flag it as malformed.
+ */
+
+/**
+ * Capture file to write to, enabling capture. Written as <file>.0, <file>.1, ... up to the file count and then
+ * overwriting the oldest.
+ */
+#define AERON_AGENT_CAPTURE_FILE_ENV_VAR "AERON_EVENT_CAPTURE_FILE"
+
+/**
+ * Size in bytes at which a capture file is rotated. Default 64MB.
+ */
+#define AERON_AGENT_CAPTURE_FILE_SIZE_ENV_VAR "AERON_EVENT_CAPTURE_FILE_SIZE"
+
+/**
+ * Number of capture files to rotate through. Default 4.
+ */
+#define AERON_AGENT_CAPTURE_FILE_COUNT_ENV_VAR "AERON_EVENT_CAPTURE_FILE_COUNT"
+
+/**
+ * Length of the ring frames are captured into. Frames are dropped, and counted, when it is full. Default 16MB.
+ */
+#define AERON_AGENT_CAPTURE_BUFFER_LENGTH_ENV_VAR "AERON_EVENT_CAPTURE_BUFFER_LENGTH"
+
+/**
+ * Bytes of each frame to capture, up to AERON_AGENT_CAPTURE_MAX_SNAPLEN. Default 128 which covers the Aeron headers.
+ */
+#define AERON_AGENT_CAPTURE_SNAPLEN_ENV_VAR "AERON_EVENT_CAPTURE_SNAPLEN"
+
+/**
+ * Capture only 1 in this many frames. Default 1 for every frame.
+ */
+#define AERON_AGENT_CAPTURE_SAMPLE_ENV_VAR "AERON_EVENT_CAPTURE_SAMPLE"
+
+/**
+ * Comma separated stream ids to capture frames for, leaving out frames without a stream id. Default all frames.
+ */
+#define AERON_AGENT_CAPTURE_STREAM_IDS_ENV_VAR "AERON_EVENT_CAPTURE_STREAM_IDS"
+
+#define AERON_AGENT_CAPTURE_FILE_SIZE_DEFAULT (64 * 1024 * 1024L)
+#define AERON_AGENT_CAPTURE_FILE_COUNT_DEFAULT (4)
+#define AERON_AGENT_CAPTURE_BUFFER_LENGTH_DEFAULT (16 * 1024 * 1024)
+#define AERON_AGENT_CAPTURE_SNAPLEN_DEFAULT (128)
+#define AERON_AGENT_CAPTURE_MAX_SNAPLEN (8192)
+#define AERON_AGENT_CAPTURE_MAX_STREAM_IDS (16)
+
+#define AERON_CAPTURE_FRAME_IN (0x01)
+#define AERON_CAPTURE_FRAME_OUT (0x02)
+
+typedef struct aeron_driver_agent_capture_header_stct
+{
+    int64_t time_ns;
+    int32_t sockfd;
+    int32_t frame_length;
+    int32_t sockaddr_len;
+}
+aeron_driver_agent_capture_header_t;
+
+/**
+ * Start capturing if AERON_AGENT_CAPTURE_FILE_ENV_VAR is set.
+ *
+ * @return 0 for success and -1 for error.
+ */
+int aeron_driver_agent_capture_init();
+
+/**
+ * Stop capturing, writing out what is left in the ring and closing the capture file. Frames must no longer be
+ * captured by the time this is called.
+ */
+void aeron_driver_agent_capture_close();
+
+bool aeron_driver_agent_capture_is_enabled();
+
+int64_t aeron_driver_agent_capture_nano_clock();
+
+/**
+ * Capture a frame of the given length sent or received on the socket, subject to the sampling and stream filters.
+ */
+void aeron_driver_agent_capture_frame(
+    int32_t msg_type_id, int sockfd, const struct msghdr *msghdr, size_t length, int64_t time_ns);
+
+#endif //AERON_DRIVER_AGENT_CAPTURE_H
@@ -31,6 +31,8 @@
 #define AERON_COMMAND_ADD_COUNTER (0x09)
 #define AERON_COMMAND_REMOVE_COUNTER (0x0A)
 #define AERON_COMMAND_CLIENT_CLOSE (0x0B)
+#define AERON_COMMAND_ADD_RCV_DESTINATION (0x0C)
+#define AERON_COMMAND_REMOVE_RCV_DESTINATION (0x0D)
 
 #define AERON_RESPONSE_ON_ERROR (0x0F01)
 #define AERON_RESPONSE_ON_AVAILABLE_IMAGE (0x0F02)
@@ -154,6 +154,12 @@ inline int64_t aeron_counter_add_ordered(volatile int64_t *addr, int64_t value)
     return current;
 }
 
+/* Counters updated by more than one agent need the atomic add, those with a single writer can take the ordered put. */
+inline int64_t aeron_counter_shared_increment(volatile int64_t *addr, int64_t value, bool is_shared)
+{
+    return is_shared ? aeron_counter_increment(addr, value) : aeron_counter_ordered_increment(addr, value);
+}
+
 inline bool aeron_counter_propose_max_ordered(volatile int64_t *addr, int64_t proposed_value)
 {
     bool updated = false;
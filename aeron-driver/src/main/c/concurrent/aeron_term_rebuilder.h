@@ -32,21 +32,30 @@ typedef struct aeron_data_header_as_longs_stct
 aeron_data_header_as_longs_t;
 #pragma pack(pop)
 
-inline void aeron_term_rebuilder_insert(uint8_t *dest, const uint8_t *src, size_t length)
+/*
+ * Complete a frame whose payload is already in place at dest, the frame length going last so readers never see it
+ * partially written.
+ */
+inline void aeron_term_rebuilder_insert_header(uint8_t *dest, const uint8_t *src)
 {
-    aeron_data_header_t *hdr_dest = (aeron_data_header_t *)dest;
     aeron_data_header_as_longs_t *dest_hdr_as_longs = (aeron_data_header_as_longs_t *)dest;
     aeron_data_header_as_longs_t *src_hdr_as_longs = (aeron_data_header_as_longs_t *)src;
 
+    dest_hdr_as_longs->hdr[3] = src_hdr_as_longs->hdr[3];
+    dest_hdr_as_longs->hdr[2] = src_hdr_as_longs->hdr[2];
+    dest_hdr_as_longs->hdr[1] = src_hdr_as_longs->hdr[1];
+
+    AERON_PUT_ORDERED(dest_hdr_as_longs->hdr[0], src_hdr_as_longs->hdr[0]);
+}
+
+inline void aeron_term_rebuilder_insert(uint8_t *dest, const uint8_t *src, size_t length)
+{
+    aeron_data_header_t *hdr_dest = (aeron_data_header_t *)dest;
+
     if (0 == hdr_dest->frame_header.frame_length)
     {
         memcpy(dest + AERON_DATA_HEADER_LENGTH, src + AERON_DATA_HEADER_LENGTH, length - AERON_DATA_HEADER_LENGTH);
-
-        dest_hdr_as_longs->hdr[3] = src_hdr_as_longs->hdr[3];
-        dest_hdr_as_longs->hdr[2] = src_hdr_as_longs->hdr[2];
-        dest_hdr_as_longs->hdr[1] = src_hdr_as_longs->hdr[1];
-
-        AERON_PUT_ORDERED(dest_hdr_as_longs->hdr[0], src_hdr_as_longs->hdr[0]);
+        aeron_term_rebuilder_insert_header(dest, src);
     }
 }
 
@@ -14,8 +14,19 @@
  * limitations under the License.
  */
 
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <stdio.h>
 #include "concurrent/aeron_thread.h"
 
+#if defined(__linux__)
+#include <dirent.h>
+#endif
+
 void aeron_nano_sleep(size_t nanoseconds)
 {
 #ifdef AERON_COMPILER_MSVC
@@ -37,7 +48,13 @@ void aeron_nano_sleep(size_t nanoseconds)
     WaitForSingleObject(timer, INFINITE);
     CloseHandle(timer);
 #else
-    nanosleep(&(struct timespec) { .tv_nsec = 1 }, NULL);
+    struct timespec ts =
+        {
+            .tv_sec = (time_t)(nanoseconds / (1000 * 1000 * 1000)),
+            .tv_nsec = (long)(nanoseconds % (1000 * 1000 * 1000))
+        };
+
+    nanosleep(&ts, NULL);
 #endif
 }
 
@@ -169,4 +186,96 @@ void proc_yield()
 #error Unsupported platform!
 #endif
 
+bool aeron_cpu_set_is_empty(const aeron_cpu_set_t *cpu_set)
+{
+    for (size_t i = 0; i < AERON_CPU_SET_MAX_CPUS / 64; i++)
+    {
+        if (0 != cpu_set->mask[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int aeron_thread_attr_set_affinity(pthread_attr_t *attr, const aeron_cpu_set_t *cpu_set)
+{
+#if defined(__linux__)
+    cpu_set_t linux_cpu_set;
+
+    CPU_ZERO(&linux_cpu_set);
+    for (size_t cpu = 0; cpu < AERON_CPU_SET_MAX_CPUS; cpu++)
+    {
+        if (aeron_cpu_set_is_set(cpu_set, cpu))
+        {
+            if (cpu >= CPU_SETSIZE)
+            {
+                return EINVAL;
+            }
+
+            CPU_SET(cpu, &linux_cpu_set);
+        }
+    }
+
+    return pthread_attr_setaffinity_np(attr, sizeof(cpu_set_t), &linux_cpu_set);
+#else
+    return ENOTSUP;
+#endif
+}
+
+#if defined(__linux__)
+static int32_t aeron_cpu_numa_node(size_t cpu)
+{
+    char path[64];
+    DIR *dir;
+    struct dirent *entry;
+    int32_t numa_node = -1;
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu", cpu);
+    if ((dir = opendir(path)) == NULL)
+    {
+        return -1;
+    }
+
+    while ((entry = readdir(dir)) != NULL)
+    {
+        int node;
+
+        if (sscanf(entry->d_name, "node%d", &node) == 1)
+        {
+            numa_node = node;
+            break;
+        }
+    }
+
+    closedir(dir);
+    return numa_node;
+}
+#endif
+
+int32_t aeron_cpu_set_numa_node(const aeron_cpu_set_t *cpu_set)
+{
+    int32_t numa_node = -1;
+
+#if defined(__linux__)
+    for (size_t cpu = 0; cpu < AERON_CPU_SET_MAX_CPUS; cpu++)
+    {
+        if (aeron_cpu_set_is_set(cpu_set, cpu))
+        {
+            int32_t cpu_numa_node = aeron_cpu_numa_node(cpu);
+
+            if (cpu_numa_node < 0 || (numa_node >= 0 && cpu_numa_node != numa_node))
+            {
+                return -1;
+            }
+
+            numa_node = cpu_numa_node;
+        }
+    }
+#endif
+
+    return numa_node;
+}
 
+extern bool aeron_cpu_set_is_set(const aeron_cpu_set_t *cpu_set, size_t cpu);
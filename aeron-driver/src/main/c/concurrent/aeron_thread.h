@@ -20,6 +20,7 @@
 #include <util/aeron_platform.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 
 
 #if defined(AERON_COMPILER_GCC)
@@ -97,6 +98,27 @@
 
 void aeron_nano_sleep(size_t nanoseconds);
 
+#define AERON_CPU_SET_MAX_CPUS (1024)
+
+typedef struct aeron_cpu_set_stct
+{
+    uint64_t mask[AERON_CPU_SET_MAX_CPUS / 64];
+}
+aeron_cpu_set_t;
+
+inline bool aeron_cpu_set_is_set(const aeron_cpu_set_t *cpu_set, size_t cpu)
+{
+    return cpu < AERON_CPU_SET_MAX_CPUS && 0 != (cpu_set->mask[cpu / 64] & (UINT64_C(1) << (cpu % 64)));
+}
+
+bool aeron_cpu_set_is_empty(const aeron_cpu_set_t *cpu_set);
+
+/* returns 0 or an errno value in the manner of the pthread functions */
+int aeron_thread_attr_set_affinity(pthread_attr_t *attr, const aeron_cpu_set_t *cpu_set);
+
+/* NUMA node all CPUs of the set belong to, or -1 if the set is empty, spans nodes or it can not be determined */
+int32_t aeron_cpu_set_numa_node(const aeron_cpu_set_t *cpu_set);
+
 #if defined(AERON_COMPILER_GCC)
 
 #include <sched.h>
@@ -14,7 +14,15 @@
  * limitations under the License.
  */
 
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
 #include <inttypes.h>
 #include "aeron_socket.h"
 #include "aeron_system_counters.h"
@@ -23,8 +31,43 @@
 #include "aeron_driver_context.h"
 #include "aeron_alloc.h"
 #include "collections/aeron_int64_to_ptr_hash_map.h"
+#include "util/aeron_arrayutil.h"
 #include "media/aeron_receive_channel_endpoint.h"
 #include "aeron_driver_receiver.h"
+#include "aeron_publication_image.h"
+
+#if !defined(HAVE_STRUCT_MMSGHDR)
+struct mmsghdr
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+#endif
+
+static int aeron_receive_channel_endpoint_set_socket_options(
+    aeron_udp_channel_transport_t *transport, aeron_driver_context_t *context)
+{
+    if (context->socket_gro_enabled && aeron_udp_channel_transport_enable_gro(transport) < 0)
+    {
+        return -1;
+    }
+
+    if (AERON_RECEIVER_TIMESTAMPING_NONE != context->receiver_timestamping &&
+        aeron_udp_channel_transport_enable_timestamping(
+            transport, AERON_RECEIVER_TIMESTAMPING_HARDWARE == context->receiver_timestamping) < 0)
+    {
+        return -1;
+    }
+
+    if (context->receiver_socket_busy_poll_ns > 0 &&
+        aeron_udp_channel_transport_enable_busy_poll(
+            transport, (uint32_t)(context->receiver_socket_busy_poll_ns / 1000)) < 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
 
 int aeron_receive_channel_endpoint_create(
     aeron_receive_channel_endpoint_t **endpoint,
@@ -34,6 +77,7 @@ int aeron_receive_channel_endpoint_create(
     aeron_driver_context_t *context)
 {
     aeron_receive_channel_endpoint_t *_endpoint = NULL;
+    aeron_driver_receiver_proxy_t *receiver_proxy = aeron_driver_receiver_proxy_for_new_endpoint(context);
 
     if (aeron_alloc((void **)&_endpoint, sizeof(aeron_receive_channel_endpoint_t)) < 0)
     {
@@ -44,7 +88,7 @@ int aeron_receive_channel_endpoint_create(
     }
 
     if (aeron_data_packet_dispatcher_init(
-        &_endpoint->dispatcher, context->conductor_proxy, context->receiver_proxy->receiver) < 0)
+        &_endpoint->dispatcher, context->conductor_proxy, receiver_proxy->receiver) < 0)
     {
         return -1;
     }
@@ -62,10 +106,58 @@ int aeron_receive_channel_endpoint_create(
     _endpoint->conductor_fields.managed_resource.clientd = _endpoint;
     _endpoint->conductor_fields.managed_resource.registration_id = -1;
     _endpoint->conductor_fields.status = AERON_RECEIVE_CHANNEL_ENDPOINT_STATUS_ACTIVE;
+    _endpoint->conductor_fields.destinations.array = NULL;
+    _endpoint->conductor_fields.destinations.length = 0;
+    _endpoint->conductor_fields.destinations.capacity = 0;
     _endpoint->transport.fd = -1;
+    _endpoint->fan_out.transports = NULL;
+    _endpoint->fan_out.length = 0;
     _endpoint->channel_status.counter_id = -1;
+    _endpoint->is_manual_control_mode = channel->is_manual_control_mode;
+    _endpoint->so_rcvbuf = 0;
+    _endpoint->zero_copy_image = NULL;
+    _endpoint->recv_timestamp_ns = 0;
+
+    /* a multicast datagram goes to every socket on the port, so only unicast receives can be spread across several */
+    const bool is_fan_out = !channel->multicast &&
+        !channel->is_manual_control_mode &&
+        context->receiver_socket_fan_out > 1;
+
+    /*
+     * each receive must be exactly one datagram at a known destination, which GRO and io_uring receives are not, on
+     * the one socket, which fanned out receives are not, and be dispatched as it lands, which impaired receives are not
+     */
+    _endpoint->is_zero_copy_enabled = context->receiver_zero_copy_enabled &&
+        !channel->multicast &&
+        !channel->is_manual_control_mode &&
+        !context->socket_gro_enabled &&
+        !context->io_uring_enabled &&
+        !is_fan_out &&
+        !aeron_udp_channel_impairment_params_is_enabled(&context->data_impairment);
+
+    if (is_fan_out)
+    {
+        const size_t member_count = context->receiver_socket_fan_out - 1;
+
+        if (aeron_alloc(
+            (void **)&_endpoint->fan_out.transports, member_count * sizeof(aeron_udp_channel_transport_t)) < 0 ||
+            aeron_udp_channel_transport_init_fan_out(
+                &_endpoint->transport,
+                _endpoint->fan_out.transports,
+                member_count,
+                &channel->remote_data,
+                context->socket_rcvbuf,
+                context->socket_sndbuf,
+                context->receiver_socket_fan_out_steering) < 0)
+        {
+            aeron_receive_channel_endpoint_delete(NULL, _endpoint);
+            return -1;
+        }
 
-    if (aeron_udp_channel_transport_init(
+        _endpoint->fan_out.length = member_count;
+    }
+    /* destinations are added later, each bringing its own transport, and the smallest SO_RCVBUF then applies */
+    else if (!_endpoint->is_manual_control_mode && aeron_udp_channel_transport_init(
         &_endpoint->transport,
         &channel->remote_data,
         &channel->local_data,
@@ -78,12 +170,51 @@ int aeron_receive_channel_endpoint_create(
         return -1;
     }
 
-    if (aeron_udp_channel_transport_get_so_rcvbuf(&_endpoint->transport, &_endpoint->so_rcvbuf) < 0)
+    if (!_endpoint->is_manual_control_mode &&
+        aeron_udp_channel_transport_get_so_rcvbuf(&_endpoint->transport, &_endpoint->so_rcvbuf) < 0)
+    {
+        aeron_receive_channel_endpoint_delete(NULL, _endpoint);
+        return -1;
+    }
+
+    if (!_endpoint->is_manual_control_mode &&
+        aeron_receive_channel_endpoint_set_socket_options(&_endpoint->transport, context) < 0)
     {
         aeron_receive_channel_endpoint_delete(NULL, _endpoint);
         return -1;
     }
 
+    for (size_t i = 0; i < _endpoint->fan_out.length; i++)
+    {
+        if (aeron_receive_channel_endpoint_set_socket_options(&_endpoint->fan_out.transports[i], context) < 0)
+        {
+            aeron_receive_channel_endpoint_delete(NULL, _endpoint);
+            return -1;
+        }
+
+        _endpoint->fan_out.transports[i].dispatch_clientd = _endpoint;
+    }
+
+    const char *group_tag = aeron_uri_find_param_value(&channel->uri.params.udp.additional_params, AERON_URI_GTAG_KEY);
+    _endpoint->group_tag = 0;
+    _endpoint->has_group_tag = false;
+
+    if (NULL != group_tag)
+    {
+        char *end = NULL;
+
+        errno = 0;
+        _endpoint->group_tag = strtoll(group_tag, &end, 10);
+        if (0 != errno || end == group_tag || '\0' != *end)
+        {
+            aeron_set_err(EINVAL, "invalid %s: %s", AERON_URI_GTAG_KEY, group_tag);
+            aeron_receive_channel_endpoint_delete(NULL, _endpoint);
+            return -1;
+        }
+
+        _endpoint->has_group_tag = true;
+    }
+
     _endpoint->transport.dispatch_clientd = _endpoint;
     _endpoint->has_receiver_released = false;
 
@@ -91,9 +222,11 @@ int aeron_receive_channel_endpoint_create(
     _endpoint->channel_status.value_addr = status_indicator->value_addr;
 
     _endpoint->receiver_id = context->receiver_id;
-    _endpoint->receiver_proxy = context->receiver_proxy;
+    _endpoint->receiver_proxy = receiver_proxy;
+    receiver_proxy->endpoint_count++;
 
     _endpoint->short_sends_counter = aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_SHORT_SENDS);
+    _endpoint->has_shared_system_counters = context->receiver_count > 1;
     _endpoint->possible_ttl_asymmetry_counter =
         aeron_system_counter_addr(system_counters, AERON_SYSTEM_COUNTER_POSSIBLE_TTL_ASYMMETRY);
 
@@ -116,19 +249,62 @@ int aeron_receive_channel_endpoint_delete(
         aeron_counters_manager_free(counters_manager, (int32_t)endpoint->channel_status.counter_id);
     }
 
+    if (NULL != endpoint->receiver_proxy)
+    {
+        endpoint->receiver_proxy->endpoint_count--;
+    }
+
     aeron_int64_to_ptr_hash_map_for_each(&endpoint->stream_id_to_refcnt_map, aeron_receive_channel_endpoint_free_stream_id_refcnt, endpoint);
 
+    for (size_t i = 0, length = endpoint->destinations.length; i < length; i++)
+    {
+        aeron_receive_destination_delete(endpoint->destinations.array[i].destination);
+    }
+
+    aeron_free(endpoint->destinations.array);
+    aeron_free(endpoint->conductor_fields.destinations.array);
     aeron_int64_to_ptr_hash_map_delete(&endpoint->stream_id_to_refcnt_map);
     aeron_data_packet_dispatcher_close(&endpoint->dispatcher);
     aeron_udp_channel_delete(endpoint->conductor_fields.udp_channel);
     aeron_udp_channel_transport_close(&endpoint->transport);
+
+    for (size_t i = 0; i < endpoint->fan_out.length; i++)
+    {
+        aeron_udp_channel_transport_close(&endpoint->fan_out.transports[i]);
+    }
+
+    aeron_free(endpoint->fan_out.transports);
     aeron_free(endpoint);
     return 0;
 }
 
 int aeron_receive_channel_endpoint_sendmsg(aeron_receive_channel_endpoint_t *endpoint, struct msghdr *msghdr)
 {
-    return aeron_udp_channel_transport_sendmsg(&endpoint->transport, msghdr);
+    if (!endpoint->is_manual_control_mode)
+    {
+        return aeron_udp_channel_transport_sendmsg(&endpoint->transport, msghdr);
+    }
+
+    /* the message was addressed to whichever source the image was created from, each path has a source of its own */
+    int64_t now_ns = endpoint->receiver_proxy->receiver->cached_clock_ns;
+    int min_bytes_sent = (int)msghdr->msg_iov->iov_len;
+
+    for (size_t i = 0, length = endpoint->destinations.length; i < length; i++)
+    {
+        aeron_receive_destination_t *destination = endpoint->destinations.array[i].destination;
+
+        if (aeron_receive_destination_is_active(destination, now_ns))
+        {
+            msghdr->msg_name = &destination->current_control_addr;
+            msghdr->msg_namelen = AERON_ADDR_LEN(&destination->current_control_addr);
+
+            const int sendmsg_result = aeron_udp_channel_transport_sendmsg(&destination->transport, msghdr);
+
+            min_bytes_sent = sendmsg_result < min_bytes_sent ? sendmsg_result : min_bytes_sent;
+        }
+    }
+
+    return min_bytes_sent;
 }
 
 int aeron_receive_channel_endpoint_send_sm(
@@ -141,12 +317,13 @@ int aeron_receive_channel_endpoint_send_sm(
     int32_t receiver_window,
     uint8_t flags)
 {
-    uint8_t buffer[sizeof(aeron_status_message_header_t)];
+    uint8_t buffer[sizeof(aeron_status_message_header_t) + sizeof(aeron_status_message_optional_header_t)];
     aeron_status_message_header_t *sm_header = (aeron_status_message_header_t *) buffer;
+    const size_t frame_length = endpoint->has_group_tag ? sizeof(buffer) : sizeof(aeron_status_message_header_t);
     struct iovec iov[1];
     struct msghdr msghdr;
 
-    sm_header->frame_header.frame_length = sizeof(aeron_status_message_header_t);
+    sm_header->frame_header.frame_length = (int32_t)frame_length;
     sm_header->frame_header.version = AERON_FRAME_HEADER_VERSION;
     sm_header->frame_header.flags = flags;
     sm_header->frame_header.type = AERON_HDR_TYPE_SM;
@@ -157,8 +334,16 @@ int aeron_receive_channel_endpoint_send_sm(
     sm_header->receiver_window = receiver_window;
     sm_header->receiver_id = endpoint->receiver_id;
 
+    if (endpoint->has_group_tag)
+    {
+        aeron_status_message_optional_header_t *optional_header =
+            (aeron_status_message_optional_header_t *)(buffer + sizeof(aeron_status_message_header_t));
+
+        optional_header->group_tag = endpoint->group_tag;
+    }
+
     iov[0].iov_base = buffer;
-    iov[0].iov_len = sizeof(aeron_status_message_header_t);
+    iov[0].iov_len = frame_length;
     msghdr.msg_iov = iov;
     msghdr.msg_iovlen = 1;
     msghdr.msg_flags = 0;
@@ -272,7 +457,12 @@ int aeron_receive_channel_endpoint_send_rttm(
 }
 
 void aeron_receive_channel_endpoint_dispatch(
-    void *receiver_clientd, void *endpoint_clientd, uint8_t *buffer, size_t length, struct sockaddr_storage *addr)
+    void *receiver_clientd,
+    void *endpoint_clientd,
+    void *destination_clientd,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr)
 {
     aeron_driver_receiver_t *receiver = (aeron_driver_receiver_t *)receiver_clientd;
     aeron_frame_header_t *frame_header = (aeron_frame_header_t *)buffer;
@@ -284,6 +474,16 @@ void aeron_receive_channel_endpoint_dispatch(
         return;
     }
 
+    endpoint->recv_timestamp_ns = NULL != destination_clientd ?
+        ((aeron_receive_destination_t *)destination_clientd)->transport.recv_timestamp_ns :
+        endpoint->transport.recv_timestamp_ns;
+
+    if (NULL != destination_clientd)
+    {
+        aeron_receive_destination_on_activity(
+            (aeron_receive_destination_t *)destination_clientd, addr, receiver->cached_clock_ns);
+    }
+
     switch (frame_header->type)
     {
         case AERON_HDR_TYPE_PAD:
@@ -455,6 +655,172 @@ int aeron_receive_channel_endpoint_on_remove_publication_image(
     return aeron_data_packet_dispatcher_remove_publication_image(&endpoint->dispatcher, image);
 }
 
+void aeron_receive_channel_endpoint_set_zero_copy_image(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_publication_image_t *image)
+{
+    if (endpoint->is_zero_copy_enabled)
+    {
+        endpoint->zero_copy_image = image;
+        endpoint->transport.recvmmsg_func = NULL != image ? aeron_receive_channel_endpoint_recv_zero_copy : NULL;
+    }
+}
+
+int aeron_receive_channel_endpoint_recv_zero_copy(
+    aeron_udp_channel_transport_t *transport,
+    struct mmsghdr *msgvec,
+    size_t vlen,
+    int64_t *bytes_received,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd)
+{
+    aeron_receive_channel_endpoint_t *endpoint = (aeron_receive_channel_endpoint_t *)transport->dispatch_clientd;
+    aeron_publication_image_t *image = endpoint->zero_copy_image;
+    struct msghdr *message = &msgvec[0].msg_hdr;
+    uint8_t *buffer = (uint8_t *)message->msg_iov[0].iov_base;
+    const size_t max_target_length = message->msg_iov[0].iov_len - AERON_DATA_HEADER_LENGTH;
+    int work_count = 0;
+
+    /* where each datagram should go depends on the one before, so they are received one at a time */
+    for (size_t i = 0; i < vlen; i++)
+    {
+        size_t target_length = 0;
+        uint8_t *target = aeron_publication_image_zero_copy_target(image, max_target_length, &target_length);
+
+        int recv_result = aeron_udp_channel_transport_recv_split(
+            transport, message, AERON_DATA_HEADER_LENGTH, target, target_length);
+        if (recv_result <= 0)
+        {
+            return recv_result < 0 ? recv_result : work_count;
+        }
+
+        const size_t length = (size_t)recv_result;
+        const size_t payload_length = length > AERON_DATA_HEADER_LENGTH ? length - AERON_DATA_HEADER_LENGTH : 0;
+        const size_t landed_length = payload_length < target_length ? payload_length : target_length;
+
+        *bytes_received += length;
+        work_count++;
+
+        if (landed_length > 0)
+        {
+            endpoint->recv_timestamp_ns = transport->recv_timestamp_ns;
+
+            if (payload_length == landed_length && !(message->msg_flags & MSG_TRUNC) &&
+                aeron_publication_image_insert_in_place(image, buffer, length))
+            {
+                continue;
+            }
+
+            /* not the next data in order for the image, so put the datagram back together and leave the term clean */
+            memcpy(buffer + AERON_DATA_HEADER_LENGTH, target, landed_length);
+            memset(target, 0, landed_length);
+        }
+
+        if (message->msg_flags & MSG_TRUNC)
+        {
+            aeron_udp_channel_transport_on_truncated(transport);
+            continue;
+        }
+
+        recv_func(
+            clientd,
+            transport->dispatch_clientd,
+            transport->destination_clientd,
+            buffer,
+            length,
+            (struct sockaddr_storage *)message->msg_name);
+    }
+
+    return work_count;
+}
+
+int aeron_receive_channel_endpoint_add_destination(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_receive_destination_t *destination)
+{
+    int ensure_capacity_result = 0;
+    AERON_ARRAY_ENSURE_CAPACITY(ensure_capacity_result, endpoint->destinations, aeron_receive_destination_entry_t);
+    if (ensure_capacity_result < 0)
+    {
+        return -1;
+    }
+
+    endpoint->destinations.array[endpoint->destinations.length++].destination = destination;
+
+    return 0;
+}
+
+static bool aeron_receive_channel_endpoint_destination_matches(
+    aeron_receive_destination_t *destination, aeron_udp_channel_t *udp_channel)
+{
+    return destination->udp_channel->canonical_length == udp_channel->canonical_length &&
+        strncmp(
+            destination->udp_channel->canonical_form,
+            udp_channel->canonical_form,
+            udp_channel->canonical_length) == 0;
+}
+
+aeron_receive_destination_t *aeron_receive_channel_endpoint_remove_destination(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_udp_channel_t *udp_channel)
+{
+    for (int last_index = (int)endpoint->destinations.length - 1, i = last_index; i >= 0; i--)
+    {
+        aeron_receive_destination_t *destination = endpoint->destinations.array[i].destination;
+
+        if (aeron_receive_channel_endpoint_destination_matches(destination, udp_channel))
+        {
+            aeron_array_fast_unordered_remove(
+                (uint8_t *)endpoint->destinations.array,
+                sizeof(aeron_receive_destination_entry_t),
+                (size_t)i,
+                (size_t)last_index);
+            endpoint->destinations.length--;
+
+            return destination;
+        }
+    }
+
+    return NULL;
+}
+
+int aeron_receive_channel_endpoint_track_destination(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_receive_destination_t *destination)
+{
+    int ensure_capacity_result = 0;
+
+    AERON_ARRAY_ENSURE_CAPACITY(
+        ensure_capacity_result, endpoint->conductor_fields.destinations, aeron_receive_destination_entry_t);
+    if (ensure_capacity_result < 0)
+    {
+        return -1;
+    }
+
+    endpoint->conductor_fields.destinations.array[endpoint->conductor_fields.destinations.length++].destination =
+        destination;
+
+    return 0;
+}
+
+bool aeron_receive_channel_endpoint_forget_destination(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_udp_channel_t *udp_channel)
+{
+    for (int last_index = (int)endpoint->conductor_fields.destinations.length - 1, i = last_index; i >= 0; i--)
+    {
+        if (aeron_receive_channel_endpoint_destination_matches(
+            endpoint->conductor_fields.destinations.array[i].destination, udp_channel))
+        {
+            aeron_array_fast_unordered_remove(
+                (uint8_t *)endpoint->conductor_fields.destinations.array,
+                sizeof(aeron_receive_destination_entry_t),
+                (size_t)i,
+                (size_t)last_index);
+            endpoint->conductor_fields.destinations.length--;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
 int aeron_receiver_channel_endpoint_validate_sender_mtu_length(
     aeron_receive_channel_endpoint_t *endpoint, size_t sender_mtu_length, size_t window_max_length)
 {
@@ -20,6 +20,7 @@
 #include "aeron_data_packet_dispatcher.h"
 #include "aeron_udp_channel.h"
 #include "aeron_udp_channel_transport.h"
+#include "aeron_receive_destination.h"
 #include "concurrent/aeron_counters_manager.h"
 #include "aeron_driver_context.h"
 #include "aeron_system_counters.h"
@@ -37,6 +38,12 @@ typedef struct aeron_stream_id_refcnt_stct
 }
 aeron_stream_id_refcnt_t;
 
+typedef struct aeron_receive_destination_entry_stct
+{
+    aeron_receive_destination_t *destination;
+}
+aeron_receive_destination_entry_t;
+
 typedef struct aeron_receive_channel_endpoint_stct
 {
     struct aeron_receive_channel_endpoint_conductor_fields_stct
@@ -44,22 +51,60 @@ typedef struct aeron_receive_channel_endpoint_stct
         aeron_driver_managed_resource_t managed_resource;
         aeron_udp_channel_t *udp_channel;
         aeron_receive_channel_endpoint_status_t status;
+
+        /* the destinations added as the conductor last saw them, so removing one never added can be refused */
+        struct aeron_receive_channel_endpoint_conductor_destinations_stct
+        {
+            aeron_receive_destination_entry_t *array;
+            size_t length;
+            size_t capacity;
+        }
+        destinations;
     }
     conductor_fields;
 
     /* uint8_t conductor_fields_pad[(2 * AERON_CACHE_LINE_LENGTH) - sizeof(struct conductor_fields_stct)]; */
 
     aeron_udp_channel_transport_t transport;
+
+    /* further sockets on the port of transport for aeron.receiver.socket.fan.out, polled alongside it */
+    struct aeron_receive_channel_endpoint_fan_out_stct
+    {
+        aeron_udp_channel_transport_t *transports;
+        size_t length;
+    }
+    fan_out;
+
+    /* owned by the receiver, only a subscription in manual control mode has destinations rather than a transport */
+    struct aeron_receive_channel_endpoint_destinations_stct
+    {
+        aeron_receive_destination_entry_t *array;
+        size_t length;
+        size_t capacity;
+    }
+    destinations;
+
     aeron_data_packet_dispatcher_t dispatcher;
     aeron_int64_to_ptr_hash_map_t stream_id_to_refcnt_map;
     aeron_counter_t channel_status;
     aeron_driver_receiver_proxy_t *receiver_proxy;
     int64_t receiver_id;
+    int64_t group_tag;
     size_t so_rcvbuf;
+    bool has_group_tag;
     bool has_receiver_released;
+    bool is_manual_control_mode;
+    bool is_zero_copy_enabled;
+
+    /* owned by the receiver, the only image of the endpoint while its payloads are received straight into the log */
+    aeron_publication_image_t *zero_copy_image;
+
+    /* receive timestamp of the datagram being dispatched from whichever transport it came in on, 0 if it has none */
+    int64_t recv_timestamp_ns;
 
     int64_t *short_sends_counter;
     int64_t *possible_ttl_asymmetry_counter;
+    bool has_shared_system_counters;
 }
 aeron_receive_channel_endpoint_t;
 
@@ -104,7 +149,12 @@ int aeron_receive_channel_endpoint_send_rttm(
     bool is_reply);
 
 void aeron_receive_channel_endpoint_dispatch(
-    void *receiver_clientd, void *endpoint_clientd, uint8_t *buffer, size_t length, struct sockaddr_storage *addr);
+    void *receiver_clientd,
+    void *endpoint_clientd,
+    void *destination_clientd,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr);
 
 int aeron_receive_channel_endpoint_on_data(
     aeron_receive_channel_endpoint_t *endpoint, uint8_t *buffer, size_t length, struct sockaddr_storage *addr);
@@ -127,6 +177,39 @@ int aeron_receive_channel_endpoint_on_add_publication_image(
 int aeron_receive_channel_endpoint_on_remove_publication_image(
     aeron_receive_channel_endpoint_t *endpoint, aeron_publication_image_t *image);
 
+/*
+ * Receive payloads of image straight into its term buffers, or go back to receiving into the receiver buffers when
+ * image is NULL. Does nothing unless zero copy receives are enabled for the endpoint.
+ */
+void aeron_receive_channel_endpoint_set_zero_copy_image(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_publication_image_t *image);
+
+int aeron_receive_channel_endpoint_recv_zero_copy(
+    aeron_udp_channel_transport_t *transport,
+    struct mmsghdr *msgvec,
+    size_t vlen,
+    int64_t *bytes_received,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd);
+
+int aeron_receive_channel_endpoint_add_destination(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_receive_destination_t *destination);
+
+/*
+ * Take the destination matching udp_channel out of the endpoint, returning NULL if there is none. The caller is left
+ * to remove it from the poller and delete it.
+ */
+aeron_receive_destination_t *aeron_receive_channel_endpoint_remove_destination(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_udp_channel_t *udp_channel);
+
+/*
+ * Conductor side bookkeeping of the destinations handed to the receiver. Forgetting returns false if none matches.
+ */
+int aeron_receive_channel_endpoint_track_destination(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_receive_destination_t *destination);
+bool aeron_receive_channel_endpoint_forget_destination(
+    aeron_receive_channel_endpoint_t *endpoint, aeron_udp_channel_t *udp_channel);
+
 int aeron_receiver_channel_endpoint_validate_sender_mtu_length(
     aeron_receive_channel_endpoint_t *endpoint, size_t sender_mtu_length, size_t window_max_length);
 
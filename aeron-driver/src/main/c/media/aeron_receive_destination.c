@@ -0,0 +1,115 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+
+#include "aeron_alloc.h"
+#include "util/aeron_error.h"
+#include "media/aeron_receive_destination.h"
+
+int aeron_receive_destination_create(
+    aeron_receive_destination_t **destination,
+    aeron_udp_channel_t *channel,
+    void *endpoint,
+    aeron_driver_context_t *context)
+{
+    aeron_receive_destination_t *_destination = NULL;
+
+    if (aeron_alloc((void **)&_destination, sizeof(aeron_receive_destination_t)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "could not allocate receive_destination: %s", strerror(errcode));
+        return -1;
+    }
+
+    _destination->transport.fd = -1;
+
+    if (aeron_udp_channel_transport_init(
+        &_destination->transport,
+        &channel->remote_data,
+        &channel->local_data,
+        channel->interface_index,
+        (0 != channel->multicast_ttl) ? channel->multicast_ttl : context->multicast_ttl,
+        context->socket_rcvbuf,
+        context->socket_sndbuf) < 0)
+    {
+        aeron_receive_destination_delete(_destination);
+        return -1;
+    }
+
+    if (aeron_udp_channel_transport_get_so_rcvbuf(&_destination->transport, &_destination->so_rcvbuf) < 0)
+    {
+        aeron_receive_destination_delete(_destination);
+        return -1;
+    }
+
+    if (context->socket_gro_enabled && aeron_udp_channel_transport_enable_gro(&_destination->transport) < 0)
+    {
+        aeron_receive_destination_delete(_destination);
+        return -1;
+    }
+
+    if (AERON_RECEIVER_TIMESTAMPING_NONE != context->receiver_timestamping &&
+        aeron_udp_channel_transport_enable_timestamping(
+            &_destination->transport, AERON_RECEIVER_TIMESTAMPING_HARDWARE == context->receiver_timestamping) < 0)
+    {
+        aeron_receive_destination_delete(_destination);
+        return -1;
+    }
+
+    if (context->receiver_socket_busy_poll_ns > 0 &&
+        aeron_udp_channel_transport_enable_busy_poll(
+            &_destination->transport, (uint32_t)(context->receiver_socket_busy_poll_ns / 1000)) < 0)
+    {
+        aeron_receive_destination_delete(_destination);
+        return -1;
+    }
+
+    _destination->transport.dispatch_clientd = endpoint;
+    _destination->transport.destination_clientd = _destination;
+    _destination->udp_channel = channel;
+    _destination->time_of_last_activity_ns = context->nano_clock();
+    _destination->has_control_addr = false;
+
+    if (channel->multicast)
+    {
+        memcpy(&_destination->current_control_addr, &channel->remote_control, AERON_ADDR_LEN(&channel->remote_control));
+        _destination->has_control_addr = true;
+    }
+
+    *destination = _destination;
+    return 0;
+}
+
+void aeron_receive_destination_delete(aeron_receive_destination_t *destination)
+{
+    if (NULL != destination)
+    {
+        aeron_udp_channel_transport_close(&destination->transport);
+        aeron_udp_channel_delete(destination->udp_channel);
+        aeron_free(destination);
+    }
+}
+
+extern void aeron_receive_destination_on_activity(
+    aeron_receive_destination_t *destination, struct sockaddr_storage *addr, int64_t now_ns);
+extern bool aeron_receive_destination_is_active(aeron_receive_destination_t *destination, int64_t now_ns);
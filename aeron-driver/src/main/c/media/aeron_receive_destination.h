@@ -0,0 +1,70 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AERON_RECEIVE_DESTINATION_H
+#define AERON_RECEIVE_DESTINATION_H
+
+#include <string.h>
+
+#include "aeron_driver_context.h"
+#include "util/aeron_netutil.h"
+#include "aeron_udp_channel.h"
+#include "aeron_udp_channel_transport.h"
+
+#define AERON_RECEIVE_DESTINATION_TIMEOUT_NS (5 * 1000 * 1000 * 1000L)
+
+/*
+ * One transport of a multi-destination subscription. Control messages go back to the address data last arrived
+ * from, or to the control group for multicast, for as long as data keeps arriving on it.
+ */
+typedef struct aeron_receive_destination_stct
+{
+    aeron_udp_channel_transport_t transport;
+    aeron_udp_channel_t *udp_channel;
+    struct sockaddr_storage current_control_addr;
+    int64_t time_of_last_activity_ns;
+    size_t so_rcvbuf;
+    bool has_control_addr;
+}
+aeron_receive_destination_t;
+
+int aeron_receive_destination_create(
+    aeron_receive_destination_t **destination,
+    aeron_udp_channel_t *channel,
+    void *endpoint,
+    aeron_driver_context_t *context);
+
+void aeron_receive_destination_delete(aeron_receive_destination_t *destination);
+
+inline void aeron_receive_destination_on_activity(
+    aeron_receive_destination_t *destination, struct sockaddr_storage *addr, int64_t now_ns)
+{
+    if (!destination->udp_channel->multicast)
+    {
+        memcpy(&destination->current_control_addr, addr, AERON_ADDR_LEN(addr));
+        destination->has_control_addr = true;
+    }
+
+    destination->time_of_last_activity_ns = now_ns;
+}
+
+inline bool aeron_receive_destination_is_active(aeron_receive_destination_t *destination, int64_t now_ns)
+{
+    return destination->has_control_addr &&
+        now_ns <= (destination->time_of_last_activity_ns + AERON_RECEIVE_DESTINATION_TIMEOUT_NS);
+}
+
+#endif //AERON_RECEIVE_DESTINATION_H
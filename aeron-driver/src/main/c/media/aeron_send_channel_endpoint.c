@@ -51,6 +51,26 @@ int aeron_send_channel_endpoint_create(
         return -1;
     }
 
+    const size_t batch_capacity = AERON_SEND_CHANNEL_ENDPOINT_SEND_BATCH_CAPACITY;
+    if (aeron_alloc((void **)&_endpoint->send_batch.mmsghdrs, batch_capacity * sizeof(struct mmsghdr)) < 0 ||
+        aeron_alloc((void **)&_endpoint->send_batch.iov, batch_capacity * sizeof(struct iovec)) < 0 ||
+        aeron_alloc(
+            (void **)&_endpoint->send_batch.control, batch_capacity * AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH) < 0)
+    {
+        aeron_free(_endpoint->send_batch.mmsghdrs);
+        aeron_free(_endpoint->send_batch.iov);
+        aeron_free(_endpoint);
+        return -1;
+    }
+
+    for (size_t i = 0; i < batch_capacity; i++)
+    {
+        _endpoint->send_batch.mmsghdrs[i].msg_hdr.msg_iov = &_endpoint->send_batch.iov[i];
+        _endpoint->send_batch.mmsghdrs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    _endpoint->send_batch.length = 0;
+
     _endpoint->destination_tracker = NULL;
     if (channel->explicit_control)
     {
@@ -100,6 +120,20 @@ int aeron_send_channel_endpoint_create(
         return -1;
     }
 
+    if (context->sender_zero_copy_enabled && !context->io_uring_enabled &&
+        aeron_udp_channel_transport_enable_zero_copy(&_endpoint->transport, context->sender_zero_copy_threshold) < 0)
+    {
+        aeron_send_channel_endpoint_delete(NULL, _endpoint);
+        return -1;
+    }
+
+    if (NULL != context->xdp && !channel->multicast &&
+        aeron_udp_transport_xdp_attach_sender(context->xdp, &_endpoint->transport) < 0)
+    {
+        aeron_send_channel_endpoint_delete(NULL, _endpoint);
+        return -1;
+    }
+
     if (aeron_int64_to_ptr_hash_map_init(
         &_endpoint->publication_dispatch_map, 8, AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
     {
@@ -107,13 +141,22 @@ int aeron_send_channel_endpoint_create(
         return -1;
     }
 
+    if (aeron_int64_to_ptr_hash_map_init(
+        &_endpoint->conductor_fields.shared_publication_by_stream_id_map,
+        8,
+        AERON_INT64_TO_PTR_HASH_MAP_DEFAULT_LOAD_FACTOR) < 0)
+    {
+        aeron_send_channel_endpoint_delete(NULL, _endpoint);
+        return -1;
+    }
+
     _endpoint->transport.dispatch_clientd = _endpoint;
     _endpoint->has_sender_released = false;
 
     _endpoint->channel_status.counter_id = status_indicator->counter_id;
     _endpoint->channel_status.value_addr = status_indicator->value_addr;
 
-    _endpoint->sender_proxy = context->sender_proxy;
+    _endpoint->sender_proxy = aeron_driver_sender_proxy_for_new_endpoint(context);
 
     *endpoint = _endpoint;
     return 0;
@@ -127,6 +170,7 @@ int aeron_send_channel_endpoint_delete(aeron_counters_manager_t *counters_manage
     }
 
     aeron_int64_to_ptr_hash_map_delete(&endpoint->publication_dispatch_map);
+    aeron_int64_to_ptr_hash_map_delete(&endpoint->conductor_fields.shared_publication_by_stream_id_map);
     aeron_udp_channel_delete(endpoint->conductor_fields.udp_channel);
     aeron_udp_channel_transport_close(&endpoint->transport);
 
@@ -136,6 +180,9 @@ int aeron_send_channel_endpoint_delete(aeron_counters_manager_t *counters_manage
         aeron_free(endpoint->destination_tracker);
     }
 
+    aeron_free(endpoint->send_batch.mmsghdrs);
+    aeron_free(endpoint->send_batch.iov);
+    aeron_free(endpoint->send_batch.control);
     aeron_free(endpoint);
     return 0;
 }
@@ -182,6 +229,61 @@ int aeron_send_channel_sendmmsg(aeron_send_channel_endpoint_t *endpoint, struct
     return result;
 }
 
+int aeron_send_channel_endpoint_send_batch_add(
+    aeron_send_channel_endpoint_t *endpoint,
+    uint8_t *buffer,
+    size_t length,
+    uint16_t gso_segment_length,
+    int64_t *short_sends_counter)
+{
+    struct aeron_send_channel_endpoint_send_batch_stct *batch = &endpoint->send_batch;
+
+    if (AERON_SEND_CHANNEL_ENDPOINT_SEND_BATCH_CAPACITY == batch->length &&
+        aeron_send_channel_endpoint_send_batch_flush(endpoint, short_sends_counter) < 0)
+    {
+        return -1;
+    }
+
+    const size_t index = batch->length;
+    struct mmsghdr *mmsghdr = &batch->mmsghdrs[index];
+
+    batch->iov[index].iov_base = buffer;
+    batch->iov[index].iov_len = length;
+    mmsghdr->msg_hdr.msg_flags = 0;
+    mmsghdr->msg_hdr.msg_control = NULL;
+    mmsghdr->msg_hdr.msg_controllen = 0;
+    mmsghdr->msg_len = 0;
+
+    if (0 != gso_segment_length && aeron_udp_channel_transport_set_gso_segment_length(
+        &mmsghdr->msg_hdr, batch->control + (index * AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH), gso_segment_length) < 0)
+    {
+        return -1;
+    }
+
+    batch->length++;
+    return 0;
+}
+
+int aeron_send_channel_endpoint_send_batch_flush(aeron_send_channel_endpoint_t *endpoint, int64_t *short_sends_counter)
+{
+    const size_t vlen = endpoint->send_batch.length;
+
+    if (0 == vlen)
+    {
+        return 0;
+    }
+
+    endpoint->send_batch.length = 0;
+
+    int result = aeron_send_channel_sendmmsg(endpoint, endpoint->send_batch.mmsghdrs, vlen);
+    if (result >= 0 && (size_t)result != vlen)
+    {
+        aeron_counter_increment(short_sends_counter, 1);
+    }
+
+    return result;
+}
+
 int aeron_send_channel_sendmsg(aeron_send_channel_endpoint_t *endpoint, struct msghdr *msghdr)
 {
     int result = 0;
@@ -225,7 +327,12 @@ int aeron_send_channel_endpoint_remove_publication(
 }
 
 void aeron_send_channel_endpoint_dispatch(
-    void *sender_clientd, void *endpoint_clientd, uint8_t *buffer, size_t length, struct sockaddr_storage *addr)
+    void *sender_clientd,
+    void *endpoint_clientd,
+    void *destination_clientd,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr)
 {
     aeron_driver_sender_t *sender = (aeron_driver_sender_t *)sender_clientd;
     aeron_frame_header_t *frame_header = (aeron_frame_header_t *)buffer;
@@ -243,7 +350,8 @@ void aeron_send_channel_endpoint_dispatch(
             if (length >= sizeof(aeron_nak_header_t))
             {
                 aeron_send_channel_endpoint_on_nak(endpoint, buffer, length, addr);
-                aeron_counter_ordered_increment(sender->nak_messages_received_counter, 1);
+                aeron_counter_shared_increment(
+                    sender->nak_messages_received_counter, 1, sender->context->sender_count > 1);
             }
             else
             {
@@ -255,7 +363,8 @@ void aeron_send_channel_endpoint_dispatch(
             if (length >= sizeof(aeron_status_message_header_t))
             {
                 aeron_send_channel_endpoint_on_status_message(endpoint, buffer, length, addr);
-                aeron_counter_ordered_increment(sender->status_messages_received_counter, 1);
+                aeron_counter_shared_increment(
+                    sender->status_messages_received_counter, 1, sender->context->sender_count > 1);
             }
             else
             {
@@ -26,6 +26,8 @@
 #include "aeron_udp_destination_tracker.h"
 #include "aeron_driver_sender_proxy.h"
 
+#define AERON_SEND_CHANNEL_ENDPOINT_SEND_BATCH_CAPACITY (64)
+
 typedef enum aeron_send_channel_endpoint_status_enum
 {
     AERON_SEND_CHANNEL_ENDPOINT_STATUS_ACTIVE,
@@ -42,6 +44,7 @@ typedef struct aeron_send_channel_endpoint_stct
         bool has_reached_end_of_life;
         aeron_udp_channel_t *udp_channel;
         aeron_send_channel_endpoint_status_t status;
+        aeron_int64_to_ptr_hash_map_t shared_publication_by_stream_id_map;
     }
     conductor_fields;
 
@@ -53,6 +56,16 @@ typedef struct aeron_send_channel_endpoint_stct
     aeron_udp_destination_tracker_t *destination_tracker;
     aeron_driver_sender_proxy_t *sender_proxy;
     bool has_sender_released;
+
+    /* data staged by all publications on the endpoint in a sender duty cycle, so it leaves in one sendmmsg */
+    struct aeron_send_channel_endpoint_send_batch_stct
+    {
+        struct mmsghdr *mmsghdrs;
+        struct iovec *iov;
+        uint8_t *control;
+        size_t length;
+    }
+    send_batch;
 }
 aeron_send_channel_endpoint_t;
 
@@ -70,6 +83,20 @@ void aeron_send_channel_endpoint_decref(void *clientd);
 int aeron_send_channel_sendmmsg(aeron_send_channel_endpoint_t *endpoint, struct mmsghdr *mmsghdr, size_t vlen);
 int aeron_send_channel_sendmsg(aeron_send_channel_endpoint_t *endpoint, struct msghdr *msghdr);
 
+/*
+ * Stage length bytes at buffer to be sent on the next flush, as a single datagram or, with a non zero
+ * gso_segment_length, as a GSO message. A full batch is flushed first.
+ */
+int aeron_send_channel_endpoint_send_batch_add(
+    aeron_send_channel_endpoint_t *endpoint,
+    uint8_t *buffer,
+    size_t length,
+    uint16_t gso_segment_length,
+    int64_t *short_sends_counter);
+
+int aeron_send_channel_endpoint_send_batch_flush(
+    aeron_send_channel_endpoint_t *endpoint, int64_t *short_sends_counter);
+
 int aeron_send_channel_endpoint_add_publication(
     aeron_send_channel_endpoint_t *endpoint, aeron_network_publication_t *publication);
 
@@ -77,7 +104,12 @@ int aeron_send_channel_endpoint_remove_publication(
     aeron_send_channel_endpoint_t *endpoint, aeron_network_publication_t *publication);
 
 void aeron_send_channel_endpoint_dispatch(
-    void *sender_clientd, void *endpoint_clientd, uint8_t *buffer, size_t length, struct sockaddr_storage *addr);
+    void *sender_clientd,
+    void *endpoint_clientd,
+    void *destination_clientd,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr);
 
 void aeron_send_channel_endpoint_on_nak(
     aeron_send_channel_endpoint_t *endpoint, uint8_t *buffer, size_t length, struct sockaddr_storage *addr);
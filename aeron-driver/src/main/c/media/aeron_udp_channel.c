@@ -209,6 +209,7 @@ int aeron_udp_channel_parse(size_t uri_length, const char *uri, aeron_udp_channe
 
     _channel->explicit_control = false;
     _channel->multicast = false;
+    _channel->is_manual_control_mode = false;
 
     if (_channel->uri.type != AERON_URI_UDP)
     {
@@ -216,7 +217,16 @@ int aeron_udp_channel_parse(size_t uri_length, const char *uri, aeron_udp_channe
         goto error_cleanup;
     }
 
-    if (NULL == _channel->uri.params.udp.endpoint_key && NULL == _channel->uri.params.udp.control_key)
+    const char *control_mode =
+        aeron_uri_find_param_value(&_channel->uri.params.udp.additional_params, AERON_UDP_CHANNEL_CONTROL_MODE_KEY);
+
+    if (NULL != control_mode && strcmp(control_mode, AERON_UDP_CHANNEL_CONTROL_MODE_MANUAL_VALUE) == 0)
+    {
+        _channel->is_manual_control_mode = true;
+    }
+
+    if (NULL == _channel->uri.params.udp.endpoint_key && NULL == _channel->uri.params.udp.control_key &&
+        !_channel->is_manual_control_mode)
     {
         aeron_set_err(EINVAL, "%s", "Aeron URIs for UDP must specify an endpoint address and/or a control address");
         goto error_cleanup;
@@ -35,6 +35,7 @@ typedef struct aeron_udp_channel_stct
     uint8_t multicast_ttl;
     bool explicit_control;
     bool multicast;
+    bool is_manual_control_mode;
 }
 aeron_udp_channel_t;
 
@@ -0,0 +1,376 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "media/aeron_udp_channel_impairment.h"
+#include "util/aeron_arrayutil.h"
+#include "aeron_alloc.h"
+#include "aeron_windows.h"
+
+bool aeron_udp_channel_impairment_params_is_enabled(const aeron_udp_channel_impairment_params_t *params)
+{
+    return params->loss_rate > 0.0 ||
+        params->duplicate_rate > 0.0 ||
+        params->reorder_rate > 0.0 ||
+        params->delay_ns > 0 ||
+        params->delay_jitter_ns > 0;
+}
+
+int aeron_udp_channel_impairment_create(
+    aeron_udp_channel_impairment_t **impairment,
+    const aeron_udp_channel_impairment_params_t *params,
+    uint64_t seed,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *recv_clientd)
+{
+    aeron_udp_channel_impairment_t *_impairment = NULL;
+
+    if (aeron_alloc((void **)&_impairment, sizeof(aeron_udp_channel_impairment_t)) < 0)
+    {
+        return -1;
+    }
+
+    _impairment->params = *params;
+    _impairment->recv_func = recv_func;
+    _impairment->recv_clientd = recv_clientd;
+    _impairment->now_ns = 0;
+    _impairment->sequence = 0;
+    _impairment->delayed.array = NULL;
+    _impairment->delayed.length = 0;
+    _impairment->delayed.capacity = 0;
+    _impairment->held = NULL;
+    aeron_udp_channel_impairment_seed(_impairment, seed);
+
+    *impairment = _impairment;
+
+    return 0;
+}
+
+void aeron_udp_channel_impairment_delete(aeron_udp_channel_impairment_t *impairment)
+{
+    if (NULL != impairment)
+    {
+        for (size_t i = 0; i < impairment->delayed.length; i++)
+        {
+            aeron_free(impairment->delayed.array[i]);
+        }
+
+        aeron_free(impairment->delayed.array);
+        aeron_free(impairment->held);
+        aeron_free(impairment);
+    }
+}
+
+void aeron_udp_channel_impairment_seed(aeron_udp_channel_impairment_t *impairment, uint64_t seed)
+{
+    /* spread small and consecutive seeds, such as per shard ones, as erand48 starts off near 0 for them */
+    seed += 0x9E3779B97F4A7C15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    seed ^= seed >> 31;
+
+    impairment->xsubi[2] = (unsigned short)(seed & 0xFFFF);
+    impairment->xsubi[1] = (unsigned short)((seed >> 16) & 0xFFFF);
+    impairment->xsubi[0] = (unsigned short)((seed >> 32) & 0xFFFF);
+}
+
+static bool aeron_udp_channel_impairment_draw(aeron_udp_channel_impairment_t *impairment, double rate)
+{
+    return rate > 0.0 && aeron_erand48(impairment->xsubi) < rate;
+}
+
+static bool aeron_udp_channel_impairment_frame_before(
+    aeron_udp_channel_impairment_frame_t *lhs, aeron_udp_channel_impairment_frame_t *rhs)
+{
+    return lhs->due_ns < rhs->due_ns || (lhs->due_ns == rhs->due_ns && lhs->sequence < rhs->sequence);
+}
+
+static void aeron_udp_channel_impairment_sift_up(aeron_udp_channel_impairment_t *impairment, size_t index)
+{
+    aeron_udp_channel_impairment_frame_t **heap = impairment->delayed.array;
+    aeron_udp_channel_impairment_frame_t *frame = heap[index];
+
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+
+        if (!aeron_udp_channel_impairment_frame_before(frame, heap[parent]))
+        {
+            break;
+        }
+
+        heap[index] = heap[parent];
+        index = parent;
+    }
+
+    heap[index] = frame;
+}
+
+static void aeron_udp_channel_impairment_sift_down(aeron_udp_channel_impairment_t *impairment, size_t index)
+{
+    aeron_udp_channel_impairment_frame_t **heap = impairment->delayed.array;
+    aeron_udp_channel_impairment_frame_t *frame = heap[index];
+    const size_t length = impairment->delayed.length;
+
+    while (true)
+    {
+        size_t child = (2 * index) + 1;
+
+        if (child >= length)
+        {
+            break;
+        }
+
+        if (child + 1 < length && aeron_udp_channel_impairment_frame_before(heap[child + 1], heap[child]))
+        {
+            child++;
+        }
+
+        if (!aeron_udp_channel_impairment_frame_before(heap[child], frame))
+        {
+            break;
+        }
+
+        heap[index] = heap[child];
+        index = child;
+    }
+
+    heap[index] = frame;
+}
+
+static aeron_udp_channel_impairment_frame_t *aeron_udp_channel_impairment_frame_copy(
+    aeron_udp_channel_impairment_t *impairment,
+    void *endpoint_clientd,
+    void *destination_clientd,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr)
+{
+    aeron_udp_channel_impairment_frame_t *frame = NULL;
+
+    if (aeron_alloc((void **)&frame, sizeof(aeron_udp_channel_impairment_frame_t) + length) < 0)
+    {
+        return NULL;
+    }
+
+    frame->sequence = impairment->sequence++;
+    frame->endpoint_clientd = endpoint_clientd;
+    frame->destination_clientd = destination_clientd;
+    frame->length = length;
+    frame->buffer = (uint8_t *)frame + sizeof(aeron_udp_channel_impairment_frame_t);
+    memcpy(&frame->addr, addr, sizeof(frame->addr));
+    memcpy(frame->buffer, buffer, length);
+
+    return frame;
+}
+
+static void aeron_udp_channel_impairment_dispatch_frame(
+    aeron_udp_channel_impairment_t *impairment, aeron_udp_channel_impairment_frame_t *frame)
+{
+    impairment->recv_func(
+        impairment->recv_clientd,
+        frame->endpoint_clientd,
+        frame->destination_clientd,
+        frame->buffer,
+        frame->length,
+        &frame->addr);
+
+    aeron_free(frame);
+}
+
+static int64_t aeron_udp_channel_impairment_delay_ns(aeron_udp_channel_impairment_t *impairment)
+{
+    int64_t delay_ns = (int64_t)impairment->params.delay_ns;
+
+    if (impairment->params.delay_jitter_ns > 0)
+    {
+        delay_ns += (int64_t)(aeron_erand48(impairment->xsubi) * (double)impairment->params.delay_jitter_ns);
+    }
+
+    return delay_ns;
+}
+
+/*
+ * Delivers either a frame just polled or an already copied one, which then belongs to the queue or is freed.
+ */
+static void aeron_udp_channel_impairment_deliver(
+    aeron_udp_channel_impairment_t *impairment,
+    aeron_udp_channel_impairment_frame_t *frame,
+    void *endpoint_clientd,
+    void *destination_clientd,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr)
+{
+    const int64_t delay_ns = aeron_udp_channel_impairment_delay_ns(impairment);
+
+    if (0 == delay_ns)
+    {
+        if (NULL != frame)
+        {
+            aeron_udp_channel_impairment_dispatch_frame(impairment, frame);
+        }
+        else
+        {
+            impairment->recv_func(
+                impairment->recv_clientd, endpoint_clientd, destination_clientd, buffer, length, addr);
+        }
+
+        return;
+    }
+
+    if (NULL == frame)
+    {
+        if ((frame = aeron_udp_channel_impairment_frame_copy(
+            impairment, endpoint_clientd, destination_clientd, buffer, length, addr)) == NULL)
+        {
+            return;
+        }
+    }
+    else
+    {
+        /* a held frame goes after the one it was held for when both fall due together */
+        frame->sequence = impairment->sequence++;
+    }
+
+    int ensure_capacity_result = 0;
+    AERON_ARRAY_ENSURE_CAPACITY(ensure_capacity_result, impairment->delayed, aeron_udp_channel_impairment_frame_t *);
+    if (ensure_capacity_result < 0)
+    {
+        aeron_free(frame);
+        return;
+    }
+
+    frame->due_ns = impairment->now_ns + delay_ns;
+    impairment->delayed.array[impairment->delayed.length++] = frame;
+    aeron_udp_channel_impairment_sift_up(impairment, impairment->delayed.length - 1);
+}
+
+void aeron_udp_channel_impairment_on_recv(
+    void *clientd,
+    void *endpoint_clientd,
+    void *destination_clientd,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr)
+{
+    aeron_udp_channel_impairment_t *impairment = (aeron_udp_channel_impairment_t *)clientd;
+
+    if (aeron_udp_channel_impairment_draw(impairment, impairment->params.loss_rate))
+    {
+        return;
+    }
+
+    const int copies = aeron_udp_channel_impairment_draw(impairment, impairment->params.duplicate_rate) ? 2 : 1;
+
+    for (int i = 0; i < copies; i++)
+    {
+        if (NULL == impairment->held && aeron_udp_channel_impairment_draw(impairment, impairment->params.reorder_rate))
+        {
+            impairment->held = aeron_udp_channel_impairment_frame_copy(
+                impairment, endpoint_clientd, destination_clientd, buffer, length, addr);
+
+            if (NULL != impairment->held)
+            {
+                impairment->held->due_ns = impairment->now_ns + AERON_UDP_CHANNEL_IMPAIRMENT_REORDER_TIMEOUT_NS;
+            }
+
+            continue;
+        }
+
+        aeron_udp_channel_impairment_deliver(
+            impairment, NULL, endpoint_clientd, destination_clientd, buffer, length, addr);
+
+        if (NULL != impairment->held)
+        {
+            aeron_udp_channel_impairment_frame_t *held = impairment->held;
+
+            impairment->held = NULL;
+            aeron_udp_channel_impairment_deliver(impairment, held, NULL, NULL, NULL, 0, NULL);
+        }
+    }
+}
+
+int aeron_udp_channel_impairment_release(aeron_udp_channel_impairment_t *impairment, int64_t now_ns)
+{
+    int work_count = 0;
+
+    impairment->now_ns = now_ns;
+
+    while (impairment->delayed.length > 0 && impairment->delayed.array[0]->due_ns <= now_ns)
+    {
+        aeron_udp_channel_impairment_frame_t *frame = impairment->delayed.array[0];
+
+        if (--impairment->delayed.length > 0)
+        {
+            impairment->delayed.array[0] = impairment->delayed.array[impairment->delayed.length];
+            aeron_udp_channel_impairment_sift_down(impairment, 0);
+        }
+
+        aeron_udp_channel_impairment_dispatch_frame(impairment, frame);
+        work_count++;
+    }
+
+    if (NULL != impairment->held && impairment->held->due_ns <= now_ns)
+    {
+        aeron_udp_channel_impairment_frame_t *held = impairment->held;
+
+        impairment->held = NULL;
+        aeron_udp_channel_impairment_deliver(impairment, held, NULL, NULL, NULL, 0, NULL);
+        work_count++;
+    }
+
+    return work_count;
+}
+
+void aeron_udp_channel_impairment_remove(aeron_udp_channel_impairment_t *impairment, void *clientd)
+{
+    if (NULL != impairment->held &&
+        (clientd == impairment->held->endpoint_clientd || clientd == impairment->held->destination_clientd))
+    {
+        aeron_free(impairment->held);
+        impairment->held = NULL;
+    }
+
+    size_t length = 0;
+    for (size_t i = 0; i < impairment->delayed.length; i++)
+    {
+        aeron_udp_channel_impairment_frame_t *frame = impairment->delayed.array[i];
+
+        if (clientd == frame->endpoint_clientd || clientd == frame->destination_clientd)
+        {
+            aeron_free(frame);
+        }
+        else
+        {
+            impairment->delayed.array[length++] = frame;
+        }
+    }
+
+    impairment->delayed.length = length;
+
+    for (size_t i = length / 2; i-- > 0;)
+    {
+        aeron_udp_channel_impairment_sift_down(impairment, i);
+    }
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AERON_UDP_CHANNEL_IMPAIRMENT_H
+#define AERON_UDP_CHANNEL_IMPAIRMENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "media/aeron_udp_channel_transport.h"
+
+/* how long a frame held back to be reordered waits for a following frame before it is released anyway */
+#define AERON_UDP_CHANNEL_IMPAIRMENT_REORDER_TIMEOUT_NS (1000 * 1000L)
+
+typedef struct aeron_udp_channel_impairment_params_stct
+{
+    double loss_rate;
+    double duplicate_rate;
+    double reorder_rate;
+    uint64_t delay_ns;
+    uint64_t delay_jitter_ns;
+}
+aeron_udp_channel_impairment_params_t;
+
+typedef struct aeron_udp_channel_impairment_frame_stct
+{
+    int64_t due_ns;
+    int64_t sequence;
+    void *endpoint_clientd;
+    void *destination_clientd;
+    struct sockaddr_storage addr;
+    size_t length;
+    uint8_t *buffer;
+}
+aeron_udp_channel_impairment_frame_t;
+
+/*
+ * Simulated network impairment of the frames a sender or receiver polls, before they reach the endpoint dispatch.
+ * Frames are dropped, duplicated, held back to swap with the frame after them, and delayed, each by its own draw from
+ * a generator seeded for reproducible runs. Delayed frames are copied and dispatched from a queue ordered by due time,
+ * so jitter larger than the gap between frames reorders them too. Only for testing, and owned by a single thread.
+ */
+typedef struct aeron_udp_channel_impairment_stct
+{
+    aeron_udp_channel_impairment_params_t params;
+    aeron_udp_transport_recv_func_t recv_func;
+    void *recv_clientd;
+    unsigned short xsubi[3];
+    int64_t now_ns;
+    int64_t sequence;
+
+    struct aeron_udp_channel_impairment_delayed_stct
+    {
+        aeron_udp_channel_impairment_frame_t **array;
+        size_t length;
+        size_t capacity;
+    }
+    delayed;
+
+    aeron_udp_channel_impairment_frame_t *held;
+}
+aeron_udp_channel_impairment_t;
+
+bool aeron_udp_channel_impairment_params_is_enabled(const aeron_udp_channel_impairment_params_t *params);
+
+/**
+ * Create an impairment which passes the frames that get through on to recv_func with recv_clientd.
+ *
+ * @return 0 for success and -1 for error.
+ */
+int aeron_udp_channel_impairment_create(
+    aeron_udp_channel_impairment_t **impairment,
+    const aeron_udp_channel_impairment_params_t *params,
+    uint64_t seed,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *recv_clientd);
+
+void aeron_udp_channel_impairment_delete(aeron_udp_channel_impairment_t *impairment);
+
+void aeron_udp_channel_impairment_seed(aeron_udp_channel_impairment_t *impairment, uint64_t seed);
+
+/**
+ * Receive function to poll with in place of recv_func, with the impairment as its clientd.
+ */
+void aeron_udp_channel_impairment_on_recv(
+    void *clientd,
+    void *endpoint_clientd,
+    void *destination_clientd,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr);
+
+/**
+ * Dispatch the delayed frames now due, and a held frame nothing followed in time. Also sets the time frames polled
+ * after are delayed from.
+ *
+ * @return number of frames dispatched.
+ */
+int aeron_udp_channel_impairment_release(aeron_udp_channel_impairment_t *impairment, int64_t now_ns);
+
+/**
+ * Discard frames yet to be dispatched to an endpoint or destination, which is being removed.
+ */
+void aeron_udp_channel_impairment_remove(aeron_udp_channel_impairment_t *impairment, void *clientd);
+
+#endif //AERON_UDP_CHANNEL_IMPAIRMENT_H
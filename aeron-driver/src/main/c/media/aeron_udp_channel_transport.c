@@ -28,13 +28,36 @@
 
 #include "aeron_socket.h"
 
+#include <stddef.h>
 #include <string.h>
 #include <fcntl.h>
 #include <errno.h>
+
+#if defined(HAVE_UDP_GSO) || defined(HAVE_UDP_GRO)
+#include <netinet/udp.h>
+#endif
+
+#if defined(HAVE_MSG_ZEROCOPY)
+#include <linux/errqueue.h>
+#endif
+
+#if defined(HAVE_SO_TIMESTAMPING)
+#include <linux/net_tstamp.h>
+#endif
+
+#if defined(HAVE_REUSEPORT_CBPF)
+#include <linux/filter.h>
+#endif
+
 #include "util/aeron_error.h"
 #include "util/aeron_netutil.h"
 #include "aeron_udp_channel_transport.h"
+#include "aeron_udp_transport_uring.h"
+#include "aeron_udp_transport_xdp.h"
 #include "concurrent/aeron_thread.h"
+#include "util/aeron_arrayutil.h"
+#include "concurrent/aeron_counters_manager.h"
+#include "protocol/aeron_udp_protocol.h"
 
 #if !defined(HAVE_STRUCT_MMSGHDR)
 struct mmsghdr
@@ -44,20 +67,35 @@ struct mmsghdr
 };
 #endif
 
-int aeron_udp_channel_transport_init(
+static int aeron_udp_channel_transport_open(
     aeron_udp_channel_transport_t *transport,
     struct sockaddr_storage *bind_addr,
     struct sockaddr_storage *multicast_if_addr,
     unsigned int multicast_if_index,
     uint8_t ttl,
     size_t socket_rcvbuf,
-    size_t socket_sndbuf)
+    size_t socket_sndbuf,
+    bool reuse_port)
 {
     bool is_ipv6, is_multicast;
     struct sockaddr_in *in4 = (struct sockaddr_in *)bind_addr;
     struct sockaddr_in6 *in6 = (struct sockaddr_in6 *)bind_addr;
 
     transport->fd = -1;
+    transport->destination_clientd = NULL;
+    transport->uring = NULL;
+    transport->xdp = NULL;
+    transport->xdp_src_port = 0;
+    transport->recvmmsg_func = NULL;
+    transport->recv_timestamp_ns = 0;
+    transport->fan_out_leader = NULL;
+    transport->truncated_counter = NULL;
+    transport->zero_copy_threshold = 0;
+    transport->zero_copy_sent = 0;
+    transport->zero_copy_completed = 0;
+    transport->zero_copy_pending.array = NULL;
+    transport->zero_copy_pending.length = 0;
+    transport->zero_copy_pending.capacity = 0;
     if ((transport->fd = aeron_socket(bind_addr->ss_family, SOCK_DGRAM, 0)) < 0)
     {
         goto error;
@@ -69,6 +107,18 @@ int aeron_udp_channel_transport_init(
 
     if (!is_multicast)
     {
+#if defined(SO_REUSEPORT)
+        int reuse = 1;
+
+        if (reuse_port && setsockopt(transport->fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0)
+        {
+            int errcode = errno;
+
+            aeron_set_err(errcode, "setsockopt(SO_REUSEPORT): %s", strerror(errcode));
+            goto error;
+        }
+#endif
+
         if (bind(transport->fd, (struct sockaddr *)bind_addr, bind_addr_len) < 0)
         {
             int errcode = errno;
@@ -240,6 +290,153 @@ int aeron_udp_channel_transport_init(
         return -1;
 }
 
+int aeron_udp_channel_transport_init(
+    aeron_udp_channel_transport_t *transport,
+    struct sockaddr_storage *bind_addr,
+    struct sockaddr_storage *multicast_if_addr,
+    unsigned int multicast_if_index,
+    uint8_t ttl,
+    size_t socket_rcvbuf,
+    size_t socket_sndbuf)
+{
+    return aeron_udp_channel_transport_open(
+        transport, bind_addr, multicast_if_addr, multicast_if_index, ttl, socket_rcvbuf, socket_sndbuf, false);
+}
+
+static int aeron_udp_channel_transport_attach_steering(
+    aeron_udp_channel_transport_t *transport, aeron_udp_channel_transport_steering_t steering, size_t group_size)
+{
+    if (AERON_UDP_CHANNEL_TRANSPORT_STEERING_HASH == steering)
+    {
+        return 0;
+    }
+
+#if defined(HAVE_REUSEPORT_CBPF)
+    /*
+     * Each program returns the index of the socket, in the order they joined the group. Frames are little endian and
+     * absolute loads big endian, so types are compared byte swapped and the bytes of session ids folded together
+     * before taking the index, keeping consecutive ids apart. Frames without a session go to the leader.
+     */
+    struct sock_filter session_code[] =
+    {
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, offsetof(aeron_frame_header_t, type)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, AERON_HDR_TYPE_DATA << 8, 3, 0),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, AERON_HDR_TYPE_PAD << 8, 2, 0),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, AERON_HDR_TYPE_SETUP << 8, 1, 0),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, AERON_HDR_TYPE_RTTM << 8, 2, 11),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(aeron_data_header_t, session_id)),
+        BPF_STMT(BPF_JMP | BPF_JA, 1),
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(aeron_rttm_header_t, session_id)),
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 16),
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 8),
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, (uint32_t)group_size),
+        BPF_STMT(BPF_RET | BPF_A, 0),
+        BPF_STMT(BPF_RET | BPF_K, 0)
+    };
+    struct sock_filter cpu_code[] =
+    {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, (uint32_t)(SKF_AD_OFF + SKF_AD_CPU)),
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, (uint32_t)group_size),
+        BPF_STMT(BPF_RET | BPF_A, 0)
+    };
+    struct sock_fprog program;
+
+    if (AERON_UDP_CHANNEL_TRANSPORT_STEERING_SESSION == steering)
+    {
+        program.len = sizeof(session_code) / sizeof(session_code[0]);
+        program.filter = session_code;
+    }
+    else
+    {
+        program.len = sizeof(cpu_code) / sizeof(cpu_code[0]);
+        program.filter = cpu_code;
+    }
+
+    if (setsockopt(transport->fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "setsockopt(SO_ATTACH_REUSEPORT_CBPF): %s", strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+#else
+    aeron_set_err(ENOTSUP, "setsockopt(SO_ATTACH_REUSEPORT_CBPF): %s", strerror(ENOTSUP));
+    return -1;
+#endif
+}
+
+int aeron_udp_channel_transport_init_fan_out(
+    aeron_udp_channel_transport_t *leader,
+    aeron_udp_channel_transport_t *members,
+    size_t member_count,
+    struct sockaddr_storage *bind_addr,
+    size_t socket_rcvbuf,
+    size_t socket_sndbuf,
+    aeron_udp_channel_transport_steering_t steering)
+{
+#if defined(SO_REUSEPORT)
+    struct sockaddr_storage group_addr;
+    socklen_t group_addr_len = sizeof(group_addr);
+
+    for (size_t i = 0; i < member_count; i++)
+    {
+        members[i].fd = -1;
+        members[i].zero_copy_pending.array = NULL;
+    }
+
+    if (aeron_udp_channel_transport_open(leader, bind_addr, NULL, 0, 0, socket_rcvbuf, socket_sndbuf, true) < 0)
+    {
+        return -1;
+    }
+
+    if (getsockname(leader->fd, (struct sockaddr *)&group_addr, &group_addr_len) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "getsockname: %s", strerror(errcode));
+        goto error;
+    }
+
+    for (size_t i = 0; i < member_count; i++)
+    {
+        if (aeron_udp_channel_transport_open(
+            &members[i], &group_addr, NULL, 0, 0, socket_rcvbuf, socket_sndbuf, true) < 0)
+        {
+            goto error;
+        }
+
+        members[i].fan_out_leader = leader;
+    }
+
+    if (aeron_udp_channel_transport_attach_steering(leader, steering, member_count + 1) < 0)
+    {
+        goto error;
+    }
+
+    return 0;
+
+    error:
+        for (size_t i = 0; i < member_count; i++)
+        {
+            aeron_udp_channel_transport_close(&members[i]);
+            members[i].fd = -1;
+        }
+
+        aeron_udp_channel_transport_close(leader);
+        leader->fd = -1;
+        return -1;
+#else
+    aeron_set_err(ENOTSUP, "setsockopt(SO_REUSEPORT): %s", strerror(ENOTSUP));
+    return -1;
+#endif
+}
+
 int aeron_udp_channel_transport_close(aeron_udp_channel_transport_t *transport)
 {
     if (transport->fd != -1)
@@ -247,6 +444,9 @@ int aeron_udp_channel_transport_close(aeron_udp_channel_transport_t *transport)
         aeron_close_socket(transport->fd);
     }
 
+    aeron_free(transport->zero_copy_pending.array);
+    transport->zero_copy_pending.array = NULL;
+
     return 0;
 }
 
@@ -254,9 +454,15 @@ int aeron_udp_channel_transport_recvmmsg(
     aeron_udp_channel_transport_t *transport,
     struct mmsghdr *msgvec,
     size_t vlen,
+    int64_t *bytes_received,
     aeron_udp_transport_recv_func_t recv_func,
     void *clientd)
 {
+    if (NULL != transport->recvmmsg_func)
+    {
+        return transport->recvmmsg_func(transport, msgvec, vlen, bytes_received, recv_func, clientd);
+    }
+
 #if defined(HAVE_RECVMMSG)
     struct timespec tv = {.tv_nsec = 0, .tv_sec = 0};
 
@@ -279,17 +485,30 @@ int aeron_udp_channel_transport_recvmmsg(
     }
     else
     {
+        int work_count = 0;
+
         for (size_t i = 0, length = result; i < length; i++)
         {
-            recv_func(
-                clientd,
-                transport->dispatch_clientd,
+            *bytes_received += msgvec[i].msg_len;
+
+            if (msgvec[i].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                aeron_udp_channel_transport_on_truncated(transport);
+                work_count++;
+                continue;
+            }
+
+            work_count += aeron_udp_channel_transport_dispatch(
+                transport,
+                &msgvec[i].msg_hdr,
                 msgvec[i].msg_hdr.msg_iov[0].iov_base,
                 msgvec[i].msg_len,
-                msgvec[i].msg_hdr.msg_name);
+                msgvec[i].msg_hdr.msg_name,
+                recv_func,
+                clientd);
         }
 
-        return result;
+        return work_count;
     }
 #else
     int work_count = 0;
@@ -316,32 +535,162 @@ int aeron_udp_channel_transport_recvmmsg(
         }
 
         msgvec[i].msg_len = (unsigned int)result;
-        recv_func(
-            clientd,
-            transport->dispatch_clientd,
+        *bytes_received += msgvec[i].msg_len;
+
+        if (msgvec[i].msg_hdr.msg_flags & MSG_TRUNC)
+        {
+            aeron_udp_channel_transport_on_truncated(transport);
+            work_count++;
+            continue;
+        }
+
+        work_count += aeron_udp_channel_transport_dispatch(
+            transport,
+            &msgvec[i].msg_hdr,
             msgvec[i].msg_hdr.msg_iov[0].iov_base,
             msgvec[i].msg_len,
-            msgvec[i].msg_hdr.msg_name);
-        work_count++;
+            msgvec[i].msg_hdr.msg_name,
+            recv_func,
+            clientd);
     }
 
     return work_count;
 #endif
 }
 
+#if defined(HAVE_SO_TIMESTAMPING)
+/* software stamp first, then the legacy slot, then the NIC's raw hardware stamp, preferring the latter when set */
+static int64_t aeron_udp_channel_transport_timestamp_ns(struct cmsghdr *cmsg)
+{
+    struct timespec ts[3];
+
+    memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+    struct timespec *stamp = 0 != ts[2].tv_sec || 0 != ts[2].tv_nsec ? &ts[2] : &ts[0];
+
+    return ((int64_t)stamp->tv_sec * 1000000000) + stamp->tv_nsec;
+}
+#endif
+
+int aeron_udp_channel_transport_recv_split(
+    aeron_udp_channel_transport_t *transport,
+    struct msghdr *message,
+    size_t header_length,
+    uint8_t *target,
+    size_t target_length)
+{
+    uint8_t *buffer = (uint8_t *)message->msg_iov[0].iov_base;
+    const size_t buffer_length = message->msg_iov[0].iov_len;
+    struct iovec iov[3];
+    struct msghdr split;
+
+    iov[0].iov_base = buffer;
+    iov[0].iov_len = header_length;
+    iov[1].iov_base = target;
+    iov[1].iov_len = target_length;
+    iov[2].iov_base = buffer + header_length + target_length;
+    iov[2].iov_len = buffer_length - header_length - target_length;
+
+    split.msg_name = message->msg_name;
+    split.msg_namelen = sizeof(struct sockaddr_storage);
+    split.msg_iov = iov;
+    split.msg_iovlen = 3;
+    split.msg_control = message->msg_control;
+    split.msg_controllen = NULL != message->msg_control ? AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH : 0;
+    split.msg_flags = 0;
+
+    ssize_t result = recvmsg(transport->fd, &split, 0);
+    if (result < 0)
+    {
+        int err = errno;
+
+        if (EINTR == err || EAGAIN == err)
+        {
+            return 0;
+        }
+
+        aeron_set_err(err, "recvmsg: %s", strerror(err));
+        return -1;
+    }
+
+    message->msg_namelen = split.msg_namelen;
+    message->msg_controllen = split.msg_controllen;
+    message->msg_flags = split.msg_flags;
+    transport->recv_timestamp_ns = 0;
+
+#if defined(HAVE_SO_TIMESTAMPING)
+    if (split.msg_controllen > 0)
+    {
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&split); NULL != cmsg; cmsg = CMSG_NXTHDR(&split, cmsg))
+        {
+            if (SOL_SOCKET == cmsg->cmsg_level && SCM_TIMESTAMPING == cmsg->cmsg_type)
+            {
+                transport->recv_timestamp_ns = aeron_udp_channel_transport_timestamp_ns(cmsg);
+            }
+        }
+    }
+#endif
+
+    return (int)result;
+}
+
 int aeron_udp_channel_transport_sendmmsg(
     aeron_udp_channel_transport_t *transport,
     struct mmsghdr *msgvec,
     size_t vlen)
 {
+    if (NULL != transport->uring)
+    {
+        return aeron_udp_transport_uring_sendmmsg(transport->uring, transport, msgvec, vlen);
+    }
+
+    if (NULL != transport->xdp)
+    {
+        return aeron_udp_transport_xdp_sendmmsg(transport->xdp, transport, msgvec, vlen);
+    }
+
 #if defined(HAVE_SENDMMSG)
-    int sendmmsg_result = sendmmsg(transport->fd, msgvec, vlen, 0);
+    int flags = 0;
+
+#if defined(HAVE_MSG_ZEROCOPY)
+    if (aeron_udp_channel_transport_is_zero_copy_enabled(transport))
+    {
+        size_t total_length = 0;
+
+        for (size_t i = 0; i < vlen; i++)
+        {
+            for (size_t j = 0; j < msgvec[i].msg_hdr.msg_iovlen; j++)
+            {
+                total_length += msgvec[i].msg_hdr.msg_iov[j].iov_len;
+            }
+        }
+
+        /* pinning pages and handling the completion costs more than copying small messages */
+        flags = total_length >= transport->zero_copy_threshold * vlen ? MSG_ZEROCOPY : 0;
+    }
+#endif
+
+    int sendmmsg_result = sendmmsg(transport->fd, msgvec, vlen, flags);
+
+#if defined(HAVE_MSG_ZEROCOPY)
+    if (sendmmsg_result < 0 && ENOBUFS == errno && 0 != flags)
+    {
+        /* out of optmem for completion notifications until some are read, so copy this batch instead */
+        flags = 0;
+        sendmmsg_result = sendmmsg(transport->fd, msgvec, vlen, flags);
+    }
+#endif
+
     if (sendmmsg_result < 0)
     {
         aeron_set_err(errno, "sendmmsg: %s", strerror(errno));
         return -1;
     }
 
+    if (0 != flags)
+    {
+        transport->zero_copy_sent += (uint32_t)sendmmsg_result;
+    }
+
     return sendmmsg_result;
 #else
     int result = 0;
@@ -373,6 +722,11 @@ int aeron_udp_channel_transport_sendmsg(
     aeron_udp_channel_transport_t *transport,
     struct msghdr *message)
 {
+    if (NULL != transport->uring)
+    {
+        return aeron_udp_transport_uring_sendmsg(transport->uring, transport, message);
+    }
+
     ssize_t sendmsg_result = sendmsg(transport->fd, message, 0);
     if (sendmsg_result < 0)
     {
@@ -383,6 +737,291 @@ int aeron_udp_channel_transport_sendmsg(
     return (int)sendmsg_result;
 }
 
+int aeron_udp_channel_transport_enable_gro(aeron_udp_channel_transport_t *transport)
+{
+#if defined(HAVE_UDP_GRO)
+    int enable = 1;
+
+    if (setsockopt(transport->fd, IPPROTO_UDP, UDP_GRO, &enable, sizeof(enable)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "setsockopt(UDP_GRO): %s", strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+#else
+    aeron_set_err(ENOTSUP, "setsockopt(UDP_GRO): %s", strerror(ENOTSUP));
+    return -1;
+#endif
+}
+
+int aeron_udp_channel_transport_enable_timestamping(aeron_udp_channel_transport_t *transport, bool hardware)
+{
+#if defined(HAVE_SO_TIMESTAMPING)
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+
+    if (hardware)
+    {
+        flags |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+    }
+
+    if (setsockopt(transport->fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "setsockopt(SO_TIMESTAMPING): %s", strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+#else
+    aeron_set_err(ENOTSUP, "setsockopt(SO_TIMESTAMPING): %s", strerror(ENOTSUP));
+    return -1;
+#endif
+}
+
+int aeron_udp_channel_transport_set_gso_segment_length(
+    struct msghdr *message, uint8_t *control, uint16_t segment_length)
+{
+#if defined(HAVE_UDP_GSO)
+    memset(control, 0, CMSG_SPACE(sizeof(uint16_t)));
+    message->msg_control = control;
+    message->msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(message);
+    cmsg->cmsg_level = IPPROTO_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    memcpy(CMSG_DATA(cmsg), &segment_length, sizeof(uint16_t));
+
+    return 0;
+#else
+    aeron_set_err(ENOTSUP, "UDP_SEGMENT: %s", strerror(ENOTSUP));
+    return -1;
+#endif
+}
+
+int aeron_udp_channel_transport_dispatch(
+    aeron_udp_channel_transport_t *transport,
+    struct msghdr *message,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd)
+{
+    aeron_udp_channel_transport_t *stamped = NULL != transport->fan_out_leader ? transport->fan_out_leader : transport;
+    size_t segment_length = length;
+
+    stamped->recv_timestamp_ns = 0;
+
+#if defined(HAVE_UDP_GRO) || defined(HAVE_SO_TIMESTAMPING)
+    if (message->msg_controllen > 0)
+    {
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(message); NULL != cmsg; cmsg = CMSG_NXTHDR(message, cmsg))
+        {
+#if defined(HAVE_UDP_GRO)
+            if (IPPROTO_UDP == cmsg->cmsg_level && UDP_GRO == cmsg->cmsg_type)
+            {
+                int gso_size;
+
+                memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+                segment_length = gso_size > 0 ? (size_t)gso_size : length;
+            }
+#endif
+#if defined(HAVE_SO_TIMESTAMPING)
+            if (SOL_SOCKET == cmsg->cmsg_level && SCM_TIMESTAMPING == cmsg->cmsg_type)
+            {
+                stamped->recv_timestamp_ns = aeron_udp_channel_transport_timestamp_ns(cmsg);
+            }
+#endif
+        }
+    }
+#endif
+
+    int work_count = 0;
+    size_t offset = 0;
+
+    do
+    {
+        const size_t remaining = length - offset;
+
+        recv_func(
+            clientd,
+            transport->dispatch_clientd,
+            transport->destination_clientd,
+            buffer + offset,
+            remaining < segment_length ? remaining : segment_length,
+            addr);
+
+        offset += segment_length;
+        work_count++;
+    }
+    while (offset < length);
+
+    return work_count;
+}
+
+void aeron_udp_channel_transport_on_truncated(aeron_udp_channel_transport_t *transport)
+{
+    if (NULL != transport->truncated_counter)
+    {
+        aeron_counter_increment(transport->truncated_counter, 1);
+    }
+}
+
+int aeron_udp_channel_transport_enable_busy_poll(aeron_udp_channel_transport_t *transport, uint32_t busy_poll_us)
+{
+#if defined(HAVE_SO_BUSY_POLL)
+    int value = (int)busy_poll_us;
+
+    if (setsockopt(transport->fd, SOL_SOCKET, SO_BUSY_POLL, &value, sizeof(value)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "setsockopt(SO_BUSY_POLL): %s", strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+#else
+    aeron_set_err(ENOTSUP, "setsockopt(SO_BUSY_POLL): %s", strerror(ENOTSUP));
+    return -1;
+#endif
+}
+
+int aeron_udp_channel_transport_enable_zero_copy(aeron_udp_channel_transport_t *transport, size_t threshold)
+{
+#if defined(HAVE_MSG_ZEROCOPY) && defined(HAVE_SENDMMSG)
+    int enable = 1;
+
+    if (NULL != transport->uring)
+    {
+        aeron_set_err(ENOTSUP, "%s", "MSG_ZEROCOPY: not supported with io_uring sends");
+        return -1;
+    }
+
+    if (setsockopt(transport->fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "setsockopt(SO_ZEROCOPY): %s", strerror(errcode));
+        return -1;
+    }
+
+    transport->zero_copy_threshold = 0 == threshold ? 1 : threshold;
+    return 0;
+#else
+    aeron_set_err(ENOTSUP, "setsockopt(SO_ZEROCOPY): %s", strerror(ENOTSUP));
+    return -1;
+#endif
+}
+
+int aeron_udp_channel_transport_poll_zero_copy(aeron_udp_channel_transport_t *transport)
+{
+    int work_count = 0;
+
+#if defined(HAVE_MSG_ZEROCOPY)
+    while (transport->zero_copy_completed != transport->zero_copy_sent)
+    {
+        uint8_t control[AERON_UDP_CHANNEL_TRANSPORT_ERRQUEUE_CONTROL_LENGTH];
+        struct msghdr message;
+
+        memset(&message, 0, sizeof(message));
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        if (recvmsg(transport->fd, &message, MSG_ERRQUEUE) < 0)
+        {
+            int err = errno;
+
+            if (EAGAIN == err || EWOULDBLOCK == err || EINTR == err)
+            {
+                break;
+            }
+
+            aeron_set_err(err, "recvmsg(MSG_ERRQUEUE): %s", strerror(err));
+            return -1;
+        }
+
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); NULL != cmsg; cmsg = CMSG_NXTHDR(&message, cmsg))
+        {
+            struct sock_extended_err err;
+
+            if (!((SOL_IP == cmsg->cmsg_level && IP_RECVERR == cmsg->cmsg_type) ||
+                (SOL_IPV6 == cmsg->cmsg_level && IPV6_RECVERR == cmsg->cmsg_type)))
+            {
+                continue;
+            }
+
+            /* ZEROCOPY_COPIED in ee_code only says the kernel fell back to copying, the send still completed */
+            memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+            if (SO_EE_ORIGIN_ZEROCOPY == err.ee_origin && 0 == err.ee_errno)
+            {
+                if (aeron_udp_channel_transport_on_zero_copy_completed(transport, err.ee_info, err.ee_data) < 0)
+                {
+                    return -1;
+                }
+
+                work_count++;
+            }
+        }
+    }
+#endif
+
+    return work_count;
+}
+
+int aeron_udp_channel_transport_on_zero_copy_completed(
+    aeron_udp_channel_transport_t *transport, uint32_t lo, uint32_t hi)
+{
+    if (lo != transport->zero_copy_completed)
+    {
+        int ensure_capacity_result = 0;
+
+        AERON_ARRAY_ENSURE_CAPACITY(
+            ensure_capacity_result, transport->zero_copy_pending, aeron_udp_channel_transport_zero_copy_range_t);
+        if (ensure_capacity_result < 0)
+        {
+            return -1;
+        }
+
+        transport->zero_copy_pending.array[transport->zero_copy_pending.length].lo = lo;
+        transport->zero_copy_pending.array[transport->zero_copy_pending.length].hi = hi;
+        transport->zero_copy_pending.length++;
+        return 0;
+    }
+
+    transport->zero_copy_completed = hi + 1;
+
+    for (size_t i = 0; i < transport->zero_copy_pending.length;)
+    {
+        aeron_udp_channel_transport_zero_copy_range_t *range = &transport->zero_copy_pending.array[i];
+
+        if (range->lo == transport->zero_copy_completed)
+        {
+            transport->zero_copy_completed = range->hi + 1;
+            aeron_array_fast_unordered_remove(
+                (uint8_t *)transport->zero_copy_pending.array,
+                sizeof(aeron_udp_channel_transport_zero_copy_range_t),
+                i,
+                transport->zero_copy_pending.length - 1);
+            transport->zero_copy_pending.length--;
+
+            /* a removal can expose a range already passed over, so start again */
+            i = 0;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return 0;
+}
+
 int aeron_udp_channel_transport_get_so_rcvbuf(aeron_udp_channel_transport_t *transport, size_t *so_rcvbuf)
 {
     socklen_t len = sizeof(size_t);
@@ -397,3 +1036,8 @@ int aeron_udp_channel_transport_get_so_rcvbuf(aeron_udp_channel_transport_t *tra
 
     return 0;
 }
+
+extern bool aeron_udp_channel_transport_is_zero_copy_enabled(aeron_udp_channel_transport_t *transport);
+
+extern bool aeron_udp_channel_transport_zero_copy_has_completed(
+    aeron_udp_channel_transport_t *transport, uint32_t id);
@@ -21,14 +21,88 @@
 
 #include "aeron_driver_common.h"
 
-typedef struct aeron_udp_channel_transport_stct
+/* large enough for a UDP_SEGMENT or UDP_GRO control message alongside an SCM_TIMESTAMPING one */
+#define AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH (128)
+
+#define AERON_UDP_CHANNEL_TRANSPORT_GSO_MAX_SEGMENTS (64)
+
+/* largest UDP payload within an IPv4 datagram */
+#define AERON_UDP_CHANNEL_TRANSPORT_GSO_MAX_LENGTH (65535 - 20 - 8)
+
+/* large enough for a sock_extended_err and the offending address read from the error queue */
+#define AERON_UDP_CHANNEL_TRANSPORT_ERRQUEUE_CONTROL_LENGTH (128)
+
+typedef struct aeron_udp_transport_uring_stct aeron_udp_transport_uring_t;
+typedef struct aeron_udp_transport_xdp_stct aeron_udp_transport_xdp_t;
+typedef struct aeron_udp_channel_transport_stct aeron_udp_channel_transport_t;
+
+struct mmsghdr;
+
+typedef void (*aeron_udp_transport_recv_func_t)(void *, void *, void *, uint8_t *, size_t, struct sockaddr_storage *);
+
+typedef int (*aeron_udp_transport_recvmmsg_func_t)(
+    aeron_udp_channel_transport_t *transport,
+    struct mmsghdr *msgvec,
+    size_t vlen,
+    int64_t *bytes_received,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd);
+
+/* how the kernel picks the socket of a fan-out group for each datagram, see aeron_udp_channel_transport_init_fan_out */
+typedef enum aeron_udp_channel_transport_steering_enum
+{
+    AERON_UDP_CHANNEL_TRANSPORT_STEERING_HASH,
+    AERON_UDP_CHANNEL_TRANSPORT_STEERING_SESSION,
+    AERON_UDP_CHANNEL_TRANSPORT_STEERING_CPU,
+}
+aeron_udp_channel_transport_steering_t;
+
+typedef struct aeron_udp_channel_transport_zero_copy_range_stct
+{
+    uint32_t lo;
+    uint32_t hi;
+}
+aeron_udp_channel_transport_zero_copy_range_t;
+
+struct aeron_udp_channel_transport_stct
 {
     aeron_fd_t fd;
     void *dispatch_clientd;
-}
-aeron_udp_channel_transport_t;
+    void *destination_clientd;
+    aeron_udp_transport_uring_t *uring;
 
-struct mmsghdr;
+    /* when set, batches are framed straight into the AF_XDP socket's UMEM as if sent from xdp_src_port */
+    aeron_udp_transport_xdp_t *xdp;
+    uint16_t xdp_src_port;
+
+    /* when set, receives are done by this instead, e.g. to land payloads straight in a term buffer */
+    aeron_udp_transport_recvmmsg_func_t recvmmsg_func;
+
+    /* CLOCK_REALTIME ns the kernel or NIC stamped the datagram being dispatched with, or 0 if not timestamped */
+    int64_t recv_timestamp_ns;
+
+    /* first transport of the fan-out group this is a further socket of, which its receive timestamps go to */
+    aeron_udp_channel_transport_t *fan_out_leader;
+
+    /* when set, counts the datagrams dropped for being larger than the buffer they were received into */
+    int64_t *truncated_counter;
+
+    /*
+     * MSG_ZEROCOPY sends leave the kernel referencing the buffers until it reports them complete on the error queue.
+     * The kernel numbers each zero-copy send on the socket in turn, so zero_copy_completed is the first number not yet
+     * known to be complete and zero_copy_pending holds any ranges reported out of order beyond it.
+     */
+    size_t zero_copy_threshold;
+    uint32_t zero_copy_sent;
+    uint32_t zero_copy_completed;
+    struct zero_copy_pending_stct
+    {
+        aeron_udp_channel_transport_zero_copy_range_t *array;
+        size_t length;
+        size_t capacity;
+    }
+    zero_copy_pending;
+};
 
 int aeron_udp_channel_transport_init(
     aeron_udp_channel_transport_t *transport,
@@ -39,17 +113,51 @@ int aeron_udp_channel_transport_init(
     size_t socket_rcvbuf,
     size_t socket_sndbuf);
 
-int aeron_udp_channel_transport_close(aeron_udp_channel_transport_t *transport);
+/**
+ * Open a group of unicast receive sockets all bound to bind_addr with SO_REUSEPORT, so the kernel spreads the datagrams
+ * arriving for it, and the receive processing of them, across the group. The leader is bound first and the members to
+ * the same port, which may be ephemeral. Members record receive timestamps on the leader.
+ *
+ * @param steering to pick the socket of each datagram by. HASH leaves it to the kernel hash of the addresses and ports,
+ * SESSION picks by the session id of the frame so each session stays on one socket, and CPU by the CPU the datagram
+ * is received on, which with the receive queues of the NIC each bound to a CPU spreads the group across the queues.
+ * @return 0 for success and -1 for error, leaving none of the sockets open.
+ */
+int aeron_udp_channel_transport_init_fan_out(
+    aeron_udp_channel_transport_t *leader,
+    aeron_udp_channel_transport_t *members,
+    size_t member_count,
+    struct sockaddr_storage *bind_addr,
+    size_t socket_rcvbuf,
+    size_t socket_sndbuf,
+    aeron_udp_channel_transport_steering_t steering);
 
-typedef void (*aeron_udp_transport_recv_func_t)(void *, void *, uint8_t *, size_t, struct sockaddr_storage *);
+int aeron_udp_channel_transport_close(aeron_udp_channel_transport_t *transport);
 
 int aeron_udp_channel_transport_recvmmsg(
     aeron_udp_channel_transport_t *transport,
     struct mmsghdr *msgvec,
     size_t vlen,
+    int64_t *bytes_received,
     aeron_udp_transport_recv_func_t recv_func,
     void *clientd);
 
+/**
+ * Receive a single datagram, scattering it so the first header_length bytes land at the front of the message buffer,
+ * the next target_length straight into target, and anything beyond that in the buffer just after where those would
+ * have been. Copying what landed in target back to buffer + header_length therefore rebuilds the datagram in place.
+ *
+ * @param message with a single buffer of at least header_length + target_length bytes and the address to fill in, and
+ * optionally AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH bytes of control to read the receive timestamp with.
+ * @return bytes received, 0 if there was nothing to receive, or -1 on error.
+ */
+int aeron_udp_channel_transport_recv_split(
+    aeron_udp_channel_transport_t *transport,
+    struct msghdr *message,
+    size_t header_length,
+    uint8_t *target,
+    size_t target_length);
+
 int aeron_udp_channel_transport_sendmmsg(
     aeron_udp_channel_transport_t *transport,
     struct mmsghdr *msgvec,
@@ -59,6 +167,97 @@ int aeron_udp_channel_transport_sendmsg(
     aeron_udp_channel_transport_t *transport,
     struct msghdr *message);
 
+/**
+ * Enable UDP_GRO so the kernel may coalesce consecutive datagrams of the same flow into a single receive.
+ */
+int aeron_udp_channel_transport_enable_gro(aeron_udp_channel_transport_t *transport);
+
+/**
+ * Enable SO_TIMESTAMPING so each datagram received comes with the time it arrived, which is then available as
+ * recv_timestamp_ns while it is dispatched. Hardware timestamps are taken by the NIC, which needs RX timestamping
+ * enabled on it and its clock kept in step with CLOCK_REALTIME, e.g. by phc2sys. Software ones are used otherwise.
+ *
+ * @param hardware to prefer timestamps taken by the NIC.
+ * @return 0 for success and -1 if timestamping is not supported on this platform.
+ */
+int aeron_udp_channel_transport_enable_timestamping(aeron_udp_channel_transport_t *transport, bool hardware);
+
+/**
+ * Set SO_BUSY_POLL so receives poll the device queue for up to busy_poll_us when the socket has nothing waiting,
+ * rather than waiting on the interrupt. Raising it above net.core.busy_read needs CAP_NET_ADMIN.
+ *
+ * @return 0 for success and -1 if busy polling is not supported on this platform or not permitted.
+ */
+int aeron_udp_channel_transport_enable_busy_poll(aeron_udp_channel_transport_t *transport, uint32_t busy_poll_us);
+
+/**
+ * Attach a UDP_SEGMENT control message so the payload of the message is sent as datagrams of segment_length, with
+ * the last possibly being shorter.
+ *
+ * @param message to attach the control message to.
+ * @param control buffer of at least AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH bytes to hold the control message.
+ * @param segment_length of each datagram.
+ * @return 0 for success and -1 if segmentation offload is not supported on this platform.
+ */
+int aeron_udp_channel_transport_set_gso_segment_length(
+    struct msghdr *message, uint8_t *control, uint16_t segment_length);
+
+/**
+ * Dispatch a received buffer, splitting it into datagrams when it holds a GRO coalesced receive.
+ *
+ * @param message the buffer was received with, used to find the UDP_GRO segment length and timestamp if present.
+ * @return number of datagrams dispatched.
+ */
+int aeron_udp_channel_transport_dispatch(
+    aeron_udp_channel_transport_t *transport,
+    struct msghdr *message,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd);
+
+/*
+ * A datagram larger than its buffer would be dispatched as a partial frame, so it is dropped and counted instead.
+ */
+void aeron_udp_channel_transport_on_truncated(aeron_udp_channel_transport_t *transport);
+
+/**
+ * Enable SO_ZEROCOPY and send batches with MSG_ZEROCOPY when their messages average at least threshold bytes, so
+ * the kernel reads payloads from the buffers given rather than copying them. Buffers must then be left untouched
+ * until aeron_udp_channel_transport_zero_copy_has_completed says so.
+ *
+ * @param threshold average message length in a batch for it to be sent zero-copy.
+ * @return 0 for success and -1 if zero-copy sends are not supported by this platform or kernel.
+ */
+int aeron_udp_channel_transport_enable_zero_copy(aeron_udp_channel_transport_t *transport, size_t threshold);
+
+/**
+ * Read zero-copy completions from the socket error queue, if any sends are still outstanding.
+ *
+ * @return number of completion notifications read or -1 on error.
+ */
+int aeron_udp_channel_transport_poll_zero_copy(aeron_udp_channel_transport_t *transport);
+
+/**
+ * Record the kernel has completed zero-copy sends lo to hi inclusive.
+ */
+int aeron_udp_channel_transport_on_zero_copy_completed(
+    aeron_udp_channel_transport_t *transport, uint32_t lo, uint32_t hi);
+
+inline bool aeron_udp_channel_transport_is_zero_copy_enabled(aeron_udp_channel_transport_t *transport)
+{
+    return 0 != transport->zero_copy_threshold;
+}
+
+/*
+ * Have all zero-copy sends before the one numbered id completed? Numbers wrap so compare by distance.
+ */
+inline bool aeron_udp_channel_transport_zero_copy_has_completed(aeron_udp_channel_transport_t *transport, uint32_t id)
+{
+    return (int32_t)(transport->zero_copy_completed - id) >= 0;
+}
+
 int aeron_udp_channel_transport_get_so_rcvbuf(aeron_udp_channel_transport_t *transport, size_t *so_rcvbuf);
 
 #endif //AERON_UDP_CHANNEL_TRANSPORT_H
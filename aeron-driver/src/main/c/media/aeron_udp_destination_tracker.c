@@ -19,9 +19,12 @@
 #define _GNU_SOURCE
 #endif
 
+#include <errno.h>
+
 #include "protocol/aeron_udp_protocol.h"
 #include "util/aeron_netutil.h"
 #include "util/aeron_arrayutil.h"
+#include "util/aeron_error.h"
 #include "media/aeron_udp_destination_tracker.h"
 
 #if !defined(HAVE_STRUCT_MMSGHDR)
@@ -40,6 +43,8 @@ int aeron_udp_destination_tracker_init(
     tracker->destinations.array = NULL;
     tracker->destinations.length = 0;
     tracker->destinations.capacity = 0;
+    tracker->fan_out.mmsghdrs = NULL;
+    tracker->fan_out.capacity = 0;
     tracker->is_manual_control_mode =
         timeout == AERON_UDP_DESTINATION_TRACKER_MANUAL_DESTINATION_TIMEOUT_NS ? true : false;
 
@@ -51,17 +56,14 @@ int aeron_udp_destination_tracker_close(aeron_udp_destination_tracker_t *tracker
     if (NULL != tracker)
     {
         aeron_free(tracker->destinations.array);
+        aeron_free(tracker->fan_out.mmsghdrs);
     }
 
     return 0;
 }
 
-int aeron_udp_destination_tracker_sendmmsg(
-    aeron_udp_destination_tracker_t *tracker, aeron_udp_channel_transport_t *transport, struct mmsghdr *mmsghdr, size_t vlen)
+static void aeron_udp_destination_tracker_remove_timed_out(aeron_udp_destination_tracker_t *tracker, int64_t now_ns)
 {
-    int64_t now_ns = tracker->nano_clock();
-    int min_msgs_sent = (int)vlen;
-
     for (int last_index = (int)tracker->destinations.length - 1, i = last_index; i >= 0; i--)
     {
         aeron_udp_destination_entry_t *entry = &tracker->destinations.array[i];
@@ -76,22 +78,98 @@ int aeron_udp_destination_tracker_sendmmsg(
             last_index--;
             tracker->destinations.length--;
         }
-        else
+    }
+}
+
+int aeron_udp_destination_tracker_sendmmsg(
+    aeron_udp_destination_tracker_t *tracker, aeron_udp_channel_transport_t *transport, struct mmsghdr *mmsghdr, size_t vlen)
+{
+    aeron_udp_destination_tracker_remove_timed_out(tracker, tracker->nano_clock());
+
+    const size_t destination_count = tracker->destinations.length;
+    const size_t fan_out_length = destination_count * vlen;
+
+    if (0 == fan_out_length)
+    {
+        return (int)vlen;
+    }
+
+    if (fan_out_length > tracker->fan_out.capacity)
+    {
+        if (aeron_reallocf((void **)&tracker->fan_out.mmsghdrs, fan_out_length * sizeof(struct mmsghdr)) < 0)
+        {
+            tracker->fan_out.capacity = 0;
+            aeron_set_err(ENOMEM, "could not allocate fan out of %d messages", (int)fan_out_length);
+            return -1;
+        }
+
+        tracker->fan_out.capacity = fan_out_length;
+    }
+
+    /*
+     * Each message goes to every destination before the next so a short send leaves all destinations with about the
+     * same prefix of the batch rather than starving those at the end.
+     */
+    struct mmsghdr *fan_out = tracker->fan_out.mmsghdrs;
+    for (size_t j = 0, k = 0; j < vlen; j++)
+    {
+        for (size_t i = 0; i < destination_count; i++, k++)
+        {
+            aeron_udp_destination_entry_t *entry = &tracker->destinations.array[i];
+
+            fan_out[k].msg_hdr = mmsghdr[j].msg_hdr;
+            fan_out[k].msg_hdr.msg_name = &entry->addr;
+            fan_out[k].msg_hdr.msg_namelen = AERON_ADDR_LEN(&entry->addr);
+            fan_out[k].msg_len = 0;
+        }
+    }
+
+    /*
+     * A destination failing a message only skips that entry so the others carry on. Being message major, the first
+     * entry not sent marks the shortest prefix of the batch sent to any destination, which is what is reported.
+     */
+    size_t index = 0, msgs_sent = 0, msgs_failed = 0, first_unsent = fan_out_length;
+    while (index < fan_out_length)
+    {
+        const size_t remaining = fan_out_length - index;
+        const size_t chunk_length = remaining < AERON_UDP_DESTINATION_TRACKER_FAN_OUT_MAX_VLEN ?
+            remaining : AERON_UDP_DESTINATION_TRACKER_FAN_OUT_MAX_VLEN;
+
+        const int sendmmsg_result = aeron_udp_channel_transport_sendmmsg(transport, &fan_out[index], chunk_length);
+
+        if (sendmmsg_result < 0)
         {
-            for (size_t j = 0; j < vlen; j++)
+            const int errcode = aeron_errcode();
+
+            first_unsent = index < first_unsent ? index : first_unsent;
+            msgs_failed++;
+
+            /* the socket is shared so when it has no room no destination can be sent to */
+            if (EAGAIN == errcode || EWOULDBLOCK == errcode || ENOBUFS == errcode)
             {
-                mmsghdr[j].msg_hdr.msg_name = &entry->addr;
-                mmsghdr[j].msg_hdr.msg_namelen = AERON_ADDR_LEN(&entry->addr);
-                mmsghdr[j].msg_len = 0;
+                break;
             }
 
-            const int sendmmsg_result = aeron_udp_channel_transport_sendmmsg(transport, mmsghdr, vlen);
+            index++;
+            continue;
+        }
+
+        msgs_sent += (size_t)sendmmsg_result;
+        index += (size_t)sendmmsg_result;
 
-            min_msgs_sent = sendmmsg_result < min_msgs_sent ? sendmmsg_result : min_msgs_sent;
+        if (0 == sendmmsg_result)
+        {
+            first_unsent = index < first_unsent ? index : first_unsent;
+            break;
         }
     }
 
-    return min_msgs_sent;
+    if (0 == msgs_sent && 0 != msgs_failed)
+    {
+        return -1;
+    }
+
+    return (int)(first_unsent / destination_count);
 }
 
 int aeron_udp_destination_tracker_sendmsg(
@@ -100,29 +178,18 @@ int aeron_udp_destination_tracker_sendmsg(
     int64_t now_ns = tracker->nano_clock();
     int min_bytes_sent = (int)msghdr->msg_iov->iov_len;
 
-    for (int last_index = (int)tracker->destinations.length - 1, i = last_index; i >= 0; i--)
+    aeron_udp_destination_tracker_remove_timed_out(tracker, now_ns);
+
+    for (int i = (int)tracker->destinations.length - 1; i >= 0; i--)
     {
         aeron_udp_destination_entry_t *entry = &tracker->destinations.array[i];
 
-        if (now_ns > (entry->time_of_last_activity_ns + tracker->destination_timeout_ns))
-        {
-            aeron_array_fast_unordered_remove(
-                (uint8_t *)tracker->destinations.array,
-                sizeof(aeron_udp_destination_entry_t),
-                (size_t)i,
-                (size_t)last_index);
-            last_index--;
-            tracker->destinations.length--;
-        }
-        else
-        {
-            msghdr->msg_name = &entry->addr;
-            msghdr->msg_namelen = AERON_ADDR_LEN(&entry->addr);
+        msghdr->msg_name = &entry->addr;
+        msghdr->msg_namelen = AERON_ADDR_LEN(&entry->addr);
 
-            const int sendmsg_result = aeron_udp_channel_transport_sendmsg(transport, msghdr);
+        const int sendmsg_result = aeron_udp_channel_transport_sendmsg(transport, msghdr);
 
-            min_bytes_sent = sendmsg_result < min_bytes_sent ? sendmsg_result : min_bytes_sent;
-        }
+        min_bytes_sent = sendmsg_result < min_bytes_sent ? sendmsg_result : min_bytes_sent;
     }
 
     return min_bytes_sent;
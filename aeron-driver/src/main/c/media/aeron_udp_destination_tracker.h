@@ -24,6 +24,9 @@
 #define AERON_UDP_DESTINATION_TRACKER_DESTINATION_TIMEOUT_NS (5 * 1000 * 1000 * 1000L)
 #define AERON_UDP_DESTINATION_TRACKER_MANUAL_DESTINATION_TIMEOUT_NS (0L)
 
+/* the kernel sends no more than UIO_MAXIOV messages per sendmmsg call */
+#define AERON_UDP_DESTINATION_TRACKER_FAN_OUT_MAX_VLEN (1024)
+
 typedef struct aeron_udp_destination_entry_stct
 {
     struct sockaddr_storage addr;
@@ -42,6 +45,17 @@ typedef struct aeron_udp_destination_tracker_stct
     }
     destinations;
 
+    /*
+     * Batch of messages repeated for every destination, retained across sends so the fan out to all destinations
+     * only grows it and costs a sendmmsg per AERON_UDP_DESTINATION_TRACKER_FAN_OUT_MAX_VLEN messages.
+     */
+    struct aeron_udp_destination_tracker_fan_out_stct
+    {
+        struct mmsghdr *mmsghdrs;
+        size_t capacity;
+    }
+    fan_out;
+
     aeron_clock_func_t nano_clock;
     int64_t destination_timeout_ns;
     bool is_manual_control_mode;
@@ -25,11 +25,14 @@
 #include "aeron_alloc.h"
 #include "media/aeron_udp_transport_poller.h"
 
-int aeron_udp_transport_poller_init(aeron_udp_transport_poller_t *poller)
+int aeron_udp_transport_poller_init(
+    aeron_udp_transport_poller_t *poller, aeron_udp_transport_uring_t *uring, aeron_udp_transport_xdp_t *xdp)
 {
     poller->transports.array = NULL;
     poller->transports.length = 0;
     poller->transports.capacity = 0;
+    poller->uring = uring;
+    poller->xdp = xdp;
 
 #if defined(HAVE_EPOLL)
     if ((poller->epoll_fd = epoll_create1(0)) < 0)
@@ -70,6 +73,22 @@ int aeron_udp_transport_poller_add(aeron_udp_transport_poller_t *poller, aeron_u
 
     poller->transports.array[index].transport = transport;
 
+    if (NULL != poller->uring)
+    {
+        if (aeron_udp_transport_uring_add(poller->uring, transport) < 0)
+        {
+            return -1;
+        }
+
+        poller->transports.length++;
+        return 0;
+    }
+
+    if (NULL != poller->xdp && aeron_udp_transport_xdp_add(poller->xdp, transport) < 0)
+    {
+        return -1;
+    }
+
 #if defined(HAVE_EPOLL)
     size_t new_capacity = poller->transports.capacity;
 
@@ -135,6 +154,17 @@ int aeron_udp_transport_poller_remove(aeron_udp_transport_poller_t *poller, aero
             (size_t)index,
             (size_t)last_index);
 
+        if (NULL != poller->uring)
+        {
+            poller->transports.length--;
+            return aeron_udp_transport_uring_remove(poller->uring, transport);
+        }
+
+        if (NULL != poller->xdp && aeron_udp_transport_xdp_remove(poller->xdp, transport) < 0)
+        {
+            return -1;
+        }
+
 #if defined(HAVE_EPOLL)
         aeron_array_fast_unordered_remove(
             (uint8_t *)poller->epoll_events,
@@ -171,17 +201,29 @@ int aeron_udp_transport_poller_poll(
     aeron_udp_transport_poller_t *poller,
     struct mmsghdr *msgvec,
     size_t vlen,
+    int64_t *bytes_received,
     aeron_udp_transport_recv_func_t recv_func,
     void *clientd)
 {
     int work_count = 0;
 
+    if (NULL != poller->uring)
+    {
+        return aeron_udp_transport_uring_poll(poller->uring, bytes_received, recv_func, clientd);
+    }
+
+    if (NULL != poller->xdp &&
+        (work_count = aeron_udp_transport_xdp_poll(poller->xdp, bytes_received, recv_func, clientd)) < 0)
+    {
+        return -1;
+    }
+
     if (poller->transports.length <= AERON_UDP_TRANSPORT_POLLER_ITERATION_THRESHOLD)
     {
         for (size_t i = 0, length = poller->transports.length; i < length; i++)
         {
             int recv_result = aeron_udp_channel_transport_recvmmsg(
-                poller->transports.array[i].transport, msgvec, vlen, recv_func, clientd);
+                poller->transports.array[i].transport, msgvec, vlen, bytes_received, recv_func, clientd);
             if (recv_result < 0)
             {
                 return recv_result;
@@ -201,7 +243,7 @@ int aeron_udp_transport_poller_poll(
 
             if (EINTR == err || EAGAIN == err)
             {
-                return 0;
+                return work_count;
             }
 
             aeron_set_err(err, "epoll_wait: %s", strerror(err));
@@ -209,7 +251,7 @@ int aeron_udp_transport_poller_poll(
         }
         else if (0 == result)
         {
-            return 0;
+            return work_count;
         }
         else
         {
@@ -218,7 +260,7 @@ int aeron_udp_transport_poller_poll(
                 if (poller->epoll_events[i].events & EPOLLIN)
                 {
                     int recv_result = aeron_udp_channel_transport_recvmmsg(
-                        poller->epoll_events[i].data.ptr, msgvec, vlen, recv_func, clientd);
+                        poller->epoll_events[i].data.ptr, msgvec, vlen, bytes_received, recv_func, clientd);
 
                     if (recv_result < 0)
                     {
@@ -241,7 +283,7 @@ int aeron_udp_transport_poller_poll(
 
             if (EINTR == err || EAGAIN == err)
             {
-                return 0;
+                return work_count;
             }
 
             aeron_set_err(err, "poll: %s", strerror(err));
@@ -249,7 +291,7 @@ int aeron_udp_transport_poller_poll(
         }
         else if (0 == result)
         {
-            return 0;
+            return work_count;
         }
         else
         {
@@ -258,7 +300,7 @@ int aeron_udp_transport_poller_poll(
                 if (poller->pollfds[i].revents & POLLIN)
                 {
                     int recv_result = aeron_udp_channel_transport_recvmmsg(
-                        poller->transports.array[i].transport, msgvec, vlen, recv_func, clientd);
+                        poller->transports.array[i].transport, msgvec, vlen, bytes_received, recv_func, clientd);
 
                     if (recv_result < 0)
                     {
@@ -24,6 +24,8 @@
 #endif
 
 #include "media/aeron_udp_channel_transport.h"
+#include "media/aeron_udp_transport_uring.h"
+#include "media/aeron_udp_transport_xdp.h"
 
 #define AERON_UDP_TRANSPORT_POLLER_ITERATION_THRESHOLD (5)
 
@@ -43,6 +45,11 @@ typedef struct aeron_udp_transport_poller_stct
     }
     transports;
 
+    aeron_udp_transport_uring_t *uring;
+
+    /* transports still get polled on their sockets for whatever the XDP program passes on to the kernel */
+    aeron_udp_transport_xdp_t *xdp;
+
 #if defined(HAVE_EPOLL)
     int epoll_fd;
     struct epoll_event *epoll_events;
@@ -52,7 +59,8 @@ typedef struct aeron_udp_transport_poller_stct
 }
 aeron_udp_transport_poller_t;
 
-int aeron_udp_transport_poller_init(aeron_udp_transport_poller_t *poller);
+int aeron_udp_transport_poller_init(
+    aeron_udp_transport_poller_t *poller, aeron_udp_transport_uring_t *uring, aeron_udp_transport_xdp_t *xdp);
 int aeron_udp_transport_poller_close(aeron_udp_transport_poller_t *poller);
 
 int aeron_udp_transport_poller_add(aeron_udp_transport_poller_t *poller, aeron_udp_channel_transport_t *transport);
@@ -62,6 +70,7 @@ int aeron_udp_transport_poller_poll(
     aeron_udp_transport_poller_t *poller,
     struct mmsghdr *msgvec,
     size_t vlen,
+    int64_t *bytes_received,
     aeron_udp_transport_recv_func_t recv_func,
     void *clientd);
 
@@ -0,0 +1,889 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "aeron_socket.h"
+
+#include <string.h>
+#include <errno.h>
+
+#if defined(HAVE_IO_URING)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#if !defined(HAVE_STRUCT_MMSGHDR)
+struct mmsghdr
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+#endif
+
+#include "util/aeron_error.h"
+#include "util/aeron_arrayutil.h"
+#include "util/aeron_bitutil.h"
+#include "concurrent/aeron_atomic.h"
+#include "aeron_alloc.h"
+#include "media/aeron_udp_transport_uring.h"
+
+#if defined(HAVE_IO_URING)
+
+#define AERON_UDP_TRANSPORT_URING_USER_DATA(index, tag) (((uint64_t)(index) << 8) | (uint64_t)(tag))
+#define AERON_UDP_TRANSPORT_URING_USER_DATA_TAG(user_data) ((int)((user_data) & 0xFF))
+#define AERON_UDP_TRANSPORT_URING_USER_DATA_INDEX(user_data) ((size_t)((user_data) >> 8))
+#define AERON_UDP_TRANSPORT_URING_MAX_BUFFERS (32768)
+
+static int aeron_io_uring_setup(uint32_t entries, struct io_uring_params *params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int aeron_io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int aeron_io_uring_register(int fd, unsigned int opcode, void *arg, unsigned int nr_args)
+{
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static void *aeron_udp_transport_uring_mmap(int fd, size_t length, off_t offset)
+{
+    int flags = MAP_SHARED | MAP_POPULATE;
+    void *addr = -1 == fd ?
+        mmap(NULL, length, PROT_READ | PROT_WRITE, flags | MAP_ANONYMOUS, -1, 0) :
+        mmap(NULL, length, PROT_READ | PROT_WRITE, flags, fd, offset);
+
+    return MAP_FAILED == addr ? NULL : addr;
+}
+
+static inline void aeron_udp_transport_uring_recycle_buffer(aeron_udp_transport_uring_t *ring, uint16_t buffer_id)
+{
+    struct io_uring_buf *buf = &ring->buf_ring->bufs[ring->buf_ring_tail & ring->buf_ring_mask];
+
+    buf->addr = (uint64_t)(uintptr_t)(ring->recv_buffers + ((size_t)buffer_id * ring->recv_buffer_length));
+    buf->len = (uint32_t)ring->recv_buffer_length;
+    buf->bid = buffer_id;
+    ring->buf_ring_tail++;
+}
+
+static struct io_uring_sqe *aeron_udp_transport_uring_next_sqe(aeron_udp_transport_uring_t *ring, uint32_t *index)
+{
+    uint32_t sq_head;
+    AERON_GET_VOLATILE(sq_head, *ring->sq_head);
+
+    if (ring->sq_local_tail - sq_head >= ring->sq_entries)
+    {
+        if (aeron_udp_transport_uring_submit(ring) < 0)
+        {
+            return NULL;
+        }
+
+        AERON_GET_VOLATILE(sq_head, *ring->sq_head);
+        if (ring->sq_local_tail - sq_head >= ring->sq_entries)
+        {
+            aeron_set_err(EBUSY, "io_uring submission queue full: %s", strerror(EBUSY));
+            return NULL;
+        }
+    }
+
+    *index = ring->sq_local_tail & ring->sq_mask;
+    ring->sq_local_tail++;
+
+    struct io_uring_sqe *sqe = &ring->sqes[*index];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+
+    return sqe;
+}
+
+static int aeron_udp_transport_uring_arm_recv(aeron_udp_transport_uring_t *ring, size_t slot_index)
+{
+    aeron_udp_transport_uring_recv_slot_t *slot = &ring->recv_slots.array[slot_index];
+    uint32_t index;
+    struct io_uring_sqe *sqe = aeron_udp_transport_uring_next_sqe(ring, &index);
+
+    if (NULL == sqe)
+    {
+        return -1;
+    }
+
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = slot->transport->fd;
+    sqe->addr = (uint64_t)(uintptr_t)&ring->recv_msghdr;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = AERON_UDP_TRANSPORT_URING_BUFFER_GROUP_ID;
+    sqe->user_data = AERON_UDP_TRANSPORT_URING_USER_DATA(slot_index, AERON_UDP_TRANSPORT_URING_TAG_RECV);
+
+    slot->is_armed = true;
+
+    return 0;
+}
+
+static void aeron_udp_transport_uring_on_send_complete(
+    aeron_udp_transport_uring_t *ring, const aeron_udp_transport_uring_cqe_t *cqe)
+{
+    ring->send_slots[AERON_UDP_TRANSPORT_URING_USER_DATA_INDEX(cqe->user_data)].result = cqe->res;
+    ring->sends_in_flight--;
+}
+
+static int aeron_udp_transport_uring_enter(aeron_udp_transport_uring_t *ring, uint32_t min_complete)
+{
+    uint32_t sq_head, sq_flags;
+
+    AERON_GET_VOLATILE(sq_head, *ring->sq_head);
+    AERON_GET_VOLATILE(sq_flags, *ring->sq_flags);
+
+    uint32_t to_submit = ring->sq_local_tail - sq_head;
+    int submitted = 0;
+
+    if (to_submit > 0 || min_complete > 0 || (sq_flags & IORING_SQ_CQ_OVERFLOW))
+    {
+        AERON_PUT_ORDERED(*ring->sq_tail, ring->sq_local_tail);
+
+        uint32_t flags = min_complete > 0 || (sq_flags & IORING_SQ_CQ_OVERFLOW) ? IORING_ENTER_GETEVENTS : 0;
+
+        if ((submitted = aeron_io_uring_enter(ring->ring_fd, to_submit, min_complete, flags)) < 0)
+        {
+            int errcode = errno;
+
+            if (EINTR == errcode || EAGAIN == errcode || EBUSY == errcode)
+            {
+                return 0;
+            }
+
+            aeron_set_err(errcode, "io_uring_enter: %s", strerror(errcode));
+            return -1;
+        }
+    }
+
+    return submitted;
+}
+
+/*
+ * Reaps send completions from the head of the completion queue. Receive completions stop the reap, so poll can
+ * dispatch them in place, unless they are to be set aside because sends queued behind them are being waited on.
+ */
+static int aeron_udp_transport_uring_reap(aeron_udp_transport_uring_t *ring, bool defer_recv)
+{
+    uint32_t cq_head = *ring->cq_head, cq_tail;
+    int result = 0;
+
+    AERON_GET_VOLATILE(cq_tail, *ring->cq_tail);
+
+    for (; cq_head != cq_tail; cq_head++)
+    {
+        struct io_uring_cqe *cqe = &ring->cqes[cq_head & ring->cq_mask];
+        aeron_udp_transport_uring_cqe_t entry = { cqe->user_data, cqe->res, cqe->flags };
+        int tag = AERON_UDP_TRANSPORT_URING_USER_DATA_TAG(entry.user_data);
+
+        if (AERON_UDP_TRANSPORT_URING_TAG_RECV == tag)
+        {
+            int ensure_capacity_result = 0;
+
+            if (!defer_recv)
+            {
+                break;
+            }
+
+            AERON_ARRAY_ENSURE_CAPACITY(ensure_capacity_result, ring->deferred_cqes, aeron_udp_transport_uring_cqe_t);
+            if (ensure_capacity_result < 0)
+            {
+                result = -1;
+                break;
+            }
+
+            ring->deferred_cqes.array[ring->deferred_cqes.length++] = entry;
+        }
+        else if (AERON_UDP_TRANSPORT_URING_TAG_SEND == tag)
+        {
+            aeron_udp_transport_uring_on_send_complete(ring, &entry);
+        }
+    }
+
+    AERON_PUT_ORDERED(*ring->cq_head, cq_head);
+
+    return result;
+}
+
+static int aeron_udp_transport_uring_await_sends(aeron_udp_transport_uring_t *ring)
+{
+    uint32_t min_complete = 0;
+
+    do
+    {
+        if (aeron_udp_transport_uring_enter(ring, min_complete) < 0 || aeron_udp_transport_uring_reap(ring, true) < 0)
+        {
+            return -1;
+        }
+
+        min_complete = 1;
+    }
+    while (ring->sends_in_flight > 0);
+
+    return 0;
+}
+
+static bool aeron_udp_transport_uring_next_cqe(aeron_udp_transport_uring_t *ring, aeron_udp_transport_uring_cqe_t *cqe)
+{
+    struct aeron_udp_transport_uring_deferred_cqes_stct *deferred = &ring->deferred_cqes;
+
+    if (deferred->head < deferred->length)
+    {
+        *cqe = deferred->array[deferred->head++];
+        if (deferred->head == deferred->length)
+        {
+            deferred->head = 0;
+            deferred->length = 0;
+        }
+
+        return true;
+    }
+
+    uint32_t cq_head = *ring->cq_head, cq_tail;
+    AERON_GET_VOLATILE(cq_tail, *ring->cq_tail);
+
+    if (cq_head == cq_tail)
+    {
+        return false;
+    }
+
+    struct io_uring_cqe *next = &ring->cqes[cq_head & ring->cq_mask];
+    cqe->user_data = next->user_data;
+    cqe->res = next->res;
+    cqe->flags = next->flags;
+    AERON_PUT_ORDERED(*ring->cq_head, cq_head + 1);
+
+    return true;
+}
+
+int aeron_udp_transport_uring_init(aeron_udp_transport_uring_t *ring, uint32_t entries, size_t max_packet_length)
+{
+    struct io_uring_params params;
+
+    ring->ring_fd = -1;
+    ring->sq_ring = NULL;
+    ring->cq_ring = NULL;
+    ring->sqes = NULL;
+    ring->buf_ring = NULL;
+    ring->recv_buffers = NULL;
+    ring->send_slots = NULL;
+    ring->sends_in_flight = 0;
+    ring->recv_slots.array = NULL;
+    ring->recv_slots.length = 0;
+    ring->recv_slots.capacity = 0;
+    ring->deferred_cqes.array = NULL;
+    ring->deferred_cqes.head = 0;
+    ring->deferred_cqes.length = 0;
+    ring->deferred_cqes.capacity = 0;
+
+    if (!AERON_IS_POWER_OF_TWO(entries) || entries > AERON_UDP_TRANSPORT_URING_MAX_BUFFERS)
+    {
+        aeron_set_err(EINVAL, "io_uring entries must be a power of 2 <= %d: entries=%u",
+            AERON_UDP_TRANSPORT_URING_MAX_BUFFERS, entries);
+        return -1;
+    }
+
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+
+    if ((ring->ring_fd = aeron_io_uring_setup(entries, &params)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "io_uring_setup: %s", strerror(errcode));
+        goto error;
+    }
+
+    ring->sq_ring_length = params.sq_off.array + (params.sq_entries * sizeof(uint32_t));
+    ring->cq_ring_length = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+    ring->sqes_length = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    if ((ring->sq_ring = aeron_udp_transport_uring_mmap(ring->ring_fd, ring->sq_ring_length, IORING_OFF_SQ_RING)) == NULL ||
+        (ring->cq_ring = aeron_udp_transport_uring_mmap(ring->ring_fd, ring->cq_ring_length, IORING_OFF_CQ_RING)) == NULL ||
+        (ring->sqes = aeron_udp_transport_uring_mmap(ring->ring_fd, ring->sqes_length, IORING_OFF_SQES)) == NULL)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "io_uring mmap: %s", strerror(errcode));
+        goto error;
+    }
+
+    ring->sq_head = (volatile uint32_t *)(ring->sq_ring + params.sq_off.head);
+    ring->sq_tail = (volatile uint32_t *)(ring->sq_ring + params.sq_off.tail);
+    ring->sq_flags = (volatile uint32_t *)(ring->sq_ring + params.sq_off.flags);
+    ring->sq_array = (uint32_t *)(ring->sq_ring + params.sq_off.array);
+    ring->sq_mask = *(uint32_t *)(ring->sq_ring + params.sq_off.ring_mask);
+    ring->sq_entries = params.sq_entries;
+    ring->sq_local_tail = *ring->sq_tail;
+
+    ring->cq_head = (volatile uint32_t *)(ring->cq_ring + params.cq_off.head);
+    ring->cq_tail = (volatile uint32_t *)(ring->cq_ring + params.cq_off.tail);
+    ring->cqes = (struct io_uring_cqe *)(ring->cq_ring + params.cq_off.cqes);
+    ring->cq_mask = *(uint32_t *)(ring->cq_ring + params.cq_off.ring_mask);
+
+    for (uint32_t i = 0; i < ring->sq_entries; i++)
+    {
+        ring->sq_array[i] = i;
+    }
+
+    if (aeron_alloc((void **)&ring->send_slots, ring->sq_entries * sizeof(aeron_udp_transport_uring_send_slot_t)) < 0)
+    {
+        goto error;
+    }
+
+    ring->recv_buffer_count = entries;
+    ring->recv_buffer_length = AERON_ALIGN(
+        sizeof(struct io_uring_recvmsg_out) +
+        sizeof(struct sockaddr_storage) +
+        AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH +
+        max_packet_length,
+        AERON_CACHE_LINE_LENGTH);
+    ring->buf_ring_length = AERON_ALIGN(entries * sizeof(struct io_uring_buf), (size_t)getpagesize());
+    ring->buf_ring_mask = (uint16_t)(entries - 1);
+    ring->buf_ring_tail = 0;
+
+    if ((ring->buf_ring = aeron_udp_transport_uring_mmap(-1, ring->buf_ring_length, 0)) == NULL ||
+        (ring->recv_buffers = aeron_udp_transport_uring_mmap(
+            -1, ring->recv_buffer_count * ring->recv_buffer_length, 0)) == NULL)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "io_uring buffers mmap: %s", strerror(errcode));
+        goto error;
+    }
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)ring->buf_ring;
+    reg.ring_entries = entries;
+    reg.bgid = AERON_UDP_TRANSPORT_URING_BUFFER_GROUP_ID;
+
+    if (aeron_io_uring_register(ring->ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "io_uring_register(IORING_REGISTER_PBUF_RING): %s", strerror(errcode));
+        goto error;
+    }
+
+    for (uint32_t i = 0; i < ring->recv_buffer_count; i++)
+    {
+        aeron_udp_transport_uring_recycle_buffer(ring, (uint16_t)i);
+    }
+    AERON_PUT_ORDERED(ring->buf_ring->tail, ring->buf_ring_tail);
+
+    memset(&ring->recv_msghdr, 0, sizeof(ring->recv_msghdr));
+    ring->recv_msghdr.msg_namelen = sizeof(struct sockaddr_storage);
+    ring->recv_msghdr.msg_controllen = AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH;
+
+    return 0;
+
+    error:
+        aeron_udp_transport_uring_close(ring);
+        return -1;
+}
+
+int aeron_udp_transport_uring_close(aeron_udp_transport_uring_t *ring)
+{
+    if (-1 != ring->ring_fd)
+    {
+        close(ring->ring_fd);
+        ring->ring_fd = -1;
+    }
+
+    if (NULL != ring->sq_ring)
+    {
+        munmap(ring->sq_ring, ring->sq_ring_length);
+        ring->sq_ring = NULL;
+    }
+
+    if (NULL != ring->cq_ring)
+    {
+        munmap(ring->cq_ring, ring->cq_ring_length);
+        ring->cq_ring = NULL;
+    }
+
+    if (NULL != ring->sqes)
+    {
+        munmap(ring->sqes, ring->sqes_length);
+        ring->sqes = NULL;
+    }
+
+    if (NULL != ring->buf_ring)
+    {
+        munmap(ring->buf_ring, ring->buf_ring_length);
+        ring->buf_ring = NULL;
+    }
+
+    if (NULL != ring->recv_buffers)
+    {
+        munmap(ring->recv_buffers, ring->recv_buffer_count * ring->recv_buffer_length);
+        ring->recv_buffers = NULL;
+    }
+
+    aeron_free(ring->send_slots);
+    ring->send_slots = NULL;
+    aeron_free(ring->recv_slots.array);
+    ring->recv_slots.array = NULL;
+    ring->recv_slots.length = 0;
+    ring->recv_slots.capacity = 0;
+    aeron_free(ring->deferred_cqes.array);
+    ring->deferred_cqes.array = NULL;
+    ring->deferred_cqes.head = 0;
+    ring->deferred_cqes.length = 0;
+    ring->deferred_cqes.capacity = 0;
+
+    return 0;
+}
+
+int aeron_udp_transport_uring_add(aeron_udp_transport_uring_t *ring, aeron_udp_channel_transport_t *transport)
+{
+    size_t slot_index = ring->recv_slots.length;
+
+    for (size_t i = 0, length = ring->recv_slots.length; i < length; i++)
+    {
+        aeron_udp_transport_uring_recv_slot_t *slot = &ring->recv_slots.array[i];
+
+        if (NULL == slot->transport && !slot->is_armed)
+        {
+            slot_index = i;
+            break;
+        }
+    }
+
+    if (slot_index == ring->recv_slots.length)
+    {
+        int ensure_capacity_result = 0;
+
+        AERON_ARRAY_ENSURE_CAPACITY(ensure_capacity_result, ring->recv_slots, aeron_udp_transport_uring_recv_slot_t);
+        if (ensure_capacity_result < 0)
+        {
+            return -1;
+        }
+
+        ring->recv_slots.length++;
+    }
+
+    ring->recv_slots.array[slot_index].transport = transport;
+    ring->recv_slots.array[slot_index].is_armed = false;
+    transport->uring = ring;
+
+    if (aeron_udp_transport_uring_arm_recv(ring, slot_index) < 0)
+    {
+        return -1;
+    }
+
+    return aeron_udp_transport_uring_submit(ring) < 0 ? -1 : 0;
+}
+
+int aeron_udp_transport_uring_remove(aeron_udp_transport_uring_t *ring, aeron_udp_channel_transport_t *transport)
+{
+    int result = aeron_udp_transport_uring_submit(ring);
+
+    for (size_t i = 0, length = ring->recv_slots.length; i < length; i++)
+    {
+        aeron_udp_transport_uring_recv_slot_t *slot = &ring->recv_slots.array[i];
+
+        if (transport == slot->transport)
+        {
+            /* completions already queued for this slot are dropped until the terminating one frees the slot */
+            slot->transport = NULL;
+
+            if (slot->is_armed)
+            {
+                uint32_t index;
+                struct io_uring_sqe *sqe = aeron_udp_transport_uring_next_sqe(ring, &index);
+
+                if (NULL == sqe)
+                {
+                    return -1;
+                }
+
+                sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                sqe->fd = -1;
+                sqe->addr = AERON_UDP_TRANSPORT_URING_USER_DATA(i, AERON_UDP_TRANSPORT_URING_TAG_RECV);
+                sqe->user_data = AERON_UDP_TRANSPORT_URING_USER_DATA(i, AERON_UDP_TRANSPORT_URING_TAG_CANCEL);
+
+                if (aeron_udp_transport_uring_submit(ring) < 0)
+                {
+                    return -1;
+                }
+            }
+            break;
+        }
+    }
+
+    transport->uring = NULL;
+
+    return result < 0 ? -1 : 0;
+}
+
+int aeron_udp_transport_uring_submit(aeron_udp_transport_uring_t *ring)
+{
+    int submitted = aeron_udp_transport_uring_enter(ring, 0);
+
+    if (submitted < 0 || aeron_udp_transport_uring_reap(ring, false) < 0)
+    {
+        return -1;
+    }
+
+    return submitted;
+}
+
+int aeron_udp_transport_uring_poll(
+    aeron_udp_transport_uring_t *ring,
+    int64_t *bytes_received,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd)
+{
+    const size_t header_length =
+        sizeof(struct io_uring_recvmsg_out) + ring->recv_msghdr.msg_namelen + ring->recv_msghdr.msg_controllen;
+    int work_count = 0, recv_errcode = 0;
+
+    if (aeron_udp_transport_uring_submit(ring) < 0)
+    {
+        return -1;
+    }
+
+    uint32_t cq_tail;
+    AERON_GET_VOLATILE(cq_tail, *ring->cq_tail);
+
+    /*
+     * Bounded by what is there on entry so a busy socket cannot hold the loop. A handler sending waits for its
+     * completions, setting aside the receives ahead of them, which are taken first so the order is kept.
+     */
+    const size_t budget = (ring->deferred_cqes.length - ring->deferred_cqes.head) + (cq_tail - *ring->cq_head);
+    aeron_udp_transport_uring_cqe_t cqe;
+
+    for (size_t i = 0; i < budget && aeron_udp_transport_uring_next_cqe(ring, &cqe); i++)
+    {
+        const uint64_t user_data = cqe.user_data;
+        const int32_t res = cqe.res;
+        const uint32_t flags = cqe.flags;
+        const int tag = AERON_UDP_TRANSPORT_URING_USER_DATA_TAG(user_data);
+
+        if (AERON_UDP_TRANSPORT_URING_TAG_SEND == tag)
+        {
+            aeron_udp_transport_uring_on_send_complete(ring, &cqe);
+        }
+
+        if (AERON_UDP_TRANSPORT_URING_TAG_RECV != tag)
+        {
+            continue;
+        }
+
+        size_t slot_index = AERON_UDP_TRANSPORT_URING_USER_DATA_INDEX(user_data);
+
+        if (flags & IORING_CQE_F_BUFFER)
+        {
+            uint16_t buffer_id = (uint16_t)(flags >> IORING_CQE_BUFFER_SHIFT);
+            aeron_udp_channel_transport_t *transport = ring->recv_slots.array[slot_index].transport;
+
+            if (res >= (int32_t)header_length && NULL != transport)
+            {
+                uint8_t *buffer = ring->recv_buffers + ((size_t)buffer_id * ring->recv_buffer_length);
+                struct io_uring_recvmsg_out *out = (struct io_uring_recvmsg_out *)buffer;
+
+                if (0 == (out->flags & MSG_TRUNC))
+                {
+                    size_t length = (size_t)res - header_length;
+                    struct msghdr message;
+
+                    message.msg_control =
+                        buffer + sizeof(struct io_uring_recvmsg_out) + ring->recv_msghdr.msg_namelen;
+                    message.msg_controllen = out->controllen;
+
+                    work_count += aeron_udp_channel_transport_dispatch(
+                        transport,
+                        &message,
+                        buffer + header_length,
+                        length,
+                        (struct sockaddr_storage *)(buffer + sizeof(struct io_uring_recvmsg_out)),
+                        recv_func,
+                        clientd);
+
+                    *bytes_received += length;
+                }
+                else
+                {
+                    aeron_udp_channel_transport_on_truncated(transport);
+                }
+            }
+
+            aeron_udp_transport_uring_recycle_buffer(ring, buffer_id);
+        }
+
+        if (0 == (flags & IORING_CQE_F_MORE))
+        {
+            aeron_udp_transport_uring_recv_slot_t *slot = &ring->recv_slots.array[slot_index];
+
+            slot->is_armed = false;
+
+            if (res < 0 && -ENOBUFS != res && -ECANCELED != res && -EINTR != res)
+            {
+                recv_errcode = -res;
+            }
+
+            if (NULL != slot->transport && aeron_udp_transport_uring_arm_recv(ring, slot_index) < 0)
+            {
+                AERON_PUT_ORDERED(ring->buf_ring->tail, ring->buf_ring_tail);
+                return -1;
+            }
+        }
+    }
+
+    AERON_PUT_ORDERED(ring->buf_ring->tail, ring->buf_ring_tail);
+
+    if (ring->sq_local_tail != *ring->sq_tail && aeron_udp_transport_uring_submit(ring) < 0)
+    {
+        return -1;
+    }
+
+    if (0 != recv_errcode)
+    {
+        aeron_set_err(recv_errcode, "io_uring recvmsg: %s", strerror(recv_errcode));
+        return -1;
+    }
+
+    return work_count;
+}
+
+static int aeron_udp_transport_uring_queue_send(
+    aeron_udp_transport_uring_t *ring,
+    aeron_udp_channel_transport_t *transport,
+    struct msghdr *message,
+    uint32_t *index)
+{
+    size_t iovlen = message->msg_iovlen, length = 0;
+
+    if (iovlen > AERON_UDP_TRANSPORT_URING_MAX_IOV ||
+        message->msg_namelen > sizeof(struct sockaddr_storage) ||
+        message->msg_controllen > AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH)
+    {
+        aeron_set_err(EINVAL, "io_uring sendmsg: %s", strerror(EINVAL));
+        return -1;
+    }
+
+    for (size_t i = 0; i < iovlen; i++)
+    {
+        length += message->msg_iov[i].iov_len;
+    }
+
+    struct io_uring_sqe *sqe = aeron_udp_transport_uring_next_sqe(ring, index);
+    if (NULL == sqe)
+    {
+        return -1;
+    }
+
+    aeron_udp_transport_uring_send_slot_t *slot = &ring->send_slots[*index];
+
+    memcpy(&slot->addr, message->msg_name, message->msg_namelen);
+    slot->msghdr.msg_name = &slot->addr;
+    slot->msghdr.msg_namelen = message->msg_namelen;
+    slot->msghdr.msg_control = NULL;
+    slot->msghdr.msg_controllen = message->msg_controllen;
+    if (message->msg_controllen > 0)
+    {
+        memcpy(slot->control, message->msg_control, message->msg_controllen);
+        slot->msghdr.msg_control = slot->control;
+    }
+    slot->msghdr.msg_flags = 0;
+    slot->msghdr.msg_iov = slot->iov;
+
+    if (length <= AERON_UDP_TRANSPORT_URING_INLINE_LENGTH)
+    {
+        size_t offset = 0;
+
+        for (size_t i = 0; i < iovlen; i++)
+        {
+            memcpy(slot->inline_buffer + offset, message->msg_iov[i].iov_base, message->msg_iov[i].iov_len);
+            offset += message->msg_iov[i].iov_len;
+        }
+
+        slot->iov[0].iov_base = slot->inline_buffer;
+        slot->iov[0].iov_len = length;
+        slot->msghdr.msg_iovlen = 1;
+    }
+    else
+    {
+        memcpy(slot->iov, message->msg_iov, iovlen * sizeof(struct iovec));
+        slot->msghdr.msg_iovlen = iovlen;
+    }
+
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = transport->fd;
+    sqe->addr = (uint64_t)(uintptr_t)&slot->msghdr;
+    sqe->len = 1;
+    sqe->msg_flags = MSG_DONTWAIT;
+    sqe->user_data = AERON_UDP_TRANSPORT_URING_USER_DATA(*index, AERON_UDP_TRANSPORT_URING_TAG_SEND);
+    ring->sends_in_flight++;
+
+    return (int)length;
+}
+
+int aeron_udp_transport_uring_sendmmsg(
+    aeron_udp_transport_uring_t *ring,
+    aeron_udp_channel_transport_t *transport,
+    struct mmsghdr *msgvec,
+    size_t vlen)
+{
+    size_t sent = 0;
+
+    while (sent < vlen)
+    {
+        /* no more than the submission queue holds, so no slot is reused before its result has been read */
+        const size_t limit = vlen - sent < ring->sq_entries ? vlen - sent : ring->sq_entries;
+        const uint32_t first_tail = ring->sq_local_tail;
+        size_t queued = 0;
+        uint32_t index;
+
+        for (; queued < limit; queued++)
+        {
+            if (aeron_udp_transport_uring_queue_send(ring, transport, &msgvec[sent + queued].msg_hdr, &index) < 0)
+            {
+                break;
+            }
+        }
+
+        if (aeron_udp_transport_uring_await_sends(ring) < 0)
+        {
+            return 0 == sent ? -1 : (int)sent;
+        }
+
+        for (size_t i = 0; i < queued; i++)
+        {
+            const int32_t result = ring->send_slots[(first_tail + (uint32_t)i) & ring->sq_mask].result;
+
+            if (result < 0)
+            {
+                if (0 == sent)
+                {
+                    aeron_set_err(-result, "io_uring sendmsg: %s", strerror(-result));
+                    return -1;
+                }
+
+                return (int)sent;
+            }
+
+            msgvec[sent].msg_len = (unsigned int)result;
+            sent++;
+        }
+
+        if (queued < limit)
+        {
+            return 0 == sent ? -1 : (int)sent;
+        }
+    }
+
+    return (int)sent;
+}
+
+int aeron_udp_transport_uring_sendmsg(
+    aeron_udp_transport_uring_t *ring,
+    aeron_udp_channel_transport_t *transport,
+    struct msghdr *message)
+{
+    uint32_t index;
+
+    if (aeron_udp_transport_uring_queue_send(ring, transport, message, &index) < 0 ||
+        aeron_udp_transport_uring_await_sends(ring) < 0)
+    {
+        return -1;
+    }
+
+    const int32_t result = ring->send_slots[index].result;
+
+    if (result < 0)
+    {
+        aeron_set_err(-result, "io_uring sendmsg: %s", strerror(-result));
+        return -1;
+    }
+
+    return result;
+}
+
+#else
+
+int aeron_udp_transport_uring_init(aeron_udp_transport_uring_t *ring, uint32_t entries, size_t max_packet_length)
+{
+    ring->ring_fd = -1;
+    ring->recv_slots.array = NULL;
+    ring->recv_slots.length = 0;
+    ring->recv_slots.capacity = 0;
+
+    aeron_set_err(ENOTSUP, "io_uring transport not supported on this platform: %s", strerror(ENOTSUP));
+    return -1;
+}
+
+int aeron_udp_transport_uring_close(aeron_udp_transport_uring_t *ring)
+{
+    return 0;
+}
+
+int aeron_udp_transport_uring_add(aeron_udp_transport_uring_t *ring, aeron_udp_channel_transport_t *transport)
+{
+    aeron_set_err(ENOTSUP, "io_uring transport not supported on this platform: %s", strerror(ENOTSUP));
+    return -1;
+}
+
+int aeron_udp_transport_uring_remove(aeron_udp_transport_uring_t *ring, aeron_udp_channel_transport_t *transport)
+{
+    return 0;
+}
+
+int aeron_udp_transport_uring_poll(
+    aeron_udp_transport_uring_t *ring,
+    int64_t *bytes_received,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd)
+{
+    return 0;
+}
+
+int aeron_udp_transport_uring_submit(aeron_udp_transport_uring_t *ring)
+{
+    return 0;
+}
+
+int aeron_udp_transport_uring_sendmmsg(
+    aeron_udp_transport_uring_t *ring,
+    aeron_udp_channel_transport_t *transport,
+    struct mmsghdr *msgvec,
+    size_t vlen)
+{
+    aeron_set_err(ENOTSUP, "io_uring transport not supported on this platform: %s", strerror(ENOTSUP));
+    return -1;
+}
+
+int aeron_udp_transport_uring_sendmsg(
+    aeron_udp_transport_uring_t *ring,
+    aeron_udp_channel_transport_t *transport,
+    struct msghdr *message)
+{
+    aeron_set_err(ENOTSUP, "io_uring transport not supported on this platform: %s", strerror(ENOTSUP));
+    return -1;
+}
+
+#endif
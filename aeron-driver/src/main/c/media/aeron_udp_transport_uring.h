@@ -0,0 +1,179 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AERON_UDP_TRANSPORT_URING_H
+#define AERON_UDP_TRANSPORT_URING_H
+
+#if defined(HAVE_IO_URING)
+#include <linux/io_uring.h>
+#endif
+
+#include "media/aeron_udp_channel_transport.h"
+
+#define AERON_UDP_TRANSPORT_URING_INLINE_LENGTH (128)
+#define AERON_UDP_TRANSPORT_URING_MAX_IOV (4)
+#define AERON_UDP_TRANSPORT_URING_BUFFER_GROUP_ID (0)
+
+#define AERON_UDP_TRANSPORT_URING_TAG_RECV (1)
+#define AERON_UDP_TRANSPORT_URING_TAG_SEND (2)
+#define AERON_UDP_TRANSPORT_URING_TAG_CANCEL (3)
+
+typedef struct aeron_udp_transport_uring_recv_slot_stct
+{
+    aeron_udp_channel_transport_t *transport;
+    bool is_armed;
+}
+aeron_udp_transport_uring_recv_slot_t;
+
+/*
+ * The message header, address, control message, and any small frame built on the caller's stack are copied into the
+ * slot that shadows the submission queue entry, which also holds the result once the send has completed.
+ */
+typedef struct aeron_udp_transport_uring_send_slot_stct
+{
+    struct msghdr msghdr;
+    struct iovec iov[AERON_UDP_TRANSPORT_URING_MAX_IOV];
+    struct sockaddr_storage addr;
+    uint8_t control[AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH];
+    uint8_t inline_buffer[AERON_UDP_TRANSPORT_URING_INLINE_LENGTH];
+    int32_t result;
+}
+aeron_udp_transport_uring_send_slot_t;
+
+typedef struct aeron_udp_transport_uring_cqe_stct
+{
+    uint64_t user_data;
+    int32_t res;
+    uint32_t flags;
+}
+aeron_udp_transport_uring_cqe_t;
+
+typedef struct aeron_udp_transport_uring_stct
+{
+    int ring_fd;
+
+    uint8_t *sq_ring;
+    size_t sq_ring_length;
+    uint8_t *cq_ring;
+    size_t cq_ring_length;
+    struct io_uring_sqe *sqes;
+    size_t sqes_length;
+
+    volatile uint32_t *sq_head;
+    volatile uint32_t *sq_tail;
+    volatile uint32_t *sq_flags;
+    uint32_t *sq_array;
+    uint32_t sq_mask;
+    uint32_t sq_entries;
+    uint32_t sq_local_tail;
+
+    volatile uint32_t *cq_head;
+    volatile uint32_t *cq_tail;
+    struct io_uring_cqe *cqes;
+    uint32_t cq_mask;
+
+    struct io_uring_buf_ring *buf_ring;
+    size_t buf_ring_length;
+    uint8_t *recv_buffers;
+    size_t recv_buffer_length;
+    uint32_t recv_buffer_count;
+    uint16_t buf_ring_mask;
+    uint16_t buf_ring_tail;
+    struct msghdr recv_msghdr;
+
+    aeron_udp_transport_uring_send_slot_t *send_slots;
+    size_t sends_in_flight;
+
+    /* receive completions reaped while waiting on sends, in completion order, ahead of what is still in the queue */
+    struct aeron_udp_transport_uring_deferred_cqes_stct
+    {
+        aeron_udp_transport_uring_cqe_t *array;
+        size_t head;
+        size_t length;
+        size_t capacity;
+    }
+    deferred_cqes;
+
+    struct aeron_udp_transport_uring_recv_slots_stct
+    {
+        aeron_udp_transport_uring_recv_slot_t *array;
+        size_t length;
+        size_t capacity;
+    }
+    recv_slots;
+}
+aeron_udp_transport_uring_t;
+
+/**
+ * Initialise an io_uring instance owned by a single agent.
+ *
+ * @param ring to initialise.
+ * @param entries number of submission queue entries and provided receive buffers, must be a power of 2.
+ * @param max_packet_length largest datagram that will be received by transports attached to this ring.
+ * @return 0 for success and -1 for error.
+ */
+int aeron_udp_transport_uring_init(aeron_udp_transport_uring_t *ring, uint32_t entries, size_t max_packet_length);
+
+int aeron_udp_transport_uring_close(aeron_udp_transport_uring_t *ring);
+
+int aeron_udp_transport_uring_add(aeron_udp_transport_uring_t *ring, aeron_udp_channel_transport_t *transport);
+int aeron_udp_transport_uring_remove(aeron_udp_transport_uring_t *ring, aeron_udp_channel_transport_t *transport);
+
+/**
+ * Sweep the completion queue, dispatching every datagram received by the multishot receives and re-arming any that
+ * have terminated. Queued sends are submitted in the same call.
+ *
+ * @return number of datagrams dispatched or -1 for error.
+ */
+int aeron_udp_transport_uring_poll(
+    aeron_udp_transport_uring_t *ring,
+    int64_t *bytes_received,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd);
+
+/**
+ * Submit all queued entries with a single io_uring_enter and reap the completion queue, setting aside receive
+ * completions for the next poll.
+ *
+ * @return number of entries submitted or -1 for error.
+ */
+int aeron_udp_transport_uring_submit(aeron_udp_transport_uring_t *ring);
+
+/**
+ * Send the messages with a single io_uring_enter and wait for their completions, so as with sendmmsg the count
+ * returned is of the messages the kernel took, and a send that fails with EAGAIN or ENOBUFS is not reported as sent.
+ * The whole batch is submitted though, so messages after a failed one may also have been sent and are duplicated if
+ * sent again.
+ *
+ * @return number of messages sent before the first that failed, or -1 for error when the first failed.
+ */
+int aeron_udp_transport_uring_sendmmsg(
+    aeron_udp_transport_uring_t *ring,
+    aeron_udp_channel_transport_t *transport,
+    struct mmsghdr *msgvec,
+    size_t vlen);
+
+/**
+ * Send the message and wait for its completion.
+ *
+ * @return number of bytes sent or -1 for error.
+ */
+int aeron_udp_transport_uring_sendmsg(
+    aeron_udp_transport_uring_t *ring,
+    aeron_udp_channel_transport_t *transport,
+    struct msghdr *message);
+
+#endif //AERON_UDP_TRANSPORT_URING_H
@@ -0,0 +1,1150 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+#define _BSD_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "aeron_socket.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(HAVE_AF_XDP)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#endif
+
+#if !defined(HAVE_STRUCT_MMSGHDR)
+struct mmsghdr
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+#endif
+
+#include "util/aeron_error.h"
+#include "util/aeron_arrayutil.h"
+#include "util/aeron_bitutil.h"
+#include "concurrent/aeron_atomic.h"
+#include "aeron_alloc.h"
+#include "aeronmd.h"
+#include "media/aeron_udp_transport_xdp.h"
+
+#if defined(HAVE_AF_XDP)
+
+#define AERON_UDP_TRANSPORT_XDP_ETH_P_IP (0x0800)
+#define AERON_UDP_TRANSPORT_XDP_IP_VERSION_IHL (0x45)
+#define AERON_UDP_TRANSPORT_XDP_IP_FLAGS_DF (0x4000)
+#define AERON_UDP_TRANSPORT_XDP_IP_FRAGMENT_MASK (0x3FFF)
+#define AERON_UDP_TRANSPORT_XDP_IP_TTL (64)
+#define AERON_UDP_TRANSPORT_XDP_RTF_UP (0x1)
+#define AERON_UDP_TRANSPORT_XDP_RTF_GATEWAY (0x2)
+#define AERON_UDP_TRANSPORT_XDP_ATF_COM (0x2)
+#define AERON_UDP_TRANSPORT_XDP_VERIFIER_LOG_LENGTH (4096)
+#define AERON_UDP_TRANSPORT_XDP_PATH_LENGTH (128)
+#define AERON_UDP_TRANSPORT_XDP_LOOPBACK_NET (0x7F000000)
+#define AERON_UDP_TRANSPORT_XDP_LOOPBACK_MASK (0xFF000000)
+#define AERON_UDP_TRANSPORT_XDP_RX_HEADROOM (256)
+#define AERON_UDP_TRANSPORT_XDP_MAX_RX_LENGTH \
+    (AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH - AERON_UDP_TRANSPORT_XDP_RX_HEADROOM)
+
+#define AERON_BPF_INSN(c, d, s, o, i) { (uint8_t)(c), (uint8_t)(d), (uint8_t)(s), (int16_t)(o), (int32_t)(i) }
+#define AERON_BPF_MOV64_REG(d, s) AERON_BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_X, d, s, 0, 0)
+#define AERON_BPF_MOV64_IMM(d, i) AERON_BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_K, d, 0, 0, i)
+#define AERON_BPF_ADD64_IMM(d, i) AERON_BPF_INSN(BPF_ALU64 | BPF_ADD | BPF_K, d, 0, 0, i)
+#define AERON_BPF_AND64_IMM(d, i) AERON_BPF_INSN(BPF_ALU64 | BPF_AND | BPF_K, d, 0, 0, i)
+#define AERON_BPF_LDX_MEM(size, d, s, o) AERON_BPF_INSN(BPF_LDX | BPF_MEM | (size), d, s, o, 0)
+#define AERON_BPF_STX_MEM(size, d, s, o) AERON_BPF_INSN(BPF_STX | BPF_MEM | (size), d, s, o, 0)
+#define AERON_BPF_JMP_REG(op, d, s, o) AERON_BPF_INSN(BPF_JMP | (op) | BPF_X, d, s, o, 0)
+#define AERON_BPF_JMP_IMM(op, d, i, o) AERON_BPF_INSN(BPF_JMP | (op) | BPF_K, d, 0, o, i)
+#define AERON_BPF_LD_MAP_FD(d, fd) \
+    AERON_BPF_INSN(BPF_LD | BPF_DW | BPF_IMM, d, BPF_PSEUDO_MAP_FD, 0, fd), AERON_BPF_INSN(0, 0, 0, 0, 0)
+#define AERON_BPF_CALL(f) AERON_BPF_INSN(BPF_JMP | BPF_CALL, 0, 0, 0, f)
+#define AERON_BPF_EXIT() AERON_BPF_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0)
+
+/* instruction the program passes packets on to the kernel from, so jumps to it are relative to where they are */
+#define AERON_UDP_TRANSPORT_XDP_PROG_PASS (32)
+#define AERON_UDP_TRANSPORT_XDP_TO_PASS(pc) (AERON_UDP_TRANSPORT_XDP_PROG_PASS - ((pc) + 1))
+
+static int aeron_bpf(int cmd, union bpf_attr *attr)
+{
+    return (int)syscall(__NR_bpf, cmd, attr, sizeof(union bpf_attr));
+}
+
+static int aeron_udp_transport_xdp_map_create(uint32_t map_type, uint32_t max_entries)
+{
+    union bpf_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_type = map_type;
+    attr.key_size = sizeof(uint32_t);
+    attr.value_size = sizeof(uint32_t);
+    attr.max_entries = max_entries;
+
+    int fd = aeron_bpf(BPF_MAP_CREATE, &attr);
+    if (fd < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "bpf(BPF_MAP_CREATE): %s", strerror(errcode));
+    }
+
+    return fd;
+}
+
+static int aeron_udp_transport_xdp_map_update(int map_fd, uint32_t key, uint32_t value)
+{
+    union bpf_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_fd = (uint32_t)map_fd;
+    attr.key = (uint64_t)(uintptr_t)&key;
+    attr.value = (uint64_t)(uintptr_t)&value;
+    attr.flags = BPF_ANY;
+
+    if (aeron_bpf(BPF_MAP_UPDATE_ELEM, &attr) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "bpf(BPF_MAP_UPDATE_ELEM): %s", strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+}
+
+static bool aeron_udp_transport_xdp_map_contains(int map_fd, uint32_t key)
+{
+    union bpf_attr attr;
+    uint32_t value;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_fd = (uint32_t)map_fd;
+    attr.key = (uint64_t)(uintptr_t)&key;
+    attr.value = (uint64_t)(uintptr_t)&value;
+
+    return aeron_bpf(BPF_MAP_LOOKUP_ELEM, &attr) >= 0;
+}
+
+static int aeron_udp_transport_xdp_map_delete(int map_fd, uint32_t key)
+{
+    union bpf_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_fd = (uint32_t)map_fd;
+    attr.key = (uint64_t)(uintptr_t)&key;
+
+    if (aeron_bpf(BPF_MAP_DELETE_ELEM, &attr) < 0 && ENOENT != errno)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "bpf(BPF_MAP_DELETE_ELEM): %s", strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Redirect unfragmented IPv4 UDP, without IP options, to a port in the ports map into the socket bound to the queue
+ * the packet arrived on. Anything else, including packets too long for a frame after the headroom the kernel copies
+ * them in at, or a queue without a socket, is passed on to the kernel.
+ */
+static int aeron_udp_transport_xdp_prog_load(aeron_udp_transport_xdp_t *xdp)
+{
+    struct bpf_insn prog[] =
+    {
+        /* 0 */ AERON_BPF_MOV64_REG(BPF_REG_6, BPF_REG_1),
+        /* 1 */ AERON_BPF_LDX_MEM(BPF_W, BPF_REG_2, BPF_REG_6, offsetof(struct xdp_md, data)),
+        /* 2 */ AERON_BPF_LDX_MEM(BPF_W, BPF_REG_3, BPF_REG_6, offsetof(struct xdp_md, data_end)),
+        /* 3 */ AERON_BPF_MOV64_REG(BPF_REG_4, BPF_REG_2),
+        /* 4 */ AERON_BPF_ADD64_IMM(BPF_REG_4, AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH),
+        /* 5 */ AERON_BPF_JMP_REG(BPF_JGT, BPF_REG_4, BPF_REG_3, AERON_UDP_TRANSPORT_XDP_TO_PASS(5)),
+        /* 6 */ AERON_BPF_MOV64_REG(BPF_REG_4, BPF_REG_2),
+        /* 7 */ AERON_BPF_ADD64_IMM(BPF_REG_4, AERON_UDP_TRANSPORT_XDP_MAX_RX_LENGTH),
+        /* 8 */ AERON_BPF_JMP_REG(BPF_JGT, BPF_REG_3, BPF_REG_4, AERON_UDP_TRANSPORT_XDP_TO_PASS(8)),
+        /* 9 */ AERON_BPF_LDX_MEM(BPF_H, BPF_REG_5, BPF_REG_2, 12),
+        /* 10 */ AERON_BPF_JMP_IMM(
+            BPF_JNE, BPF_REG_5, htons(AERON_UDP_TRANSPORT_XDP_ETH_P_IP), AERON_UDP_TRANSPORT_XDP_TO_PASS(10)),
+        /* 11 */ AERON_BPF_LDX_MEM(BPF_B, BPF_REG_5, BPF_REG_2, 14),
+        /* 12 */ AERON_BPF_JMP_IMM(
+            BPF_JNE, BPF_REG_5, AERON_UDP_TRANSPORT_XDP_IP_VERSION_IHL, AERON_UDP_TRANSPORT_XDP_TO_PASS(12)),
+        /* 13 */ AERON_BPF_LDX_MEM(BPF_B, BPF_REG_5, BPF_REG_2, 23),
+        /* 14 */ AERON_BPF_JMP_IMM(BPF_JNE, BPF_REG_5, IPPROTO_UDP, AERON_UDP_TRANSPORT_XDP_TO_PASS(14)),
+        /* 15 */ AERON_BPF_LDX_MEM(BPF_H, BPF_REG_5, BPF_REG_2, 20),
+        /* 16 */ AERON_BPF_AND64_IMM(BPF_REG_5, htons(AERON_UDP_TRANSPORT_XDP_IP_FRAGMENT_MASK)),
+        /* 17 */ AERON_BPF_JMP_IMM(BPF_JNE, BPF_REG_5, 0, AERON_UDP_TRANSPORT_XDP_TO_PASS(17)),
+        /* 18 */ AERON_BPF_LDX_MEM(BPF_H, BPF_REG_5, BPF_REG_2, 36),
+        /* 19 */ AERON_BPF_STX_MEM(BPF_W, BPF_REG_10, BPF_REG_5, -4),
+        /* 20 */ AERON_BPF_MOV64_REG(BPF_REG_2, BPF_REG_10),
+        /* 21 */ AERON_BPF_ADD64_IMM(BPF_REG_2, -4),
+        /* 22, 23 */ AERON_BPF_LD_MAP_FD(BPF_REG_1, xdp->ports_map_fd),
+        /* 24 */ AERON_BPF_CALL(BPF_FUNC_map_lookup_elem),
+        /* 25 */ AERON_BPF_JMP_IMM(BPF_JEQ, BPF_REG_0, 0, AERON_UDP_TRANSPORT_XDP_TO_PASS(25)),
+        /* 26 */ AERON_BPF_LDX_MEM(BPF_W, BPF_REG_2, BPF_REG_6, offsetof(struct xdp_md, rx_queue_index)),
+        /* 27, 28 */ AERON_BPF_LD_MAP_FD(BPF_REG_1, xdp->xsks_map_fd),
+        /* 29 */ AERON_BPF_MOV64_IMM(BPF_REG_3, XDP_PASS),
+        /* 30 */ AERON_BPF_CALL(BPF_FUNC_redirect_map),
+        /* 31 */ AERON_BPF_EXIT(),
+        /* 32 */ AERON_BPF_MOV64_IMM(BPF_REG_0, XDP_PASS),
+        /* 33 */ AERON_BPF_EXIT()
+    };
+    char log[AERON_UDP_TRANSPORT_XDP_VERIFIER_LOG_LENGTH];
+    union bpf_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    log[0] = '\0';
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insns = (uint64_t)(uintptr_t)prog;
+    attr.insn_cnt = sizeof(prog) / sizeof(prog[0]);
+    attr.license = (uint64_t)(uintptr_t)"Apache-2.0";
+    attr.log_buf = (uint64_t)(uintptr_t)log;
+    attr.log_size = sizeof(log);
+    attr.log_level = 1;
+
+    if ((xdp->prog_fd = aeron_bpf(BPF_PROG_LOAD, &attr)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "bpf(BPF_PROG_LOAD): %s %s", strerror(errcode), log);
+        return -1;
+    }
+
+    memset(&attr, 0, sizeof(attr));
+    attr.link_create.prog_fd = (uint32_t)xdp->prog_fd;
+    attr.link_create.target_ifindex = xdp->ifindex;
+    attr.link_create.attach_type = BPF_XDP;
+    attr.link_create.flags = XDP_FLAGS_SKB_MODE;
+
+    /* a link detaches the program when closed, including when the driver dies, so no program is left behind */
+    if ((xdp->link_fd = aeron_bpf(BPF_LINK_CREATE, &attr)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "bpf(BPF_LINK_CREATE) %s: %s", xdp->interface_name, strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+}
+
+static int aeron_udp_transport_xdp_interface_info(aeron_udp_transport_xdp_t *xdp)
+{
+    struct ifreq ifr;
+    int fd;
+
+    if ((fd = socket(AF_INET, SOCK_DGRAM, 0)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "socket: %s", strerror(errcode));
+        return -1;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    memcpy(ifr.ifr_name, xdp->interface_name, sizeof(ifr.ifr_name));
+
+    if (ioctl(fd, SIOCGIFFLAGS, &ifr) < 0)
+    {
+        goto error;
+    }
+
+    xdp->is_loopback = 0 != (ifr.ifr_flags & IFF_LOOPBACK);
+
+    if (ioctl(fd, SIOCGIFHWADDR, &ifr) < 0)
+    {
+        goto error;
+    }
+
+    memcpy(xdp->mac, ifr.ifr_hwaddr.sa_data, sizeof(xdp->mac));
+
+    ifr.ifr_addr.sa_family = AF_INET;
+    if (ioctl(fd, SIOCGIFADDR, &ifr) < 0)
+    {
+        goto error;
+    }
+
+    xdp->addr = ((struct sockaddr_in *)&ifr.ifr_addr)->sin_addr.s_addr;
+    close(fd);
+
+    char path[AERON_UDP_TRANSPORT_XDP_PATH_LENGTH];
+    snprintf(path, sizeof(path), "/proc/sys/net/ipv4/conf/%s/route_localnet", xdp->interface_name);
+
+    FILE *route_localnet = fopen(path, "r");
+    if (NULL != route_localnet)
+    {
+        int value = 0;
+
+        xdp->is_route_localnet = 1 == fscanf(route_localnet, "%d", &value) && 0 != value;
+        fclose(route_localnet);
+    }
+
+    return 0;
+
+    error:
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "ioctl %s: %s", xdp->interface_name, strerror(errcode));
+        close(fd);
+        return -1;
+    }
+}
+
+static int aeron_udp_transport_xdp_ring_map(
+    aeron_udp_transport_xdp_t *xdp,
+    aeron_udp_transport_xdp_ring_t *ring,
+    struct xdp_ring_offset *offsets,
+    uint32_t size,
+    size_t desc_length,
+    off_t pgoff)
+{
+    ring->map_length = offsets->desc + (size * desc_length);
+    ring->map = mmap(NULL, ring->map_length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, xdp->fd, pgoff);
+
+    if (MAP_FAILED == ring->map)
+    {
+        int errcode = errno;
+
+        ring->map = NULL;
+        aeron_set_err(errcode, "mmap AF_XDP ring: %s", strerror(errcode));
+        return -1;
+    }
+
+    ring->producer = (volatile uint32_t *)(ring->map + offsets->producer);
+    ring->consumer = (volatile uint32_t *)(ring->map + offsets->consumer);
+    ring->flags = (volatile uint32_t *)(ring->map + offsets->flags);
+    ring->descs = ring->map + offsets->desc;
+    ring->size = size;
+    ring->mask = size - 1;
+    ring->local_index = 0;
+
+    return 0;
+}
+
+static int aeron_udp_transport_xdp_setsockopt(aeron_udp_transport_xdp_t *xdp, int optname, void *value, size_t length)
+{
+    if (setsockopt(xdp->fd, SOL_XDP, optname, value, (socklen_t)length) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "setsockopt(SOL_XDP, %d): %s", optname, strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+}
+
+static int aeron_udp_transport_xdp_socket_init(aeron_udp_transport_xdp_t *xdp)
+{
+    const uint32_t ring_size = xdp->frame_count / 2;
+    struct xdp_umem_reg umem_reg;
+    struct xdp_mmap_offsets offsets;
+    socklen_t offsets_length = sizeof(offsets);
+    struct sockaddr_xdp sxdp;
+    uint32_t size = ring_size;
+
+    if ((xdp->fd = socket(AF_XDP, SOCK_RAW, 0)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "socket(AF_XDP): %s", strerror(errcode));
+        return -1;
+    }
+
+    xdp->umem_length = (size_t)xdp->frame_count * AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH;
+    xdp->umem = mmap(
+        NULL, xdp->umem_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (MAP_FAILED == xdp->umem)
+    {
+        int errcode = errno;
+
+        xdp->umem = NULL;
+        aeron_set_err(errcode, "mmap AF_XDP UMEM: %s", strerror(errcode));
+        return -1;
+    }
+
+    memset(&umem_reg, 0, sizeof(umem_reg));
+    umem_reg.addr = (uint64_t)(uintptr_t)xdp->umem;
+    umem_reg.len = xdp->umem_length;
+    umem_reg.chunk_size = AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH;
+    umem_reg.headroom = 0;
+
+    if (aeron_udp_transport_xdp_setsockopt(xdp, XDP_UMEM_REG, &umem_reg, sizeof(umem_reg)) < 0 ||
+        aeron_udp_transport_xdp_setsockopt(xdp, XDP_UMEM_FILL_RING, &size, sizeof(size)) < 0 ||
+        aeron_udp_transport_xdp_setsockopt(xdp, XDP_UMEM_COMPLETION_RING, &size, sizeof(size)) < 0 ||
+        aeron_udp_transport_xdp_setsockopt(xdp, XDP_RX_RING, &size, sizeof(size)) < 0 ||
+        aeron_udp_transport_xdp_setsockopt(xdp, XDP_TX_RING, &size, sizeof(size)) < 0)
+    {
+        return -1;
+    }
+
+    if (getsockopt(xdp->fd, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &offsets_length) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "getsockopt(XDP_MMAP_OFFSETS): %s", strerror(errcode));
+        return -1;
+    }
+
+    if (aeron_udp_transport_xdp_ring_map(
+        xdp, &xdp->fill, &offsets.fr, ring_size, sizeof(uint64_t), XDP_UMEM_PGOFF_FILL_RING) < 0 ||
+        aeron_udp_transport_xdp_ring_map(
+            xdp, &xdp->completion, &offsets.cr, ring_size, sizeof(uint64_t), XDP_UMEM_PGOFF_COMPLETION_RING) < 0 ||
+        aeron_udp_transport_xdp_ring_map(
+            xdp, &xdp->rx, &offsets.rx, ring_size, sizeof(struct xdp_desc), XDP_PGOFF_RX_RING) < 0 ||
+        aeron_udp_transport_xdp_ring_map(
+            xdp, &xdp->tx, &offsets.tx, ring_size, sizeof(struct xdp_desc), XDP_PGOFF_TX_RING) < 0)
+    {
+        return -1;
+    }
+
+    /* the first half of the frames are handed to the kernel to receive into, the second half are for sending */
+    for (uint32_t i = 0; i < ring_size; i++)
+    {
+        ((uint64_t *)xdp->fill.descs)[i] = (uint64_t)i * AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH;
+    }
+
+    xdp->fill.local_index = ring_size;
+    AERON_PUT_ORDERED(*xdp->fill.producer, xdp->fill.local_index);
+
+    if (aeron_alloc((void **)&xdp->tx_free_frames, ring_size * sizeof(uint64_t)) < 0)
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < ring_size; i++)
+    {
+        xdp->tx_free_frames[i] = (uint64_t)(ring_size + i) * AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH;
+    }
+
+    xdp->tx_free_length = ring_size;
+
+    memset(&sxdp, 0, sizeof(sxdp));
+    sxdp.sxdp_family = AF_XDP;
+    sxdp.sxdp_ifindex = xdp->ifindex;
+    sxdp.sxdp_queue_id = xdp->queue_id;
+    sxdp.sxdp_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+
+    if (bind(xdp->fd, (struct sockaddr *)&sxdp, sizeof(sxdp)) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(
+            errcode, "bind AF_XDP %s queue %u: %s", xdp->interface_name, xdp->queue_id, strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+}
+
+int aeron_udp_transport_xdp_init(
+    aeron_udp_transport_xdp_t **xdp, const char *interface_name, uint32_t queue_id, uint32_t frame_count)
+{
+    aeron_udp_transport_xdp_t *_xdp = NULL;
+
+    if (!AERON_IS_POWER_OF_TWO(frame_count) || frame_count < 2)
+    {
+        aeron_set_err(EINVAL, "AF_XDP frame count must be a power of 2: %u", frame_count);
+        return -1;
+    }
+
+    if (aeron_alloc((void **)&_xdp, sizeof(aeron_udp_transport_xdp_t)) < 0)
+    {
+        aeron_set_err(ENOMEM, "%s", "could not allocate AF_XDP transport");
+        return -1;
+    }
+
+    _xdp->fd = -1;
+    _xdp->prog_fd = -1;
+    _xdp->link_fd = -1;
+    _xdp->ports_map_fd = -1;
+    _xdp->xsks_map_fd = -1;
+    _xdp->queue_id = queue_id;
+    _xdp->frame_count = frame_count;
+    snprintf(_xdp->interface_name, sizeof(_xdp->interface_name), "%s", interface_name);
+
+    if (0 == (_xdp->ifindex = if_nametoindex(_xdp->interface_name)))
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "if_nametoindex %s: %s", _xdp->interface_name, strerror(errcode));
+        goto error;
+    }
+
+    if (aeron_udp_transport_xdp_interface_info(_xdp) < 0 ||
+        aeron_udp_transport_xdp_socket_init(_xdp) < 0)
+    {
+        goto error;
+    }
+
+    if ((_xdp->ports_map_fd = aeron_udp_transport_xdp_map_create(
+        BPF_MAP_TYPE_HASH, AERON_UDP_TRANSPORT_XDP_MAX_PORTS)) < 0 ||
+        (_xdp->xsks_map_fd = aeron_udp_transport_xdp_map_create(BPF_MAP_TYPE_XSKMAP, queue_id + 1)) < 0 ||
+        aeron_udp_transport_xdp_map_update(_xdp->xsks_map_fd, queue_id, (uint32_t)_xdp->fd) < 0 ||
+        aeron_udp_transport_xdp_prog_load(_xdp) < 0)
+    {
+        goto error;
+    }
+
+    *xdp = _xdp;
+    return 0;
+
+    error:
+        aeron_udp_transport_xdp_close(_xdp);
+        return -1;
+}
+
+static void aeron_udp_transport_xdp_ring_unmap(aeron_udp_transport_xdp_ring_t *ring)
+{
+    if (NULL != ring->map)
+    {
+        munmap(ring->map, ring->map_length);
+        ring->map = NULL;
+    }
+}
+
+int aeron_udp_transport_xdp_close(aeron_udp_transport_xdp_t *xdp)
+{
+    if (NULL == xdp)
+    {
+        return 0;
+    }
+
+    if (xdp->link_fd >= 0)
+    {
+        close(xdp->link_fd);
+    }
+
+    if (xdp->prog_fd >= 0)
+    {
+        close(xdp->prog_fd);
+    }
+
+    if (xdp->ports_map_fd >= 0)
+    {
+        close(xdp->ports_map_fd);
+    }
+
+    if (xdp->xsks_map_fd >= 0)
+    {
+        close(xdp->xsks_map_fd);
+    }
+
+    aeron_udp_transport_xdp_ring_unmap(&xdp->fill);
+    aeron_udp_transport_xdp_ring_unmap(&xdp->completion);
+    aeron_udp_transport_xdp_ring_unmap(&xdp->rx);
+    aeron_udp_transport_xdp_ring_unmap(&xdp->tx);
+
+    if (xdp->fd >= 0)
+    {
+        close(xdp->fd);
+    }
+
+    if (NULL != xdp->umem)
+    {
+        munmap(xdp->umem, xdp->umem_length);
+    }
+
+    aeron_free(xdp->tx_free_frames);
+    aeron_free(xdp->ports.array);
+    aeron_free(xdp->routes.array);
+    aeron_free(xdp);
+
+    return 0;
+}
+
+static int aeron_udp_transport_xdp_local_port(aeron_udp_channel_transport_t *transport, uint16_t *port)
+{
+    struct sockaddr_storage addr;
+    socklen_t addr_length = sizeof(addr);
+
+    if (getsockname(transport->fd, (struct sockaddr *)&addr, &addr_length) < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "getsockname: %s", strerror(errcode));
+        return -1;
+    }
+
+    *port = AF_INET == addr.ss_family ? ((struct sockaddr_in *)&addr)->sin_port : 0;
+    return 0;
+}
+
+int aeron_udp_transport_xdp_add(aeron_udp_transport_xdp_t *xdp, aeron_udp_channel_transport_t *transport)
+{
+    int ensure_capacity_result = 0;
+    uint16_t port;
+
+    if (aeron_udp_transport_xdp_local_port(transport, &port) < 0)
+    {
+        return -1;
+    }
+
+    if (0 == port)
+    {
+        return 0;
+    }
+
+    if (xdp->ports.length >= AERON_UDP_TRANSPORT_XDP_MAX_PORTS)
+    {
+        aeron_set_err(ENOSPC, "AF_XDP transport limited to %d ports", AERON_UDP_TRANSPORT_XDP_MAX_PORTS);
+        return -1;
+    }
+
+    AERON_ARRAY_ENSURE_CAPACITY(ensure_capacity_result, xdp->ports, aeron_udp_transport_xdp_port_t);
+    if (ensure_capacity_result < 0)
+    {
+        return -1;
+    }
+
+    xdp->ports.array[xdp->ports.length].port = port;
+    xdp->ports.array[xdp->ports.length].transport = transport;
+    xdp->ports.length++;
+
+    return aeron_udp_transport_xdp_map_update(xdp->ports_map_fd, port, 1);
+}
+
+int aeron_udp_transport_xdp_remove(aeron_udp_transport_xdp_t *xdp, aeron_udp_channel_transport_t *transport)
+{
+    for (int last_index = (int)xdp->ports.length - 1, i = last_index; i >= 0; i--)
+    {
+        if (xdp->ports.array[i].transport == transport)
+        {
+            const uint16_t port = xdp->ports.array[i].port;
+
+            aeron_array_fast_unordered_remove(
+                (uint8_t *)xdp->ports.array, sizeof(aeron_udp_transport_xdp_port_t), (size_t)i, (size_t)last_index);
+            xdp->ports.length--;
+
+            return aeron_udp_transport_xdp_map_delete(xdp->ports_map_fd, port);
+        }
+    }
+
+    return 0;
+}
+
+static aeron_udp_channel_transport_t *aeron_udp_transport_xdp_find_transport(
+    aeron_udp_transport_xdp_t *xdp, uint16_t port)
+{
+    for (size_t i = 0, length = xdp->ports.length; i < length; i++)
+    {
+        if (port == xdp->ports.array[i].port)
+        {
+            return xdp->ports.array[i].transport;
+        }
+    }
+
+    return NULL;
+}
+
+int aeron_udp_transport_xdp_poll(
+    aeron_udp_transport_xdp_t *xdp,
+    int64_t *bytes_received,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd)
+{
+    uint32_t rx_producer;
+    AERON_GET_VOLATILE(rx_producer, *xdp->rx.producer);
+
+    uint32_t available = rx_producer - xdp->rx.local_index;
+    if (0 == available)
+    {
+        return 0;
+    }
+
+    available = available > AERON_UDP_TRANSPORT_XDP_RX_BATCH ? AERON_UDP_TRANSPORT_XDP_RX_BATCH : available;
+    int work_count = 0;
+
+    for (uint32_t i = 0; i < available; i++)
+    {
+        struct xdp_desc *desc = &((struct xdp_desc *)xdp->rx.descs)[xdp->rx.local_index & xdp->rx.mask];
+        uint8_t *frame = xdp->umem + desc->addr;
+        uint8_t *ip = frame + AERON_UDP_TRANSPORT_XDP_ETH_HEADER_LENGTH;
+        uint8_t *udp = ip + AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH;
+        uint16_t udp_length;
+
+        memcpy(&udp_length, udp + 4, sizeof(udp_length));
+        udp_length = ntohs(udp_length);
+
+        if (desc->len >= AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH &&
+            udp_length >= AERON_UDP_TRANSPORT_XDP_UDP_HEADER_LENGTH &&
+            (uint32_t)udp_length <=
+                desc->len - AERON_UDP_TRANSPORT_XDP_ETH_HEADER_LENGTH - AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH)
+        {
+            uint16_t dst_port;
+            memcpy(&dst_port, udp + 2, sizeof(dst_port));
+
+            aeron_udp_channel_transport_t *transport = aeron_udp_transport_xdp_find_transport(xdp, dst_port);
+            if (NULL != transport)
+            {
+                struct sockaddr_storage addr;
+                struct sockaddr_in *in4 = (struct sockaddr_in *)&addr;
+                const size_t length = udp_length - AERON_UDP_TRANSPORT_XDP_UDP_HEADER_LENGTH;
+
+                memset(&addr, 0, sizeof(addr));
+                in4->sin_family = AF_INET;
+                memcpy(&in4->sin_addr.s_addr, ip + 12, sizeof(in4->sin_addr.s_addr));
+                memcpy(&in4->sin_port, udp, sizeof(in4->sin_port));
+
+                /* dispatched straight out of the UMEM frame, which only goes back to the kernel after this */
+                transport->recv_timestamp_ns = 0;
+                recv_func(
+                    clientd,
+                    transport->dispatch_clientd,
+                    transport->destination_clientd,
+                    udp + AERON_UDP_TRANSPORT_XDP_UDP_HEADER_LENGTH,
+                    length,
+                    &addr);
+
+                *bytes_received += (int64_t)length;
+                work_count++;
+            }
+        }
+
+        ((uint64_t *)xdp->fill.descs)[xdp->fill.local_index & xdp->fill.mask] =
+            desc->addr & ~((uint64_t)AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH - 1);
+        xdp->fill.local_index++;
+        xdp->rx.local_index++;
+    }
+
+    AERON_PUT_ORDERED(*xdp->rx.consumer, xdp->rx.local_index);
+    AERON_PUT_ORDERED(*xdp->fill.producer, xdp->fill.local_index);
+
+    uint32_t fill_flags;
+    AERON_GET_VOLATILE(fill_flags, *xdp->fill.flags);
+    if (fill_flags & XDP_RING_NEED_WAKEUP)
+    {
+        recvfrom(xdp->fd, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+    }
+
+    return work_count;
+}
+
+int aeron_udp_transport_xdp_attach_sender(aeron_udp_transport_xdp_t *xdp, aeron_udp_channel_transport_t *transport)
+{
+    if (aeron_udp_transport_xdp_local_port(transport, &transport->xdp_src_port) < 0)
+    {
+        return -1;
+    }
+
+    transport->xdp = 0 != transport->xdp_src_port ? xdp : NULL;
+    return 0;
+}
+
+static bool aeron_udp_transport_xdp_next_hop(aeron_udp_transport_xdp_t *xdp, uint32_t dst_addr, uint32_t *next_hop)
+{
+    char line[256];
+    char iface[IF_NAMESIZE + 1];
+    uint32_t destination, gateway, mask, best_mask = 0;
+    unsigned int flags;
+    bool is_found = false;
+    FILE *routes = fopen("/proc/net/route", "r");
+
+    if (NULL == routes)
+    {
+        return false;
+    }
+
+    /* values are the raw network order words printed as hex, so compare directly with the address */
+    while (NULL != fgets(line, sizeof(line), routes))
+    {
+        if (5 == sscanf(line, "%16s %x %x %x %*d %*d %*d %x", iface, &destination, &gateway, &flags, &mask) &&
+            0 == strcmp(iface, xdp->interface_name) &&
+            (flags & AERON_UDP_TRANSPORT_XDP_RTF_UP) &&
+            (dst_addr & mask) == destination &&
+            (!is_found || ntohl(mask) > ntohl(best_mask)))
+        {
+            *next_hop = (flags & AERON_UDP_TRANSPORT_XDP_RTF_GATEWAY) ? gateway : dst_addr;
+            best_mask = mask;
+            is_found = true;
+        }
+    }
+
+    fclose(routes);
+    return is_found;
+}
+
+static bool aeron_udp_transport_xdp_neighbour(aeron_udp_transport_xdp_t *xdp, uint32_t addr, uint8_t *mac)
+{
+    char line[256];
+    char ip[INET_ADDRSTRLEN + 1], hw[32], device[IF_NAMESIZE + 1];
+    unsigned int hw_type, flags;
+    struct in_addr in;
+    bool is_found = false;
+    FILE *neighbours = fopen("/proc/net/arp", "r");
+
+    if (NULL == neighbours)
+    {
+        return false;
+    }
+
+    while (!is_found && NULL != fgets(line, sizeof(line), neighbours))
+    {
+        is_found =
+            5 == sscanf(line, "%16s %x %x %31s %*s %16s", ip, &hw_type, &flags, hw, device) &&
+            1 == inet_pton(AF_INET, ip, &in) &&
+            in.s_addr == addr &&
+            (flags & AERON_UDP_TRANSPORT_XDP_ATF_COM) &&
+            0 == strcmp(device, xdp->interface_name) &&
+            6 == sscanf(hw, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx", &mac[0], &mac[1], &mac[2], &mac[3], &mac[4], &mac[5]);
+    }
+
+    fclose(neighbours);
+    return is_found;
+}
+
+static void aeron_udp_transport_xdp_resolve(
+    aeron_udp_transport_xdp_t *xdp, aeron_udp_transport_xdp_route_t *route, int64_t now_ns)
+{
+    uint8_t dst_mac[6] = { 0 };
+    uint32_t next_hop;
+
+    route->is_resolved = false;
+    route->resolve_deadline_ns = now_ns + AERON_UDP_TRANSPORT_XDP_ROUTE_RETRY_NS;
+
+    /*
+     * Frames from the TX ring enter the stack without a route, so the kernel routes them as if received, which drops
+     * loopback addresses unless route_localnet is set. Those only get through when redirected to a socket beforehand.
+     */
+    if ((ntohl(route->dst_addr) & AERON_UDP_TRANSPORT_XDP_LOOPBACK_MASK) == AERON_UDP_TRANSPORT_XDP_LOOPBACK_NET &&
+        !xdp->is_route_localnet && !aeron_udp_transport_xdp_map_contains(xdp->ports_map_fd, route->dst_port))
+    {
+        return;
+    }
+
+    if (!xdp->is_loopback &&
+        (!aeron_udp_transport_xdp_next_hop(xdp, route->dst_addr, &next_hop) ||
+        !aeron_udp_transport_xdp_neighbour(xdp, next_hop, dst_mac)))
+    {
+        return;
+    }
+
+    uint8_t *eth = route->header;
+    uint8_t *ip = eth + AERON_UDP_TRANSPORT_XDP_ETH_HEADER_LENGTH;
+    uint8_t *udp = ip + AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH;
+    const uint16_t eth_type = htons(AERON_UDP_TRANSPORT_XDP_ETH_P_IP);
+    const uint16_t ip_flags = htons(AERON_UDP_TRANSPORT_XDP_IP_FLAGS_DF);
+
+    memset(route->header, 0, sizeof(route->header));
+    memcpy(eth, dst_mac, sizeof(dst_mac));
+    memcpy(eth + 6, xdp->mac, sizeof(xdp->mac));
+    memcpy(eth + 12, &eth_type, sizeof(eth_type));
+
+    ip[0] = AERON_UDP_TRANSPORT_XDP_IP_VERSION_IHL;
+    memcpy(ip + 6, &ip_flags, sizeof(ip_flags));
+    ip[8] = AERON_UDP_TRANSPORT_XDP_IP_TTL;
+    ip[9] = IPPROTO_UDP;
+    memcpy(ip + 12, &xdp->addr, sizeof(xdp->addr));
+    memcpy(ip + 16, &route->dst_addr, sizeof(route->dst_addr));
+
+    /* a zero UDP checksum means none for IPv4, which saves summing the whole payload */
+    memcpy(udp, &route->src_port, sizeof(route->src_port));
+    memcpy(udp + 2, &route->dst_port, sizeof(route->dst_port));
+
+    route->is_resolved = true;
+    route->resolve_deadline_ns = now_ns + AERON_UDP_TRANSPORT_XDP_ROUTE_EXPIRY_NS;
+}
+
+aeron_udp_transport_xdp_route_t *aeron_udp_transport_xdp_route(
+    aeron_udp_transport_xdp_t *xdp, uint16_t src_port, struct sockaddr_in *dst, int64_t now_ns)
+{
+    aeron_udp_transport_xdp_route_t *route = NULL;
+
+    for (size_t i = 0, length = xdp->routes.length; i < length; i++)
+    {
+        route = &xdp->routes.array[i];
+
+        if (src_port == route->src_port && dst->sin_port == route->dst_port &&
+            dst->sin_addr.s_addr == route->dst_addr)
+        {
+            if (now_ns - route->resolve_deadline_ns >= 0)
+            {
+                aeron_udp_transport_xdp_resolve(xdp, route, now_ns);
+            }
+
+            route->last_used_ns = now_ns;
+            return route;
+        }
+    }
+
+    if (xdp->routes.length < AERON_UDP_TRANSPORT_XDP_MAX_ROUTES)
+    {
+        int ensure_capacity_result = 0;
+
+        AERON_ARRAY_ENSURE_CAPACITY(ensure_capacity_result, xdp->routes, aeron_udp_transport_xdp_route_t);
+        if (ensure_capacity_result < 0)
+        {
+            return NULL;
+        }
+
+        route = &xdp->routes.array[xdp->routes.length++];
+    }
+    else
+    {
+        route = &xdp->routes.array[0];
+
+        for (size_t i = 1, length = xdp->routes.length; i < length; i++)
+        {
+            if (xdp->routes.array[i].last_used_ns - route->last_used_ns < 0)
+            {
+                route = &xdp->routes.array[i];
+            }
+        }
+    }
+
+    route->src_port = src_port;
+    route->dst_port = dst->sin_port;
+    route->dst_addr = dst->sin_addr.s_addr;
+    route->last_used_ns = now_ns;
+    aeron_udp_transport_xdp_resolve(xdp, route, now_ns);
+
+    return route;
+}
+
+static uint16_t aeron_udp_transport_xdp_ip_checksum(const uint8_t *ip)
+{
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH; i += 2)
+    {
+        sum += ((uint32_t)ip[i] << 8) | ip[i + 1];
+    }
+
+    while (sum >> 16)
+    {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+
+    return htons((uint16_t)~sum);
+}
+
+size_t aeron_udp_transport_xdp_frame(
+    const aeron_udp_transport_xdp_route_t *route, uint8_t *frame, const struct msghdr *message, size_t length)
+{
+    uint8_t *ip = frame + AERON_UDP_TRANSPORT_XDP_ETH_HEADER_LENGTH;
+    uint8_t *udp = ip + AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH;
+    uint8_t *payload = frame + AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH;
+    const uint16_t ip_length = htons((uint16_t)(length + AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH +
+        AERON_UDP_TRANSPORT_XDP_UDP_HEADER_LENGTH));
+    const uint16_t udp_length = htons((uint16_t)(length + AERON_UDP_TRANSPORT_XDP_UDP_HEADER_LENGTH));
+
+    memcpy(frame, route->header, AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH);
+    memcpy(ip + 2, &ip_length, sizeof(ip_length));
+    memcpy(udp + 4, &udp_length, sizeof(udp_length));
+
+    const uint16_t ip_checksum = aeron_udp_transport_xdp_ip_checksum(ip);
+    memcpy(ip + 10, &ip_checksum, sizeof(ip_checksum));
+
+    for (size_t i = 0; i < message->msg_iovlen; i++)
+    {
+        memcpy(payload, message->msg_iov[i].iov_base, message->msg_iov[i].iov_len);
+        payload += message->msg_iov[i].iov_len;
+    }
+
+    return length + AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH;
+}
+
+static void aeron_udp_transport_xdp_reclaim(aeron_udp_transport_xdp_t *xdp)
+{
+    uint32_t completion_producer;
+    AERON_GET_VOLATILE(completion_producer, *xdp->completion.producer);
+
+    if (completion_producer != xdp->completion.local_index)
+    {
+        while (xdp->completion.local_index != completion_producer)
+        {
+            xdp->tx_free_frames[xdp->tx_free_length++] =
+                ((uint64_t *)xdp->completion.descs)[xdp->completion.local_index & xdp->completion.mask];
+            xdp->completion.local_index++;
+        }
+
+        AERON_PUT_ORDERED(*xdp->completion.consumer, xdp->completion.local_index);
+    }
+}
+
+static int aeron_udp_transport_xdp_kernel_send(aeron_udp_channel_transport_t *transport, struct mmsghdr *mmsghdr)
+{
+    ssize_t sendmsg_result = sendmsg(transport->fd, &mmsghdr->msg_hdr, 0);
+    if (sendmsg_result < 0)
+    {
+        int errcode = errno;
+
+        aeron_set_err(errcode, "sendmsg: %s", strerror(errcode));
+        return -1;
+    }
+
+    mmsghdr->msg_len = (unsigned int)sendmsg_result;
+    return 0;
+}
+
+int aeron_udp_transport_xdp_sendmmsg(
+    aeron_udp_transport_xdp_t *xdp,
+    aeron_udp_channel_transport_t *transport,
+    struct mmsghdr *msgvec,
+    size_t vlen)
+{
+    uint32_t tx_consumer;
+    int sent = 0, xdp_sent = 0;
+    const int64_t now_ns = aeron_nano_clock();
+
+    aeron_udp_transport_xdp_reclaim(xdp);
+    AERON_GET_VOLATILE(tx_consumer, *xdp->tx.consumer);
+
+    for (size_t i = 0; i < vlen; i++)
+    {
+        struct msghdr *message = &msgvec[i].msg_hdr;
+        struct sockaddr_in *dst = (struct sockaddr_in *)message->msg_name;
+        aeron_udp_transport_xdp_route_t *route = NULL;
+        size_t length = 0;
+
+        for (size_t j = 0; j < message->msg_iovlen; j++)
+        {
+            length += message->msg_iov[j].iov_len;
+        }
+
+        /* segmentation offload, IPv6, and jumbo datagrams are all left to the kernel */
+        if (NULL != dst && AF_INET == dst->sin_family && 0 == message->msg_controllen &&
+            length <= AERON_UDP_TRANSPORT_XDP_MAX_PAYLOAD_LENGTH &&
+            NULL == (route = aeron_udp_transport_xdp_route(xdp, transport->xdp_src_port, dst, now_ns)))
+        {
+            return sent > 0 ? sent : -1;
+        }
+
+        if (NULL == route || !route->is_resolved)
+        {
+            if (aeron_udp_transport_xdp_kernel_send(transport, &msgvec[i]) < 0)
+            {
+                return sent > 0 ? sent : -1;
+            }
+
+            sent++;
+            continue;
+        }
+
+        if (0 == xdp->tx_free_length || xdp->tx.local_index - tx_consumer >= xdp->tx.size)
+        {
+            break;
+        }
+
+        const uint64_t frame_addr = xdp->tx_free_frames[--xdp->tx_free_length];
+
+        struct xdp_desc *desc = &((struct xdp_desc *)xdp->tx.descs)[xdp->tx.local_index & xdp->tx.mask];
+        desc->addr = frame_addr;
+        desc->len = (uint32_t)aeron_udp_transport_xdp_frame(route, xdp->umem + frame_addr, message, length);
+        desc->options = 0;
+        xdp->tx.local_index++;
+
+        msgvec[i].msg_len = (unsigned int)length;
+        xdp_sent++;
+        sent++;
+    }
+
+    if (xdp_sent > 0)
+    {
+        uint32_t tx_flags;
+
+        AERON_PUT_ORDERED(*xdp->tx.producer, xdp->tx.local_index);
+
+        /* in copy mode the kernel only transmits when asked */
+        AERON_GET_VOLATILE(tx_flags, *xdp->tx.flags);
+        if ((tx_flags & XDP_RING_NEED_WAKEUP) && sendto(xdp->fd, NULL, 0, MSG_DONTWAIT, NULL, 0) < 0)
+        {
+            int errcode = errno;
+
+            if (EAGAIN != errcode && EBUSY != errcode && ENOBUFS != errcode && ENETDOWN != errcode)
+            {
+                aeron_set_err(errcode, "sendto AF_XDP: %s", strerror(errcode));
+                return -1;
+            }
+        }
+    }
+
+    return sent;
+}
+
+#else
+
+int aeron_udp_transport_xdp_init(
+    aeron_udp_transport_xdp_t **xdp, const char *interface_name, uint32_t queue_id, uint32_t frame_count)
+{
+    aeron_set_err(ENOTSUP, "AF_XDP: %s", strerror(ENOTSUP));
+    return -1;
+}
+
+int aeron_udp_transport_xdp_close(aeron_udp_transport_xdp_t *xdp)
+{
+    return 0;
+}
+
+int aeron_udp_transport_xdp_add(aeron_udp_transport_xdp_t *xdp, aeron_udp_channel_transport_t *transport)
+{
+    aeron_set_err(ENOTSUP, "AF_XDP: %s", strerror(ENOTSUP));
+    return -1;
+}
+
+int aeron_udp_transport_xdp_remove(aeron_udp_transport_xdp_t *xdp, aeron_udp_channel_transport_t *transport)
+{
+    return 0;
+}
+
+int aeron_udp_transport_xdp_poll(
+    aeron_udp_transport_xdp_t *xdp,
+    int64_t *bytes_received,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd)
+{
+    return 0;
+}
+
+int aeron_udp_transport_xdp_attach_sender(aeron_udp_transport_xdp_t *xdp, aeron_udp_channel_transport_t *transport)
+{
+    aeron_set_err(ENOTSUP, "AF_XDP: %s", strerror(ENOTSUP));
+    return -1;
+}
+
+int aeron_udp_transport_xdp_sendmmsg(
+    aeron_udp_transport_xdp_t *xdp,
+    aeron_udp_channel_transport_t *transport,
+    struct mmsghdr *msgvec,
+    size_t vlen)
+{
+    aeron_set_err(ENOTSUP, "AF_XDP: %s", strerror(ENOTSUP));
+    return -1;
+}
+
+aeron_udp_transport_xdp_route_t *aeron_udp_transport_xdp_route(
+    aeron_udp_transport_xdp_t *xdp, uint16_t src_port, struct sockaddr_in *dst, int64_t now_ns)
+{
+    aeron_set_err(ENOTSUP, "AF_XDP: %s", strerror(ENOTSUP));
+    return NULL;
+}
+
+size_t aeron_udp_transport_xdp_frame(
+    const aeron_udp_transport_xdp_route_t *route, uint8_t *frame, const struct msghdr *message, size_t length)
+{
+    return 0;
+}
+
+#endif
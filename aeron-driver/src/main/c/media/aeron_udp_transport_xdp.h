@@ -0,0 +1,195 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AERON_UDP_TRANSPORT_XDP_H
+#define AERON_UDP_TRANSPORT_XDP_H
+
+#include <net/if.h>
+
+#include "media/aeron_udp_channel_transport.h"
+
+#define AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH (4096)
+#define AERON_UDP_TRANSPORT_XDP_ETH_HEADER_LENGTH (14)
+#define AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH (20)
+#define AERON_UDP_TRANSPORT_XDP_UDP_HEADER_LENGTH (8)
+#define AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH \
+    (AERON_UDP_TRANSPORT_XDP_ETH_HEADER_LENGTH + AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH + \
+    AERON_UDP_TRANSPORT_XDP_UDP_HEADER_LENGTH)
+#define AERON_UDP_TRANSPORT_XDP_MAX_PAYLOAD_LENGTH \
+    (AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH - AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH)
+#define AERON_UDP_TRANSPORT_XDP_MAX_PORTS (64)
+#define AERON_UDP_TRANSPORT_XDP_RX_BATCH (64)
+#define AERON_UDP_TRANSPORT_XDP_MAX_ROUTES (256)
+#define AERON_UDP_TRANSPORT_XDP_ROUTE_RETRY_NS (10 * 1000 * 1000LL)
+#define AERON_UDP_TRANSPORT_XDP_ROUTE_EXPIRY_NS (1000 * 1000 * 1000LL)
+
+/*
+ * Single producer, single consumer ring shared with the kernel. The local producer or consumer index runs ahead of
+ * the shared one until a batch is released.
+ */
+typedef struct aeron_udp_transport_xdp_ring_stct
+{
+    volatile uint32_t *producer;
+    volatile uint32_t *consumer;
+    volatile uint32_t *flags;
+    void *descs;
+    uint8_t *map;
+    size_t map_length;
+    uint32_t mask;
+    uint32_t size;
+    uint32_t local_index;
+}
+aeron_udp_transport_xdp_ring_t;
+
+typedef struct aeron_udp_transport_xdp_port_stct
+{
+    uint16_t port;
+    aeron_udp_channel_transport_t *transport;
+}
+aeron_udp_transport_xdp_port_t;
+
+/*
+ * Everything up to the lengths and IP checksum of a datagram from a local port to a destination, resolved from the
+ * routing and neighbour tables. Until the next hop is resolved datagrams go through the kernel socket instead, which
+ * also gets the kernel to resolve it. Resolved routes expire so changes to the tables are picked up, and unresolved
+ * ones are retried sooner.
+ */
+typedef struct aeron_udp_transport_xdp_route_stct
+{
+    uint16_t src_port;
+    uint16_t dst_port;
+    uint32_t dst_addr;
+    uint8_t header[AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH];
+    bool is_resolved;
+    int64_t resolve_deadline_ns;
+    int64_t last_used_ns;
+}
+aeron_udp_transport_xdp_route_t;
+
+/*
+ * An AF_XDP socket on one interface queue shared by the driver. An XDP program in generic mode, so it works with
+ * any NIC, veth, or loopback, redirects unfragmented IPv4 UDP to the ports of registered receive transports into the
+ * socket and passes everything else on to the kernel. The receiver owns the RX and fill rings and dispatches frames
+ * straight out of the UMEM. The sender owns the TX and completion rings and frames its datagrams in the UMEM.
+ */
+typedef struct aeron_udp_transport_xdp_stct
+{
+    int fd;
+    int prog_fd;
+    int link_fd;
+    int ports_map_fd;
+    int xsks_map_fd;
+    unsigned int ifindex;
+    uint32_t queue_id;
+    bool is_loopback;
+    bool is_route_localnet;
+    char interface_name[IF_NAMESIZE];
+    uint8_t mac[6];
+    uint32_t addr;
+
+    uint8_t *umem;
+    size_t umem_length;
+    uint32_t frame_count;
+
+    aeron_udp_transport_xdp_ring_t fill;
+    aeron_udp_transport_xdp_ring_t completion;
+    aeron_udp_transport_xdp_ring_t rx;
+    aeron_udp_transport_xdp_ring_t tx;
+
+    uint64_t *tx_free_frames;
+    uint32_t tx_free_length;
+
+    struct aeron_udp_transport_xdp_ports_stct
+    {
+        aeron_udp_transport_xdp_port_t *array;
+        size_t length;
+        size_t capacity;
+    }
+    ports;
+
+    struct aeron_udp_transport_xdp_routes_stct
+    {
+        aeron_udp_transport_xdp_route_t *array;
+        size_t length;
+        size_t capacity;
+    }
+    routes;
+}
+aeron_udp_transport_xdp_t;
+
+/**
+ * Create an AF_XDP socket bound to an interface queue and attach the XDP program that feeds it.
+ *
+ * @param xdp to allocate and initialise.
+ * @param interface_name to attach to.
+ * @param queue_id of the interface to bind to.
+ * @param frame_count of the UMEM, a power of 2, half of which are for receiving and half for sending.
+ * @return 0 for success and -1 for error.
+ */
+int aeron_udp_transport_xdp_init(
+    aeron_udp_transport_xdp_t **xdp, const char *interface_name, uint32_t queue_id, uint32_t frame_count);
+
+int aeron_udp_transport_xdp_close(aeron_udp_transport_xdp_t *xdp);
+
+/**
+ * Have datagrams to the port the transport is bound to redirected to the AF_XDP socket and dispatched as if received
+ * by the transport. Transports not bound to IPv4 are left to the kernel.
+ */
+int aeron_udp_transport_xdp_add(aeron_udp_transport_xdp_t *xdp, aeron_udp_channel_transport_t *transport);
+int aeron_udp_transport_xdp_remove(aeron_udp_transport_xdp_t *xdp, aeron_udp_channel_transport_t *transport);
+
+/**
+ * Dispatch datagrams from the RX ring and give their frames back to the fill ring.
+ *
+ * @return number of datagrams dispatched or -1 for error.
+ */
+int aeron_udp_transport_xdp_poll(
+    aeron_udp_transport_xdp_t *xdp,
+    int64_t *bytes_received,
+    aeron_udp_transport_recv_func_t recv_func,
+    void *clientd);
+
+/**
+ * Send the transport's batches through the AF_XDP socket from here on, where the destination can be resolved.
+ */
+int aeron_udp_transport_xdp_attach_sender(aeron_udp_transport_xdp_t *xdp, aeron_udp_channel_transport_t *transport);
+
+int aeron_udp_transport_xdp_sendmmsg(
+    aeron_udp_transport_xdp_t *xdp,
+    aeron_udp_channel_transport_t *transport,
+    struct mmsghdr *msgvec,
+    size_t vlen);
+
+/**
+ * Find the route from a local port to a destination, resolving it again once its deadline has passed. A new route is
+ * added for a destination not seen before, in place of the least recently used once there are
+ * AERON_UDP_TRANSPORT_XDP_MAX_ROUTES.
+ *
+ * @return the route, which may be unresolved, or NULL on error.
+ */
+aeron_udp_transport_xdp_route_t *aeron_udp_transport_xdp_route(
+    aeron_udp_transport_xdp_t *xdp, uint16_t src_port, struct sockaddr_in *dst, int64_t now_ns);
+
+/**
+ * Write the Ethernet, IP and UDP headers of route to frame, with the lengths and IP checksum for length bytes of
+ * payload, followed by the payload gathered from the iovecs of message.
+ *
+ * @return length of the frame.
+ */
+size_t aeron_udp_transport_xdp_frame(
+    const aeron_udp_transport_xdp_route_t *route, uint8_t *frame, const struct msghdr *message, size_t length);
+
+#endif //AERON_UDP_TRANSPORT_XDP_H
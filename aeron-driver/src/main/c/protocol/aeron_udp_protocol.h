@@ -78,6 +78,12 @@ typedef struct aeron_status_message_header_stct
 }
 aeron_status_message_header_t;
 
+typedef struct aeron_status_message_optional_header_stct
+{
+    int64_t group_tag;
+}
+aeron_status_message_optional_header_t;
+
 typedef struct aeron_rttm_header_stct
 {
     aeron_frame_header_t frame_header;
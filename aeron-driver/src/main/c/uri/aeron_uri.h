@@ -52,6 +52,8 @@ aeron_uri_params_t;
 #define AERON_URI_LINGER_TIMEOUT_KEY "linger"
 #define AERON_URI_MTU_LENGTH_KEY "mtu"
 #define AERON_URI_SPARSE_TERM_KEY "sparse"
+#define AERON_URI_FC_KEY "fc"
+#define AERON_URI_GTAG_KEY "gtag"
 
 typedef struct aeron_uri_publication_params_stct
 {
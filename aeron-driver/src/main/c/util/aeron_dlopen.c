@@ -33,7 +33,8 @@ int aeron_max_multicast_flow_control_strategy_supplier(
     int32_t stream_id,
     int64_t registration_id,
     int32_t initial_term_id,
-    size_t term_buffer_capacity);
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context);
 
 int aeron_unicast_flow_control_strategy_supplier(
     aeron_flow_control_strategy_t **strategy,
@@ -42,7 +43,38 @@ int aeron_unicast_flow_control_strategy_supplier(
     int32_t stream_id,
     int64_t registration_id,
     int32_t initial_term_id,
-    size_t term_buffer_capacity);
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context);
+
+int aeron_min_multicast_flow_control_strategy_supplier(
+    aeron_flow_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int64_t registration_id,
+    int32_t initial_term_id,
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context);
+
+int aeron_tagged_multicast_flow_control_strategy_supplier(
+    aeron_flow_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int64_t registration_id,
+    int32_t initial_term_id,
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context);
+
+int aeron_default_multicast_flow_control_strategy_supplier(
+    aeron_flow_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int64_t registration_id,
+    int32_t initial_term_id,
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context);
 
 int aeron_static_window_congestion_control_strategy_supplier(
     aeron_congestion_control_strategy_t **strategy,
@@ -56,6 +88,18 @@ int aeron_static_window_congestion_control_strategy_supplier(
     aeron_driver_context_t *context,
     aeron_counters_manager_t *counters_manager);
 
+int aeron_cubic_congestion_control_strategy_supplier(
+    aeron_congestion_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int32_t session_id,
+    int64_t registration_id,
+    int32_t term_length,
+    int32_t sender_mtu_length,
+    aeron_driver_context_t *context,
+    aeron_counters_manager_t *counters_manager);
+
 void* aeron_dlsym_fallback(LPCSTR name)
 {
     if (strcmp(name, "aeron_unicast_flow_control_strategy_supplier") == 0)
@@ -68,11 +112,31 @@ void* aeron_dlsym_fallback(LPCSTR name)
         return aeron_max_multicast_flow_control_strategy_supplier;
     }
 
+    if (strcmp(name, "aeron_min_multicast_flow_control_strategy_supplier") == 0)
+    {
+        return aeron_min_multicast_flow_control_strategy_supplier;
+    }
+
+    if (strcmp(name, "aeron_tagged_multicast_flow_control_strategy_supplier") == 0)
+    {
+        return aeron_tagged_multicast_flow_control_strategy_supplier;
+    }
+
+    if (strcmp(name, "aeron_default_multicast_flow_control_strategy_supplier") == 0)
+    {
+        return aeron_default_multicast_flow_control_strategy_supplier;
+    }
+
     if (strcmp(name, "aeron_static_window_congestion_control_strategy_supplier") == 0)
     {
         return aeron_static_window_congestion_control_strategy_supplier;
     }
 
+    if (strcmp(name, "aeron_cubic_congestion_control_strategy_supplier") == 0)
+    {
+        return aeron_cubic_congestion_control_strategy_supplier;
+    }
+
     return NULL;
 }
 #else
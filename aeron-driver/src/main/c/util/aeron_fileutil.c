@@ -236,12 +236,22 @@ int aeron_create_file(const char* path)
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <inttypes.h>
 #include <errno.h>
 #include "util/aeron_fileutil.h"
 #include "aeron_error.h"
 
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include <sys/vfs.h>
+#endif
+
 #define AERON_BLOCK_SIZE (4 * 1024)
+#define AERON_NUMA_MAX_NODES (1024)
+#define AERON_HUGETLBFS_MAGIC (0x958458f6)
 
 inline static void aeron_touch_pages(uint8_t *base, size_t length, size_t page_size)
 {
@@ -414,8 +424,10 @@ int aeron_map_raw_log(
     aeron_mapped_raw_log_t *mapped_raw_log,
     const char *path,
     bool use_sparse_files,
+    bool use_huge_pages,
     uint64_t term_length,
-    uint64_t page_size)
+    uint64_t page_size,
+    int32_t numa_node)
 {
     int fd, result = -1;
     uint64_t log_length = aeron_logbuffer_compute_log_length(term_length, page_size);
@@ -434,6 +446,21 @@ int aeron_map_raw_log(
                 return -1;
             }
 
+            /* advice only affects pages faulted in after it is given so must come before touching */
+            if (use_huge_pages)
+            {
+                aeron_mapped_file_advise_huge_pages(&mapped_raw_log->mapped_file);
+            }
+
+            /* as with the advice, binding first places pages on the node as they fault rather than moving them */
+            if (aeron_mapped_file_bind_numa_node(&mapped_raw_log->mapped_file, numa_node) < 0)
+            {
+                aeron_unmap(&mapped_raw_log->mapped_file);
+                mapped_raw_log->mapped_file.addr = NULL;
+                remove(path);
+                return -1;
+            }
+
             if (!use_sparse_files)
             {
                 aeron_touch_pages(mapped_raw_log->mapped_file.addr, log_length, page_size);
@@ -490,3 +517,149 @@ int aeron_map_raw_log_close(aeron_mapped_raw_log_t *mapped_raw_log, const char *
 
     return result;
 }
+
+int aeron_mapped_file_bind_numa_node(aeron_mapped_file_t *mapped_file, int32_t numa_node)
+{
+    if (numa_node < 0 || NULL == mapped_file->addr || 0 == mapped_file->length)
+    {
+        return 0;
+    }
+
+#if defined(__linux__) && defined(SYS_mbind)
+    const size_t bits_per_word = 8 * sizeof(unsigned long);
+    unsigned long node_mask[AERON_NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+
+    if (numa_node >= AERON_NUMA_MAX_NODES)
+    {
+        aeron_set_err(EINVAL, "NUMA node %" PRId32 " out of range", numa_node);
+        return -1;
+    }
+
+    memset(node_mask, 0, sizeof(node_mask));
+    node_mask[numa_node / bits_per_word] = 1UL << (numa_node % bits_per_word);
+
+    /* preferred rather than bind so a full node falls back to another rather than failing the fault */
+    if (syscall(
+        SYS_mbind,
+        mapped_file->addr,
+        mapped_file->length,
+        MPOL_PREFERRED,
+        node_mask,
+        AERON_NUMA_MAX_NODES + 1,
+        MPOL_MF_MOVE) < 0)
+    {
+        int errcode = errno;
+        aeron_set_err(errcode, "mbind to NUMA node %" PRId32 ": %s", numa_node, strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+#else
+    aeron_set_err(ENOTSUP, "%s", "binding mappings to a NUMA node is not supported on this platform");
+    return -1;
+#endif
+}
+
+void aeron_mapped_file_touch_pages(aeron_mapped_file_t *mapped_file, size_t page_size)
+{
+    aeron_touch_pages(mapped_file->addr, mapped_file->length, page_size);
+}
+
+int aeron_mapped_file_advise_huge_pages(aeron_mapped_file_t *mapped_file)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (madvise(mapped_file->addr, mapped_file->length, MADV_HUGEPAGE) < 0)
+    {
+        int errcode = errno;
+        aeron_set_err(errcode, "madvise huge pages: %s", strerror(errcode));
+        return -1;
+    }
+
+    return 0;
+#else
+    aeron_set_err(ENOTSUP, "%s", "transparent huge pages are not supported on this platform");
+    return -1;
+#endif
+}
+
+int64_t aeron_mapped_file_huge_page_length(aeron_mapped_file_t *mapped_file)
+{
+#if defined(__linux__)
+    static const char *huge_page_fields[] =
+    {
+        "AnonHugePages:", "ShmemPmdMapped:", "FilePmdMapped:", "Shared_Hugetlb:", "Private_Hugetlb:"
+    };
+    const size_t num_fields = sizeof(huge_page_fields) / sizeof(huge_page_fields[0]);
+    const uintptr_t addr = (uintptr_t)mapped_file->addr;
+    char line[256];
+    int64_t length_kb = 0;
+    bool in_mapping = false, found = false;
+    FILE *smaps;
+
+    if ((smaps = fopen("/proc/self/smaps", "r")) == NULL)
+    {
+        int errcode = errno;
+        aeron_set_err(errcode, "could not open /proc/self/smaps: %s", strerror(errcode));
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), smaps) != NULL)
+    {
+        uintptr_t start, end;
+
+        /* mapping header lines are the only ones of the form start-end, field names never hold a '-' */
+        if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &start, &end) == 2)
+        {
+            in_mapping = start >= addr && end <= addr + mapped_file->length;
+            found |= in_mapping;
+            continue;
+        }
+
+        if (!in_mapping)
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < num_fields; i++)
+        {
+            size_t field_length = strlen(huge_page_fields[i]);
+            if (strncmp(line, huge_page_fields[i], field_length) == 0)
+            {
+                length_kb += strtoll(line + field_length, NULL, 10);
+                break;
+            }
+        }
+    }
+
+    fclose(smaps);
+
+    if (!found)
+    {
+        aeron_set_err(EINVAL, "mapping at %p not found in /proc/self/smaps", mapped_file->addr);
+        return -1;
+    }
+
+    return length_kb * 1024;
+#else
+    aeron_set_err(ENOTSUP, "%s", "huge page usage is not reported on this platform");
+    return -1;
+#endif
+}
+
+int64_t aeron_hugetlbfs_page_size(const char *path)
+{
+#if defined(__linux__)
+    struct statfs fs;
+
+    if (statfs(path, &fs) < 0)
+    {
+        int errcode = errno;
+        aeron_set_err(errcode, "statfs %s: %s", path, strerror(errcode));
+        return -1;
+    }
+
+    return AERON_HUGETLBFS_MAGIC == (uint32_t)fs.f_type ? (int64_t)fs.f_bsize : 0;
+#else
+    return 0;
+#endif
+}
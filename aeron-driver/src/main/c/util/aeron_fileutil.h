@@ -97,16 +97,34 @@ int aeron_publication_image_location(
     int32_t stream_id,
     int64_t correlation_id);
 
-typedef int (*aeron_map_raw_log_func_t)(aeron_mapped_raw_log_t *, const char *, bool, uint64_t, uint64_t);
+typedef int (*aeron_map_raw_log_func_t)(
+    aeron_mapped_raw_log_t *, const char *, bool, bool, uint64_t, uint64_t, int32_t);
 typedef int (*aeron_map_raw_log_close_func_t)(aeron_mapped_raw_log_t *, const char *filename);
 
+/*
+ * Create and map a raw log, bound to numa_node unless it is negative. The policy is set before any page is touched
+ * so each is faulted in on the node rather than migrated there afterwards.
+ */
 int aeron_map_raw_log(
     aeron_mapped_raw_log_t *mapped_raw_log,
     const char *path,
     bool use_sparse_files,
+    bool use_huge_pages,
     uint64_t term_length,
-    uint64_t page_size);
+    uint64_t page_size,
+    int32_t numa_node);
 
 int aeron_map_raw_log_close(aeron_mapped_raw_log_t *mapped_raw_log, const char *filename);
 
+int aeron_mapped_file_bind_numa_node(aeron_mapped_file_t *mapped_file, int32_t numa_node);
+
+void aeron_mapped_file_touch_pages(aeron_mapped_file_t *mapped_file, size_t page_size);
+int aeron_mapped_file_advise_huge_pages(aeron_mapped_file_t *mapped_file);
+
+/* bytes of the mapping currently backed by transparent or hugetlbfs huge pages, or -1 if not known */
+int64_t aeron_mapped_file_huge_page_length(aeron_mapped_file_t *mapped_file);
+
+/* page size of the hugetlbfs mount holding path, 0 if path is not on hugetlbfs, or -1 on error */
+int64_t aeron_hugetlbfs_page_size(const char *path);
+
 #endif //AERON_FILEUTIL_H
@@ -437,6 +437,69 @@ int aeron_interface_split(const char *interface_str, aeron_parsed_interface_t *p
     return 0;
 }
 
+int aeron_parse_cpu_set(const char *str, aeron_cpu_set_t *cpu_set)
+{
+    const char *cursor = str;
+
+    memset(cpu_set, 0, sizeof(aeron_cpu_set_t));
+
+    if (NULL == str)
+    {
+        return -1;
+    }
+
+    while ('\0' != *cursor)
+    {
+        char *end = NULL;
+
+        if (!isdigit((unsigned char)*cursor))
+        {
+            goto error;
+        }
+
+        errno = 0;
+        unsigned long first = strtoul(cursor, &end, 10);
+        unsigned long last = first;
+
+        if ('-' == *end)
+        {
+            cursor = end + 1;
+            if (!isdigit((unsigned char)*cursor))
+            {
+                goto error;
+            }
+
+            last = strtoul(cursor, &end, 10);
+        }
+
+        if (0 != errno || last < first || last >= AERON_CPU_SET_MAX_CPUS)
+        {
+            goto error;
+        }
+
+        for (unsigned long cpu = first; cpu <= last; cpu++)
+        {
+            cpu_set->mask[cpu / 64] |= UINT64_C(1) << (cpu % 64);
+        }
+
+        if (',' == *end)
+        {
+            end++;
+        }
+        else if ('\0' != *end)
+        {
+            goto error;
+        }
+
+        cursor = end;
+    }
+
+    return 0;
+
+    error:
+    aeron_set_err(EINVAL, "invalid CPU list: %s", str);
+    return -1;
+}
 
 extern int aeron_parse_size64(const char *str, uint64_t *result);
 
@@ -19,6 +19,8 @@
 
 #include <stdint.h>
 
+#include "concurrent/aeron_thread.h"
+
 #define AERON_MAX_HOST_LENGTH (384)
 #define AERON_MAX_PORT_LENGTH (8)
 #define AERON_MAX_PREFIX_LENGTH (8)
@@ -48,4 +50,7 @@ int aeron_address_split(const char *address_str, aeron_parsed_address_t *parsed_
 
 int aeron_interface_split(const char *interface_str, aeron_parsed_interface_t *parsed_interface);
 
+/* parses a CPU list such as "0-3,8,10-11" */
+int aeron_parse_cpu_set(const char *str, aeron_cpu_set_t *cpu_set);
+
 #endif //AERON_AERON_PROP_UTIL_H
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cmath>
+#include <string>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "aeron_congestion_control.h"
+#include "aeron_driver_context.h"
+#include "concurrent/aeron_counters_manager.h"
+#include "util/aeron_error.h"
+
+int aeron_cubic_congestion_control_strategy_supplier(
+    aeron_congestion_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int32_t session_id,
+    int64_t registration_id,
+    int32_t term_length,
+    int32_t sender_mtu_length,
+    aeron_driver_context_t *context,
+    aeron_counters_manager_t *counters_manager);
+}
+
+#define TERM_LENGTH (64 * 1024)
+#define MTU_LENGTH (1024)
+#define MAX_CWND ((TERM_LENGTH / 2) / MTU_LENGTH)
+#define INITIAL_RTT_NS (100 * 1000L)
+#define NUM_COUNTERS (4)
+
+static int64_t now_ns = 0;
+
+static int64_t test_nano_clock()
+{
+    return now_ns;
+}
+
+static int64_t null_epoch_clock()
+{
+    return 0;
+}
+
+class CubicCongestionControlTest : public testing::Test
+{
+public:
+    CubicCongestionControlTest() : m_strategy(NULL)
+    {
+        now_ns = 1000 * 1000 * 1000L;
+        memset(&m_context, 0, sizeof(m_context));
+        m_context.nano_clock = test_nano_clock;
+        m_context.initial_window_length = 128 * 1024;
+        m_context.cubic_initial_rtt_ns = INITIAL_RTT_NS;
+        m_metadata.fill(0);
+        m_values.fill(0);
+        aeron_counters_manager_init(
+            &m_counters_manager,
+            m_metadata.data(),
+            m_metadata.size(),
+            m_values.data(),
+            m_values.size(),
+            null_epoch_clock,
+            0);
+    }
+
+    virtual ~CubicCongestionControlTest()
+    {
+        if (NULL != m_strategy)
+        {
+            m_strategy->fini(m_strategy);
+        }
+
+        aeron_counters_manager_close(&m_counters_manager);
+    }
+
+    int create()
+    {
+        const std::string channel = "aeron:udp?endpoint=localhost:24325";
+
+        return aeron_cubic_congestion_control_strategy_supplier(
+            &m_strategy,
+            (int32_t)channel.length(),
+            channel.c_str(),
+            1001,
+            7,
+            42,
+            TERM_LENGTH,
+            MTU_LENGTH,
+            &m_context,
+            &m_counters_manager);
+    }
+
+    int32_t on_track_rebuild(bool *should_force_sm, bool loss_occurred)
+    {
+        return m_strategy->on_track_rebuild(m_strategy->state, should_force_sm, now_ns, 0, 0, 0, 0, 0, loss_occurred);
+    }
+
+    int64_t counter_value(int32_t counter_id)
+    {
+        return *aeron_counter_addr(&m_counters_manager, counter_id);
+    }
+
+protected:
+    aeron_driver_context_t m_context;
+    aeron_congestion_control_strategy_t *m_strategy;
+    aeron_counters_manager_t m_counters_manager;
+    std::array<uint8_t, NUM_COUNTERS * AERON_COUNTERS_MANAGER_METADATA_LENGTH> m_metadata;
+    std::array<uint8_t, NUM_COUNTERS * AERON_COUNTERS_MANAGER_VALUE_LENGTH> m_values;
+};
+
+TEST_F(CubicCongestionControlTest, shouldStartWithInitialCongestionWindow)
+{
+    ASSERT_EQ(create(), 0) << aeron_errmsg();
+
+    bool should_force_sm = true;
+
+    EXPECT_EQ(m_strategy->initial_window_length(m_strategy->state), MTU_LENGTH);
+    EXPECT_EQ(counter_value(1), MTU_LENGTH);
+
+    EXPECT_EQ(on_track_rebuild(&should_force_sm, false), AERON_CUBICCONGESTIONCONTROL_INITCWND * MTU_LENGTH);
+    EXPECT_FALSE(should_force_sm);
+    EXPECT_EQ(counter_value(1), AERON_CUBICCONGESTIONCONTROL_INITCWND * MTU_LENGTH);
+}
+
+TEST_F(CubicCongestionControlTest, shouldBackOffOnLoss)
+{
+    ASSERT_EQ(create(), 0) << aeron_errmsg();
+
+    bool should_force_sm = false;
+
+    EXPECT_EQ(on_track_rebuild(&should_force_sm, true), 8 * MTU_LENGTH);
+    EXPECT_TRUE(should_force_sm);
+    EXPECT_EQ(on_track_rebuild(&should_force_sm, true), 6 * MTU_LENGTH);
+    EXPECT_TRUE(should_force_sm);
+}
+
+TEST_F(CubicCongestionControlTest, shouldGrowAlongCubicCurveAfterLoss)
+{
+    ASSERT_EQ(create(), 0) << aeron_errmsg();
+
+    bool should_force_sm = false;
+
+    on_track_rebuild(&should_force_sm, true);
+
+    /* w_max = 10 so K = cbrt(10 * B / C) seconds and the window is back at w_max after K */
+    const double k = std::cbrt(10 * AERON_CUBICCONGESTIONCONTROL_B / AERON_CUBICCONGESTIONCONTROL_C);
+
+    now_ns += (int64_t)((k + 3.0) * 1e9);
+    EXPECT_EQ(on_track_rebuild(&should_force_sm, false), (10 + (int32_t)(0.4 * 27)) * MTU_LENGTH);
+    EXPECT_TRUE(should_force_sm);
+
+    now_ns += 1;
+    EXPECT_EQ(on_track_rebuild(&should_force_sm, false), (10 + (int32_t)(0.4 * 27)) * MTU_LENGTH);
+    EXPECT_FALSE(should_force_sm);
+
+    now_ns += 60 * 1000 * 1000 * 1000L;
+    EXPECT_EQ(on_track_rebuild(&should_force_sm, false), MAX_CWND * MTU_LENGTH);
+    EXPECT_TRUE(should_force_sm);
+    EXPECT_EQ(counter_value(1), MAX_CWND * MTU_LENGTH);
+}
+
+TEST_F(CubicCongestionControlTest, shouldGrowAtLeastAsFastAsTcpInTcpMode)
+{
+    bool should_force_sm = false;
+
+    ASSERT_EQ(create(), 0) << aeron_errmsg();
+    on_track_rebuild(&should_force_sm, true);
+    now_ns += 1000 * 1000L;
+    EXPECT_EQ(on_track_rebuild(&should_force_sm, false), 9 * MTU_LENGTH);
+
+    m_strategy->fini(m_strategy);
+    m_strategy = NULL;
+    m_context.cubic_tcp_mode = true;
+
+    ASSERT_EQ(create(), 0) << aeron_errmsg();
+    on_track_rebuild(&should_force_sm, true);
+    now_ns += 1000 * 1000L;
+    EXPECT_EQ(on_track_rebuild(&should_force_sm, false), 11 * MTU_LENGTH);
+}
+
+TEST_F(CubicCongestionControlTest, shouldNotMeasureRttUnlessConfigured)
+{
+    ASSERT_EQ(create(), 0) << aeron_errmsg();
+
+    EXPECT_FALSE(m_strategy->should_measure_rtt(m_strategy->state, now_ns));
+}
+
+TEST_F(CubicCongestionControlTest, shouldLimitOutstandingRttMeasurements)
+{
+    m_context.cubic_measure_rtt = true;
+    ASSERT_EQ(create(), 0) << aeron_errmsg();
+
+    EXPECT_TRUE(m_strategy->should_measure_rtt(m_strategy->state, now_ns));
+    m_strategy->on_rttm_sent(m_strategy->state, now_ns);
+
+    now_ns += AERON_CUBICCONGESTIONCONTROL_RTT_MEASUREMENT_TIMEOUT_NS + 1;
+    EXPECT_FALSE(m_strategy->should_measure_rtt(m_strategy->state, now_ns));
+
+    m_strategy->on_rttm(m_strategy->state, now_ns, 250 * 1000L, NULL);
+    EXPECT_EQ(counter_value(0), 250 * 1000L);
+    EXPECT_FALSE(m_strategy->should_measure_rtt(m_strategy->state, now_ns));
+
+    now_ns += AERON_CUBICCONGESTIONCONTROL_RTT_MEASUREMENT_TIMEOUT_NS + 1;
+    EXPECT_TRUE(m_strategy->should_measure_rtt(m_strategy->state, now_ns));
+    m_strategy->on_rttm_sent(m_strategy->state, now_ns);
+
+    now_ns += AERON_CUBICCONGESTIONCONTROL_RTT_MAX_TIMEOUT_NS + 1;
+    EXPECT_TRUE(m_strategy->should_measure_rtt(m_strategy->state, now_ns));
+}
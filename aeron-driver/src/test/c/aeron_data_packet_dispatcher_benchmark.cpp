@@ -0,0 +1,149 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+extern "C"
+{
+#include "aeron_data_packet_dispatcher.h"
+#include "aeron_publication_image.h"
+#include "util/aeron_error.h"
+}
+
+#define TERM_LENGTH (64 * 1024)
+#define FRAME_LENGTH (64)
+#define STREAM_ID_BASE (1001)
+#define STREAM_COUNT (4)
+
+static int64_t benchmark_nano_clock()
+{
+    return 0;
+}
+
+/*
+ * Small data frames from the given number of images spread over a few streams, dispatched in turn so successive
+ * frames are for different images unless there is only one. Images are just enough of one for frames to be inserted
+ * and share a term, so what is measured is finding the image plus a 64 byte insert.
+ */
+class DataPacketDispatch
+{
+public:
+    explicit DataPacketDispatch(size_t image_count) :
+        m_term(TERM_LENGTH),
+        m_frames(image_count * FRAME_LENGTH),
+        m_hwm_positions(image_count),
+        m_images(image_count)
+    {
+        if (aeron_data_packet_dispatcher_init(&m_dispatcher, NULL, NULL) < 0)
+        {
+            throw std::runtime_error("could not init dispatcher: " + std::string(aeron_errmsg()));
+        }
+
+        for (int32_t stream_id = STREAM_ID_BASE; stream_id < STREAM_ID_BASE + STREAM_COUNT; stream_id++)
+        {
+            aeron_data_packet_dispatcher_add_subscription(&m_dispatcher, stream_id);
+        }
+
+        for (size_t i = 0; i < image_count; i++)
+        {
+            aeron_publication_image_t *image =
+                (aeron_publication_image_t *)calloc(1, sizeof(aeron_publication_image_t));
+            const int32_t session_id = (int32_t)(i * 7919);
+            const int32_t stream_id = STREAM_ID_BASE + (int32_t)(i % STREAM_COUNT);
+
+            image->conductor_fields.managed_resource.registration_id = (int64_t)i;
+            image->session_id = session_id;
+            image->stream_id = stream_id;
+            image->term_length_mask = TERM_LENGTH - 1;
+            image->position_bits_to_shift = (size_t)aeron_number_of_trailing_zeroes(TERM_LENGTH);
+            image->last_sm_position_window_limit = INT64_MAX;
+            image->rcv_hwm_position.value_addr = &m_hwm_positions[i];
+            image->nano_clock = benchmark_nano_clock;
+            image->heartbeats_received_counter = &m_scratch_counter;
+            image->flow_control_under_runs_counter = &m_scratch_counter;
+            image->flow_control_over_runs_counter = &m_scratch_counter;
+
+            for (size_t j = 0; j < AERON_LOGBUFFER_PARTITION_COUNT; j++)
+            {
+                image->mapped_raw_log.term_buffers[j].addr = m_term.data();
+                image->mapped_raw_log.term_buffers[j].length = TERM_LENGTH;
+            }
+
+            aeron_data_packet_dispatcher_add_publication_image(&m_dispatcher, image);
+            m_images[i] = image;
+
+            aeron_data_header_t *header = (aeron_data_header_t *)(m_frames.data() + (i * FRAME_LENGTH));
+            header->frame_header.frame_length = FRAME_LENGTH;
+            header->frame_header.version = AERON_FRAME_HEADER_VERSION;
+            header->frame_header.flags = AERON_DATA_HEADER_BEGIN_FLAG | AERON_DATA_HEADER_END_FLAG;
+            header->frame_header.type = AERON_HDR_TYPE_DATA;
+            header->session_id = session_id;
+            header->stream_id = stream_id;
+        }
+    }
+
+    ~DataPacketDispatch()
+    {
+        aeron_data_packet_dispatcher_close(&m_dispatcher);
+
+        for (auto image : m_images)
+        {
+            free(image);
+        }
+    }
+
+    int dispatch(size_t image_index)
+    {
+        uint8_t *frame = m_frames.data() + (image_index * FRAME_LENGTH);
+
+        return aeron_data_packet_dispatcher_on_data(
+            &m_dispatcher, NULL, (aeron_data_header_t *)frame, frame, FRAME_LENGTH, NULL);
+    }
+
+private:
+    aeron_data_packet_dispatcher_t m_dispatcher;
+    std::vector<uint8_t> m_term;
+    std::vector<uint8_t> m_frames;
+    std::vector<int64_t> m_hwm_positions;
+    std::vector<aeron_publication_image_t *> m_images;
+    int64_t m_scratch_counter = 0;
+};
+
+static void BM_DispatchDataFrame(benchmark::State &state)
+{
+    const size_t image_count = (size_t)state.range(0);
+    DataPacketDispatch dispatch(image_count);
+    size_t image_index = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dispatch.dispatch(image_index));
+        image_index = image_index + 1 < image_count ? image_index + 1 : 0;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_DispatchDataFrame)->Arg(1)->Arg(10)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "aeron_data_packet_dispatcher.h"
+#include "aeron_publication_image.h"
+}
+
+#define STREAM_ID_A (1001)
+#define STREAM_ID_B (1002)
+
+class DataPacketDispatcherTest : public testing::Test
+{
+public:
+    DataPacketDispatcherTest()
+    {
+        aeron_data_packet_dispatcher_init(&m_dispatcher, NULL, NULL);
+    }
+
+    ~DataPacketDispatcherTest()
+    {
+        aeron_data_packet_dispatcher_close(&m_dispatcher);
+
+        for (auto image : m_images)
+        {
+            delete image;
+        }
+    }
+
+    aeron_publication_image_t *image(int32_t session_id, int32_t stream_id)
+    {
+        aeron_publication_image_t *image = new aeron_publication_image_t();
+
+        image->session_id = session_id;
+        image->stream_id = stream_id;
+        image->conductor_fields.managed_resource.registration_id = (int64_t)m_images.size();
+        m_images.push_back(image);
+
+        return image;
+    }
+
+    void *get(int32_t session_id, int32_t stream_id)
+    {
+        return aeron_data_packet_dispatcher_session_get(&m_dispatcher, session_id, stream_id);
+    }
+
+protected:
+    aeron_data_packet_dispatcher_t m_dispatcher;
+    std::vector<aeron_publication_image_t *> m_images;
+};
+
+TEST_F(DataPacketDispatcherTest, shouldFindImagesOfSubscribedStreamsOnly)
+{
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_subscription(&m_dispatcher, STREAM_ID_A), 0);
+
+    aeron_publication_image_t *subscribed = image(7, STREAM_ID_A);
+    aeron_publication_image_t *unsubscribed = image(7, STREAM_ID_B);
+
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_publication_image(&m_dispatcher, subscribed), 0);
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_publication_image(&m_dispatcher, unsubscribed), 0);
+
+    EXPECT_EQ(get(7, STREAM_ID_A), (void *)subscribed);
+    EXPECT_EQ(get(7, STREAM_ID_B), nullptr);
+    EXPECT_EQ(get(-7, STREAM_ID_A), nullptr);
+    EXPECT_TRUE(aeron_data_packet_dispatcher_should_elicit_setup_message(&m_dispatcher));
+}
+
+TEST_F(DataPacketDispatcherTest, shouldKeepImagesReachableAcrossGrowthAndRemoval)
+{
+    const int32_t count = 1000;
+
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_subscription(&m_dispatcher, STREAM_ID_A), 0);
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_subscription(&m_dispatcher, STREAM_ID_B), 0);
+
+    for (int32_t i = 0; i < count; i++)
+    {
+        ASSERT_EQ(aeron_data_packet_dispatcher_add_publication_image(
+            &m_dispatcher, image(i << 20, (i % 2) ? STREAM_ID_B : STREAM_ID_A)), 0);
+    }
+
+    EXPECT_EQ(m_dispatcher.sessions.size, (size_t)count);
+
+    for (int32_t i = 0; i < count; i += 3)
+    {
+        ASSERT_EQ(aeron_data_packet_dispatcher_remove_publication_image(&m_dispatcher, m_images[i]), 0);
+        ASSERT_EQ(aeron_data_packet_dispatcher_remove_cool_down(&m_dispatcher, i << 20, m_images[i]->stream_id), 0);
+    }
+
+    for (int32_t i = 0; i < count; i++)
+    {
+        EXPECT_EQ(get(i << 20, m_images[i]->stream_id), 0 == i % 3 ? nullptr : (void *)m_images[i]) << i;
+    }
+}
+
+TEST_F(DataPacketDispatcherTest, shouldCoolDownRemovedImageUnlessReplaced)
+{
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_subscription(&m_dispatcher, STREAM_ID_A), 0);
+
+    aeron_publication_image_t *old_image = image(7, STREAM_ID_A);
+    aeron_publication_image_t *new_image = image(7, STREAM_ID_A);
+
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_publication_image(&m_dispatcher, old_image), 0);
+    ASSERT_EQ(aeron_data_packet_dispatcher_remove_publication_image(&m_dispatcher, old_image), 0);
+    EXPECT_EQ(get(7, STREAM_ID_A), (void *)&m_dispatcher.tokens.on_cool_down);
+    EXPECT_FALSE(aeron_data_packet_dispatcher_is_not_already_in_progress_or_on_cool_down(
+        &m_dispatcher, STREAM_ID_A, 7));
+
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_publication_image(&m_dispatcher, new_image), 0);
+    ASSERT_EQ(aeron_data_packet_dispatcher_remove_publication_image(&m_dispatcher, old_image), 0);
+    EXPECT_EQ(get(7, STREAM_ID_A), (void *)new_image);
+}
+
+TEST_F(DataPacketDispatcherTest, shouldDropImagesButNotTokensOfRemovedSubscription)
+{
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_subscription(&m_dispatcher, STREAM_ID_A), 0);
+    ASSERT_EQ(aeron_data_packet_dispatcher_add_subscription(&m_dispatcher, STREAM_ID_B), 0);
+
+    for (int32_t i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(aeron_data_packet_dispatcher_add_publication_image(&m_dispatcher, image(i, STREAM_ID_A)), 0);
+        ASSERT_EQ(aeron_data_packet_dispatcher_add_publication_image(&m_dispatcher, image(i, STREAM_ID_B)), 0);
+    }
+
+    ASSERT_EQ(aeron_data_packet_dispatcher_remove_publication_image(&m_dispatcher, m_images[0]), 0);
+    m_dispatcher.hot_image = m_images[2];
+
+    ASSERT_EQ(aeron_data_packet_dispatcher_remove_subscription(&m_dispatcher, STREAM_ID_A), 0);
+
+    EXPECT_EQ(m_dispatcher.hot_image, nullptr);
+    EXPECT_EQ(get(0, STREAM_ID_A), (void *)&m_dispatcher.tokens.on_cool_down);
+    for (int32_t i = 1; i < 100; i++)
+    {
+        EXPECT_EQ(get(i, STREAM_ID_A), nullptr) << i;
+    }
+
+    for (int32_t i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(get(i, STREAM_ID_B), (void *)m_images[(2 * i) + 1]) << i;
+    }
+
+    EXPECT_EQ(m_dispatcher.sessions.size, 101u);
+}
@@ -0,0 +1,426 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "agent/aeron_driver_agent_capture.h"
+#include "protocol/aeron_udp_protocol.h"
+#include "util/aeron_error.h"
+#include "util/aeron_fileutil.h"
+}
+
+#define FRAME_LENGTH (64)
+#define IP_UDP_HEADER_LENGTH (20 + 8)
+#define REMOTE_PORT (40123)
+
+#pragma pack(push)
+#pragma pack(4)
+typedef struct pcap_file_header_stct
+{
+    uint32_t magic;
+    uint16_t version_major;
+    uint16_t version_minor;
+    int32_t thiszone;
+    uint32_t sigfigs;
+    uint32_t snaplen;
+    uint32_t linktype;
+}
+pcap_file_header_t;
+
+typedef struct pcap_record_header_stct
+{
+    uint32_t ts_sec;
+    uint32_t ts_nsec;
+    uint32_t incl_len;
+    uint32_t orig_len;
+}
+pcap_record_header_t;
+#pragma pack(pop)
+
+typedef struct capture_record_stct
+{
+    pcap_record_header_t header;
+    std::vector<uint8_t> packet;
+}
+capture_record_t;
+
+static const char *CAPTURE_ENV_VARS[] =
+{
+    AERON_AGENT_CAPTURE_FILE_ENV_VAR,
+    AERON_AGENT_CAPTURE_FILE_SIZE_ENV_VAR,
+    AERON_AGENT_CAPTURE_FILE_COUNT_ENV_VAR,
+    AERON_AGENT_CAPTURE_BUFFER_LENGTH_ENV_VAR,
+    AERON_AGENT_CAPTURE_SNAPLEN_ENV_VAR,
+    AERON_AGENT_CAPTURE_SAMPLE_ENV_VAR,
+    AERON_AGENT_CAPTURE_STREAM_IDS_ENV_VAR
+};
+
+static uint16_t getUint16(const uint8_t *buffer)
+{
+    return (uint16_t)((buffer[0] << 8) | buffer[1]);
+}
+
+class DriverAgentCaptureTest : public testing::Test
+{
+public:
+    DriverAgentCaptureTest() : m_fd(-1)
+    {
+        char dir[] = "/tmp/aeron-capture-XXXXXX";
+
+        m_dir = mkdtemp(dir);
+        m_path = m_dir + "/capture";
+    }
+
+    virtual void SetUp()
+    {
+        for (const char *name : CAPTURE_ENV_VARS)
+        {
+            unsetenv(name);
+        }
+
+        setenv(AERON_AGENT_CAPTURE_FILE_ENV_VAR, m_path.c_str(), 1);
+        setenv(AERON_AGENT_CAPTURE_BUFFER_LENGTH_ENV_VAR, "65536", 1);
+
+        socklen_t addr_len = sizeof(m_local_addr);
+
+        memset(&m_local_addr, 0, sizeof(m_local_addr));
+        m_local_addr.sin_family = AF_INET;
+        m_local_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        ASSERT_GE(m_fd = socket(AF_INET, SOCK_DGRAM, 0), 0);
+        ASSERT_EQ(bind(m_fd, (struct sockaddr *)&m_local_addr, sizeof(m_local_addr)), 0);
+        ASSERT_EQ(getsockname(m_fd, (struct sockaddr *)&m_local_addr, &addr_len), 0);
+
+        memset(&m_remote_addr, 0, sizeof(m_remote_addr));
+        m_remote_addr.sin_family = AF_INET;
+        m_remote_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        m_remote_addr.sin_port = htons(REMOTE_PORT);
+    }
+
+    virtual void TearDown()
+    {
+        aeron_driver_agent_capture_close();
+
+        for (const char *name : CAPTURE_ENV_VARS)
+        {
+            unsetenv(name);
+        }
+
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+
+        aeron_delete_directory(m_dir.c_str());
+    }
+
+protected:
+    void captureFrame(int32_t msg_type_id, int32_t stream_id, int32_t term_offset, size_t length, int64_t time_ns)
+    {
+        uint8_t frame[FRAME_LENGTH];
+        aeron_data_header_t *data_header = (aeron_data_header_t *)frame;
+        struct iovec iov;
+        struct msghdr msghdr;
+
+        for (size_t i = 0; i < sizeof(frame); i++)
+        {
+            frame[i] = (uint8_t)i;
+        }
+
+        data_header->frame_header.frame_length = (int32_t)length;
+        data_header->frame_header.version = AERON_FRAME_HEADER_VERSION;
+        data_header->frame_header.flags = AERON_DATA_HEADER_BEGIN_FLAG | AERON_DATA_HEADER_END_FLAG;
+        data_header->frame_header.type = AERON_HDR_TYPE_DATA;
+        data_header->term_offset = term_offset;
+        data_header->session_id = 1;
+        data_header->stream_id = stream_id;
+        data_header->term_id = 0;
+
+        iov.iov_base = frame;
+        iov.iov_len = length;
+        memset(&msghdr, 0, sizeof(msghdr));
+        msghdr.msg_name = &m_remote_addr;
+        msghdr.msg_namelen = sizeof(m_remote_addr);
+        msghdr.msg_iov = &iov;
+        msghdr.msg_iovlen = 1;
+
+        aeron_driver_agent_capture_frame(msg_type_id, m_fd, &msghdr, length, time_ns);
+    }
+
+    std::string capturePath(int index)
+    {
+        return m_path + "." + std::to_string(index);
+    }
+
+    static bool readCapture(
+        const std::string &path, pcap_file_header_t *file_header, std::vector<capture_record_t> &records)
+    {
+        FILE *file = fopen(path.c_str(), "rb");
+
+        if (NULL == file)
+        {
+            return false;
+        }
+
+        bool result = 1 == fread(file_header, sizeof(pcap_file_header_t), 1, file);
+        capture_record_t record;
+
+        while (result && 1 == fread(&record.header, sizeof(record.header), 1, file))
+        {
+            record.packet.resize(record.header.incl_len);
+            if (record.header.incl_len > 0 && 1 != fread(record.packet.data(), record.packet.size(), 1, file))
+            {
+                result = false;
+                break;
+            }
+
+            records.push_back(record);
+        }
+
+        fclose(file);
+
+        return result;
+    }
+
+    static int32_t termOffset(const capture_record_t &record)
+    {
+        return ((aeron_data_header_t *)(record.packet.data() + IP_UDP_HEADER_LENGTH))->term_offset;
+    }
+
+    std::string m_dir;
+    std::string m_path;
+    int m_fd;
+    struct sockaddr_in m_local_addr;
+    struct sockaddr_in m_remote_addr;
+};
+
+TEST_F(DriverAgentCaptureTest, shouldNotEnableWithoutCaptureFile)
+{
+    unsetenv(AERON_AGENT_CAPTURE_FILE_ENV_VAR);
+
+    ASSERT_EQ(aeron_driver_agent_capture_init(), 0) << aeron_errmsg();
+    EXPECT_FALSE(aeron_driver_agent_capture_is_enabled());
+}
+
+TEST_F(DriverAgentCaptureTest, shouldWriteGlobalAndRecordHeaders)
+{
+    pcap_file_header_t file_header;
+    std::vector<capture_record_t> records;
+
+    ASSERT_EQ(aeron_driver_agent_capture_init(), 0) << aeron_errmsg();
+    ASSERT_TRUE(aeron_driver_agent_capture_is_enabled());
+
+    captureFrame(AERON_CAPTURE_FRAME_OUT, 10, 0, FRAME_LENGTH, 5 * 1000000000LL + 123);
+    aeron_driver_agent_capture_close();
+    EXPECT_FALSE(aeron_driver_agent_capture_is_enabled());
+
+    ASSERT_TRUE(readCapture(capturePath(0), &file_header, records));
+    EXPECT_EQ(file_header.magic, 0xA1B23C4Du);
+    EXPECT_EQ(file_header.version_major, 2u);
+    EXPECT_EQ(file_header.version_minor, 4u);
+    EXPECT_EQ(file_header.thiszone, 0);
+    EXPECT_EQ(file_header.sigfigs, 0u);
+    EXPECT_EQ(file_header.snaplen, (uint32_t)(40 + 8 + AERON_AGENT_CAPTURE_SNAPLEN_DEFAULT));
+    EXPECT_EQ(file_header.linktype, 101u);
+
+    ASSERT_EQ(records.size(), 1u);
+    const capture_record_t &record = records[0];
+    EXPECT_EQ(record.header.ts_sec, 5u);
+    EXPECT_EQ(record.header.ts_nsec, 123u);
+    EXPECT_EQ(record.header.incl_len, (uint32_t)(IP_UDP_HEADER_LENGTH + FRAME_LENGTH));
+    EXPECT_EQ(record.header.orig_len, (uint32_t)(IP_UDP_HEADER_LENGTH + FRAME_LENGTH));
+
+    const uint8_t *ip = record.packet.data();
+    EXPECT_EQ(ip[0], 0x45);
+    EXPECT_EQ(getUint16(ip + 2), IP_UDP_HEADER_LENGTH + FRAME_LENGTH);
+    EXPECT_EQ(ip[8], 64);
+    EXPECT_EQ(ip[9], 17);
+    EXPECT_EQ(memcmp(ip + 12, &m_local_addr.sin_addr, 4), 0);
+    EXPECT_EQ(memcmp(ip + 16, &m_remote_addr.sin_addr, 4), 0);
+
+    const uint8_t *udp = ip + 20;
+    EXPECT_EQ(getUint16(udp), ntohs(m_local_addr.sin_port));
+    EXPECT_EQ(getUint16(udp + 2), REMOTE_PORT);
+    EXPECT_EQ(getUint16(udp + 4), 8 + FRAME_LENGTH);
+    EXPECT_EQ(getUint16(udp + 6), 0);
+
+    const aeron_data_header_t *data_header = (const aeron_data_header_t *)(udp + 8);
+    EXPECT_EQ(data_header->frame_header.frame_length, FRAME_LENGTH);
+    EXPECT_EQ(data_header->stream_id, 10);
+    EXPECT_EQ(udp[8 + FRAME_LENGTH - 1], FRAME_LENGTH - 1);
+}
+
+TEST_F(DriverAgentCaptureTest, shouldWriteReceivedFrameFromRemoteToLocal)
+{
+    pcap_file_header_t file_header;
+    std::vector<capture_record_t> records;
+
+    ASSERT_EQ(aeron_driver_agent_capture_init(), 0) << aeron_errmsg();
+
+    captureFrame(AERON_CAPTURE_FRAME_IN, 10, 0, FRAME_LENGTH, 0);
+    aeron_driver_agent_capture_close();
+
+    ASSERT_TRUE(readCapture(capturePath(0), &file_header, records));
+    ASSERT_EQ(records.size(), 1u);
+
+    const uint8_t *ip = records[0].packet.data();
+    EXPECT_EQ(memcmp(ip + 12, &m_remote_addr.sin_addr, 4), 0);
+    EXPECT_EQ(memcmp(ip + 16, &m_local_addr.sin_addr, 4), 0);
+    EXPECT_EQ(getUint16(ip + 20), REMOTE_PORT);
+    EXPECT_EQ(getUint16(ip + 22), ntohs(m_local_addr.sin_port));
+}
+
+TEST_F(DriverAgentCaptureTest, shouldWriteValidIpv4HeaderChecksum)
+{
+    pcap_file_header_t file_header;
+    std::vector<capture_record_t> records;
+
+    ASSERT_EQ(aeron_driver_agent_capture_init(), 0) << aeron_errmsg();
+
+    captureFrame(AERON_CAPTURE_FRAME_OUT, 10, 0, FRAME_LENGTH, 0);
+    captureFrame(AERON_CAPTURE_FRAME_IN, 10, FRAME_LENGTH, 40, 0);
+    aeron_driver_agent_capture_close();
+
+    ASSERT_TRUE(readCapture(capturePath(0), &file_header, records));
+    ASSERT_EQ(records.size(), 2u);
+
+    for (const capture_record_t &record : records)
+    {
+        const uint8_t *ip = record.packet.data();
+        uint32_t sum = 0;
+
+        for (size_t i = 0; i < 20; i += 2)
+        {
+            sum += getUint16(ip + i);
+        }
+
+        while (sum >> 16)
+        {
+            sum = (sum & 0xFFFF) + (sum >> 16);
+        }
+
+        EXPECT_NE(getUint16(ip + 10), 0);
+        EXPECT_EQ(sum, 0xFFFFu);
+    }
+}
+
+TEST_F(DriverAgentCaptureTest, shouldTruncateFramesToSnaplen)
+{
+    pcap_file_header_t file_header;
+    std::vector<capture_record_t> records;
+
+    setenv(AERON_AGENT_CAPTURE_SNAPLEN_ENV_VAR, "32", 1);
+    ASSERT_EQ(aeron_driver_agent_capture_init(), 0) << aeron_errmsg();
+
+    captureFrame(AERON_CAPTURE_FRAME_OUT, 10, 0, FRAME_LENGTH, 0);
+    aeron_driver_agent_capture_close();
+
+    ASSERT_TRUE(readCapture(capturePath(0), &file_header, records));
+    EXPECT_EQ(file_header.snaplen, (uint32_t)(40 + 8 + 32));
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].header.incl_len, (uint32_t)(IP_UDP_HEADER_LENGTH + 32));
+    EXPECT_EQ(records[0].header.orig_len, (uint32_t)(IP_UDP_HEADER_LENGTH + FRAME_LENGTH));
+    EXPECT_EQ(getUint16(records[0].packet.data() + 2), IP_UDP_HEADER_LENGTH + FRAME_LENGTH);
+}
+
+TEST_F(DriverAgentCaptureTest, shouldRotateThroughFileCountOverwritingOldest)
+{
+    const size_t record_length = sizeof(pcap_record_header_t) + IP_UDP_HEADER_LENGTH + FRAME_LENGTH;
+    const std::string file_size = std::to_string(sizeof(pcap_file_header_t) + (2 * record_length));
+    pcap_file_header_t file_header;
+    std::vector<capture_record_t> first_records, second_records;
+
+    setenv(AERON_AGENT_CAPTURE_FILE_SIZE_ENV_VAR, file_size.c_str(), 1);
+    setenv(AERON_AGENT_CAPTURE_FILE_COUNT_ENV_VAR, "2", 1);
+    ASSERT_EQ(aeron_driver_agent_capture_init(), 0) << aeron_errmsg();
+
+    for (int32_t i = 0; i < 5; i++)
+    {
+        captureFrame(AERON_CAPTURE_FRAME_OUT, 10, i * FRAME_LENGTH, FRAME_LENGTH, 0);
+    }
+    aeron_driver_agent_capture_close();
+
+    ASSERT_TRUE(readCapture(capturePath(0), &file_header, first_records));
+    ASSERT_TRUE(readCapture(capturePath(1), &file_header, second_records));
+    EXPECT_NE(access(capturePath(2).c_str(), F_OK), 0);
+
+    ASSERT_EQ(first_records.size(), 1u);
+    EXPECT_EQ(termOffset(first_records[0]), 4 * FRAME_LENGTH);
+
+    ASSERT_EQ(second_records.size(), 2u);
+    EXPECT_EQ(termOffset(second_records[0]), 2 * FRAME_LENGTH);
+    EXPECT_EQ(termOffset(second_records[1]), 3 * FRAME_LENGTH);
+}
+
+TEST_F(DriverAgentCaptureTest, shouldCaptureOnlySelectedStreamIds)
+{
+    pcap_file_header_t file_header;
+    std::vector<capture_record_t> records;
+
+    setenv(AERON_AGENT_CAPTURE_STREAM_IDS_ENV_VAR, "10,0x20,-7", 1);
+    ASSERT_EQ(aeron_driver_agent_capture_init(), 0) << aeron_errmsg();
+
+    captureFrame(AERON_CAPTURE_FRAME_OUT, 10, 0, FRAME_LENGTH, 0);
+    captureFrame(AERON_CAPTURE_FRAME_OUT, 11, 1 * FRAME_LENGTH, FRAME_LENGTH, 0);
+    captureFrame(AERON_CAPTURE_FRAME_OUT, 32, 2 * FRAME_LENGTH, FRAME_LENGTH, 0);
+    captureFrame(AERON_CAPTURE_FRAME_OUT, -7, 3 * FRAME_LENGTH, FRAME_LENGTH, 0);
+    captureFrame(AERON_CAPTURE_FRAME_OUT, 10, 4 * FRAME_LENGTH, sizeof(aeron_frame_header_t), 0);
+    aeron_driver_agent_capture_close();
+
+    ASSERT_TRUE(readCapture(capturePath(0), &file_header, records));
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(termOffset(records[0]), 0);
+    EXPECT_EQ(termOffset(records[1]), 2 * FRAME_LENGTH);
+    EXPECT_EQ(termOffset(records[2]), 3 * FRAME_LENGTH);
+}
+
+TEST_F(DriverAgentCaptureTest, shouldRejectInvalidStreamIds)
+{
+    const char *invalid[] =
+    {
+        ",",
+        "10,,11",
+        "10;11",
+        "abc",
+        "2147483648",
+        "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17"
+    };
+
+    for (const char *stream_ids : invalid)
+    {
+        setenv(AERON_AGENT_CAPTURE_STREAM_IDS_ENV_VAR, stream_ids, 1);
+
+        EXPECT_EQ(aeron_driver_agent_capture_init(), -1) << stream_ids;
+        EXPECT_EQ(aeron_errcode(), EINVAL) << stream_ids;
+        EXPECT_FALSE(aeron_driver_agent_capture_is_enabled()) << stream_ids;
+    }
+}
+
+TEST_F(DriverAgentCaptureTest, shouldAcceptMaxStreamIds)
+{
+    setenv(AERON_AGENT_CAPTURE_STREAM_IDS_ENV_VAR, "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16", 1);
+
+    ASSERT_EQ(aeron_driver_agent_capture_init(), 0) << aeron_errmsg();
+    EXPECT_TRUE(aeron_driver_agent_capture_is_enabled());
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+extern "C"
+{
+#include "aeron_driver_conductor.h"
+#include "aeron_driver_sender.h"
+#include "aeron_driver_receiver.h"
+#include "util/aeron_error.h"
+}
+
+#define TERM_LENGTH (64 * 1024)
+#define CLIENT_ID_BASE (1000000)
+#define MAX_COMMAND_LENGTH (1024)
+
+static int64_t benchmark_nano_clock()
+{
+    return 0;
+}
+
+static int64_t benchmark_epoch_clock()
+{
+    return 0;
+}
+
+/* calloc leaves the term buffers untouched so 10k publications do not commit 10k logs worth of memory */
+static int benchmark_calloc_map_raw_log(
+    aeron_mapped_raw_log_t *log,
+    const char *path,
+    bool use_sparse_file,
+    bool use_huge_pages,
+    uint64_t term_length,
+    uint64_t page_size,
+    int32_t numa_node)
+{
+    uint64_t log_length = aeron_logbuffer_compute_log_length(term_length, page_size);
+
+    log->mapped_file.length = 0;
+    if ((log->mapped_file.addr = calloc(1, log_length)) == NULL)
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < AERON_LOGBUFFER_PARTITION_COUNT; i++)
+    {
+        log->term_buffers[i].addr = (uint8_t *)log->mapped_file.addr + (i * term_length);
+        log->term_buffers[i].length = term_length;
+    }
+
+    log->log_meta_data.addr = (uint8_t *)log->mapped_file.addr + (log_length - AERON_LOGBUFFER_META_DATA_LENGTH);
+    log->log_meta_data.length = AERON_LOGBUFFER_META_DATA_LENGTH;
+
+    log->term_length = term_length;
+    return 0;
+}
+
+static int benchmark_calloc_map_raw_log_close(aeron_mapped_raw_log_t *log, const char *filename)
+{
+    free(log->mapped_file.addr);
+    return 0;
+}
+
+static uint64_t benchmark_uint64_max_usable_fs_space(const char *path)
+{
+    return UINT64_MAX;
+}
+
+class BenchmarkDriver
+{
+public:
+    explicit BenchmarkDriver(size_t num_resources)
+    {
+        if (aeron_driver_context_init(&m_context) < 0)
+        {
+            throw std::runtime_error("could not init context: " + std::string(aeron_errmsg()));
+        }
+
+        m_context->threading_mode = AERON_THREADING_MODE_SHARED;
+        m_context->counters_values_buffer_length = 4 * 1024 * 1024;
+        m_context->counters_metadata_buffer_length =
+            m_context->counters_values_buffer_length *
+            (AERON_COUNTERS_MANAGER_METADATA_LENGTH / AERON_COUNTERS_MANAGER_VALUE_LENGTH);
+        m_context->cnc_map.length = aeron_cnc_length(m_context);
+        m_cnc = std::unique_ptr<uint8_t[]>(new uint8_t[m_context->cnc_map.length]);
+        m_context->cnc_map.addr = m_cnc.get();
+
+        memset(m_context->cnc_map.addr, 0, m_context->cnc_map.length);
+
+        aeron_driver_fill_cnc_metadata(m_context);
+
+        m_context->term_buffer_length = TERM_LENGTH;
+        m_context->ipc_term_buffer_length = TERM_LENGTH;
+        m_context->nano_clock = benchmark_nano_clock;
+        m_context->epoch_clock = benchmark_epoch_clock;
+        m_context->usable_fs_space_func = benchmark_uint64_max_usable_fs_space;
+        m_context->map_raw_log_func = benchmark_calloc_map_raw_log;
+        m_context->map_raw_log_close_func = benchmark_calloc_map_raw_log_close;
+
+        if (aeron_driver_conductor_init(&m_conductor, m_context) < 0)
+        {
+            throw std::runtime_error("could not init conductor: " + std::string(aeron_errmsg()));
+        }
+
+        m_context->conductor_proxy = &m_conductor.conductor_proxy;
+
+        if (aeron_driver_sender_init(&m_sender, m_context, &m_conductor.system_counters, &m_conductor.error_log) < 0)
+        {
+            throw std::runtime_error("could not init sender: " + std::string(aeron_errmsg()));
+        }
+
+        m_context->sender_proxy = &m_sender.sender_proxy;
+
+        if (aeron_driver_receiver_init(
+            &m_receiver, m_context, &m_conductor.system_counters, &m_conductor.error_log) < 0)
+        {
+            throw std::runtime_error("could not init receiver: " + std::string(aeron_errmsg()));
+        }
+
+        m_context->receiver_proxy = &m_receiver.receiver_proxy;
+
+        /* one client per publication so both the client and publication tables hold num_resources entries */
+        for (size_t i = 0; i < num_resources; i++)
+        {
+            addIpcPublication(CLIENT_ID_BASE + (int64_t)i, (int32_t)i, false);
+        }
+    }
+
+    ~BenchmarkDriver()
+    {
+        aeron_driver_conductor_on_close(&m_conductor);
+        aeron_driver_sender_on_close(&m_sender);
+        aeron_driver_receiver_on_close(&m_receiver);
+        m_context->cnc_map.addr = NULL;
+        aeron_driver_context_close(m_context);
+    }
+
+    int64_t addIpcPublication(int64_t client_id, int32_t stream_id, bool is_exclusive)
+    {
+        aeron_publication_command_t *command = (aeron_publication_command_t *)m_command;
+        int64_t correlation_id = m_next_correlation_id++;
+
+        command->correlated.client_id = client_id;
+        command->correlated.correlation_id = correlation_id;
+        command->stream_id = stream_id;
+        command->channel_length = AERON_IPC_CHANNEL_LEN;
+        memcpy(m_command + sizeof(aeron_publication_command_t), AERON_IPC_CHANNEL, AERON_IPC_CHANNEL_LEN);
+
+        onCommand(
+            is_exclusive ? AERON_COMMAND_ADD_EXCLUSIVE_PUBLICATION : AERON_COMMAND_ADD_PUBLICATION,
+            sizeof(aeron_publication_command_t) + AERON_IPC_CHANNEL_LEN);
+
+        return correlation_id;
+    }
+
+    void removePublication(int64_t client_id, int64_t registration_id)
+    {
+        aeron_remove_command_t *command = (aeron_remove_command_t *)m_command;
+
+        command->correlated.client_id = client_id;
+        command->correlated.correlation_id = m_next_correlation_id++;
+        command->registration_id = registration_id;
+
+        onCommand(AERON_COMMAND_REMOVE_PUBLICATION, sizeof(aeron_remove_command_t));
+    }
+
+    void clientKeepalive(int64_t client_id)
+    {
+        aeron_correlated_command_t *command = (aeron_correlated_command_t *)m_command;
+
+        command->client_id = client_id;
+        command->correlation_id = 0;
+
+        onCommand(AERON_COMMAND_CLIENT_KEEPALIVE, sizeof(aeron_correlated_command_t));
+    }
+
+private:
+    void onCommand(int32_t msg_type_id, size_t length)
+    {
+        int64_t errors_before = aeron_counter_get(m_conductor.errors_counter);
+
+        aeron_driver_conductor_on_command(msg_type_id, m_command, length, &m_conductor);
+
+        if (aeron_counter_get(m_conductor.errors_counter) != errors_before)
+        {
+            throw std::runtime_error("command failed: " + std::string(aeron_errmsg()));
+        }
+    }
+
+    aeron_driver_context_t *m_context = NULL;
+    std::unique_ptr<uint8_t[]> m_cnc;
+    aeron_driver_conductor_t m_conductor;
+    aeron_driver_sender_t m_sender;
+    aeron_driver_receiver_t m_receiver;
+    uint8_t m_command[MAX_COMMAND_LENGTH];
+    int64_t m_next_correlation_id = 1;
+};
+
+static void BM_ClientKeepalive(benchmark::State &state)
+{
+    const size_t num_resources = (size_t)state.range(0);
+    BenchmarkDriver driver(num_resources);
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        driver.clientKeepalive(CLIENT_ID_BASE + (int64_t)(i++ % num_resources));
+    }
+}
+
+BENCHMARK(BM_ClientKeepalive)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_AddRemoveSharedIpcPublication(benchmark::State &state)
+{
+    const size_t num_resources = (size_t)state.range(0);
+    BenchmarkDriver driver(num_resources);
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        const int64_t client_id = CLIENT_ID_BASE + (int64_t)(i++ % num_resources);
+        const int32_t stream_id = (int32_t)((i * 7919) % num_resources);
+        const int64_t registration_id = driver.addIpcPublication(client_id, stream_id, false);
+
+        driver.removePublication(client_id, registration_id);
+    }
+}
+
+BENCHMARK(BM_AddRemoveSharedIpcPublication)->RangeMultiplier(10)->Range(10, 10000);
+
+BENCHMARK_MAIN();
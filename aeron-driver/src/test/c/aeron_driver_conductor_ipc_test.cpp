@@ -724,3 +724,29 @@ TEST_F(DriverConductorIpcTest, shouldBeAbleToTimeoutIpcPublicationWithActiveIpcS
     EXPECT_EQ(readAllBroadcastsFromConductor(handler), 1u);
 }
 
+
+TEST_F(DriverConductorIpcTest, shouldNotHoldReplayPublicationLimitBelowInitialPositionWhenCleanerIsDedicated)
+{
+    aeron_driver_conductor_t *conductor = &m_conductor.m_conductor;
+    int64_t client_id = nextCorrelationId();
+    int64_t pub_id = nextCorrelationId();
+    int64_t sub_id = nextCorrelationId();
+    int64_t bytes_cleaned = 0, cleaner_lag = 0;
+    const int64_t initial_position = (5 * TERM_LENGTH) + 1024;
+
+    aeron_term_cleaner_close(&conductor->term_cleaner);
+    ASSERT_EQ(aeron_term_cleaner_init(&conductor->term_cleaner, true, false, &bytes_cleaned, &cleaner_lag), 0);
+
+    ASSERT_EQ(addNetworkPublication(
+        client_id, pub_id, AERON_IPC_CHANNEL "?init-term-id=10|term-id=15|term-offset=1024", STREAM_ID_1, true), 0);
+    ASSERT_EQ(addIpcSubscription(client_id, sub_id, STREAM_ID_1, -1), 0);
+    doWork();
+
+    aeron_ipc_publication_t *publication = aeron_driver_conductor_find_ipc_publication(conductor, pub_id);
+    ASSERT_NE(publication, (aeron_ipc_publication_t *)NULL);
+    EXPECT_EQ(publication->cleaned_position, initial_position);
+
+    doWork();
+
+    EXPECT_GT(aeron_counter_get(publication->pub_lmt_position.value_addr), initial_position);
+}
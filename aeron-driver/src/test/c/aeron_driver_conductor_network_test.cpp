@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <utility>
+#include <vector>
+
 #include "aeron_driver_conductor_test.h"
 
 class DriverConductorNetworkTest : public DriverConductorTest
@@ -217,6 +220,51 @@ TEST_F(DriverConductorNetworkTest, shouldBeAbleToAddMultipleNetworkPublicationsD
     EXPECT_EQ(readAllBroadcastsFromConductor(null_handler), 4u);
 }
 
+TEST_F(DriverConductorNetworkTest, shouldPinSendChannelEndpointsToSenderWithFewestPublications)
+{
+    /* outlives the fixture so releasing what is pinned to it on close is safe */
+    static aeron_driver_sender_proxy_t shard_proxy;
+    shard_proxy = m_conductor.m_sender.sender_proxy;
+    shard_proxy.endpoint_count = 0;
+    shard_proxy.publication_count = 0;
+
+    m_context.m_context->sender_count = 2;
+    m_context.m_context->sender_proxies[0] = m_context.m_context->sender_proxy;
+    m_context.m_context->sender_proxies[1] = &shard_proxy;
+
+    int64_t client_id = nextCorrelationId();
+    int64_t pub_id_1 = nextCorrelationId();
+    int64_t pub_id_2 = nextCorrelationId();
+    int64_t pub_id_3 = nextCorrelationId();
+    int64_t pub_id_4 = nextCorrelationId();
+
+    ASSERT_EQ(addNetworkPublication(client_id, pub_id_1, CHANNEL_1, STREAM_ID_1, false), 0);
+    ASSERT_EQ(addNetworkPublication(client_id, pub_id_2, CHANNEL_1, STREAM_ID_2, false), 0);
+    ASSERT_EQ(addNetworkPublication(client_id, pub_id_3, CHANNEL_2, STREAM_ID_1, false), 0);
+    ASSERT_EQ(addNetworkPublication(client_id, pub_id_4, CHANNEL_3, STREAM_ID_1, false), 0);
+    doWork();
+
+    aeron_send_channel_endpoint_t *endpoint_1 = aeron_driver_conductor_find_send_channel_endpoint(
+        &m_conductor.m_conductor, CHANNEL_1);
+    aeron_send_channel_endpoint_t *endpoint_2 = aeron_driver_conductor_find_send_channel_endpoint(
+        &m_conductor.m_conductor, CHANNEL_2);
+    aeron_send_channel_endpoint_t *endpoint_3 = aeron_driver_conductor_find_send_channel_endpoint(
+        &m_conductor.m_conductor, CHANNEL_3);
+
+    ASSERT_NE(endpoint_1, (aeron_send_channel_endpoint_t *)NULL);
+    ASSERT_NE(endpoint_2, (aeron_send_channel_endpoint_t *)NULL);
+    ASSERT_NE(endpoint_3, (aeron_send_channel_endpoint_t *)NULL);
+
+    EXPECT_EQ(endpoint_1->sender_proxy, m_context.m_context->sender_proxy);
+    EXPECT_EQ(endpoint_2->sender_proxy, &shard_proxy);
+    EXPECT_EQ(endpoint_3->sender_proxy, &shard_proxy);
+    EXPECT_EQ(m_context.m_context->sender_proxy->publication_count, 2u);
+    EXPECT_EQ(shard_proxy.publication_count, 2u);
+    EXPECT_EQ(shard_proxy.endpoint_count, 2u);
+
+    EXPECT_EQ(readAllBroadcastsFromConductor(null_handler), 4u);
+}
+
 TEST_F(DriverConductorNetworkTest, shouldBeAbleToAddAndRemoveMultipleNetworkPublicationsToSameChannelSameStreamId)
 {
     int64_t client_id = nextCorrelationId();
@@ -354,6 +402,152 @@ TEST_F(DriverConductorNetworkTest, shouldBeAbleToAddMultipleNetworkSubscriptions
     EXPECT_EQ(readAllBroadcastsFromConductor(null_handler), 4u);
 }
 
+TEST_F(DriverConductorNetworkTest, shouldShardReceiveChannelEndpointsToReceiverWithFewestEndpoints)
+{
+    /* outlives the fixture so deleting the endpoint sharded to it on close is safe */
+    static aeron_driver_receiver_proxy_t shard_proxy;
+    shard_proxy = m_conductor.m_receiver.receiver_proxy;
+    shard_proxy.endpoint_count = 0;
+
+    m_context.m_context->receiver_count = 2;
+    m_context.m_context->receiver_proxies[0] = m_context.m_context->receiver_proxy;
+    m_context.m_context->receiver_proxies[1] = &shard_proxy;
+
+    int64_t client_id = nextCorrelationId();
+    int64_t sub_id_1 = nextCorrelationId();
+    int64_t sub_id_2 = nextCorrelationId();
+    int64_t sub_id_3 = nextCorrelationId();
+
+    ASSERT_EQ(addNetworkSubscription(client_id, sub_id_1, CHANNEL_1, STREAM_ID_1, -1), 0);
+    ASSERT_EQ(addNetworkSubscription(client_id, sub_id_2, CHANNEL_2, STREAM_ID_1, -1), 0);
+    ASSERT_EQ(addNetworkSubscription(client_id, sub_id_3, CHANNEL_3, STREAM_ID_1, -1), 0);
+
+    doWork();
+
+    aeron_receive_channel_endpoint_t *endpoint_1 = aeron_driver_conductor_find_receive_channel_endpoint(
+        &m_conductor.m_conductor, CHANNEL_1);
+    aeron_receive_channel_endpoint_t *endpoint_2 = aeron_driver_conductor_find_receive_channel_endpoint(
+        &m_conductor.m_conductor, CHANNEL_2);
+    aeron_receive_channel_endpoint_t *endpoint_3 = aeron_driver_conductor_find_receive_channel_endpoint(
+        &m_conductor.m_conductor, CHANNEL_3);
+
+    ASSERT_NE(endpoint_1, (aeron_receive_channel_endpoint_t *)NULL);
+    ASSERT_NE(endpoint_2, (aeron_receive_channel_endpoint_t *)NULL);
+    ASSERT_NE(endpoint_3, (aeron_receive_channel_endpoint_t *)NULL);
+
+    EXPECT_EQ(endpoint_1->receiver_proxy, m_context.m_context->receiver_proxy);
+    EXPECT_EQ(endpoint_2->receiver_proxy, &shard_proxy);
+    EXPECT_EQ(endpoint_3->receiver_proxy, m_context.m_context->receiver_proxy);
+    EXPECT_EQ(m_context.m_context->receiver_proxy->endpoint_count, 2u);
+    EXPECT_EQ(shard_proxy.endpoint_count, 1u);
+
+    EXPECT_EQ(readAllBroadcastsFromConductor(null_handler), 3u);
+}
+
+TEST_F(DriverConductorNetworkTest, shouldAddAndRemoveReceiveDestinationsForManualControlModeSubscription)
+{
+    int64_t client_id = nextCorrelationId();
+    int64_t sub_id_1 = nextCorrelationId();
+    int64_t sub_id_2 = nextCorrelationId();
+    int64_t add_id_1 = nextCorrelationId();
+    int64_t add_id_2 = nextCorrelationId();
+    int64_t remove_id = nextCorrelationId();
+
+    ASSERT_EQ(addNetworkSubscription(client_id, sub_id_1, CHANNEL_MDC_MANUAL, STREAM_ID_1, -1), 0);
+    ASSERT_EQ(addNetworkSubscription(client_id, sub_id_2, CHANNEL_MDC_MANUAL, STREAM_ID_1, -1), 0);
+    doWork();
+    EXPECT_EQ(aeron_driver_conductor_num_receive_channel_endpoints(&m_conductor.m_conductor), 2u);
+    EXPECT_EQ(readAllBroadcastsFromConductor(null_handler), 2u);
+
+    aeron_receive_channel_endpoint_t *endpoint = m_conductor.m_conductor.network_subscriptions.array[0].endpoint;
+    ASSERT_TRUE(endpoint->is_manual_control_mode);
+    EXPECT_EQ(endpoint->transport.fd, -1);
+
+    ASSERT_EQ(addReceiveDestination(client_id, add_id_1, sub_id_1, CHANNEL_1), 0);
+    ASSERT_EQ(addReceiveDestination(client_id, add_id_2, sub_id_1, CHANNEL_2), 0);
+    doWork();
+    ASSERT_EQ(endpoint->destinations.length, 2u);
+    EXPECT_GT(endpoint->so_rcvbuf, 0u);
+    EXPECT_EQ(readAllBroadcastsFromConductor(null_handler), 2u);
+
+    ASSERT_EQ(removeReceiveDestination(client_id, remove_id, sub_id_1, CHANNEL_1), 0);
+    doWork();
+    auto handler = [&](std::int32_t msgTypeId, AtomicBuffer& buffer, util::index_t offset, util::index_t length)
+    {
+        ASSERT_EQ(msgTypeId, AERON_RESPONSE_ON_OPERATION_SUCCESS);
+
+        const command::OperationSucceededFlyweight response(buffer, offset);
+
+        EXPECT_EQ(response.correlationId(), remove_id);
+    };
+
+    EXPECT_EQ(readAllBroadcastsFromConductor(handler), 1u);
+    ASSERT_EQ(endpoint->destinations.length, 1u);
+    EXPECT_STREQ(endpoint->destinations.array[0].destination->udp_channel->original_uri, CHANNEL_2);
+}
+
+TEST_F(DriverConductorNetworkTest, shouldErrorOnRemoveOfUnknownReceiveDestination)
+{
+    int64_t client_id = nextCorrelationId();
+    int64_t sub_id = nextCorrelationId();
+    int64_t add_id = nextCorrelationId();
+    int64_t remove_id_1 = nextCorrelationId();
+    int64_t remove_id_2 = nextCorrelationId();
+
+    ASSERT_EQ(addNetworkSubscription(client_id, sub_id, CHANNEL_MDC_MANUAL, STREAM_ID_1, -1), 0);
+    ASSERT_EQ(addReceiveDestination(client_id, add_id, sub_id, CHANNEL_1), 0);
+    doWork();
+    EXPECT_EQ(readAllBroadcastsFromConductor(null_handler), 2u);
+
+    ASSERT_EQ(removeReceiveDestination(client_id, remove_id_1, sub_id, CHANNEL_1), 0);
+    ASSERT_EQ(removeReceiveDestination(client_id, remove_id_2, sub_id, CHANNEL_1), 0);
+    doWork();
+
+    std::vector<std::pair<std::int32_t, int64_t>> responses;
+    auto handler = [&](std::int32_t msgTypeId, AtomicBuffer& buffer, util::index_t offset, util::index_t length)
+    {
+        if (AERON_RESPONSE_ON_ERROR == msgTypeId)
+        {
+            const command::ErrorResponseFlyweight response(buffer, offset);
+            responses.push_back(std::make_pair(msgTypeId, response.offendingCommandCorrelationId()));
+        }
+        else
+        {
+            const command::OperationSucceededFlyweight response(buffer, offset);
+            responses.push_back(std::make_pair(msgTypeId, response.correlationId()));
+        }
+    };
+
+    EXPECT_EQ(readAllBroadcastsFromConductor(handler), 2u);
+    ASSERT_EQ(responses.size(), 2u);
+    EXPECT_EQ(responses[0], std::make_pair((std::int32_t)AERON_RESPONSE_ON_OPERATION_SUCCESS, remove_id_1));
+    EXPECT_EQ(responses[1], std::make_pair((std::int32_t)AERON_RESPONSE_ON_ERROR, remove_id_2));
+}
+
+TEST_F(DriverConductorNetworkTest, shouldErrorOnAddReceiveDestinationToDynamicSubscription)
+{
+    int64_t client_id = nextCorrelationId();
+    int64_t sub_id = nextCorrelationId();
+    int64_t add_id = nextCorrelationId();
+
+    ASSERT_EQ(addNetworkSubscription(client_id, sub_id, CHANNEL_1, STREAM_ID_1, -1), 0);
+    doWork();
+    EXPECT_EQ(readAllBroadcastsFromConductor(null_handler), 1u);
+
+    ASSERT_EQ(addReceiveDestination(client_id, add_id, sub_id, CHANNEL_2), 0);
+    doWork();
+    auto handler = [&](std::int32_t msgTypeId, AtomicBuffer& buffer, util::index_t offset, util::index_t length)
+    {
+        ASSERT_EQ(msgTypeId, AERON_RESPONSE_ON_ERROR);
+
+        const command::ErrorResponseFlyweight response(buffer, offset);
+
+        EXPECT_EQ(response.offendingCommandCorrelationId(), add_id);
+    };
+
+    EXPECT_EQ(readAllBroadcastsFromConductor(handler), 1u);
+}
+
 TEST_F(DriverConductorNetworkTest, shouldKeepSubscriptionMediaEndpointUponRemovalOfAllButOneSubscriber)
 {
     int64_t client_id = nextCorrelationId();
@@ -1018,3 +1212,127 @@ TEST_F(DriverConductorNetworkTest, shouldTimeoutImageAndSendUnavailableImageWhen
 
     EXPECT_EQ(readAllBroadcastsFromConductor(handler), 6u);
 }
+
+static void appendDataFrame(uint8_t *term_buffer, int32_t term_offset, int32_t frame_length)
+{
+    aeron_data_header_t *data_header = (aeron_data_header_t *)(term_buffer + term_offset);
+
+    data_header->frame_header.type = AERON_HDR_TYPE_DATA;
+    data_header->frame_header.frame_length = frame_length;
+}
+
+TEST_F(DriverConductorNetworkTest, shouldStageSendBatchUntilFlushed)
+{
+    int64_t client_id = nextCorrelationId();
+    int64_t pub_id = nextCorrelationId();
+    uint8_t buffer[AERON_DATA_HEADER_LENGTH] = { 0 };
+
+    ASSERT_EQ(addNetworkPublication(client_id, pub_id, CHANNEL_1, STREAM_ID_1, false), 0);
+    doWork();
+
+    aeron_network_publication_t *publication = aeron_driver_conductor_find_network_publication(
+        &m_conductor.m_conductor, pub_id);
+    ASSERT_NE(publication, (aeron_network_publication_t *)NULL);
+    aeron_send_channel_endpoint_t *endpoint = publication->endpoint;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(aeron_send_channel_endpoint_send_batch_add(
+            endpoint, buffer, sizeof(buffer), 0, publication->short_sends_counter), 0) << aeron_errmsg();
+    }
+
+    EXPECT_EQ(endpoint->send_batch.length, 3u);
+    EXPECT_EQ(endpoint->send_batch.iov[2].iov_base, (void *)buffer);
+    EXPECT_EQ(endpoint->send_batch.iov[2].iov_len, sizeof(buffer));
+
+    EXPECT_EQ(aeron_send_channel_endpoint_send_batch_flush(endpoint, publication->short_sends_counter), 3);
+    EXPECT_EQ(endpoint->send_batch.length, 0u);
+    EXPECT_EQ(aeron_send_channel_endpoint_send_batch_flush(endpoint, publication->short_sends_counter), 0);
+    EXPECT_EQ(aeron_counter_get(publication->short_sends_counter), 0);
+}
+
+TEST_F(DriverConductorNetworkTest, shouldFlushFullSendBatchBeforeStagingMore)
+{
+    int64_t client_id = nextCorrelationId();
+    int64_t pub_id = nextCorrelationId();
+    uint8_t buffer[AERON_DATA_HEADER_LENGTH] = { 0 };
+
+    ASSERT_EQ(addNetworkPublication(client_id, pub_id, CHANNEL_1, STREAM_ID_1, false), 0);
+    doWork();
+
+    aeron_network_publication_t *publication = aeron_driver_conductor_find_network_publication(
+        &m_conductor.m_conductor, pub_id);
+    ASSERT_NE(publication, (aeron_network_publication_t *)NULL);
+    aeron_send_channel_endpoint_t *endpoint = publication->endpoint;
+
+    for (size_t i = 0; i < AERON_SEND_CHANNEL_ENDPOINT_SEND_BATCH_CAPACITY; i++)
+    {
+        ASSERT_EQ(aeron_send_channel_endpoint_send_batch_add(
+            endpoint, buffer, sizeof(buffer), 0, publication->short_sends_counter), 0) << aeron_errmsg();
+    }
+
+    EXPECT_EQ(endpoint->send_batch.length, (size_t)AERON_SEND_CHANNEL_ENDPOINT_SEND_BATCH_CAPACITY);
+
+    ASSERT_EQ(aeron_send_channel_endpoint_send_batch_add(
+        endpoint, buffer, sizeof(buffer), 0, publication->short_sends_counter), 0) << aeron_errmsg();
+    EXPECT_EQ(endpoint->send_batch.length, 1u);
+}
+
+TEST_F(DriverConductorNetworkTest, shouldAdvanceSenderPositionBySentChunks)
+{
+    int64_t client_id = nextCorrelationId();
+    int64_t pub_id = nextCorrelationId();
+
+    ASSERT_EQ(addNetworkPublication(client_id, pub_id, CHANNEL_1, STREAM_ID_1, false), 0);
+    doWork();
+
+    aeron_network_publication_t *publication = aeron_driver_conductor_find_network_publication(
+        &m_conductor.m_conductor, pub_id);
+    ASSERT_NE(publication, (aeron_network_publication_t *)NULL);
+
+    const int32_t mtu_length = (int32_t)publication->mtu_length;
+    uint8_t *term_buffer = publication->mapped_raw_log.term_buffers[0].addr;
+    appendDataFrame(term_buffer, 0, mtu_length);
+    appendDataFrame(term_buffer, mtu_length, mtu_length);
+    aeron_counter_set_ordered(publication->snd_lmt_position.value_addr, TERM_LENGTH);
+
+    EXPECT_EQ(aeron_network_publication_send_data(publication, 0, 0, 0, 4), 2 * mtu_length);
+    EXPECT_EQ(aeron_counter_get(publication->snd_pos_position.value_addr), 2 * mtu_length);
+    EXPECT_EQ(publication->endpoint->send_batch.length, 2u);
+}
+
+TEST_F(DriverConductorNetworkTest, shouldNotAdvanceSenderPositionPastChunkThatFailedToStage)
+{
+    int64_t client_id = nextCorrelationId();
+    int64_t pub_id = nextCorrelationId();
+    uint8_t buffer[AERON_DATA_HEADER_LENGTH] = { 0 };
+
+    ASSERT_EQ(addNetworkPublication(client_id, pub_id, CHANNEL_1, STREAM_ID_1, false), 0);
+    doWork();
+
+    aeron_network_publication_t *publication = aeron_driver_conductor_find_network_publication(
+        &m_conductor.m_conductor, pub_id);
+    ASSERT_NE(publication, (aeron_network_publication_t *)NULL);
+    aeron_send_channel_endpoint_t *endpoint = publication->endpoint;
+
+    const int32_t mtu_length = (int32_t)publication->mtu_length;
+    uint8_t *term_buffer = publication->mapped_raw_log.term_buffers[0].addr;
+    appendDataFrame(term_buffer, 0, mtu_length);
+    appendDataFrame(term_buffer, mtu_length, mtu_length);
+    aeron_counter_set_ordered(publication->snd_lmt_position.value_addr, TERM_LENGTH);
+
+    /* leave room for the first chunk only, so staging the second must flush and the flush fails */
+    for (size_t i = 0; i < AERON_SEND_CHANNEL_ENDPOINT_SEND_BATCH_CAPACITY - 1; i++)
+    {
+        ASSERT_EQ(aeron_send_channel_endpoint_send_batch_add(
+            endpoint, buffer, sizeof(buffer), 0, publication->short_sends_counter), 0) << aeron_errmsg();
+    }
+
+    const aeron_fd_t fd = endpoint->transport.fd;
+    endpoint->transport.fd = -1;
+    const int result = aeron_network_publication_send_data(publication, 0, 0, 0, 4);
+    endpoint->transport.fd = fd;
+
+    EXPECT_EQ(result, -1);
+    EXPECT_EQ(aeron_counter_get(publication->snd_pos_position.value_addr), mtu_length);
+}
@@ -48,6 +48,7 @@ extern "C"
 #include "command/CounterMessageFlyweight.h"
 #include "command/CounterUpdateFlyweight.h"
 #include "command/ClientTimeoutFlyweight.h"
+#include "command/DestinationMessageFlyweight.h"
 
 using namespace aeron::concurrent::broadcast;
 using namespace aeron::concurrent::ringbuffer;
@@ -58,6 +59,7 @@ using namespace aeron;
 #define CHANNEL_2 "aeron:udp?endpoint=localhost:40002"
 #define CHANNEL_3 "aeron:udp?endpoint=localhost:40003"
 #define CHANNEL_4 "aeron:udp?endpoint=localhost:40004"
+#define CHANNEL_MDC_MANUAL "aeron:udp?control-mode=manual"
 #define INVALID_URI "aeron:udp://"
 
 #define STREAM_ID_1 (101)
@@ -90,7 +92,13 @@ static int64_t test_epoch_clock()
 }
 
 static int test_malloc_map_raw_log(
-    aeron_mapped_raw_log_t *log, const char *path, bool use_sparse_file, uint64_t term_length, uint64_t page_size)
+    aeron_mapped_raw_log_t *log,
+    const char *path,
+    bool use_sparse_file,
+    bool use_huge_pages,
+    uint64_t term_length,
+    uint64_t page_size,
+    int32_t numa_node)
 {
     uint64_t log_length = aeron_logbuffer_compute_log_length(term_length, page_size);
 
@@ -339,6 +347,32 @@ public:
         return writeCommand(AERON_COMMAND_REMOVE_SUBSCRIPTION, command.length());
     }
 
+    int addReceiveDestination(
+        int64_t client_id, int64_t correlation_id, int64_t registration_id, const char *channel)
+    {
+        command::DestinationMessageFlyweight command(m_command, 0);
+
+        command.clientId(client_id);
+        command.correlationId(correlation_id);
+        command.registrationId(registration_id);
+        command.channel(channel);
+
+        return writeCommand(AERON_COMMAND_ADD_RCV_DESTINATION, command.length());
+    }
+
+    int removeReceiveDestination(
+        int64_t client_id, int64_t correlation_id, int64_t registration_id, const char *channel)
+    {
+        command::DestinationMessageFlyweight command(m_command, 0);
+
+        command.clientId(client_id);
+        command.correlationId(correlation_id);
+        command.registrationId(registration_id);
+        command.channel(channel);
+
+        return writeCommand(AERON_COMMAND_REMOVE_RCV_DESTINATION, command.length());
+    }
+
     int clientKeepalive(int64_t client_id)
     {
         command::CorrelatedMessageFlyweight command(m_command, 0);
@@ -0,0 +1,393 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "aeron_driver_conductor_test.h"
+
+extern "C"
+{
+#include "util/aeron_bitutil.h"
+#include "concurrent/aeron_thread.h"
+}
+
+#define RECEIVER_PORT (40001)
+#define POLL_ATTEMPTS (1000)
+
+typedef aeron_driver_receiver_stct::aeron_driver_receiver_buffers_stct recv_buffers_t;
+
+class DriverReceiverTest : public DriverConductorTest
+{
+public:
+    DriverReceiverTest() : DriverConductorTest()
+    {
+        m_fd = socket(AF_INET, SOCK_DGRAM, 0);
+        m_invalid_packets = aeron_system_counter_addr(
+            &m_conductor.m_conductor.system_counters, AERON_SYSTEM_COUNTER_INVALID_PACKETS);
+    }
+
+    virtual ~DriverReceiverTest()
+    {
+        close(m_fd);
+    }
+
+    void addSubscription()
+    {
+        ASSERT_EQ(addNetworkSubscription(nextCorrelationId(), nextCorrelationId(), CHANNEL_1, STREAM_ID_1, -1), 0);
+        doWork();
+        ASSERT_EQ(readAllBroadcastsFromConductor(null_handler), 1u);
+    }
+
+    aeron_publication_image_t *addZeroCopyImage()
+    {
+        m_context.m_context->receiver_zero_copy_enabled = true;
+        addSubscription();
+
+        aeron_receive_channel_endpoint_t *endpoint = aeron_driver_conductor_find_receive_channel_endpoint(
+            &m_conductor.m_conductor, CHANNEL_1);
+        if (NULL == endpoint)
+        {
+            return NULL;
+        }
+
+        createPublicationImage(endpoint, STREAM_ID_1, 0);
+        aeron_publication_image_t *image = aeron_driver_conductor_find_publication_image(
+            &m_conductor.m_conductor, endpoint, STREAM_ID_1);
+
+        return NULL != image && image == endpoint->zero_copy_image ? image : NULL;
+    }
+
+    void sendBytes(const uint8_t *buffer, size_t length)
+    {
+        struct sockaddr_in addr;
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(RECEIVER_PORT);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        ASSERT_EQ(sendto(m_fd, buffer, length, 0, (struct sockaddr *)&addr, sizeof(addr)), (ssize_t)length);
+    }
+
+    void sendDatagram(size_t length)
+    {
+        std::unique_ptr<uint8_t[]> datagram(new uint8_t[length]);
+
+        memset(datagram.get(), 0, length);
+        sendBytes(datagram.get(), length);
+    }
+
+    template<typename F>
+    bool receiveUntil(F&& condition)
+    {
+        for (int i = 0; i < POLL_ATTEMPTS; i++)
+        {
+            aeron_driver_receiver_do_work(&m_conductor.m_receiver);
+            if (condition())
+            {
+                return true;
+            }
+
+            aeron_micro_sleep(1000);
+        }
+
+        return false;
+    }
+
+    bool receiveUntilInvalidPackets(int64_t expected)
+    {
+        return receiveUntil([&]() { return aeron_counter_get(m_invalid_packets) >= expected; });
+    }
+
+    void expectHeadersReset()
+    {
+        recv_buffers_t *buffers = &m_conductor.m_receiver.recv_buffers;
+
+        for (size_t i = 0; i < buffers->capacity; i++)
+        {
+            struct mmsghdr *header = &buffers->mmsghdrs[i];
+
+            EXPECT_EQ(header->msg_len, 0u) << i;
+            EXPECT_EQ(header->msg_hdr.msg_flags, 0) << i;
+            EXPECT_EQ(header->msg_hdr.msg_namelen, sizeof(struct sockaddr_storage)) << i;
+            EXPECT_EQ(header->msg_hdr.msg_controllen, (size_t)AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH) << i;
+            EXPECT_EQ(header->msg_hdr.msg_iov, &buffers->iov[i]) << i;
+        }
+    }
+
+protected:
+    int m_fd;
+    int64_t *m_invalid_packets;
+};
+
+static void fillDataFrame(uint8_t *buffer, int32_t term_offset, size_t payload_length, uint8_t fill)
+{
+    aeron_data_header_t *header = (aeron_data_header_t *)buffer;
+
+    memset(buffer, 0, AERON_DATA_HEADER_LENGTH);
+    header->frame_header.frame_length = (int32_t)(AERON_DATA_HEADER_LENGTH + payload_length);
+    header->frame_header.version = AERON_FRAME_HEADER_VERSION;
+    header->frame_header.flags = AERON_DATA_HEADER_BEGIN_FLAG | AERON_DATA_HEADER_END_FLAG;
+    header->frame_header.type = AERON_HDR_TYPE_DATA;
+    header->term_offset = term_offset;
+    header->session_id = SESSION_ID;
+    header->stream_id = STREAM_ID_1;
+    header->term_id = INITIAL_TERM_ID;
+    memset(buffer + AERON_DATA_HEADER_LENGTH, fill, payload_length);
+}
+
+static bool isZero(const uint8_t *buffer, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        if (0 != buffer[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void expectSlots(recv_buffers_t *buffers, size_t slot_length)
+{
+    EXPECT_EQ(buffers->slot_length, slot_length);
+    EXPECT_EQ(slot_length % (AERON_CACHE_LINE_LENGTH * 2), 0u);
+
+    for (size_t i = 0; i < buffers->capacity; i++)
+    {
+        const uintptr_t base = (uintptr_t)buffers->iov[i].iov_base;
+
+        EXPECT_EQ(base % (AERON_CACHE_LINE_LENGTH * 2), 0u) << i;
+        EXPECT_EQ(buffers->iov[i].iov_len, slot_length) << i;
+        if (i > 0)
+        {
+            EXPECT_EQ(base - (uintptr_t)buffers->iov[i - 1].iov_base, slot_length) << i;
+        }
+    }
+}
+
+TEST_F(DriverReceiverTest, shouldSizeSlotsToMtuInWholeCacheLinePairs)
+{
+    recv_buffers_t *buffers = &m_conductor.m_receiver.recv_buffers;
+
+    EXPECT_EQ(buffers->capacity, m_context.m_context->receiver_io_vector_capacity);
+    expectSlots(buffers, AERON_ALIGN(m_context.m_context->mtu_length, AERON_CACHE_LINE_LENGTH * 2));
+    expectHeadersReset();
+}
+
+TEST_F(DriverReceiverTest, shouldSizeSlotsToMaxUdpPacketWithGro)
+{
+    aeron_driver_receiver_t receiver;
+
+    m_context.m_context->socket_gro_enabled = true;
+    ASSERT_EQ(aeron_driver_receiver_init(
+        &receiver, m_context.m_context, &m_conductor.m_conductor.system_counters, &m_conductor.m_conductor.error_log),
+        0) << aeron_errmsg();
+
+    expectSlots(
+        &receiver.recv_buffers, AERON_ALIGN(AERON_DRIVER_RECEIVER_MAX_UDP_PACKET_LENGTH, AERON_CACHE_LINE_LENGTH * 2));
+
+    aeron_driver_receiver_on_close(&receiver);
+    m_context.m_context->socket_gro_enabled = false;
+}
+
+TEST_F(DriverReceiverTest, shouldGrowSlotsToLargestSenderMtu)
+{
+    addSubscription();
+
+    aeron_receive_channel_endpoint_t *endpoint = aeron_driver_conductor_find_receive_channel_endpoint(
+        &m_conductor.m_conductor, CHANNEL_1);
+    ASSERT_NE(endpoint, (aeron_receive_channel_endpoint_t *)NULL);
+
+    const size_t initial_slot_length = m_conductor.m_receiver.recv_buffers.slot_length;
+    const size_t sender_mtu_length = 8192 + AERON_DATA_HEADER_LENGTH;
+
+    m_context.m_context->mtu_length = sender_mtu_length;
+    createPublicationImage(endpoint, STREAM_ID_1, 1000);
+    ASSERT_EQ(aeron_driver_conductor_num_images(&m_conductor.m_conductor), 1u);
+
+    EXPECT_GT(m_conductor.m_receiver.recv_buffers.slot_length, initial_slot_length);
+    expectSlots(&m_conductor.m_receiver.recv_buffers, AERON_ALIGN(sender_mtu_length, AERON_CACHE_LINE_LENGTH * 2));
+}
+
+TEST_F(DriverReceiverTest, shouldResetHeadersBetweenPolls)
+{
+    addSubscription();
+
+    const int64_t invalid_packets = aeron_counter_get(m_invalid_packets);
+
+    /* shorter than a frame header, so counted invalid by the endpoint once dispatched */
+    sendDatagram(sizeof(aeron_frame_header_t) - 1);
+    sendDatagram(sizeof(aeron_frame_header_t) - 1);
+    ASSERT_TRUE(receiveUntilInvalidPackets(invalid_packets + 2));
+
+    expectHeadersReset();
+}
+
+TEST_F(DriverReceiverTest, shouldCountTruncatedDatagramsAsInvalid)
+{
+    addSubscription();
+
+    const int64_t invalid_packets = aeron_counter_get(m_invalid_packets);
+    const int64_t bytes_received = aeron_counter_get(m_conductor.m_receiver.total_bytes_received_counter);
+
+    sendDatagram(m_conductor.m_receiver.recv_buffers.slot_length + 1024);
+    ASSERT_TRUE(receiveUntilInvalidPackets(invalid_packets + 1));
+
+    EXPECT_EQ(aeron_counter_get(m_invalid_packets), invalid_packets + 1);
+    EXPECT_GT(aeron_counter_get(m_conductor.m_receiver.total_bytes_received_counter), bytes_received);
+    expectHeadersReset();
+}
+
+TEST_F(DriverReceiverTest, shouldTargetPayloadAtHighWaterMarkWithinWindowAndTerm)
+{
+    aeron_publication_image_t *image = addZeroCopyImage();
+    ASSERT_NE(image, (aeron_publication_image_t *)NULL);
+
+    uint8_t *term_buffer = image->mapped_raw_log.term_buffers[0].addr;
+    size_t length = 0;
+
+    image->last_sm_position_window_limit = TERM_LENGTH;
+    EXPECT_EQ(aeron_publication_image_zero_copy_target(image, 1024, &length), term_buffer + AERON_DATA_HEADER_LENGTH);
+    EXPECT_EQ(length, 1024u);
+
+    image->last_sm_position_window_limit = AERON_DATA_HEADER_LENGTH + 64;
+    EXPECT_EQ(aeron_publication_image_zero_copy_target(image, 1024, &length), term_buffer + AERON_DATA_HEADER_LENGTH);
+    EXPECT_EQ(length, 64u);
+
+    image->last_sm_position_window_limit = AERON_DATA_HEADER_LENGTH;
+    EXPECT_EQ(aeron_publication_image_zero_copy_target(image, 1024, &length), (uint8_t *)NULL);
+    EXPECT_EQ(length, 0u);
+
+    image->last_sm_position_window_limit = TERM_LENGTH;
+    aeron_counter_set_ordered(image->rcv_hwm_position.value_addr, TERM_LENGTH - AERON_DATA_HEADER_LENGTH - 64);
+    EXPECT_EQ(aeron_publication_image_zero_copy_target(image, 1024, &length), term_buffer + TERM_LENGTH - 64);
+    EXPECT_EQ(length, 64u);
+}
+
+TEST_F(DriverReceiverTest, shouldInsertInPlaceOnlyAtHighWaterMark)
+{
+    aeron_publication_image_t *image = addZeroCopyImage();
+    ASSERT_NE(image, (aeron_publication_image_t *)NULL);
+
+    uint8_t *term_buffer = image->mapped_raw_log.term_buffers[0].addr;
+    uint8_t frame[AERON_DATA_HEADER_LENGTH + 64];
+    const size_t frame_length = sizeof(frame);
+
+    fillDataFrame(frame, (int32_t)frame_length, 64, 0x5A);
+    EXPECT_FALSE(aeron_publication_image_insert_in_place(image, frame, frame_length));
+
+    fillDataFrame(frame, 0, 64, 0x5A);
+    ((aeron_data_header_t *)frame)->session_id = SESSION_ID + 1;
+    EXPECT_FALSE(aeron_publication_image_insert_in_place(image, frame, frame_length));
+
+    fillDataFrame(frame, 0, 64, 0x5A);
+    ((aeron_data_header_t *)frame)->frame_header.type = AERON_HDR_TYPE_PAD;
+    EXPECT_FALSE(aeron_publication_image_insert_in_place(image, frame, frame_length));
+
+    EXPECT_EQ(aeron_counter_get(image->rcv_hwm_position.value_addr), 0);
+    EXPECT_TRUE(isZero(term_buffer, frame_length));
+
+    /* the payload is already in the term, as received, so only the header is written */
+    fillDataFrame(frame, 0, 64, 0x5A);
+    memcpy(term_buffer + AERON_DATA_HEADER_LENGTH, frame + AERON_DATA_HEADER_LENGTH, 64);
+    EXPECT_TRUE(aeron_publication_image_insert_in_place(image, frame, frame_length));
+
+    EXPECT_EQ(memcmp(term_buffer, frame, frame_length), 0);
+    EXPECT_EQ(aeron_counter_get(image->rcv_hwm_position.value_addr), (int64_t)frame_length);
+}
+
+TEST_F(DriverReceiverTest, shouldReceiveInOrderDatagramStraightIntoTerm)
+{
+    aeron_publication_image_t *image = addZeroCopyImage();
+    ASSERT_NE(image, (aeron_publication_image_t *)NULL);
+
+    uint8_t *term_buffer = image->mapped_raw_log.term_buffers[0].addr;
+    uint8_t frame[AERON_DATA_HEADER_LENGTH + 256];
+
+    fillDataFrame(frame, 0, 256, 0x11);
+    sendBytes(frame, sizeof(frame));
+    ASSERT_TRUE(receiveUntil(
+        [&]() { return aeron_counter_get(image->rcv_hwm_position.value_addr) == (int64_t)sizeof(frame); }));
+
+    EXPECT_EQ(memcmp(term_buffer, frame, sizeof(frame)), 0);
+}
+
+TEST_F(DriverReceiverTest, shouldFallBackAndClearTargetForOutOfOrderDatagram)
+{
+    aeron_publication_image_t *image = addZeroCopyImage();
+    ASSERT_NE(image, (aeron_publication_image_t *)NULL);
+
+    uint8_t *term_buffer = image->mapped_raw_log.term_buffers[0].addr;
+    uint8_t frame[AERON_DATA_HEADER_LENGTH + 256];
+    const int32_t term_offset = 1024;
+
+    fillDataFrame(frame, term_offset, 256, 0x22);
+    sendBytes(frame, sizeof(frame));
+    const int64_t expected_hwm_position = term_offset + (int64_t)sizeof(frame);
+    ASSERT_TRUE(receiveUntil(
+        [&]() { return aeron_counter_get(image->rcv_hwm_position.value_addr) == expected_hwm_position; }));
+
+    /* it first landed after the header at the old high water mark, which must be left clean for the gap */
+    EXPECT_TRUE(isZero(term_buffer, term_offset));
+    EXPECT_EQ(memcmp(term_buffer + term_offset, frame, sizeof(frame)), 0);
+}
+
+TEST_F(DriverReceiverTest, shouldNotLandDatagramBeyondReceiverWindow)
+{
+    aeron_publication_image_t *image = addZeroCopyImage();
+    ASSERT_NE(image, (aeron_publication_image_t *)NULL);
+
+    uint8_t *term_buffer = image->mapped_raw_log.term_buffers[0].addr;
+    uint8_t frame[AERON_DATA_HEADER_LENGTH + 256];
+    const int64_t over_runs = aeron_counter_get(image->flow_control_over_runs_counter);
+
+    image->last_sm_position_window_limit = AERON_DATA_HEADER_LENGTH + 64;
+
+    fillDataFrame(frame, 0, 256, 0x33);
+    sendBytes(frame, sizeof(frame));
+    ASSERT_TRUE(receiveUntil(
+        [&]() { return aeron_counter_get(image->flow_control_over_runs_counter) > over_runs; }));
+
+    EXPECT_EQ(aeron_counter_get(image->rcv_hwm_position.value_addr), 0);
+    EXPECT_TRUE(isZero(term_buffer, sizeof(frame)));
+}
+
+static bool always_measure_rtt(void *state, int64_t now_ns)
+{
+    return true;
+}
+
+TEST_F(DriverReceiverTest, shouldInitiateRttmWhenStrategyHasNoRttmSentHandler)
+{
+    addSubscription();
+    aeron_receive_channel_endpoint_t *endpoint = aeron_driver_conductor_find_receive_channel_endpoint(
+        &m_conductor.m_conductor, CHANNEL_1);
+    ASSERT_NE(endpoint, (aeron_receive_channel_endpoint_t *)NULL);
+
+    createPublicationImage(endpoint, STREAM_ID_1, 0);
+    aeron_publication_image_t *image = aeron_driver_conductor_find_publication_image(
+        &m_conductor.m_conductor, endpoint, STREAM_ID_1);
+    ASSERT_NE(image, (aeron_publication_image_t *)NULL);
+
+    image->congestion_control->should_measure_rtt = always_measure_rtt;
+    image->congestion_control->on_rttm_sent = NULL;
+
+    EXPECT_EQ(aeron_publication_image_initiate_rttm(image, 0), 1);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "aeron_test_skip.h"
+
+extern "C"
+{
+#include "util/aeron_fileutil.h"
+#include "util/aeron_error.h"
+}
+
+#define TERM_LENGTH (64 * 1024)
+#define PAGE_SIZE (4 * 1024)
+#define FILE_LENGTH (4 * 1024 * 1024)
+
+class FileUtilTest : public testing::Test
+{
+public:
+    FileUtilTest()
+    {
+        char dir[] = "/tmp/aeron-fileutil-XXXXXX";
+
+        m_dir = mkdtemp(dir);
+        m_mapped_file.addr = NULL;
+        m_mapped_file.length = FILE_LENGTH;
+    }
+
+    virtual ~FileUtilTest()
+    {
+        if (NULL != m_mapped_file.addr)
+        {
+            aeron_unmap(&m_mapped_file);
+        }
+
+        aeron_delete_directory(m_dir.c_str());
+    }
+
+protected:
+    std::string m_dir;
+    aeron_mapped_file_t m_mapped_file;
+};
+
+TEST_F(FileUtilTest, shouldReportDirectoryNotOnHugetlbfs)
+{
+    EXPECT_EQ(aeron_hugetlbfs_page_size(m_dir.c_str()), 0);
+}
+
+#if defined(__linux__)
+
+TEST_F(FileUtilTest, shouldFailHugetlbfsPageSizeOfMissingPath)
+{
+    EXPECT_EQ(aeron_hugetlbfs_page_size((m_dir + "/missing").c_str()), -1);
+    EXPECT_EQ(aeron_errcode(), ENOENT);
+}
+
+TEST_F(FileUtilTest, shouldReportHugePageLengthWithinMapping)
+{
+    ASSERT_EQ(aeron_map_new_file(&m_mapped_file, (m_dir + "/file").c_str(), false), 0) << aeron_errmsg();
+
+    if (aeron_mapped_file_advise_huge_pages(&m_mapped_file) < 0)
+    {
+        AERON_TEST_SKIP("no transparent huge pages: " << aeron_errmsg());
+    }
+
+    aeron_mapped_file_touch_pages(&m_mapped_file, PAGE_SIZE);
+
+    const int64_t huge_page_length = aeron_mapped_file_huge_page_length(&m_mapped_file);
+    ASSERT_GE(huge_page_length, 0) << aeron_errmsg();
+    EXPECT_LE(huge_page_length, (int64_t)FILE_LENGTH);
+
+    const uint8_t *addr = (const uint8_t *)m_mapped_file.addr;
+    for (size_t i = 0; i < FILE_LENGTH; i += PAGE_SIZE)
+    {
+        ASSERT_EQ(addr[i], 0u);
+    }
+}
+
+TEST_F(FileUtilTest, shouldFailHugePageLengthOfUnmappedRange)
+{
+    aeron_mapped_file_t unmapped;
+
+    ASSERT_EQ(aeron_map_new_file(&m_mapped_file, (m_dir + "/file").c_str(), false), 0) << aeron_errmsg();
+    unmapped.addr = m_mapped_file.addr;
+    unmapped.length = m_mapped_file.length;
+
+    ASSERT_EQ(aeron_unmap(&unmapped), 0);
+    m_mapped_file.addr = NULL;
+
+    EXPECT_EQ(aeron_mapped_file_huge_page_length(&unmapped), -1);
+    EXPECT_EQ(aeron_errcode(), EINVAL);
+}
+
+TEST_F(FileUtilTest, shouldMapRawLogAdvisedForHugePages)
+{
+    aeron_mapped_raw_log_t raw_log;
+    const std::string path = m_dir + "/raw.logbuffer";
+
+    ASSERT_EQ(aeron_map_raw_log(&raw_log, path.c_str(), false, true, TERM_LENGTH, PAGE_SIZE, -1), 0) << aeron_errmsg();
+
+    EXPECT_EQ(raw_log.term_length, (size_t)TERM_LENGTH);
+    for (size_t i = 0; i < AERON_LOGBUFFER_PARTITION_COUNT; i++)
+    {
+        EXPECT_EQ(raw_log.term_buffers[i].length, (size_t)TERM_LENGTH);
+        EXPECT_EQ(raw_log.term_buffers[i].addr[0], 0u);
+        EXPECT_EQ(raw_log.term_buffers[i].addr[TERM_LENGTH - 1], 0u);
+    }
+
+    EXPECT_GE(aeron_mapped_file_huge_page_length(&raw_log.mapped_file), 0) << aeron_errmsg();
+    EXPECT_EQ(aeron_map_raw_log_close(&raw_log, path.c_str()), 0);
+    EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+TEST_F(FileUtilTest, shouldNotLeaveRawLogBehindWhenNumaBindFails)
+{
+    aeron_mapped_raw_log_t raw_log;
+    const std::string path = m_dir + "/raw.logbuffer";
+
+    EXPECT_EQ(aeron_map_raw_log(&raw_log, path.c_str(), false, false, TERM_LENGTH, PAGE_SIZE, INT32_MAX), -1);
+    EXPECT_EQ(aeron_errcode(), EINVAL);
+    EXPECT_EQ(raw_log.mapped_file.addr, (void *)NULL);
+    EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+#endif
@@ -0,0 +1,218 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "aeron_flow_control.h"
+#include "aeron_driver_context.h"
+#include "protocol/aeron_udp_protocol.h"
+#include "concurrent/aeron_logbuffer_descriptor.h"
+#include "util/aeron_error.h"
+
+int aeron_default_multicast_flow_control_strategy_supplier(
+    aeron_flow_control_strategy_t **strategy,
+    int32_t channel_length,
+    const char *channel,
+    int32_t stream_id,
+    int64_t registration_id,
+    int32_t initial_term_id,
+    size_t term_buffer_capacity,
+    aeron_driver_context_t *context);
+
+int64_t aeron_config_parse_int64(const char *name, const char *str, int64_t def, int64_t min, int64_t max);
+}
+
+#define TERM_BUFFER_LENGTH (64 * 1024)
+#define POSITION_BITS_TO_SHIFT (16)
+#define INITIAL_TERM_ID (7)
+#define WINDOW_LENGTH (4096)
+#define RECEIVER_TIMEOUT_NS (2 * 1000 * 1000 * 1000L)
+
+class FlowControlTest : public testing::Test
+{
+public:
+    FlowControlTest() : m_strategy(NULL)
+    {
+        memset(&m_context, 0, sizeof(m_context));
+        m_context.flow_control_receiver_timeout_ns = RECEIVER_TIMEOUT_NS;
+        m_context.flow_control_group_tag = -1;
+        memset(&m_addr, 0, sizeof(m_addr));
+    }
+
+    virtual ~FlowControlTest()
+    {
+        if (NULL != m_strategy)
+        {
+            m_strategy->fini(m_strategy);
+        }
+    }
+
+    int create(const std::string& channel)
+    {
+        return aeron_default_multicast_flow_control_strategy_supplier(
+            &m_strategy,
+            (int32_t)channel.length(),
+            channel.c_str(),
+            1001,
+            1,
+            INITIAL_TERM_ID,
+            TERM_BUFFER_LENGTH,
+            &m_context);
+    }
+
+    int64_t on_sm(int64_t receiver_id, int64_t position, int64_t snd_lmt, int64_t now_ns, const int64_t *group_tag = NULL)
+    {
+        uint8_t buffer[sizeof(aeron_status_message_header_t) + sizeof(aeron_status_message_optional_header_t)];
+        aeron_status_message_header_t *sm = (aeron_status_message_header_t *)buffer;
+        size_t length = sizeof(aeron_status_message_header_t);
+
+        memset(buffer, 0, sizeof(buffer));
+        sm->consumption_term_id = aeron_logbuffer_compute_term_id_from_position(
+            position, POSITION_BITS_TO_SHIFT, INITIAL_TERM_ID);
+        sm->consumption_term_offset = (int32_t)(position & (TERM_BUFFER_LENGTH - 1));
+        sm->receiver_window = WINDOW_LENGTH;
+        sm->receiver_id = receiver_id;
+
+        if (NULL != group_tag)
+        {
+            aeron_status_message_optional_header_t *optional_header =
+                (aeron_status_message_optional_header_t *)(buffer + sizeof(aeron_status_message_header_t));
+            optional_header->group_tag = *group_tag;
+            length += sizeof(aeron_status_message_optional_header_t);
+        }
+
+        return m_strategy->on_status_message(
+            m_strategy->state, buffer, length, &m_addr, snd_lmt, INITIAL_TERM_ID, POSITION_BITS_TO_SHIFT, now_ns);
+    }
+
+protected:
+    aeron_driver_context_t m_context;
+    aeron_flow_control_strategy_t *m_strategy;
+    struct sockaddr_storage m_addr;
+};
+
+TEST_F(FlowControlTest, shouldParseOptions)
+{
+    aeron_flow_control_options_t options;
+    const std::string value = "tagged,g:-17,t:250ms";
+
+    ASSERT_EQ(aeron_flow_control_parse_options(value.length(), value.c_str(), &options), 0) << aeron_errmsg();
+    EXPECT_EQ(std::string(options.strategy_name, options.strategy_name_length), "tagged");
+    EXPECT_TRUE(options.has_group_tag);
+    EXPECT_EQ(options.group_tag, -17);
+    EXPECT_TRUE(options.has_receiver_timeout);
+    EXPECT_EQ(options.receiver_timeout_ns, 250 * 1000 * 1000L);
+}
+
+TEST_F(FlowControlTest, shouldRejectInvalidOptions)
+{
+    aeron_flow_control_options_t options;
+    const std::string unknown = "min,x:1";
+    const std::string bad_timeout = "min,t:abc";
+
+    EXPECT_EQ(aeron_flow_control_parse_options(unknown.length(), unknown.c_str(), &options), -1);
+    EXPECT_EQ(aeron_flow_control_parse_options(bad_timeout.length(), bad_timeout.c_str(), &options), -1);
+    EXPECT_EQ(create("aeron:udp?endpoint=224.20.30.39:24326|fc=mi"), -1);
+}
+
+TEST_F(FlowControlTest, shouldUseMaxPositionWithoutFlowControlParameter)
+{
+    ASSERT_EQ(create("aeron:udp?endpoint=224.20.30.39:24326"), 0) << aeron_errmsg();
+
+    EXPECT_EQ(on_sm(1, 1000, 0, 0), 1000 + WINDOW_LENGTH);
+    EXPECT_EQ(on_sm(2, 500, 1000 + WINDOW_LENGTH, 0), 1000 + WINDOW_LENGTH);
+}
+
+TEST_F(FlowControlTest, shouldUseMinPositionOfReceivers)
+{
+    ASSERT_EQ(create("aeron:udp?endpoint=224.20.30.39:24326|fc=min"), 0) << aeron_errmsg();
+
+    EXPECT_EQ(on_sm(1, 1000, 0, 0), 1000 + WINDOW_LENGTH);
+    EXPECT_EQ(on_sm(2, 500, 1000 + WINDOW_LENGTH, 0), 500 + WINDOW_LENGTH);
+    EXPECT_EQ(on_sm(2, 2000, 500 + WINDOW_LENGTH, 0), 1000 + WINDOW_LENGTH);
+    EXPECT_EQ(on_sm(1, 3000, 1000 + WINDOW_LENGTH, 0), 2000 + WINDOW_LENGTH);
+}
+
+TEST_F(FlowControlTest, shouldRemoveTimedOutReceivers)
+{
+    ASSERT_EQ(create("aeron:udp?endpoint=224.20.30.39:24326|fc=min,t:1s"), 0) << aeron_errmsg();
+
+    const int64_t timeout_ns = 1000 * 1000 * 1000L;
+
+    on_sm(1, 1000, 0, 0);
+    on_sm(2, 5000, 0, timeout_ns / 2);
+
+    EXPECT_EQ(m_strategy->on_idle(m_strategy->state, timeout_ns, 0, 0, false), 1000 + WINDOW_LENGTH);
+    EXPECT_EQ(m_strategy->on_idle(m_strategy->state, timeout_ns + 1, 0, 0, false), 5000 + WINDOW_LENGTH);
+    EXPECT_EQ(m_strategy->on_idle(m_strategy->state, 2 * timeout_ns, 42, 0, false), 42);
+}
+
+TEST_F(FlowControlTest, shouldLingerUntilAllReceiversReachSenderPosition)
+{
+    ASSERT_EQ(create("aeron:udp?endpoint=224.20.30.39:24326|fc=min"), 0) << aeron_errmsg();
+
+    on_sm(1, 1000, 0, 0);
+    on_sm(2, 2000, 0, 0);
+
+    m_strategy->on_idle(m_strategy->state, 0, 0, 2000, true);
+    EXPECT_TRUE(m_strategy->should_linger(m_strategy->state, 0));
+
+    on_sm(1, 2000, 0, 0);
+    m_strategy->on_idle(m_strategy->state, 0, 0, 2000, true);
+    EXPECT_FALSE(m_strategy->should_linger(m_strategy->state, 0));
+}
+
+TEST_F(FlowControlTest, shouldOnlyTrackReceiversWithMatchingGroupTag)
+{
+    ASSERT_EQ(create("aeron:udp?endpoint=224.20.30.39:24326|fc=tagged,g:100"), 0) << aeron_errmsg();
+
+    const int64_t tag = 100;
+    const int64_t other_tag = 200;
+
+    EXPECT_EQ(on_sm(1, 1000, 0, 0), 1000 + WINDOW_LENGTH);
+    EXPECT_EQ(on_sm(2, 3000, 1000 + WINDOW_LENGTH, 0, &other_tag), 3000 + WINDOW_LENGTH);
+    EXPECT_EQ(on_sm(3, 2000, 3000 + WINDOW_LENGTH, 0, &tag), 2000 + WINDOW_LENGTH);
+    EXPECT_EQ(on_sm(1, 500, 2000 + WINDOW_LENGTH, 0), 2000 + WINDOW_LENGTH);
+    EXPECT_EQ(m_strategy->on_idle(m_strategy->state, 0, 0, 0, false), 2000 + WINDOW_LENGTH);
+}
+
+TEST_F(FlowControlTest, shouldUseContextGroupTagWhenNotInChannel)
+{
+    m_context.flow_control_group_tag = 7;
+    ASSERT_EQ(create("aeron:udp?endpoint=224.20.30.39:24326|fc=tagged"), 0) << aeron_errmsg();
+
+    const int64_t tag = 7;
+
+    EXPECT_EQ(on_sm(1, 4000, 0, 0), 4000 + WINDOW_LENGTH);
+    EXPECT_EQ(on_sm(2, 1000, 4000 + WINDOW_LENGTH, 0, &tag), 1000 + WINDOW_LENGTH);
+}
+
+TEST_F(FlowControlTest, shouldParseSignedGroupTagFromConfig)
+{
+    const char *name = AERON_FLOW_CONTROL_GROUP_TAG_ENV_VAR;
+
+    EXPECT_EQ(aeron_config_parse_int64(name, NULL, -1, INT64_MIN, INT64_MAX), -1);
+    EXPECT_EQ(aeron_config_parse_int64(name, "-42", -1, INT64_MIN, INT64_MAX), -42);
+    EXPECT_EQ(aeron_config_parse_int64(name, "0x10", -1, INT64_MIN, INT64_MAX), 16);
+    EXPECT_EQ(aeron_config_parse_int64(name, "9223372036854775807", -1, INT64_MIN, INT64_MAX), INT64_MAX);
+    EXPECT_EQ(aeron_config_parse_int64(name, "9223372036854775808", -1, INT64_MIN, INT64_MAX), -1);
+    EXPECT_EQ(aeron_config_parse_int64(name, "7tag", -1, INT64_MIN, INT64_MAX), -1);
+    EXPECT_EQ(aeron_config_parse_int64(name, "-5", -1, 0, 100), 0);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "aeron_agent.h"
+#include "aeron_driver_context.h"
+#include "aeron_alloc.h"
+#include "util/aeron_error.h"
+}
+
+#define MAX_SPINS (2)
+#define MAX_YIELDS (3)
+#define MIN_PARK_PERIOD_NS (1)
+#define MAX_PARK_PERIOD_NS (4)
+
+class IdleStrategyTest : public testing::Test
+{
+public:
+    IdleStrategyTest() : m_state(NULL)
+    {
+        memset(&m_context, 0, sizeof(m_context));
+        m_context.idle_strategy_max_spins = MAX_SPINS;
+        m_context.idle_strategy_max_yields = MAX_YIELDS;
+        m_context.idle_strategy_min_park_period_ns = MIN_PARK_PERIOD_NS;
+        m_context.idle_strategy_max_park_period_ns = MAX_PARK_PERIOD_NS;
+    }
+
+    virtual ~IdleStrategyTest()
+    {
+        aeron_free(m_state);
+    }
+
+    aeron_idle_strategy_func_t load(const char *name)
+    {
+        return aeron_idle_strategy_load(name, &m_state, &m_context);
+    }
+
+protected:
+    aeron_driver_context_t m_context;
+    void *m_state;
+};
+
+TEST_F(IdleStrategyTest, shouldBackOffFromSpinningToYieldingToParking)
+{
+    aeron_idle_strategy_func_t idle = load("backoff");
+    ASSERT_TRUE(aeron_idle_strategy_backoff_idle == idle) << aeron_errmsg();
+
+    aeron_idle_strategy_backoff_state_t *backoff = (aeron_idle_strategy_backoff_state_t *)m_state;
+    EXPECT_EQ(backoff->state, AERON_IDLE_STRATEGY_BACKOFF_STATE_NOT_IDLE);
+
+    for (int i = 0; i < MAX_SPINS; i++)
+    {
+        idle(m_state, 0);
+        EXPECT_EQ(backoff->state, AERON_IDLE_STRATEGY_BACKOFF_STATE_SPINNING);
+    }
+
+    idle(m_state, 0);
+    EXPECT_EQ(backoff->state, AERON_IDLE_STRATEGY_BACKOFF_STATE_YIELDING);
+
+    for (int i = 0; i < MAX_YIELDS; i++)
+    {
+        idle(m_state, 0);
+        EXPECT_EQ(backoff->state, AERON_IDLE_STRATEGY_BACKOFF_STATE_YIELDING);
+    }
+
+    idle(m_state, 0);
+    EXPECT_EQ(backoff->state, AERON_IDLE_STRATEGY_BACKOFF_STATE_PARKING);
+    EXPECT_EQ(backoff->park_period_ns, (uint64_t)MIN_PARK_PERIOD_NS);
+
+    idle(m_state, 0);
+    EXPECT_EQ(backoff->park_period_ns, (uint64_t)(2 * MIN_PARK_PERIOD_NS));
+
+    for (int i = 0; i < 8; i++)
+    {
+        idle(m_state, 0);
+    }
+    EXPECT_EQ(backoff->park_period_ns, (uint64_t)MAX_PARK_PERIOD_NS);
+}
+
+TEST_F(IdleStrategyTest, shouldResetBackOffWhenWorkIsDone)
+{
+    aeron_idle_strategy_func_t idle = load("backoff");
+    ASSERT_TRUE(aeron_idle_strategy_backoff_idle == idle) << aeron_errmsg();
+
+    aeron_idle_strategy_backoff_state_t *backoff = (aeron_idle_strategy_backoff_state_t *)m_state;
+
+    for (int i = 0; i < 20; i++)
+    {
+        idle(m_state, 0);
+    }
+    EXPECT_EQ(backoff->state, AERON_IDLE_STRATEGY_BACKOFF_STATE_PARKING);
+
+    idle(m_state, 1);
+    EXPECT_EQ(backoff->state, AERON_IDLE_STRATEGY_BACKOFF_STATE_NOT_IDLE);
+    EXPECT_EQ(backoff->spins, 0u);
+    EXPECT_EQ(backoff->yields, 0u);
+    EXPECT_EQ(backoff->park_period_ns, (uint64_t)MIN_PARK_PERIOD_NS);
+}
+
+TEST_F(IdleStrategyTest, shouldFollowStatusIndicatorWhenControllable)
+{
+    aeron_idle_strategy_func_t idle = load("controllable");
+    ASSERT_TRUE(aeron_idle_strategy_controllable_idle == idle) << aeron_errmsg();
+
+    aeron_idle_strategy_controllable_state_t *controllable = (aeron_idle_strategy_controllable_state_t *)m_state;
+
+    idle(m_state, 0);
+    EXPECT_EQ(controllable->backoff.state, AERON_IDLE_STRATEGY_BACKOFF_STATE_SPINNING);
+
+    volatile int64_t status = AERON_IDLE_STRATEGY_CONTROLLABLE_NOOP;
+    m_context.controllable_idle_strategy_status_indicator = &status;
+
+    for (int i = 0; i < 20; i++)
+    {
+        idle(m_state, 0);
+    }
+    EXPECT_EQ(controllable->backoff.state, AERON_IDLE_STRATEGY_BACKOFF_STATE_SPINNING);
+
+    status = AERON_IDLE_STRATEGY_CONTROLLABLE_NOT_CONTROLLED;
+    for (int i = 0; i < 20; i++)
+    {
+        idle(m_state, 0);
+    }
+    EXPECT_EQ(controllable->backoff.state, AERON_IDLE_STRATEGY_BACKOFF_STATE_PARKING);
+}
+
+TEST_F(IdleStrategyTest, shouldFailToLoadUnknownStrategy)
+{
+    EXPECT_TRUE(NULL == load("not-an-idle-strategy"));
+}
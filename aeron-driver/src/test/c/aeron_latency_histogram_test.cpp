@@ -0,0 +1,120 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "aeron_latency_histogram.h"
+#include "aeron_position.h"
+}
+
+#define NUM_COUNTERS (16)
+#define CHANNEL "aeron:udp?endpoint=localhost:40123"
+
+static int64_t null_epoch_clock()
+{
+    return 0;
+}
+
+class LatencyHistogramTest : public testing::Test
+{
+public:
+    LatencyHistogramTest()
+    {
+        m_metadata.fill(0);
+        m_values.fill(0);
+    }
+
+    ~LatencyHistogramTest()
+    {
+        aeron_counters_manager_close(&m_manager);
+    }
+
+    virtual void SetUp()
+    {
+        ASSERT_EQ(aeron_counters_manager_init(
+            &m_manager, m_metadata.data(), m_metadata.size(), m_values.data(), m_values.size(), null_epoch_clock, 0), 0);
+    }
+
+    static void on_counter(
+        int32_t id,
+        int32_t type_id,
+        const uint8_t *key,
+        size_t key_length,
+        const uint8_t *label,
+        size_t label_length,
+        void *clientd)
+    {
+        LatencyHistogramTest *test = (LatencyHistogramTest *)clientd;
+
+        EXPECT_EQ(type_id, AERON_COUNTER_RECEIVER_HISTOGRAM_TYPE_ID);
+        test->m_labels.push_back(std::string((const char *)label, label_length));
+    }
+
+protected:
+    aeron_counters_manager_t m_manager;
+    std::array<std::uint8_t, NUM_COUNTERS * AERON_COUNTERS_MANAGER_METADATA_LENGTH> m_metadata;
+    std::array<std::uint8_t, NUM_COUNTERS * AERON_COUNTERS_MANAGER_VALUE_LENGTH> m_values;
+    std::vector<std::string> m_labels;
+};
+
+TEST_F(LatencyHistogramTest, shouldBucketByPowersOfFourMicroseconds)
+{
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(-1), 0u);
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(0), 0u);
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(999), 0u);
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(1000), 1u);
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(3999), 1u);
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(4000), 2u);
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(1023999), 5u);
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(4095999), 6u);
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(4096000), 7u);
+    EXPECT_EQ(aeron_latency_histogram_bucket_index(INT64_MAX), 7u);
+}
+
+TEST_F(LatencyHistogramTest, shouldCountIntoBucketCountersAndFreeThemOnClose)
+{
+    aeron_latency_histogram_t histogram;
+
+    ASSERT_EQ(aeron_latency_histogram_init(
+        &histogram, &m_manager, AERON_COUNTER_RECEIVER_LATENCY_NAME, 7, 1, 2, sizeof(CHANNEL) - 1, CHANNEL), 0);
+
+    aeron_latency_histogram_record(&histogram, 500);
+    aeron_latency_histogram_record(&histogram, 2000);
+    aeron_latency_histogram_record(&histogram, 3000);
+    aeron_latency_histogram_record(&histogram, 10000000);
+
+    EXPECT_EQ(*histogram.buckets[0], 1);
+    EXPECT_EQ(*histogram.buckets[1], 2);
+    EXPECT_EQ(*histogram.buckets[2], 0);
+    EXPECT_EQ(*histogram.buckets[AERON_LATENCY_HISTOGRAM_BUCKET_COUNT - 1], 1);
+
+    aeron_counters_reader_foreach(m_metadata.data(), m_metadata.size(), on_counter, this);
+    ASSERT_EQ(m_labels.size(), (size_t)AERON_LATENCY_HISTOGRAM_BUCKET_COUNT);
+    EXPECT_EQ(m_labels[0], "rcv-latency: 7 1 2 " CHANNEL " <1us");
+    EXPECT_EQ(m_labels[AERON_LATENCY_HISTOGRAM_BUCKET_COUNT - 1], "rcv-latency: 7 1 2 " CHANNEL " >=4ms");
+
+    aeron_latency_histogram_close(&histogram, &m_manager);
+
+    m_labels.clear();
+    aeron_counters_reader_foreach(m_metadata.data(), m_metadata.size(), on_counter, this);
+    EXPECT_EQ(m_labels.size(), 0u);
+}
@@ -266,4 +266,36 @@ TEST_F(ParseUtilTest, shouldSplitInterface)
     EXPECT_EQ(std::string(split_interface.port), "1234");
     EXPECT_EQ(std::string(split_interface.prefix), "");
     EXPECT_EQ(split_interface.ip_version_hint, 6);
-}
\ No newline at end of file
+}
+
+TEST_F(ParseUtilTest, shouldParseCpuSet)
+{
+    aeron_cpu_set_t cpu_set;
+
+    EXPECT_EQ(aeron_parse_cpu_set("", &cpu_set), 0);
+    EXPECT_TRUE(aeron_cpu_set_is_empty(&cpu_set));
+
+    EXPECT_EQ(aeron_parse_cpu_set("0-2,8,63-64", &cpu_set), 0);
+    EXPECT_TRUE(aeron_cpu_set_is_set(&cpu_set, 0));
+    EXPECT_TRUE(aeron_cpu_set_is_set(&cpu_set, 1));
+    EXPECT_TRUE(aeron_cpu_set_is_set(&cpu_set, 2));
+    EXPECT_FALSE(aeron_cpu_set_is_set(&cpu_set, 3));
+    EXPECT_TRUE(aeron_cpu_set_is_set(&cpu_set, 8));
+    EXPECT_FALSE(aeron_cpu_set_is_set(&cpu_set, 62));
+    EXPECT_TRUE(aeron_cpu_set_is_set(&cpu_set, 63));
+    EXPECT_TRUE(aeron_cpu_set_is_set(&cpu_set, 64));
+    EXPECT_FALSE(aeron_cpu_set_is_set(&cpu_set, 65));
+}
+
+TEST_F(ParseUtilTest, shouldNotParseInvalidCpuSet)
+{
+    aeron_cpu_set_t cpu_set;
+
+    EXPECT_EQ(aeron_parse_cpu_set(nullptr, &cpu_set), -1);
+    EXPECT_EQ(aeron_parse_cpu_set("rubbish", &cpu_set), -1);
+    EXPECT_EQ(aeron_parse_cpu_set("-1", &cpu_set), -1);
+    EXPECT_EQ(aeron_parse_cpu_set("3-1", &cpu_set), -1);
+    EXPECT_EQ(aeron_parse_cpu_set("1-", &cpu_set), -1);
+    EXPECT_EQ(aeron_parse_cpu_set("1;2", &cpu_set), -1);
+    EXPECT_EQ(aeron_parse_cpu_set("1024", &cpu_set), -1);
+}
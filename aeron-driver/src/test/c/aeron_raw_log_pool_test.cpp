@@ -0,0 +1,128 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "aeron_raw_log_pool.h"
+#include "util/aeron_error.h"
+}
+
+#define TERM_LENGTH (64 * 1024)
+#define OTHER_TERM_LENGTH (128 * 1024)
+#define PAGE_SIZE (4 * 1024)
+#define DEPTH (2)
+#define POLL_ATTEMPTS (5000)
+
+class RawLogPoolTest : public testing::Test
+{
+public:
+    RawLogPoolTest() : m_pool(NULL)
+    {
+        char dir[] = "/tmp/aeron-raw-log-pool-XXXXXX";
+
+        m_dir = mkdtemp(dir);
+        mkdir((m_dir + "/" AERON_RAW_LOG_POOL_DIR).c_str(), S_IRWXU);
+    }
+
+    virtual ~RawLogPoolTest()
+    {
+        aeron_raw_log_pool_close(m_pool);
+        aeron_delete_directory(m_dir.c_str());
+    }
+
+    int create(size_t depth)
+    {
+        const uint64_t term_lengths[] = { TERM_LENGTH, TERM_LENGTH };
+        const int32_t numa_nodes[] = { -1, -1 };
+
+        return aeron_raw_log_pool_init(&m_pool, m_dir.c_str(), term_lengths, numa_nodes, 2, depth, PAGE_SIZE, false);
+    }
+
+    void await_available(uint64_t term_length, size_t count)
+    {
+        for (int i = 0; i < POLL_ATTEMPTS && aeron_raw_log_pool_available(m_pool, term_length, -1) < count; i++)
+        {
+            aeron_micro_sleep(1000);
+        }
+    }
+
+protected:
+    std::string m_dir;
+    aeron_raw_log_pool_t *m_pool;
+};
+
+TEST_F(RawLogPoolTest, shouldFillToDepthAndMoveTakenLogToPath)
+{
+    ASSERT_EQ(create(DEPTH), 0) << aeron_errmsg();
+    EXPECT_EQ(m_pool->term_length_pools_length, 1u);
+
+    await_available(TERM_LENGTH, DEPTH);
+    ASSERT_EQ(aeron_raw_log_pool_available(m_pool, TERM_LENGTH, -1), (size_t)DEPTH);
+
+    const std::string path = m_dir + "/taken.logbuffer";
+    aeron_mapped_raw_log_t mapped_raw_log;
+
+    ASSERT_TRUE(aeron_raw_log_pool_take(m_pool, &mapped_raw_log, path.c_str(), false, TERM_LENGTH, -1));
+    EXPECT_EQ(mapped_raw_log.term_length, (size_t)TERM_LENGTH);
+    EXPECT_EQ(mapped_raw_log.mapped_file.length, aeron_logbuffer_compute_log_length(TERM_LENGTH, PAGE_SIZE));
+    EXPECT_EQ(access(path.c_str(), F_OK), 0);
+
+    mapped_raw_log.log_meta_data.addr[0] = 1;
+    EXPECT_EQ(aeron_map_raw_log_close(&mapped_raw_log, path.c_str()), 0);
+
+    await_available(TERM_LENGTH, DEPTH);
+    EXPECT_EQ(aeron_raw_log_pool_available(m_pool, TERM_LENGTH, -1), (size_t)DEPTH);
+}
+
+TEST_F(RawLogPoolTest, shouldNotTakeSparseOrUnpooledTermLength)
+{
+    ASSERT_EQ(create(DEPTH), 0) << aeron_errmsg();
+    await_available(TERM_LENGTH, DEPTH);
+
+    const std::string path = m_dir + "/taken.logbuffer";
+    aeron_mapped_raw_log_t mapped_raw_log;
+
+    EXPECT_FALSE(aeron_raw_log_pool_take(m_pool, &mapped_raw_log, path.c_str(), true, TERM_LENGTH, -1));
+    EXPECT_FALSE(aeron_raw_log_pool_take(m_pool, &mapped_raw_log, path.c_str(), false, OTHER_TERM_LENGTH, -1));
+    EXPECT_FALSE(aeron_raw_log_pool_take(NULL, &mapped_raw_log, path.c_str(), false, TERM_LENGTH, -1));
+    EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+TEST_F(RawLogPoolTest, shouldKeepSeparateQueuesPerNumaNode)
+{
+    const uint64_t term_lengths[] = { TERM_LENGTH, TERM_LENGTH, TERM_LENGTH };
+    const int32_t numa_nodes[] = { -1, 0, 0 };
+
+    ASSERT_EQ(aeron_raw_log_pool_init(
+        &m_pool, m_dir.c_str(), term_lengths, numa_nodes, 3, DEPTH, PAGE_SIZE, false), 0) << aeron_errmsg();
+    EXPECT_EQ(m_pool->term_length_pools_length, 2u);
+
+    await_available(TERM_LENGTH, DEPTH);
+    ASSERT_EQ(aeron_raw_log_pool_available(m_pool, TERM_LENGTH, -1), (size_t)DEPTH);
+
+    const std::string path = m_dir + "/taken.logbuffer";
+    aeron_mapped_raw_log_t mapped_raw_log;
+
+    EXPECT_FALSE(aeron_raw_log_pool_take(m_pool, &mapped_raw_log, path.c_str(), false, TERM_LENGTH, 1));
+    EXPECT_EQ(aeron_raw_log_pool_available(m_pool, TERM_LENGTH, -1), (size_t)DEPTH);
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+extern "C"
+{
+#include "media/aeron_udp_channel_transport.h"
+#include "concurrent/aeron_term_rebuilder.h"
+#include "util/aeron_error.h"
+}
+
+#if !defined(__linux__)
+struct mmsghdr
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+#endif
+
+#define TERM_LENGTH (16 * 1024 * 1024)
+#define SO_RCVBUF_LENGTH (4 * 1024 * 1024)
+#define BATCH_BYTES (128 * 1024)
+#define EMPTY_POLL_LIMIT (1000)
+#define IO_VECTOR_CAPACITY (32)
+
+static uint64_t cycles()
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Loopback datagrams of one MTU, each a single data frame, received in order into a term buffer either by copying out
+ * of a receive buffer as the rebuilder does or by scattering the payload straight to its place in the term.
+ */
+class ZeroCopyReceive
+{
+public:
+    explicit ZeroCopyReceive(size_t mtu_length) :
+        m_mtu_length(mtu_length),
+        m_batch_length(BATCH_BYTES / mtu_length > 0 ? BATCH_BYTES / mtu_length : 1),
+        m_term(TERM_LENGTH),
+        m_buffer(mtu_length * IO_VECTOR_CAPACITY),
+        m_datagram(mtu_length)
+    {
+        open(&m_sender, &m_sender_addr);
+        open(&m_receiver, &m_receiver_addr);
+
+        aeron_data_header_t *header = (aeron_data_header_t *)m_datagram.data();
+        header->frame_header.frame_length = (int32_t)mtu_length;
+        header->frame_header.version = AERON_FRAME_HEADER_VERSION;
+        header->frame_header.flags = AERON_DATA_HEADER_BEGIN_FLAG | AERON_DATA_HEADER_END_FLAG;
+        header->frame_header.type = AERON_HDR_TYPE_DATA;
+        memset(m_datagram.data() + AERON_DATA_HEADER_LENGTH, 'x', mtu_length - AERON_DATA_HEADER_LENGTH);
+    }
+
+    ~ZeroCopyReceive()
+    {
+        aeron_udp_channel_transport_close(&m_sender);
+        aeron_udp_channel_transport_close(&m_receiver);
+    }
+
+    size_t batchLength() const
+    {
+        return m_batch_length;
+    }
+
+    /* send a batch ahead of the term offset, starting the term again if the batch would not fit */
+    void sendBatch()
+    {
+        if (m_term_offset + (m_batch_length * m_mtu_length) > TERM_LENGTH)
+        {
+            memset(m_term.data(), 0, m_term.size());
+            m_term_offset = 0;
+        }
+
+        aeron_data_header_t *header = (aeron_data_header_t *)m_datagram.data();
+        struct iovec iov;
+        struct msghdr message;
+
+        iov.iov_base = m_datagram.data();
+        iov.iov_len = m_mtu_length;
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_name = &m_receiver_addr;
+        message.msg_namelen = sizeof(struct sockaddr_in);
+        message.msg_control = NULL;
+        message.msg_controllen = 0;
+        message.msg_flags = 0;
+
+        for (size_t i = 0; i < m_batch_length; i++)
+        {
+            header->term_offset = (int32_t)(m_term_offset + (i * m_mtu_length));
+
+            if (aeron_udp_channel_transport_sendmsg(&m_sender, &message) != (int)m_mtu_length)
+            {
+                throw std::runtime_error("could not send: " + std::string(aeron_errmsg()));
+            }
+        }
+    }
+
+    /* batched as the receiver does with its recvmmsg vectors */
+    size_t receiveBatchByCopy()
+    {
+        struct iovec iov[IO_VECTOR_CAPACITY];
+        struct mmsghdr messages[IO_VECTOR_CAPACITY];
+        struct sockaddr_storage addrs[IO_VECTOR_CAPACITY];
+        int64_t bytes_received = 0;
+        size_t received = 0;
+
+        for (int empty_polls = 0; received < m_batch_length && empty_polls < EMPTY_POLL_LIMIT;)
+        {
+            for (size_t i = 0; i < IO_VECTOR_CAPACITY; i++)
+            {
+                iov[i].iov_base = m_buffer.data() + (i * m_mtu_length);
+                iov[i].iov_len = m_mtu_length;
+                messages[i].msg_hdr.msg_iov = &iov[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+                messages[i].msg_hdr.msg_name = &addrs[i];
+                messages[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+                messages[i].msg_hdr.msg_control = NULL;
+                messages[i].msg_hdr.msg_controllen = 0;
+                messages[i].msg_hdr.msg_flags = 0;
+                messages[i].msg_len = 0;
+            }
+
+            int result = aeron_udp_channel_transport_recvmmsg(
+                &m_receiver, messages, IO_VECTOR_CAPACITY, &bytes_received, ZeroCopyReceive::onRecv, this);
+
+            received += result > 0 ? (size_t)result : 0;
+            empty_polls = result > 0 ? 0 : empty_polls + 1;
+        }
+
+        return received;
+    }
+
+    size_t receiveBatchInPlace()
+    {
+        struct iovec iov;
+        struct msghdr message;
+        struct sockaddr_storage addr;
+        size_t received = 0;
+
+        iov.iov_base = m_buffer.data();
+        iov.iov_len = m_mtu_length;
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_name = &addr;
+        message.msg_control = NULL;
+
+        for (int empty_polls = 0; received < m_batch_length && empty_polls < EMPTY_POLL_LIMIT;)
+        {
+            uint8_t *frame = m_term.data() + m_term_offset;
+
+            int result = aeron_udp_channel_transport_recv_split(
+                &m_receiver,
+                &message,
+                AERON_DATA_HEADER_LENGTH,
+                frame + AERON_DATA_HEADER_LENGTH,
+                m_mtu_length - AERON_DATA_HEADER_LENGTH);
+
+            if (result > 0)
+            {
+                aeron_term_rebuilder_insert_header(frame, m_buffer.data());
+                m_term_offset += (size_t)result;
+                received++;
+                empty_polls = 0;
+            }
+            else
+            {
+                empty_polls++;
+            }
+        }
+
+        return received;
+    }
+
+private:
+    static void open(aeron_udp_channel_transport_t *transport, struct sockaddr_storage *addr)
+    {
+        struct sockaddr_in *in4 = (struct sockaddr_in *)addr;
+        socklen_t addr_len = sizeof(struct sockaddr_storage);
+
+        memset(addr, 0, sizeof(struct sockaddr_storage));
+        in4->sin_family = AF_INET;
+        in4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (aeron_udp_channel_transport_init(transport, addr, NULL, 0, 0, SO_RCVBUF_LENGTH, 0) < 0 ||
+            getsockname(transport->fd, (struct sockaddr *)addr, &addr_len) < 0)
+        {
+            throw std::runtime_error("could not open transport: " + std::string(aeron_errmsg()));
+        }
+    }
+
+    static void onRecv(
+        void *clientd,
+        void *transport_clientd,
+        void *destination_clientd,
+        uint8_t *buffer,
+        size_t length,
+        struct sockaddr_storage *addr)
+    {
+        ZeroCopyReceive *receive = (ZeroCopyReceive *)clientd;
+        aeron_data_header_t *header = (aeron_data_header_t *)buffer;
+
+        aeron_term_rebuilder_insert(receive->m_term.data() + header->term_offset, buffer, length);
+        receive->m_term_offset = (size_t)header->term_offset + length;
+    }
+
+    size_t m_mtu_length;
+    size_t m_batch_length;
+    size_t m_term_offset = 0;
+    std::vector<uint8_t> m_term;
+    std::vector<uint8_t> m_buffer;
+    std::vector<uint8_t> m_datagram;
+    aeron_udp_channel_transport_t m_sender;
+    aeron_udp_channel_transport_t m_receiver;
+    struct sockaddr_storage m_sender_addr;
+    struct sockaddr_storage m_receiver_addr;
+};
+
+template<size_t (ZeroCopyReceive::*receive_batch)()>
+static void BM_ReceiveIntoTerm(benchmark::State &state)
+{
+    const size_t mtu_length = (size_t)state.range(0);
+    ZeroCopyReceive receive(mtu_length);
+    uint64_t total_cycles = 0;
+    size_t total_received = 0;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        receive.sendBatch();
+        state.ResumeTiming();
+
+        const uint64_t start = cycles();
+        total_received += (receive.*receive_batch)();
+        total_cycles += cycles() - start;
+    }
+
+    const int64_t bytes = (int64_t)(total_received * mtu_length);
+
+    state.SetBytesProcessed(bytes);
+    if (total_cycles > 0)
+    {
+        state.counters["bytes_per_cycle"] = (double)bytes / (double)total_cycles;
+    }
+    state.counters["dropped"] = (double)((state.iterations() * receive.batchLength()) - total_received);
+}
+
+BENCHMARK_TEMPLATE(BM_ReceiveIntoTerm, &ZeroCopyReceive::receiveBatchByCopy)->Arg(1408)->Arg(8192)->Arg(32768);
+BENCHMARK_TEMPLATE(BM_ReceiveIntoTerm, &ZeroCopyReceive::receiveBatchInPlace)->Arg(1408)->Arg(8192)->Arg(32768);
+
+BENCHMARK_MAIN();
@@ -16,6 +16,8 @@
 
 #include <array>
 #include <functional>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -35,13 +37,16 @@ extern "C"
 #define ALIGNED_FRAME_LENGTH (AERON_ALIGN(MESSAGE_LENGTH, AERON_LOGBUFFER_FRAME_ALIGNMENT))
 
 #define LINGER_TIMEOUT_20MS (20 * 1000 * 1000L)
+#define RATE_INTERVAL_1MS (1000 * 1000L)
 
 class RetransmitHandlerTest : public testing::Test
 {
 public:
     RetransmitHandlerTest() :
         m_time(0),
-        m_invalid_packet_counter(0)
+        m_invalid_packet_counter(0),
+        m_retransmitted_bytes_counter(0),
+        m_retransmit_overflow_counter(0)
     {
     }
 
@@ -57,16 +62,43 @@ public:
         return t->m_resend(term_id, term_offset, length);
     }
 
+    int init(size_t max_retransmits, int64_t rate_limit_bytes)
+    {
+        return aeron_retransmit_handler_init(
+            &m_handler,
+            &m_invalid_packet_counter,
+            &m_retransmitted_bytes_counter,
+            &m_retransmit_overflow_counter,
+            false,
+            LINGER_TIMEOUT_20MS,
+            max_retransmits,
+            rate_limit_bytes,
+            RATE_INTERVAL_1MS);
+    }
+
+    int on_nak(int32_t term_offset, size_t length)
+    {
+        return aeron_retransmit_handler_on_nak(
+            &m_handler, TERM_ID, term_offset, length, TERM_LENGTH, m_time, RetransmitHandlerTest::on_resend, this);
+    }
+
+    int process_timeouts()
+    {
+        return aeron_retransmit_handler_process_timeouts(&m_handler, m_time, RetransmitHandlerTest::on_resend, this);
+    }
+
 protected:
     int64_t m_time;
     int64_t m_invalid_packet_counter;
+    int64_t m_retransmitted_bytes_counter;
+    int64_t m_retransmit_overflow_counter;
     aeron_retransmit_handler_t m_handler;
     std::function<int(int32_t,int32_t,size_t)> m_resend;
 };
 
 TEST_F(RetransmitHandlerTest, shouldImmediateRetransmitOnNak)
 {
-    ASSERT_EQ(aeron_retransmit_handler_init(&m_handler, &m_invalid_packet_counter, LINGER_TIMEOUT_20MS), 0);
+    ASSERT_EQ(init(AERON_RETRANSMIT_HANDLER_DEFAULT_MAX_RETRANSMITS, 0), 0);
 
     const int32_t nak_offset = (ALIGNED_FRAME_LENGTH * 2);
     const size_t nak_length = ALIGNED_FRAME_LENGTH;
@@ -89,7 +121,7 @@ TEST_F(RetransmitHandlerTest, shouldImmediateRetransmitOnNak)
 
 TEST_F(RetransmitHandlerTest, shouldNotRetransmitOnNakWhileInLinger)
 {
-    ASSERT_EQ(aeron_retransmit_handler_init(&m_handler, &m_invalid_packet_counter, LINGER_TIMEOUT_20MS), 0);
+    ASSERT_EQ(init(AERON_RETRANSMIT_HANDLER_DEFAULT_MAX_RETRANSMITS, 0), 0);
 
     const int32_t nak_offset = (ALIGNED_FRAME_LENGTH * 2);
     const size_t nak_length = ALIGNED_FRAME_LENGTH;
@@ -109,7 +141,7 @@ TEST_F(RetransmitHandlerTest, shouldNotRetransmitOnNakWhileInLinger)
     EXPECT_EQ(called, 1u);
 
     m_time = 10 * 1000 * 1000L;
-    EXPECT_EQ(aeron_retransmit_handler_process_timeouts(&m_handler, m_time), 0);
+    EXPECT_EQ(process_timeouts(), 0);
     EXPECT_EQ(aeron_retransmit_handler_on_nak(
         &m_handler, TERM_ID, nak_offset, nak_length, TERM_LENGTH, m_time, RetransmitHandlerTest::on_resend, this), 0);
     EXPECT_EQ(called, 1u);
@@ -117,7 +149,7 @@ TEST_F(RetransmitHandlerTest, shouldNotRetransmitOnNakWhileInLinger)
 
 TEST_F(RetransmitHandlerTest, shouldRetransmitOnNakAfterLinger)
 {
-    ASSERT_EQ(aeron_retransmit_handler_init(&m_handler, &m_invalid_packet_counter, LINGER_TIMEOUT_20MS), 0);
+    ASSERT_EQ(init(AERON_RETRANSMIT_HANDLER_DEFAULT_MAX_RETRANSMITS, 0), 0);
 
     const int32_t nak_offset = (ALIGNED_FRAME_LENGTH * 2);
     const size_t nak_length = ALIGNED_FRAME_LENGTH;
@@ -137,7 +169,7 @@ TEST_F(RetransmitHandlerTest, shouldRetransmitOnNakAfterLinger)
     EXPECT_EQ(called, 1u);
 
     m_time = 30 * 1000 * 1000L;
-    EXPECT_EQ(aeron_retransmit_handler_process_timeouts(&m_handler, m_time), 1);
+    EXPECT_EQ(process_timeouts(), 1);
     EXPECT_EQ(aeron_retransmit_handler_on_nak(
         &m_handler, TERM_ID, nak_offset, nak_length, TERM_LENGTH, m_time, RetransmitHandlerTest::on_resend, this), 0);
     EXPECT_EQ(called, 2u);
@@ -145,7 +177,7 @@ TEST_F(RetransmitHandlerTest, shouldRetransmitOnNakAfterLinger)
 
 TEST_F(RetransmitHandlerTest, shouldRetransmitOnMultipleNaks)
 {
-    ASSERT_EQ(aeron_retransmit_handler_init(&m_handler, &m_invalid_packet_counter, LINGER_TIMEOUT_20MS), 0);
+    ASSERT_EQ(init(AERON_RETRANSMIT_HANDLER_DEFAULT_MAX_RETRANSMITS, 0), 0);
 
     const int32_t nak_offset_1 = (ALIGNED_FRAME_LENGTH * 2);
     const size_t nak_length_1 = ALIGNED_FRAME_LENGTH;
@@ -178,3 +210,113 @@ TEST_F(RetransmitHandlerTest, shouldRetransmitOnMultipleNaks)
         &m_handler, TERM_ID, nak_offset_2, nak_length_2, TERM_LENGTH, m_time, RetransmitHandlerTest::on_resend, this), 0);
     EXPECT_EQ(called, 2u);
 }
+
+TEST_F(RetransmitHandlerTest, shouldOnlyRetransmitUncoveredRangesOfOverlappingNak)
+{
+    ASSERT_EQ(init(AERON_RETRANSMIT_HANDLER_DEFAULT_MAX_RETRANSMITS, 0), 0);
+
+    std::vector<std::pair<int32_t, size_t>> resends;
+    m_resend = [&](int32_t term_id, int32_t term_offset, size_t length)
+    {
+        EXPECT_EQ(term_id, TERM_ID);
+        resends.push_back(std::make_pair(term_offset, length));
+        return (int)length;
+    };
+
+    EXPECT_EQ(on_nak(ALIGNED_FRAME_LENGTH * 2, ALIGNED_FRAME_LENGTH), 0);
+    EXPECT_EQ(on_nak(ALIGNED_FRAME_LENGTH, ALIGNED_FRAME_LENGTH * 3), 0);
+    EXPECT_EQ(on_nak(ALIGNED_FRAME_LENGTH, ALIGNED_FRAME_LENGTH * 3), 0);
+
+    ASSERT_EQ(resends.size(), 3u);
+    EXPECT_EQ(resends[0], std::make_pair((int32_t)(ALIGNED_FRAME_LENGTH * 2), (size_t)ALIGNED_FRAME_LENGTH));
+    EXPECT_EQ(resends[1], std::make_pair((int32_t)ALIGNED_FRAME_LENGTH, (size_t)ALIGNED_FRAME_LENGTH));
+    EXPECT_EQ(resends[2], std::make_pair((int32_t)(ALIGNED_FRAME_LENGTH * 3), (size_t)ALIGNED_FRAME_LENGTH));
+    EXPECT_EQ(m_retransmitted_bytes_counter, (int64_t)(ALIGNED_FRAME_LENGTH * 3));
+}
+
+TEST_F(RetransmitHandlerTest, shouldCountNaksBeyondCapacityAsOverflow)
+{
+    ASSERT_EQ(init(2, 0), 0);
+
+    size_t called = 0;
+    m_resend = [&](int32_t term_id, int32_t term_offset, size_t length)
+    {
+        called++;
+        return (int)length;
+    };
+
+    EXPECT_EQ(on_nak(0, ALIGNED_FRAME_LENGTH), 0);
+    EXPECT_EQ(on_nak(ALIGNED_FRAME_LENGTH * 2, ALIGNED_FRAME_LENGTH), 0);
+    EXPECT_EQ(on_nak(ALIGNED_FRAME_LENGTH * 4, ALIGNED_FRAME_LENGTH), 0);
+    EXPECT_EQ(called, 2u);
+    EXPECT_EQ(m_retransmit_overflow_counter, 1);
+
+    m_time = 30 * 1000 * 1000L;
+    EXPECT_EQ(process_timeouts(), 2);
+    EXPECT_EQ(on_nak(ALIGNED_FRAME_LENGTH * 4, ALIGNED_FRAME_LENGTH), 0);
+    EXPECT_EQ(called, 3u);
+}
+
+TEST_F(RetransmitHandlerTest, shouldDelayRetransmitsOverRateLimitToNextInterval)
+{
+    ASSERT_EQ(init(AERON_RETRANSMIT_HANDLER_DEFAULT_MAX_RETRANSMITS, ALIGNED_FRAME_LENGTH), 0);
+
+    std::vector<std::pair<int32_t, size_t>> resends;
+    m_resend = [&](int32_t term_id, int32_t term_offset, size_t length)
+    {
+        resends.push_back(std::make_pair(term_offset, length));
+        return (int)length;
+    };
+
+    EXPECT_EQ(on_nak(0, ALIGNED_FRAME_LENGTH), 0);
+    EXPECT_EQ(on_nak(ALIGNED_FRAME_LENGTH * 2, ALIGNED_FRAME_LENGTH), 0);
+    EXPECT_EQ(on_nak(ALIGNED_FRAME_LENGTH * 3, ALIGNED_FRAME_LENGTH), 0);
+    ASSERT_EQ(resends.size(), 1u);
+
+    EXPECT_EQ(process_timeouts(), 0);
+    ASSERT_EQ(resends.size(), 1u);
+
+    m_time += RATE_INTERVAL_1MS;
+    EXPECT_EQ(process_timeouts(), 0);
+    ASSERT_EQ(resends.size(), 2u);
+    EXPECT_EQ(resends[1], std::make_pair((int32_t)(ALIGNED_FRAME_LENGTH * 2), (size_t)(ALIGNED_FRAME_LENGTH * 2)));
+    EXPECT_EQ(m_retransmitted_bytes_counter, (int64_t)(ALIGNED_FRAME_LENGTH * 3));
+}
+
+TEST_F(RetransmitHandlerTest, shouldKeepActionsOrderedAcrossTermIdWrap)
+{
+    ASSERT_EQ(init(AERON_RETRANSMIT_HANDLER_DEFAULT_MAX_RETRANSMITS, 0), 0);
+
+    std::vector<std::pair<int32_t, int32_t>> resends;
+    m_resend = [&](int32_t term_id, int32_t term_offset, size_t length)
+    {
+        resends.push_back(std::make_pair(term_id, term_offset));
+        return (int)length;
+    };
+
+    const int32_t frame = ALIGNED_FRAME_LENGTH;
+    auto nak = [&](int32_t term_id, int32_t term_offset, size_t length)
+    {
+        return aeron_retransmit_handler_on_nak(
+            &m_handler, term_id, term_offset, length, TERM_LENGTH, m_time, RetransmitHandlerTest::on_resend, this);
+    };
+
+    EXPECT_EQ(nak(INT32_MIN, 0, frame), 0);
+    EXPECT_EQ(nak(INT32_MAX, frame * 4, frame), 0);
+    EXPECT_EQ(nak(INT32_MAX, 0, frame), 0);
+    EXPECT_EQ(nak(INT32_MAX, 0, frame * 6), 0);
+
+    const std::vector<std::pair<int32_t, int32_t>> expected =
+    {
+        { INT32_MAX, 0 }, { INT32_MAX, frame }, { INT32_MAX, frame * 4 }, { INT32_MAX, frame * 5 }, { INT32_MIN, 0 }
+    };
+
+    ASSERT_EQ(m_handler.actions_length, expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(std::make_pair(m_handler.actions[i].term_id, m_handler.actions[i].term_offset), expected[i]) << i;
+    }
+
+    EXPECT_EQ(resends.size(), expected.size());
+    EXPECT_EQ(m_handler.actions[1].length, (size_t)(frame * 3));
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "aeron_term_cleaner.h"
+}
+
+#define BUFFER_LENGTH (4 * 1024)
+#define TERM_LENGTH (64 * 1024)
+
+class TermCleanerTest : public testing::Test
+{
+public:
+    TermCleanerTest() : m_bytes_cleaned(0), m_lag(0), m_cleaned_position(0)
+    {
+        m_buffer.fill(0xFF);
+    }
+
+    virtual ~TermCleanerTest()
+    {
+        aeron_term_cleaner_close(&m_cleaner);
+    }
+
+    bool is_zero(size_t offset, size_t length)
+    {
+        for (size_t i = offset; i < offset + length; i++)
+        {
+            if (0 != m_buffer[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+protected:
+    aeron_term_cleaner_t m_cleaner;
+    std::array<uint8_t, BUFFER_LENGTH> m_buffer;
+    int64_t m_bytes_cleaned;
+    int64_t m_lag;
+    volatile int64_t m_cleaned_position;
+};
+
+TEST_F(TermCleanerTest, shouldCleanInlineWhenNotOffloaded)
+{
+    ASSERT_EQ(aeron_term_cleaner_init(&m_cleaner, false, false, &m_bytes_cleaned, &m_lag), 0);
+
+    ASSERT_TRUE(aeron_term_cleaner_clean(&m_cleaner, m_buffer.data(), 1024, 1024, &m_cleaned_position));
+
+    EXPECT_TRUE(is_zero(0, 1024));
+    EXPECT_EQ(m_buffer[1024], 0xFF);
+    EXPECT_EQ(m_cleaned_position, 1024);
+    EXPECT_EQ(m_bytes_cleaned, 1024);
+    EXPECT_EQ(aeron_term_cleaner_limit(&m_cleaner, 10 * TERM_LENGTH, &m_cleaned_position, TERM_LENGTH),
+        10 * TERM_LENGTH);
+}
+
+TEST_F(TermCleanerTest, shouldDeferCleaningToAgentAndHoldBackLimitWhenOffloaded)
+{
+    ASSERT_EQ(aeron_term_cleaner_init(&m_cleaner, true, false, &m_bytes_cleaned, &m_lag), 0);
+
+    ASSERT_TRUE(aeron_term_cleaner_clean(&m_cleaner, m_buffer.data(), 1024, 1024, &m_cleaned_position));
+
+    EXPECT_EQ(m_buffer[0], 0xFF);
+    EXPECT_EQ(m_cleaned_position, 0);
+    EXPECT_FALSE(aeron_term_cleaner_has_caught_up(1024, &m_cleaned_position));
+    EXPECT_EQ(aeron_term_cleaner_limit(&m_cleaner, 10 * TERM_LENGTH, &m_cleaned_position, TERM_LENGTH), TERM_LENGTH);
+
+    aeron_term_cleaner_update_lag(&m_cleaner);
+    EXPECT_EQ(m_lag, 1024);
+
+    EXPECT_EQ(aeron_term_cleaner_do_work(&m_cleaner), 1);
+
+    EXPECT_TRUE(is_zero(0, 1024));
+    EXPECT_EQ(m_buffer[1024], 0xFF);
+    EXPECT_TRUE(aeron_term_cleaner_has_caught_up(1024, &m_cleaned_position));
+    EXPECT_EQ(aeron_term_cleaner_limit(&m_cleaner, 10 * TERM_LENGTH, &m_cleaned_position, TERM_LENGTH),
+        1024 + TERM_LENGTH);
+
+    aeron_term_cleaner_update_lag(&m_cleaner);
+    EXPECT_EQ(m_lag, 0);
+}
+
+TEST_F(TermCleanerTest, shouldZeroUnalignedRangeWithNonTemporalStores)
+{
+    aeron_term_cleaner_zero(m_buffer.data() + 3, 1021, true);
+
+    EXPECT_EQ(m_buffer[2], 0xFF);
+    EXPECT_TRUE(is_zero(3, 1021));
+    EXPECT_EQ(m_buffer[1024], 0xFF);
+}
+
+TEST_F(TermCleanerTest, shouldHoldBackLimitFromNonZeroCleanedPositionWhenOffloaded)
+{
+    const int64_t initial_position = (5 * TERM_LENGTH) + 1024;
+
+    ASSERT_EQ(aeron_term_cleaner_init(&m_cleaner, true, false, &m_bytes_cleaned, &m_lag), 0);
+    m_cleaned_position = initial_position;
+
+    EXPECT_EQ(aeron_term_cleaner_limit(&m_cleaner, 10 * TERM_LENGTH, &m_cleaned_position, TERM_LENGTH),
+        initial_position + TERM_LENGTH);
+
+    ASSERT_TRUE(aeron_term_cleaner_clean(
+        &m_cleaner, m_buffer.data(), 1024, initial_position + 1024, &m_cleaned_position));
+    EXPECT_EQ(aeron_term_cleaner_do_work(&m_cleaner), 1);
+
+    EXPECT_TRUE(is_zero(0, 1024));
+    EXPECT_TRUE(aeron_term_cleaner_has_caught_up(initial_position + 1024, &m_cleaned_position));
+    EXPECT_EQ(aeron_term_cleaner_limit(&m_cleaner, 10 * TERM_LENGTH, &m_cleaned_position, TERM_LENGTH),
+        initial_position + 1024 + TERM_LENGTH);
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AERON_TEST_SKIP_H
+#define AERON_TEST_SKIP_H
+
+#include <iostream>
+
+/*
+ * The gtest in use has no GTEST_SKIP, so a test of a feature the kernel or platform lacks returns early and says why,
+ * rather than passing silently as though it had been covered.
+ */
+#define AERON_TEST_SKIP(reason) \
+do \
+{ \
+    std::cout << "[  SKIPPED ] " << ::testing::UnitTest::GetInstance()->current_test_info()->name() \
+        << ": " << reason << std::endl; \
+    return; \
+} \
+while (0)
+
+#endif //AERON_TEST_SKIP_H
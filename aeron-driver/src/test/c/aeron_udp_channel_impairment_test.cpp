@@ -0,0 +1,268 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "media/aeron_udp_channel_impairment.h"
+#include "util/aeron_error.h"
+}
+
+#define FRAME_COUNT (1000)
+#define SEED (42)
+
+struct dispatched_frame_t
+{
+    int32_t value;
+    void *endpoint_clientd;
+    void *destination_clientd;
+};
+
+static void on_recv(
+    void *clientd,
+    void *endpoint_clientd,
+    void *destination_clientd,
+    uint8_t *buffer,
+    size_t length,
+    struct sockaddr_storage *addr)
+{
+    auto frames = static_cast<std::vector<dispatched_frame_t> *>(clientd);
+    dispatched_frame_t frame = {};
+
+    EXPECT_EQ(length, sizeof(frame.value));
+    memcpy(&frame.value, buffer, sizeof(frame.value));
+    frame.endpoint_clientd = endpoint_clientd;
+    frame.destination_clientd = destination_clientd;
+    frames->push_back(frame);
+}
+
+class UdpChannelImpairmentTest : public testing::Test
+{
+public:
+    UdpChannelImpairmentTest()
+    {
+        memset(&m_params, 0, sizeof(m_params));
+        memset(&m_addr, 0, sizeof(m_addr));
+    }
+
+    virtual void TearDown()
+    {
+        aeron_udp_channel_impairment_delete(m_impairment);
+    }
+
+    void create(uint64_t seed = SEED)
+    {
+        aeron_udp_channel_impairment_delete(m_impairment);
+        m_impairment = nullptr;
+        m_frames.clear();
+        ASSERT_EQ(aeron_udp_channel_impairment_create(&m_impairment, &m_params, seed, on_recv, &m_frames), 0)
+            << aeron_errmsg();
+    }
+
+    void recv(int32_t value, void *endpoint_clientd = nullptr, void *destination_clientd = nullptr)
+    {
+        aeron_udp_channel_impairment_on_recv(
+            m_impairment, endpoint_clientd, destination_clientd, (uint8_t *)&value, sizeof(value), &m_addr);
+    }
+
+    std::vector<int32_t> values()
+    {
+        std::vector<int32_t> result;
+
+        for (auto &frame : m_frames)
+        {
+            result.push_back(frame.value);
+        }
+
+        return result;
+    }
+
+protected:
+    aeron_udp_channel_impairment_params_t m_params;
+    aeron_udp_channel_impairment_t *m_impairment = nullptr;
+    std::vector<dispatched_frame_t> m_frames;
+    struct sockaddr_storage m_addr;
+};
+
+TEST_F(UdpChannelImpairmentTest, shouldBeDisabledWithoutImpairments)
+{
+    EXPECT_FALSE(aeron_udp_channel_impairment_params_is_enabled(&m_params));
+
+    m_params.delay_jitter_ns = 1;
+    EXPECT_TRUE(aeron_udp_channel_impairment_params_is_enabled(&m_params));
+}
+
+TEST_F(UdpChannelImpairmentTest, shouldDropTheSameFramesForTheSameSeed)
+{
+    m_params.loss_rate = 0.1;
+    create();
+
+    for (int32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        recv(i);
+    }
+
+    std::vector<int32_t> first = values();
+    EXPECT_GT(first.size(), FRAME_COUNT * 0.8);
+    EXPECT_LT(first.size(), FRAME_COUNT * 0.98);
+
+    create();
+    for (int32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        recv(i);
+    }
+
+    EXPECT_EQ(values(), first);
+
+    create(SEED + 1);
+    for (int32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        recv(i);
+    }
+
+    EXPECT_NE(values(), first);
+}
+
+TEST_F(UdpChannelImpairmentTest, shouldDispatchEveryFrameTwiceWhenAlwaysDuplicating)
+{
+    m_params.duplicate_rate = 1.0;
+    create();
+
+    recv(1);
+    recv(2);
+
+    EXPECT_EQ(values(), std::vector<int32_t>({ 1, 1, 2, 2 }));
+}
+
+TEST_F(UdpChannelImpairmentTest, shouldSwapFrameWithTheOneAfterWhenAlwaysReordering)
+{
+    m_params.reorder_rate = 1.0;
+    create();
+
+    recv(1);
+    EXPECT_TRUE(m_frames.empty());
+
+    recv(2);
+    recv(3);
+    recv(4);
+    EXPECT_EQ(values(), std::vector<int32_t>({ 2, 1, 4, 3 }));
+}
+
+TEST_F(UdpChannelImpairmentTest, shouldReleaseHeldFrameWhenNothingFollowsInTime)
+{
+    m_params.reorder_rate = 1.0;
+    create();
+
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, 0), 0);
+    recv(1);
+
+    const int64_t timeout_ns = AERON_UDP_CHANNEL_IMPAIRMENT_REORDER_TIMEOUT_NS;
+
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, timeout_ns - 1), 0);
+    EXPECT_TRUE(m_frames.empty());
+
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, timeout_ns), 1);
+    EXPECT_EQ(values(), std::vector<int32_t>({ 1 }));
+}
+
+TEST_F(UdpChannelImpairmentTest, shouldDelayFramesInOrderUntilDue)
+{
+    m_params.delay_ns = 100;
+    create();
+
+    aeron_udp_channel_impairment_release(m_impairment, 0);
+    recv(1);
+    aeron_udp_channel_impairment_release(m_impairment, 50);
+    recv(2);
+
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, 99), 0);
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, 100), 1);
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, 149), 0);
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, 150), 1);
+    EXPECT_EQ(values(), std::vector<int32_t>({ 1, 2 }));
+}
+
+TEST_F(UdpChannelImpairmentTest, shouldKeepReorderedFramesSwappedWhenDelayed)
+{
+    m_params.delay_ns = 100;
+    m_params.reorder_rate = 1.0;
+    create();
+
+    aeron_udp_channel_impairment_release(m_impairment, 0);
+    recv(1);
+    recv(2);
+
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, 100), 2);
+    EXPECT_EQ(values(), std::vector<int32_t>({ 2, 1 }));
+}
+
+TEST_F(UdpChannelImpairmentTest, shouldDelayEveryFrameWithinJitter)
+{
+    m_params.delay_ns = 100;
+    m_params.delay_jitter_ns = 1000;
+    create();
+
+    aeron_udp_channel_impairment_release(m_impairment, 0);
+    for (int32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        recv(i);
+    }
+
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, 99), 0);
+    aeron_udp_channel_impairment_release(m_impairment, 1100);
+
+    std::vector<int32_t> dispatched = values();
+    ASSERT_EQ(dispatched.size(), (size_t)FRAME_COUNT);
+    EXPECT_FALSE(std::is_sorted(dispatched.begin(), dispatched.end()));
+
+    std::sort(dispatched.begin(), dispatched.end());
+    for (int32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        EXPECT_EQ(dispatched[i], i);
+    }
+}
+
+TEST_F(UdpChannelImpairmentTest, shouldDiscardFramesOfRemovedEndpointOrDestination)
+{
+    int endpoint_a, endpoint_b, destination;
+
+    m_params.delay_ns = 100;
+    m_params.delay_jitter_ns = 100;
+    create();
+
+    aeron_udp_channel_impairment_release(m_impairment, 0);
+    for (int32_t i = 0; i < 30; i++)
+    {
+        recv(i, &endpoint_a);
+        recv(i, &endpoint_b);
+        recv(i, &endpoint_b, &destination);
+    }
+
+    aeron_udp_channel_impairment_remove(m_impairment, &endpoint_a);
+    aeron_udp_channel_impairment_remove(m_impairment, &destination);
+
+    EXPECT_EQ(aeron_udp_channel_impairment_release(m_impairment, 200), 30);
+    for (auto &frame : m_frames)
+    {
+        EXPECT_EQ(frame.endpoint_clientd, &endpoint_b);
+        EXPECT_EQ(frame.destination_clientd, nullptr);
+    }
+}
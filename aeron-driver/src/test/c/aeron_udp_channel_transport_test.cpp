@@ -0,0 +1,478 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "aeron_test_skip.h"
+
+extern "C"
+{
+#include "aeronmd.h"
+#include "media/aeron_udp_channel_transport.h"
+#include "protocol/aeron_udp_protocol.h"
+#include "util/aeron_error.h"
+#include "concurrent/aeron_thread.h"
+}
+
+#if !defined(__linux__)
+struct mmsghdr
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+#endif
+
+#define SEGMENT_LENGTH (1024)
+#define MAX_PACKET_LENGTH (64 * 1024)
+#define POLL_ATTEMPTS (1000)
+#define FAN_OUT_MEMBERS (3)
+#define TIMESTAMP_TOLERANCE_NS (1000 * 1000)
+
+class UdpChannelTransportTest : public testing::Test
+{
+public:
+    UdpChannelTransportTest()
+    {
+        m_sender.fd = -1;
+        m_receiver.fd = -1;
+        m_buffer.resize(MAX_PACKET_LENGTH);
+    }
+
+    virtual void SetUp()
+    {
+        ASSERT_EQ(open_loopback(&m_receiver, &m_receiver_addr), 0) << aeron_errmsg();
+        ASSERT_EQ(open_loopback(&m_sender, &m_sender_addr), 0) << aeron_errmsg();
+    }
+
+    virtual void TearDown()
+    {
+        if (-1 != m_sender.fd)
+        {
+            aeron_udp_channel_transport_close(&m_sender);
+        }
+
+        if (-1 != m_receiver.fd)
+        {
+            aeron_udp_channel_transport_close(&m_receiver);
+        }
+    }
+
+    static int open_loopback(aeron_udp_channel_transport_t *transport, struct sockaddr_storage *addr)
+    {
+        struct sockaddr_in *in4 = (struct sockaddr_in *)addr;
+
+        memset(addr, 0, sizeof(struct sockaddr_storage));
+        in4->sin_family = AF_INET;
+        in4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        in4->sin_port = 0;
+
+        if (aeron_udp_channel_transport_init(transport, addr, NULL, 0, 0, 0, 0) < 0)
+        {
+            return -1;
+        }
+
+        socklen_t addr_len = sizeof(struct sockaddr_storage);
+        return getsockname(transport->fd, (struct sockaddr *)addr, &addr_len);
+    }
+
+    static void on_recv(
+        void *clientd,
+        void *transport_clientd,
+        void *destination_clientd,
+        uint8_t *buffer,
+        size_t length,
+        struct sockaddr_storage *addr)
+    {
+        UdpChannelTransportTest *test = (UdpChannelTransportTest *)clientd;
+
+        test->m_received.push_back(std::string((const char *)buffer, length));
+        test->m_recv_timestamps.push_back(test->m_receiver.recv_timestamp_ns);
+    }
+
+    int send(const std::string& payload, uint16_t segment_length)
+    {
+        struct iovec iov;
+        struct mmsghdr msg;
+
+        iov.iov_base = (void *)payload.data();
+        iov.iov_len = payload.length();
+        msg.msg_hdr.msg_iov = &iov;
+        msg.msg_hdr.msg_iovlen = 1;
+        msg.msg_hdr.msg_name = &m_receiver_addr;
+        msg.msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        msg.msg_hdr.msg_control = NULL;
+        msg.msg_hdr.msg_controllen = 0;
+        msg.msg_hdr.msg_flags = 0;
+        msg.msg_len = 0;
+
+        if (segment_length > 0 &&
+            aeron_udp_channel_transport_set_gso_segment_length(&msg.msg_hdr, m_send_control, segment_length) < 0)
+        {
+            return -1;
+        }
+
+        return aeron_udp_channel_transport_sendmmsg(&m_sender, &msg, 1);
+    }
+
+    void poll_until(size_t count)
+    {
+        for (int i = 0; i < POLL_ATTEMPTS && m_received.size() < count; i++)
+        {
+            struct iovec iov;
+            struct mmsghdr msg;
+            struct sockaddr_storage addr;
+            int64_t bytes_received = 0;
+
+            iov.iov_base = &m_buffer[0];
+            iov.iov_len = m_buffer.size();
+            msg.msg_hdr.msg_iov = &iov;
+            msg.msg_hdr.msg_iovlen = 1;
+            msg.msg_hdr.msg_name = &addr;
+            msg.msg_hdr.msg_namelen = sizeof(addr);
+            msg.msg_hdr.msg_control = m_recv_control;
+            msg.msg_hdr.msg_controllen = sizeof(m_recv_control);
+            msg.msg_hdr.msg_flags = 0;
+            msg.msg_len = 0;
+
+            int result = aeron_udp_channel_transport_recvmmsg(&m_receiver, &msg, 1, &bytes_received, on_recv, this);
+            ASSERT_GE(result, 0) << aeron_errmsg();
+
+            if (0 == result)
+            {
+                aeron_micro_sleep(1000);
+            }
+        }
+    }
+
+    int recv_split(size_t header_length, uint8_t *target, size_t target_length)
+    {
+        struct iovec iov;
+        struct msghdr msg;
+        struct sockaddr_storage addr;
+        int result = 0;
+
+        iov.iov_base = &m_buffer[0];
+        iov.iov_len = m_buffer.size();
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_name = &addr;
+        msg.msg_control = m_recv_control;
+
+        for (int i = 0; i < POLL_ATTEMPTS && 0 == result; i++)
+        {
+            if ((result = aeron_udp_channel_transport_recv_split(
+                &m_receiver, &msg, header_length, target, target_length)) == 0)
+            {
+                aeron_micro_sleep(1000);
+            }
+        }
+
+        return result;
+    }
+
+    static std::string payload(size_t length)
+    {
+        std::string payload(length, '\0');
+
+        for (size_t i = 0; i < length; i++)
+        {
+            payload[i] = (char)('a' + ((i / SEGMENT_LENGTH) % 26));
+        }
+
+        return payload;
+    }
+
+protected:
+    aeron_udp_channel_transport_t m_sender;
+    aeron_udp_channel_transport_t m_receiver;
+    struct sockaddr_storage m_sender_addr;
+    struct sockaddr_storage m_receiver_addr;
+    uint8_t m_send_control[AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH];
+    uint8_t m_recv_control[AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH];
+    std::vector<uint8_t> m_buffer;
+    std::vector<std::string> m_received;
+    std::vector<int64_t> m_recv_timestamps;
+};
+
+TEST_F(UdpChannelTransportTest, shouldDispatchSingleDatagramWithoutControlMessage)
+{
+    struct msghdr msghdr;
+    uint8_t buffer[64] = { 0 };
+
+    memset(&msghdr, 0, sizeof(msghdr));
+
+    EXPECT_EQ(aeron_udp_channel_transport_dispatch(
+        &m_receiver, &msghdr, buffer, sizeof(buffer), &m_sender_addr, on_recv, this), 1);
+    ASSERT_EQ(m_received.size(), 1u);
+    EXPECT_EQ(m_received[0].length(), sizeof(buffer));
+}
+
+TEST_F(UdpChannelTransportTest, shouldSplitReceiveBetweenBufferAndTarget)
+{
+    const std::string sent = payload(3 * SEGMENT_LENGTH);
+    std::vector<uint8_t> target(SEGMENT_LENGTH);
+
+    ASSERT_EQ(send(sent, 0), 1) << aeron_errmsg();
+    ASSERT_EQ(recv_split(32, &target[0], target.size()), (int)sent.length()) << aeron_errmsg();
+
+    EXPECT_EQ(std::string((const char *)&m_buffer[0], 32), sent.substr(0, 32));
+    EXPECT_EQ(std::string((const char *)&target[0], SEGMENT_LENGTH), sent.substr(32, SEGMENT_LENGTH));
+
+    memcpy(&m_buffer[32], &target[0], target.size());
+    EXPECT_EQ(std::string((const char *)&m_buffer[0], sent.length()), sent);
+}
+
+TEST_F(UdpChannelTransportTest, shouldTrackZeroCopyCompletionsReportedOutOfOrder)
+{
+    m_sender.zero_copy_sent = 6;
+
+    ASSERT_EQ(aeron_udp_channel_transport_on_zero_copy_completed(&m_sender, 4, 5), 0);
+    ASSERT_EQ(aeron_udp_channel_transport_on_zero_copy_completed(&m_sender, 2, 3), 0);
+    EXPECT_FALSE(aeron_udp_channel_transport_zero_copy_has_completed(&m_sender, 1));
+
+    ASSERT_EQ(aeron_udp_channel_transport_on_zero_copy_completed(&m_sender, 0, 1), 0);
+    EXPECT_TRUE(aeron_udp_channel_transport_zero_copy_has_completed(&m_sender, 6));
+    EXPECT_EQ(m_sender.zero_copy_completed, 6u);
+    EXPECT_EQ(m_sender.zero_copy_pending.length, 0u);
+}
+
+#if defined(__linux__)
+
+TEST_F(UdpChannelTransportTest, shouldCompleteZeroCopySends)
+{
+    const std::string sent = payload(2 * SEGMENT_LENGTH);
+
+    if (aeron_udp_channel_transport_enable_zero_copy(&m_sender, SEGMENT_LENGTH) < 0)
+    {
+        AERON_TEST_SKIP("no SO_ZEROCOPY: " << aeron_errmsg());
+    }
+
+    ASSERT_EQ(send(sent, 0), 1) << aeron_errmsg();
+    ASSERT_EQ(send(sent.substr(0, SEGMENT_LENGTH / 2), 0), 1) << aeron_errmsg();
+    EXPECT_EQ(m_sender.zero_copy_sent, 1u);
+
+    for (int i = 0; i < POLL_ATTEMPTS && m_sender.zero_copy_completed != m_sender.zero_copy_sent; i++)
+    {
+        int result = aeron_udp_channel_transport_poll_zero_copy(&m_sender);
+        ASSERT_GE(result, 0) << aeron_errmsg();
+
+        if (0 == result)
+        {
+            aeron_micro_sleep(1000);
+        }
+    }
+
+    EXPECT_TRUE(aeron_udp_channel_transport_zero_copy_has_completed(&m_sender, 1));
+
+    poll_until(2);
+
+    ASSERT_EQ(m_received.size(), 2u);
+    EXPECT_EQ(m_received[0], sent);
+}
+
+TEST_F(UdpChannelTransportTest, shouldSplitGroReceiveIntoSegments)
+{
+    const std::string sent = payload((3 * SEGMENT_LENGTH) + 100);
+
+    if (aeron_udp_channel_transport_enable_gro(&m_receiver) < 0)
+    {
+        AERON_TEST_SKIP("no UDP_GRO: " << aeron_errmsg());
+    }
+
+    if (send(sent, SEGMENT_LENGTH) < 0)
+    {
+        AERON_TEST_SKIP("no UDP_SEGMENT: " << aeron_errmsg());
+    }
+
+    poll_until(4);
+
+    ASSERT_EQ(m_received.size(), 4u);
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(m_received[i], sent.substr(i * SEGMENT_LENGTH, SEGMENT_LENGTH));
+    }
+    EXPECT_EQ(m_received[3], sent.substr(3 * SEGMENT_LENGTH));
+}
+
+TEST_F(UdpChannelTransportTest, shouldReceiveGsoSendAsSeparateDatagramsWithoutGro)
+{
+    const std::string sent = payload(2 * SEGMENT_LENGTH);
+
+    if (send(sent, SEGMENT_LENGTH) < 0)
+    {
+        AERON_TEST_SKIP("no UDP_SEGMENT: " << aeron_errmsg());
+    }
+
+    poll_until(2);
+
+    ASSERT_EQ(m_received.size(), 2u);
+    EXPECT_EQ(m_received[0], sent.substr(0, SEGMENT_LENGTH));
+    EXPECT_EQ(m_received[1], sent.substr(SEGMENT_LENGTH));
+}
+
+TEST_F(UdpChannelTransportTest, shouldTimestampReceivedDatagrams)
+{
+    const std::string sent = payload(SEGMENT_LENGTH);
+    std::vector<uint8_t> target(SEGMENT_LENGTH);
+
+    if (aeron_udp_channel_transport_enable_timestamping(&m_receiver, false) < 0)
+    {
+        AERON_TEST_SKIP("no SO_TIMESTAMPING: " << aeron_errmsg());
+    }
+
+    const int64_t before_ns = aeron_epoch_nano_clock();
+    ASSERT_EQ(send(sent, 0), 1) << aeron_errmsg();
+    poll_until(1);
+
+    ASSERT_EQ(send(sent, 0), 1) << aeron_errmsg();
+    ASSERT_EQ(recv_split(32, &target[0], target.size()), (int)sent.length()) << aeron_errmsg();
+    const int64_t after_ns = aeron_epoch_nano_clock();
+
+    /* the kernel stamps with its own read of the realtime clock so allow for it not agreeing exactly with ours */
+    ASSERT_EQ(m_recv_timestamps.size(), 1u);
+    for (int64_t timestamp_ns : { m_recv_timestamps[0], m_receiver.recv_timestamp_ns })
+    {
+        EXPECT_NE(timestamp_ns, 0);
+        EXPECT_GE(timestamp_ns, before_ns - TIMESTAMP_TOLERANCE_NS);
+        EXPECT_LE(timestamp_ns, after_ns + TIMESTAMP_TOLERANCE_NS);
+    }
+}
+
+TEST_F(UdpChannelTransportTest, shouldKeepEachSessionOnOneSocketOfFanOut)
+{
+    aeron_udp_channel_transport_t group[FAN_OUT_MEMBERS + 1];
+    struct sockaddr_storage bind_addr;
+    struct sockaddr_in *in4 = (struct sockaddr_in *)&bind_addr;
+    const int32_t session_count = 8, frames_per_session = 4;
+
+    memset(&bind_addr, 0, sizeof(bind_addr));
+    in4->sin_family = AF_INET;
+    in4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (aeron_udp_channel_transport_init_fan_out(
+        &group[0], &group[1], FAN_OUT_MEMBERS, &bind_addr, 0, 0, AERON_UDP_CHANNEL_TRANSPORT_STEERING_SESSION) < 0)
+    {
+        AERON_TEST_SKIP("no SO_REUSEPORT fan out: " << aeron_errmsg());
+    }
+
+    socklen_t addr_len = sizeof(m_receiver_addr);
+    ASSERT_EQ(getsockname(group[0].fd, (struct sockaddr *)&m_receiver_addr, &addr_len), 0);
+    for (size_t i = 1; i <= FAN_OUT_MEMBERS; i++)
+    {
+        struct sockaddr_storage member_addr;
+
+        addr_len = sizeof(member_addr);
+        ASSERT_EQ(getsockname(group[i].fd, (struct sockaddr *)&member_addr, &addr_len), 0);
+        EXPECT_EQ(((struct sockaddr_in *)&member_addr)->sin_port, ((struct sockaddr_in *)&m_receiver_addr)->sin_port);
+        EXPECT_EQ(group[i].fan_out_leader, &group[0]);
+    }
+
+    for (int32_t i = 0; i < session_count * frames_per_session; i++)
+    {
+        aeron_data_header_t header;
+
+        memset(&header, 0, sizeof(header));
+        header.frame_header.type = AERON_HDR_TYPE_DATA;
+        header.session_id = (i % session_count) + 1;
+        ASSERT_EQ(send(std::string((const char *)&header, sizeof(header)), 0), 1) << aeron_errmsg();
+    }
+
+    std::vector<std::vector<int32_t>> sessions_by_socket(FAN_OUT_MEMBERS + 1);
+    size_t received = 0;
+
+    for (int attempt = 0; attempt < POLL_ATTEMPTS && received < (size_t)(session_count * frames_per_session); attempt++)
+    {
+        const size_t received_before = received;
+
+        for (size_t i = 0; i <= FAN_OUT_MEMBERS; i++)
+        {
+            struct iovec iov;
+            struct mmsghdr msg;
+            struct sockaddr_storage addr;
+            int64_t bytes_received = 0;
+
+            iov.iov_base = &m_buffer[0];
+            iov.iov_len = m_buffer.size();
+            msg.msg_hdr.msg_iov = &iov;
+            msg.msg_hdr.msg_iovlen = 1;
+            msg.msg_hdr.msg_name = &addr;
+            msg.msg_hdr.msg_namelen = sizeof(addr);
+            msg.msg_hdr.msg_control = NULL;
+            msg.msg_hdr.msg_controllen = 0;
+            msg.msg_hdr.msg_flags = 0;
+            msg.msg_len = 0;
+
+            m_received.clear();
+            ASSERT_GE(aeron_udp_channel_transport_recvmmsg(
+                &group[i], &msg, 1, &bytes_received, on_recv, this), 0) << aeron_errmsg();
+
+            for (auto &frame : m_received)
+            {
+                sessions_by_socket[i].push_back(((aeron_data_header_t *)frame.data())->session_id);
+                received++;
+            }
+        }
+
+        if (received == received_before)
+        {
+            aeron_micro_sleep(1000);
+        }
+    }
+
+    EXPECT_EQ(received, (size_t)(session_count * frames_per_session));
+
+    size_t sockets_used = 0;
+    for (size_t i = 0; i <= FAN_OUT_MEMBERS; i++)
+    {
+        sockets_used += sessions_by_socket[i].empty() ? 0 : 1;
+        for (int32_t session_id : sessions_by_socket[i])
+        {
+            EXPECT_EQ(std::count(sessions_by_socket[i].begin(), sessions_by_socket[i].end(), session_id),
+                frames_per_session) << "session " << session_id << " split across sockets";
+        }
+    }
+
+    EXPECT_GT(sockets_used, 1u);
+
+    for (size_t i = 0; i <= FAN_OUT_MEMBERS; i++)
+    {
+        aeron_udp_channel_transport_close(&group[i]);
+    }
+}
+
+TEST_F(UdpChannelTransportTest, shouldRecordFanOutMemberTimestampsOnLeader)
+{
+    aeron_udp_channel_transport_t member;
+    struct msghdr msghdr;
+    uint8_t buffer[64] = { 0 };
+
+    memset(&member, 0, sizeof(member));
+    memset(&msghdr, 0, sizeof(msghdr));
+    member.fan_out_leader = &m_receiver;
+    m_receiver.recv_timestamp_ns = 42;
+    member.recv_timestamp_ns = 42;
+
+    EXPECT_EQ(aeron_udp_channel_transport_dispatch(
+        &member, &msghdr, buffer, sizeof(buffer), &m_sender_addr, on_recv, this), 1);
+    EXPECT_EQ(m_receiver.recv_timestamp_ns, 0);
+    EXPECT_EQ(member.recv_timestamp_ns, 42);
+}
+
+#endif
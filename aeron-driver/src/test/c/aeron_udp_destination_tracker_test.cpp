@@ -0,0 +1,273 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "aeronmd.h"
+#include "media/aeron_udp_destination_tracker.h"
+#include "util/aeron_error.h"
+}
+
+#if !defined(__linux__)
+struct mmsghdr
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+#endif
+
+#define MAX_PACKET_LENGTH (1024)
+#define POLL_ATTEMPTS (1000)
+#define DESTINATION_TIMEOUT_NS (1000L)
+
+static int64_t now_ns = 0;
+
+static int64_t test_nano_clock()
+{
+    return now_ns;
+}
+
+class UdpDestinationTrackerTest : public testing::Test
+{
+public:
+    UdpDestinationTrackerTest()
+    {
+        now_ns = 0;
+        m_sender.fd = -1;
+        aeron_udp_destination_tracker_init(&m_tracker, test_nano_clock, DESTINATION_TIMEOUT_NS);
+    }
+
+    virtual void SetUp()
+    {
+        struct sockaddr_storage addr;
+
+        ASSERT_EQ(open_loopback(&m_sender, &addr), 0) << aeron_errmsg();
+    }
+
+    virtual void TearDown()
+    {
+        aeron_udp_destination_tracker_close(&m_tracker);
+
+        if (-1 != m_sender.fd)
+        {
+            aeron_udp_channel_transport_close(&m_sender);
+        }
+
+        for (auto receiver : m_receivers)
+        {
+            aeron_udp_channel_transport_close(receiver);
+            delete receiver;
+        }
+    }
+
+    static int open_loopback(aeron_udp_channel_transport_t *transport, struct sockaddr_storage *addr)
+    {
+        struct sockaddr_in *in4 = (struct sockaddr_in *)addr;
+
+        memset(addr, 0, sizeof(struct sockaddr_storage));
+        in4->sin_family = AF_INET;
+        in4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        in4->sin_port = 0;
+
+        if (aeron_udp_channel_transport_init(transport, addr, NULL, 0, 0, 0, 0) < 0)
+        {
+            return -1;
+        }
+
+        socklen_t addr_len = sizeof(struct sockaddr_storage);
+        return getsockname(transport->fd, (struct sockaddr *)addr, &addr_len);
+    }
+
+    void add_destinations(size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            aeron_udp_channel_transport_t *receiver = new aeron_udp_channel_transport_t();
+            struct sockaddr_storage addr;
+
+            m_receivers.push_back(receiver);
+            ASSERT_EQ(open_loopback(receiver, &addr), 0) << aeron_errmsg();
+            ASSERT_EQ(aeron_udp_destination_tracker_add_destination(&m_tracker, (int64_t)i, now_ns, &addr), 0);
+        }
+    }
+
+    int send(const std::vector<std::string>& payloads)
+    {
+        std::vector<struct iovec> iov(payloads.size());
+        std::vector<struct mmsghdr> msgs(payloads.size());
+
+        for (size_t i = 0; i < payloads.size(); i++)
+        {
+            iov[i].iov_base = (void *)payloads[i].data();
+            iov[i].iov_len = payloads[i].length();
+            memset(&msgs[i], 0, sizeof(struct mmsghdr));
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        return aeron_udp_destination_tracker_sendmmsg(&m_tracker, &m_sender, msgs.data(), msgs.size());
+    }
+
+    static void on_recv(
+        void *clientd,
+        void *transport_clientd,
+        void *destination_clientd,
+        uint8_t *buffer,
+        size_t length,
+        struct sockaddr_storage *addr)
+    {
+        std::vector<std::string> *received = (std::vector<std::string> *)clientd;
+
+        received->push_back(std::string((const char *)buffer, length));
+    }
+
+    std::vector<std::string> poll(aeron_udp_channel_transport_t *receiver, size_t count)
+    {
+        std::vector<std::string> received;
+        uint8_t buffer[MAX_PACKET_LENGTH];
+
+        for (int i = 0; i < POLL_ATTEMPTS && received.size() < count; i++)
+        {
+            struct iovec iov;
+            struct mmsghdr msg;
+            struct sockaddr_storage addr;
+            int64_t bytes_received = 0;
+
+            iov.iov_base = buffer;
+            iov.iov_len = sizeof(buffer);
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_hdr.msg_iov = &iov;
+            msg.msg_hdr.msg_iovlen = 1;
+            msg.msg_hdr.msg_name = &addr;
+            msg.msg_hdr.msg_namelen = sizeof(addr);
+
+            EXPECT_GE(aeron_udp_channel_transport_recvmmsg(
+                receiver, &msg, 1, &bytes_received, on_recv, &received), 0) << aeron_errmsg();
+        }
+
+        return received;
+    }
+
+protected:
+    aeron_udp_destination_tracker_t m_tracker;
+    aeron_udp_channel_transport_t m_sender;
+    std::vector<aeron_udp_channel_transport_t *> m_receivers;
+};
+
+TEST_F(UdpDestinationTrackerTest, shouldSendEveryMessageToEveryDestinationInOrder)
+{
+    const std::vector<std::string> payloads = { "first", "second", "third" };
+
+    add_destinations(3);
+
+    EXPECT_EQ(send(payloads), 3);
+
+    for (auto receiver : m_receivers)
+    {
+        EXPECT_EQ(poll(receiver, payloads.size()), payloads);
+    }
+}
+
+TEST_F(UdpDestinationTrackerTest, shouldFanOutBeyondOneSendmmsgCall)
+{
+    const size_t destination_count = 20;
+    std::vector<std::string> payloads;
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        payloads.push_back("message-" + std::to_string(i));
+    }
+
+    add_destinations(destination_count);
+    ASSERT_GT(destination_count * payloads.size(), (size_t)AERON_UDP_DESTINATION_TRACKER_FAN_OUT_MAX_VLEN);
+
+    EXPECT_EQ(send(payloads), (int)payloads.size());
+
+    for (auto receiver : m_receivers)
+    {
+        EXPECT_EQ(poll(receiver, payloads.size()), payloads);
+    }
+}
+
+TEST_F(UdpDestinationTrackerTest, shouldSkipFailingDestinationAndSendToTheRest)
+{
+    const std::vector<std::string> payloads = { "first", "second", "third" };
+    struct sockaddr_storage bad_addr;
+    struct sockaddr_in *in4 = (struct sockaddr_in *)&bad_addr;
+
+    add_destinations(1);
+
+    /* port 0 is rejected with EINVAL for every message */
+    memset(&bad_addr, 0, sizeof(bad_addr));
+    in4->sin_family = AF_INET;
+    in4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    in4->sin_port = 0;
+    ASSERT_EQ(aeron_udp_destination_tracker_add_destination(&m_tracker, 1, now_ns, &bad_addr), 0);
+
+    add_destinations(1);
+
+    EXPECT_EQ(send(payloads), 0);
+
+    for (auto receiver : m_receivers)
+    {
+        EXPECT_EQ(poll(receiver, payloads.size()), payloads);
+    }
+}
+
+TEST_F(UdpDestinationTrackerTest, shouldFailWhenEveryDestinationFails)
+{
+    struct sockaddr_storage bad_addr;
+    struct sockaddr_in *in4 = (struct sockaddr_in *)&bad_addr;
+
+    memset(&bad_addr, 0, sizeof(bad_addr));
+    in4->sin_family = AF_INET;
+    in4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    in4->sin_port = 0;
+    ASSERT_EQ(aeron_udp_destination_tracker_add_destination(&m_tracker, 0, now_ns, &bad_addr), 0);
+
+    EXPECT_EQ(send({ "first", "second" }), -1);
+    EXPECT_EQ(aeron_errcode(), EINVAL);
+}
+
+TEST_F(UdpDestinationTrackerTest, shouldDropTimedOutDestinationsAndReuseFanOut)
+{
+    const std::vector<std::string> payloads = { "before", "timeout" };
+
+    add_destinations(2);
+    ASSERT_EQ(send(payloads), 2);
+    struct mmsghdr *fan_out = m_tracker.fan_out.mmsghdrs;
+
+    now_ns += DESTINATION_TIMEOUT_NS;
+    m_tracker.destinations.array[1].time_of_last_activity_ns = now_ns;
+    now_ns += 1;
+
+    EXPECT_EQ(send({ "after" }), 1);
+    EXPECT_EQ(m_tracker.destinations.length, 1u);
+    EXPECT_EQ(m_tracker.fan_out.mmsghdrs, fan_out);
+
+    EXPECT_EQ(poll(m_receivers[0], 2), payloads);
+    EXPECT_EQ(poll(m_receivers[1], 3), std::vector<std::string>({ "before", "timeout", "after" }));
+
+    now_ns += DESTINATION_TIMEOUT_NS + 1;
+
+    EXPECT_EQ(send({ "nobody" }), 1);
+    EXPECT_EQ(m_tracker.destinations.length, 0u);
+}
@@ -0,0 +1,346 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "aeron_test_skip.h"
+
+extern "C"
+{
+#include "media/aeron_udp_channel_transport.h"
+#include "media/aeron_udp_transport_uring.h"
+#include "util/aeron_error.h"
+#include "concurrent/aeron_thread.h"
+}
+
+#define MAX_PACKET_LENGTH (1408)
+#define POLL_ATTEMPTS (1000)
+
+class UdpTransportUringTest : public testing::Test
+{
+public:
+    UdpTransportUringTest() : m_is_supported(false)
+    {
+        m_sender.fd = -1;
+        m_receiver.fd = -1;
+    }
+
+    virtual void SetUp()
+    {
+        m_is_supported = aeron_udp_transport_uring_init(&m_ring, 64, MAX_PACKET_LENGTH) >= 0;
+        if (!m_is_supported)
+        {
+            m_skip_reason = std::string("no io_uring: ") + aeron_errmsg();
+            return;
+        }
+
+        ASSERT_EQ(open_loopback(&m_receiver, &m_receiver_addr), 0) << aeron_errmsg();
+        ASSERT_EQ(open_loopback(&m_sender, &m_sender_addr), 0) << aeron_errmsg();
+    }
+
+    virtual void TearDown()
+    {
+        if (m_is_supported)
+        {
+            aeron_udp_transport_uring_close(&m_ring);
+        }
+
+        if (-1 != m_sender.fd)
+        {
+            aeron_udp_channel_transport_close(&m_sender);
+        }
+
+        if (-1 != m_receiver.fd)
+        {
+            aeron_udp_channel_transport_close(&m_receiver);
+        }
+    }
+
+    static int open_loopback(aeron_udp_channel_transport_t *transport, struct sockaddr_storage *addr)
+    {
+        struct sockaddr_in *in4 = (struct sockaddr_in *)addr;
+
+        memset(addr, 0, sizeof(struct sockaddr_storage));
+        in4->sin_family = AF_INET;
+        in4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        in4->sin_port = 0;
+
+        if (aeron_udp_channel_transport_init(transport, addr, NULL, 0, 0, 0, 0) < 0)
+        {
+            return -1;
+        }
+
+        socklen_t addr_len = sizeof(struct sockaddr_storage);
+        return getsockname(transport->fd, (struct sockaddr *)addr, &addr_len);
+    }
+
+    static void on_recv(
+        void *clientd,
+        void *transport_clientd,
+        void *destination_clientd,
+        uint8_t *buffer,
+        size_t length,
+        struct sockaddr_storage *addr)
+    {
+        UdpTransportUringTest *test = (UdpTransportUringTest *)clientd;
+
+        test->m_received.push_back(std::string((const char *)buffer, length));
+        test->m_received_port = ntohs(((struct sockaddr_in *)addr)->sin_port);
+    }
+
+    int send(const std::string& message)
+    {
+        struct iovec iov;
+        struct msghdr msghdr;
+
+        init_msghdr(&msghdr, &iov, message, &m_receiver_addr);
+
+        return aeron_udp_channel_transport_sendmsg(&m_sender, &msghdr);
+    }
+
+    static void init_msghdr(
+        struct msghdr *msghdr, struct iovec *iov, const std::string& message, struct sockaddr_storage *addr)
+    {
+        iov->iov_base = (void *)message.data();
+        iov->iov_len = message.length();
+        msghdr->msg_iov = iov;
+        msghdr->msg_iovlen = 1;
+        msghdr->msg_name = addr;
+        msghdr->msg_namelen = sizeof(struct sockaddr_in);
+        msghdr->msg_control = NULL;
+        msghdr->msg_controllen = 0;
+        msghdr->msg_flags = 0;
+    }
+
+    void poll_until(size_t count)
+    {
+        for (int i = 0; i < POLL_ATTEMPTS && m_received.size() < count; i++)
+        {
+            int64_t bytes_received = 0;
+            ASSERT_GE(aeron_udp_transport_uring_poll(&m_ring, &bytes_received, on_recv, this), 0) << aeron_errmsg();
+            m_bytes_received += bytes_received;
+
+            if (0 == bytes_received)
+            {
+                aeron_micro_sleep(1000);
+            }
+        }
+    }
+
+protected:
+    aeron_udp_transport_uring_t m_ring;
+    aeron_udp_channel_transport_t m_sender;
+    aeron_udp_channel_transport_t m_receiver;
+    struct sockaddr_storage m_sender_addr;
+    struct sockaddr_storage m_receiver_addr;
+    std::vector<std::string> m_received;
+    int64_t m_bytes_received = 0;
+    int m_received_port = 0;
+    bool m_is_supported;
+    std::string m_skip_reason;
+};
+
+TEST_F(UdpTransportUringTest, shouldSendAndReceiveThroughRing)
+{
+    if (!m_is_supported)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    ASSERT_EQ(aeron_udp_transport_uring_add(&m_ring, &m_receiver), 0) << aeron_errmsg();
+    m_sender.uring = &m_ring;
+
+    const std::string small(32, 'a');
+    const std::string large(MAX_PACKET_LENGTH, 'b');
+
+    EXPECT_EQ(send(small), (int)small.length());
+    EXPECT_EQ(send(large), (int)large.length());
+    ASSERT_GE(aeron_udp_transport_uring_submit(&m_ring), 0) << aeron_errmsg();
+
+    poll_until(2);
+
+    ASSERT_EQ(m_received.size(), 2u);
+    EXPECT_EQ(m_received[0], small);
+    EXPECT_EQ(m_received[1], large);
+    EXPECT_EQ(m_bytes_received, (int64_t)(small.length() + large.length()));
+    EXPECT_EQ(m_received_port, ntohs(((struct sockaddr_in *)&m_sender_addr)->sin_port));
+}
+
+TEST_F(UdpTransportUringTest, shouldReceiveMoreDatagramsThanProvidedBuffers)
+{
+    if (!m_is_supported)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    ASSERT_EQ(aeron_udp_transport_uring_add(&m_ring, &m_receiver), 0) << aeron_errmsg();
+    m_sender.uring = &m_ring;
+
+    const size_t count = 256;
+    for (size_t i = 0; i < count; i++)
+    {
+        ASSERT_GT(send(std::to_string(i)), 0);
+        if (0 == (i & 31))
+        {
+            ASSERT_GE(aeron_udp_transport_uring_submit(&m_ring), 0) << aeron_errmsg();
+            poll_until(i);
+        }
+    }
+    ASSERT_GE(aeron_udp_transport_uring_submit(&m_ring), 0) << aeron_errmsg();
+
+    poll_until(count);
+
+    ASSERT_EQ(m_received.size(), count);
+    for (size_t i = 0; i < count; i++)
+    {
+        EXPECT_EQ(m_received[i], std::to_string(i));
+    }
+}
+
+TEST_F(UdpTransportUringTest, shouldStopDispatchingAfterRemove)
+{
+    if (!m_is_supported)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    ASSERT_EQ(aeron_udp_transport_uring_add(&m_ring, &m_receiver), 0) << aeron_errmsg();
+    ASSERT_EQ(aeron_udp_transport_uring_remove(&m_ring, &m_receiver), 0) << aeron_errmsg();
+    EXPECT_EQ(m_receiver.uring, (aeron_udp_transport_uring_t *)NULL);
+
+    m_sender.uring = &m_ring;
+    ASSERT_GT(send("after remove"), 0);
+    ASSERT_GE(aeron_udp_transport_uring_submit(&m_ring), 0) << aeron_errmsg();
+
+    poll_until(1);
+
+    EXPECT_EQ(m_received.size(), 0u);
+}
+
+TEST_F(UdpTransportUringTest, shouldSplitGroReceiveOfGsoSendIntoSegments)
+{
+    if (!m_is_supported)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    if (aeron_udp_channel_transport_enable_gro(&m_receiver) < 0)
+    {
+        AERON_TEST_SKIP("no UDP_GRO: " << aeron_errmsg());
+    }
+
+    ASSERT_EQ(aeron_udp_transport_uring_add(&m_ring, &m_receiver), 0) << aeron_errmsg();
+    m_sender.uring = &m_ring;
+
+    const std::string message = std::string(512, 'a') + std::string(512, 'b') + std::string(100, 'c');
+    uint8_t control[AERON_UDP_CHANNEL_TRANSPORT_CONTROL_LENGTH];
+    struct iovec iov;
+    struct msghdr msghdr;
+
+    iov.iov_base = (void *)message.data();
+    iov.iov_len = message.length();
+    msghdr.msg_iov = &iov;
+    msghdr.msg_iovlen = 1;
+    msghdr.msg_name = &m_receiver_addr;
+    msghdr.msg_namelen = sizeof(struct sockaddr_in);
+    msghdr.msg_flags = 0;
+
+    if (aeron_udp_channel_transport_set_gso_segment_length(&msghdr, control, 512) < 0)
+    {
+        AERON_TEST_SKIP("no UDP_SEGMENT: " << aeron_errmsg());
+    }
+
+    ASSERT_EQ(aeron_udp_channel_transport_sendmsg(&m_sender, &msghdr), (int)message.length());
+    ASSERT_GE(aeron_udp_transport_uring_submit(&m_ring), 0) << aeron_errmsg();
+
+    poll_until(3);
+
+    ASSERT_EQ(m_received.size(), 3u);
+    EXPECT_EQ(m_received[0], std::string(512, 'a'));
+    EXPECT_EQ(m_received[1], std::string(512, 'b'));
+    EXPECT_EQ(m_received[2], std::string(100, 'c'));
+}
+
+TEST_F(UdpTransportUringTest, shouldCountOnlyBatchMessagesSentBeforeFailedSend)
+{
+    if (!m_is_supported)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    ASSERT_EQ(aeron_udp_transport_uring_add(&m_ring, &m_receiver), 0) << aeron_errmsg();
+    m_sender.uring = &m_ring;
+
+    /* the kernel rejects a send to port 0 with EINVAL, which only shows in the completion */
+    struct sockaddr_storage invalid_addr = m_receiver_addr;
+    ((struct sockaddr_in *)&invalid_addr)->sin_port = 0;
+
+    const std::string messages[] = { "first", "second", "third" };
+    struct iovec iov[3];
+    struct mmsghdr msgvec[3];
+
+    init_msghdr(&msgvec[0].msg_hdr, &iov[0], messages[0], &m_receiver_addr);
+    init_msghdr(&msgvec[1].msg_hdr, &iov[1], messages[1], &invalid_addr);
+    init_msghdr(&msgvec[2].msg_hdr, &iov[2], messages[2], &m_receiver_addr);
+    msgvec[0].msg_len = 0;
+
+    EXPECT_EQ(aeron_udp_channel_transport_sendmmsg(&m_sender, msgvec, 3), 1) << aeron_errmsg();
+    EXPECT_EQ(msgvec[0].msg_len, messages[0].length());
+    EXPECT_EQ(m_ring.sends_in_flight, 0u);
+
+    EXPECT_EQ(aeron_udp_channel_transport_sendmmsg(&m_sender, &msgvec[1], 2), -1);
+    EXPECT_EQ(aeron_errcode(), EINVAL);
+
+    EXPECT_EQ(aeron_udp_channel_transport_sendmsg(&m_sender, &msgvec[1].msg_hdr), -1);
+    EXPECT_EQ(aeron_errcode(), EINVAL);
+
+    /* the whole batch is submitted, so the message after a failed one goes out each time and is only duplicated */
+    poll_until(3);
+
+    ASSERT_EQ(m_received.size(), 3u);
+    EXPECT_EQ(m_received[0], messages[0]);
+    EXPECT_EQ(m_received[1], messages[2]);
+    EXPECT_EQ(m_received[2], messages[2]);
+}
+
+TEST_F(UdpTransportUringTest, shouldDispatchReceivesSetAsideWhileSendingInOrder)
+{
+    if (!m_is_supported)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    ASSERT_EQ(aeron_udp_transport_uring_add(&m_ring, &m_receiver), 0) << aeron_errmsg();
+    m_sender.uring = &m_ring;
+
+    const size_t count = 32;
+    for (size_t i = 0; i < count; i++)
+    {
+        ASSERT_EQ(send(std::to_string(i)), (int)std::to_string(i).length()) << aeron_errmsg();
+    }
+
+    poll_until(count);
+
+    ASSERT_EQ(m_received.size(), count);
+    for (size_t i = 0; i < count; i++)
+    {
+        EXPECT_EQ(m_received[i], std::to_string(i));
+    }
+    EXPECT_EQ(m_ring.deferred_cqes.length, 0u);
+}
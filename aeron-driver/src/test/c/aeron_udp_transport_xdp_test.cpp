@@ -0,0 +1,500 @@
+/*
+ * Copyright 2014-2019 Real Logic Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "aeron_test_skip.h"
+
+extern "C"
+{
+#include "media/aeron_udp_channel_transport.h"
+#include "media/aeron_udp_transport_xdp.h"
+#include "util/aeron_error.h"
+#include "aeron_alloc.h"
+#include "concurrent/aeron_thread.h"
+}
+
+#if !defined(__linux__)
+struct mmsghdr
+{
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+#endif
+
+#define FRAME_COUNT (64)
+#define POLL_ATTEMPTS (1000)
+
+/*
+ * Generic mode XDP on loopback sees every datagram sent over it, whether sent by the kernel or from the AF_XDP TX ring,
+ * so both directions can be exercised without a NIC. Skipped where AF_XDP, or the privileges it needs, are missing.
+ */
+class UdpTransportXdpTest : public testing::Test
+{
+public:
+    UdpTransportXdpTest() : m_xdp(NULL)
+    {
+        m_sender.fd = -1;
+        m_receiver.fd = -1;
+    }
+
+    virtual void SetUp()
+    {
+        int result = aeron_udp_transport_xdp_init(&m_xdp, "lo", 0, FRAME_COUNT);
+
+        /* the kernel lets go of the queue the previous test bound in the background */
+        for (int i = 0; i < POLL_ATTEMPTS && result < 0 && EBUSY == aeron_errcode(); i++)
+        {
+            aeron_micro_sleep(1000);
+            result = aeron_udp_transport_xdp_init(&m_xdp, "lo", 0, FRAME_COUNT);
+        }
+
+        if (result < 0)
+        {
+            m_xdp = NULL;
+            m_skip_reason = std::string("no AF_XDP: ") + aeron_errmsg();
+            return;
+        }
+
+        ASSERT_EQ(open_loopback(&m_receiver, &m_receiver_addr), 0) << aeron_errmsg();
+        ASSERT_EQ(open_loopback(&m_sender, &m_sender_addr), 0) << aeron_errmsg();
+        m_receiver.dispatch_clientd = &m_receiver;
+    }
+
+    virtual void TearDown()
+    {
+        aeron_udp_transport_xdp_close(m_xdp);
+
+        if (-1 != m_sender.fd)
+        {
+            aeron_udp_channel_transport_close(&m_sender);
+        }
+
+        if (-1 != m_receiver.fd)
+        {
+            aeron_udp_channel_transport_close(&m_receiver);
+        }
+    }
+
+    static int open_loopback(aeron_udp_channel_transport_t *transport, struct sockaddr_storage *addr)
+    {
+        struct sockaddr_in *in4 = (struct sockaddr_in *)addr;
+
+        memset(addr, 0, sizeof(struct sockaddr_storage));
+        in4->sin_family = AF_INET;
+        in4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        in4->sin_port = 0;
+
+        if (aeron_udp_channel_transport_init(transport, addr, NULL, 0, 0, 0, 0) < 0)
+        {
+            return -1;
+        }
+
+        socklen_t addr_len = sizeof(struct sockaddr_storage);
+        return getsockname(transport->fd, (struct sockaddr *)addr, &addr_len);
+    }
+
+    static void on_recv(
+        void *clientd,
+        void *transport_clientd,
+        void *destination_clientd,
+        uint8_t *buffer,
+        size_t length,
+        struct sockaddr_storage *addr)
+    {
+        UdpTransportXdpTest *test = (UdpTransportXdpTest *)clientd;
+
+        test->m_received.push_back(std::string((const char *)buffer, length));
+        test->m_received_port = ntohs(((struct sockaddr_in *)addr)->sin_port);
+        test->m_transport_clientd = transport_clientd;
+    }
+
+    int send(const std::vector<std::string>& messages)
+    {
+        std::vector<struct iovec> iov(messages.size());
+        std::vector<struct mmsghdr> msgvec(messages.size());
+
+        for (size_t i = 0; i < messages.size(); i++)
+        {
+            iov[i].iov_base = (void *)messages[i].data();
+            iov[i].iov_len = messages[i].length();
+            msgvec[i].msg_hdr.msg_iov = &iov[i];
+            msgvec[i].msg_hdr.msg_iovlen = 1;
+            msgvec[i].msg_hdr.msg_name = &m_receiver_addr;
+            msgvec[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            msgvec[i].msg_hdr.msg_control = NULL;
+            msgvec[i].msg_hdr.msg_controllen = 0;
+            msgvec[i].msg_hdr.msg_flags = 0;
+            msgvec[i].msg_len = 0;
+        }
+
+        return aeron_udp_channel_transport_sendmmsg(&m_sender, msgvec.data(), msgvec.size());
+    }
+
+    void poll_xdp_until(size_t count)
+    {
+        for (int i = 0; i < POLL_ATTEMPTS && m_received.size() < count; i++)
+        {
+            int64_t bytes_received = 0;
+            ASSERT_GE(aeron_udp_transport_xdp_poll(m_xdp, &bytes_received, on_recv, this), 0) << aeron_errmsg();
+            m_bytes_received += bytes_received;
+        }
+    }
+
+    void poll_socket_until(size_t count)
+    {
+        uint8_t buffer[AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH];
+        struct sockaddr_storage addr;
+        struct iovec iov;
+        struct mmsghdr msg;
+
+        for (int i = 0; i < POLL_ATTEMPTS && m_received.size() < count; i++)
+        {
+            int64_t bytes_received = 0;
+
+            iov.iov_base = buffer;
+            iov.iov_len = sizeof(buffer);
+            msg.msg_hdr.msg_iov = &iov;
+            msg.msg_hdr.msg_iovlen = 1;
+            msg.msg_hdr.msg_name = &addr;
+            msg.msg_hdr.msg_namelen = sizeof(addr);
+            msg.msg_hdr.msg_control = NULL;
+            msg.msg_hdr.msg_controllen = 0;
+            msg.msg_hdr.msg_flags = 0;
+            msg.msg_len = 0;
+
+            ASSERT_GE(aeron_udp_channel_transport_recvmmsg(
+                &m_receiver, &msg, 1, &bytes_received, on_recv, this), 0) << aeron_errmsg();
+            m_bytes_received += bytes_received;
+        }
+    }
+
+protected:
+    aeron_udp_transport_xdp_t *m_xdp;
+    std::string m_skip_reason;
+    aeron_udp_channel_transport_t m_sender;
+    aeron_udp_channel_transport_t m_receiver;
+    struct sockaddr_storage m_sender_addr;
+    struct sockaddr_storage m_receiver_addr;
+    std::vector<std::string> m_received;
+    int64_t m_bytes_received = 0;
+    int m_received_port = 0;
+    void *m_transport_clientd = NULL;
+};
+
+TEST_F(UdpTransportXdpTest, shouldDeliverToPortLeftToKernelSocket)
+{
+    if (NULL == m_xdp)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    ASSERT_EQ(aeron_udp_transport_xdp_attach_sender(m_xdp, &m_sender), 0) << aeron_errmsg();
+    ASSERT_EQ(m_sender.xdp, m_xdp);
+
+    const std::vector<std::string> messages = { std::string(32, 'a'), std::string(1408, 'b') };
+
+    ASSERT_EQ(send(messages), 2) << aeron_errmsg();
+
+    poll_socket_until(2);
+
+    ASSERT_EQ(m_received.size(), 2u);
+    EXPECT_EQ(m_received[0], messages[0]);
+    EXPECT_EQ(m_received[1], messages[1]);
+    EXPECT_EQ(m_received_port, ntohs(((struct sockaddr_in *)&m_sender_addr)->sin_port));
+}
+
+TEST_F(UdpTransportXdpTest, shouldRedirectRegisteredPortToRxRing)
+{
+    if (NULL == m_xdp)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    ASSERT_EQ(aeron_udp_transport_xdp_add(m_xdp, &m_receiver), 0) << aeron_errmsg();
+
+    const std::vector<std::string> messages = { "first", std::string(1408, 'c') };
+
+    ASSERT_EQ(send(messages), 2) << aeron_errmsg();
+
+    poll_xdp_until(2);
+
+    ASSERT_EQ(m_received.size(), 2u);
+    EXPECT_EQ(m_received[0], messages[0]);
+    EXPECT_EQ(m_received[1], messages[1]);
+    EXPECT_EQ(m_bytes_received, (int64_t)(messages[0].length() + messages[1].length()));
+    EXPECT_EQ(m_received_port, ntohs(((struct sockaddr_in *)&m_sender_addr)->sin_port));
+    EXPECT_EQ(m_transport_clientd, (void *)&m_receiver);
+}
+
+TEST_F(UdpTransportXdpTest, shouldRecycleFramesBetweenTxAndRxRings)
+{
+    if (NULL == m_xdp)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    ASSERT_EQ(aeron_udp_transport_xdp_add(m_xdp, &m_receiver), 0) << aeron_errmsg();
+    ASSERT_EQ(aeron_udp_transport_xdp_attach_sender(m_xdp, &m_sender), 0) << aeron_errmsg();
+
+    const size_t count = FRAME_COUNT * 4;
+    for (size_t i = 0; i < count; i++)
+    {
+        int sent = 0;
+        for (int j = 0; j < POLL_ATTEMPTS && 0 == sent; j++)
+        {
+            ASSERT_GE(sent = send({ std::to_string(i) }), 0) << aeron_errmsg();
+        }
+
+        ASSERT_EQ(sent, 1);
+        poll_xdp_until(i + 1);
+    }
+
+    ASSERT_EQ(m_received.size(), count);
+    for (size_t i = 0; i < count; i++)
+    {
+        EXPECT_EQ(m_received[i], std::to_string(i));
+    }
+
+    EXPECT_EQ(m_xdp->tx.local_index, (uint32_t)count);
+}
+
+TEST_F(UdpTransportXdpTest, shouldPassPortToKernelAfterRemove)
+{
+    if (NULL == m_xdp)
+    {
+        AERON_TEST_SKIP(m_skip_reason);
+    }
+
+    ASSERT_EQ(aeron_udp_transport_xdp_add(m_xdp, &m_receiver), 0) << aeron_errmsg();
+    ASSERT_EQ(aeron_udp_transport_xdp_remove(m_xdp, &m_receiver), 0) << aeron_errmsg();
+
+    ASSERT_EQ(send({ "after remove" }), 1) << aeron_errmsg();
+
+    poll_xdp_until(1);
+    EXPECT_EQ(m_received.size(), 0u);
+
+    poll_socket_until(1);
+    ASSERT_EQ(m_received.size(), 1u);
+    EXPECT_EQ(m_received[0], "after remove");
+}
+
+#if defined(HAVE_AF_XDP)
+
+/*
+ * Routes and frames are built from the routing and neighbour tables and the interface details alone, so they are
+ * exercised here against an interface description with no socket behind it.
+ */
+class UdpTransportXdpRouteTest : public testing::Test
+{
+public:
+    UdpTransportXdpRouteTest()
+    {
+        const uint8_t mac[] = { 0x02, 0, 0, 0, 0, 0x01 };
+
+        memset(&m_xdp, 0, sizeof(m_xdp));
+        m_xdp.fd = -1;
+        m_xdp.ports_map_fd = -1;
+        m_xdp.is_loopback = true;
+        m_xdp.is_route_localnet = true;
+        strcpy(m_xdp.interface_name, "lo");
+        memcpy(m_xdp.mac, mac, sizeof(mac));
+        m_xdp.addr = htonl(INADDR_LOOPBACK);
+    }
+
+    virtual ~UdpTransportXdpRouteTest()
+    {
+        aeron_free(m_xdp.routes.array);
+    }
+
+    static struct sockaddr_in destination(uint16_t port)
+    {
+        struct sockaddr_in dst;
+
+        memset(&dst, 0, sizeof(dst));
+        dst.sin_family = AF_INET;
+        dst.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        dst.sin_port = htons(port);
+
+        return dst;
+    }
+
+    aeron_udp_transport_xdp_route_t *find(uint16_t port)
+    {
+        for (size_t i = 0; i < m_xdp.routes.length; i++)
+        {
+            if (htons(port) == m_xdp.routes.array[i].dst_port)
+            {
+                return &m_xdp.routes.array[i];
+            }
+        }
+
+        return NULL;
+    }
+
+protected:
+    aeron_udp_transport_xdp_t m_xdp;
+};
+
+static uint16_t read_uint16(const uint8_t *buffer)
+{
+    return (uint16_t)((buffer[0] << 8) | buffer[1]);
+}
+
+TEST_F(UdpTransportXdpRouteTest, shouldBuildFrameWithHeadersLengthsAndChecksum)
+{
+    const uint16_t src_port = 40123;
+    struct sockaddr_in dst = destination(40456);
+    aeron_udp_transport_xdp_route_t *route = aeron_udp_transport_xdp_route(&m_xdp, htons(src_port), &dst, 0);
+
+    ASSERT_NE(route, (aeron_udp_transport_xdp_route_t *)NULL);
+    ASSERT_TRUE(route->is_resolved);
+
+    std::string first = "hello ", second = "world";
+    struct iovec iov[2];
+    struct msghdr message;
+    uint8_t frame[AERON_UDP_TRANSPORT_XDP_FRAME_LENGTH];
+    const size_t length = first.length() + second.length();
+
+    iov[0].iov_base = (void *)first.data();
+    iov[0].iov_len = first.length();
+    iov[1].iov_base = (void *)second.data();
+    iov[1].iov_len = second.length();
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = iov;
+    message.msg_iovlen = 2;
+
+    ASSERT_EQ(
+        aeron_udp_transport_xdp_frame(route, frame, &message, length), AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH + length);
+
+    const uint8_t *eth = frame;
+    const uint8_t *ip = eth + AERON_UDP_TRANSPORT_XDP_ETH_HEADER_LENGTH;
+    const uint8_t *udp = ip + AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH;
+
+    EXPECT_EQ(memcmp(eth + 6, m_xdp.mac, sizeof(m_xdp.mac)), 0);
+    EXPECT_EQ(read_uint16(eth + 12), 0x0800);
+
+    EXPECT_EQ(ip[0], 0x45);
+    EXPECT_EQ(
+        read_uint16(ip + 2),
+        AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH + AERON_UDP_TRANSPORT_XDP_UDP_HEADER_LENGTH + length);
+    EXPECT_EQ(read_uint16(ip + 6), 0x4000);
+    EXPECT_EQ(ip[9], IPPROTO_UDP);
+    EXPECT_EQ(memcmp(ip + 12, &m_xdp.addr, sizeof(m_xdp.addr)), 0);
+    EXPECT_EQ(memcmp(ip + 16, &dst.sin_addr.s_addr, sizeof(dst.sin_addr.s_addr)), 0);
+
+    uint32_t sum = 0;
+    for (size_t i = 0; i < AERON_UDP_TRANSPORT_XDP_IP_HEADER_LENGTH; i += 2)
+    {
+        sum += read_uint16(ip + i);
+    }
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    EXPECT_EQ(sum, 0xFFFFu) << "IP header checksum";
+
+    EXPECT_EQ(read_uint16(udp), src_port);
+    EXPECT_EQ(read_uint16(udp + 2), 40456);
+    EXPECT_EQ(read_uint16(udp + 4), AERON_UDP_TRANSPORT_XDP_UDP_HEADER_LENGTH + length);
+    EXPECT_EQ(read_uint16(udp + 6), 0);
+    EXPECT_EQ(std::string((const char *)frame + AERON_UDP_TRANSPORT_XDP_HEADERS_LENGTH, length), first + second);
+}
+
+TEST_F(UdpTransportXdpRouteTest, shouldReuseRouteToSameDestination)
+{
+    struct sockaddr_in dst_1 = destination(40001), dst_2 = destination(40002);
+
+    aeron_udp_transport_xdp_route_t *route = aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst_1, 0);
+    ASSERT_NE(route, (aeron_udp_transport_xdp_route_t *)NULL);
+
+    EXPECT_EQ(aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst_1, 1), route);
+    EXPECT_EQ(m_xdp.routes.length, 1u);
+
+    EXPECT_NE(aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst_2, 2), route);
+    EXPECT_NE(aeron_udp_transport_xdp_route(&m_xdp, htons(40003), &dst_1, 3), route);
+    EXPECT_EQ(m_xdp.routes.length, 3u);
+}
+
+TEST_F(UdpTransportXdpRouteTest, shouldResolveRouteAgainOnceExpired)
+{
+    struct sockaddr_in dst = destination(40001);
+    const int64_t now_ns = 1000;
+    const int64_t expiry_ns = now_ns + AERON_UDP_TRANSPORT_XDP_ROUTE_EXPIRY_NS;
+
+    aeron_udp_transport_xdp_route_t *route = aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst, now_ns);
+    ASSERT_NE(route, (aeron_udp_transport_xdp_route_t *)NULL);
+    ASSERT_TRUE(route->is_resolved);
+
+    m_xdp.mac[5] = 0x02;
+
+    route = aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst, expiry_ns - 1);
+    EXPECT_EQ(route->header[6 + 5], 0x01);
+
+    route = aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst, expiry_ns);
+    EXPECT_TRUE(route->is_resolved);
+    EXPECT_EQ(route->header[6 + 5], 0x02);
+}
+
+TEST_F(UdpTransportXdpRouteTest, shouldRetryRouteThatNoLongerResolves)
+{
+    struct sockaddr_in dst = destination(40001);
+    int64_t now_ns = 1000;
+
+    aeron_udp_transport_xdp_route_t *route = aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst, now_ns);
+    ASSERT_NE(route, (aeron_udp_transport_xdp_route_t *)NULL);
+    ASSERT_TRUE(route->is_resolved);
+
+    /* loopback destinations only resolve with route_localnet, or when the port is redirected, which it is not */
+    m_xdp.is_route_localnet = false;
+    now_ns += AERON_UDP_TRANSPORT_XDP_ROUTE_EXPIRY_NS;
+    route = aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst, now_ns);
+    EXPECT_FALSE(route->is_resolved);
+
+    const int64_t retry_ns = now_ns + AERON_UDP_TRANSPORT_XDP_ROUTE_RETRY_NS;
+    m_xdp.is_route_localnet = true;
+    route = aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst, retry_ns - 1);
+    EXPECT_FALSE(route->is_resolved);
+
+    route = aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst, retry_ns);
+    EXPECT_TRUE(route->is_resolved);
+}
+
+TEST_F(UdpTransportXdpRouteTest, shouldReplaceLeastRecentlyUsedRouteWhenFull)
+{
+    for (uint16_t i = 0; i < AERON_UDP_TRANSPORT_XDP_MAX_ROUTES; i++)
+    {
+        struct sockaddr_in dst = destination((uint16_t)(30000 + i));
+        ASSERT_NE(
+            aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &dst, i), (aeron_udp_transport_xdp_route_t *)NULL);
+    }
+
+    struct sockaddr_in first = destination(30000);
+    aeron_udp_transport_xdp_route(&m_xdp, htons(40000), &first, AERON_UDP_TRANSPORT_XDP_MAX_ROUTES);
+
+    struct sockaddr_in next = destination(50000);
+    aeron_udp_transport_xdp_route_t *route = aeron_udp_transport_xdp_route(
+        &m_xdp, htons(40000), &next, AERON_UDP_TRANSPORT_XDP_MAX_ROUTES + 1);
+
+    ASSERT_NE(route, (aeron_udp_transport_xdp_route_t *)NULL);
+    EXPECT_EQ(m_xdp.routes.length, (size_t)AERON_UDP_TRANSPORT_XDP_MAX_ROUTES);
+    EXPECT_EQ(find(50000), route);
+    EXPECT_NE(find(30000), (aeron_udp_transport_xdp_route_t *)NULL);
+    EXPECT_EQ(find(30001), (aeron_udp_transport_xdp_route_t *)NULL);
+    EXPECT_TRUE(route->is_resolved);
+}
+
+#endif